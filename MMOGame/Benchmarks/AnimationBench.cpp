@@ -0,0 +1,414 @@
+// Benchmark + consistency check for compiled animation clips.
+//
+// Animates 500 characters sharing one humanoid rig (53 nodes, 52 bones, four
+// 30 key/s clips, every 10th character cross-fading) and times one frame of
+// skinning-matrix evaluation two ways:
+//   - before: the previous Animator, copied here verbatim in spirit: recurse
+//     the node tree, look each node's track and bone up by name, and find
+//     keys with a linear scan from key 0;
+//   - after: Animation::Compile'd clips evaluated by AnimationRig's flat
+//     parent-ordered loop (SSE2 slerp/nlerp, TRS compose and matrix product);
+//   - batch: the same jobs through AnimationBatch on a worker pool, every
+//     character writing into its range of one packed palette, the layout
+//     SceneRenderer uploads to the skinned bone SSBO.
+// Clips use both 30 and 1000 ticks per second so the resampling grid has to
+// line up with key times that are not integers. All paths must agree on
+// every bone matrix of every character.
+//
+// CPU only; needs no GL context or Assimp. Exits non-zero on mismatch.
+
+#include <Graphics/Animation.h>
+#include <Graphics/AnimationBatch.h>
+#include <Graphics/AnimationRig.h>
+#include <Graphics/Skeleton.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace Onyx;
+
+	constexpr int CHARACTERS = 500;
+	constexpr int FRAMES = 120;
+	constexpr float DT = 1.0f / 60.0f;
+	constexpr float KEYS_PER_SECOND = 30.0f;
+	constexpr float TOLERANCE = 1e-3f;
+
+	// ============================================================
+	// SYNTHETIC RIG
+	// ============================================================
+
+	struct Rig
+	{
+		std::vector<AnimationNode> nodes;
+		Skeleton skeleton;
+	};
+
+	int AddNode(Rig& rig, const std::string& name, int parent, const glm::vec3& offset, bool isBone)
+	{
+		AnimationNode node;
+		node.name = name;
+		node.transform = glm::mat4(1.0f);
+		node.transform[3] = glm::vec4(offset, 1.0f);
+		node.parentIndex = parent;
+
+		int index = static_cast<int>(rig.nodes.size());
+		rig.nodes.push_back(node);
+		if (parent >= 0)
+			rig.nodes[parent].children.push_back(index);
+
+		if (isBone)
+		{
+			glm::mat4 offsetMatrix(1.0f);
+			offsetMatrix[3] = glm::vec4(-offset, 1.0f);
+			int parentBone = parent >= 0 ? rig.skeleton.GetBoneIndex(rig.nodes[parent].name) : -1;
+			rig.skeleton.AddBone(name, parentBone, offsetMatrix);
+		}
+		return index;
+	}
+
+	Rig BuildHumanoid()
+	{
+		Rig rig;
+		int armature = AddNode(rig, "Armature", -1, glm::vec3(0.0f), false);
+		int hips = AddNode(rig, "Hips", armature, glm::vec3(0.0f, 1.0f, 0.0f), true);
+
+		int spine = hips;
+		for (int i = 0; i < 3; i++)
+		{
+			spine = AddNode(rig, "Spine" + std::to_string(i), spine, glm::vec3(0.0f, 0.15f, 0.0f), true);
+		}
+		int neck = AddNode(rig, "Neck", spine, glm::vec3(0.0f, 0.15f, 0.0f), true);
+		AddNode(rig, "Head", neck, glm::vec3(0.0f, 0.1f, 0.0f), true);
+
+		for (int side = 0; side < 2; side++)
+		{
+			const std::string prefix = side == 0 ? "Left" : "Right";
+			const float dir = side == 0 ? 1.0f : -1.0f;
+
+			int shoulder = AddNode(rig, prefix + "Shoulder", spine, glm::vec3(dir * 0.1f, 0.1f, 0.0f), true);
+			int arm = AddNode(rig, prefix + "Arm", shoulder, glm::vec3(dir * 0.15f, 0.0f, 0.0f), true);
+			int foreArm = AddNode(rig, prefix + "ForeArm", arm, glm::vec3(dir * 0.25f, 0.0f, 0.0f), true);
+			int hand = AddNode(rig, prefix + "Hand", foreArm, glm::vec3(dir * 0.25f, 0.0f, 0.0f), true);
+			for (int finger = 0; finger < 5; finger++)
+			{
+				int joint = hand;
+				for (int j = 0; j < 3; j++)
+				{
+					joint = AddNode(rig, prefix + "Finger" + std::to_string(finger) + "_" + std::to_string(j), joint,
+									glm::vec3(dir * 0.03f, 0.0f, 0.01f * float(finger - 2)), true);
+				}
+			}
+
+			int upLeg = AddNode(rig, prefix + "UpLeg", hips, glm::vec3(dir * 0.1f, -0.05f, 0.0f), true);
+			int leg = AddNode(rig, prefix + "Leg", upLeg, glm::vec3(0.0f, -0.45f, 0.0f), true);
+			int foot = AddNode(rig, prefix + "Foot", leg, glm::vec3(0.0f, -0.45f, 0.0f), true);
+			AddNode(rig, prefix + "ToeBase", foot, glm::vec3(0.0f, -0.05f, 0.1f), true);
+		}
+		return rig;
+	}
+
+	Animation BuildClip(const Rig& rig, const std::string& name, float seconds, float ticksPerSecond, uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> angle(-0.6f, 0.6f);
+		std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> jitter(-0.02f, 0.02f);
+
+		const float duration = seconds * ticksPerSecond;
+		const int keyCount = static_cast<int>(seconds * KEYS_PER_SECOND) + 1;
+		Animation clip(name, duration, ticksPerSecond);
+
+		for (const Bone& bone : rig.skeleton.GetBones())
+		{
+			BoneAnimation track;
+			track.boneName = bone.name;
+			glm::vec3 restOffset = -glm::vec3(bone.offsetMatrix[3]);
+			glm::vec3 spinAxis = glm::normalize(glm::vec3(axis(rng), axis(rng), axis(rng)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+			for (int k = 0; k < keyCount; k++)
+			{
+				float time = duration * static_cast<float>(k) / static_cast<float>(keyCount - 1);
+				track.positionKeys.push_back({time, restOffset + glm::vec3(jitter(rng), jitter(rng), jitter(rng))});
+				track.rotationKeys.push_back({time, glm::angleAxis(angle(rng), spinAxis)});
+				track.scaleKeys.push_back({time, glm::vec3(1.0f)});
+			}
+			clip.AddBoneAnimation(track);
+		}
+		return clip;
+	}
+
+	// ============================================================
+	// BEFORE: recursive, name-keyed evaluation with linear key search
+	// ============================================================
+
+	template <typename KeyType>
+	int FindKeyLinear(const std::vector<KeyType>& keys, float time)
+	{
+		for (size_t i = 0; i < keys.size() - 1; i++)
+		{
+			if (time < keys[i + 1].time)
+				return static_cast<int>(i);
+		}
+		return static_cast<int>(keys.size() - 2);
+	}
+
+	template <typename KeyType, typename Value, typename Lerp>
+	Value InterpolateLinear(const std::vector<KeyType>& keys, float time, Value KeyType::*value, Value fallback, Lerp lerp)
+	{
+		if (keys.empty())
+			return fallback;
+		if (keys.size() == 1)
+			return keys[0].*value;
+
+		int index = FindKeyLinear(keys, time);
+		float factor = (time - keys[index].time) / (keys[index + 1].time - keys[index].time);
+		return lerp(keys[index].*value, keys[index + 1].*value, glm::clamp(factor, 0.0f, 1.0f));
+	}
+
+	struct Character
+	{
+		int clip = 0;
+		int blendFrom = -1;
+		float time = 0.0f;
+		float blendFromTime = 0.0f;
+		float blendFactor = 0.0f;
+		float speed = 1.0f;
+	};
+
+	void EvaluateRecursive(const Rig& rig, const std::vector<Animation>& clips, const Character& character,
+						   int nodeIndex, const glm::mat4& parentTransform, std::vector<glm::mat4>& boneMatrices)
+	{
+		const AnimationNode& node = rig.nodes[nodeIndex];
+		glm::mat4 nodeTransform = node.transform;
+
+		auto mixVec = [](const glm::vec3& a, const glm::vec3& b, float t) { return glm::mix(a, b, t); };
+		auto slerp = [](const glm::quat& a, const glm::quat& b, float t) { return glm::slerp(a, b, t); };
+
+		const Animation& clip = clips[character.clip];
+		if (const BoneAnimation* boneAnim = clip.GetBoneAnimation(node.name))
+		{
+			glm::vec3 position = InterpolateLinear(boneAnim->positionKeys, character.time, &PositionKey::position,
+												   glm::vec3(0.0f), mixVec);
+			glm::quat rotation = InterpolateLinear(boneAnim->rotationKeys, character.time, &RotationKey::rotation,
+												   glm::quat(1.0f, 0.0f, 0.0f, 0.0f), slerp);
+			glm::vec3 scale = InterpolateLinear(boneAnim->scaleKeys, character.time, &ScaleKey::scale,
+												glm::vec3(1.0f), mixVec);
+
+			if (character.blendFrom >= 0)
+			{
+				const Animation& from = clips[character.blendFrom];
+				if (const BoneAnimation* fromAnim = from.GetBoneAnimation(node.name))
+				{
+					float t = character.blendFromTime;
+					glm::vec3 fromPos = InterpolateLinear(fromAnim->positionKeys, t, &PositionKey::position,
+														  glm::vec3(0.0f), mixVec);
+					glm::quat fromRot = InterpolateLinear(fromAnim->rotationKeys, t, &RotationKey::rotation,
+														  glm::quat(1.0f, 0.0f, 0.0f, 0.0f), slerp);
+					glm::vec3 fromScale = InterpolateLinear(fromAnim->scaleKeys, t, &ScaleKey::scale,
+															glm::vec3(1.0f), mixVec);
+					position = glm::mix(fromPos, position, character.blendFactor);
+					rotation = glm::slerp(fromRot, rotation, character.blendFactor);
+					scale = glm::mix(fromScale, scale, character.blendFactor);
+				}
+			}
+
+			nodeTransform = glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation) *
+							glm::scale(glm::mat4(1.0f), scale);
+		}
+
+		glm::mat4 globalTransform = parentTransform * nodeTransform;
+
+		int boneIndex = rig.skeleton.GetBoneIndex(node.name);
+		if (boneIndex >= 0 && boneIndex < static_cast<int>(boneMatrices.size()))
+		{
+			const Bone* bone = rig.skeleton.GetBone(boneIndex);
+			boneMatrices[boneIndex] = rig.skeleton.GetGlobalInverseTransform() * globalTransform * bone->offsetMatrix;
+		}
+
+		for (int child : node.children)
+		{
+			EvaluateRecursive(rig, clips, character, child, globalTransform, boneMatrices);
+		}
+	}
+
+	void EvaluateBefore(const Rig& rig, const std::vector<Animation>& clips, const Character& character,
+						std::vector<glm::mat4>& boneMatrices)
+	{
+		for (int i = 0; i < static_cast<int>(rig.nodes.size()); i++)
+		{
+			if (rig.nodes[i].parentIndex < 0)
+				EvaluateRecursive(rig, clips, character, i, glm::mat4(1.0f), boneMatrices);
+		}
+	}
+
+	float MaxDifference(const std::vector<glm::mat4>& a, const std::vector<glm::mat4>& b)
+	{
+		float maxDiff = 0.0f;
+		for (size_t m = 0; m < a.size(); m++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				for (int r = 0; r < 4; r++)
+				{
+					maxDiff = std::max(maxDiff, std::abs(a[m][c][r] - b[m][c][r]));
+				}
+			}
+		}
+		return maxDiff;
+	}
+
+} // namespace
+
+int main()
+{
+	Rig rig = BuildHumanoid();
+
+	std::vector<Animation> clips;
+	clips.push_back(BuildClip(rig, "Idle", 2.0f, 30.0f, 1));
+	clips.push_back(BuildClip(rig, "Walk", 1.0f, 30.0f, 2));
+	clips.push_back(BuildClip(rig, "Run", 0.7f, 1000.0f, 3));
+	clips.push_back(BuildClip(rig, "Attack", 1.5f, 1000.0f, 4));
+
+	auto compileStart = Clock::now();
+	AnimationRig animationRig;
+	animationRig.Build(rig.nodes, rig.skeleton);
+	for (auto& clip : clips)
+	{
+		clip.Compile(rig.nodes);
+	}
+	double compileMs = std::chrono::duration<double, std::milli>(Clock::now() - compileStart).count();
+
+	std::mt19937 rng(7);
+	std::vector<Character> characters(CHARACTERS);
+	for (int i = 0; i < CHARACTERS; i++)
+	{
+		Character& character = characters[i];
+		character.clip = static_cast<int>(rng() % clips.size());
+		character.time = std::uniform_real_distribution<float>(0.0f, clips[character.clip].GetDuration())(rng);
+		character.speed = std::uniform_real_distribution<float>(0.8f, 1.2f)(rng);
+		if (i % 10 == 0)
+		{
+			character.blendFrom = static_cast<int>((character.clip + 1) % clips.size());
+			character.blendFromTime = clips[character.blendFrom].GetDuration() * 0.5f;
+		}
+	}
+
+	std::vector<std::vector<glm::mat4>> before(CHARACTERS, std::vector<glm::mat4>(Skeleton::MAX_BONES, glm::mat4(1.0f)));
+	std::vector<std::vector<glm::mat4>> after(CHARACTERS, std::vector<glm::mat4>(Skeleton::MAX_BONES, glm::mat4(1.0f)));
+	std::vector<std::vector<glm::mat4>> globals(CHARACTERS);
+
+	const uint32_t boneCount = animationRig.GetBoneCount();
+	std::vector<glm::mat4> palette(size_t(CHARACTERS) * boneCount, glm::mat4(1.0f));
+	std::vector<AnimationJob> jobs(CHARACTERS);
+
+	unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+	AnimationBatch batch;
+	batch.Activate(std::min(cores, 8u) - 1);
+
+	double beforeMs = 0.0;
+	double afterMs = 0.0;
+	double batchMs = 0.0;
+	float maxDiff = 0.0f;
+	float maxBatchDiff = 0.0f;
+
+	for (int frame = 0; frame < FRAMES; frame++)
+	{
+		for (Character& character : characters)
+		{
+			const Animation& clip = clips[character.clip];
+			character.time = std::fmod(character.time + DT * character.speed * clip.GetTicksPerSecond(),
+									   clip.GetDuration());
+			if (character.blendFrom >= 0)
+				character.blendFactor = 0.5f + 0.5f * std::sin(float(frame) * 0.1f);
+		}
+
+		auto start = Clock::now();
+		for (int i = 0; i < CHARACTERS; i++)
+		{
+			EvaluateBefore(rig, clips, characters[i], before[i]);
+		}
+		beforeMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		start = Clock::now();
+		for (int i = 0; i < CHARACTERS; i++)
+		{
+			const Character& character = characters[i];
+			const Animation* blendFrom = character.blendFrom >= 0 ? &clips[character.blendFrom] : nullptr;
+			animationRig.Evaluate(clips[character.clip], character.time, blendFrom, character.blendFromTime,
+								  character.blendFactor, globals[i], after[i].data(),
+								  static_cast<uint32_t>(after[i].size()));
+		}
+		afterMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		for (int i = 0; i < CHARACTERS; i++)
+		{
+			const Character& character = characters[i];
+			AnimationJob& job = jobs[i];
+			job.rig = &animationRig;
+			job.clip = &clips[character.clip];
+			job.time = character.time;
+			job.blendFrom = character.blendFrom >= 0 ? &clips[character.blendFrom] : nullptr;
+			job.blendFromTime = character.blendFromTime;
+			job.blendFactor = character.blendFactor;
+			job.globals = &globals[i];
+			job.palette = palette.data() + size_t(i) * boneCount;
+			job.paletteSize = boneCount;
+		}
+
+		start = Clock::now();
+		batch.Evaluate(jobs);
+		batchMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		for (int i = 0; i < CHARACTERS; i++)
+		{
+			maxDiff = std::max(maxDiff, MaxDifference(before[i], after[i]));
+
+			std::vector<glm::mat4> packed(palette.begin() + size_t(i) * boneCount,
+										  palette.begin() + size_t(i + 1) * boneCount);
+			std::vector<glm::mat4> serial(after[i].begin(), after[i].begin() + boneCount);
+			maxBatchDiff = std::max(maxBatchDiff, MaxDifference(serial, packed));
+		}
+	}
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << CHARACTERS << " characters, " << rig.nodes.size() << " nodes, " << rig.skeleton.GetBoneCount()
+			  << " bones, " << clips.size() << " clips (compile " << compileMs << " ms)\n";
+	for (const auto& clip : clips)
+	{
+		std::cout << "  " << std::setw(8) << clip.GetName() << ": " << clip.GetFrameCount() << " frames\n";
+	}
+	std::cout << "before (recursive, by name, linear keys): " << beforeMs / FRAMES << " ms/frame\n";
+	std::cout << "after  (compiled, flat):                  " << afterMs / FRAMES << " ms/frame\n";
+	std::cout << "batch  (" << batch.GetThreadCount() + 1 << " threads, packed palette):      " << batchMs / FRAMES
+			  << " ms/frame\n";
+	std::cout << "speedup: " << beforeMs / afterMs << "x flat, " << beforeMs / batchMs
+			  << "x batch, max matrix difference: " << std::scientific << maxDiff << " (batch vs flat "
+			  << maxBatchDiff << ")\n";
+
+	if (maxDiff > TOLERANCE)
+	{
+		std::cerr << "FAIL: compiled evaluation differs from the reference by " << maxDiff << "\n";
+		return 1;
+	}
+	if (maxBatchDiff != 0.0f)
+	{
+		std::cerr << "FAIL: batched evaluation differs from the serial one by " << maxBatchDiff << "\n";
+		return 1;
+	}
+	return 0;
+}
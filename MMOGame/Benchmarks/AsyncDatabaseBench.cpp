@@ -0,0 +1,219 @@
+// Harness: game-loop tick time with synchronous vs asynchronous persistence.
+//
+// Runs a 20 Hz loop against a real Postgres (same DB_HOST/DB_USER/DB_PASS/
+// DB_NAME variables as the servers; the schema must be migrated). Every query
+// is preceded by an artificial delay (argv[1] ms, default 5) to emulate a slow
+// or remote database.
+//
+// Per tick the simulated server:
+//   - logs one character in (GetCharacterById + cooldowns + inventory + equipment)
+//   - saves two random characters (disconnects / zone changes)
+//   - every 2 s autosaves the whole population
+//
+// sync  = the old WorldServer path: Database calls inline on the game thread.
+// async = AsyncDatabase: loads complete through ProcessCompletions() at the
+//         start of the tick, saves are write-behind and coalesced per character.
+//
+// Character ids are in an unused high range, so the UPDATEs match no rows and
+// the loads return nothing; the harness writes nothing to real characters.
+// Both runs end with the per-statement timing table from Database.
+
+#include "Database/AsyncDatabase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+
+	constexpr int TICK_RATE = 20;
+	constexpr int SIM_TICKS = TICK_RATE * 15;
+	constexpr int AUTOSAVE_TICKS = TICK_RATE * 2;
+	constexpr size_t POPULATION = 50;
+	constexpr CharacterId FIRST_ID = 0x7FFF0000u;
+
+	std::string ConnectionString()
+	{
+		const char* dbHost = std::getenv("DB_HOST");
+		const char* dbUser = std::getenv("DB_USER");
+		const char* dbPass = std::getenv("DB_PASS");
+		const char* dbName = std::getenv("DB_NAME");
+		return "host=" + std::string(dbHost ? dbHost : "localhost") +
+			   " user=" + std::string(dbUser ? dbUser : "root") +
+			   " password=" + std::string(dbPass ? dbPass : "root") +
+			   " dbname=" + std::string(dbName ? dbName : "mmogame");
+	}
+
+	CharacterSaveData MakeSave(CharacterId id, int tick)
+	{
+		CharacterSaveData save;
+		save.character.id = id;
+		save.character.level = 1;
+		save.character.experience = 0;
+		save.character.money = static_cast<uint32_t>(tick);
+		save.character.mapId = 1;
+		save.character.positionX = static_cast<float>(tick);
+		save.character.positionY = 0.0f;
+		save.character.maxHealth = save.character.currentHealth = 100;
+		save.character.maxMana = save.character.currentMana = 100;
+		// Empty collections: exercises the DELETEs of a full save without
+		// inserting rows for characters that don't exist
+		save.hasCooldowns = save.hasInventory = save.hasEquipment = true;
+		return save;
+	}
+
+	struct TickStats
+	{
+		std::vector<double> tickMs;
+		double loadLatencyMs = 0.0;
+		uint64_t loads = 0;
+
+		double Percentile(double p)
+		{
+			std::sort(tickMs.begin(), tickMs.end());
+			size_t index = std::min(tickMs.size() - 1, static_cast<size_t>(p * tickMs.size()));
+			return tickMs[index];
+		}
+	};
+
+	template <typename TickFn>
+	TickStats RunLoop(TickFn&& tick)
+	{
+		TickStats stats;
+		stats.tickMs.reserve(SIM_TICKS);
+		const auto interval = std::chrono::microseconds(1000000 / TICK_RATE);
+		auto next = Clock::now();
+		for (int i = 0; i < SIM_TICKS; i++)
+		{
+			auto start = Clock::now();
+			tick(i, stats);
+			stats.tickMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+			next += interval;
+			std::this_thread::sleep_until(std::max(next, Clock::now()));
+		}
+		return stats;
+	}
+
+	void Report(const char* name, TickStats stats)
+	{
+		double maxMs = *std::max_element(stats.tickMs.begin(), stats.tickMs.end());
+		double p50 = stats.Percentile(0.50);
+		double p99 = stats.Percentile(0.99);
+		std::cout << "  " << std::left << std::setw(6) << name << std::right
+				  << "  tick p50 " << std::setw(8) << p50
+				  << " ms  p99 " << std::setw(8) << p99
+				  << " ms  max " << std::setw(8) << maxMs << " ms"
+				  << "  login latency " << std::setw(7)
+				  << (stats.loads ? stats.loadLatencyMs / stats.loads : 0.0) << " ms\n";
+	}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	const int latencyMs = argc > 1 ? std::atoi(argv[1]) : 5;
+	const std::string connStr = ConnectionString();
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "Persistence harness: " << SIM_TICKS << " ticks at " << TICK_RATE << " Hz, "
+			  << POPULATION << " characters, " << latencyMs << " ms injected per query\n\n";
+
+	std::mt19937 rng(7);
+	auto randomId = [&rng]() { return FIRST_ID + static_cast<CharacterId>(rng() % POPULATION); };
+
+	// ---- sync: Database on the game thread ----
+	Database db;
+	if (!db.Connect(connStr))
+	{
+		std::cerr << "Cannot connect; set DB_HOST/DB_USER/DB_PASS/DB_NAME" << '\n';
+		return 1;
+	}
+
+	auto delay = [latencyMs]() { std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs)); };
+	auto save = [&](const CharacterSaveData& data) {
+		delay();
+		db.SaveCharacterFull(data.character, &data.cooldowns, &data.inventory, &data.equipment);
+	};
+
+	TickStats sync = RunLoop([&](int tick, TickStats& stats) {
+		auto start = Clock::now();
+		CharacterId login = randomId();
+		delay();
+		db.GetCharacterById(login);
+		db.GetCooldowns(login);
+		db.GetInventory(login);
+		db.GetEquipment(login);
+		stats.loadLatencyMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		stats.loads++;
+
+		save(MakeSave(randomId(), tick));
+		save(MakeSave(randomId(), tick));
+		if (tick % AUTOSAVE_TICKS == 0)
+		{
+			for (size_t i = 0; i < POPULATION; i++)
+				save(MakeSave(FIRST_ID + static_cast<CharacterId>(i), tick));
+		}
+	});
+	const Database::StatementStatsMap syncStatements = db.GetStatementStats();
+	db.Disconnect();
+
+	// ---- async: AsyncDatabase, completions at the start of the tick ----
+	AsyncDatabase async;
+	if (!async.Connect(connStr, 2))
+		return 1;
+	async.SetArtificialLatency(std::chrono::milliseconds(latencyMs));
+
+	TickStats asyncStats = RunLoop([&](int tick, TickStats& stats) {
+		async.ProcessCompletions();
+
+		CharacterId login = randomId();
+		auto issued = Clock::now();
+		async.Query(
+			login,
+			[login](Database& conn) {
+				conn.GetCharacterById(login);
+				conn.GetCooldowns(login);
+				conn.GetInventory(login);
+				return conn.GetEquipment(login).size();
+			},
+			[&stats, issued](size_t) {
+				stats.loadLatencyMs += std::chrono::duration<double, std::milli>(Clock::now() - issued).count();
+				stats.loads++;
+			});
+
+		async.SaveCharacter(MakeSave(randomId(), tick));
+		async.SaveCharacter(MakeSave(randomId(), tick));
+		if (tick % AUTOSAVE_TICKS == 0)
+		{
+			for (size_t i = 0; i < POPULATION; i++)
+				async.SaveCharacter(MakeSave(FIRST_ID + static_cast<CharacterId>(i), tick));
+		}
+	});
+
+	size_t backlog = async.GetQueueDepth();
+	async.Shutdown(); // Drains the backlog; leftover completions reference the finished loop and are dropped
+	AsyncDatabaseStats dbStats = async.GetStats();
+
+	Report("sync", sync);
+	Report("async", asyncStats);
+	std::cout << "\n  async saves: " << dbStats.savesQueued << " queued, " << dbStats.savesWritten
+			  << " written, " << (dbStats.savesQueued - dbStats.savesWritten) << " coalesced; "
+			  << backlog << " jobs were still queued when the loop ended\n";
+
+	std::cout << "\n  sync statements:\n";
+	Database::PrintStatementStats(syncStatements);
+	std::cout << "\n  async statements:\n";
+	Database::PrintStatementStats(async.GetStatementStats());
+	return 0;
+}
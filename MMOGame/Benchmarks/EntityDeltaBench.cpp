@@ -0,0 +1,248 @@
+// Benchmark + round-trip check: S_ENTITY_UPDATE vs S_ENTITY_DELTAS.
+//
+// Simulates one recipient watching N entities at 20 Hz for 30 s. Mobs and
+// players random-walk at run speed, take occasional damage / spend mana, swap
+// targets and start casts. Every tick the dirty entities are encoded twice:
+//
+// legacy = one S_ENTITY_UPDATE per entity (type byte + fixed-width fields),
+//          each framed in a PacketBatch entry (2-byte length).
+// delta  = EntityDelta::Encode into one S_ENTITY_DELTAS packet against a
+//          server-side baseline, then decoded with an independent client-side
+//          baseline (seeded from the same S_EntitySpawn).
+//
+// Every decoded field is checked against the source state (positions within
+// half a quantum, rotation within half a step, integers exact). Exit code is
+// non-zero on any mismatch, so this doubles as the codec's round-trip test.
+
+#include "Network/PacketBatch.h"
+#include "Packets/Packets.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+
+	constexpr int TICK_RATE = 20;
+	constexpr int SIM_TICKS = TICK_RATE * 30;
+	constexpr float RUN_SPEED = 7.0f;
+	constexpr float PI = 3.14159265f;
+
+	struct SimEntity
+	{
+		S_EntityUpdate state{};
+		float heading = 0.0f;
+		EntityDeltaBaseline serverBaseline;
+		EntityDeltaBaseline clientBaseline;
+	};
+
+	float AngleDiff(float a, float b)
+	{
+		float d = std::fmod(std::fabs(a - b), 2.0f * PI);
+		return std::min(d, 2.0f * PI - d);
+	}
+
+	bool Check(const S_EntityUpdate& src, const S_EntityUpdate& got)
+	{
+		const float posTolerance = 0.5f / ENTITY_POSITION_SCALE + 1e-4f;
+		bool ok = true;
+		if (src.updateMask & UPDATE_POSITION)
+		{
+			ok &= std::fabs(src.position.x - got.position.x) <= posTolerance;
+			ok &= std::fabs(src.position.y - got.position.y) <= posTolerance;
+			ok &= std::fabs(src.height - got.height) <= posTolerance;
+			ok &= AngleDiff(src.rotation, got.rotation) <= PI / 65536.0f + 1e-5f;
+		}
+		if (src.updateMask & UPDATE_HEALTH)
+			ok &= src.health == got.health && src.maxHealth == got.maxHealth;
+		if (src.updateMask & UPDATE_MANA)
+			ok &= src.mana == got.mana && src.maxMana == got.maxMana;
+		if (src.updateMask & UPDATE_MOVE_STATE)
+			ok &= src.moveState == got.moveState;
+		if (src.updateMask & UPDATE_TARGET)
+			ok &= src.targetId == got.targetId;
+		if (src.updateMask & UPDATE_CASTING)
+		{
+			ok &= src.isCasting == got.isCasting;
+			if (src.isCasting)
+			{
+				ok &= src.castingAbilityId == got.castingAbilityId;
+				ok &= std::fabs(src.castProgress - got.castProgress) <= 1.0f / 65535.0f;
+			}
+		}
+		return ok;
+	}
+
+	bool RunCase(size_t entityCount)
+	{
+		std::mt19937 rng(42u + static_cast<uint32_t>(entityCount));
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		// Spawn: both sides seed baselines from the same spawn packet
+		std::vector<SimEntity> entities(entityCount);
+		for (size_t i = 0; i < entityCount; i++)
+		{
+			SimEntity& e = entities[i];
+			S_EntitySpawn spawn{};
+			spawn.id = static_cast<EntityId>(1000 + i);
+			spawn.position = Vec2(unit(rng) * 160.0f - 80.0f, unit(rng) * 160.0f - 80.0f);
+			spawn.height = unit(rng) * 10.0f;
+			spawn.rotation = unit(rng) * 2.0f * PI;
+			spawn.health = spawn.maxHealth = 1000 + static_cast<int32_t>(i % 7) * 250;
+
+			WriteBuffer wire;
+			spawn.Serialize(wire);
+			ReadBuffer read(wire.Data(), wire.Size());
+			S_EntitySpawn received;
+			received.Deserialize(read);
+
+			e.serverBaseline = EntityDeltaBaseline::FromSpawn(spawn);
+			e.clientBaseline = EntityDeltaBaseline::FromSpawn(received);
+
+			e.state.id = spawn.id;
+			e.state.position = spawn.position;
+			e.state.height = spawn.height;
+			e.state.rotation = spawn.rotation;
+			e.state.health = spawn.health;
+			e.state.maxHealth = spawn.maxHealth;
+			e.state.mana = e.state.maxMana = 500;
+			e.state.moveState = MoveState::IDLE;
+			e.heading = spawn.rotation;
+		}
+
+		uint64_t legacyBytes = 0;
+		uint64_t deltaBytes = 0;
+		uint64_t entries = 0;
+		uint64_t mismatches = 0;
+		double encodeNs = 0.0;
+		double decodeNs = 0.0;
+
+		WriteBuffer packet(2048);
+		const float dt = 1.0f / TICK_RATE;
+
+		for (int tick = 0; tick < SIM_TICKS; tick++)
+		{
+			// Advance simulation and collect this tick's dirty set
+			std::vector<size_t> dirty;
+			for (size_t i = 0; i < entityCount; i++)
+			{
+				SimEntity& e = entities[i];
+				S_EntityUpdate& s = e.state;
+				s.updateMask = 0;
+
+				bool moving = (i % 3) != 0; // a third of the population stands still
+				if (moving)
+				{
+					e.heading += (unit(rng) - 0.5f) * 0.3f;
+					s.position.x += std::cos(e.heading) * RUN_SPEED * dt;
+					s.position.y += std::sin(e.heading) * RUN_SPEED * dt;
+					s.height += (unit(rng) - 0.5f) * 0.05f;
+					s.rotation = e.heading;
+					s.updateMask |= UPDATE_POSITION;
+					if (s.moveState != MoveState::RUNNING)
+					{
+						s.moveState = MoveState::RUNNING;
+						s.updateMask |= UPDATE_MOVE_STATE;
+					}
+				}
+				if (unit(rng) < 0.05f)
+				{
+					s.health = std::max(0, s.health - static_cast<int32_t>(unit(rng) * 120.0f));
+					if (unit(rng) < 0.02f)
+						s.maxHealth += 50;
+					s.updateMask |= UPDATE_HEALTH;
+				}
+				if (unit(rng) < 0.03f)
+				{
+					s.mana = std::max(0, s.mana - 30);
+					s.updateMask |= UPDATE_MANA;
+				}
+				if (unit(rng) < 0.01f)
+				{
+					s.targetId = static_cast<EntityId>(1000 + rng() % entityCount);
+					s.updateMask |= UPDATE_TARGET;
+				}
+				if (unit(rng) < 0.01f)
+				{
+					s.isCasting = !s.isCasting;
+					s.castingAbilityId = static_cast<AbilityId>(1 + rng() % 40);
+					s.castProgress = unit(rng);
+					s.updateMask |= UPDATE_CASTING;
+				}
+
+				if (s.updateMask)
+				{
+					dirty.push_back(i);
+					legacyBytes += 1 + PacketBatch::ENTRY_HEADER_SIZE + s.SerializedSize();
+				}
+			}
+
+			// Encode one delta packet for the recipient
+			auto start = Clock::now();
+			packet.Clear();
+			packet.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_DELTAS));
+			for (size_t i : dirty)
+			{
+				if (EntityDelta::Encode(packet, entities[i].state, entities[i].serverBaseline))
+					entries++;
+			}
+			encodeNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+			if (packet.Size() > 1)
+				deltaBytes += packet.Size() + PacketBatch::ENTRY_HEADER_SIZE;
+
+			// Decode as the client would and verify
+			start = Clock::now();
+			ReadBuffer read(packet.Data(), packet.Size());
+			read.ReadU8();
+			std::vector<S_EntityUpdate> decoded;
+			decoded.reserve(dirty.size());
+			while (read.HasData(1))
+			{
+				EntityId id = EntityDelta::ReadId(read);
+				SimEntity& e = entities[id - 1000];
+				decoded.push_back(EntityDelta::Decode(read, id, e.clientBaseline));
+			}
+			decodeNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+			for (const S_EntityUpdate& got : decoded)
+			{
+				if (!Check(entities[got.id - 1000].state, got))
+					mismatches++;
+			}
+		}
+
+		std::cout << std::setw(6) << entityCount << " entities: "
+				  << std::setw(9) << legacyBytes / SIM_TICKS << " B/tick legacy  "
+				  << std::setw(9) << deltaBytes / SIM_TICKS << " B/tick delta  ("
+				  << std::setprecision(1)
+				  << 100.0 - 100.0 * static_cast<double>(deltaBytes) / static_cast<double>(legacyBytes)
+				  << "% saved, " << static_cast<double>(deltaBytes) / std::max<uint64_t>(entries, 1)
+				  << " B/entry)  encode " << encodeNs / std::max<uint64_t>(entries, 1)
+				  << " ns/entry, decode " << decodeNs / std::max<uint64_t>(entries, 1) << " ns/entry"
+				  << (mismatches ? "  ** ROUND-TRIP MISMATCH **" : "") << '\n';
+		return mismatches == 0;
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed;
+	std::cout << "Entity update encoding: one recipient, " << SIM_TICKS << " ticks at " << TICK_RATE << " Hz\n\n";
+
+	bool ok = true;
+	for (size_t count : {size_t(50), size_t(200), size_t(1000)})
+	{
+		ok &= RunCase(count);
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,374 @@
+// Benchmark: MapInstance per-tick entity work, pointer-per-component vs pools.
+//
+// legacy = the previous layout: unordered_map<EntityId, unique_ptr<Entity>>,
+//          every component behind its own unique_ptr, allocated in shuffled
+//          order as they would be on a long-running server. The tick walks the
+//          map for old positions, Entity::Update, the moved check, regen and
+//          auras, like MapInstance::Update did.
+// pooled = real Entity objects whose components live in a ComponentStore;
+//          the same phases run as loops over the dense pools, the way
+//          MapInstance::Update runs them now.
+//
+// Population: creatures with health, combat (two cooldowns), aggro and auras;
+// every fifth has mana; half are walking; 10% carry a speed aura and 5% a
+// periodic heal. Regen runs on its real 2 s cadence. Both layouts must end
+// with identical positions and health, checked at the end (exit code 1 on
+// mismatch).
+
+#include "Entity/Entity.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+
+	constexpr int TICK_RATE = 20;
+	constexpr int SIM_TICKS = TICK_RATE * 10;
+	constexpr float DT = 1.0f / TICK_RATE;
+	constexpr float TICK_BUDGET_MS = 50.0f;
+	constexpr int REGEN_TICKS = TICK_RATE * 2;
+
+	// ------------------------------------------------------------
+	// Legacy layout
+	// ------------------------------------------------------------
+
+	struct LegacyEntity
+	{
+		EntityId id = 0;
+		EntityType type = EntityType::MOB;
+		std::unique_ptr<HealthComponent> health;
+		std::unique_ptr<ManaComponent> mana;
+		std::unique_ptr<MovementComponent> movement;
+		std::unique_ptr<CombatComponent> combat;
+		std::unique_ptr<AggroComponent> aggro;
+		std::unique_ptr<AuraComponent> auras;
+
+		void Update(float dt)
+		{
+			if (combat)
+				TickCombatTimers(*combat, dt);
+			if (movement)
+				IntegrateMovement(*movement, health.get(), auras.get(), dt);
+		}
+	};
+
+	// ------------------------------------------------------------
+	// Shared population setup
+	// ------------------------------------------------------------
+
+	struct Spawn
+	{
+		Vec2 position;
+		Vec2 velocity;
+		bool hasMana = false;
+		bool speedAura = false;
+		bool healAura = false;
+		int32_t damage = 0;
+	};
+
+	std::vector<Spawn> MakeSpawns(size_t count)
+	{
+		std::mt19937 rng(static_cast<uint32_t>(count));
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		std::vector<Spawn> spawns(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			Spawn& s = spawns[i];
+			s.position = Vec2(unit(rng) * 1000.0f, unit(rng) * 1000.0f);
+			if (i % 2 == 0)
+				s.velocity = Vec2(unit(rng) - 0.5f, unit(rng) - 0.5f);
+			s.hasMana = i % 5 == 0;
+			s.speedAura = unit(rng) < 0.10f;
+			s.healAura = unit(rng) < 0.05f;
+			s.damage = static_cast<int32_t>(unit(rng) * 400.0f);
+		}
+		return spawns;
+	}
+
+	Aura MakeAura(AuraType type, float value, float tickInterval)
+	{
+		Aura aura;
+		aura.type = type;
+		aura.value = value;
+		aura.duration = 1e6f;
+		aura.tickInterval = tickInterval;
+		return aura;
+	}
+
+	void TickAuras(AuraComponent& auras, HealthComponent* health, float dt)
+	{
+		for (auto& aura : auras.GetAuras())
+		{
+			aura.duration -= dt;
+			if (aura.tickInterval <= 0.0f)
+				continue;
+			aura.tickTimer += dt;
+			while (aura.tickTimer >= aura.tickInterval)
+			{
+				aura.tickTimer -= aura.tickInterval;
+				if (aura.type == AuraType::PERIODIC_HEAL && health && !health->IsDead())
+					health->Heal(static_cast<int32_t>(aura.value));
+			}
+		}
+	}
+
+	void Regen(HealthComponent& health, ManaComponent* mana, AggroComponent* aggro, EntityType type)
+	{
+		if (type == EntityType::MOB && aggro && aggro->isEvading && health.current < health.max)
+			health.Heal(std::max(1, static_cast<int32_t>(health.max * 0.05f)));
+		if (mana && mana->current < mana->max)
+			mana->RestoreMana(std::max(1, static_cast<int32_t>(mana->max * 0.03f)));
+	}
+
+	// ------------------------------------------------------------
+	// Runs
+	// ------------------------------------------------------------
+
+	struct Result
+	{
+		double tickMs = 0.0;
+		uint64_t moved = 0;
+		std::vector<Vec2> positions;
+		std::vector<int32_t> health;
+	};
+
+	Result RunLegacy(const std::vector<Spawn>& spawns)
+	{
+		std::unordered_map<EntityId, std::unique_ptr<LegacyEntity>> entities;
+		std::vector<LegacyEntity*> order;
+		for (size_t i = 0; i < spawns.size(); i++)
+		{
+			auto entity = std::make_unique<LegacyEntity>();
+			entity->id = static_cast<EntityId>(i + 1);
+			order.push_back(entity.get());
+			entities[entity->id] = std::move(entity);
+		}
+
+		// Components are allocated in shuffled order, so one entity's
+		// components are scattered across the heap as on a live server
+		std::vector<std::function<void()>> allocations;
+		for (size_t i = 0; i < spawns.size(); i++)
+		{
+			LegacyEntity* e = order[i];
+			const Spawn& s = spawns[i];
+			allocations.push_back([e]() { e->health = std::make_unique<HealthComponent>(); e->health->max = e->health->current = 1000; });
+			allocations.push_back([e, &s]() { e->movement = std::make_unique<MovementComponent>(); e->movement->position = s.position; e->movement->velocity = s.velocity; });
+			allocations.push_back([e]() { e->combat = std::make_unique<CombatComponent>(); e->combat->cooldowns[AbilityId::WARRIOR_SLASH] = 3.0f; e->combat->cooldowns[AbilityId::WITCH_FIREBALL] = 8.0f; });
+			allocations.push_back([e]() { e->aggro = std::make_unique<AggroComponent>(); });
+			allocations.push_back([e]() { e->auras = std::make_unique<AuraComponent>(); });
+			if (s.hasMana)
+				allocations.push_back([e]() { e->mana = std::make_unique<ManaComponent>(); e->mana->current = 10; });
+		}
+		std::shuffle(allocations.begin(), allocations.end(), std::mt19937(1));
+		for (auto& allocate : allocations)
+			allocate();
+		for (size_t i = 0; i < spawns.size(); i++)
+		{
+			LegacyEntity* e = order[i];
+			e->health->TakeDamage(spawns[i].damage);
+			if (spawns[i].speedAura)
+				e->auras->AddAura(MakeAura(AuraType::MOD_SPEED_PCT, 30.0f, 0.0f));
+			if (spawns[i].healAura)
+				e->auras->AddAura(MakeAura(AuraType::PERIODIC_HEAL, 5.0f, 1.0f));
+		}
+
+		Result result;
+		auto start = Clock::now();
+		for (int tick = 0; tick < SIM_TICKS; tick++)
+		{
+			std::unordered_map<EntityId, Vec2> oldPositions;
+			for (auto& [id, entity] : entities)
+			{
+				if (entity->movement)
+					oldPositions[id] = entity->movement->position;
+			}
+
+			for (auto& [id, entity] : entities)
+				entity->Update(DT);
+
+			for (auto& [id, entity] : entities)
+			{
+				if (!entity->movement)
+					continue;
+				auto it = oldPositions.find(id);
+				if (it != oldPositions.end() && Vec2::DistanceSquared(it->second, entity->movement->position) > 0.0001f)
+					result.moved++;
+			}
+
+			if (tick % REGEN_TICKS == 0)
+			{
+				for (auto& [id, entity] : entities)
+				{
+					if (entity->health && !entity->health->IsDead())
+						Regen(*entity->health, entity->mana.get(), entity->aggro.get(), entity->type);
+				}
+			}
+
+			for (auto& [id, entity] : entities)
+			{
+				if (entity->auras)
+					TickAuras(*entity->auras, entity->health.get(), DT);
+			}
+		}
+		result.tickMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / SIM_TICKS;
+
+		for (LegacyEntity* e : order)
+		{
+			result.positions.push_back(e->movement->position);
+			result.health.push_back(e->health->current);
+		}
+		return result;
+	}
+
+	Result RunPooled(const std::vector<Spawn>& spawns)
+	{
+		ComponentStore store;
+		std::vector<std::unique_ptr<Entity>> entities;
+		for (size_t i = 0; i < spawns.size(); i++)
+		{
+			const Spawn& s = spawns[i];
+			auto entity = std::make_unique<Entity>(static_cast<EntityId>(i + 1), EntityType::MOB, "mob", store);
+			entity->AddHealthComponent(1000);
+			if (s.hasMana)
+			{
+				entity->AddManaComponent(100);
+				entity->GetMana()->current = 10;
+			}
+			entity->AddMovementComponent(5.0f);
+			entity->GetMovement()->position = s.position;
+			entity->GetMovement()->velocity = s.velocity;
+			entity->AddCombatComponent(2.5f);
+			entity->GetCombat()->cooldowns[AbilityId::WARRIOR_SLASH] = 3.0f;
+			entity->GetCombat()->cooldowns[AbilityId::WITCH_FIREBALL] = 8.0f;
+			entity->AddAggroComponent(10.0f, 20.0f);
+			entity->AddAuraComponent();
+			entity->GetHealth()->TakeDamage(s.damage);
+			if (s.speedAura)
+				entity->AddAura(MakeAura(AuraType::MOD_SPEED_PCT, 30.0f, 0.0f));
+			if (s.healAura)
+				entity->AddAura(MakeAura(AuraType::PERIODIC_HEAL, 5.0f, 1.0f));
+			entities.push_back(std::move(entity));
+		}
+
+		auto& movements = store.Pool<MovementComponent>();
+		auto& healths = store.Pool<HealthComponent>();
+		auto& manas = store.Pool<ManaComponent>();
+		auto& combats = store.Pool<CombatComponent>();
+		auto& aggros = store.Pool<AggroComponent>();
+		auto& auraPool = store.Pool<AuraComponent>();
+		std::vector<Vec2> oldPositions;
+
+		Result result;
+		auto start = Clock::now();
+		for (int tick = 0; tick < SIM_TICKS; tick++)
+		{
+			const uint32_t movedCount = movements.Size();
+			oldPositions.resize(movedCount);
+			for (uint32_t i = 0; i < movedCount; i++)
+				oldPositions[i] = movements.At(i).position;
+
+			for (uint32_t i = 0; i < combats.Size(); i++)
+			{
+				if (combats.OwnerAt(i))
+					TickCombatTimers(combats.At(i), DT);
+			}
+			for (uint32_t i = 0; i < movements.Size(); i++)
+			{
+				if (!movements.OwnerAt(i))
+					continue;
+				EntityHandle handle = movements.HandleAt(i);
+				IntegrateMovement(movements.At(i), healths.Get(handle), auraPool.Get(handle), DT);
+			}
+
+			for (uint32_t i = 0; i < movedCount; i++)
+			{
+				if (movements.OwnerAt(i) && Vec2::DistanceSquared(oldPositions[i], movements.At(i).position) > 0.0001f)
+					result.moved++;
+			}
+
+			if (tick % REGEN_TICKS == 0)
+			{
+				for (uint32_t i = 0; i < healths.Size(); i++)
+				{
+					Entity* entity = healths.OwnerAt(i);
+					HealthComponent& health = healths.At(i);
+					if (!entity || health.IsDead())
+						continue;
+					EntityHandle handle = healths.HandleAt(i);
+					ManaComponent* mana = manas.Get(handle);
+					if (health.current >= health.max && (!mana || mana->current >= mana->max))
+						continue;
+					Regen(health, mana, aggros.Get(handle), entity->GetType());
+				}
+			}
+
+			for (uint32_t i = 0; i < auraPool.Size(); i++)
+			{
+				AuraComponent& auras = auraPool.At(i);
+				if (auraPool.OwnerAt(i) && !auras.GetAuras().empty())
+					TickAuras(auras, healths.Get(auraPool.HandleAt(i)), DT);
+			}
+
+			store.Compact();
+		}
+		result.tickMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / SIM_TICKS;
+
+		for (const auto& entity : entities)
+		{
+			result.positions.push_back(entity->GetMovement()->position);
+			result.health.push_back(entity->GetHealth()->current);
+		}
+		return result;
+	}
+
+	bool Same(const Result& a, const Result& b)
+	{
+		if (a.moved != b.moved || a.health != b.health)
+			return false;
+		for (size_t i = 0; i < a.positions.size(); i++)
+		{
+			if (Vec2::DistanceSquared(a.positions[i], b.positions[i]) > 1e-8f)
+				return false;
+		}
+		return true;
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "Entity tick: " << SIM_TICKS << " ticks at " << TICK_RATE << " Hz, budget "
+			  << TICK_BUDGET_MS << " ms\n\n";
+
+	bool ok = true;
+	for (size_t count : {size_t(1000), size_t(10000), size_t(50000)})
+	{
+		std::vector<Spawn> spawns = MakeSpawns(count);
+		Result legacy = RunLegacy(spawns);
+		Result pooled = RunPooled(spawns);
+		bool same = Same(legacy, pooled);
+		ok &= same;
+
+		auto perBudget = [count](double ms) { return static_cast<uint64_t>(TICK_BUDGET_MS / ms * count); };
+		std::cout << std::setw(6) << count << " creatures: legacy " << std::setw(8) << legacy.tickMs
+				  << " ms/tick  pooled " << std::setw(8) << pooled.tickMs << " ms/tick  ("
+				  << std::setprecision(2) << legacy.tickMs / pooled.tickMs << "x; ~"
+				  << perBudget(legacy.tickMs) << " vs ~" << perBudget(pooled.tickMs)
+				  << " creatures per " << TICK_BUDGET_MS << " ms)" << std::setprecision(3)
+				  << (same ? "" : "  ** RESULT MISMATCH **") << '\n';
+	}
+	return ok ? 0 : 1;
+}
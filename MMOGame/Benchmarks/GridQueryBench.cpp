@@ -0,0 +1,350 @@
+// Benchmark: WorldServer Grid radius queries and moves, old vs current storage.
+//
+// legacy  = the previous layout, reproduced inline: unordered_map<CellCoord,
+//           unique_ptr<GridCell>> with unordered_set<EntityId> members, and every
+//           candidate's position fetched through a map lookup + component
+//           pointer (what m_Map->GetEntity(id)->GetMovement()->position did).
+//           Cell search radius ceil(r / cell) + 1.
+//
+// current = MMO::Grid from WorldServer/Source/Grid: dense cell array, members
+//           in swap-remove vectors with cached x/y arrays, exact cell bounds.
+//
+// Each run places N entities (10% players) uniformly on a 2048x2048 map, then
+// times VIEW_DISTANCE entity queries, player queries and short back-and-forth
+// moves of every entity, one tick per pass (dirty flags and visibility
+// changes cleared in between). Moves are reported twice: all of them, and
+// only those that stay in their cell. A move that crosses a cell boundary
+// also updates Grid's watcher lists and appends each affected player's
+// visibility changes, work the legacy grid left to per-tick radius queries,
+// so the all-moves column is not like for like.
+// Result counts are compared so a storage bug shows up as a mismatch.
+
+#include "Grid/Grid.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+
+	constexpr float WORLD_SIZE = 2048.0f;
+	constexpr size_t QUERY_COUNT = 20000;
+	constexpr float MOVE_STEP = 4.0f;
+	constexpr size_t MOVE_ROUNDS = 20; // Each round moves every entity out and back
+
+	// ============================================================
+	// LEGACY GRID (pre-dense layout)
+	// ============================================================
+
+	struct LegacyHash
+	{
+		size_t operator()(const CellCoord& coord) const
+		{
+			return std::hash<int32_t>()(coord.x) ^ (std::hash<int32_t>()(coord.y) << 16);
+		}
+	};
+
+	struct LegacyMovement
+	{
+		Vec2 position;
+	};
+
+	struct LegacyEntity
+	{
+		std::shared_ptr<LegacyMovement> movement = std::make_shared<LegacyMovement>();
+	};
+
+	struct LegacyCell
+	{
+		std::unordered_set<EntityId> entities;
+		std::unordered_set<EntityId> players;
+	};
+
+	class LegacyGrid
+	{
+	public:
+		void AddEntity(EntityId id, Vec2 position, bool isPlayer)
+		{
+			auto& entity = m_Entities[id];
+			entity = std::make_unique<LegacyEntity>();
+			entity->movement->position = position;
+
+			LegacyCell& cell = GetOrCreateCell(Grid::PositionToCell(position));
+			cell.entities.insert(id);
+			if (isPlayer)
+				cell.players.insert(id);
+		}
+
+		void MoveEntity(EntityId id, Vec2 oldPos, Vec2 newPos, bool isPlayer)
+		{
+			m_Entities[id]->movement->position = newPos;
+
+			// Same dirty bookkeeping as Grid::MoveEntity so move cost compares like for like
+			m_DirtyFlags[id].position = true;
+			m_DirtyEntities.insert(id);
+
+			CellCoord oldCoord = Grid::PositionToCell(oldPos);
+			CellCoord newCoord = Grid::PositionToCell(newPos);
+			if (oldCoord == newCoord)
+				return;
+
+			LegacyCell& oldCell = GetOrCreateCell(oldCoord);
+			oldCell.entities.erase(id);
+			if (isPlayer)
+				oldCell.players.erase(id);
+
+			LegacyCell& newCell = GetOrCreateCell(newCoord);
+			newCell.entities.insert(id);
+			if (isPlayer)
+				newCell.players.insert(id);
+		}
+
+		void EndTick()
+		{
+			for (auto& [id, flags] : m_DirtyFlags)
+				flags.Clear();
+			m_DirtyEntities.clear();
+		}
+
+		void Query(Vec2 center, float radius, bool playersOnly, std::vector<EntityId>& out) const
+		{
+			float radiusSq = radius * radius;
+			CellCoord centerCell = Grid::PositionToCell(center);
+			int32_t cellRadius = static_cast<int32_t>(std::ceil(radius / GRID_CELL_SIZE)) + 1;
+
+			for (int32_t dx = -cellRadius; dx <= cellRadius; dx++)
+			{
+				for (int32_t dy = -cellRadius; dy <= cellRadius; dy++)
+				{
+					auto it = m_Cells.find(CellCoord{centerCell.x + dx, centerCell.y + dy});
+					if (it == m_Cells.end())
+						continue;
+
+					const auto& ids = playersOnly ? it->second->players : it->second->entities;
+					for (EntityId id : ids)
+					{
+						auto entityIt = m_Entities.find(id);
+						if (entityIt == m_Entities.end())
+							continue;
+
+						auto movement = entityIt->second->movement;
+						if (!movement)
+							continue;
+
+						if (Vec2::DistanceSquared(center, movement->position) <= radiusSq)
+							out.push_back(id);
+					}
+				}
+			}
+		}
+
+	private:
+		LegacyCell& GetOrCreateCell(CellCoord coord)
+		{
+			auto& cell = m_Cells[coord];
+			if (!cell)
+				cell = std::make_unique<LegacyCell>();
+			return *cell;
+		}
+
+		std::unordered_map<CellCoord, std::unique_ptr<LegacyCell>, LegacyHash> m_Cells;
+		std::unordered_map<EntityId, std::unique_ptr<LegacyEntity>> m_Entities;
+		std::unordered_map<EntityId, DirtyFlags> m_DirtyFlags;
+		std::unordered_set<EntityId> m_DirtyEntities;
+	};
+
+	// ============================================================
+	// HARNESS
+	// ============================================================
+
+	struct Scenario
+	{
+		std::vector<Vec2> positions;
+		std::vector<Vec2> moved;
+		std::vector<bool> isPlayer;
+		std::vector<size_t> sameCell; // Entities whose move stays in their cell
+		std::vector<Vec2> queryCenters;
+	};
+
+	Scenario BuildScenario(size_t entityCount, uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> coord(0.0f, WORLD_SIZE);
+		std::uniform_real_distribution<float> step(-MOVE_STEP, MOVE_STEP);
+
+		Scenario s;
+		s.positions.reserve(entityCount);
+		s.moved.reserve(entityCount);
+		s.isPlayer.reserve(entityCount);
+		for (size_t i = 0; i < entityCount; i++)
+		{
+			Vec2 p(coord(rng), coord(rng));
+			s.positions.push_back(p);
+			s.moved.push_back(Vec2(p.x + step(rng), p.y + step(rng)));
+			s.isPlayer.push_back(i % 10 == 0);
+			if (Grid::PositionToCell(s.positions.back()) == Grid::PositionToCell(s.moved.back()))
+				s.sameCell.push_back(i);
+		}
+		for (size_t i = 0; i < QUERY_COUNT; i++)
+		{
+			s.queryCenters.push_back(Vec2(coord(rng), coord(rng)));
+		}
+		return s;
+	}
+
+	struct Timings
+	{
+		double entityQueryNs = 0.0;
+		double playerQueryNs = 0.0;
+		double moveNs = 0.0;
+		double sameCellMoveNs = 0.0;
+		uint64_t entityHits = 0;
+		uint64_t playerHits = 0;
+	};
+
+	template <typename QueryFn, typename MoveFn, typename TickFn>
+	Timings Measure(const Scenario& s, QueryFn&& query, MoveFn&& move, TickFn&& endTick)
+	{
+		Timings t;
+		std::vector<EntityId> out;
+		out.reserve(4096);
+
+		auto start = Clock::now();
+		for (const Vec2& center : s.queryCenters)
+		{
+			out.clear();
+			query(center, false, out);
+			t.entityHits += out.size();
+		}
+		t.entityQueryNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / s.queryCenters.size();
+
+		start = Clock::now();
+		for (const Vec2& center : s.queryCenters)
+		{
+			out.clear();
+			query(center, true, out);
+			t.playerHits += out.size();
+		}
+		t.playerQueryNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / s.queryCenters.size();
+
+		start = Clock::now();
+		for (size_t round = 0; round < MOVE_ROUNDS; round++)
+		{
+			for (size_t i = 0; i < s.positions.size(); i++)
+			{
+				move(static_cast<EntityId>(i + 1), s.positions[i], s.moved[i], s.isPlayer[i]);
+			}
+			endTick();
+			for (size_t i = 0; i < s.positions.size(); i++)
+			{
+				move(static_cast<EntityId>(i + 1), s.moved[i], s.positions[i], s.isPlayer[i]);
+			}
+			endTick();
+		}
+		t.moveNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+				   (s.positions.size() * MOVE_ROUNDS * 2);
+
+		start = Clock::now();
+		for (size_t round = 0; round < MOVE_ROUNDS; round++)
+		{
+			for (size_t i : s.sameCell)
+			{
+				move(static_cast<EntityId>(i + 1), s.positions[i], s.moved[i], s.isPlayer[i]);
+			}
+			endTick();
+			for (size_t i : s.sameCell)
+			{
+				move(static_cast<EntityId>(i + 1), s.moved[i], s.positions[i], s.isPlayer[i]);
+			}
+			endTick();
+		}
+		t.sameCellMoveNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+						   (s.sameCell.size() * MOVE_ROUNDS * 2);
+		return t;
+	}
+
+	bool RunCase(size_t entityCount)
+	{
+		Scenario s = BuildScenario(entityCount, 1337u + static_cast<uint32_t>(entityCount));
+
+		LegacyGrid legacy;
+		Grid grid(nullptr);
+		grid.ReserveBounds(Vec2(0.0f, 0.0f), Vec2(WORLD_SIZE, WORLD_SIZE));
+		for (size_t i = 0; i < entityCount; i++)
+		{
+			EntityId id = static_cast<EntityId>(i + 1);
+			legacy.AddEntity(id, s.positions[i], s.isPlayer[i]);
+			grid.AddEntity(id, s.positions[i], s.isPlayer[i]);
+		}
+
+		Timings old = Measure(
+			s,
+			[&](Vec2 c, bool players, std::vector<EntityId>& out) { legacy.Query(c, VIEW_DISTANCE, players, out); },
+			[&](EntityId id, Vec2 from, Vec2 to, bool player) { legacy.MoveEntity(id, from, to, player); },
+			[&] { legacy.EndTick(); });
+
+		Timings cur = Measure(
+			s,
+			[&](Vec2 c, bool players, std::vector<EntityId>& out) {
+				if (players)
+					grid.GetPlayersInRadius(c, VIEW_DISTANCE, out);
+				else
+					grid.GetEntitiesInRadius(c, VIEW_DISTANCE, out);
+			},
+			[&](EntityId id, Vec2, Vec2 to, bool player) { grid.MoveEntity(id, to, player); },
+			[&] {
+				grid.ClearAllDirtyFlags();
+				grid.ClearVisibilityChanges();
+			});
+
+		bool match = old.entityHits == cur.entityHits && old.playerHits == cur.playerHits;
+
+		auto row = [](const char* name, const Timings& t) {
+			std::cout << "  " << std::left << std::setw(8) << name << std::right
+					  << std::setw(12) << t.entityQueryNs
+					  << std::setw(12) << t.playerQueryNs
+					  << std::setw(10) << t.moveNs
+					  << std::setw(12) << t.sameCellMoveNs << '\n';
+		};
+
+		std::cout << entityCount << " entities (avg " << std::setprecision(1)
+				  << static_cast<double>(old.entityHits) / QUERY_COUNT << " hits/query)"
+				  << (match ? "" : "  ** RESULT MISMATCH **") << '\n';
+		std::cout << "  " << std::left << std::setw(8) << "layout" << std::right
+				  << std::setw(12) << "entity ns" << std::setw(12) << "player ns"
+				  << std::setw(10) << "move ns" << std::setw(12) << "in-cell ns" << '\n';
+		row("legacy", old);
+		row("current", cur);
+		std::cout << "  speedup " << std::setw(11) << old.entityQueryNs / cur.entityQueryNs << "x"
+				  << std::setw(11) << old.playerQueryNs / cur.playerQueryNs << "x"
+				  << std::setw(9) << old.moveNs / cur.moveNs << "x"
+				  << std::setw(11) << old.sameCellMoveNs / cur.sameCellMoveNs << "x\n\n";
+		return match;
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "Grid query benchmark: " << QUERY_COUNT << " queries at radius " << MMO::VIEW_DISTANCE
+			  << " on a " << WORLD_SIZE << "x" << WORLD_SIZE << " map\n\n";
+
+	bool ok = true;
+	for (size_t count : {size_t(1000), size_t(10000), size_t(50000)})
+	{
+		ok &= RunCase(count);
+	}
+	return ok ? 0 : 1;
+}
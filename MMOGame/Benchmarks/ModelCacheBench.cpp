@@ -0,0 +1,367 @@
+// Benchmark + consistency check: Onyx::ModelCache against a fresh Assimp import.
+//
+// Times what AssetManager's loader thread does per model two ways:
+//   - miss: Model::ParseFromFile (Assimp with the engine's post-processing)
+//     and the merge into one vertex/index stream with a LOD chain per mesh,
+//     as AssetManager::MergeMeshes does (copied here, it is private);
+//   - hit: hash the source file and read the cache entry back.
+// Then checks that the hit returns the miss's data byte for byte (vertices,
+// indices with every LOD range, mesh infos, bounds, texture paths), that a
+// corrupt entry is rejected and rewritten, and that editing the source or
+// its .mtl misses. With a skinned model on the command line, the animated
+// entry must bring back the same meshes, skeleton and clips.
+//
+// Without arguments the source is a generated OBJ (64 spheres, ~1M
+// triangles) with a one-material .mtl. CPU only; needs no GL context. Exits non-zero on mismatch.
+//
+// Usage: ModelCacheBench [model file]
+
+#include <Graphics/AnimatedModel.h>
+#include <Graphics/MeshSimplifier.h>
+#include <Graphics/Model.h>
+#include <Graphics/ModelCache.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace Onyx;
+
+	constexpr int SPHERES = 64;
+	constexpr int RINGS = 64;
+	constexpr int SEGMENTS = 128;
+	constexpr int MISS_RUNS = 3;
+	constexpr int HIT_RUNS = 10;
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	void WriteSpheresMtl(const std::string& path, const char* diffuseTexture)
+	{
+		std::ofstream(path) << "newmtl Stone\nKd 0.8 0.8 0.8\nmap_Kd " << diffuseTexture << "\n";
+	}
+
+	// One object per sphere so the import has meshes to merge and LOD; the
+	// material library sits next to it as spheres.mtl
+	void WriteSpheresObj(const std::string& path)
+	{
+		std::ofstream file(path);
+		file << std::fixed << std::setprecision(5);
+		file << "mtllib spheres.mtl\n";
+		int vertexBase = 1;
+		for (int sphere = 0; sphere < SPHERES; sphere++)
+		{
+			const float cx = static_cast<float>(sphere % 8) * 3.0f;
+			const float cz = static_cast<float>(sphere / 8) * 3.0f;
+			file << "o Sphere" << sphere << "\nusemtl Stone\n";
+			for (int ring = 0; ring <= RINGS; ring++)
+			{
+				const float phi = 3.14159265f * static_cast<float>(ring) / RINGS;
+				for (int segment = 0; segment <= SEGMENTS; segment++)
+				{
+					const float theta = 6.28318531f * static_cast<float>(segment) / SEGMENTS;
+					const float x = std::sin(phi) * std::cos(theta);
+					const float y = std::cos(phi);
+					const float z = std::sin(phi) * std::sin(theta);
+					file << "v " << cx + x << ' ' << y << ' ' << cz + z << "\n";
+					file << "vt " << static_cast<float>(segment) / SEGMENTS << ' ' << static_cast<float>(ring) / RINGS << "\n";
+				}
+			}
+			for (int ring = 0; ring < RINGS; ring++)
+			{
+				for (int segment = 0; segment < SEGMENTS; segment++)
+				{
+					const int a = vertexBase + ring * (SEGMENTS + 1) + segment;
+					const int b = a + SEGMENTS + 1;
+					file << "f " << a << '/' << a << ' ' << b << '/' << b << ' ' << a + 1 << '/' << a + 1 << "\n";
+					file << "f " << a + 1 << '/' << a + 1 << ' ' << b << '/' << b << ' ' << b + 1 << '/' << b + 1 << "\n";
+				}
+			}
+			vertexBase += (RINGS + 1) * (SEGMENTS + 1);
+		}
+	}
+
+	// AssetManager::MergeMeshes<MeshVertex>
+	void MergeStatic(const std::vector<CpuMeshData>& meshes, MergedMeshData& out)
+	{
+		uint32_t totalVerts = 0, totalIndices = 0;
+		for (const auto& mesh : meshes)
+		{
+			totalVerts += static_cast<uint32_t>(mesh.vertices.size());
+			totalIndices += static_cast<uint32_t>(mesh.indices.size());
+		}
+		out.totalVertices = totalVerts;
+		out.totalIndices = totalIndices;
+		out.vertexData.resize(totalVerts * sizeof(MeshVertex));
+		out.indexData.resize(totalIndices * sizeof(uint32_t));
+
+		std::vector<uint32_t> lodIndices;
+		size_t vOff = 0, iOff = 0;
+		uint32_t vertexOffset = 0, indexOffset = 0;
+		for (const auto& mesh : meshes)
+		{
+			MergedMeshInfo info;
+			info.indexCount = static_cast<uint32_t>(mesh.indices.size());
+			info.firstIndex = indexOffset;
+			info.baseVertex = static_cast<int32_t>(vertexOffset);
+			info.lods[0] = {info.firstIndex, info.indexCount, 0.0f};
+			info.lodCount = BuildMeshLods(reinterpret_cast<const uint8_t*>(mesh.vertices.data()),
+										  mesh.vertices.size(), sizeof(MeshVertex), mesh.indices.data(),
+										  mesh.indices.size(), totalIndices + static_cast<uint32_t>(lodIndices.size()),
+										  lodIndices, info.lods);
+			out.meshInfos.push_back(info);
+
+			MeshBoundsInfo bounds;
+			bounds.name = mesh.name;
+			bounds.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+			bounds.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+			for (const auto& v : mesh.vertices)
+			{
+				glm::vec3 p(v.position[0], v.position[1], v.position[2]);
+				bounds.boundsMin = glm::min(bounds.boundsMin, p);
+				bounds.boundsMax = glm::max(bounds.boundsMax, p);
+			}
+			out.meshBounds.push_back(bounds);
+			out.meshTextures.push_back(mesh.texturePaths);
+
+			size_t vBytes = mesh.vertices.size() * sizeof(MeshVertex);
+			std::memcpy(out.vertexData.data() + vOff, mesh.vertices.data(), vBytes);
+			vOff += vBytes;
+			size_t iBytes = mesh.indices.size() * sizeof(uint32_t);
+			std::memcpy(out.indexData.data() + iOff, mesh.indices.data(), iBytes);
+			iOff += iBytes;
+
+			vertexOffset += static_cast<uint32_t>(mesh.vertices.size());
+			indexOffset += static_cast<uint32_t>(mesh.indices.size());
+		}
+
+		out.indexData.resize(out.indexData.size() + lodIndices.size() * sizeof(uint32_t));
+		std::memcpy(out.indexData.data() + iOff, lodIndices.data(), lodIndices.size() * sizeof(uint32_t));
+		out.totalIndices += static_cast<uint32_t>(lodIndices.size());
+	}
+
+	bool SameStatic(const MergedMeshData& a, const MergedMeshData& b)
+	{
+		if (a.vertexData != b.vertexData || a.indexData != b.indexData || a.totalVertices != b.totalVertices
+			|| a.totalIndices != b.totalIndices || a.meshInfos.size() != b.meshInfos.size()
+			|| a.meshBounds.size() != b.meshBounds.size() || a.meshTextures.size() != b.meshTextures.size())
+			return false;
+
+		for (size_t i = 0; i < a.meshInfos.size(); i++)
+		{
+			const MergedMeshInfo& x = a.meshInfos[i];
+			const MergedMeshInfo& y = b.meshInfos[i];
+			if (x.indexCount != y.indexCount || x.firstIndex != y.firstIndex || x.baseVertex != y.baseVertex
+				|| x.lodCount != y.lodCount || std::memcmp(x.lods, y.lods, sizeof(MeshLod) * x.lodCount) != 0)
+				return false;
+			if (a.meshBounds[i].name != b.meshBounds[i].name
+				|| std::memcmp(&a.meshBounds[i].boundsMin, &b.meshBounds[i].boundsMin, sizeof(glm::vec3)) != 0
+				|| std::memcmp(&a.meshBounds[i].boundsMax, &b.meshBounds[i].boundsMax, sizeof(glm::vec3)) != 0)
+				return false;
+			if (a.meshTextures[i].size() != b.meshTextures[i].size())
+				return false;
+			for (size_t t = 0; t < a.meshTextures[i].size(); t++)
+			{
+				if (a.meshTextures[i][t].type != b.meshTextures[i][t].type || a.meshTextures[i][t].path != b.meshTextures[i][t].path)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	bool SameAnimated(const AnimatedModel& a, const AnimatedModel& b)
+	{
+		if (a.GetMeshes().size() != b.GetMeshes().size() || a.GetMaterials().size() != b.GetMaterials().size()
+			|| a.GetSkeleton().GetBoneCount() != b.GetSkeleton().GetBoneCount()
+			|| a.GetAnimationCount() != b.GetAnimationCount() || a.GetNodeHierarchy().size() != b.GetNodeHierarchy().size())
+			return false;
+
+		for (size_t i = 0; i < a.GetMeshes().size(); i++)
+		{
+			const SkinnedMesh& x = a.GetMeshes()[i];
+			const SkinnedMesh& y = b.GetMeshes()[i];
+			if (x.name != y.name || x.materialIndex != y.materialIndex || x.indices != y.indices
+				|| x.vertices.size() != y.vertices.size()
+				|| std::memcmp(x.vertices.data(), y.vertices.data(), x.vertices.size() * sizeof(SkinnedVertex)) != 0)
+				return false;
+		}
+		for (size_t i = 0; i < a.GetMaterials().size(); i++)
+		{
+			const AnimatedMaterial& x = a.GetMaterials()[i];
+			const AnimatedMaterial& y = b.GetMaterials()[i];
+			if (x.name != y.name || x.diffuseTexturePath != y.diffuseTexturePath
+				|| x.normalTexturePath != y.normalTexturePath || x.specularTexturePath != y.specularTexturePath)
+				return false;
+		}
+		for (int i = 0; i < a.GetSkeleton().GetBoneCount(); i++)
+		{
+			const Bone* x = a.GetSkeleton().GetBone(i);
+			const Bone* y = b.GetSkeleton().GetBone(i);
+			if (x->name != y->name || x->parentIndex != y->parentIndex
+				|| std::memcmp(&x->offsetMatrix, &y->offsetMatrix, sizeof(glm::mat4)) != 0
+				|| std::memcmp(&x->localBindTransform, &y->localBindTransform, sizeof(glm::mat4)) != 0)
+				return false;
+		}
+		for (int i = 0; i < a.GetAnimationCount(); i++)
+		{
+			const auto& x = a.GetAnimations()[i];
+			const auto& y = b.GetAnimations()[i];
+			if (x->GetName() != y->GetName() || x->GetDuration() != y->GetDuration()
+				|| x->GetBoneAnimations().size() != y->GetBoneAnimations().size())
+				return false;
+		}
+		return a.GetRig().GetBoneCount() == b.GetRig().GetBoneCount();
+	}
+
+	std::string EntryPath(const ModelCache& cache, uint64_t key)
+	{
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+		return cache.GetDirectory() + "/" + name + ModelCache::EXTENSION;
+	}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	std::cout << std::fixed << std::setprecision(2);
+	bool ok = true;
+	auto fail = [&](const char* what) {
+		std::cout << "  ** FAILED: " << what << " **\n";
+		ok = false;
+	};
+
+	const std::filesystem::path workDir = std::filesystem::temp_directory_path() / "ModelCacheBench";
+	std::filesystem::remove_all(workDir);
+	std::filesystem::create_directories(workDir);
+
+	std::string source;
+	if (argc > 1)
+	{
+		source = argv[1];
+	}
+	else
+	{
+		source = (workDir / "spheres.obj").string();
+		WriteSpheresObj(source);
+		WriteSpheresMtl((workDir / "spheres.mtl").string(), "stone.png");
+	}
+
+	ModelCache cache;
+	cache.SetDirectory((workDir / "Cache").string());
+
+	// --- Static: miss (Assimp + merge) vs hit (hash + entry read) ---
+	MergedMeshData imported;
+	double missMs = 1e30;
+	for (int run = 0; run < MISS_RUNS; run++)
+	{
+		const auto start = Clock::now();
+		std::string directory;
+		std::vector<CpuMeshData> meshes = Model::ParseFromFile(source, directory, true);
+		MergedMeshData merged;
+		MergeStatic(meshes, merged);
+		missMs = std::min(missMs, MsSince(start));
+		imported = std::move(merged);
+	}
+	if (imported.meshInfos.empty())
+	{
+		std::cout << "  could not import " << source << "\n";
+		return 1;
+	}
+
+	const uint64_t key = ModelCache::MakeKey(cache.HashSource(source), ModelCache::Kind::Static);
+	MergedMeshData cached;
+	if (cache.LoadStatic(key, cached))
+		fail("hit in an empty cache");
+	cache.StoreStatic(key, imported);
+
+	double hitMs = 1e30;
+	bool same = true;
+	for (int run = 0; run < HIT_RUNS; run++)
+	{
+		const auto start = Clock::now();
+		MergedMeshData loaded;
+		const bool hit = cache.LoadStatic(ModelCache::MakeKey(cache.HashSource(source), ModelCache::Kind::Static), loaded);
+		hitMs = std::min(hitMs, MsSince(start));
+		same = same && hit && SameStatic(imported, loaded);
+	}
+
+	const double entryMb = std::filesystem::file_size(EntryPath(cache, key)) / (1024.0 * 1024.0);
+	std::cout << source << ": " << imported.meshInfos.size() << " meshes, " << imported.totalVertices
+			  << " vertices, " << imported.totalIndices << " indices with LODs\n\n";
+	std::cout << "  path      best ms\n";
+	std::cout << "  miss   " << std::setw(10) << missMs << "   (Assimp import + merge + LODs, best of " << MISS_RUNS << ")\n";
+	std::cout << "  hit    " << std::setw(10) << hitMs << "   (hash + " << entryMb << " MB entry, best of " << HIT_RUNS << ")\n";
+	std::cout << "  speedup " << std::setw(8) << missMs / hitMs << "x\n\n";
+	if (!same)
+		fail("cached static data differs from the import");
+
+	// --- Corrupt entry: rejected, then replaced by the next store ---
+	{
+		std::fstream file(EntryPath(cache, key), std::ios::in | std::ios::out | std::ios::binary);
+		const uint32_t badVersion = ModelCache::VERSION + 1;
+		file.seekp(4);
+		file.write(reinterpret_cast<const char*>(&badVersion), sizeof(badVersion));
+	}
+	const uint32_t rejectedBefore = cache.GetStats().rejected;
+	MergedMeshData loaded;
+	if (cache.LoadStatic(key, loaded) || cache.GetStats().rejected != rejectedBefore + 1)
+		fail("corrupt entry not rejected");
+	cache.StoreStatic(key, imported);
+	if (!cache.LoadStatic(key, loaded) || !SameStatic(imported, loaded))
+		fail("rewritten entry does not load");
+
+	// --- Editing the source or its material library changes the key ---
+	if (argc <= 1)
+	{
+		WriteSpheresMtl((workDir / "spheres.mtl").string(), "moss.png");
+		if (cache.LoadStatic(ModelCache::MakeKey(cache.HashSource(source), ModelCache::Kind::Static), loaded))
+			fail("edited .mtl still hits");
+
+		std::ofstream(source, std::ios::app) << "# edited\n";
+		if (cache.LoadStatic(ModelCache::MakeKey(cache.HashSource(source), ModelCache::Kind::Static), loaded))
+			fail("edited source still hits");
+	}
+
+	// --- Animated entry, for a skinned model given on the command line ---
+	if (argc > 1)
+	{
+		const uint64_t animKey = ModelCache::MakeKey(cache.HashSource(source), ModelCache::Kind::Animated);
+		auto start = Clock::now();
+		std::unique_ptr<AnimatedModel> parsed = AnimatedModel::ParseFromFile(source);
+		const double parseMs = MsSince(start);
+		const bool animated = parsed && parsed->GetAnimationCount() > 0;
+		cache.StoreAnimated(animKey, animated ? parsed.get() : nullptr);
+
+		start = Clock::now();
+		std::unique_ptr<AnimatedModel> restored;
+		const bool hit = cache.LoadAnimated(animKey, source, restored);
+		const double loadMs = MsSince(start);
+
+		std::cout << "  animated: " << (animated ? "yes" : "no") << ", parse " << parseMs << " ms, cache "
+				  << loadMs << " ms\n";
+		if (!hit || animated != (restored != nullptr) || (animated && !SameAnimated(*parsed, *restored)))
+			fail("cached animated model differs from the import");
+	}
+
+	const ModelCacheStats stats = cache.GetStats();
+	std::cout << "  cache: " << stats.hits << " hits, " << stats.misses << " misses (" << stats.rejected
+			  << " rejected), " << stats.stores << " stores\n";
+
+	std::filesystem::remove_all(workDir);
+	return ok ? 0 : 1;
+}
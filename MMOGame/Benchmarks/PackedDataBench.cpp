@@ -0,0 +1,302 @@
+// Benchmark: cold zone load from loose Data/ files vs a mounted data.opak.
+//
+// Generates a runtime Data/ tree like ExportForRuntime writes (GRID x GRID
+// chunk files for one map plus MODEL_COUNT .omdl models), packs it with
+// PackWriter, then loads the zone the way the client does: list the chunk
+// directory, LoadChunkFile every chunk, ReadOmdl every model and touch its
+// vertex/index blobs (what glBufferData would read).
+//
+// loose  = one open + read per file, as before the pack existed.
+// packed = PackFileSystem mounted over the same paths: one mapping, index
+//          lookups, LZ-decoded chunks, zero-copy models.
+//
+// "Cold" drops the files from the page cache before each run with
+// posix_fadvise(DONTNEED), which needs no privileges but only works on Linux;
+// elsewhere the numbers are warm-cache. Pass a directory to generate into
+// (default: a temp dir, removed afterwards).
+// Loaded heights and blob bytes are checksummed so a pack bug shows up as a
+// mismatch.
+
+#include "Model/OmdlReader.h"
+#include "Model/OmdlWriter.h"
+#include "Pack/PackFile.h"
+#include "Pack/PackWriter.h"
+#include "Terrain/ChunkFileWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+	namespace fs = std::filesystem;
+
+	constexpr int GRID = 24; // Chunks per side
+	constexpr int MODEL_COUNT = 64;
+	constexpr uint32_t MODEL_VERTICES = 6000;
+	constexpr int RUNS = 5;
+	constexpr uint32_t MAP_ID = 1;
+
+	struct LoadResult
+	{
+		double ms = 0.0;
+		size_t files = 0;
+		uint64_t checksum = 0;
+	};
+
+	std::string ChunksDir(const fs::path& root)
+	{
+		char buf[32];
+		snprintf(buf, sizeof(buf), "maps/%03u/chunks", MAP_ID);
+		return (root / buf).generic_string();
+	}
+
+	void GenerateData(const fs::path& dataDir)
+	{
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+
+		fs::create_directories(ChunksDir(dataDir));
+		for (int cz = 0; cz < GRID; cz++)
+		{
+			for (int cx = 0; cx < GRID; cx++)
+			{
+				// Rolling hills + a little noise: compresses like sculpted terrain
+				ChunkFileData data;
+				data.mapId = MAP_ID;
+				data.terrain.heightmap.resize(TERRAIN_CHUNK_HEIGHTMAP_SIZE);
+				for (size_t i = 0; i < data.terrain.heightmap.size(); i++)
+				{
+					data.terrain.heightmap[i] = std::sin(float(cx * 7 + i % 97) * 0.05f) * 20.0f + noise(rng);
+				}
+				data.terrain.splatmap.assign(TERRAIN_SPLATMAP_TEXELS * 8, 0);
+				for (size_t i = 0; i < data.terrain.splatmap.size(); i += 8)
+				{
+					data.terrain.splatmap[i] = 255;
+				}
+				for (int o = 0; o < 8; o++)
+				{
+					ChunkObjectData object;
+					object.modelPath = "models/model_" + std::to_string((cx * 31 + cz * 17 + o) % MODEL_COUNT) + ".omdl";
+					object.position[0] = float(cx * 64 + o * 8);
+					object.position[2] = float(cz * 64);
+					data.objects.push_back(object);
+				}
+
+				const std::string path =
+					ChunksDir(dataDir) + "/chunk_" + std::to_string(cx) + "_" + std::to_string(cz) + ".chunk";
+				WriteChunkFile(path, data, cx, cz);
+			}
+		}
+
+		fs::create_directories(dataDir / "models");
+		for (int m = 0; m < MODEL_COUNT; m++)
+		{
+			OmdlData model;
+			model.header.meshCount = 1;
+			model.header.totalVertices = MODEL_VERTICES;
+			model.header.totalIndices = MODEL_VERTICES * 3;
+			model.vertexBlob.resize(size_t(MODEL_VERTICES) * OMDL_VERTEX_BYTES);
+			for (auto& byte : model.vertexBlob)
+			{
+				byte = static_cast<uint8_t>(rng());
+			}
+			model.indexBlob.resize(size_t(model.header.totalIndices) * 4);
+			auto* indices = reinterpret_cast<uint32_t*>(model.indexBlob.data());
+			for (uint32_t i = 0; i < model.header.totalIndices; i++)
+			{
+				indices[i] = rng() % MODEL_VERTICES;
+			}
+			OmdlMeshInfo mesh;
+			mesh.indexCount = model.header.totalIndices;
+			mesh.albedoPath = "textures/model_" + std::to_string(m) + ".png";
+			model.meshes.push_back(mesh);
+
+			WriteOmdl((dataDir / "models" / ("model_" + std::to_string(m) + ".omdl")).string(), model);
+		}
+	}
+
+	void DropFromPageCache(const fs::path& dataDir)
+	{
+#if defined(__linux__)
+		for (const auto& entry : fs::recursive_directory_iterator(dataDir))
+		{
+			if (!entry.is_regular_file())
+				continue;
+			int fd = ::open(entry.path().c_str(), O_RDONLY);
+			if (fd < 0)
+				continue;
+			fdatasync(fd);
+			posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+			close(fd);
+		}
+#else
+		(void)dataDir;
+#endif
+	}
+
+	uint64_t Mix(uint64_t hash, uint64_t value)
+	{
+		return (hash ^ value) * 0x100000001B3ull;
+	}
+
+	// The client's zone load: directory listing, chunks, then every model
+	LoadResult LoadZone(const fs::path& dataDir, bool packed)
+	{
+		LoadResult result;
+		const auto start = Clock::now();
+
+		const std::string chunksDir = ChunksDir(dataDir);
+		std::vector<std::string> chunkPaths;
+		if (packed)
+		{
+			chunkPaths = PackFileSystem::List(chunksDir);
+		}
+		else
+		{
+			for (const auto& entry : fs::directory_iterator(chunksDir))
+			{
+				chunkPaths.push_back(entry.path().generic_string());
+			}
+			std::sort(chunkPaths.begin(), chunkPaths.end());
+		}
+
+		for (const auto& path : chunkPaths)
+		{
+			ChunkFileData data;
+			if (!LoadChunkFile(path, data))
+				continue;
+			result.files++;
+			for (float h : data.terrain.heightmap)
+			{
+				result.checksum = Mix(result.checksum, static_cast<uint64_t>(static_cast<int64_t>(h * 1000.0f)));
+			}
+			result.checksum = Mix(result.checksum, data.objects.size());
+		}
+
+		for (int m = 0; m < MODEL_COUNT; m++)
+		{
+			OmdlMapped model;
+			if (!ReadOmdl((dataDir / "models" / ("model_" + std::to_string(m) + ".omdl")).generic_string(), model))
+				continue;
+			result.files++;
+
+			// Stand-in for the GPU upload: read every page of both blobs
+			const auto* vertices = static_cast<const uint8_t*>(model.vertexData);
+			const auto* indices = static_cast<const uint8_t*>(model.indexData);
+			uint64_t sum = 0;
+			for (size_t i = 0; i < model.vertexBytes; i += 64)
+			{
+				sum += vertices[i];
+			}
+			for (size_t i = 0; i < model.indexBytes; i += 64)
+			{
+				sum += indices[i];
+			}
+			result.checksum = Mix(result.checksum, sum);
+		}
+
+		result.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		return result;
+	}
+
+	double Median(std::vector<double> values)
+	{
+		std::sort(values.begin(), values.end());
+		return values[values.size() / 2];
+	}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	const bool tempDir = argc < 2;
+	const fs::path root = tempDir ? fs::temp_directory_path() / "onyx_packed_bench" : fs::path(argv[1]);
+	const fs::path dataDir = root / "Data";
+	fs::remove_all(dataDir);
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "Packed data benchmark: " << GRID * GRID << " chunks + " << MODEL_COUNT << " models in "
+			  << dataDir.string() << "\n";
+
+	GenerateData(dataDir);
+
+	PackWriter writer;
+	writer.AddDirectory(dataDir.string());
+	PackWriteStats stats;
+	std::string error;
+	const fs::path packPath = dataDir / "data.opak";
+	if (!writer.Write(packPath.string(), {}, &stats, &error))
+	{
+		std::cerr << "Pack failed: " << error << "\n";
+		return 1;
+	}
+	std::cout << "Pack: " << stats.files << " files (" << stats.compressedFiles << " compressed), "
+			  << stats.rawBytes / 1024 << " KB -> " << stats.packBytes / 1024 << " KB\n";
+#if !defined(__linux__)
+	std::cout << "(no page-cache control on this platform: timings are warm)\n";
+#endif
+	std::cout << "\n";
+
+	std::vector<double> looseTimes;
+	std::vector<double> packedTimes;
+	LoadResult loose;
+	LoadResult packed;
+	for (int run = 0; run < RUNS; run++)
+	{
+		DropFromPageCache(dataDir);
+		loose = LoadZone(dataDir, false);
+		looseTimes.push_back(loose.ms);
+
+		// Mounting is part of the cold cost
+		DropFromPageCache(dataDir);
+		const auto mountStart = Clock::now();
+		if (!PackFileSystem::Mount(packPath.string(), dataDir.generic_string(), &error))
+		{
+			std::cerr << "Mount failed: " << error << "\n";
+			return 1;
+		}
+		const double mountMs = std::chrono::duration<double, std::milli>(Clock::now() - mountStart).count();
+		packed = LoadZone(dataDir, true);
+		packed.ms += mountMs;
+		packedTimes.push_back(packed.ms);
+		PackFileSystem::UnmountAll();
+	}
+
+	const double looseMs = Median(looseTimes);
+	const double packedMs = Median(packedTimes);
+	std::cout << std::left << std::setw(10) << "mode" << std::right << std::setw(10) << "files" << std::setw(14)
+			  << "median ms" << "\n";
+	std::cout << std::left << std::setw(10) << "loose" << std::right << std::setw(10) << loose.files << std::setw(14)
+			  << looseMs << "\n";
+	std::cout << std::left << std::setw(10) << "packed" << std::right << std::setw(10) << packed.files << std::setw(14)
+			  << packedMs << "  (" << looseMs / packedMs << "x)\n";
+
+	const bool match = loose.files == packed.files && loose.checksum == packed.checksum;
+	if (!match)
+	{
+		std::cerr << "MISMATCH: loose and packed loads differ\n";
+	}
+
+	if (tempDir)
+	{
+		fs::remove_all(root);
+	}
+	return match ? 0 : 1;
+}
@@ -0,0 +1,314 @@
+// Benchmark + consistency check: Onyx::ParticleSystem at 1M particles.
+//
+// Times a 60 Hz Update and the per-frame quad output two ways:
+//   - pool: the previous ParticleSystem, copied here: an array of Particle
+//     structs with an `active` flag, walked whole every Update and Render,
+//     one RenderQuadInstanced call per live particle;
+//   - SoA: the current ParticleSystem: live particles packed in structure-
+//     of-arrays form, integrated and interpolated four at a time, quads
+//     written straight into the instanced buffer by WriteQuads.
+// The budget is 4 ms for an Update of 1M particles on one core; whether it
+// is met is printed but does not affect the exit code.
+//
+// Checks that after every frame of a run where most particles die, the SoA
+// system holds exactly the pool's live particles (compared as their quad
+// records, bit for bit, in any order), and that a non-looping Rate emitter
+// emits what its rate and duration ask for, and that a removed emitter's
+// handle stays dead once its slot is reused.
+//
+// CPU only; needs no GL context. Exits non-zero on mismatch.
+
+#include <Graphics/ParticleSystem.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace Onyx;
+
+	constexpr uint32_t PARTICLES = 1000000;
+	constexpr int RUNS = 30;
+	constexpr float DT = 1.0f / 60.0f;
+	constexpr double UPDATE_BUDGET_MS = 4.0;
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	// The previous ParticleSystem, minus the renderer: Render writes what
+	// RenderQuadInstanced did for each particle
+	class PoolParticleSystem
+	{
+	public:
+		explicit PoolParticleSystem(uint32_t count) { m_ParticlePool.resize(count); }
+
+		void Update(float timestamp)
+		{
+			for (auto& particle : m_ParticlePool)
+			{
+				if (!particle.active)
+					continue;
+
+				if (particle.lifeRemaining <= 0.0f)
+				{
+					particle.active = false;
+					continue;
+				}
+
+				particle.position += {
+					particle.velocity.x * timestamp,
+					particle.velocity.y * timestamp};
+				particle.lifeRemaining -= timestamp;
+			}
+		}
+
+		// `liveOnly` skips particles whose life ran out this Update: the old
+		// system drew those one more frame before retiring them
+		uint32_t Render(QuadInstance* out, bool liveOnly)
+		{
+			uint32_t written = 0;
+			for (auto& particle : m_ParticlePool)
+			{
+				if (!particle.active || (liveOnly && particle.lifeRemaining <= 0.0f))
+					continue;
+
+				float life = particle.lifeRemaining / particle.lifetime;
+
+				particle.color = Onyx::lerp4D(particle.colorEnd, particle.colorBegin, life);
+				float size = Onyx::lerp(particle.sizeEnd, particle.sizeBegin, life);
+
+				QuadInstance* quad = out + written++;
+				quad->position = {particle.position.x * 2, particle.position.y * 2, 0.0f};
+				quad->rotation = particle.rotation;
+				quad->halfSize = {size, size};
+				quad->uvRect = {0.0f, 0.0f, 1.0f, 1.0f};
+				quad->color = PackQuadColor(particle.color);
+				quad->texIndex = -1.0f;
+			}
+			return written;
+		}
+
+		void Emit(const ParticleProperties& props)
+		{
+			Particle& particle = m_ParticlePool[m_PoolIndex];
+
+			particle.active = true;
+			particle.lifeRemaining = props.lifetime;
+			particle.lifetime = props.lifetime;
+
+			particle.position = props.position;
+			particle.rotation = props.rotation;
+
+			particle.velocity = props.velocity;
+			particle.velocity.x += props.velocityVariation.x * Onyx::ramdomInRange(-0.5f, 0.5f);
+			particle.velocity.y += props.velocityVariation.y * Onyx::ramdomInRange(-0.5f, 0.5f);
+
+			particle.sizeBegin = props.sizeBegin;
+			particle.sizeEnd = props.sizeEnd;
+
+			particle.color = props.color;
+			particle.colorBegin = props.colorBegin;
+			particle.colorEnd = props.colorEnd;
+
+			m_PoolIndex = (m_PoolIndex + 1) % m_ParticlePool.size();
+		}
+
+		static constexpr size_t BYTES_PER_PARTICLE = sizeof(Onyx::Vector2D) * 2 + sizeof(Onyx::Vector4D) * 3 + sizeof(float) * 5 + sizeof(bool);
+
+	private:
+		struct Particle
+		{
+			Onyx::Vector2D position, velocity;
+			Onyx::Vector4D color, colorBegin, colorEnd;
+
+			float sizeBegin, sizeEnd;
+			float rotation = 0.0f;
+
+			float lifetime = 1.0f;
+			float lifeRemaining = 1.0f;
+
+			bool active = false;
+		};
+
+		std::vector<Particle> m_ParticlePool;
+		size_t m_PoolIndex = 0;
+	};
+
+	std::vector<ParticleProperties> MakeProperties(uint32_t count, float minLifetime, float maxLifetime, uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		std::vector<ParticleProperties> properties(count);
+		for (ParticleProperties& props : properties)
+		{
+			props.position = {unit(rng) - 0.5f, unit(rng) - 0.5f};
+			props.velocity = {unit(rng) - 0.5f, unit(rng) - 0.5f};
+			props.velocityVariation = {0.2f, 0.2f};
+			props.colorBegin = {unit(rng), unit(rng), unit(rng), 1.0f};
+			props.colorEnd = {unit(rng), unit(rng), unit(rng), 0.0f};
+			props.color = props.colorBegin;
+			props.sizeBegin = 0.01f + unit(rng) * 0.02f;
+			props.sizeEnd = 0.0f;
+			props.sizeVariation = 0.0f;
+			props.rotation = unit(rng) * 360.0f;
+			props.lifetime = minLifetime + unit(rng) * (maxLifetime - minLifetime);
+		}
+		return properties;
+	}
+
+	// Emits the same particles into both, velocity variation included
+	void EmitBoth(const std::vector<ParticleProperties>& properties, PoolParticleSystem& pool, ParticleSystem& soa)
+	{
+		std::srand(7);
+		for (const ParticleProperties& props : properties)
+			pool.Emit(props);
+
+		std::srand(7);
+		for (const ParticleProperties& props : properties)
+			soa.Emit(props);
+	}
+
+	void SortRecords(std::vector<QuadInstance>& records, uint32_t count)
+	{
+		std::sort(records.begin(), records.begin() + count, [](const QuadInstance& a, const QuadInstance& b) {
+			return std::memcmp(&a, &b, sizeof(QuadInstance)) < 0;
+		});
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(2);
+	bool ok = true;
+	auto fail = [&](const char* what) {
+		std::cout << "  ** FAILED: " << what << " **\n";
+		ok = false;
+	};
+
+	std::vector<QuadInstance> poolQuads(PARTICLES), soaQuads(PARTICLES);
+
+	// --- Timing: best of RUNS, every particle alive throughout ---
+	{
+		const std::vector<ParticleProperties> properties = MakeProperties(PARTICLES, 100.0f, 200.0f, 2024);
+		PoolParticleSystem pool(PARTICLES);
+		ParticleSystem soa(PARTICLES);
+		EmitBoth(properties, pool, soa);
+
+		double poolUpdateMs = 1e30, poolRenderMs = 1e30, soaUpdateMs = 1e30, soaRenderMs = 1e30;
+		for (int run = 0; run < RUNS; run++)
+		{
+			auto start = Clock::now();
+			pool.Update(DT);
+			poolUpdateMs = std::min(poolUpdateMs, MsSince(start));
+
+			start = Clock::now();
+			pool.Render(poolQuads.data(), false);
+			poolRenderMs = std::min(poolRenderMs, MsSince(start));
+
+			start = Clock::now();
+			soa.Update(DT);
+			soaUpdateMs = std::min(soaUpdateMs, MsSince(start));
+
+			start = Clock::now();
+			soa.WriteQuads(soaQuads.data());
+			soaRenderMs = std::min(soaRenderMs, MsSince(start));
+		}
+
+		const size_t soaBytesPerParticle = sizeof(float) * 17 + sizeof(uint32_t);
+		std::cout << PARTICLES << " live particles, best of " << RUNS << " frames\n\n";
+		std::cout << "  system    Update ms   Render ms   bytes / particle\n";
+		std::cout << "  pool      " << std::setw(9) << poolUpdateMs << std::setw(12) << poolRenderMs
+				  << std::setw(19) << PoolParticleSystem::BYTES_PER_PARTICLE << "\n";
+		std::cout << "  SoA       " << std::setw(9) << soaUpdateMs << std::setw(12) << soaRenderMs
+				  << std::setw(19) << soaBytesPerParticle << "\n";
+		std::cout << "  speedup   " << std::setw(8) << poolUpdateMs / soaUpdateMs << "x" << std::setw(11)
+				  << poolRenderMs / soaRenderMs << "x\n";
+		// Reported only: timings depend on the machine, so they never fail the run
+		std::cout << "  Update budget " << UPDATE_BUDGET_MS << " ms: " << (soaUpdateMs <= UPDATE_BUDGET_MS ? "met" : "MISSED") << "\n\n";
+	}
+
+	// --- Consistency: same live particles as the pool after every frame ---
+	{
+		const std::vector<ParticleProperties> properties = MakeProperties(PARTICLES, 0.05f, 1.0f, 2025);
+		PoolParticleSystem pool(PARTICLES);
+		ParticleSystem soa(PARTICLES);
+		EmitBoth(properties, pool, soa);
+
+		uint32_t mismatchedFrames = 0;
+		uint32_t firstAlive = 0, lastAlive = 0;
+		const int frames = 64; // Past the longest lifetime
+		for (int frame = 0; frame < frames; frame++)
+		{
+			pool.Update(DT);
+			soa.Update(DT);
+
+			const uint32_t poolCount = pool.Render(poolQuads.data(), true);
+			const uint32_t soaCount = soa.GetAliveCount();
+			soa.WriteQuads(soaQuads.data());
+
+			if (frame == 0)
+				firstAlive = soaCount;
+			lastAlive = soaCount;
+
+			if (poolCount != soaCount)
+			{
+				mismatchedFrames++;
+				continue;
+			}
+
+			SortRecords(poolQuads, poolCount);
+			SortRecords(soaQuads, soaCount);
+			if (std::memcmp(poolQuads.data(), soaQuads.data(), soaCount * sizeof(QuadInstance)) != 0)
+				mismatchedFrames++;
+		}
+
+		std::cout << "  " << frames << " frames, live " << firstAlive << " -> " << lastAlive
+				  << ", frames differing from the pool: " << mismatchedFrames << "\n";
+		if (mismatchedFrames != 0)
+			fail("SoA live particles differ from the pool's");
+		if (lastAlive != 0)
+			fail("particles outlived their lifetime");
+	}
+
+	// --- Emitters: a non-looping Rate emitter ---
+	{
+		ParticleSystem soa(10000);
+		ParticleEmitterSettings settings;
+		settings.properties = MakeProperties(1, 100.0f, 100.0f, 1)[0];
+		settings.rate = 1200.0f;
+		settings.duration = 1.0f;
+		settings.looping = false;
+		const ParticleEmitterHandle emitter = soa.AddEmitter(settings);
+
+		for (int frame = 0; frame < 90; frame++)
+			soa.Update(DT);
+
+		std::cout << "  Rate emitter, 1200/s for 1 s: " << soa.GetAliveCount() << " emitted, "
+				  << (soa.IsPlaying(emitter) ? "still playing" : "stopped") << "\n";
+		if (soa.GetAliveCount() + 1 < 1200 || soa.GetAliveCount() > 1200 || soa.IsPlaying(emitter))
+			fail("Rate emitter count or stop");
+
+		// The new emitter takes the removed one's slot
+		soa.RemoveEmitter(emitter);
+		settings.looping = true;
+		const ParticleEmitterHandle reused = soa.AddEmitter(settings);
+		const bool staleResolves = soa.GetEmitterSettings(emitter) != nullptr || soa.IsPlaying(emitter);
+		std::cout << "  Removed emitter's handle after slot reuse: " << (staleResolves ? "still resolves" : "null") << "\n";
+		if (staleResolves || reused == emitter || !soa.IsPlaying(reused))
+			fail("stale emitter handle resolves");
+	}
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,514 @@
+// Benchmark + correctness check: creature pathfinding on the baked walk grid.
+//
+// Bakes a synthetic 8x8-chunk map (rooms walled off with doorways, scattered
+// crates and a sealed vault) through ServerTerrainBuilder, builds a NavGrid
+// over it and runs:
+//
+// reference = textbook A*, 8-way without corner cutting, octile costs.
+// JPS       = PathFinder::FindPath (jump points, string-pulled output).
+//
+// Checks: JPS finds a path exactly when the reference does, every returned
+// leg is walkable, the string-pulled length never exceeds the reference
+// grid cost, and budgeted async requests return the same paths as the
+// synchronous calls. Then simulates mobs chasing wandering players with
+// PathFollower under the per-tick step budget, against a naive per-mob A*
+// every tick. Exit code is non-zero on any failure.
+
+#include "Navigation/PathFinder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+
+	constexpr int CHUNKS_MIN = -4;
+	constexpr int CHUNKS_MAX = 3; // Inclusive: 8x8 chunks, 512x512 m
+	constexpr float MAP_MIN = CHUNKS_MIN * TERRAIN_CHUNK_SIZE;
+	constexpr float MAP_MAX = (CHUNKS_MAX + 1) * TERRAIN_CHUNK_SIZE;
+	constexpr int QUERY_COUNT = 1'000;
+	constexpr int PLAYER_COUNT = 200;
+	constexpr int MOBS_PER_PLAYER = 10;
+	constexpr int SIM_TICKS = 1200; // 60 s
+	constexpr int NAIVE_TICKS = 3;
+	constexpr float TICK_SECONDS = 0.05f;
+	constexpr float MOB_SPEED = 7.0f;
+	constexpr float PLAYER_SPEED = 3.0f;
+	constexpr float AGGRO_SPREAD = 60.0f; // Mobs spawn this far from their player
+	constexpr int AGGRO_TICKS = 200;	  // and start chasing within the first 10 s
+	constexpr float CAUGHT_DISTANCE = 3.0f;
+	constexpr int STUCK_TICKS = 40;
+	constexpr float VAULT_MIN = 100.0f;
+	constexpr float VAULT_MAX = 140.0f;
+
+	TerrainObstacle Box(float minX, float minZ, float maxX, float maxZ)
+	{
+		TerrainObstacle box;
+		box.centerX = (minX + maxX) * 0.5f;
+		box.centerZ = (minZ + maxZ) * 0.5f;
+		box.halfExtentX = (maxX - minX) * 0.5f;
+		box.halfExtentZ = (maxZ - minZ) * 0.5f;
+		box.bottom = -10.0f;
+		box.top = 10.0f;
+		return box;
+	}
+
+	void Build(ServerTerrainBuilder& builder, std::mt19937& rng)
+	{
+		for (int cz = CHUNKS_MIN; cz <= CHUNKS_MAX; cz++)
+		{
+			for (int cx = CHUNKS_MIN; cx <= CHUNKS_MAX; cx++)
+			{
+				TerrainChunkData data;
+				data.chunkX = cx;
+				data.chunkZ = cz;
+				data.heightmap.assign(TERRAIN_CHUNK_HEIGHTMAP_SIZE, 0.0f);
+				data.CalculateBounds();
+				builder.AddChunk(data);
+			}
+		}
+
+		// Walls every 96 m both ways, each span between crossings with one
+		// 4 m doorway at a random spot
+		std::uniform_real_distribution<float> door(8.0f, 84.0f);
+		for (float line = MAP_MIN + 64.0f; line < MAP_MAX; line += 96.0f)
+		{
+			for (float span = MAP_MIN; span < MAP_MAX; span += 96.0f)
+			{
+				const float end = std::min(span + 96.0f, MAP_MAX);
+				const float gap = span + door(rng);
+				builder.AddObstacle(Box(line - 1.0f, span, line + 1.0f, gap));
+				builder.AddObstacle(Box(line - 1.0f, gap + 4.0f, line + 1.0f, end));
+				builder.AddObstacle(Box(span, line - 1.0f, gap, line + 1.0f));
+				builder.AddObstacle(Box(gap + 4.0f, line - 1.0f, end, line + 1.0f));
+			}
+		}
+
+		// A sealed vault: its inside is a region of its own
+		builder.AddObstacle(Box(VAULT_MIN, VAULT_MIN, VAULT_MAX, VAULT_MIN + 2.0f));
+		builder.AddObstacle(Box(VAULT_MIN, VAULT_MAX - 2.0f, VAULT_MAX, VAULT_MAX));
+		builder.AddObstacle(Box(VAULT_MIN, VAULT_MIN, VAULT_MIN + 2.0f, VAULT_MAX));
+		builder.AddObstacle(Box(VAULT_MAX - 2.0f, VAULT_MIN, VAULT_MAX, VAULT_MAX));
+
+		// Crates
+		std::uniform_real_distribution<float> pos(MAP_MIN, MAP_MAX);
+		std::uniform_real_distribution<float> size(0.5f, 3.0f);
+		std::uniform_real_distribution<float> yaw(0.0f, 6.2831853f);
+		for (int i = 0; i < 600; i++)
+		{
+			TerrainObstacle crate = Box(0.0f, 0.0f, 0.0f, 0.0f);
+			crate.centerX = pos(rng);
+			crate.centerZ = pos(rng);
+			crate.halfExtentX = size(rng);
+			crate.halfExtentZ = size(rng);
+			crate.yaw = yaw(rng);
+			builder.AddObstacle(crate);
+		}
+	}
+
+	float Octile(int32_t dx, int32_t dy)
+	{
+		dx = std::abs(dx);
+		dy = std::abs(dy);
+		return std::max(dx, dy) + (std::sqrt(2.0f) - 1.0f) * std::min(dx, dy);
+	}
+
+	// Plain A* over every cell; returns the grid cost or infinity
+	class ReferenceAStar
+	{
+	public:
+		explicit ReferenceAStar(const NavGrid& grid)
+			: m_Grid(grid), m_G(static_cast<size_t>(grid.GetWidth()) * grid.GetHeight()),
+			  m_Closed(m_G.size())
+		{
+		}
+
+		float Search(int32_t sx, int32_t sy, int32_t gx, int32_t gy)
+		{
+			constexpr float INF = std::numeric_limits<float>::infinity();
+			std::fill(m_G.begin(), m_G.end(), INF);
+			std::fill(m_Closed.begin(), m_Closed.end(), 0);
+			m_Open.clear();
+
+			auto greater = [](const Entry& a, const Entry& b) { return a.f > b.f; };
+			m_G[Index(sx, sy)] = 0.0f;
+			m_Open.push_back({Octile(gx - sx, gy - sy), 0.0f, sx, sy});
+			while (!m_Open.empty())
+			{
+				std::pop_heap(m_Open.begin(), m_Open.end(), greater);
+				const Entry e = m_Open.back();
+				m_Open.pop_back();
+				const size_t index = Index(e.x, e.y);
+				if (m_Closed[index])
+					continue;
+				m_Closed[index] = 1;
+				if (e.x == gx && e.y == gy)
+					return e.g;
+
+				for (int32_t dy = -1; dy <= 1; dy++)
+				{
+					for (int32_t dx = -1; dx <= 1; dx++)
+					{
+						const int32_t nx = e.x + dx, ny = e.y + dy;
+						if ((dx == 0 && dy == 0) || !m_Grid.IsWalkable(nx, ny))
+							continue;
+						if (dx != 0 && dy != 0 && (!m_Grid.IsWalkable(e.x + dx, e.y) || !m_Grid.IsWalkable(e.x, e.y + dy)))
+							continue;
+						const float g = e.g + Octile(dx, dy);
+						const size_t next = Index(nx, ny);
+						if (g < m_G[next])
+						{
+							m_G[next] = g;
+							m_Open.push_back({g + Octile(gx - nx, gy - ny), g, nx, ny});
+							std::push_heap(m_Open.begin(), m_Open.end(), greater);
+						}
+					}
+				}
+			}
+			return INF;
+		}
+
+	private:
+		struct Entry
+		{
+			float f;
+			float g;
+			int32_t x;
+			int32_t y;
+		};
+
+		size_t Index(int32_t x, int32_t y) const
+		{
+			return static_cast<size_t>(y - m_Grid.GetMinCellY()) * m_Grid.GetWidth() + (x - m_Grid.GetMinCellX());
+		}
+
+		const NavGrid& m_Grid;
+		std::vector<float> m_G;
+		std::vector<uint8_t> m_Closed;
+		std::vector<Entry> m_Open;
+	};
+
+	float PathLength(Vec2 from, const std::vector<Vec2>& path)
+	{
+		float length = 0.0f;
+		for (const Vec2& point : path)
+		{
+			length += Vec2::Distance(from, point);
+			from = point;
+		}
+		return length;
+	}
+
+	bool LegsWalkable(const NavGrid& grid, Vec2 from, const std::vector<Vec2>& path)
+	{
+		for (const Vec2& point : path)
+		{
+			if (!grid.IsLineWalkable(from, point))
+				return false;
+			from = point;
+		}
+		return true;
+	}
+
+	Vec2 RandomWalkable(const NavGrid& grid, std::mt19937& rng, float minX, float minY, float maxX, float maxY)
+	{
+		std::uniform_real_distribution<float> x(std::max(minX, MAP_MIN), std::min(maxX, MAP_MAX - 0.01f));
+		std::uniform_real_distribution<float> y(std::max(minY, MAP_MIN), std::min(maxY, MAP_MAX - 0.01f));
+		while (true)
+		{
+			const int32_t cellX = NavGrid::ToCell(x(rng)), cellY = NavGrid::ToCell(y(rng));
+			if (grid.IsWalkable(cellX, cellY))
+				return NavGrid::CellCenter(cellX, cellY);
+		}
+	}
+
+	// The move MapInstance's GroundMovement makes: blocked cells revert the
+	// step unless one axis alone can slide
+	void Move(const NavGrid& grid, Vec2& position, Vec2 velocity)
+	{
+		const Vec2 target = position + velocity * TICK_SECONDS;
+		auto walkable = [&](Vec2 p) { return grid.IsWalkable(NavGrid::ToCell(p.x), NavGrid::ToCell(p.y)); };
+		if (walkable(target))
+			position = target;
+		else if (walkable(Vec2(target.x, position.y)))
+			position.x = target.x;
+		else if (walkable(Vec2(position.x, target.y)))
+			position.y = target.y;
+	}
+
+	uint32_t RegionAt(const NavGrid& grid, Vec2 p)
+	{
+		return grid.GetRegion(NavGrid::ToCell(p.x), NavGrid::ToCell(p.y));
+	}
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(2);
+	std::mt19937 rng(4321);
+	bool ok = true;
+	auto fail = [&](const char* what) {
+		std::cout << "  ** FAILED: " << what << " **\n";
+		ok = false;
+	};
+
+	ServerTerrainBuilder builder;
+	Build(builder, rng);
+	ServerTerrain terrain;
+	builder.Build(terrain);
+
+	auto gridStart = Clock::now();
+	auto grid = std::make_shared<const NavGrid>(terrain);
+	const double gridMs = MsSince(gridStart);
+	std::cout << "Nav grid: " << grid->GetWidth() << "x" << grid->GetHeight() << " cells, "
+			  << terrain.CountWalkableCells() << " walkable, " << grid->GetRegionCount() << " regions, built in "
+			  << gridMs << " ms\n\n";
+
+	const Vec2 vaultInside = NavGrid::CellCenter(NavGrid::ToCell((VAULT_MIN + VAULT_MAX) * 0.5f), NavGrid::ToCell((VAULT_MIN + VAULT_MAX) * 0.5f));
+	if (RegionAt(*grid, vaultInside) == 0 ||
+		RegionAt(*grid, vaultInside) == RegionAt(*grid, Vec2(VAULT_MIN - 5.0f, VAULT_MIN - 5.0f)))
+		fail("the vault is not a region of its own");
+
+	// ---- Correctness ----
+	std::vector<std::pair<Vec2, Vec2>> queries;
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		// Every tenth query targets the vault
+		const Vec2 from = RandomWalkable(*grid, rng, MAP_MIN, MAP_MIN, MAP_MAX, MAP_MAX);
+		const Vec2 to = i % 10 == 0 ? vaultInside : RandomWalkable(*grid, rng, MAP_MIN, MAP_MIN, MAP_MAX, MAP_MAX);
+		queries.emplace_back(from, to);
+	}
+
+	ReferenceAStar reference(*grid);
+	PathFinder finder(grid);
+	std::vector<std::vector<Vec2>> syncPaths(QUERY_COUNT);
+	std::vector<PathStatus> syncStatus(QUERY_COUNT);
+	int foundMismatches = 0, illegalLegs = 0, longerPaths = 0, found = 0;
+	double referenceMs = 0.0, jpsMs = 0.0, referenceCost = 0.0, pulledLength = 0.0;
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		const auto [from, to] = queries[i];
+		auto start = Clock::now();
+		const float cost = reference.Search(NavGrid::ToCell(from.x), NavGrid::ToCell(from.y),
+											NavGrid::ToCell(to.x), NavGrid::ToCell(to.y));
+		referenceMs += MsSince(start);
+
+		start = Clock::now();
+		syncStatus[i] = finder.FindPath(from, to, syncPaths[i]);
+		jpsMs += MsSince(start);
+
+		const bool jpsFound = syncStatus[i] == PathStatus::FOUND;
+		if (jpsFound != std::isfinite(cost))
+		{
+			foundMismatches++;
+			continue;
+		}
+		if (!jpsFound)
+			continue;
+
+		found++;
+		const float length = PathLength(from, syncPaths[i]);
+		illegalLegs += !LegsWalkable(*grid, from, syncPaths[i]);
+		longerPaths += length > cost + 1e-3f;
+		referenceCost += cost;
+		pulledLength += length;
+	}
+
+	std::cout << "JPS vs reference A* (" << QUERY_COUNT << " queries, " << found << " reachable):\n";
+	std::cout << "  found/not-found mismatches: " << foundMismatches << "\n";
+	std::cout << "  paths with a blocked leg:   " << illegalLegs << "\n";
+	std::cout << "  longer than the grid path:  " << longerPaths << "\n";
+	std::cout << "  string-pulled length:       " << 100.0 * pulledLength / referenceCost << "% of grid cost\n";
+	std::cout << "  reference A*: " << std::setw(8) << 1000.0 * referenceMs / QUERY_COUNT << " us/query\n";
+	std::cout << "  JPS:          " << std::setw(8) << 1000.0 * jpsMs / QUERY_COUNT << " us/query ("
+			  << finder.GetStats().scanSteps / std::max<uint64_t>(1, finder.GetStats().searches)
+			  << " steps/search)\n";
+	if (foundMismatches)
+		fail("reachability disagrees with the reference");
+	if (illegalLegs)
+		fail("path crosses unwalkable cells");
+	if (longerPaths)
+		fail("path longer than the optimal grid path");
+
+	// Same queries through the queue, a small budget per Update
+	PathFinder async(grid);
+	std::vector<PathRequestId> ids;
+	for (const auto& [from, to] : queries)
+	{
+		ids.push_back(async.Request(from, to));
+	}
+	// Cancelling one must not disturb the rest
+	async.Cancel(ids[1]);
+	int updates = 0;
+	while (async.GetPendingCount() > 0)
+	{
+		async.Update(500);
+		updates++;
+	}
+	int asyncMismatches = 0;
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		std::vector<Vec2> path;
+		const PathStatus status = async.Poll(ids[i], path);
+		if (i == 1)
+			continue;
+		bool same = status == syncStatus[i] && path.size() == syncPaths[i].size();
+		for (size_t p = 0; same && p < path.size(); p++)
+		{
+			same = path[p].x == syncPaths[i][p].x && path[p].y == syncPaths[i][p].y;
+		}
+		asyncMismatches += !same;
+	}
+	std::cout << "Async (500 steps per Update, " << updates << " updates): " << asyncMismatches
+			  << " mismatches vs sync\n\n";
+	if (asyncMismatches)
+		fail("async results differ from sync");
+
+	// ---- Chase simulation ----
+	struct Player
+	{
+		Vec2 position;
+		Vec2 heading;
+	};
+	struct Mob
+	{
+		Vec2 position;
+		int player;
+		int aggroTick;
+		PathFollower follower;
+		Vec2 checkpoint;
+	};
+
+	std::vector<Player> players(PLAYER_COUNT);
+	std::vector<Mob> mobs;
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::uniform_int_distribution<int> aggro(0, AGGRO_TICKS - 1);
+	for (int p = 0; p < PLAYER_COUNT; p++)
+	{
+		players[p].position = RandomWalkable(*grid, rng, MAP_MIN, MAP_MIN, MAP_MAX, MAP_MAX);
+		const float a = angle(rng);
+		players[p].heading = Vec2(std::cos(a), std::sin(a));
+		for (int m = 0; m < MOBS_PER_PLAYER; m++)
+		{
+			const Vec2 c = players[p].position;
+			mobs.push_back({RandomWalkable(*grid, rng, c.x - AGGRO_SPREAD, c.y - AGGRO_SPREAD, c.x + AGGRO_SPREAD,
+										   c.y + AGGRO_SPREAD),
+							p, aggro(rng), {}, {}});
+		}
+	}
+	const std::vector<Player> startPlayers = players;
+	const std::vector<Mob> startMobs = mobs;
+
+	auto movePlayers = [&](std::mt19937& walk) {
+		for (Player& player : players)
+		{
+			const Vec2 before = player.position;
+			Move(*grid, player.position, player.heading * PLAYER_SPEED);
+			if (Vec2::DistanceSquared(before, player.position) < 1e-6f || walk() % 200 == 0)
+			{
+				const float a = angle(walk);
+				player.heading = Vec2(std::cos(a), std::sin(a));
+			}
+		}
+	};
+
+	PathFinder chase(grid);
+	std::mt19937 walk(99);
+	double worstTickMs = 0.0, totalTickMs = 0.0;
+	size_t maxPending = 0;
+	int stuck = 0;
+	for (int tick = 0; tick < SIM_TICKS; tick++)
+	{
+		movePlayers(walk);
+
+		const auto start = Clock::now();
+		for (Mob& mob : mobs)
+		{
+			const Vec2 goal = players[mob.player].position;
+			if (tick < mob.aggroTick || Vec2::DistanceSquared(mob.position, goal) <= CAUGHT_DISTANCE * CAUGHT_DISTANCE)
+				continue;
+			Move(*grid, mob.position, mob.follower.Steer(chase, mob.position, goal) * MOB_SPEED);
+		}
+		chase.Update(PathFinder::TICK_STEP_BUDGET);
+		const double tickMs = MsSince(start);
+
+		totalTickMs += tickMs;
+		worstTickMs = std::max(worstTickMs, tickMs);
+		maxPending = std::max(maxPending, chase.GetPendingCount());
+
+		// Chasing a reachable player yet barely moved in the last STUCK_TICKS;
+		// mobs hovering about a cornered player are not stuck
+		if (tick % STUCK_TICKS == STUCK_TICKS - 1)
+		{
+			for (Mob& mob : mobs)
+			{
+				const Vec2 goal = players[mob.player].position;
+				const float hover = CAUGHT_DISTANCE + 2.0f;
+				stuck += tick - STUCK_TICKS >= mob.aggroTick && Vec2::DistanceSquared(mob.position, goal) > hover * hover &&
+						 RegionAt(*grid, mob.position) == RegionAt(*grid, goal) &&
+						 Vec2::DistanceSquared(mob.position, mob.checkpoint) < 1.0f;
+				mob.checkpoint = mob.position;
+			}
+		}
+	}
+
+	int reachable = 0, caught = 0;
+	for (const Mob& mob : mobs)
+	{
+		const Vec2 goal = players[mob.player].position;
+		if (RegionAt(*grid, mob.position) != RegionAt(*grid, goal))
+			continue;
+		reachable++;
+		caught += Vec2::DistanceSquared(mob.position, goal) <= (CAUGHT_DISTANCE + 1.0f) * (CAUGHT_DISTANCE + 1.0f);
+	}
+
+	const PathFinderStats& stats = chase.GetStats();
+	std::cout << "Chase: " << mobs.size() << " mobs after " << PLAYER_COUNT << " wandering players, " << SIM_TICKS
+			  << " ticks, budget " << PathFinder::TICK_STEP_BUDGET << " steps/tick\n";
+	std::cout << "  tick (steer + Update): " << std::setw(7) << totalTickMs / SIM_TICKS << " ms avg, "
+			  << worstTickMs << " ms worst, of a " << TICK_SECONDS * 1000.0f << " ms tick\n";
+	std::cout << "  requests " << stats.requests << ", cache hits " << std::setprecision(1)
+			  << 100.0 * stats.cacheHits / std::max<uint64_t>(1, stats.requests) << "%, searches " << stats.searches
+			  << ", unreachable " << stats.unreachable << ", max queued " << maxPending << "\n";
+	std::cout << "  caught their player: " << caught << " / " << reachable << " reachable ("
+			  << 100.0 * caught / std::max(1, reachable) << "%), stuck for " << STUCK_TICKS * TICK_SECONDS
+			  << " s while chasing: " << stuck << "\n"
+			  << std::setprecision(2);
+	if (caught < reachable * 0.9 || stuck)
+		fail("mobs failed to reach their players");
+
+	// ---- Naive: a fresh A* per mob per tick ----
+	players = startPlayers;
+	mobs = startMobs;
+	walk.seed(99);
+	const auto naiveStart = Clock::now();
+	for (int tick = 0; tick < NAIVE_TICKS; tick++)
+	{
+		movePlayers(walk);
+		for (Mob& mob : mobs)
+		{
+			const Vec2 goal = players[mob.player].position;
+			reference.Search(NavGrid::ToCell(mob.position.x), NavGrid::ToCell(mob.position.y), NavGrid::ToCell(goal.x),
+							 NavGrid::ToCell(goal.y));
+		}
+	}
+	std::cout << "  naive A* per mob per tick (all chasing): " << std::setw(7) << MsSince(naiveStart) / NAIVE_TICKS
+			  << " ms/tick\n";
+
+	return ok ? 0 : 1;
+}
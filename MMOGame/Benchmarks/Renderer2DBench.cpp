@@ -0,0 +1,252 @@
+// Benchmark + consistency check: Renderer2D's CPU cost per quad.
+//
+// Submits 100k rotated, colored quads (a ParticleSystem::Render's worth) two
+// ways and times the CPU side only:
+//   - vertex batch: the previous RenderRotatedQuad, copied here: four corners
+//     rotated with Vector2D::Rotate, expanded to 4 x 10 floats and copied
+//     into the preallocated float array Flush uploads with glBufferSubData;
+//   - instanced: RenderQuadInstanced's 48-byte QuadInstance record, written
+//     field by field as into the persistently mapped ring (plain memory here,
+//     so no upload at all); quad_instanced.vert does the rest on the GPU.
+// Memory is what each path keeps allocated for this many quads.
+//
+// Checks that quad_instanced.vert's corner expansion (mirrored in C++ below)
+// lands unrotated quads exactly where the vertex batch puts them, and that
+// rotated quads keep their shape. The old Vector2D::Rotate adds each
+// corner's own angle, so its rotated quads do not; the deviation is printed.
+//
+// CPU only; needs no GL context. Exits non-zero on mismatch.
+
+#include <Graphics/Renderer2D.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace Onyx;
+
+	constexpr uint32_t QUADS = 100000;
+	constexpr int RUNS = 20;
+	constexpr float ASPECT_RATIO = 16.0f / 9.0f;
+	constexpr uint32_t FLOATS_PER_VERTEX = sizeof(BufferDisposition) / sizeof(float);
+
+	// What the old Renderer2DSpecification preallocated, whatever was drawn
+	constexpr size_t OLD_MAX_QUADS = 400 * 400;
+	constexpr size_t OLD_INDEX_COUNT = OLD_MAX_QUADS * 4 * 6;
+	constexpr size_t OLD_VERTEX_BYTES = OLD_MAX_QUADS * 4 * sizeof(BufferDisposition);
+	// The CPU vertex array was `new float[OLD_VERTEX_BYTES]`: 4x the bytes it needed
+	constexpr size_t OLD_KEPT_BYTES = OLD_VERTEX_BYTES * sizeof(float) + OLD_VERTEX_BYTES + 2 * OLD_INDEX_COUNT * sizeof(uint32_t);
+
+	struct Quad
+	{
+		Vector2D size;
+		Vector3 position;
+		Vector4D color;
+		float rotation;
+	};
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	// ============================================================
+	// VERTEX BATCH (previous RenderRotatedQuad, color overload)
+	// ============================================================
+
+	void BatchRotatedQuad(Vector2D size, Vector3 position, Vector4D color, float rotation, float* out, uint32_t& offset)
+	{
+		float aspectRatio = ASPECT_RATIO;
+
+		Vector2D topLeft = Vector2D(-size.x, size.y).Rotate(-rotation);
+		Vector2D topRight = Vector2D(size.x, size.y).Rotate(-rotation);
+		Vector2D bottomRight = Vector2D(size.x, -size.y).Rotate(-rotation);
+		Vector2D bottomLeft = Vector2D(-size.x, -size.y).Rotate(-rotation);
+
+		float vertices[] = {
+			topLeft.x + position.x * 2, topLeft.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f,
+			topRight.x + position.x * 2, topRight.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f,
+			bottomRight.x + position.x * 2, bottomRight.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f,
+			bottomLeft.x + position.x * 2, bottomLeft.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f};
+
+		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
+			out[offset + i] = vertices[i];
+		offset += sizeof(vertices) / sizeof(float);
+	}
+
+	// The previous unrotated RenderQuad, color overload; corners only
+	void BatchQuadCorners(Vector2D size, Vector3 position, float out[4][2])
+	{
+		const float aspectRatio = ASPECT_RATIO;
+		const float corners[4][2] = {
+			{-size.x + position.x * 2, size.y * aspectRatio + position.y * 2},
+			{size.x + position.x * 2, size.y * aspectRatio + position.y * 2},
+			{size.x + position.x * 2, -size.y * aspectRatio + position.y * 2},
+			{-size.x + position.x * 2, -size.y * aspectRatio + position.y * 2}};
+		std::memcpy(out, corners, sizeof(corners));
+	}
+
+	// ============================================================
+	// INSTANCED (RenderQuadInstanced + quad_instanced.vert)
+	// ============================================================
+
+	void InstancedQuad(Vector2D size, Vector3 position, Vector4D color, float rotation, QuadInstance* quad)
+	{
+		quad->position = {position.x * 2, position.y * 2, position.z};
+		quad->rotation = rotation;
+		quad->halfSize = {size.x, size.y};
+		quad->uvRect = {0.0f, 0.0f, 1.0f, 1.0f};
+		quad->color = PackQuadColor(color);
+		quad->texIndex = -1.0f;
+	}
+
+	// quad_instanced.vert, corners in the vertex batch's order (TL, TR, BR, BL)
+	void ExpandInstance(const QuadInstance& quad, float out[4][2])
+	{
+		static const float STRIP_CORNERS[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {-1.0f, 1.0f}, {1.0f, 1.0f}};
+		static const int BATCH_ORDER[4] = {2, 3, 1, 0};
+
+		const float angle = -quad.rotation * 3.14159265358979f / 180.0f;
+		const float s = std::sin(angle);
+		const float c = std::cos(angle);
+		for (int i = 0; i < 4; i++)
+		{
+			const float* corner = STRIP_CORNERS[BATCH_ORDER[i]];
+			const float x = corner[0] * quad.halfSize.x;
+			const float y = corner[1] * quad.halfSize.y;
+			out[i][0] = quad.position.x + (x * c - y * s) * 1.0f;
+			out[i][1] = quad.position.y + (x * s + y * c) * ASPECT_RATIO;
+		}
+	}
+
+	// Side lengths and diagonals with the aspect ratio taken back out; equal
+	// for a rigid rotation of the unrotated quad
+	float ShapeError(const float corners[4][2], Vector2D size)
+	{
+		auto length = [&](int a, int b) {
+			const float dx = corners[a][0] - corners[b][0];
+			const float dy = (corners[a][1] - corners[b][1]) / ASPECT_RATIO;
+			return std::sqrt(dx * dx + dy * dy);
+		};
+		const float width = 2.0f * size.x, height = 2.0f * size.y;
+		const float diagonal = std::sqrt(width * width + height * height);
+		float error = 0.0f;
+		error = std::max(error, std::abs(length(0, 1) - width) / width);
+		error = std::max(error, std::abs(length(1, 2) - height) / height);
+		error = std::max(error, std::abs(length(0, 2) - diagonal) / diagonal);
+		error = std::max(error, std::abs(length(1, 3) - diagonal) / diagonal);
+		return error;
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(2);
+	std::mt19937 rng(2023);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	bool ok = true;
+	auto fail = [&](const char* what) {
+		std::cout << "  ** FAILED: " << what << " **\n";
+		ok = false;
+	};
+
+	std::vector<Quad> quads(QUADS);
+	for (Quad& quad : quads)
+	{
+		const float size = 0.005f + unit(rng) * 0.02f;
+		quad.size = {size, size * (0.5f + unit(rng))};
+		quad.position = {unit(rng) - 0.5f, unit(rng) - 0.5f, 0.0f};
+		quad.color = {unit(rng), unit(rng), unit(rng), 0.5f + 0.5f * unit(rng)};
+		quad.rotation = unit(rng) * 360.0f;
+	}
+
+	// --- Timing: best of RUNS ---
+	std::vector<float> vertexData(static_cast<size_t>(QUADS) * 4 * FLOATS_PER_VERTEX);
+	std::vector<QuadInstance> ring(QUADS);
+	double batchMs = 1e30, instancedMs = 1e30;
+	float sink = 0.0f;
+	for (int run = 0; run < RUNS; run++)
+	{
+		auto start = Clock::now();
+		uint32_t offset = 0;
+		for (const Quad& quad : quads)
+			BatchRotatedQuad(quad.size, quad.position, quad.color, quad.rotation, vertexData.data(), offset);
+		batchMs = std::min(batchMs, MsSince(start));
+		sink += vertexData[run % vertexData.size()];
+
+		start = Clock::now();
+		QuadInstance* out = ring.data();
+		for (const Quad& quad : quads)
+			InstancedQuad(quad.size, quad.position, quad.color, quad.rotation, out++);
+		instancedMs = std::min(instancedMs, MsSince(start));
+		sink += ring[run % ring.size()].position.x;
+	}
+
+	const double perQuadScale = 100000.0 / QUADS;
+	const size_t batchBytesPerQuad = 4 * sizeof(BufferDisposition);
+	std::cout << QUADS << " rotated colored quads, best of " << RUNS << " (CPU submit only)\n\n";
+	std::cout << "  path            ms / 100k quads   uploaded / quad   kept allocated\n";
+	std::cout << "  vertex batch    " << std::setw(15) << batchMs * perQuadScale << std::setw(16) << batchBytesPerQuad
+			  << " B   " << std::setw(7) << OLD_KEPT_BYTES / (1024.0 * 1024.0)
+			  << " MB (old fixed 160k-quad CPU + GPU buffers)\n";
+	std::cout << "  instanced       " << std::setw(15) << instancedMs * perQuadScale << std::setw(16) << sizeof(QuadInstance)
+			  << " B   " << std::setw(7) << (QUADS * sizeof(QuadInstance) * PersistentRingBuffer::REGION_COUNT) / (1024.0 * 1024.0)
+			  << " MB (ring grown to this batch, " << PersistentRingBuffer::REGION_COUNT << " regions)\n";
+	std::cout << "  speedup " << batchMs / instancedMs << "x\n\n";
+
+	// --- Placement: unrotated quads land exactly on the vertex batch's corners ---
+	uint32_t placementMismatches = 0;
+	float instancedShape = 0.0f, batchShape = 0.0f;
+	for (const Quad& quad : quads)
+	{
+		QuadInstance instance;
+		InstancedQuad(quad.size, quad.position, quad.color, 0.0f, &instance);
+		float expected[4][2], actual[4][2];
+		BatchQuadCorners(quad.size, quad.position, expected);
+		ExpandInstance(instance, actual);
+		if (std::memcmp(expected, actual, sizeof(expected)) != 0)
+			placementMismatches++;
+
+		// Rotated: the instanced quad keeps its shape
+		InstancedQuad(quad.size, quad.position, quad.color, quad.rotation, &instance);
+		ExpandInstance(instance, actual);
+		instancedShape = std::max(instancedShape, ShapeError(actual, quad.size));
+
+		uint32_t offset = 0;
+		float vertices[4 * FLOATS_PER_VERTEX];
+		BatchRotatedQuad(quad.size, quad.position, quad.color, quad.rotation, vertices, offset);
+		for (int i = 0; i < 4; i++)
+		{
+			actual[i][0] = vertices[i * FLOATS_PER_VERTEX + 0];
+			actual[i][1] = vertices[i * FLOATS_PER_VERTEX + 1];
+		}
+		batchShape = std::max(batchShape, ShapeError(actual, quad.size));
+	}
+	std::cout << "  unrotated corner mismatches: " << placementMismatches << "\n";
+	std::cout << std::setprecision(6) << "  rotated shape error (relative): instanced " << instancedShape
+			  << ", old vertex batch " << batchShape << "\n";
+
+	if (placementMismatches != 0)
+		fail("instanced corners differ from the vertex batch for unrotated quads");
+	if (instancedShape > 1e-4f)
+		fail("instanced rotation does not keep the quad's shape");
+
+	QuadInstance white;
+	InstancedQuad({1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 0.5f, 0.0f, 1.0f}, 0.0f, &white);
+	if (white.color != 0xFF0080FFu)
+		fail("PackQuadColor channel order");
+
+	if (sink == 12345.0f)
+		std::cout << "\n";
+	return ok ? 0 : 1;
+}
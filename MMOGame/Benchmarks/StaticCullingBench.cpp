@@ -0,0 +1,272 @@
+// Benchmark + consistency check for SceneRenderer's retained static scene.
+//
+// Places N static mesh instances over a 2 km square (the editor's world
+// scale) and, per simulated frame, culls them against the camera frustum and
+// four shadow cascades the way each SceneRenderer path does:
+//   - immediate: every instance is resubmitted (TransformAABB, material-key
+//     hashing, batch map insert), then each frustum tests every box;
+//   - retained: instances live in a BoundingVolumeHierarchy and only the
+//     1% that move per frame are updated; each frustum is one traversal.
+// Both paths must produce the same visible set for every frustum, including
+// after moves (refits), removals and re-insertions (rebuilds).
+//
+// CPU only; needs no GL context. Exits non-zero on any mismatch.
+
+#include <Graphics/BoundingVolumeHierarchy.h>
+#include <Graphics/Frustum.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace Onyx;
+
+	constexpr float WORLD_SIZE = 2048.0f;
+	constexpr int FRAMES = 120;
+	constexpr int CASCADES = 4;
+
+	struct Instance
+	{
+		glm::mat4 transform;
+		glm::vec3 localMin;
+		glm::vec3 localMax;
+		glm::vec3 worldMin;
+		glm::vec3 worldMax;
+		uint32_t material;
+	};
+
+	// Same as SceneRenderer::TransformAABB
+	void TransformAABB(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& transform,
+					   glm::vec3& worldMin, glm::vec3& worldMax)
+	{
+		glm::vec3 t(transform[3]);
+		worldMin = t;
+		worldMax = t;
+		for (int i = 0; i < 3; i++)
+		{
+			glm::vec3 col(transform[i][0], transform[i][1], transform[i][2]);
+			glm::vec3 a = col * localMin[i];
+			glm::vec3 b = col * localMax[i];
+			worldMin += glm::min(a, b);
+			worldMax += glm::max(a, b);
+		}
+	}
+
+	glm::mat4 PlaceAt(const glm::vec3& position, float scale)
+	{
+		return glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(scale));
+	}
+
+	// Camera sweeping across the world, plus light matrices that cover
+	// successive slices of its view like CascadedShadowMap does
+	void MakeFrustums(int frame, Frustum& camera, Frustum (&cascades)[CASCADES])
+	{
+		const float t = float(frame) / float(FRAMES);
+		const glm::vec3 eye(200.0f + t * 1600.0f, 40.0f, 300.0f + t * 1200.0f);
+		const glm::vec3 forward = glm::normalize(glm::vec3(std::cos(t * 6.0f), -0.25f, std::sin(t * 6.0f)));
+		const glm::mat4 view = glm::lookAt(eye, eye + forward, glm::vec3(0, 1, 0));
+		camera.Update(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f) * view);
+
+		const glm::vec3 lightDir = glm::normalize(glm::vec3(-0.5f, -1.0f, -0.3f));
+		float sliceStart = 0.0f;
+		for (int c = 0; c < CASCADES; c++)
+		{
+			const float sliceEnd = 15.0f * float(1 << (2 * c)); // 15, 60, 240, 960 m
+			const glm::vec3 center = eye + forward * ((sliceStart + sliceEnd) * 0.5f);
+			const float radius = (sliceEnd - sliceStart) * 0.75f;
+			const glm::mat4 lightView = glm::lookAt(center - lightDir * radius * 2.0f, center, glm::vec3(0, 1, 0));
+			cascades[c].Update(glm::ortho(-radius, radius, -radius, radius, 0.0f, radius * 4.0f) * lightView);
+			sliceStart = sliceEnd;
+		}
+	}
+
+	uint64_t MakeBatchKey(const void* ptr, const std::string& albedo, const std::string& normal)
+	{
+		uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+		auto mix = [](uint64_t seed, uint64_t val) -> uint64_t {
+			seed ^= val + 0x9e3779b97f4a7c15ULL + (seed << 12) + (seed >> 4);
+			return seed;
+		};
+		std::hash<std::string> strHash;
+		h = mix(h, strHash(albedo));
+		h = mix(h, strHash(normal));
+		return h;
+	}
+
+	struct Result
+	{
+		double immediateMs = 0.0;
+		double retainedMs = 0.0;
+		uint64_t visible = 0;
+		uint64_t nodesVisited = 0;
+		bool ok = true;
+	};
+
+	Result Run(uint32_t count)
+	{
+		std::mt19937 rng(count);
+		std::uniform_real_distribution<float> position(0.0f, WORLD_SIZE);
+		std::uniform_real_distribution<float> scale(0.5f, 3.0f);
+		std::uniform_real_distribution<float> size(0.5f, 4.0f);
+		std::uniform_int_distribution<uint32_t> material(0, 31);
+
+		std::vector<std::string> albedoPaths;
+		std::vector<std::string> normalPaths;
+		for (int m = 0; m < 32; m++)
+		{
+			albedoPaths.push_back("Data/materials/props/prop_" + std::to_string(m) + "_albedo.dds");
+			normalPaths.push_back("Data/materials/props/prop_" + std::to_string(m) + "_normal.dds");
+		}
+
+		std::vector<Instance> instances(count);
+		BoundingVolumeHierarchy bvh;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Instance& instance = instances[i];
+			const float s = size(rng);
+			instance.localMin = glm::vec3(-s, 0.0f, -s);
+			instance.localMax = glm::vec3(s, 2.0f * s, s);
+			instance.transform = PlaceAt(glm::vec3(position(rng), 0.0f, position(rng)), scale(rng));
+			instance.material = material(rng);
+			TransformAABB(instance.localMin, instance.localMax, instance.transform, instance.worldMin,
+						  instance.worldMax);
+			bvh.Insert(i, instance.worldMin, instance.worldMax);
+		}
+		bvh.Rebuild();
+
+		Result result;
+		std::vector<uint32_t> linearVisible;
+		std::vector<uint32_t> bvhVisible;
+		std::unordered_map<uint64_t, std::vector<uint32_t>> batches;
+
+		for (int frame = 0; frame < FRAMES; frame++)
+		{
+			Frustum camera;
+			Frustum cascades[CASCADES];
+			MakeFrustums(frame, camera, cascades);
+
+			// 1% of the instances move; every 30 frames a few are deleted and
+			// placed again, which forces a rebuild on the retained side
+			std::vector<uint32_t> moved;
+			for (uint32_t k = 0; k < count / 100; k++)
+			{
+				moved.push_back(rng() % count);
+			}
+			for (uint32_t i : moved)
+			{
+				Instance& instance = instances[i];
+				instance.transform = glm::translate(instance.transform, glm::vec3(0.5f, 0.0f, -0.25f));
+			}
+			const bool churn = frame % 30 == 29;
+
+			// Immediate: resubmit everything, then test every box per frustum
+			auto start = Clock::now();
+			batches.clear();
+			for (uint32_t i = 0; i < count; i++)
+			{
+				Instance& instance = instances[i];
+				TransformAABB(instance.localMin, instance.localMax, instance.transform, instance.worldMin,
+							  instance.worldMax);
+				const uint64_t key = MakeBatchKey(&instances, albedoPaths[instance.material],
+												  normalPaths[instance.material]);
+				batches[key].push_back(i);
+			}
+			std::vector<std::vector<uint32_t>> linearSets;
+			for (int f = 0; f <= CASCADES; f++)
+			{
+				const Frustum& frustum = f == 0 ? camera : cascades[f - 1];
+				linearVisible.clear();
+				for (const auto& [key, members] : batches)
+				{
+					for (uint32_t i : members)
+					{
+						if (frustum.IsBoxVisible(instances[i].worldMin, instances[i].worldMax))
+							linearVisible.push_back(i);
+					}
+				}
+				linearSets.push_back(linearVisible);
+			}
+			result.immediateMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+			// Retained: only moved instances touch the tree
+			start = Clock::now();
+			for (uint32_t i : moved)
+			{
+				bvh.Update(i, instances[i].worldMin, instances[i].worldMax);
+			}
+			if (churn)
+			{
+				for (uint32_t k = 0; k < 16; k++)
+				{
+					const uint32_t i = rng() % count;
+					bvh.Remove(i);
+					bvh.Insert(i, instances[i].worldMin, instances[i].worldMax);
+				}
+			}
+			std::vector<std::vector<uint32_t>> bvhSets;
+			for (int f = 0; f <= CASCADES; f++)
+			{
+				const Frustum& frustum = f == 0 ? camera : cascades[f - 1];
+				bvhVisible.clear();
+				bvh.Query(frustum, [&](uint32_t item) { bvhVisible.push_back(item); });
+				result.nodesVisited += bvh.GetLastNodesVisited();
+				bvhSets.push_back(bvhVisible);
+			}
+			result.retainedMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+			for (int f = 0; f <= CASCADES; f++)
+			{
+				std::sort(linearSets[f].begin(), linearSets[f].end());
+				std::sort(bvhSets[f].begin(), bvhSets[f].end());
+				if (linearSets[f] != bvhSets[f])
+				{
+					std::cerr << "  frame " << frame << " frustum " << f << ": linear " << linearSets[f].size()
+							  << " visible, BVH " << bvhSets[f].size() << "\n";
+					result.ok = false;
+				}
+				result.visible += linearSets[f].size();
+			}
+		}
+		return result;
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << std::setw(10) << "instances" << std::setw(16) << "immediate ms/f" << std::setw(15)
+			  << "retained ms/f" << std::setw(10) << "speedup" << std::setw(14) << "visible/f" << std::setw(14)
+			  << "nodes/f" << "\n";
+
+	bool ok = true;
+	for (uint32_t count : {5000u, 20000u, 50000u, 100000u})
+	{
+		const Result result = Run(count);
+		std::cout << std::setw(10) << count << std::setw(16) << result.immediateMs / FRAMES << std::setw(15)
+				  << result.retainedMs / FRAMES << std::setw(9) << result.immediateMs / result.retainedMs << "x"
+				  << std::setw(14) << result.visible / FRAMES << std::setw(14) << result.nodesVisited / FRAMES
+				  << "\n";
+		if (!result.ok)
+		{
+			std::cerr << "FAIL: visible sets differ at " << count << " instances\n";
+			ok = false;
+		}
+	}
+
+	std::cout << "\nPer frame: camera + " << CASCADES << " cascades; visible counts sum all five frustums\n";
+	return ok ? 0 : 1;
+}
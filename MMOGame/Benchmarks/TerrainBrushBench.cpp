@@ -0,0 +1,525 @@
+// Benchmark + correctness check: the editor's sculpt brushes.
+//
+// Runs the same dabs of raise, lower, smooth and flatten over a synthetic
+// 8x8-chunk map two ways, each followed by the mesh work the next frame
+// does for it:
+//
+// full   = the old EditorWorldSystem::ApplyBrush path: a std::function and a
+//          sqrt for all 65x65 vertices of every chunk in the brush's bounding
+//          box, edge stitching, then whole-mesh regeneration and re-upload of
+//          those chunks and their neighbors.
+// region = the vertices strictly inside the brush gathered into one
+//          rectangle, TerrainBrushKernels' SSE2 row kernels, scatter back
+//          (TerrainHeightRegion, the same code the editor links), and
+//          GenerateTerrainMeshRegion for only the mesh vertices the change
+//          reaches (the glBufferSubData ranges).
+//
+// Checks: both leave identical heightmaps, and meshes patched region by
+// region equal a full regeneration bit for bit. The full flatten skips
+// vertices at or past the radius, which the old loop could move by a
+// rounding step. Exit code is non-zero on any failure.
+
+#include "Terrain/TerrainBrushKernels.h"
+#include "Terrain/TerrainHeightRegion.h"
+
+#include <Terrain/TerrainMeshGenerator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+	using Editor3D::BrushDab;
+
+	constexpr int CHUNKS = 8; // 8x8 chunks from (0, 0), 512x512 m
+	constexpr int DABS_PER_SIZE = 120;
+	constexpr float BRUSH_SIZES[] = {8.0f, 32.0f, 64.0f};
+	constexpr int QUADS = TERRAIN_CHUNK_RESOLUTION - 1;
+	constexpr double FRAME_BUDGET_MS = 1000.0 / 60.0;
+
+	using ChunkMap = std::unordered_map<int32_t, TerrainChunkData>;
+
+	enum class Tool
+	{
+		Raise,
+		Lower,
+		Smooth,
+		Flatten,
+	};
+
+	int32_t Key(int32_t x, int32_t z)
+	{
+		return static_cast<int32_t>((static_cast<uint32_t>(x) << 16) | (static_cast<uint32_t>(z) & 0xFFFF));
+	}
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	ChunkMap BuildMap()
+	{
+		ChunkMap map;
+		for (int cz = 0; cz < CHUNKS; cz++)
+		{
+			for (int cx = 0; cx < CHUNKS; cx++)
+			{
+				TerrainChunkData data;
+				data.chunkX = cx;
+				data.chunkZ = cz;
+				data.heightmap.resize(TERRAIN_CHUNK_HEIGHTMAP_SIZE);
+				for (int z = 0; z < TERRAIN_CHUNK_RESOLUTION; z++)
+				{
+					for (int x = 0; x < TERRAIN_CHUNK_RESOLUTION; x++)
+					{
+						// From world coordinates, so both copies of a border agree
+						const float wx = static_cast<float>(cx * QUADS + x);
+						const float wz = static_cast<float>(cz * QUADS + z);
+						data.heightmap[z * TERRAIN_CHUNK_RESOLUTION + x] =
+							8.0f * std::sin(wx * 0.021f) * std::cos(wz * 0.017f) + 2.0f * std::sin(wx * 0.11f + wz * 0.07f);
+					}
+				}
+				data.splatmap.assign(static_cast<size_t>(TERRAIN_SPLATMAP_TEXELS) * TERRAIN_MAX_LAYERS, 0);
+				data.CalculateBounds();
+				map.emplace(Key(cx, cz), std::move(data));
+			}
+		}
+		return map;
+	}
+
+	// EditorWorldSystem::GetChunkHeight: cross-chunk reads, 0 off the map
+	float GetChunkHeight(const ChunkMap& map, int cx, int cz, int lx, int lz)
+	{
+		const int last = TERRAIN_CHUNK_RESOLUTION - 1;
+		if (lx < 0)
+		{
+			cx--;
+			lx = last + lx;
+		}
+		else if (lx > last)
+		{
+			cx++;
+			lx = lx - last;
+		}
+		if (lz < 0)
+		{
+			cz--;
+			lz = last + lz;
+		}
+		else if (lz > last)
+		{
+			cz++;
+			lz = lz - last;
+		}
+		auto it = map.find(Key(cx, cz));
+		if (it == map.end() || it->second.heightmap.empty())
+			return 0.0f;
+		return it->second.heightmap[lz * TERRAIN_CHUNK_RESOLUTION + lx];
+	}
+
+	TerrainMeshOptions EditorMeshOptions(const ChunkMap& map)
+	{
+		TerrainMeshOptions options;
+		options.meshResolution = TERRAIN_CHUNK_RESOLUTION;
+		options.sobelNormals = true;
+		options.smoothNormals = true;
+		options.diamondGrid = true;
+		options.generatePaddedHeightmap = true;
+		options.heightSampler = [&map](int cx, int cz, int lx, int lz) { return GetChunkHeight(map, cx, cz, lx, lz); };
+		return options;
+	}
+
+	// ============================================================
+	// FULL: the old per-chunk brush
+	// ============================================================
+
+	float SmoothWeight(float dist, float radius, float strength)
+	{
+		if (dist >= radius)
+			return 0.0f;
+		float t = dist / radius;
+		t = t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+		return strength * (1.0f - t);
+	}
+
+	float Mix(float x, float y, float a)
+	{
+		return x * (1.0f - a) + y * a;
+	}
+
+	void StitchEdges(ChunkMap& map, int minCX, int maxCX, int minCZ, int maxCZ)
+	{
+		const int res = TERRAIN_CHUNK_RESOLUTION;
+		for (int cz = minCZ; cz <= maxCZ; cz++)
+		{
+			for (int cx = minCX; cx <= maxCX; cx++)
+			{
+				auto& data = map[Key(cx, cz)].heightmap;
+				if (cx + 1 <= maxCX)
+				{
+					auto& right = map[Key(cx + 1, cz)].heightmap;
+					for (int lz = 0; lz < res; lz++)
+					{
+						float avg = (data[lz * res + res - 1] + right[lz * res]) * 0.5f;
+						data[lz * res + res - 1] = avg;
+						right[lz * res] = avg;
+					}
+				}
+				if (cz + 1 <= maxCZ)
+				{
+					auto& bottom = map[Key(cx, cz + 1)].heightmap;
+					for (int lx = 0; lx < res; lx++)
+					{
+						float avg = (data[(res - 1) * res + lx] + bottom[lx]) * 0.5f;
+						data[(res - 1) * res + lx] = avg;
+						bottom[lx] = avg;
+					}
+				}
+			}
+		}
+	}
+
+	// Chunks in the bounding box plus their 4 neighbors: what
+	// DirtyNeighborChunks sent to full regeneration
+	void FullDirtyChunks(int minCX, int maxCX, int minCZ, int maxCZ, std::set<int32_t>& dirty)
+	{
+		for (int cz = minCZ; cz <= maxCZ; cz++)
+		{
+			for (int cx = minCX; cx <= maxCX; cx++)
+			{
+				static const int offsets[][2] = {{0, 0}, {-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+				for (auto& off : offsets)
+				{
+					const int nx = cx + off[0], nz = cz + off[1];
+					if (nx >= 0 && nx < CHUNKS && nz >= 0 && nz < CHUNKS)
+						dirty.insert(Key(nx, nz));
+				}
+			}
+		}
+	}
+
+	void FullDab(ChunkMap& map, Tool tool, float worldX, float worldZ, float radius, float amount,
+				 std::set<int32_t>& dirty)
+	{
+		const int minCX = static_cast<int>(std::floor((worldX - radius) / TERRAIN_CHUNK_SIZE));
+		const int maxCX = static_cast<int>(std::floor((worldX + radius) / TERRAIN_CHUNK_SIZE));
+		const int minCZ = static_cast<int>(std::floor((worldZ - radius) / TERRAIN_CHUNK_SIZE));
+		const int maxCZ = static_cast<int>(std::floor((worldZ + radius) / TERRAIN_CHUNK_SIZE));
+
+		std::function<void(TerrainChunkData&, int, int, float)> operation;
+		struct SmoothVertex
+		{
+			TerrainChunkData* chunk;
+			int index;
+			float average;
+			float weight;
+		};
+		std::vector<SmoothVertex> smoothed;
+
+		const float innerRadius = radius * 0.4f;
+		const float transitionWidth = radius - innerRadius;
+		switch (tool)
+		{
+		case Tool::Raise:
+		case Tool::Lower:
+		{
+			const float signedAmount = tool == Tool::Raise ? amount : -amount;
+			operation = [radius, signedAmount](TerrainChunkData& data, int lx, int lz, float dist) {
+				data.heightmap[lz * TERRAIN_CHUNK_RESOLUTION + lx] += SmoothWeight(dist, radius, signedAmount);
+			};
+			break;
+		}
+		case Tool::Flatten:
+			operation = [radius, amount, innerRadius, transitionWidth](TerrainChunkData& data, int lx, int lz, float dist) {
+				if (dist >= radius)
+					return;
+				float& height = data.heightmap[lz * TERRAIN_CHUNK_RESOLUTION + lx];
+				if (dist <= innerRadius)
+				{
+					height = amount;
+					return;
+				}
+				float t = (dist - innerRadius) / transitionWidth;
+				t = t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+				float desired = Mix(amount, height, t);
+				if (std::abs(desired - amount) < std::abs(height - amount))
+					height = desired;
+			};
+			break;
+		case Tool::Smooth:
+			operation = [&](TerrainChunkData& data, int lx, int lz, float dist) {
+				if (dist > radius)
+					return;
+				float sum = GetChunkHeight(map, data.chunkX, data.chunkZ, lx - 1, lz) +
+							GetChunkHeight(map, data.chunkX, data.chunkZ, lx + 1, lz) +
+							GetChunkHeight(map, data.chunkX, data.chunkZ, lx, lz - 1) +
+							GetChunkHeight(map, data.chunkX, data.chunkZ, lx, lz + 1);
+				smoothed.push_back({&data, lz * TERRAIN_CHUNK_RESOLUTION + lx, sum * 0.25f, SmoothWeight(dist, radius, amount)});
+			};
+			break;
+		}
+
+		for (int cz = minCZ; cz <= maxCZ; cz++)
+		{
+			for (int cx = minCX; cx <= maxCX; cx++)
+			{
+				TerrainChunkData& data = map[Key(cx, cz)];
+				for (int lz = 0; lz < TERRAIN_CHUNK_RESOLUTION; lz++)
+				{
+					for (int lx = 0; lx < TERRAIN_CHUNK_RESOLUTION; lx++)
+					{
+						float dx = (cx * TERRAIN_CHUNK_SIZE + lx) - worldX;
+						float dz = (cz * TERRAIN_CHUNK_SIZE + lz) - worldZ;
+						operation(data, lx, lz, std::sqrt(dx * dx + dz * dz));
+					}
+				}
+			}
+		}
+		for (const SmoothVertex& sv : smoothed)
+		{
+			float& height = sv.chunk->heightmap[sv.index];
+			height = Mix(height, sv.average, sv.weight);
+		}
+
+		StitchEdges(map, minCX, maxCX, minCZ, maxCZ);
+		for (int cz = minCZ; cz <= maxCZ; cz++)
+			for (int cx = minCX; cx <= maxCX; cx++)
+				map[Key(cx, cz)].CalculateBounds();
+		FullDirtyChunks(minCX, maxCX, minCZ, maxCZ, dirty);
+	}
+
+	// ============================================================
+	// REGION: gather, row kernels, scatter (EditorWorldSystem's sculpt path)
+	// ============================================================
+
+	struct RegionBrush
+	{
+		std::vector<float> heights;
+		std::vector<float> scratch;
+	};
+
+	// The chunk lookups EditorWorldSystem::GatherHeights / ScatterHeights pass
+	void Gather(const ChunkMap& map, const TerrainVertexRect& rect, std::vector<float>& out)
+	{
+		Editor3D::GatherHeightRegion(rect, [&map](int32_t cx, int32_t cz) -> const TerrainChunkData* {
+			auto it = map.find(Key(cx, cz));
+			return it != map.end() ? &it->second : nullptr;
+		}, out);
+	}
+
+	void Scatter(ChunkMap& map, const TerrainVertexRect& rect, const std::vector<float>& heights,
+				 std::unordered_map<int32_t, TerrainVertexRect>& dirty)
+	{
+		Editor3D::ScatterHeightRegion(rect, heights, [&map](int32_t cx, int32_t cz) -> TerrainChunkData* {
+			auto it = map.find(Key(cx, cz));
+			return it != map.end() ? &it->second : nullptr;
+		});
+
+		// EditorWorldSystem::MarkHeightsDirty + TerrainChunk::MarkHeightsDirty
+		Editor3D::ForEachChunkReachedByHeights(rect, [&](int32_t cx, int32_t cz, const TerrainVertexRect& local) {
+			if (map.count(Key(cx, cz)))
+			{
+				Editor3D::MergeVertexRect(dirty[Key(cx, cz)], local);
+			}
+		});
+	}
+
+	void RegionDab(ChunkMap& map, RegionBrush& brush, Tool tool, float worldX, float worldZ, float radius, float amount,
+				   std::unordered_map<int32_t, TerrainVertexRect>& dirty)
+	{
+		TerrainVertexRect rect;
+		rect.minX = static_cast<int>(std::floor(worldX - radius)) + 1;
+		rect.minZ = static_cast<int>(std::floor(worldZ - radius)) + 1;
+		rect.maxX = static_cast<int>(std::ceil(worldX + radius)) - 1;
+		rect.maxZ = static_cast<int>(std::ceil(worldZ + radius)) - 1;
+		if (rect.IsEmpty())
+			return;
+
+		const BrushDab dab{worldX, worldZ, radius};
+		const int width = rect.maxX - rect.minX + 1;
+		if (tool == Tool::Smooth)
+		{
+			const TerrainVertexRect ring{rect.minX - 1, rect.minZ - 1, rect.maxX + 1, rect.maxZ + 1};
+			const int ringWidth = width + 2;
+			Gather(map, ring, brush.heights);
+			brush.scratch.resize(static_cast<size_t>(width) * (rect.maxZ - rect.minZ + 1));
+			for (int gz = rect.minZ; gz <= rect.maxZ; gz++)
+			{
+				const float* center = &brush.heights[(gz - ring.minZ) * ringWidth + 1];
+				Editor3D::BrushSmoothRow(dab, amount, static_cast<float>(rect.minX), static_cast<float>(gz), center,
+										 center - ringWidth, center + ringWidth, &brush.scratch[(gz - rect.minZ) * width], width);
+			}
+			Scatter(map, rect, brush.scratch, dirty);
+			return;
+		}
+
+		Gather(map, rect, brush.heights);
+		for (int gz = rect.minZ; gz <= rect.maxZ; gz++)
+		{
+			float* row = &brush.heights[(gz - rect.minZ) * width];
+			if (tool == Tool::Flatten)
+				Editor3D::BrushFlattenRow(dab, amount, radius * 0.4f, static_cast<float>(rect.minX), static_cast<float>(gz), row, width);
+			else
+				Editor3D::BrushRaiseRow(dab, tool == Tool::Raise ? amount : -amount, static_cast<float>(rect.minX),
+										static_cast<float>(gz), row, width);
+		}
+		Scatter(map, rect, brush.heights, dirty);
+	}
+
+	bool SameHeights(const ChunkMap& a, const ChunkMap& b)
+	{
+		for (const auto& [key, data] : a)
+		{
+			const auto& other = b.at(key).heightmap;
+			if (data.heightmap.size() != other.size() ||
+				std::memcmp(data.heightmap.data(), other.data(), other.size() * sizeof(float)) != 0)
+				return false;
+		}
+		return true;
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(2);
+	std::mt19937 rng(2025);
+	bool ok = true;
+	auto fail = [&](const char* what) {
+		std::cout << "  ** FAILED: " << what << " **\n";
+		ok = false;
+	};
+
+	ChunkMap fullMap = BuildMap();
+	ChunkMap regionMap = fullMap;
+
+	// The region path's "GPU" copy of every chunk's vertex buffer
+	std::unordered_map<int32_t, std::vector<float>> gpuVertices;
+	{
+		const TerrainMeshOptions options = EditorMeshOptions(regionMap);
+		for (const auto& [key, data] : regionMap)
+		{
+			TerrainMeshData mesh;
+			GenerateTerrainMesh(data, options, mesh);
+			gpuVertices[key] = std::move(mesh.vertices);
+		}
+	}
+
+	const TerrainMeshOptions fullOptions = EditorMeshOptions(fullMap);
+	const TerrainMeshOptions regionOptions = EditorMeshOptions(regionMap);
+	const size_t paddedBytes = static_cast<size_t>(TERRAIN_CHUNK_RESOLUTION + 2) * (TERRAIN_CHUNK_RESOLUTION + 2) * sizeof(float);
+	const size_t splatBytes = static_cast<size_t>(TERRAIN_SPLATMAP_TEXELS) * 4 * 2;
+
+	RegionBrush brush;
+	std::cout << "Sculpting " << CHUNKS << "x" << CHUNKS << " chunks, " << DABS_PER_SIZE
+			  << " dabs per brush size cycling raise/lower/smooth/flatten; per dab = brush + next frame's mesh work\n\n";
+	std::cout << "  radius   path     brush ms   mesh ms   total ms   worst ms   upload KB   fits 60 fps\n";
+
+	for (float radius : BRUSH_SIZES)
+	{
+		std::uniform_real_distribution<float> coord(radius + 1.0f, CHUNKS * TERRAIN_CHUNK_SIZE - radius - 1.0f);
+		std::uniform_real_distribution<float> amountDist(0.05f, 0.5f);
+
+		double fullBrushMs = 0.0, fullMeshMs = 0.0, fullWorstMs = 0.0;
+		double regionBrushMs = 0.0, regionMeshMs = 0.0, regionWorstMs = 0.0;
+		size_t fullBytes = 0, regionBytes = 0;
+
+		for (int i = 0; i < DABS_PER_SIZE; i++)
+		{
+			const Tool tool = static_cast<Tool>(i % 4);
+			const float x = coord(rng);
+			const float z = coord(rng);
+			const float amount = tool == Tool::Flatten ? 4.0f : tool == Tool::Smooth ? 0.5f : amountDist(rng);
+
+			// --- Full ---
+			std::set<int32_t> fullDirty;
+			auto start = Clock::now();
+			FullDab(fullMap, tool, x, z, radius, amount, fullDirty);
+			const double fullBrush = MsSince(start);
+			start = Clock::now();
+			for (int32_t key : fullDirty)
+			{
+				TerrainMeshData mesh;
+				GenerateTerrainMesh(fullMap[key], fullOptions, mesh);
+				fullBytes += mesh.vertices.size() * sizeof(float) + mesh.indices.size() * sizeof(uint32_t) + paddedBytes + splatBytes;
+			}
+			const double fullMesh = MsSince(start);
+
+			// --- Region ---
+			std::unordered_map<int32_t, TerrainVertexRect> regionDirty;
+			start = Clock::now();
+			RegionDab(regionMap, brush, tool, x, z, radius, amount, regionDirty);
+			const double regionBrush = MsSince(start);
+			start = Clock::now();
+			for (const auto& [key, rect] : regionDirty)
+			{
+				TerrainMeshRegionData region;
+				GenerateTerrainMeshRegion(regionMap[key], regionOptions, rect, region);
+
+				std::vector<float>& gpu = gpuVertices[key];
+				const int meshRes = regionOptions.meshResolution;
+				for (int row = 0; row < region.cornerHeight; row++)
+				{
+					std::copy_n(&region.cornerVertices[row * region.cornerWidth * 8], region.cornerWidth * 8,
+								&gpu[((region.cornerZ + row) * meshRes + region.cornerX) * 8]);
+				}
+				for (int row = 0; row < region.centerHeight; row++)
+				{
+					std::copy_n(&region.centerVertices[row * region.centerWidth * 8], region.centerWidth * 8,
+								&gpu[(meshRes * meshRes + (region.centerZ + row) * (meshRes - 1) + region.centerX) * 8]);
+				}
+				if (!region.IsEmpty())
+					regionBytes += (region.cornerVertices.size() + region.centerVertices.size()) * sizeof(float) + paddedBytes;
+			}
+			const double regionMesh = MsSince(start);
+
+			fullBrushMs += fullBrush;
+			fullMeshMs += fullMesh;
+			fullWorstMs = std::max(fullWorstMs, fullBrush + fullMesh);
+			regionBrushMs += regionBrush;
+			regionMeshMs += regionMesh;
+			regionWorstMs = std::max(regionWorstMs, regionBrush + regionMesh);
+		}
+
+		auto report = [&](const char* path, double brushMs, double meshMs, double worstMs, size_t bytes) {
+			std::cout << "  " << std::setw(4) << static_cast<int>(radius) << " m   " << path << std::setw(10)
+					  << brushMs / DABS_PER_SIZE << std::setw(10) << meshMs / DABS_PER_SIZE << std::setw(11)
+					  << (brushMs + meshMs) / DABS_PER_SIZE << std::setw(11) << worstMs << std::setw(12)
+					  << bytes / 1024.0 / DABS_PER_SIZE << "   " << (worstMs < FRAME_BUDGET_MS ? "yes" : "no") << "\n";
+		};
+		report("full  ", fullBrushMs, fullMeshMs, fullWorstMs, fullBytes);
+		report("region", regionBrushMs, regionMeshMs, regionWorstMs, regionBytes);
+	}
+	std::cout << "\n  (full mesh work was throttled to 2 chunks a frame in the editor, so big brushes lagged behind)\n";
+
+	if (!SameHeights(fullMap, regionMap))
+		fail("region kernels left different heights than the full-chunk brush");
+
+	const TerrainMeshOptions options = EditorMeshOptions(regionMap);
+	for (const auto& [key, data] : regionMap)
+	{
+		TerrainMeshData mesh;
+		GenerateTerrainMesh(data, options, mesh);
+		const std::vector<float>& gpu = gpuVertices[key];
+		if (gpu.size() != mesh.vertices.size() ||
+			std::memcmp(gpu.data(), mesh.vertices.data(), gpu.size() * sizeof(float)) != 0)
+		{
+			fail("region-patched mesh differs from a full regeneration");
+			break;
+		}
+	}
+
+	return ok ? 0 : 1;
+}
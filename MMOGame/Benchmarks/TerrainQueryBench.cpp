@@ -0,0 +1,327 @@
+// Benchmark + correctness check: server terrain queries from a baked .strn.
+//
+// Bakes a synthetic 8x8-chunk map (rolling hills, a cliff, a chunk with
+// holes, a long wall and a town of rotated houses) through
+// ServerTerrainBuilder, saves it, loads it back and times:
+//
+// chunk map = what the client does today: unordered_map chunk lookup +
+//             GetTerrainHeight on the float heightmap.
+// strn      = ServerTerrain::GetHeight / IsWalkable / HasLineOfSight.
+//
+// Checks: heights within the uint16 quantization step of GetTerrainHeight,
+// holes and the outside report no ground, the cliff and wall are not
+// walkable, the wall blocks sight, the loaded file answers every query like
+// the baked one, and HasLineOfSight agrees with a finely sampled reference
+// on random segments. Exit code is non-zero on any failure.
+
+#include "Terrain/ServerTerrain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+
+	constexpr int CHUNKS_MIN = -4;
+	constexpr int CHUNKS_MAX = 3; // Inclusive: 8x8 chunks, 512x512 m
+	constexpr int HOLE_CHUNK_X = -2;
+	constexpr int HOLE_CHUNK_Z = 1;
+	constexpr float CLIFF_X = -150.0f;
+	constexpr float WALL_X = -50.0f;
+	constexpr int QUERY_COUNT = 1'000'000;
+	constexpr int LOS_COUNT = 100'000;
+	constexpr int LOS_REFERENCE_COUNT = 20'000;
+	constexpr float EYE = 1.5f;
+
+	float Ground(float x, float z)
+	{
+		float h = 4.0f * std::sin(x * 0.03f) * std::cos(z * 0.025f) + 0.5f * std::sin(x * 0.21f + z * 0.17f);
+		// 15 m rise over 2 m: far past any walkable slope
+		h += std::clamp((x - CLIFF_X) * 0.5f, 0.0f, 1.0f) * 15.0f;
+		return h;
+	}
+
+	int64_t ChunkKey(int32_t chunkX, int32_t chunkZ)
+	{
+		return (static_cast<int64_t>(chunkX) << 32) | static_cast<uint32_t>(chunkZ);
+	}
+
+	std::unordered_map<int64_t, TerrainChunkData> MakeChunks()
+	{
+		std::unordered_map<int64_t, TerrainChunkData> chunks;
+		for (int cz = CHUNKS_MIN; cz <= CHUNKS_MAX; cz++)
+		{
+			for (int cx = CHUNKS_MIN; cx <= CHUNKS_MAX; cx++)
+			{
+				TerrainChunkData data;
+				data.chunkX = cx;
+				data.chunkZ = cz;
+				data.heightmap.resize(TERRAIN_CHUNK_HEIGHTMAP_SIZE);
+				for (int z = 0; z < TERRAIN_CHUNK_RESOLUTION; z++)
+				{
+					for (int x = 0; x < TERRAIN_CHUNK_RESOLUTION; x++)
+					{
+						float step = TERRAIN_CHUNK_SIZE / (TERRAIN_CHUNK_RESOLUTION - 1);
+						data.heightmap[z * TERRAIN_CHUNK_RESOLUTION + x] =
+							Ground(cx * TERRAIN_CHUNK_SIZE + x * step, cz * TERRAIN_CHUNK_SIZE + z * step);
+					}
+				}
+				if (cx == HOLE_CHUNK_X && cz == HOLE_CHUNK_Z)
+					data.holeMask = 0x00000000FFFFFFFFULL; // Southern half
+				data.CalculateBounds();
+				chunks[ChunkKey(cx, cz)] = std::move(data);
+			}
+		}
+		return chunks;
+	}
+
+	std::vector<TerrainObstacle> MakeObstacles(std::mt19937& rng)
+	{
+		std::vector<TerrainObstacle> obstacles;
+
+		// A wall, 60 m long and far taller than an agent
+		TerrainObstacle wall;
+		wall.centerX = WALL_X;
+		wall.centerZ = -50.0f;
+		wall.halfExtentX = 1.0f;
+		wall.halfExtentZ = 30.0f;
+		wall.bottom = -50.0f;
+		wall.top = 50.0f;
+		obstacles.push_back(wall);
+
+		// Houses in the north-east quadrant
+		std::uniform_real_distribution<float> pos(20.0f, 240.0f);
+		std::uniform_real_distribution<float> size(2.0f, 5.0f);
+		std::uniform_real_distribution<float> yaw(0.0f, 6.2831853f);
+		for (int i = 0; i < 300; i++)
+		{
+			TerrainObstacle house;
+			house.centerX = pos(rng);
+			house.centerZ = pos(rng);
+			house.halfExtentX = size(rng);
+			house.halfExtentZ = size(rng);
+			house.yaw = yaw(rng);
+			house.bottom = Ground(house.centerX, house.centerZ) - 1.0f;
+			house.top = house.bottom + 8.0f;
+			obstacles.push_back(house);
+		}
+		return obstacles;
+	}
+
+	// GetTerrainHeight through a hashed chunk lookup, as the client samples
+	bool ChunkMapHeight(const std::unordered_map<int64_t, TerrainChunkData>& chunks, float x, float z, float& out)
+	{
+		int32_t cx = WorldToChunkCoord(x);
+		int32_t cz = WorldToChunkCoord(z);
+		auto it = chunks.find(ChunkKey(cx, cz));
+		if (it == chunks.end())
+			return false;
+		out = GetTerrainHeight(it->second, x - cx * TERRAIN_CHUNK_SIZE, z - cz * TERRAIN_CHUNK_SIZE);
+		return true;
+	}
+
+	// Sight by dense sampling, the same rules as HasLineOfSight
+	bool ReferenceLineOfSight(const ServerTerrain& terrain, float fx, float fz, float fh, float tx, float tz, float th)
+	{
+		const int32_t startX = ServerTerrain::WorldToCell(fx), startZ = ServerTerrain::WorldToCell(fz);
+		const int32_t endX = ServerTerrain::WorldToCell(tx), endZ = ServerTerrain::WorldToCell(tz);
+		const float length = std::hypot(tx - fx, tz - fz);
+		const int samples = std::max(1, static_cast<int>(length / 0.01f));
+		for (int i = 0; i <= samples; i++)
+		{
+			float t = static_cast<float>(i) / samples;
+			float x = fx + (tx - fx) * t;
+			float z = fz + (tz - fz) * t;
+			int32_t cellX = ServerTerrain::WorldToCell(x), cellZ = ServerTerrain::WorldToCell(z);
+			bool endpoint = (cellX == startX && cellZ == startZ) || (cellX == endX && cellZ == endZ);
+			if (!endpoint && terrain.IsCellBlocked(cellX, cellZ))
+				return false;
+			float ground;
+			if (terrain.GetHeight(x, z, ground) && fh + (th - fh) * t < ground)
+				return false;
+		}
+		return true;
+	}
+
+	double NsPerQuery(Clock::time_point start, int count)
+	{
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(1);
+	std::mt19937 rng(1234);
+	bool ok = true;
+	auto fail = [&](const char* what) {
+		std::cout << "  ** FAILED: " << what << " **\n";
+		ok = false;
+	};
+
+	const auto chunks = MakeChunks();
+	const auto obstacles = MakeObstacles(rng);
+
+	ServerTerrainBuilder builder;
+	for (const auto& [key, data] : chunks)
+	{
+		builder.AddChunk(data);
+	}
+	for (const TerrainObstacle& obstacle : obstacles)
+	{
+		builder.AddObstacle(obstacle);
+	}
+
+	auto bakeStart = Clock::now();
+	ServerTerrain baked;
+	builder.Build(baked);
+	double bakeMs = std::chrono::duration<double, std::milli>(Clock::now() - bakeStart).count();
+
+	const std::string path = (std::filesystem::temp_directory_path() / "TerrainQueryBench.strn").string();
+	ServerTerrain terrain;
+	if (!baked.Save(path) || !terrain.Load(path))
+	{
+		std::cout << "Failed to save/load " << path << '\n';
+		return 1;
+	}
+
+	std::cout << "Server terrain: " << terrain.GetChunkCount() << " chunks, " << terrain.CountWalkableCells()
+			  << " walkable / " << terrain.CountBlockedCells() << " blocked cells, " << obstacles.size()
+			  << " obstacles, baked in " << bakeMs << " ms, "
+			  << std::filesystem::file_size(path) / 1024 << " KB on disk\n\n";
+	std::filesystem::remove(path);
+
+	const float mapMin = CHUNKS_MIN * TERRAIN_CHUNK_SIZE;
+	const float mapMax = (CHUNKS_MAX + 1) * TERRAIN_CHUNK_SIZE;
+	std::uniform_real_distribution<float> coord(mapMin, mapMax);
+
+	// ---- Correctness ----
+	int heightMismatches = 0, roundTripMismatches = 0;
+	for (int i = 0; i < 100'000; i++)
+	{
+		float x = coord(rng), z = coord(rng);
+		float expected, got, gotBaked;
+		bool has = terrain.GetHeight(x, z, got);
+		if (has != baked.GetHeight(x, z, gotBaked) || (has && got != gotBaked) ||
+			terrain.IsWalkable(x, z) != baked.IsWalkable(x, z))
+			roundTripMismatches++;
+
+		ChunkMapHeight(chunks, x, z, expected);
+		const TerrainChunkData& data = chunks.at(ChunkKey(WorldToChunkCoord(x), WorldToChunkCoord(z)));
+		const float tolerance = (data.maxHeight - data.minHeight) / 65535.0f + 1e-3f;
+		bool inHole = WorldToChunkCoord(x) == HOLE_CHUNK_X && WorldToChunkCoord(z) == HOLE_CHUNK_Z &&
+					  z - HOLE_CHUNK_Z * TERRAIN_CHUNK_SIZE < TERRAIN_CHUNK_SIZE * 0.5f;
+		if (has == inHole || (has && std::abs(got - expected) > tolerance))
+			heightMismatches++;
+	}
+	std::cout << "Heights vs GetTerrainHeight (100k points): " << heightMismatches << " mismatches\n";
+	std::cout << "Loaded vs baked (100k points):             " << roundTripMismatches << " mismatches\n";
+	if (heightMismatches)
+		fail("heights");
+	if (roundTripMismatches)
+		fail("save/load round trip");
+
+	float unused;
+	if (terrain.GetHeight(mapMax + 10.0f, 0.0f, unused) || terrain.IsWalkable(mapMin - 10.0f, 0.0f))
+		fail("outside the map has ground");
+	if (!terrain.IsWalkable(0.5f, -100.5f) || terrain.IsWalkable(CLIFF_X + 1.0f, 0.0f))
+		fail("slope walkability");
+	if (terrain.IsWalkable(WALL_X, -50.0f) || !terrain.IsWalkable(WALL_X + 3.0f, -50.0f))
+		fail("wall footprint");
+	if (terrain.HasLineOfSight(WALL_X - 5.0f, -50.0f, Ground(WALL_X - 5.0f, -50.0f) + EYE,
+							   WALL_X + 5.0f, -50.0f, Ground(WALL_X + 5.0f, -50.0f) + EYE))
+		fail("wall does not block sight");
+	if (!terrain.HasLineOfSight(WALL_X - 5.0f, 50.0f, 100.0f, WALL_X + 5.0f, 50.0f, 100.0f))
+		fail("open sky blocks sight");
+	if (terrain.HasLineOfSight(CLIFF_X - 10.0f, 0.0f, Ground(CLIFF_X - 10.0f, 0.0f) + EYE,
+							   CLIFF_X + 10.0f, 0.0f, Ground(CLIFF_X + 10.0f, 0.0f) + 30.0f) != true ||
+		terrain.HasLineOfSight(CLIFF_X - 10.0f, 0.0f, Ground(CLIFF_X - 10.0f, 0.0f) + EYE,
+							   CLIFF_X + 10.0f, 0.0f, Ground(CLIFF_X + 10.0f, 0.0f) + EYE))
+		fail("cliff sight");
+
+	// HasLineOfSight samples twice per cell; the reference every centimeter
+	std::uniform_real_distribution<float> offset(-40.0f, 40.0f);
+	int losAgree = 0, losVisible = 0;
+	for (int i = 0; i < LOS_REFERENCE_COUNT; i++)
+	{
+		float fx = coord(rng), fz = coord(rng);
+		float tx = std::clamp(fx + offset(rng), mapMin, mapMax - 0.01f);
+		float tz = std::clamp(fz + offset(rng), mapMin, mapMax - 0.01f);
+		float fh = Ground(fx, fz) + EYE, th = Ground(tx, tz) + EYE;
+		bool got = terrain.HasLineOfSight(fx, fz, fh, tx, tz, th);
+		bool expected = ReferenceLineOfSight(terrain, fx, fz, fh, tx, tz, th);
+		losAgree += got == expected;
+		losVisible += got;
+	}
+	double agreement = 100.0 * losAgree / LOS_REFERENCE_COUNT;
+	std::cout << "Line of sight vs 1 cm sampling (" << LOS_REFERENCE_COUNT / 1000 << "k segments): "
+			  << std::setprecision(2) << agreement << "% agree, " << 100.0 * losVisible / LOS_REFERENCE_COUNT
+			  << "% visible\n\n"
+			  << std::setprecision(1);
+	if (agreement < 99.0)
+		fail("line of sight disagrees with the reference");
+
+	// ---- Timing ----
+	std::vector<float> xs(QUERY_COUNT), zs(QUERY_COUNT);
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		xs[i] = coord(rng);
+		zs[i] = coord(rng);
+	}
+
+	float sink = 0.0f;
+	auto start = Clock::now();
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		float h;
+		if (ChunkMapHeight(chunks, xs[i], zs[i], h))
+			sink += h;
+	}
+	double chunkMapNs = NsPerQuery(start, QUERY_COUNT);
+
+	start = Clock::now();
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		float h;
+		if (terrain.GetHeight(xs[i], zs[i], h))
+			sink += h;
+	}
+	double heightNs = NsPerQuery(start, QUERY_COUNT);
+
+	int walkable = 0;
+	start = Clock::now();
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		walkable += terrain.IsWalkable(xs[i], zs[i]);
+	}
+	double walkNs = NsPerQuery(start, QUERY_COUNT);
+
+	int visible = 0;
+	start = Clock::now();
+	for (int i = 0; i < LOS_COUNT; i++)
+	{
+		float tx = std::clamp(xs[i] + offset(rng), mapMin, mapMax - 0.01f);
+		float tz = std::clamp(zs[i] + offset(rng), mapMin, mapMax - 0.01f);
+		visible += terrain.HasLineOfSight(xs[i], zs[i], Ground(xs[i], zs[i]) + EYE, tx, tz, Ground(tx, tz) + EYE);
+	}
+	double losNs = NsPerQuery(start, LOS_COUNT);
+
+	std::cout << "Height, chunk map + GetTerrainHeight: " << std::setw(7) << chunkMapNs << " ns/query\n";
+	std::cout << "Height, ServerTerrain::GetHeight:     " << std::setw(7) << heightNs << " ns/query\n";
+	std::cout << "ServerTerrain::IsWalkable:            " << std::setw(7) << walkNs << " ns/query\n";
+	std::cout << "ServerTerrain::HasLineOfSight (<57m): " << std::setw(7) << losNs << " ns/query\n";
+	std::cout << "(checksum " << sink + walkable + visible << ")\n";
+
+	return ok ? 0 : 1;
+}
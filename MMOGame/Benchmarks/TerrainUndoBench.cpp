@@ -0,0 +1,330 @@
+// Benchmark + correctness check: the editor's terrain undo records.
+//
+// Paints a synthetic 8x8-chunk map with a session of brush strokes the way
+// EditorWorldSystem does (every chunk in the brush's bounding box is
+// touched per dab, strokes wander across chunk borders) and records each
+// stroke with TerrainEditRecorder. Compares what the history would hold:
+//
+// snapshots = a full TerrainChunkData copy per touched chunk per stroke
+//             (the old EditSnapshot).
+// deltas    = TerrainChunkDelta: compressed dirty rectangles of heights and
+//             splat texels.
+//
+// Checks: undoing every stroke newest-first restores the starting map
+// bit for bit, redoing them all gives the painted map back, and strokes that
+// change nothing produce no record. Exit code is non-zero on any failure.
+
+#include "Terrain/TerrainEditDelta.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace MMO;
+	using Editor3D::TerrainChunkDelta;
+	using Editor3D::TerrainEditRecorder;
+
+	constexpr int CHUNKS = 8; // 8x8 chunks from (0, 0), 512x512 m
+	constexpr int STROKES = 400;
+	constexpr int DABS_PER_STROKE = 40;
+
+	using ChunkMap = std::unordered_map<int32_t, TerrainChunkData>;
+
+	int32_t Key(int32_t x, int32_t z)
+	{
+		return static_cast<int32_t>((static_cast<uint32_t>(x) << 16) | (static_cast<uint32_t>(z) & 0xFFFF));
+	}
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	size_t ChunkBytes(const TerrainChunkData& data)
+	{
+		size_t bytes = sizeof(data) + data.heightmap.capacity() * sizeof(float) + data.splatmap.capacity();
+		for (const auto& id : data.materialIds)
+			bytes += id.capacity();
+		return bytes;
+	}
+
+	ChunkMap BuildMap(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> phase(0.0f, 6.28f);
+		const float p0 = phase(rng), p1 = phase(rng);
+		ChunkMap map;
+		for (int cz = 0; cz < CHUNKS; cz++)
+		{
+			for (int cx = 0; cx < CHUNKS; cx++)
+			{
+				TerrainChunkData data;
+				data.chunkX = cx;
+				data.chunkZ = cz;
+				data.materialIds[0] = "grass";
+				// A quarter of the chunks have never been sculpted or painted
+				if ((cx + cz) % 4 != 0)
+				{
+					data.heightmap.resize(TERRAIN_CHUNK_HEIGHTMAP_SIZE);
+					for (int z = 0; z < TERRAIN_CHUNK_RESOLUTION; z++)
+					{
+						for (int x = 0; x < TERRAIN_CHUNK_RESOLUTION; x++)
+						{
+							const float wx = cx * TERRAIN_CHUNK_SIZE + x * TERRAIN_CHUNK_SIZE / (TERRAIN_CHUNK_RESOLUTION - 1);
+							const float wz = cz * TERRAIN_CHUNK_SIZE + z * TERRAIN_CHUNK_SIZE / (TERRAIN_CHUNK_RESOLUTION - 1);
+							// Flat valley floor in the middle, hills around it
+							const float hills = 8.0f * std::sin(wx * 0.021f + p0) * std::cos(wz * 0.017f + p1);
+							data.heightmap[z * TERRAIN_CHUNK_RESOLUTION + x] = std::max(hills, 0.0f);
+						}
+					}
+					data.splatmap.assign(static_cast<size_t>(TERRAIN_SPLATMAP_TEXELS) * TERRAIN_MAX_LAYERS, 0);
+					for (int i = 0; i < TERRAIN_SPLATMAP_TEXELS; i++)
+						data.splatmap[static_cast<size_t>(i) * TERRAIN_MAX_LAYERS] = 255;
+				}
+				data.CalculateBounds();
+				map.emplace(Key(cx, cz), std::move(data));
+			}
+		}
+		return map;
+	}
+
+	enum class Tool
+	{
+		Raise,
+		Flatten,
+		Paint,
+		Hole,
+	};
+
+	// EditorWorldSystem::ApplyBrush / PaintSplatmapLayer / SetHole on raw
+	// chunk data, touching (and capturing) every chunk in the bounding box
+	void Dab(ChunkMap& map, TerrainEditRecorder& recorder, Tool tool, float worldX, float worldZ, float radius,
+			 float amount, int layer)
+	{
+		const int minCX = std::max(0, static_cast<int>(std::floor((worldX - radius) / TERRAIN_CHUNK_SIZE)));
+		const int maxCX = std::min(CHUNKS - 1, static_cast<int>(std::floor((worldX + radius) / TERRAIN_CHUNK_SIZE)));
+		const int minCZ = std::max(0, static_cast<int>(std::floor((worldZ - radius) / TERRAIN_CHUNK_SIZE)));
+		const int maxCZ = std::min(CHUNKS - 1, static_cast<int>(std::floor((worldZ + radius) / TERRAIN_CHUNK_SIZE)));
+
+		for (int cz = minCZ; cz <= maxCZ; cz++)
+		{
+			for (int cx = minCX; cx <= maxCX; cx++)
+			{
+				TerrainChunkData& data = map[Key(cx, cz)];
+				recorder.Capture(Key(cx, cz), data);
+
+				if (tool == Tool::Hole)
+				{
+					const int hx = static_cast<int>((worldX - cx * TERRAIN_CHUNK_SIZE) / TERRAIN_CHUNK_SIZE * TERRAIN_HOLE_GRID_SIZE);
+					const int hz = static_cast<int>((worldZ - cz * TERRAIN_CHUNK_SIZE) / TERRAIN_CHUNK_SIZE * TERRAIN_HOLE_GRID_SIZE);
+					if (hx >= 0 && hx < TERRAIN_HOLE_GRID_SIZE && hz >= 0 && hz < TERRAIN_HOLE_GRID_SIZE)
+						data.holeMask |= 1ULL << (hz * TERRAIN_HOLE_GRID_SIZE + hx);
+					continue;
+				}
+
+				if (tool == Tool::Paint)
+				{
+					if (data.materialIds[layer].empty())
+						data.materialIds[layer] = "layer" + std::to_string(layer);
+					if (data.splatmap.empty())
+					{
+						data.splatmap.assign(static_cast<size_t>(TERRAIN_SPLATMAP_TEXELS) * TERRAIN_MAX_LAYERS, 0);
+						for (int i = 0; i < TERRAIN_SPLATMAP_TEXELS; i++)
+							data.splatmap[static_cast<size_t>(i) * TERRAIN_MAX_LAYERS] = 255;
+					}
+					for (int sz = 0; sz < TERRAIN_SPLATMAP_RESOLUTION; sz++)
+					{
+						for (int sx = 0; sx < TERRAIN_SPLATMAP_RESOLUTION; sx++)
+						{
+							const float dx = cx * TERRAIN_CHUNK_SIZE + (sx + 0.5f) / TERRAIN_SPLATMAP_RESOLUTION * TERRAIN_CHUNK_SIZE - worldX;
+							const float dz = cz * TERRAIN_CHUNK_SIZE + (sz + 0.5f) / TERRAIN_SPLATMAP_RESOLUTION * TERRAIN_CHUNK_SIZE - worldZ;
+							const float dist = std::sqrt(dx * dx + dz * dz);
+							if (dist > radius)
+								continue;
+							uint8_t* texel = &data.splatmap[static_cast<size_t>(sz * TERRAIN_SPLATMAP_RESOLUTION + sx) * TERRAIN_MAX_LAYERS];
+							float weights[TERRAIN_MAX_LAYERS];
+							float total = 0.0f;
+							for (int i = 0; i < TERRAIN_MAX_LAYERS; i++)
+								weights[i] = texel[i] / 255.0f;
+							weights[layer] += amount * (1.0f - dist / radius);
+							for (float w : weights)
+								total += w;
+							for (int i = 0; i < TERRAIN_MAX_LAYERS; i++)
+								texel[i] = static_cast<uint8_t>(weights[i] / total * 255.0f);
+						}
+					}
+					continue;
+				}
+
+				if (data.heightmap.empty())
+					data.heightmap.resize(TERRAIN_CHUNK_HEIGHTMAP_SIZE, 0.0f);
+				for (int lz = 0; lz < TERRAIN_CHUNK_RESOLUTION; lz++)
+				{
+					for (int lx = 0; lx < TERRAIN_CHUNK_RESOLUTION; lx++)
+					{
+						const float dx = cx * TERRAIN_CHUNK_SIZE + lx * TERRAIN_CHUNK_SIZE / (TERRAIN_CHUNK_RESOLUTION - 1) - worldX;
+						const float dz = cz * TERRAIN_CHUNK_SIZE + lz * TERRAIN_CHUNK_SIZE / (TERRAIN_CHUNK_RESOLUTION - 1) - worldZ;
+						const float dist = std::sqrt(dx * dx + dz * dz);
+						if (dist > radius)
+							continue;
+						float& h = data.heightmap[lz * TERRAIN_CHUNK_RESOLUTION + lx];
+						if (tool == Tool::Raise)
+							h += amount * (1.0f - dist / radius);
+						else
+							h = h + (amount - h) * (1.0f - dist / radius);
+					}
+				}
+				data.CalculateBounds();
+			}
+		}
+	}
+
+	bool SameData(const TerrainChunkData& a, const TerrainChunkData& b)
+	{
+		if (a.heightmap.size() != b.heightmap.size() || a.splatmap != b.splatmap || a.holeMask != b.holeMask)
+			return false;
+		if (!a.heightmap.empty() && std::memcmp(a.heightmap.data(), b.heightmap.data(), a.heightmap.size() * sizeof(float)) != 0)
+			return false;
+		for (int i = 0; i < TERRAIN_MAX_LAYERS; i++)
+		{
+			if (a.materialIds[i] != b.materialIds[i])
+				return false;
+		}
+		return a.heightmap.empty() || (a.minHeight == b.minHeight && a.maxHeight == b.maxHeight);
+	}
+
+	bool SameMap(const ChunkMap& a, const ChunkMap& b)
+	{
+		for (const auto& [key, data] : a)
+		{
+			auto it = b.find(key);
+			if (it == b.end() || !SameData(data, it->second))
+				return false;
+		}
+		return a.size() == b.size();
+	}
+
+} // namespace
+
+int main()
+{
+	std::cout << std::fixed << std::setprecision(2);
+	std::mt19937 rng(2024);
+	bool ok = true;
+	auto fail = [&](const char* what) {
+		std::cout << "  ** FAILED: " << what << " **\n";
+		ok = false;
+	};
+
+	ChunkMap map = BuildMap(rng);
+	const ChunkMap start = map;
+	std::uniform_real_distribution<float> coord(0.0f, CHUNKS * TERRAIN_CHUNK_SIZE);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> radiusDist(4.0f, 24.0f);
+	std::uniform_int_distribution<int> toolDist(0, 9);
+	std::uniform_int_distribution<int> layerDist(1, TERRAIN_MAX_LAYERS - 1);
+
+	TerrainEditRecorder recorder;
+	std::vector<std::vector<TerrainChunkDelta>> history;
+	size_t snapshotBytes = 0;
+	size_t deltaBytes = 0;
+	size_t touchedChunks = 0;
+	size_t changedChunks = 0;
+	double dabMs = 0.0;
+	double finishMs = 0.0;
+	double worstFinishMs = 0.0;
+
+	auto lookup = [&map](int32_t key) -> const TerrainChunkData* {
+		auto it = map.find(key);
+		return it != map.end() ? &it->second : nullptr;
+	};
+
+	for (int stroke = 0; stroke < STROKES; stroke++)
+	{
+		const int roll = toolDist(rng);
+		const Tool tool = roll < 4 ? Tool::Raise : roll < 6 ? Tool::Flatten : roll < 9 ? Tool::Paint : Tool::Hole;
+		const float radius = radiusDist(rng);
+		const int layer = layerDist(rng);
+		float x = coord(rng);
+		float z = coord(rng);
+
+		recorder.Begin();
+		const auto dabStart = Clock::now();
+		const int dabs = tool == Tool::Hole ? 1 : DABS_PER_STROKE;
+		for (int dab = 0; dab < dabs; dab++)
+		{
+			const float amount = tool == Tool::Raise ? 0.05f : tool == Tool::Flatten ? 2.0f : 0.1f;
+			Dab(map, recorder, tool, x, z, radius, amount, layer);
+			x += unit(rng) * radius * 0.3f;
+			z += unit(rng) * radius * 0.3f;
+		}
+		dabMs += MsSince(dabStart);
+
+		touchedChunks += recorder.GetCaptured().size();
+		for (const auto& [key, data] : recorder.GetCaptured())
+			snapshotBytes += ChunkBytes(data);
+
+		const auto finishStart = Clock::now();
+		std::vector<TerrainChunkDelta> deltas = recorder.Finish(lookup);
+		const double ms = MsSince(finishStart);
+		finishMs += ms;
+		worstFinishMs = std::max(worstFinishMs, ms);
+
+		changedChunks += deltas.size();
+		for (const auto& delta : deltas)
+			deltaBytes += delta.GetMemoryUsage();
+		if (!deltas.empty())
+			history.push_back(std::move(deltas));
+	}
+	const ChunkMap painted = map;
+
+	// A stroke entirely off the map touches nothing and must leave no record
+	recorder.Begin();
+	if (!recorder.Finish(lookup).empty())
+		fail("an empty edit produced a record");
+
+	auto apply = [&map](const std::vector<TerrainChunkDelta>& deltas, bool undo) {
+		for (const auto& delta : deltas)
+			Editor3D::ApplyTerrainDelta(delta, map[Key(delta.chunkX, delta.chunkZ)], undo);
+	};
+
+	const auto undoStart = Clock::now();
+	for (auto it = history.rbegin(); it != history.rend(); ++it)
+		apply(*it, true);
+	const double undoMs = MsSince(undoStart);
+	if (!SameMap(map, start))
+		fail("undoing every stroke did not restore the starting map");
+
+	const auto redoStart = Clock::now();
+	for (const auto& deltas : history)
+		apply(deltas, false);
+	const double redoMs = MsSince(redoStart);
+	if (!SameMap(map, painted))
+		fail("redoing every stroke did not give the painted map back");
+
+	std::cout << "Session: " << STROKES << " strokes of " << DABS_PER_STROKE << " dabs on " << CHUNKS << "x" << CHUNKS
+			  << " chunks, " << history.size() << " undo records\n";
+	std::cout << "  chunks touched " << touchedChunks << ", changed " << changedChunks << "\n\n";
+	std::cout << "History memory\n";
+	std::cout << "  snapshots: " << std::setw(9) << snapshotBytes / (1024.0 * 1024.0) << " MB ("
+			  << snapshotBytes / std::max<size_t>(1, history.size()) / 1024.0 << " KB/stroke)\n";
+	std::cout << "  deltas:    " << std::setw(9) << deltaBytes / (1024.0 * 1024.0) << " MB ("
+			  << deltaBytes / std::max<size_t>(1, history.size()) / 1024.0 << " KB/stroke), "
+			  << static_cast<double>(snapshotBytes) / std::max<size_t>(1, deltaBytes) << "x smaller\n\n";
+	std::cout << "Time\n";
+	std::cout << "  brush dabs (incl. first-touch capture): " << std::setw(7) << dabMs / STROKES << " ms/stroke\n";
+	std::cout << "  EndEdit diff + encode:                  " << std::setw(7) << finishMs / STROKES
+			  << " ms/stroke avg, " << worstFinishMs << " ms worst\n";
+	std::cout << "  undo all / redo all:                    " << std::setw(7) << undoMs << " / " << redoMs << " ms\n";
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,324 @@
+// Benchmark + round-trip check for the exporter's block-compressed textures.
+//
+// Generates the kinds of images ExportForRuntime transcodes (a smooth albedo,
+// a noisy albedo, a cut-out with alpha, a tangent-space normal map and an RMA
+// mask, plus sizes that are not a multiple of 4), then for each format the
+// exporter can pick:
+//   - CompressBlocks -> DecompressBlocks and reports PSNR against the source
+//     over the channels the format keeps;
+//   - encode throughput (MB of RGBA8 input per second);
+//   - EncodeDds -> ParseDds: the mip chain must reach 1x1 and account for
+//     every byte of the file, and level 0 must match CompressBlocks.
+// The ratio column is RGBA8 + mips over the .dds file (header included).
+//
+// CPU only; needs no GL context. Exits non-zero if any image falls under its
+// PSNR floor or a DDS file does not round-trip.
+
+#include <Graphics/BlockCompression.h>
+#include <Graphics/DdsFile.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	using namespace Onyx;
+
+	struct TestImage
+	{
+		std::string name;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<uint8_t> rgba;
+		TextureUsage usage = TextureUsage::Color;
+	};
+
+	struct Case
+	{
+		const TestImage* image;
+		BlockFormat format;
+		double minPsnr;
+	};
+
+	TestImage MakeImage(const std::string& name, uint32_t width, uint32_t height, TextureUsage usage)
+	{
+		TestImage image;
+		image.name = name;
+		image.width = width;
+		image.height = height;
+		image.usage = usage;
+		image.rgba.resize(size_t(width) * height * 4);
+		return image;
+	}
+
+	TestImage SmoothAlbedo(uint32_t width, uint32_t height)
+	{
+		TestImage image = MakeImage("smooth " + std::to_string(width) + "x" + std::to_string(height), width, height,
+									TextureUsage::Color);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				uint8_t* p = &image.rgba[(size_t(y) * width + x) * 4];
+				const float u = float(x) / float(width);
+				const float v = float(y) / float(height);
+				p[0] = static_cast<uint8_t>(120.0f + 100.0f * std::sin(u * 6.0f));
+				p[1] = static_cast<uint8_t>(90.0f + 80.0f * v);
+				p[2] = static_cast<uint8_t>(60.0f + 50.0f * std::cos((u + v) * 4.0f));
+				p[3] = 255;
+			}
+		}
+		return image;
+	}
+
+	TestImage NoisyAlbedo(uint32_t size)
+	{
+		TestImage image = MakeImage("noisy albedo", size, size, TextureUsage::Color);
+		std::mt19937 rng(7);
+		std::uniform_int_distribution<int> noise(-24, 24);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				uint8_t* p = &image.rgba[(size_t(y) * size + x) * 4];
+				// Stone-like: a base tint with per-texel grain
+				const int grain = noise(rng);
+				p[0] = static_cast<uint8_t>(std::clamp(128 + grain + int(x % 64), 0, 255));
+				p[1] = static_cast<uint8_t>(std::clamp(118 + grain, 0, 255));
+				p[2] = static_cast<uint8_t>(std::clamp(100 + grain - int(y % 32), 0, 255));
+				p[3] = 255;
+			}
+		}
+		return image;
+	}
+
+	TestImage CutoutAlbedo(uint32_t size)
+	{
+		TestImage image = MakeImage("cut-out foliage", size, size, TextureUsage::Color);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				uint8_t* p = &image.rgba[(size_t(y) * size + x) * 4];
+				const float dx = float(x % 32) - 16.0f;
+				const float dy = float(y % 32) - 16.0f;
+				const bool leaf = dx * dx + dy * dy < 150.0f;
+				p[0] = static_cast<uint8_t>(40 + (x * 3) % 60);
+				p[1] = static_cast<uint8_t>(110 + (y * 5) % 90);
+				p[2] = 30;
+				p[3] = leaf ? 255 : 0;
+			}
+		}
+		return image;
+	}
+
+	TestImage NormalMap(uint32_t size)
+	{
+		TestImage image = MakeImage("normal map", size, size, TextureUsage::Normal);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				// Bumps: derivative of a sum of sines, encoded as 0..255
+				const float nx = 0.4f * std::cos(float(x) * 0.15f) * std::sin(float(y) * 0.05f);
+				const float ny = 0.4f * std::sin(float(x) * 0.05f) * std::cos(float(y) * 0.15f);
+				const float nz = std::sqrt(std::max(0.0f, 1.0f - nx * nx - ny * ny));
+				uint8_t* p = &image.rgba[(size_t(y) * size + x) * 4];
+				p[0] = static_cast<uint8_t>((nx * 0.5f + 0.5f) * 255.0f + 0.5f);
+				p[1] = static_cast<uint8_t>((ny * 0.5f + 0.5f) * 255.0f + 0.5f);
+				p[2] = static_cast<uint8_t>((nz * 0.5f + 0.5f) * 255.0f + 0.5f);
+				p[3] = 255;
+			}
+		}
+		return image;
+	}
+
+	TestImage RmaMask(uint32_t size)
+	{
+		TestImage image = MakeImage("rma mask", size, size, TextureUsage::Data);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				uint8_t* p = &image.rgba[(size_t(y) * size + x) * 4];
+				p[0] = static_cast<uint8_t>(x * 255 / size);		  // Roughness ramp
+				p[1] = (x / 64 + y / 64) % 2 ? 255 : 0;				  // Metal/non-metal tiles
+				p[2] = static_cast<uint8_t>(200 + (x ^ y) % 56);	  // AO
+				p[3] = static_cast<uint8_t>(255 - y * 128 / size);	  // Spare channel
+			}
+		}
+		return image;
+	}
+
+	// Channels a format keeps: BC1 drops alpha, BC4/BC5 keep R / RG
+	int KeptChannels(BlockFormat format)
+	{
+		switch (format)
+		{
+		case BlockFormat::BC1:
+			return 3;
+		case BlockFormat::BC4:
+			return 1;
+		case BlockFormat::BC5:
+			return 2;
+		default:
+			return 4;
+		}
+	}
+
+	double Psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int channels)
+	{
+		double sum = 0.0;
+		size_t count = 0;
+		for (size_t i = 0; i < a.size(); i += 4)
+		{
+			for (int c = 0; c < channels; c++)
+			{
+				const double d = double(a[i + c]) - double(b[i + c]);
+				sum += d * d;
+				count++;
+			}
+		}
+		const double mse = sum / double(count);
+		return mse == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+	}
+
+	uint64_t MipChainBytes(uint32_t width, uint32_t height, size_t bytesPerTexel)
+	{
+		uint64_t total = 0;
+		while (true)
+		{
+			total += uint64_t(width) * height * bytesPerTexel;
+			if (width == 1 && height == 1)
+				break;
+			width = std::max(1u, width / 2);
+			height = std::max(1u, height / 2);
+		}
+		return total;
+	}
+
+	bool CheckDds(const TestImage& image, BlockFormat format, const std::vector<uint8_t>& blocks, uint64_t& fileBytes)
+	{
+		const std::vector<uint8_t> file = EncodeDds(image.rgba.data(), image.width, image.height, format);
+		fileBytes = file.size();
+
+		DdsImage dds;
+		std::string error;
+		if (!ParseDds(file.data(), file.size(), dds, &error))
+		{
+			std::cerr << "  ParseDds failed: " << error << "\n";
+			return false;
+		}
+		const auto& last = dds.levels.back();
+		if (dds.format != format || dds.width != image.width || dds.height != image.height || last.width != 1 ||
+			last.height != 1 || last.data + last.size != file.data() + file.size())
+		{
+			std::cerr << "  DDS layout mismatch\n";
+			return false;
+		}
+		if (dds.levels[0].size != blocks.size() || std::memcmp(dds.levels[0].data, blocks.data(), blocks.size()) != 0)
+		{
+			std::cerr << "  DDS level 0 differs from CompressBlocks\n";
+			return false;
+		}
+		// A truncated file must be rejected, not read past
+		if (ParseDds(file.data(), file.size() - 1, dds))
+		{
+			std::cerr << "  truncated DDS accepted\n";
+			return false;
+		}
+		return true;
+	}
+
+} // namespace
+
+int main()
+{
+	std::vector<TestImage> images;
+	images.push_back(SmoothAlbedo(512, 512));
+	images.push_back(SmoothAlbedo(37, 13));
+	images.push_back(NoisyAlbedo(512));
+	images.push_back(CutoutAlbedo(256));
+	images.push_back(NormalMap(512));
+	images.push_back(RmaMask(512));
+
+	// Floors sit a few dB under what the encoder reaches, so a regression in
+	// endpoint fitting or a bit-layout bug (which lands far lower) fails
+	std::vector<Case> cases;
+	for (const auto& image : images)
+	{
+		switch (image.usage)
+		{
+		case TextureUsage::Color:
+			cases.push_back({&image, BlockFormat::BC1, 30.0});
+			cases.push_back({&image, BlockFormat::BC3, 30.0});
+			cases.push_back({&image, BlockFormat::BC7, 30.0});
+			break;
+		case TextureUsage::Normal:
+			cases.push_back({&image, BlockFormat::BC5, 40.0});
+			cases.push_back({&image, BlockFormat::BC1, 30.0});
+			break;
+		case TextureUsage::Data:
+			cases.push_back({&image, BlockFormat::BC7, 30.0});
+			cases.push_back({&image, BlockFormat::BC4, 40.0});
+			break;
+		}
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::left << std::setw(20) << "image" << std::setw(7) << "format" << std::right << std::setw(10)
+			  << "PSNR dB" << std::setw(12) << "encode MB/s" << std::setw(12) << "VRAM ratio" << std::setw(8)
+			  << "chosen" << "\n";
+
+	bool ok = true;
+	for (const auto& testCase : cases)
+	{
+		const TestImage& image = *testCase.image;
+		std::vector<uint8_t> blocks(GetBlockCompressedSize(testCase.format, image.width, image.height));
+		std::vector<uint8_t> decoded(image.rgba.size());
+
+		// Repeat small images so the timing means something
+		const int repeats = std::max<int>(1, int((1u << 20) / (image.width * image.height)));
+		const auto start = Clock::now();
+		for (int r = 0; r < repeats; r++)
+		{
+			CompressBlocks(testCase.format, image.rgba.data(), image.width, image.height, blocks.data());
+		}
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		const double mbPerSecond = double(image.rgba.size()) * repeats / (1024.0 * 1024.0) / seconds;
+
+		const bool decodedAll =
+			DecompressBlocks(testCase.format, blocks.data(), image.width, image.height, decoded.data());
+		const double psnr = Psnr(image.rgba, decoded, KeptChannels(testCase.format));
+
+		uint64_t fileBytes = 0;
+		const bool ddsOk = CheckDds(image, testCase.format, blocks, fileBytes);
+		const double ratio = double(MipChainBytes(image.width, image.height, 4)) / double(fileBytes);
+		const bool chosen =
+			ChooseBlockFormat(image.usage, image.rgba.data(), image.rgba.size() / 4) == testCase.format;
+
+		std::cout << std::left << std::setw(20) << image.name << std::setw(7) << GetBlockFormatName(testCase.format)
+				  << std::right << std::setw(10) << psnr << std::setw(12) << mbPerSecond << std::setw(11) << ratio
+				  << "x" << std::setw(8) << (chosen ? "*" : "") << "\n";
+
+		if (!decodedAll || !ddsOk || psnr < testCase.minPsnr)
+		{
+			std::cerr << "FAIL: " << image.name << " " << GetBlockFormatName(testCase.format) << " (floor "
+					  << testCase.minPsnr << " dB)\n";
+			ok = false;
+		}
+	}
+
+	std::cout << "\n* = format ExportForRuntime picks for this image\n";
+	return ok ? 0 : 1;
+}
@@ -215,13 +215,12 @@ namespace MMO {
 		// Poll login server
 		if (m_LoginConnection.IsConnected())
 		{
-			std::vector<NetworkEvent> events;
-			m_LoginConnection.Poll(events, 0);
-			for (const auto& event : events)
+			m_LoginConnection.Poll(m_NetEvents, 0);
+			for (const auto& event : m_NetEvents)
 			{
 				if (event.type == NetworkEventType::DATA_RECEIVED)
 				{
-					ProcessLoginPacket(event.data);
+					ProcessLoginPacket(event.data, event.size);
 				}
 				else if (event.type == NetworkEventType::DISCONNECTED)
 				{
@@ -233,18 +232,18 @@ namespace MMO {
 					}
 				}
 			}
+			ReleaseEvents(m_NetEvents);
 		}
 
 		// Poll world server
 		if (m_WorldConnection.IsConnected())
 		{
-			std::vector<NetworkEvent> events;
-			m_WorldConnection.Poll(events, 0);
-			for (const auto& event : events)
+			m_WorldConnection.Poll(m_NetEvents, 0);
+			for (const auto& event : m_NetEvents)
 			{
 				if (event.type == NetworkEventType::DATA_RECEIVED)
 				{
-					ProcessWorldPacket(event.data);
+					ProcessWorldPacket(event.data, event.size);
 				}
 				else if (event.type == NetworkEventType::DISCONNECTED)
 				{
@@ -253,6 +252,7 @@ namespace MMO {
 					m_Entities.clear();
 				}
 			}
+			ReleaseEvents(m_NetEvents);
 		}
 
 		// Update cooldowns
@@ -329,12 +329,12 @@ namespace MMO {
 	// PACKET PROCESSING - LOGIN
 	// ============================================================
 
-	void GameClient::ProcessLoginPacket(const std::vector<uint8_t>& data)
+	void GameClient::ProcessLoginPacket(const uint8_t* data, size_t size)
 	{
-		if (data.empty())
+		if (size == 0)
 			return;
 
-		ReadBuffer buf(data);
+		ReadBuffer buf(data, size);
 		auto packetType = static_cast<LoginPacketType>(buf.ReadU8());
 
 		switch (packetType)
@@ -445,12 +445,17 @@ namespace MMO {
 	// PACKET PROCESSING - WORLD
 	// ============================================================
 
-	void GameClient::ProcessWorldPacket(const std::vector<uint8_t>& data)
+	void GameClient::ProcessWorldPacket(const uint8_t* data, size_t size)
 	{
-		if (data.empty())
+		if (size == 0)
 			return;
 
-		ReadBuffer buf(data);
+		ReadBuffer buf(data, size);
+		ProcessWorldPacket(buf);
+	}
+
+	void GameClient::ProcessWorldPacket(ReadBuffer& buf)
+	{
 		auto packetType = static_cast<WorldPacketType>(buf.ReadU8());
 
 		switch (packetType)
@@ -506,6 +511,9 @@ namespace MMO {
 		case WorldPacketType::S_ENTITY_UPDATE:
 			HandleEntityUpdate(buf);
 			break;
+		case WorldPacketType::S_ENTITY_DELTAS:
+			HandleEntityDeltas(buf);
+			break;
 		case WorldPacketType::S_PLAYER_POSITION:
 			HandlePlayerPosition(buf);
 			break;
@@ -515,11 +523,28 @@ namespace MMO {
 		case WorldPacketType::S_AURA_UPDATE_ALL:
 			HandleAuraUpdateAll(buf);
 			break;
+		case WorldPacketType::S_PACKET_BATCH:
+			HandlePacketBatch(buf);
+			break;
 		default:
 			break;
 		}
 	}
 
+	void GameClient::HandlePacketBatch(ReadBuffer& buf)
+	{
+		// Each entry is a u16 length followed by a complete world packet
+		while (buf.HasData(2))
+		{
+			uint16_t length = buf.ReadU16();
+			ReadBuffer inner = buf.ReadSubBuffer(length);
+			if (inner.HasData(1))
+			{
+				ProcessWorldPacket(inner);
+			}
+		}
+	}
+
 	void GameClient::HandleAuthResult(ReadBuffer& buf)
 	{
 		S_AuthResult result;
@@ -669,7 +694,28 @@ namespace MMO {
 	{
 		S_EntityUpdate update;
 		update.Deserialize(buf);
+		ApplyEntityUpdate(update);
+	}
 
+	void GameClient::HandleEntityDeltas(ReadBuffer& buf)
+	{
+		// Entries run to the end of the packet
+		while (buf.HasData(1))
+		{
+			EntityId id = EntityDelta::ReadId(buf);
+			auto entityIt = m_Entities.find(id);
+			if (entityIt == m_Entities.end())
+			{
+				EntityDelta::Skip(buf);
+				continue;
+			}
+
+			ApplyEntityUpdate(EntityDelta::Decode(buf, id, entityIt->second.deltaBaseline));
+		}
+	}
+
+	void GameClient::ApplyEntityUpdate(const S_EntityUpdate& update)
+	{
 		// Handle local player updates
 		if (update.id == m_LocalPlayer.entityId)
 		{
@@ -744,6 +790,7 @@ namespace MMO {
 		entity.moveState = MoveState::IDLE;
 		entity.interpolationTime = 1.0f;
 		entity.isCasting = false;
+		entity.deltaBaseline = EntityDeltaBaseline::FromSpawn(spawn);
 
 		m_Entities[spawn.id] = entity;
 		std::cout << "Entity spawned: " << spawn.name << " (ID: " << spawn.id << ")" << '\n';
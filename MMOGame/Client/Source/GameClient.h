@@ -80,6 +80,9 @@ namespace MMO {
 
 		// Auras (buffs/debuffs)
 		std::vector<ClientAura> auras;
+
+		// Last wire state received (decodes S_ENTITY_DELTAS)
+		EntityDeltaBaseline deltaBaseline;
 	};
 
 	// ============================================================
@@ -254,8 +257,9 @@ namespace MMO {
 		const std::vector<ClientPortal>& GetPortals() const { return m_Portals; }
 
 	private:
-		void ProcessLoginPacket(const std::vector<uint8_t>& data);
-		void ProcessWorldPacket(const std::vector<uint8_t>& data);
+		void ProcessLoginPacket(const uint8_t* data, size_t size);
+		void ProcessWorldPacket(const uint8_t* data, size_t size);
+		void ProcessWorldPacket(ReadBuffer& buf);
 
 		void HandleLoginResponse(ReadBuffer& buf);
 		void HandleRegisterResponse(ReadBuffer& buf);
@@ -269,6 +273,8 @@ namespace MMO {
 		void HandleWorldState(ReadBuffer& buf);
 		void HandlePlayerPosition(ReadBuffer& buf);
 		void HandleEntityUpdate(ReadBuffer& buf);
+		void HandleEntityDeltas(ReadBuffer& buf);
+		void ApplyEntityUpdate(const S_EntityUpdate& update);
 		void HandleEntitySpawn(ReadBuffer& buf);
 		void HandleEntityDespawn(ReadBuffer& buf);
 		void HandleEvent(ReadBuffer& buf);
@@ -284,12 +290,14 @@ namespace MMO {
 		void HandleCharacterStats(ReadBuffer& buf);
 		void HandleAuraUpdate(ReadBuffer& buf);
 		void HandleAuraUpdateAll(ReadBuffer& buf);
+		void HandlePacketBatch(ReadBuffer& buf);
 
 		void InterpolateEntities(float dt);
 		void UpdateAuras(float dt);
 
 		NetworkClient m_LoginConnection;
 		NetworkClient m_WorldConnection;
+		std::vector<NetworkEvent> m_NetEvents; // Reused across polls
 
 		ClientState m_State;
 		std::string m_SessionToken;
@@ -4,10 +4,13 @@
 #include "Rendering/GameRenderer.h"
 #include "Terrain/ClientTerrainSystem.h"
 #include <Onyx.h>
+#include <Pack/PackFile.h>
 #include <Source/Core/EntryPoint.h>
 #include <chrono>
 #include <cmath>
+#include <filesystem>
 #include <imgui.h>
+#include <iostream>
 #include <thread>
 
 using namespace MMO;
@@ -23,6 +26,7 @@ public:
 		// 3D rendering
 		m_Renderer = std::make_unique<GameRenderer>();
 		m_TerrainSystem = std::make_unique<ClientTerrainSystem>();
+		MountDataPack();
 	}
 
 	void OnUpdate() override
@@ -80,20 +84,29 @@ public:
 				char mapDir[64];
 				snprintf(mapDir, sizeof(mapDir), "Data/maps/%03u", mapId);
 				m_TerrainSystem->LoadZone(mapId, mapDir);
-				m_Renderer->LoadStaticObjects(*m_TerrainSystem, "Data");
 				m_CurrentMapId = mapId;
 			}
 
+			const auto& player = m_Client.GetLocalPlayer();
+
+			// Stream terrain around the player; static objects follow the
+			// chunks that carry them
+			m_TerrainSystem->Update(glm::vec3(player.position.x, 0.0f, player.position.y));
+			m_Renderer->UpdateStaticObjects(*m_TerrainSystem, "Data");
+
 			// Render 3D world directly to the backbuffer
 			auto& window = *Onyx::Application::GetInstance().GetWindow();
 			uint32_t vpW = static_cast<uint32_t>(window.Width());
 			uint32_t vpH = static_cast<uint32_t>(window.Height());
 
-			const auto& player = m_Client.GetLocalPlayer();
 			// Server-authored Z (from PlayerSpawn) takes precedence over terrain snap.
-			float playerHeight = (player.height != 0.0f)
-									 ? player.height
-									 : m_TerrainSystem->GetHeightAt(player.position.x, player.position.y);
+			// Keep the last height while the chunk underfoot is still streaming in.
+			float playerHeight = player.height;
+			if (playerHeight == 0.0f)
+			{
+				m_TerrainSystem->TryGetHeightAt(player.position.x, player.position.y, m_LastTerrainHeight);
+				playerHeight = m_LastTerrainHeight;
+			}
 			glm::vec3 player3D(player.position.x, playerHeight, player.position.y);
 
 			m_Renderer->BeginFrame(player3D, dt, vpW, vpH);
@@ -413,6 +426,34 @@ private:
 		ImGui::End();
 	}
 
+	// The editor's runtime export writes Data/data.opak next to the loose
+	// files. With it mounted, chunks, models and textures come from one mapped
+	// file; without it everything is read from Data/ as before.
+	void MountDataPack()
+	{
+		const char* packPath = "Data/data.opak";
+		if (!std::filesystem::exists(packPath))
+			return;
+
+		std::string error;
+		if (!PackFileSystem::Mount(packPath, "Data", &error))
+		{
+			std::cerr << "[Client] Ignoring data pack: " << error << '\n';
+			return;
+		}
+
+		// Onyx texture loads (stb) go through the same mount
+		Onyx::FileSystem::SetProvider([](const std::string& path, Onyx::FileSystem::FileView& out) {
+			PackView view;
+			if (!PackFileSystem::Read(path, view))
+				return false;
+			out.data = view.data;
+			out.size = view.size;
+			out.owner = std::move(view.owner);
+			return true;
+		});
+		std::cout << "[Client] Mounted " << packPath << '\n';
+	}
 
 private:
 	GameClient m_Client;
@@ -447,6 +488,7 @@ private:
 	// 3D Rendering
 	std::unique_ptr<GameRenderer> m_Renderer;
 	std::unique_ptr<ClientTerrainSystem> m_TerrainSystem;
+	float m_LastTerrainHeight = 0.0f;
 	uint32_t m_CurrentMapId = 0;
 	bool m_RendererInitialized = false;
 };
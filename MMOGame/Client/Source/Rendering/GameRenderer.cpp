@@ -1,14 +1,21 @@
 #include "GameRenderer.h"
 #include <GL/glew.h>
 #include <Model/OmdlReader.h>
+#include <algorithm>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 
 namespace MMO {
 
+	// Largest on-screen deviation a simplified static mesh may show
+	constexpr float LOD_ERROR_PIXELS = 1.0f;
+
 	GameRenderer::GameRenderer() = default;
 
-	GameRenderer::~GameRenderer() = default;
+	GameRenderer::~GameRenderer()
+	{
+		StopLoader();
+	}
 
 	void GameRenderer::Init()
 	{
@@ -31,6 +38,8 @@ namespace MMO {
 		// Init cube mesh for entity rendering
 		InitCubeMesh();
 
+		StartLoader();
+
 		m_Initialized = true;
 		std::cout << "[GameRenderer] Initialized (direct backbuffer)" << '\n';
 	}
@@ -79,7 +88,7 @@ namespace MMO {
 
 	void GameRenderer::RenderStaticObjects()
 	{
-		if (!m_Initialized || m_StaticObjects.empty())
+		if (!m_Initialized || m_ChunkStatics.empty())
 			return;
 
 		m_ModelShader->Bind();
@@ -90,59 +99,81 @@ namespace MMO {
 		m_ModelShader->SetFloat("u_AmbientStrength", m_AmbientStrength);
 		m_ModelShader->SetInt("u_AlbedoMap", 0);
 
-		for (const auto& obj : m_StaticObjects)
-		{
-			if (!obj.model)
-				continue;
-
-			m_ModelShader->SetMat4("u_Model", obj.modelMatrix);
-			obj.model->vao->Bind();
+		// Draw the coarsest LOD whose error stays under LOD_ERROR_PIXELS on screen
+		const glm::vec3 cameraPos = m_Camera.GetPosition();
+		const float lodThreshold = LOD_ERROR_PIXELS * 2.0f / static_cast<float>(std::max(1u, m_ViewportHeight));
 
-			for (size_t i = 0; i < obj.model->meshes.size(); i++)
+		for (const auto& [key, chunkStatics] : m_ChunkStatics)
+		{
+			for (const auto& obj : chunkStatics.objects)
 			{
-				const auto& mesh = obj.model->meshes[i];
+				m_ModelShader->SetMat4("u_Model", obj.modelMatrix);
+				obj.model->vao->Bind();
 
-				// Bind per-mesh albedo texture
-				if (i < obj.model->albedoTextures.size() && obj.model->albedoTextures[i])
-				{
-					obj.model->albedoTextures[i]->Bind(0);
-				}
-				else
+				const float distance = std::max(0.0f, glm::length(obj.boundsCenter - cameraPos) - obj.boundsRadius);
+				const float errorScale = Onyx::GetLodErrorScale(m_ProjMatrix, distance, obj.worldScale);
+
+				for (size_t i = 0; i < obj.model->meshes.size(); i++)
 				{
-					m_WhiteTexture->Bind(0);
+					const auto& mesh = obj.model->meshes[i];
+					const Onyx::MeshLod* lods = &obj.model->meshLods[i * Onyx::MAX_MESH_LODS];
+					const Onyx::MeshLod& lod = lods[Onyx::SelectLod(lods, mesh.lodCount, errorScale, lodThreshold)];
+
+					// Bind per-mesh albedo texture
+					if (i < obj.model->albedoTextures.size() && obj.model->albedoTextures[i])
+					{
+						obj.model->albedoTextures[i]->Bind(0);
+					}
+					else
+					{
+						m_WhiteTexture->Bind(0);
+					}
+
+					glDrawElementsBaseVertex(
+						GL_TRIANGLES,
+						static_cast<GLsizei>(lod.indexCount),
+						obj.model->indexType,
+						reinterpret_cast<void*>(static_cast<uintptr_t>(lod.firstIndex * obj.model->indexByteSize)),
+						mesh.baseVertex);
 				}
 
-				glDrawElementsBaseVertex(
-					GL_TRIANGLES,
-					static_cast<GLsizei>(mesh.indexCount),
-					obj.model->indexType,
-					reinterpret_cast<void*>(static_cast<uintptr_t>(mesh.firstIndex * obj.model->indexByteSize)),
-					mesh.baseVertex);
+				obj.model->vao->UnBind();
 			}
-
-			obj.model->vao->UnBind();
 		}
 
 		m_ModelShader->UnBind();
 	}
 
-	void GameRenderer::LoadStaticObjects(const ClientTerrainSystem& terrain, const std::string& dataDir)
+	// ============================================================
+	// STATIC OBJECTS
+	// ============================================================
+
+	void GameRenderer::UpdateStaticObjects(ClientTerrainSystem& terrain, const std::string& dataDir)
 	{
-		m_StaticObjects.clear();
+		for (const ClientTerrainSystem::ChunkObjectsChange& change : terrain.TakeObjectChanges())
+		{
+			m_ChunkStatics.erase(change.key);
+			if (!change.loaded)
+				continue;
 
-		const auto& objects = terrain.GetAllObjects();
-		std::cout << "[GameRenderer] Loading " << objects.size() << " static objects..." << '\n';
+			// Null if the chunk was evicted again later in the same batch
+			if (const std::vector<ChunkObjectData>* objects = terrain.GetChunkObjects(change.key))
+			{
+				AddChunkStatics(change.key, *objects, dataDir);
+			}
+		}
+
+		ProcessModelUploads();
+	}
 
+	void GameRenderer::AddChunkStatics(int64_t key, const std::vector<ChunkObjectData>& objects, const std::string& dataDir)
+	{
+		ChunkStatics& chunkStatics = m_ChunkStatics[key];
 		for (const auto& obj : objects)
 		{
 			if (obj.modelPath.empty())
 				continue;
 
-			std::string fullPath = dataDir + "/" + obj.modelPath;
-			RuntimeModel* model = LoadRuntimeModel(fullPath);
-			if (!model)
-				continue;
-
 			// Build model matrix from position, rotation (euler radians), scale
 			glm::mat4 mat = glm::mat4(1.0f);
 			mat = glm::translate(mat, glm::vec3(obj.position[0], obj.position[1], obj.position[2]));
@@ -151,35 +182,156 @@ namespace MMO {
 			mat = glm::rotate(mat, obj.rotation[2], glm::vec3(0, 0, 1)); // Z
 			mat = glm::scale(mat, glm::vec3(obj.scale[0], obj.scale[1], obj.scale[2]));
 
-			StaticWorldObject swo;
-			swo.model = model;
-			swo.modelMatrix = mat;
-			m_StaticObjects.push_back(swo);
+			std::string fullPath = dataDir + "/" + obj.modelPath;
+			auto cached = m_ModelCache.find(fullPath);
+			if (cached != m_ModelCache.end())
+			{
+				if (cached->second)
+					AddStaticObject(chunkStatics.objects, cached->second.get(), mat);
+				continue;
+			}
+
+			RequestModelAsync(fullPath);
+			std::vector<int64_t>& waiters = m_ModelWaiters[fullPath];
+			if (waiters.empty() || waiters.back() != key)
+				waiters.push_back(key);
+			chunkStatics.pending.push_back({std::move(fullPath), mat});
 		}
+	}
 
-		std::cout << "[GameRenderer] Loaded " << m_StaticObjects.size() << " static objects, "
-				  << m_ModelCache.size() << " unique models" << '\n';
+	void GameRenderer::AddStaticObject(std::vector<StaticWorldObject>& out, RuntimeModel* model, const glm::mat4& modelMatrix)
+	{
+		StaticWorldObject swo;
+		swo.model = model;
+		swo.modelMatrix = modelMatrix;
+		swo.worldScale = std::max({glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])),
+								   glm::length(glm::vec3(modelMatrix[2]))});
+		swo.boundsCenter = glm::vec3(modelMatrix * glm::vec4((model->boundsMin + model->boundsMax) * 0.5f, 1.0f));
+		swo.boundsRadius = glm::length(model->boundsMax - model->boundsMin) * 0.5f * swo.worldScale;
+		out.push_back(swo);
+	}
+
+	// ============================================================
+	// ASYNC MODEL LOADING
+	// ============================================================
+
+	void GameRenderer::RequestModelAsync(const std::string& path)
+	{
+		if (m_ModelCache.count(path) || !m_RequestedModels.insert(path).second)
+			return;
+
+		auto job = std::make_unique<ModelLoadJob>();
+		job->path = path;
+		{
+			std::lock_guard<std::mutex> lock(m_LoadMutex);
+			m_LoadQueue.push_back(std::move(job));
+		}
+		m_LoadCV.notify_one();
 	}
 
-	RuntimeModel* GameRenderer::LoadRuntimeModel(const std::string& path)
+	void GameRenderer::ProcessModelUploads(int maxPerFrame)
 	{
-		// Check cache
-		auto it = m_ModelCache.find(path);
-		if (it != m_ModelCache.end())
+		for (int uploaded = 0; uploaded < maxPerFrame; uploaded++)
 		{
-			return it->second.get();
+			std::unique_ptr<ModelLoadJob> job;
+			{
+				std::lock_guard<std::mutex> lock(m_LoadMutex);
+				if (m_UploadQueue.empty())
+					break;
+				job = std::move(m_UploadQueue.front());
+				m_UploadQueue.pop_front();
+			}
+
+			m_RequestedModels.erase(job->path);
+			RuntimeModel* model = job->loaded ? UploadModel(*job) : nullptr;
+			if (!model)
+			{
+				std::cerr << "[GameRenderer] Failed to load .omdl: " << job->path << '\n';
+				m_ModelCache[job->path] = nullptr; // Don't request it again
+			}
+
+			// Hand the model to every chunk still waiting on it
+			auto waitersIt = m_ModelWaiters.find(job->path);
+			if (waitersIt == m_ModelWaiters.end())
+				continue;
+			for (int64_t key : waitersIt->second)
+			{
+				auto chunkIt = m_ChunkStatics.find(key);
+				if (chunkIt == m_ChunkStatics.end())
+					continue; // Evicted meanwhile
+
+				ChunkStatics& chunkStatics = chunkIt->second;
+				std::erase_if(chunkStatics.pending, [&](const PendingStatic& pending) {
+					if (pending.modelPath != job->path)
+						return false;
+					if (model)
+						AddStaticObject(chunkStatics.objects, model, pending.modelMatrix);
+					return true;
+				});
+			}
+			m_ModelWaiters.erase(waitersIt);
 		}
+	}
 
+	void GameRenderer::PrepareModel(ModelLoadJob& job)
+	{
 		// Read .omdl file via memory mapping (zero-copy view).
-		OmdlMapped data;
-		if (!ReadOmdl(path, data))
+		if (!ReadOmdl(job.path, job.data))
+			return;
+
+		// Fault the mapped pages in here rather than inside glBufferData
+		auto touchPages = [](const void* data, size_t size) {
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			uint8_t sum = 0;
+			for (size_t offset = 0; offset < size; offset += 4096)
+			{
+				sum += bytes[offset];
+			}
+			volatile uint8_t sink = sum;
+			(void)sink;
+		};
+		touchPages(job.data.vertexData, job.data.vertexBytes);
+		touchPages(job.data.indexData, job.data.indexBytes);
+
+		// Resolve texture paths relative to the Data/ directory:
+		// path is like "Data/models/foo.omdl", we want "Data/"
+		std::string dataDir;
+		auto pos = job.path.find("models/");
+		if (pos != std::string::npos)
 		{
-			std::cerr << "[GameRenderer] Failed to load .omdl: " << path << '\n';
-			return nullptr;
+			dataDir = job.path.substr(0, pos);
+		}
+
+		job.albedoImages.resize(job.data.meshes.size());
+		for (size_t i = 0; i < job.data.meshes.size(); i++)
+		{
+			const auto& meshInfo = job.data.meshes[i];
+			if (!meshInfo.albedoPath.empty())
+			{
+				job.albedoImages[i] = Onyx::Texture::PreloadFromFile((dataDir + meshInfo.albedoPath).c_str());
+			}
 		}
+		job.loaded = true;
+	}
+
+	RuntimeModel* GameRenderer::UploadModel(ModelLoadJob& job)
+	{
+		OmdlMapped& data = job.data;
 
 		auto model = std::make_unique<RuntimeModel>();
 		model->meshes = std::move(data.meshes);
+		model->boundsMin = glm::vec3(data.header.boundsMin[0], data.header.boundsMin[1], data.header.boundsMin[2]);
+		model->boundsMax = glm::vec3(data.header.boundsMax[0], data.header.boundsMax[1], data.header.boundsMax[2]);
+		model->meshLods.resize(model->meshes.size() * Onyx::MAX_MESH_LODS);
+		for (size_t i = 0; i < model->meshes.size(); i++)
+		{
+			const auto& mesh = model->meshes[i];
+			for (uint32_t l = 0; l < mesh.lodCount; l++)
+			{
+				model->meshLods[i * Onyx::MAX_MESH_LODS + l] = {mesh.lods[l].firstIndex, mesh.lods[l].indexCount,
+																mesh.lods[l].error};
+			}
+		}
 		model->totalIndices = data.header.totalIndices;
 		const bool u16 = (data.header.flags & OMDL_FLAG_U16_INDICES) != 0;
 		model->indexType = u16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
@@ -202,43 +354,70 @@ namespace MMO {
 		model->vao->SetIndexBuffer(model->ebo.get());
 		model->vao->UnBind();
 
-		// Load per-mesh albedo textures
-		// Resolve paths relative to the Data/ directory
-		std::string dataDir;
-		{
-			// Extract base dir: path is like "Data/models/foo.omdl", we want "Data/"
-			auto pos = path.find("models/");
-			if (pos != std::string::npos)
-			{
-				dataDir = path.substr(0, pos); // "Data/"
-			}
-		}
-
+		// Per-mesh albedo textures, decoded on the loader thread
 		model->albedoTextures.resize(model->meshes.size());
-		for (size_t i = 0; i < model->meshes.size(); i++)
+		for (size_t i = 0; i < job.albedoImages.size(); i++)
 		{
-			const auto& meshInfo = model->meshes[i];
-			if (!meshInfo.albedoPath.empty())
-			{
-				std::string texPath = dataDir + meshInfo.albedoPath;
-				auto tex = std::make_unique<Onyx::Texture>(texPath.c_str());
-				if (tex->GetTextureID() != 0)
-				{
-					model->albedoTextures[i] = std::move(tex);
-				}
-			}
+			Onyx::PreloadedImage& image = job.albedoImages[i];
+			if (!image.Valid())
+				continue;
+			model->albedoTextures[i] = image.compressed.Valid()
+										   ? Onyx::Texture::CreateCompressed(image.compressed)
+										   : Onyx::Texture::CreateWithMipmaps(image.pixels.data(), image.width,
+																			  image.height, image.channels);
+			image.Free();
 		}
 
 		RuntimeModel* ptr = model.get();
-		m_ModelCache[path] = std::move(model);
+		m_ModelCache[job.path] = std::move(model);
 
-		std::cout << "[GameRenderer] Loaded .omdl: " << path
+		std::cout << "[GameRenderer] Loaded .omdl: " << job.path
 				  << " (" << data.header.meshCount << " meshes, "
 				  << data.header.totalVertices << " verts)" << '\n';
 
 		return ptr;
 	}
 
+	void GameRenderer::StartLoader()
+	{
+		if (m_LoaderThread.joinable())
+			return;
+		m_ShutdownLoader = false;
+		m_LoaderThread = std::thread(&GameRenderer::LoaderThreadFunc, this);
+	}
+
+	void GameRenderer::StopLoader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_LoadMutex);
+			m_ShutdownLoader = true;
+		}
+		m_LoadCV.notify_all();
+		if (m_LoaderThread.joinable())
+			m_LoaderThread.join();
+	}
+
+	void GameRenderer::LoaderThreadFunc()
+	{
+		while (true)
+		{
+			std::unique_ptr<ModelLoadJob> job;
+			{
+				std::unique_lock<std::mutex> lock(m_LoadMutex);
+				m_LoadCV.wait(lock, [this] { return m_ShutdownLoader || !m_LoadQueue.empty(); });
+				if (m_ShutdownLoader)
+					return;
+				job = std::move(m_LoadQueue.front());
+				m_LoadQueue.pop_front();
+			}
+
+			PrepareModel(*job);
+
+			std::lock_guard<std::mutex> lock(m_LoadMutex);
+			m_UploadQueue.push_back(std::move(job));
+		}
+	}
+
 	void GameRenderer::RenderEntities(const LocalPlayer& player,
 									  const std::unordered_map<EntityId, RemoteEntity>& entities,
 									  const std::vector<GameClient::ClientPortal>& portals,
@@ -5,9 +5,14 @@
 #include "IsometricCamera.h"
 #include <Model/OmdlFormat.h>
 #include <Onyx.h>
+#include <condition_variable>
+#include <deque>
 #include <glm/glm.hpp>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace MMO {
 
@@ -17,6 +22,9 @@ namespace MMO {
 		std::unique_ptr<Onyx::VertexBuffer> vbo;
 		std::unique_ptr<Onyx::IndexBuffer> ebo;
 		std::vector<OmdlMeshInfo> meshes;
+		std::vector<Onyx::MeshLod> meshLods; // MAX_MESH_LODS per mesh, from OmdlMeshInfo::lods
+		glm::vec3 boundsMin = glm::vec3(0.0f);
+		glm::vec3 boundsMax = glm::vec3(0.0f);
 		std::vector<std::unique_ptr<Onyx::Texture>> albedoTextures;
 		uint32_t totalIndices = 0;
 		uint32_t indexType = 0;       // GL_UNSIGNED_INT or GL_UNSIGNED_SHORT
@@ -27,6 +35,9 @@ namespace MMO {
 	{
 		RuntimeModel* model = nullptr;
 		glm::mat4 modelMatrix = glm::mat4(1.0f);
+		glm::vec3 boundsCenter = glm::vec3(0.0f); // World-space bounding sphere, for LOD distance
+		float boundsRadius = 0.0f;
+		float worldScale = 1.0f; // Largest axis scale of modelMatrix
 	};
 
 	class GameRenderer
@@ -46,7 +57,14 @@ namespace MMO {
 							const ClientTerrainSystem& terrain);
 		void EndFrame();
 
-		void LoadStaticObjects(const ClientTerrainSystem& terrain, const std::string& dataDir);
+		// Adds and removes the statics of chunks the terrain streamed in or out
+		// and uploads finished model loads. Once per frame, on the GL thread.
+		void UpdateStaticObjects(ClientTerrainSystem& terrain, const std::string& dataDir);
+
+		// Reads a .omdl and its albedo images on the loader thread; the GPU
+		// upload happens in ProcessModelUploads
+		void RequestModelAsync(const std::string& path);
+		void ProcessModelUploads(int maxPerFrame = 2);
 
 		IsometricCamera& GetCamera() { return m_Camera; }
 		const IsometricCamera& GetCamera() const { return m_Camera; }
@@ -56,7 +74,24 @@ namespace MMO {
 	private:
 		void DrawCube(const glm::vec3& position, const glm::vec3& scale, const glm::vec4& color);
 		void InitCubeMesh();
-		RuntimeModel* LoadRuntimeModel(const std::string& path);
+
+		// Parsed on the loader thread, consumed by ProcessModelUploads
+		struct ModelLoadJob
+		{
+			std::string path;
+			bool loaded = false;
+			OmdlMapped data;
+			std::vector<Onyx::PreloadedImage> albedoImages; // Per mesh; invalid where there is none
+		};
+
+		static void PrepareModel(ModelLoadJob& job);
+		RuntimeModel* UploadModel(ModelLoadJob& job);
+		void AddChunkStatics(int64_t key, const std::vector<ChunkObjectData>& objects, const std::string& dataDir);
+		void AddStaticObject(std::vector<StaticWorldObject>& out, RuntimeModel* model, const glm::mat4& modelMatrix);
+
+		void StartLoader();
+		void StopLoader();
+		void LoaderThreadFunc();
 
 		IsometricCamera m_Camera;
 
@@ -73,9 +108,34 @@ namespace MMO {
 		// Default texture for terrain (white 1x1 as fallback)
 		std::unique_ptr<Onyx::Texture> m_WhiteTexture;
 
-		// .omdl model cache and static objects
+		// .omdl model cache (null for a model that failed to load)
 		std::unordered_map<std::string, std::unique_ptr<RuntimeModel>> m_ModelCache;
-		std::vector<StaticWorldObject> m_StaticObjects;
+
+		// Static objects per resident terrain chunk. Objects whose model is
+		// still loading wait in `pending` and move to `objects` on upload.
+		struct PendingStatic
+		{
+			std::string modelPath;
+			glm::mat4 modelMatrix = glm::mat4(1.0f);
+		};
+
+		struct ChunkStatics
+		{
+			std::vector<StaticWorldObject> objects;
+			std::vector<PendingStatic> pending;
+		};
+
+		std::unordered_map<int64_t, ChunkStatics> m_ChunkStatics;
+		std::unordered_map<std::string, std::vector<int64_t>> m_ModelWaiters; // Model path -> chunks waiting on it
+
+		// Background .omdl loading (one thread: the work is file I/O)
+		std::thread m_LoaderThread;
+		std::mutex m_LoadMutex;
+		std::condition_variable m_LoadCV;
+		bool m_ShutdownLoader = false;
+		std::deque<std::unique_ptr<ModelLoadJob>> m_LoadQueue;	// Consumed by the loader
+		std::deque<std::unique_ptr<ModelLoadJob>> m_UploadQueue; // Consumed by the GL thread
+		std::unordered_set<std::string> m_RequestedModels;		 // Queued or loading (GL thread only)
 
 		// Directional light (hardcoded sun)
 		glm::vec3 m_SunDirection = glm::normalize(glm::vec3(-0.5f, -1.0f, -0.3f));
@@ -1,123 +1,488 @@
 #include "ClientTerrainSystem.h"
+#include <Pack/PackFile.h>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 
 namespace MMO {
 
+	ClientTerrainSystem::~ClientTerrainSystem()
+	{
+		StopWorkers();
+	}
+
 	void ClientTerrainSystem::LoadZone(uint32_t mapId, const std::string& basePath)
 	{
 		UnloadZone();
 		m_MapId = mapId;
+		m_Streaming = m_Settings.enabled;
 
 		std::string chunksDir = basePath + "/chunks";
 
-		if (!std::filesystem::exists(chunksDir))
+		// A mounted pack (exported runtime Data/) takes the place of the directory
+		std::vector<std::string> chunkPaths = PackFileSystem::List(chunksDir);
+		if (chunkPaths.empty())
 		{
-			std::cout << "[ClientTerrain] No chunks directory: " << chunksDir << '\n';
-			return;
+			if (!std::filesystem::exists(chunksDir))
+			{
+				std::cout << "[ClientTerrain] No chunks directory: " << chunksDir << '\n';
+				return;
+			}
+			for (const auto& entry : std::filesystem::directory_iterator(chunksDir))
+			{
+				chunkPaths.push_back(entry.path().string());
+			}
 		}
 
 		int loadedCount = 0;
-		for (const auto& entry : std::filesystem::directory_iterator(chunksDir))
+		for (const auto& chunkPath : chunkPaths)
 		{
-			if (entry.path().extension() != ".chunk")
+			const std::filesystem::path path(chunkPath);
+			if (path.extension() != ".chunk")
 				continue;
 
-			ChunkFileData fileData;
-			if (!LoadChunkFile(entry.path().string(), fileData))
+			if (m_Streaming)
 			{
-				std::cout << "[ClientTerrain] Failed to load: " << entry.path() << '\n';
+				// Streaming only needs to know which chunks exist; the exporter
+				// names them chunk_{cx}_{cz}.chunk
+				int32_t cx = 0;
+				int32_t cz = 0;
+				if (std::sscanf(path.stem().string().c_str(), "chunk_%d_%d", &cx, &cz) != 2)
+				{
+					std::cout << "[ClientTerrain] Skipping unrecognized chunk name: " << chunkPath << '\n';
+					continue;
+				}
+				m_ChunkFiles[PackKey(cx, cz)] = chunkPath;
 				continue;
 			}
 
-			auto chunk = std::make_unique<ClientTerrainChunk>();
-			chunk->data = std::move(fileData.terrain);
-			chunk->data.CalculateBounds();
-			chunk->objects = std::move(fileData.objects);
-
-			CreateChunkGPU(*chunk);
+			auto chunk = PrepareChunk(chunkPath);
+			if (!chunk)
+			{
+				std::cout << "[ClientTerrain] Failed to load: " << chunkPath << '\n';
+				continue;
+			}
 
-			int64_t key = PackKey(chunk->data.chunkX, chunk->data.chunkZ);
-			m_Chunks[key] = std::move(chunk);
+			UploadChunk(*chunk);
+			AddChunk(std::move(chunk));
 			loadedCount++;
 		}
 
-		// Build flat object list from all chunks
-		m_AllObjects.clear();
-		for (const auto& [key, chunk] : m_Chunks)
+		if (m_Streaming)
 		{
-			for (const auto& obj : chunk->objects)
-			{
-				m_AllObjects.push_back(obj);
-			}
+			StartWorkers();
+			m_EffectiveLoadDistance = m_Settings.loadDistance;
+			m_Stats.knownChunks = static_cast<int>(m_ChunkFiles.size());
+			std::cout << "[ClientTerrain] Streaming " << m_ChunkFiles.size() << " chunks for map " << mapId
+					  << " (load " << m_Settings.loadDistance << ", unload " << m_Settings.unloadDistance
+					  << ", budget " << (m_Settings.memoryBudgetBytes >> 20) << " MB)" << '\n';
+			return;
 		}
 
+		m_Stats.knownChunks = m_Stats.residentChunks = m_Stats.uploadedChunks = loadedCount;
+
+		size_t objectCount = 0;
+		for (const auto& [key, chunk] : m_Chunks)
+		{
+			objectCount += chunk->objects.size();
+		}
 		std::cout << "[ClientTerrain] Loaded " << loadedCount << " chunks, "
-				  << m_AllObjects.size() << " objects for map " << mapId << '\n';
+				  << objectCount << " objects for map " << mapId << '\n';
 	}
 
 	void ClientTerrainSystem::UnloadZone()
 	{
+		{
+			std::lock_guard<std::mutex> lock(m_JobMutex);
+			m_JobQueue.clear();
+			m_ReadyQueue.clear();
+		}
+		// Jobs still on a worker come back tagged with the old generation
+		m_ZoneGeneration++;
+		m_InFlight.clear();
+
+		for (const auto& [key, chunk] : m_Chunks)
+		{
+			if (!chunk->objects.empty())
+				m_ObjectChanges.push_back({key, false});
+		}
 		m_Chunks.clear();
-		m_AllObjects.clear();
+		m_ChunkFiles.clear();
+		m_PendingUploads.clear();
+		m_Stats = Stats{};
 		m_MapId = 0;
 	}
 
-	void ClientTerrainSystem::CreateChunkGPU(ClientTerrainChunk& chunk)
+	// ============================================================
+	// CHUNK PREPARATION / UPLOAD
+	// ============================================================
+
+	std::unique_ptr<ClientTerrainChunk> ClientTerrainSystem::PrepareChunk(const std::string& path)
+	{
+		ChunkFileData fileData;
+		if (!LoadChunkFile(path, fileData))
+			return nullptr;
+
+		auto chunk = std::make_unique<ClientTerrainChunk>();
+		chunk->data = std::move(fileData.terrain);
+		chunk->data.CalculateBounds();
+		chunk->objects = std::move(fileData.objects);
+
+		// Use shared generator — defaults: 65 res, sobel normals, no diamond grid.
+		// It also splits the splatmap into the two RGBA textures.
+		auto mesh = std::make_unique<TerrainMeshData>();
+		if (!chunk->data.heightmap.empty())
+		{
+			TerrainMeshOptions opts;
+			GenerateTerrainMesh(chunk->data, opts, *mesh);
+		}
+		else if (!chunk->data.splatmap.empty())
+		{
+			SplitSplatmapToRGBA(chunk->data.splatmap, mesh->splatmapRGBA0, mesh->splatmapRGBA1);
+		}
+
+		// The CPU mesh is freed after upload, but the GPU keeps the same bytes
+		chunk->memoryBytes = sizeof(ClientTerrainChunk) +
+							 chunk->data.heightmap.size() * sizeof(float) + chunk->data.splatmap.size() +
+							 chunk->objects.size() * sizeof(ChunkObjectData) +
+							 mesh->vertices.size() * sizeof(float) + mesh->indices.size() * sizeof(uint32_t) +
+							 mesh->splatmapRGBA0.size() + mesh->splatmapRGBA1.size();
+		chunk->pendingMesh = std::move(mesh);
+		return chunk;
+	}
+
+	void ClientTerrainSystem::UploadChunk(ClientTerrainChunk& chunk)
+	{
+		if (!chunk.pendingMesh)
+			return;
+
+		const TerrainMeshData& meshData = *chunk.pendingMesh;
+		if (!meshData.vertices.empty())
+		{
+			chunk.indexCount = meshData.indexCount;
+
+			Onyx::RenderCommand::ResetState();
+
+			chunk.vao = std::make_unique<Onyx::VertexArray>();
+			chunk.vbo = std::make_unique<Onyx::VertexBuffer>(meshData.vertices.data(), meshData.vertices.size() * sizeof(float));
+			chunk.ebo = std::make_unique<Onyx::IndexBuffer>(meshData.indices.data(), meshData.indices.size() * sizeof(uint32_t));
+
+			Onyx::VertexLayout layout({
+				{Onyx::VertexAttributeType::Float3}, // position
+				{Onyx::VertexAttributeType::Float3}, // normal
+				{Onyx::VertexAttributeType::Float2}	 // texcoord
+			});
+
+			chunk.vao->SetVertexBuffer(chunk.vbo.get());
+			chunk.vao->SetLayout(layout);
+			chunk.vao->SetIndexBuffer(chunk.ebo.get());
+			chunk.vao->UnBind();
+
+			// Model matrix is identity (vertices are already in world space)
+			chunk.modelMatrix = glm::mat4(1.0f);
+		}
+
+		if (!meshData.splatmapRGBA0.empty())
+		{
+			chunk.splatmapTexture0 = Onyx::Texture::CreateFromData(
+				meshData.splatmapRGBA0.data(), TERRAIN_SPLATMAP_RESOLUTION, TERRAIN_SPLATMAP_RESOLUTION, 4);
+			chunk.splatmapTexture1 = Onyx::Texture::CreateFromData(
+				meshData.splatmapRGBA1.data(), TERRAIN_SPLATMAP_RESOLUTION, TERRAIN_SPLATMAP_RESOLUTION, 4);
+		}
+
+		chunk.pendingMesh.reset();
+	}
+
+	void ClientTerrainSystem::AddChunk(std::unique_ptr<ClientTerrainChunk> chunk)
+	{
+		int64_t key = PackKey(chunk->data.chunkX, chunk->data.chunkZ);
+		if (m_Chunks.count(key))
+			EvictChunk(key);
+
+		m_Stats.residentBytes += chunk->memoryBytes;
+		if (chunk->pendingMesh)
+			m_PendingUploads.push_back(key);
+		if (!chunk->objects.empty())
+			m_ObjectChanges.push_back({key, true});
+		m_Chunks[key] = std::move(chunk);
+	}
+
+	void ClientTerrainSystem::EvictChunk(int64_t key)
+	{
+		auto it = m_Chunks.find(key);
+		if (it == m_Chunks.end())
+			return;
+
+		m_Stats.residentBytes -= it->second->memoryBytes;
+		if (!it->second->objects.empty())
+			m_ObjectChanges.push_back({key, false});
+		if (it->second->pendingMesh)
+			std::erase(m_PendingUploads, key);
+		m_Chunks.erase(it);
+		m_Stats.evictedChunks++;
+	}
+
+	const std::vector<ChunkObjectData>* ClientTerrainSystem::GetChunkObjects(int64_t key) const
+	{
+		auto it = m_Chunks.find(key);
+		return it != m_Chunks.end() ? &it->second->objects : nullptr;
+	}
+
+	// ============================================================
+	// STREAMING
+	// ============================================================
+
+	void ClientTerrainSystem::Update(const glm::vec3& focus)
+	{
+		if (!m_Streaming)
+			return;
+
+		m_Focus = glm::vec2(focus.x, focus.z);
+
+		CollectFinishedChunks();
+
+		// Never leave the ground under the focus missing (zone-in, teleport):
+		// that one chunk is loaded on this thread
+		int64_t focusKey = PackKey(WorldToChunkCoord(m_Focus.x), WorldToChunkCoord(m_Focus.y));
+		if (!m_Chunks.count(focusKey) && !m_InFlight.count(focusKey))
+		{
+			auto fileIt = m_ChunkFiles.find(focusKey);
+			if (fileIt != m_ChunkFiles.end())
+			{
+				if (auto chunk = PrepareChunk(fileIt->second))
+				{
+					UploadChunk(*chunk);
+					AddChunk(std::move(chunk));
+				}
+				else
+				{
+					std::cout << "[ClientTerrain] Failed to load: " << fileIt->second << '\n';
+					m_ChunkFiles.erase(fileIt);
+				}
+			}
+		}
+
+		EnforceBudget();
+		RequestChunks();
+		UploadPendingChunks();
+
+		m_Stats.knownChunks = static_cast<int>(m_ChunkFiles.size());
+		m_Stats.residentChunks = static_cast<int>(m_Chunks.size());
+		m_Stats.uploadedChunks = m_Stats.residentChunks - static_cast<int>(m_PendingUploads.size());
+		m_Stats.inFlightChunks = static_cast<int>(m_InFlight.size());
+		m_Stats.effectiveLoadDistance = m_EffectiveLoadDistance;
+	}
+
+	float ClientTerrainSystem::ChunkDistance(int64_t key) const
 	{
-		GenerateMesh(chunk);
-		UploadSplatmapTextures(chunk);
+		const float minX = KeyX(key) * TERRAIN_CHUNK_SIZE;
+		const float minZ = KeyZ(key) * TERRAIN_CHUNK_SIZE;
+		const float dx = std::max({0.0f, minX - m_Focus.x, m_Focus.x - (minX + TERRAIN_CHUNK_SIZE)});
+		const float dz = std::max({0.0f, minZ - m_Focus.y, m_Focus.y - (minZ + TERRAIN_CHUNK_SIZE)});
+		return std::sqrt(dx * dx + dz * dz);
 	}
 
-	void ClientTerrainSystem::GenerateMesh(ClientTerrainChunk& chunk)
+	void ClientTerrainSystem::RequestChunks()
 	{
-		if (chunk.data.heightmap.empty())
+		const int focusX = WorldToChunkCoord(m_Focus.x);
+		const int focusZ = WorldToChunkCoord(m_Focus.y);
+		const int range = static_cast<int>(std::ceil(m_EffectiveLoadDistance / TERRAIN_CHUNK_SIZE));
+
+		std::vector<ChunkLoadJob> requests;
+		for (int cz = focusZ - range; cz <= focusZ + range; cz++)
+		{
+			for (int cx = focusX - range; cx <= focusX + range; cx++)
+			{
+				int64_t key = PackKey(cx, cz);
+				if (m_Chunks.count(key) || m_InFlight.count(key))
+					continue;
+				if (ChunkDistance(key) >= m_EffectiveLoadDistance)
+					continue;
+
+				auto fileIt = m_ChunkFiles.find(key);
+				if (fileIt == m_ChunkFiles.end())
+					continue;
+
+				ChunkLoadJob job;
+				job.key = key;
+				job.zoneGeneration = m_ZoneGeneration;
+				job.path = fileIt->second;
+				requests.push_back(std::move(job));
+				m_InFlight.insert(key);
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(m_JobMutex);
+
+		// Drop queued jobs the focus has moved away from; they would be
+		// evicted on arrival
+		for (auto it = m_JobQueue.begin(); it != m_JobQueue.end();)
+		{
+			if (ChunkDistance(it->key) > m_Settings.unloadDistance)
+			{
+				m_InFlight.erase(it->key);
+				it = m_JobQueue.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		if (requests.empty())
 			return;
 
-		// Use shared generator — defaults: 65 res, sobel normals, no diamond grid
-		TerrainMeshOptions opts;
-		TerrainMeshData meshData;
-		GenerateTerrainMesh(chunk.data, opts, meshData);
+		for (auto& job : requests)
+		{
+			m_JobQueue.push_back(std::move(job));
+		}
+		std::sort(m_JobQueue.begin(), m_JobQueue.end(), [this](const ChunkLoadJob& a, const ChunkLoadJob& b) {
+			return ChunkDistance(a.key) < ChunkDistance(b.key);
+		});
+		m_JobCV.notify_all();
+	}
+
+	void ClientTerrainSystem::CollectFinishedChunks()
+	{
+		std::deque<ChunkLoadJob> ready;
+		{
+			std::lock_guard<std::mutex> lock(m_JobMutex);
+			ready.swap(m_ReadyQueue);
+		}
 
-		chunk.indexCount = meshData.indexCount;
+		for (auto& job : ready)
+		{
+			if (job.zoneGeneration != m_ZoneGeneration)
+				continue;
+			m_InFlight.erase(job.key);
 
-		Onyx::RenderCommand::ResetState();
+			if (!job.result)
+			{
+				std::cout << "[ClientTerrain] Failed to load: " << job.path << '\n';
+				m_ChunkFiles.erase(job.key); // Don't retry every frame
+				continue;
+			}
 
-		chunk.vao = std::make_unique<Onyx::VertexArray>();
-		chunk.vbo = std::make_unique<Onyx::VertexBuffer>(meshData.vertices.data(), meshData.vertices.size() * sizeof(float));
-		chunk.ebo = std::make_unique<Onyx::IndexBuffer>(meshData.indices.data(), meshData.indices.size() * sizeof(uint32_t));
+			// Heights are usable right away; the GPU upload is rate-limited
+			if (ChunkDistance(job.key) <= m_Settings.unloadDistance)
+				AddChunk(std::move(job.result));
+		}
+	}
 
-		Onyx::VertexLayout layout({
-			{Onyx::VertexAttributeType::Float3}, // position
-			{Onyx::VertexAttributeType::Float3}, // normal
-			{Onyx::VertexAttributeType::Float2}	 // texcoord
+	void ClientTerrainSystem::UploadPendingChunks()
+	{
+		if (m_PendingUploads.empty())
+			return;
+
+		std::sort(m_PendingUploads.begin(), m_PendingUploads.end(), [this](int64_t a, int64_t b) {
+			return ChunkDistance(a) < ChunkDistance(b);
 		});
 
-		chunk.vao->SetVertexBuffer(chunk.vbo.get());
-		chunk.vao->SetLayout(layout);
-		chunk.vao->SetIndexBuffer(chunk.ebo.get());
-		chunk.vao->UnBind();
+		size_t count = std::min(m_PendingUploads.size(), static_cast<size_t>(std::max(1, m_Settings.maxGPUUploadsPerFrame)));
+		for (size_t i = 0; i < count; i++)
+		{
+			UploadChunk(*m_Chunks[m_PendingUploads[i]]);
+		}
+		m_PendingUploads.erase(m_PendingUploads.begin(), m_PendingUploads.begin() + count);
+	}
+
+	void ClientTerrainSystem::EnforceBudget()
+	{
+		std::vector<std::pair<float, int64_t>> byDistance;
+		byDistance.reserve(m_Chunks.size());
+		for (const auto& [key, chunk] : m_Chunks)
+		{
+			byDistance.emplace_back(ChunkDistance(key), key);
+		}
+		std::sort(byDistance.begin(), byDistance.end(), std::greater<>());
+
+		// Out of range: always evicted
+		size_t next = 0;
+		while (next < byDistance.size() && byDistance[next].first > m_Settings.unloadDistance)
+		{
+			EvictChunk(byDistance[next++].second);
+		}
 
-		// Model matrix is identity (vertices are already in world space)
-		chunk.modelMatrix = glm::mat4(1.0f);
+		if (m_Stats.residentBytes > m_Settings.memoryBudgetBytes)
+		{
+			// Over budget: drop the farthest chunks and stop requesting chunks
+			// that far out, or they would stream straight back in
+			const int64_t focusKey = PackKey(WorldToChunkCoord(m_Focus.x), WorldToChunkCoord(m_Focus.y));
+			while (next < byDistance.size() && m_Stats.residentBytes > m_Settings.memoryBudgetBytes)
+			{
+				const auto [distance, key] = byDistance[next++];
+				if (key == focusKey)
+					continue;
+				EvictChunk(key);
+				m_EffectiveLoadDistance = std::min(m_EffectiveLoadDistance, distance);
+			}
+		}
+		else if (m_Stats.residentBytes < m_Settings.memoryBudgetBytes / 4 * 3)
+		{
+			m_EffectiveLoadDistance = m_Settings.loadDistance;
+		}
 	}
 
-	void ClientTerrainSystem::UploadSplatmapTextures(ClientTerrainChunk& chunk)
+	void ClientTerrainSystem::StartWorkers()
 	{
-		if (chunk.data.splatmap.empty())
+		if (!m_Workers.empty())
 			return;
 
-		std::vector<uint8_t> rgba0, rgba1;
-		SplitSplatmapToRGBA(chunk.data.splatmap, rgba0, rgba1);
+		m_ShutdownWorkers = false;
+		int count = std::max(1, m_Settings.workerThreads);
+		for (int i = 0; i < count; i++)
+		{
+			m_Workers.emplace_back(&ClientTerrainSystem::WorkerThreadFunc, this);
+		}
+	}
+
+	void ClientTerrainSystem::StopWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_JobMutex);
+			m_ShutdownWorkers = true;
+			m_JobQueue.clear();
+		}
+		m_JobCV.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			worker.join();
+		}
+		m_Workers.clear();
+	}
 
-		chunk.splatmapTexture0 = Onyx::Texture::CreateFromData(
-			rgba0.data(), TERRAIN_SPLATMAP_RESOLUTION, TERRAIN_SPLATMAP_RESOLUTION, 4);
-		chunk.splatmapTexture1 = Onyx::Texture::CreateFromData(
-			rgba1.data(), TERRAIN_SPLATMAP_RESOLUTION, TERRAIN_SPLATMAP_RESOLUTION, 4);
+	void ClientTerrainSystem::WorkerThreadFunc()
+	{
+		while (true)
+		{
+			ChunkLoadJob job;
+			{
+				std::unique_lock<std::mutex> lock(m_JobMutex);
+				m_JobCV.wait(lock, [this] { return m_ShutdownWorkers || !m_JobQueue.empty(); });
+				if (m_ShutdownWorkers)
+					return;
+				job = std::move(m_JobQueue.front());
+				m_JobQueue.pop_front();
+			}
+
+			// File read + mesh generation — no GL calls
+			job.result = PrepareChunk(job.path);
+
+			{
+				std::lock_guard<std::mutex> lock(m_JobMutex);
+				m_ReadyQueue.push_back(std::move(job));
+			}
+		}
 	}
 
+	// ============================================================
+	// RENDERING / QUERIES
+	// ============================================================
+
 	void ClientTerrainSystem::Render(Onyx::Shader* shader)
 	{
 		for (auto& [key, chunk] : m_Chunks)
@@ -145,6 +510,13 @@ namespace MMO {
 	}
 
 	float ClientTerrainSystem::GetHeightAt(float worldX, float worldZ) const
+	{
+		float height = 0.0f;
+		TryGetHeightAt(worldX, worldZ, height);
+		return height;
+	}
+
+	bool ClientTerrainSystem::TryGetHeightAt(float worldX, float worldZ, float& outHeight) const
 	{
 		int cx = WorldToChunkCoord(worldX);
 		int cz = WorldToChunkCoord(worldZ);
@@ -152,12 +524,13 @@ namespace MMO {
 		int64_t key = PackKey(cx, cz);
 		auto it = m_Chunks.find(key);
 		if (it == m_Chunks.end())
-			return 0.0f;
+			return false;
 
 		float localX = worldX - cx * TERRAIN_CHUNK_SIZE;
 		float localZ = worldZ - cz * TERRAIN_CHUNK_SIZE;
 
-		return GetTerrainHeight(it->second->data, localX, localZ);
+		outHeight = GetTerrainHeight(it->second->data, localX, localZ);
+		return true;
 	}
 
 } // namespace MMO
@@ -4,10 +4,16 @@
 #include <Terrain/ChunkFileReader.h>
 #include <Terrain/TerrainData.h>
 #include <Terrain/TerrainMeshGenerator.h>
+#include <condition_variable>
+#include <deque>
 #include <glm/glm.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace MMO {
 
@@ -24,38 +30,134 @@ namespace MMO {
 
 		uint32_t indexCount = 0;
 		glm::mat4 modelMatrix = glm::mat4(1.0f);
+
+		// CPU mesh waiting for its GPU upload (streaming); null once uploaded
+		std::unique_ptr<TerrainMeshData> pendingMesh;
+		size_t memoryBytes = 0; // CPU data + GPU buffers, for the streaming budget
 	};
 
 	class ClientTerrainSystem
 	{
 	public:
 		ClientTerrainSystem() = default;
-		~ClientTerrainSystem() = default;
+		~ClientTerrainSystem();
 
+		// Streaming: only the chunk files are indexed here; Update() loads
+		// chunks around the focus. Otherwise every chunk is loaded now.
 		void LoadZone(uint32_t mapId, const std::string& basePath);
 		void UnloadZone();
 
+		// Streaming only: request chunks around `focus` (world XZ), take
+		// finished ones from the workers, upload a few to the GPU and evict
+		// far chunks. Call once per frame on the GL thread.
+		void Update(const glm::vec3& focus);
+
 		void Render(Onyx::Shader* shader);
 
+		// 0 where no chunk is resident; use TryGetHeightAt while streaming
 		float GetHeightAt(float worldX, float worldZ) const;
+		// False if the chunk under (worldX, worldZ) is not loaded (yet)
+		bool TryGetHeightAt(float worldX, float worldZ, float& outHeight) const;
 		bool HasChunks() const { return !m_Chunks.empty(); }
 
-		const std::vector<ChunkObjectData>& GetAllObjects() const { return m_AllObjects; }
+		// A chunk carrying objects was added (loaded) or evicted
+		struct ChunkObjectsChange
+		{
+			int64_t key = 0;
+			bool loaded = false;
+		};
+
+		// Changes since the last call, in order. A chunk replaced in place
+		// reports its eviction before the new load.
+		std::vector<ChunkObjectsChange> TakeObjectChanges() { return std::exchange(m_ObjectChanges, {}); }
+		// Objects of a resident chunk; null once it has been evicted
+		const std::vector<ChunkObjectData>* GetChunkObjects(int64_t key) const;
 
-	private:
-		void CreateChunkGPU(ClientTerrainChunk& chunk);
-		void GenerateMesh(ClientTerrainChunk& chunk);
-		void UploadSplatmapTextures(ClientTerrainChunk& chunk);
+		struct StreamingSettings
+		{
+			bool enabled = true;
+			float loadDistance = 192.0f;   // Chunks closer than this (XZ, to the chunk's edge) are requested
+			float unloadDistance = 256.0f; // ...and evicted beyond this
+			int maxGPUUploadsPerFrame = 2;
+			size_t memoryBudgetBytes = 256ull * 1024 * 1024;
+			int workerThreads = 2;
+		};
 
+		// Applies from the next LoadZone
+		StreamingSettings& GetSettings() { return m_Settings; }
+
+		struct Stats
+		{
+			int knownChunks = 0;	// Chunk files in the zone
+			int residentChunks = 0; // Parsed; heights available
+			int uploadedChunks = 0; // ...and on the GPU
+			int inFlightChunks = 0; // Queued or on a worker
+			int evictedChunks = 0;	// Since LoadZone
+			size_t residentBytes = 0;
+			float effectiveLoadDistance = 0.0f; // Below loadDistance while over budget
+		};
+
+		const Stats& GetStats() const { return m_Stats; }
+
+	private:
 		// Key: packed (chunkX, chunkZ)
 		static int64_t PackKey(int32_t cx, int32_t cz)
 		{
 			return (static_cast<int64_t>(cx) << 32) | (static_cast<uint32_t>(cz));
 		}
+		static int32_t KeyX(int64_t key) { return static_cast<int32_t>(key >> 32); }
+		static int32_t KeyZ(int64_t key) { return static_cast<int32_t>(key & 0xFFFFFFFF); }
+
+		// Pure CPU, safe on a worker: parse the file and build the mesh
+		static std::unique_ptr<ClientTerrainChunk> PrepareChunk(const std::string& path);
+		void UploadChunk(ClientTerrainChunk& chunk);
+		void AddChunk(std::unique_ptr<ClientTerrainChunk> chunk);
+		void EvictChunk(int64_t key);
+
+		// XZ distance from the focus to the chunk's square
+		float ChunkDistance(int64_t key) const;
+
+		void RequestChunks();
+		void CollectFinishedChunks();
+		void UploadPendingChunks();
+		void EnforceBudget();
 
 		std::unordered_map<int64_t, std::unique_ptr<ClientTerrainChunk>> m_Chunks;
-		std::vector<ChunkObjectData> m_AllObjects;
+		std::vector<ChunkObjectsChange> m_ObjectChanges;
 		uint32_t m_MapId = 0;
+
+		StreamingSettings m_Settings;
+		Stats m_Stats;
+		bool m_Streaming = false; // m_Settings.enabled when the zone was loaded
+		glm::vec2 m_Focus{0.0f};
+		float m_EffectiveLoadDistance = 0.0f;
+
+		// Chunk files of the zone (streaming), indexed by key
+		std::unordered_map<int64_t, std::string> m_ChunkFiles;
+		std::vector<int64_t> m_PendingUploads; // Resident chunks with a pendingMesh
+
+		// Background chunk loading (parse + mesh)
+		struct ChunkLoadJob
+		{
+			int64_t key = 0;
+			uint32_t zoneGeneration = 0;
+			std::string path;
+			std::unique_ptr<ClientTerrainChunk> result; // Null if the file failed to load
+		};
+
+		void StartWorkers();
+		void StopWorkers();
+		void WorkerThreadFunc();
+
+		std::vector<std::thread> m_Workers;
+		std::mutex m_JobMutex;
+		std::condition_variable m_JobCV;
+		bool m_ShutdownWorkers = false;
+		uint32_t m_ZoneGeneration = 0; // Results from an older zone are dropped
+
+		std::deque<ChunkLoadJob> m_JobQueue;	// Consumed by workers, nearest first
+		std::deque<ChunkLoadJob> m_ReadyQueue; // Consumed by the main thread
+		std::unordered_set<int64_t> m_InFlight; // Queued or on a worker (main thread only)
 	};
 
 } // namespace MMO
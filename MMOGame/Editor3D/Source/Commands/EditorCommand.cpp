@@ -150,26 +150,45 @@ namespace MMO {
 	void CommandHistory::Execute(std::unique_ptr<EditorCommand> command)
 	{
 		command->Execute();
-		m_UndoStack.push_back(std::move(command));
-		m_RedoStack.clear(); // Clear redo stack on new action
-
-		// Limit history size
-		if (m_UndoStack.size() > MaxHistorySize)
-		{
-			m_UndoStack.erase(m_UndoStack.begin());
-		}
+		Push(std::move(command));
 	}
 
 	void CommandHistory::AddWithoutExecute(std::unique_ptr<EditorCommand> command)
 	{
 		// Add command to history without executing (for already-applied changes like gizmo drags)
+		Push(std::move(command));
+	}
+
+	void CommandHistory::Push(std::unique_ptr<EditorCommand> command)
+	{
+		for (const auto& redo : m_RedoStack)
+		{
+			m_MemoryUsage -= redo->GetMemoryUsage();
+		}
+		m_RedoStack.clear(); // Clear redo stack on new action
+
+		m_MemoryUsage += command->GetMemoryUsage();
 		m_UndoStack.push_back(std::move(command));
-		m_RedoStack.clear();
+		Trim();
+	}
 
-		if (m_UndoStack.size() > MaxHistorySize)
+	void CommandHistory::Trim()
+	{
+		// Limit history size and memory, oldest first
+		size_t drop = 0;
+		while (m_UndoStack.size() - drop > 1 &&
+			   (m_UndoStack.size() - drop > MaxHistorySize || m_MemoryUsage > m_MemoryBudget))
 		{
-			m_UndoStack.erase(m_UndoStack.begin());
+			m_MemoryUsage -= m_UndoStack[drop]->GetMemoryUsage();
+			drop++;
 		}
+		m_UndoStack.erase(m_UndoStack.begin(), m_UndoStack.begin() + drop);
+	}
+
+	void CommandHistory::SetMemoryBudget(size_t bytes)
+	{
+		m_MemoryBudget = bytes;
+		Trim();
 	}
 
 	void CommandHistory::Undo()
@@ -200,6 +219,7 @@ namespace MMO {
 	{
 		m_UndoStack.clear();
 		m_RedoStack.clear();
+		m_MemoryUsage = 0;
 	}
 
 	std::string CommandHistory::GetUndoDescription() const
@@ -20,6 +20,9 @@ namespace MMO {
 		virtual void Execute() = 0;
 		virtual void Undo() = 0;
 		virtual std::string GetDescription() const = 0;
+
+		// Bytes the command keeps alive while it is in the history
+		virtual size_t GetMemoryUsage() const { return sizeof(*this); }
 	};
 
 	// Transform change command (for whole objects)
@@ -123,13 +126,26 @@ namespace MMO {
 		std::string GetUndoDescription() const;
 		std::string GetRedoDescription() const;
 
+		// Total GetMemoryUsage() of the undo and redo stacks. Past the budget
+		// the oldest undo steps are dropped; the newest one is always kept.
+		size_t GetMemoryUsage() const { return m_MemoryUsage; }
+		size_t GetMemoryBudget() const { return m_MemoryBudget; }
+		void SetMemoryBudget(size_t bytes);
+		size_t GetUndoCount() const { return m_UndoStack.size(); }
+
 	private:
 		CommandHistory() = default;
 
+		void Push(std::unique_ptr<EditorCommand> command);
+		void Trim();
+
 		std::vector<std::unique_ptr<EditorCommand>> m_UndoStack;
 		std::vector<std::unique_ptr<EditorCommand>> m_RedoStack;
+		size_t m_MemoryUsage = 0;
+		size_t m_MemoryBudget = DefaultMemoryBudget;
 
 		static constexpr size_t MaxHistorySize = 100;
+		static constexpr size_t DefaultMemoryBudget = 64 * 1024 * 1024;
 	};
 
 } // namespace MMO
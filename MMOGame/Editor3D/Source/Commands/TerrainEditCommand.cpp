@@ -0,0 +1,72 @@
+#include "TerrainEditCommand.h"
+#include "Terrain/TerrainChunk.h"
+
+namespace Editor3D {
+
+	// ─────────────────────────────────────────────────────────────────────────────
+	// TerrainEditCommand
+	// ─────────────────────────────────────────────────────────────────────────────
+
+	TerrainEditCommand::TerrainEditCommand(ChunkResolver resolver, std::vector<TerrainChunkDelta> deltas,
+										   std::string description)
+		: m_Resolver(std::move(resolver)), m_Deltas(std::move(deltas)), m_Description(std::move(description))
+	{
+		m_Deltas.shrink_to_fit();
+		m_MemoryUsage = sizeof(*this) + m_Description.capacity();
+		for (const auto& delta : m_Deltas)
+		{
+			m_MemoryUsage += delta.GetMemoryUsage();
+		}
+	}
+
+	void TerrainEditCommand::Execute()
+	{
+		Apply(false);
+	}
+
+	void TerrainEditCommand::Undo()
+	{
+		Apply(true);
+	}
+
+	std::string TerrainEditCommand::GetDescription() const
+	{
+		return m_Description;
+	}
+
+	size_t TerrainEditCommand::GetMemoryUsage() const
+	{
+		return m_MemoryUsage;
+	}
+
+	void TerrainEditCommand::Apply(bool undo)
+	{
+		static const int neighbors[][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+		for (const auto& delta : m_Deltas)
+		{
+			TerrainChunk* chunk = m_Resolver(delta.chunkX, delta.chunkZ);
+			if (!chunk)
+				continue;
+
+			ApplyTerrainDelta(delta, chunk->GetDataMutable(), undo);
+			if (delta.HasSplatmap())
+			{
+				chunk->MarkSplatmapDirty();
+			}
+
+			// Edge heights feed the neighbors' normals
+			if (delta.HasHeights())
+			{
+				for (const auto& offset : neighbors)
+				{
+					if (TerrainChunk* neighbor = m_Resolver(delta.chunkX + offset[0], delta.chunkZ + offset[1]))
+					{
+						neighbor->MarkMeshDirty();
+					}
+				}
+			}
+		}
+	}
+
+} // namespace Editor3D
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "EditorCommand.h"
+#include "Terrain/TerrainEditDelta.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Editor3D {
+
+	class TerrainChunk;
+
+	// A finished terrain edit (see TerrainEditRecorder), already applied when
+	// it enters the history. Chunks are looked up again on every undo/redo
+	// since streaming may have reloaded them; a chunk that is not loaded and
+	// active at that point is left as it is.
+	class TerrainEditCommand : public MMO::EditorCommand
+	{
+	public:
+		using ChunkResolver = std::function<TerrainChunk*(int32_t chunkX, int32_t chunkZ)>;
+
+		TerrainEditCommand(ChunkResolver resolver, std::vector<TerrainChunkDelta> deltas,
+						   std::string description = "Terrain Edit");
+
+		void Execute() override;
+		void Undo() override;
+		std::string GetDescription() const override;
+		size_t GetMemoryUsage() const override;
+
+	private:
+		void Apply(bool undo);
+
+		ChunkResolver m_Resolver;
+		std::vector<TerrainChunkDelta> m_Deltas;
+		std::string m_Description;
+		size_t m_MemoryUsage = 0;
+	};
+
+} // namespace Editor3D
@@ -16,6 +16,7 @@
 #include <Core/Platform.h>
 #include <World/PlayerSpawn.h>
 #include <World/SpawnPoint.h>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <glm/gtc/quaternion.hpp>
@@ -598,10 +599,40 @@ namespace MMO {
 
 		auto result = m_ViewportPanel->GetWorldSystem().ExportForRuntime("Data", m_CurrentMapId);
 
-		m_RuntimeExportLog.push_back("Models exported: " + std::to_string(result.modelsExported));
+		auto formatMs = [](double ms) {
+			char text[32];
+			snprintf(text, sizeof(text), "%.1f ms", ms);
+			return std::string(text);
+		};
+
+		m_RuntimeExportLog.push_back("Models exported: " + std::to_string(result.modelsExported) + " (" +
+									 std::to_string(result.meshLodsBaked) + " LODs baked), " +
+									 std::to_string(result.modelsSkipped) + " up to date");
 		m_RuntimeExportLog.push_back("Materials exported: " + std::to_string(result.materialsExported));
-		m_RuntimeExportLog.push_back("Chunks exported: " + std::to_string(result.chunksExported));
-		m_RuntimeExportLog.push_back("Textures copied: " + std::to_string(result.texturesCopied));
+		m_RuntimeExportLog.push_back("Chunks exported: " + std::to_string(result.chunksExported) + ", " +
+									 std::to_string(result.chunksSkipped) + " up to date");
+		m_RuntimeExportLog.push_back("Textures compressed: " + std::to_string(result.texturesCompressed) + " (" +
+									 std::to_string(result.textureRawBytes / 1024) + " KB RGBA8 -> " +
+									 std::to_string(result.textureCompressedBytes / 1024) + " KB BCn with mips)");
+		m_RuntimeExportLog.push_back("Textures copied: " + std::to_string(result.texturesCopied) + ", " +
+									 std::to_string(result.texturesSkipped) + " up to date");
+		m_RuntimeExportLog.push_back("Server terrain: " + std::to_string(result.serverTerrainChunks) + " chunks, " +
+									 std::to_string(result.walkableCells) + " walkable cells, " +
+									 std::to_string(result.blockedCells) + " blocked" +
+									 (result.serverTerrainSkipped ? " (up to date)" : ""));
+		m_RuntimeExportLog.push_back("Files packed: " + std::to_string(result.filesPacked) + " (" +
+									 std::to_string(result.packRawBytes / 1024) + " KB -> " +
+									 std::to_string(result.packBytes / 1024) + " KB data.opak)" +
+									 (result.packSkipped ? " (up to date)" : ""));
+
+		const auto& timings = result.timings;
+		m_RuntimeExportLog.push_back("Time: " + formatMs(timings.totalMs) + " on " +
+									 std::to_string(result.workerThreads) + " threads (prepare " +
+									 formatMs(timings.prepareMs) + ", models " + formatMs(timings.modelsMs) +
+									 ", textures " + formatMs(timings.texturesMs) + ", chunks " +
+									 formatMs(timings.chunksMs) + ", server terrain " +
+									 formatMs(timings.serverTerrainMs) + ", migration " +
+									 formatMs(timings.migrationMs) + ", pack " + formatMs(timings.packMs) + ")");
 
 		for (const auto& err : result.errors)
 		{
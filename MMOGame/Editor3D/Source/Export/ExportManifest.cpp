@@ -0,0 +1,121 @@
+#include "ExportManifest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace MMO {
+
+	namespace {
+
+		bool IsSafeField(const std::string& text)
+		{
+			return text.find_first_of("\t\r\n") == std::string::npos;
+		}
+
+	} // namespace
+
+	// ============================================================
+	// EXPORT MANIFEST
+	// ============================================================
+
+	void ExportManifest::Load(const std::string& path)
+	{
+		m_Entries.clear();
+
+		std::ifstream file(path);
+		if (!file)
+			return;
+
+		std::string line;
+		std::vector<std::string> columns;
+		while (std::getline(file, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			columns.clear();
+			size_t start = 0;
+			while (true)
+			{
+				const size_t tab = line.find('\t', start);
+				columns.push_back(line.substr(start, tab - start));
+				if (tab == std::string::npos)
+					break;
+				start = tab + 1;
+			}
+
+			// key, name, output, fields...
+			if (columns.size() < 3 || columns[0].size() != 16)
+				continue;
+
+			Entry entry;
+			char* end = nullptr;
+			entry.key = std::strtoull(columns[0].c_str(), &end, 16);
+			if (end != columns[0].c_str() + 16)
+				continue;
+			entry.output = std::move(columns[2]);
+			entry.fields.assign(std::make_move_iterator(columns.begin() + 3), std::make_move_iterator(columns.end()));
+			m_Entries[columns[1]] = std::move(entry);
+		}
+	}
+
+	bool ExportManifest::Save(const std::string& path) const
+	{
+		// Written aside and renamed, so an interrupted export leaves the old
+		// manifest rather than half of a new one
+		const std::string tempPath = path + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::trunc);
+			if (!file)
+				return false;
+
+			file << "# Onyx export manifest: key\tname\toutput\tfields...\n";
+			for (const auto& [name, entry] : m_Entries)
+			{
+				bool safe = IsSafeField(name) && IsSafeField(entry.output);
+				for (const std::string& field : entry.fields)
+					safe = safe && IsSafeField(field);
+				if (!safe)
+					continue; // Rebuilt next time instead
+
+				char key[17];
+				snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(entry.key));
+				file << key << '\t' << name << '\t' << entry.output;
+				for (const std::string& field : entry.fields)
+					file << '\t' << field;
+				file << '\n';
+			}
+			if (!file)
+				return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tempPath, path, ec);
+		return !ec;
+	}
+
+	const ExportManifest::Entry* ExportManifest::Find(const std::string& name) const
+	{
+		auto it = m_Entries.find(name);
+		return it != m_Entries.end() ? &it->second : nullptr;
+	}
+
+	void ExportManifest::Set(const std::string& name, Entry entry)
+	{
+		m_Entries[name] = std::move(entry);
+	}
+
+	const ExportManifest::Entry* ExportManifest::FindUpToDate(const std::string& name, uint64_t key,
+															  const std::string& outputDir) const
+	{
+		const Entry* entry = Find(name);
+		if (!entry || entry->key != key)
+			return nullptr;
+		std::error_code ec;
+		return std::filesystem::exists(outputDir + "/" + entry->output, ec) ? entry : nullptr;
+	}
+
+} // namespace MMO
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Core/ContentHasher.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MMO {
+
+	using ContentHasher = Onyx::ContentHasher;
+
+	// ExportManifest — <outputDir>/export.manifest, one line per export item
+	// (a model, a texture, a chunk, ...): the key of the inputs it was built
+	// from, the file it produced relative to the output directory and any
+	// values later exports need without rebuilding it (a model's bounds, the
+	// textures it references). An item whose inputs hash to its recorded key,
+	// and whose file still exists, is up to date.
+	//
+	// Text, tab separated, so a stale or hand-edited manifest only costs
+	// rebuilds: unparsable lines are dropped.
+	class ExportManifest
+	{
+	public:
+		struct Entry
+		{
+			uint64_t key = 0;
+			std::string output; // Relative to the output directory
+			std::vector<std::string> fields;
+		};
+
+		static constexpr const char* FILE_NAME = "export.manifest";
+
+		void Load(const std::string& path);
+		bool Save(const std::string& path) const;
+
+		const Entry* Find(const std::string& name) const;
+		void Set(const std::string& name, Entry entry);
+
+		// The entry's key matches and its output exists under `outputDir`
+		const Entry* FindUpToDate(const std::string& name, uint64_t key, const std::string& outputDir) const;
+
+	private:
+		std::unordered_map<std::string, Entry> m_Entries;
+	};
+
+} // namespace MMO
@@ -1,6 +1,9 @@
 #include "StatisticsPanel.h"
+#include "../Commands/EditorCommand.h"
 #include "../World/EditorWorldSystem.h"
 #include "ViewportPanel.h"
+#include <Core/Application.h>
+#include <Graphics/AssetManager.h>
 #include <imgui.h>
 
 namespace MMO {
@@ -40,12 +43,30 @@ namespace MMO {
 					ImGui::Text("Meshes Submitted: %u", stats.meshesSubmitted);
 					ImGui::Text("Meshes Culled: %u", stats.meshesCulled);
 					ImGui::Text("Meshes Rendered: %u", stats.meshesSubmitted - stats.meshesCulled);
+					ImGui::Text("BVH Nodes Visited: %u", stats.bvhNodesVisited);
+					ImGui::Spacing();
+					ImGui::Text("Level of Detail");
+					ImGui::Separator();
+					ImGui::Text("Triangles Saved: %u", stats.lodTrianglesSaved);
+					ImGui::Text("Shadow Triangles Saved: %u", stats.shadowLodTrianglesSaved);
 				}
 				else
 				{
 					ImGui::TextDisabled("No viewport available");
 				}
 
+				ImGui::Spacing();
+				ImGui::Text("Model Cache");
+				ImGui::Separator();
+				{
+					const Onyx::ModelCacheStats cache = Onyx::Application::GetInstance().GetAssetManager().GetModelCacheStats();
+					ImGui::Text("Hits: %u  Misses: %u (%u rejected)", cache.hits, cache.misses, cache.rejected);
+					ImGui::Text("Imports: %u (%.1f ms)", cache.imports, cache.importMs);
+					ImGui::Text("Read: %.2f MB (%.1f ms)  Written: %.2f MB", cache.bytesRead / (1024.0 * 1024.0), cache.loadMs,
+								cache.bytesWritten / (1024.0 * 1024.0));
+					ImGui::Text("Hashing: %.1f ms", cache.hashMs);
+				}
+
 				ImGui::EndTabItem();
 			}
 
@@ -103,6 +124,18 @@ namespace MMO {
 					}
 					ImGui::SliderInt("Chunks/Frame", &settings.maxChunksPerFrame, 1, 16);
 					ImGui::Checkbox("Frustum Culling", &settings.enableFrustumCulling);
+
+					auto& history = CommandHistory::Get();
+					ImGui::Spacing();
+					ImGui::Text("Undo History");
+					ImGui::Separator();
+					ImGui::Text("Steps:  %zu", history.GetUndoCount());
+					ImGui::Text("Memory: %.2f MB", history.GetMemoryUsage() / (1024.0 * 1024.0));
+					int budgetMB = static_cast<int>(history.GetMemoryBudget() / (1024 * 1024));
+					if (ImGui::SliderInt("Budget (MB)", &budgetMB, 8, 1024))
+					{
+						history.SetMemoryBudget(static_cast<size_t>(budgetMB) * 1024 * 1024);
+					}
 				}
 				else
 				{
@@ -12,6 +12,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <imgui.h>
+#include <thread>
 
 namespace MMO {
 
@@ -54,6 +55,10 @@ namespace MMO {
 			"MMOGame/Editor3D/assets/shaders/skinned.vert",
 			"MMOGame/Editor3D/assets/shaders/model.frag");
 
+		// Leave the main thread its own core: it evaluates alongside the workers
+		unsigned int cores = std::thread::hardware_concurrency();
+		m_AnimationBatch.Activate(cores > 1 ? cores - 1 : 0);
+
 		float cubeVertices[] = {
 			-0.5f,
 			-0.5f,
@@ -514,85 +519,254 @@ namespace MMO {
 		if (dt <= 0.0f)
 			dt = 0.016f;
 
-		for (const auto& obj : m_World->GetStaticObjects())
+		SyncRetainedStatics();
+
+		m_FrameAnimators.clear();
+		m_FramePaletteOffsets.clear();
+
+		// Skinned objects are the only per-frame work: their pose changes every frame
+		for (uint64_t guid : m_AnimatedObjects)
 		{
-			if (!obj->IsVisible())
+			StaticObject* obj = m_World->GetObjectAs<StaticObject>(guid);
+			if (!obj)
 				continue;
 
-			const std::string& modelPath = obj->GetModelPath();
-			if (modelPath.empty() || modelPath[0] == '#')
+			auto& entry = ResolveModelCached(obj->GetModelPath(), !obj->GetAnimationPaths().empty());
+			if (!entry.isAnimated)
+			{
+				// Reloading; classified again once the model resolves
+				m_RetainedWaiting.insert(guid);
 				continue;
+			}
+			Onyx::AnimatedModel* animModel = entry.animModel;
 
-			auto& entry = ResolveModelCached(modelPath, !obj->GetAnimationPaths().empty());
+			Onyx::Animator* animator = GetAnimator(guid);
+			if (!animator->GetCurrentAnimation() && animModel->GetAnimationCount() > 0)
+			{
+				animator->SetModel(animModel);
+				auto names = animModel->GetAnimationNames();
+				if (!names.empty())
+				{
+					std::string startAnim = obj->GetCurrentAnimation().empty() ? names[0] : obj->GetCurrentAnimation();
+					animator->Play(startAnim, obj->GetAnimationLoop());
+				}
+			}
+			glm::mat4 worldMatrix = m_World->GetWorldMatrix(obj);
 
-			if (!entry.isAnimated)
+			std::string albedo, normal;
+			if (!obj->GetMaterialId().empty())
 			{
-				if (!entry.staticModel)
-					continue;
-				Onyx::Model* model = entry.staticModel;
+				if (auto* mat = assets.GetMaterial(obj->GetMaterialId()))
+				{
+					albedo = mat->albedoPath;
+					normal = mat->normalPath;
+				}
+			}
 
-				glm::mat4 objectMatrix = m_World->GetWorldMatrix(obj.get());
+			// Pose is evaluated below, with every other animator, straight into this range
+			uint32_t paletteOffset = m_SceneRenderer->ReserveSkinned(animModel, worldMatrix,
+																	  animator->GetPaletteSize(), albedo, normal);
+			m_FrameAnimators.push_back(animator);
+			m_FramePaletteOffsets.push_back(paletteOffset);
+		}
 
-				for (size_t meshIdx = 0; meshIdx < model->GetMeshes().size(); meshIdx++)
-				{
-					auto& mesh = model->GetMeshes()[meshIdx];
-					const std::string& meshName = mesh.m_Name;
-					const MeshMaterial* meshMat = meshName.empty() ? nullptr : obj->GetMeshMaterial(meshName);
+		// Offsets resolve to pointers only now: each reservation may grow the palette
+		m_FramePalettes.clear();
+		for (uint32_t offset : m_FramePaletteOffsets)
+		{
+			m_FramePalettes.push_back(offset != Onyx::SceneRenderer::INVALID_PALETTE_OFFSET
+										  ? m_SceneRenderer->GetSkinnedPalette(offset)
+										  : nullptr);
+		}
+		m_AnimationBatch.Update(m_FrameAnimators, dt, m_FramePalettes);
+	}
 
-					if (meshMat && !meshMat->visible)
-						continue;
+	void ViewportPanel::SyncRetainedStatics()
+	{
+		WorldChangeLog changes = m_World->TakeChanges();
 
-					std::string effectiveAlbedo;
-					std::string effectiveNormal;
+		uint32_t materialsVersion = Onyx::Application::GetInstance().GetAssetManager().GetMaterialsVersion();
+		if (changes.all || materialsVersion != m_RetainedMaterialsVersion)
+		{
+			m_RetainedFullSync = true;
+			m_RetainedMaterialsVersion = materialsVersion;
+		}
 
-					const std::string& meshMatId = meshMat ? meshMat->materialId : obj->GetMaterialId();
-					const std::string& resolveId = !meshMatId.empty() ? meshMatId : obj->GetMaterialId();
-					if (!resolveId.empty())
-					{
-						if (auto* mat = assets.GetMaterial(resolveId))
-						{
-							effectiveAlbedo = mat->albedoPath;
-							effectiveNormal = mat->normalPath;
-						}
-					}
+		if (m_RetainedFullSync)
+		{
+			m_RetainedFullSync = false;
+			m_RetainedWaiting.clear();
+			m_AnimatedObjects.clear();
 
-					glm::mat4 meshModelMatrix = ComputeMeshMatrix(objectMatrix, meshMat, mesh.GetCenter());
-					m_SceneRenderer->SubmitStatic(model, static_cast<uint32_t>(meshIdx),
-												  meshModelMatrix, effectiveAlbedo, effectiveNormal);
-				}
-			}
-			else
+			for (const auto& obj : m_World->GetStaticObjects())
 			{
-				Onyx::AnimatedModel* animModel = entry.animModel;
+				SyncRetainedObject(*obj);
+			}
 
-				Onyx::Animator* animator = GetAnimator(obj->GetGuid());
-				if (!animator->GetCurrentAnimation() && animModel->GetAnimationCount() > 0)
+			// Guids that no longer name a static object (map cleared or reloaded)
+			for (auto it = m_RetainedStatics.begin(); it != m_RetainedStatics.end();)
+			{
+				if (!m_World->GetObjectAs<StaticObject>(it->first))
 				{
-					animator->SetModel(animModel);
-					auto names = animModel->GetAnimationNames();
-					if (!names.empty())
-					{
-						std::string startAnim = obj->GetCurrentAnimation().empty() ? names[0] : obj->GetCurrentAnimation();
-						animator->Play(startAnim, obj->GetAnimationLoop());
-					}
+					UnregisterRetained(it->second);
+					it = m_RetainedStatics.erase(it);
 				}
-				animator->Update(dt);
+				else
+				{
+					++it;
+				}
+			}
+			return;
+		}
+
+		if (!m_RetainedWaiting.empty())
+		{
+			std::vector<uint64_t> waiting(m_RetainedWaiting.begin(), m_RetainedWaiting.end());
+			for (uint64_t guid : waiting)
+			{
+				SyncRetainedGuid(guid);
+			}
+		}
+
+		for (uint64_t guid : changes.changed)
+		{
+			SyncRetainedGuid(guid);
+		}
+	}
+
+	void ViewportPanel::SyncRetainedGuid(uint64_t guid)
+	{
+		WorldObject* object = m_World->GetObject(guid);
+		if (!object)
+		{
+			RemoveRetained(guid);
+			m_RetainedWaiting.erase(guid);
+			m_AnimatedObjects.erase(guid);
+			return;
+		}
+
+		if (object->GetObjectType() == WorldObjectType::STATIC_OBJECT)
+		{
+			SyncRetainedObject(static_cast<const StaticObject&>(*object));
+		}
+		else if (object->GetObjectType() == WorldObjectType::GROUP)
+		{
+			// A moved or re-parented group moves every descendant's world matrix
+			for (uint64_t childGuid : static_cast<const GroupObject*>(object)->GetChildren())
+			{
+				SyncRetainedGuid(childGuid);
+			}
+		}
+	}
 
-				glm::mat4 worldMatrix = m_World->GetWorldMatrix(obj.get());
-				const auto& boneMatrices = animator->GetBoneMatrices();
+	void ViewportPanel::SyncRetainedObject(const StaticObject& obj)
+	{
+		auto& assets = Onyx::Application::GetInstance().GetAssetManager();
+		uint64_t guid = obj.GetGuid();
+		m_RetainedWaiting.erase(guid);
+		m_AnimatedObjects.erase(guid);
+
+		const std::string& modelPath = obj.GetModelPath();
+		if (!obj.IsVisible() || modelPath.empty() || modelPath[0] == '#')
+		{
+			RemoveRetained(guid);
+			return;
+		}
+
+		auto& entry = ResolveModelCached(modelPath, !obj.GetAnimationPaths().empty());
+		if (entry.isAnimated)
+		{
+			RemoveRetained(guid);
+			m_AnimatedObjects.insert(guid);
+			return;
+		}
+		if (!entry.staticModel)
+		{
+			RemoveRetained(guid);
+			if (assets.GetModelStatus(modelPath) != Onyx::ModelLoadStatus::Failed)
+			{
+				m_RetainedWaiting.insert(guid);
+			}
+			return;
+		}
 
-				std::string albedo, normal;
-				if (!obj->GetMaterialId().empty())
+		Onyx::Model* model = entry.staticModel;
+
+		RetainedStatic& retained = m_RetainedStatics[guid];
+		if (retained.model != model)
+		{
+			UnregisterRetained(retained);
+			retained.model = model;
+			retained.meshes.assign(model->GetMeshes().size(), {});
+		}
+
+		glm::mat4 objectMatrix = m_World->GetWorldMatrix(&obj);
+
+		for (size_t meshIdx = 0; meshIdx < model->GetMeshes().size(); meshIdx++)
+		{
+			auto& mesh = model->GetMeshes()[meshIdx];
+			const std::string& meshName = mesh.m_Name;
+			const MeshMaterial* meshMat = meshName.empty() ? nullptr : obj.GetMeshMaterial(meshName);
+
+			RetainedMesh& retainedMesh = retained.meshes[meshIdx];
+			if (meshMat && !meshMat->visible)
+			{
+				m_SceneRenderer->UnregisterStatic(retainedMesh.handle);
+				retainedMesh.handle = {};
+				continue;
+			}
+
+			std::string effectiveAlbedo;
+			std::string effectiveNormal;
+
+			const std::string& meshMatId = meshMat ? meshMat->materialId : obj.GetMaterialId();
+			const std::string& resolveId = !meshMatId.empty() ? meshMatId : obj.GetMaterialId();
+			if (!resolveId.empty())
+			{
+				if (auto* mat = assets.GetMaterial(resolveId))
 				{
-					if (auto* mat = assets.GetMaterial(obj->GetMaterialId()))
-					{
-						albedo = mat->albedoPath;
-						normal = mat->normalPath;
-					}
+					effectiveAlbedo = mat->albedoPath;
+					effectiveNormal = mat->normalPath;
 				}
+			}
+
+			glm::mat4 meshModelMatrix = ComputeMeshMatrix(objectMatrix, meshMat, mesh.GetCenter());
 
-				m_SceneRenderer->SubmitSkinned(animModel, worldMatrix, boneMatrices, albedo, normal);
+			// Materials pick the renderer batch, so a change re-registers;
+			// a move only refits the instance in the renderer's BVH
+			if (!retainedMesh.handle.IsValid() || retainedMesh.albedoPath != effectiveAlbedo ||
+				retainedMesh.normalPath != effectiveNormal)
+			{
+				m_SceneRenderer->UnregisterStatic(retainedMesh.handle);
+				retainedMesh.handle = m_SceneRenderer->RegisterStatic(
+					model, static_cast<uint32_t>(meshIdx), meshModelMatrix, effectiveAlbedo, effectiveNormal);
+				retainedMesh.transform = meshModelMatrix;
+				retainedMesh.albedoPath = std::move(effectiveAlbedo);
+				retainedMesh.normalPath = std::move(effectiveNormal);
 			}
+			else if (retainedMesh.transform != meshModelMatrix)
+			{
+				m_SceneRenderer->UpdateStatic(retainedMesh.handle, meshModelMatrix);
+				retainedMesh.transform = meshModelMatrix;
+			}
+		}
+	}
+
+	void ViewportPanel::RemoveRetained(uint64_t guid)
+	{
+		auto it = m_RetainedStatics.find(guid);
+		if (it == m_RetainedStatics.end())
+			return;
+		UnregisterRetained(it->second);
+		m_RetainedStatics.erase(it);
+	}
+
+	void ViewportPanel::UnregisterRetained(RetainedStatic& retained)
+	{
+		for (RetainedMesh& mesh : retained.meshes)
+		{
+			m_SceneRenderer->UnregisterStatic(mesh.handle);
+			mesh.handle = {};
 		}
 	}
 
@@ -2017,6 +2191,7 @@ namespace MMO {
 			return;
 
 		m_ResolvedModelCache.erase(modelPath);
+		m_RetainedFullSync = true; // Objects sharing the path may change static/animated
 
 		auto& assets = Onyx::Application::GetInstance().GetAssetManager();
 		auto handle = assets.LoadAnimatedModel(modelPath);
@@ -2186,16 +2361,11 @@ namespace MMO {
 					m_TerrainTool.rampPlacing = false;
 					float endHeight = m_TerrainTool.brushPos.y;
 					float rampWidth = m_TerrainTool.brushRadius;
-					m_WorldSystem.BeginEdit(
-						(m_TerrainTool.rampStart.x + m_TerrainTool.brushPos.x) * 0.5f,
-						(m_TerrainTool.rampStart.z + m_TerrainTool.brushPos.z) * 0.5f,
-						glm::length(glm::vec2(m_TerrainTool.brushPos.x - m_TerrainTool.rampStart.x,
-											  m_TerrainTool.brushPos.z - m_TerrainTool.rampStart.z)) +
-							rampWidth);
+					m_WorldSystem.BeginEdit();
 					m_WorldSystem.RampTerrain(
 						m_TerrainTool.rampStart.x, m_TerrainTool.rampStart.z, m_TerrainTool.rampStartHeight,
 						m_TerrainTool.brushPos.x, m_TerrainTool.brushPos.z, endHeight, rampWidth);
-					m_WorldSystem.EndEdit();
+					m_WorldSystem.EndEdit("Terrain Ramp");
 				}
 			}
 			return;
@@ -2208,7 +2378,7 @@ namespace MMO {
 			if (!m_TerrainPainting)
 			{
 				m_TerrainPainting = true;
-				m_WorldSystem.BeginEdit(m_TerrainTool.brushPos.x, m_TerrainTool.brushPos.z, m_TerrainTool.brushRadius);
+				m_WorldSystem.BeginEdit();
 			}
 
 			float dt = io.DeltaTime;
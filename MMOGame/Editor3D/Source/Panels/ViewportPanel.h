@@ -7,6 +7,7 @@
 #include "World/StaticObject.h"
 #include "World/WorldTypes.h"
 #include <Graphics/AnimatedModel.h>
+#include <Graphics/AnimationBatch.h>
 #include <Graphics/Animator.h>
 #include <Graphics/Buffers.h>
 #include <Graphics/Framebuffer.h>
@@ -18,6 +19,7 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace MMO {
@@ -259,6 +261,12 @@ namespace MMO {
 
 		std::unordered_map<uint64_t, std::unique_ptr<Onyx::Animator>> m_AnimatorCache;
 
+		// Animated objects submitted this frame, evaluated together once the scan ends
+		Onyx::AnimationBatch m_AnimationBatch;
+		std::vector<Onyx::Animator*> m_FrameAnimators;
+		std::vector<uint32_t> m_FramePaletteOffsets;
+		std::vector<glm::mat4*> m_FramePalettes;
+
 		// Persistent pointer caches — avoid repeated AssetManager string-hash lookups
 		struct ResolvedModel
 		{
@@ -268,6 +276,35 @@ namespace MMO {
 		};
 		std::unordered_map<std::string, ResolvedModel> m_ResolvedModelCache;
 
+		// Static objects registered with the SceneRenderer's retained scene,
+		// keyed by object guid. Only objects in the world's change log are
+		// re-synced: moved meshes are updated, material changes re-register,
+		// and deleted or hidden objects are unregistered. A cleared world or a
+		// material library change re-syncs everything once.
+		struct RetainedMesh
+		{
+			Onyx::StaticInstanceHandle handle;
+			glm::mat4 transform = glm::mat4(1.0f);
+			std::string albedoPath;
+			std::string normalPath;
+		};
+		struct RetainedStatic
+		{
+			Onyx::Model* model = nullptr;
+			std::vector<RetainedMesh> meshes;
+		};
+		std::unordered_map<uint64_t, RetainedStatic> m_RetainedStatics;
+		std::unordered_set<uint64_t> m_RetainedWaiting; // Model still loading, retried each frame
+		std::unordered_set<uint64_t> m_AnimatedObjects; // Posed every frame instead of retained
+		uint32_t m_RetainedMaterialsVersion = UINT32_MAX;
+		bool m_RetainedFullSync = true;
+
+		void SyncRetainedStatics();
+		void SyncRetainedGuid(uint64_t guid);
+		void SyncRetainedObject(const StaticObject& obj);
+		void RemoveRetained(uint64_t guid);
+		void UnregisterRetained(RetainedStatic& retained);
+
 		Onyx::SceneRenderer* m_SceneRenderer = nullptr;
 
 		Editor3D::EditorWorldSystem m_WorldSystem;
@@ -1,4 +1,5 @@
 #include "EditorTerrainSystem.h"
+#include "Commands/TerrainEditCommand.h"
 #include <Terrain/ChunkIO.h>
 #include <World/WorldObjectData.h>
 #include <algorithm>
@@ -358,6 +359,7 @@ namespace Editor3D {
 		ix = std::clamp(ix, 0, CHUNK_RESOLUTION - 1);
 		iz = std::clamp(iz, 0, CHUNK_RESOLUTION - 1);
 
+		m_EditRecorder.Capture(key, chunk->GetData());
 		auto& data = chunk->GetDataMutable();
 		if (data.heightmap.empty())
 		{
@@ -761,6 +763,7 @@ namespace Editor3D {
 		holeX = std::clamp(holeX, 0, HOLE_GRID_SIZE - 1);
 		holeZ = std::clamp(holeZ, 0, HOLE_GRID_SIZE - 1);
 
+		m_EditRecorder.Capture(key, chunk->GetData());
 		auto& data = chunk->GetDataMutable();
 		uint64_t bit = 1ULL << (holeZ * HOLE_GRID_SIZE + holeX);
 
@@ -825,49 +828,49 @@ namespace Editor3D {
 		}
 	}
 
-	void EditorTerrainSystem::BeginEdit(float worldX, float worldZ, float radius)
+	void EditorTerrainSystem::BeginEdit()
 	{
-		m_CurrentEditSnapshot = std::make_unique<EditSnapshot>();
-
-		int minChunkX = WorldToChunkX(worldX - radius);
-		int maxChunkX = WorldToChunkX(worldX + radius);
-		int minChunkZ = WorldToChunkZ(worldZ - radius);
-		int maxChunkZ = WorldToChunkZ(worldZ + radius);
-
-		for (int cz = minChunkZ; cz <= maxChunkZ; cz++)
-		{
-			for (int cx = minChunkX; cx <= maxChunkX; cx++)
-			{
-				int32_t key = MakeChunkKey(cx, cz);
-				auto it = m_Chunks.find(key);
-				if (it != m_Chunks.end())
-				{
-					m_CurrentEditSnapshot->chunkSnapshots.emplace_back(key, it->second->GetData());
-				}
-			}
-		}
+		m_EditRecorder.Begin();
 	}
 
-	void EditorTerrainSystem::EndEdit()
+	void EditorTerrainSystem::EndEdit(const std::string& description)
 	{
-		m_CurrentEditSnapshot.reset();
+		if (!m_EditRecorder.IsActive())
+			return;
+
+		std::vector<TerrainChunkDelta> deltas = m_EditRecorder.Finish([this](int32_t key) -> const TerrainChunkData* {
+			auto it = m_Chunks.find(key);
+			return it != m_Chunks.end() ? &it->second->GetData() : nullptr;
+		});
+		if (deltas.empty())
+			return;
+
+		auto resolver = [this](int32_t chunkX, int32_t chunkZ) -> TerrainChunk* {
+			auto it = m_Chunks.find(MakeChunkKey(chunkX, chunkZ));
+			if (it == m_Chunks.end() || it->second->GetState() != ChunkState::Active)
+				return nullptr;
+			return it->second.get();
+		};
+		MMO::CommandHistory::Get().AddWithoutExecute(
+			std::make_unique<TerrainEditCommand>(std::move(resolver), std::move(deltas), description));
 	}
 
 	void EditorTerrainSystem::CancelEdit()
 	{
-		if (!m_CurrentEditSnapshot)
+		if (!m_EditRecorder.IsActive())
 			return;
 
-		for (auto& [key, data] : m_CurrentEditSnapshot->chunkSnapshots)
+		for (const auto& [key, data] : m_EditRecorder.GetCaptured())
 		{
 			auto it = m_Chunks.find(key);
 			if (it != m_Chunks.end())
 			{
-				it->second->LoadFromData(data);
+				it->second->GetDataMutable() = data;
+				it->second->MarkSplatmapDirty();
 			}
 		}
 
-		m_CurrentEditSnapshot.reset();
+		m_EditRecorder.Reset();
 	}
 
 	float EditorTerrainSystem::CalculateChunkDistance(int32_t chunkX, int32_t chunkZ) const
@@ -1115,6 +1118,18 @@ namespace Editor3D {
 				}
 			}
 		}
+
+		if (m_EditRecorder.IsActive())
+		{
+			for (int cz = minCZ; cz <= maxCZ; cz++)
+			{
+				for (int cx = minCX; cx <= maxCX; cx++)
+				{
+					m_EditRecorder.Capture(MakeChunkKey(cx, cz), m_Chunks[MakeChunkKey(cx, cz)]->GetData());
+				}
+			}
+		}
+
 		return true;
 	}
 
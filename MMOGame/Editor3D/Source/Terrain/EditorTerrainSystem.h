@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TerrainChunk.h"
+#include "TerrainEditDelta.h"
 #include <Onyx.h>
 #include <deque>
 #include <functional>
@@ -55,8 +56,10 @@ namespace Editor3D {
 		void SaveDirtyChunks();
 		void SaveChunk(int32_t chunkX, int32_t chunkZ);
 
-		void BeginEdit(float worldX, float worldZ, float radius);
-		void EndEdit();
+		// Everything the terrain tools change between BeginEdit and EndEdit
+		// becomes one TerrainEditCommand in the CommandHistory
+		void BeginEdit();
+		void EndEdit(const std::string& description = "Terrain Edit");
 		void CancelEdit();
 
 		void SetDefaultMaterialIds(const std::string ids[MAX_TERRAIN_LAYERS]);
@@ -116,11 +119,7 @@ namespace Editor3D {
 		void ApplyDefaultMaterials(TerrainChunk* chunk);
 		int ResolveGlobalLayer(const std::string& materialId);
 
-		struct EditSnapshot
-		{
-			std::vector<std::pair<int32_t, TerrainChunkData>> chunkSnapshots;
-		};
-		std::unique_ptr<EditSnapshot> m_CurrentEditSnapshot;
+		TerrainEditRecorder m_EditRecorder;
 
 		static int32_t MakeChunkKey(int32_t x, int32_t z)
 		{
@@ -0,0 +1,173 @@
+#include "TerrainBrushKernels.h"
+#include <Maths/SimdMath.h>
+#include <cmath>
+
+namespace Editor3D {
+
+	namespace {
+
+		float Distance(float x, float z, const BrushDab& dab)
+		{
+			float dx = x - dab.centerX;
+			float dz = z - dab.centerZ;
+			return std::sqrt(dx * dx + dz * dz);
+		}
+
+		float Smootherstep(float t)
+		{
+			return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+		}
+
+		float FlattenHeight(float current, float dist, float targetHeight, float innerRadius, float transitionWidth)
+		{
+			if (dist <= innerRadius)
+				return targetHeight;
+
+			float t = Smootherstep((dist - innerRadius) / transitionWidth);
+			float desired = targetHeight * (1.0f - t) + current * t;
+			return std::abs(desired - targetHeight) < std::abs(current - targetHeight) ? desired : current;
+		}
+
+#if ONYX_SIMD_SSE2
+		// Lane i holds the world X of vertex `first + i`; whole numbers, so
+		// stepping by 4 stays exact
+		struct LaneX
+		{
+			__m128 x;
+
+			explicit LaneX(float first)
+				: x(_mm_add_ps(_mm_set1_ps(first), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)))
+			{
+			}
+			void Advance() { x = _mm_add_ps(x, _mm_set1_ps(4.0f)); }
+		};
+
+		__m128 Distance4(__m128 x, float centerX, __m128 dzSquared)
+		{
+			__m128 dx = _mm_sub_ps(x, _mm_set1_ps(centerX));
+			return _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), dzSquared));
+		}
+
+		__m128 Smootherstep4(__m128 t)
+		{
+			__m128 t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+			__m128 poly = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+			poly = _mm_add_ps(_mm_mul_ps(t, poly), _mm_set1_ps(10.0f));
+			return _mm_mul_ps(t3, poly);
+		}
+
+		// Smooth falloff weight, 0 at or beyond the radius
+		__m128 SmoothWeight4(__m128 dist, float radius, float strength)
+		{
+			__m128 radius4 = _mm_set1_ps(radius);
+			__m128 t = Smootherstep4(_mm_div_ps(dist, radius4));
+			__m128 weight = _mm_mul_ps(_mm_set1_ps(strength), _mm_sub_ps(_mm_set1_ps(1.0f), t));
+			return _mm_and_ps(weight, _mm_cmplt_ps(dist, radius4));
+		}
+
+		__m128 Select4(__m128 mask, __m128 a, __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		__m128 Abs4(__m128 v)
+		{
+			return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+		}
+#endif
+
+	} // namespace
+
+	void BrushRaiseRow(const BrushDab& dab, float amount, float firstX, float z, float* heights, int count)
+	{
+		int i = 0;
+#if ONYX_SIMD_SSE2
+		const float dz = z - dab.centerZ;
+		const __m128 dzSquared = _mm_set1_ps(dz * dz);
+		LaneX lanes(firstX);
+		for (; i + 4 <= count; i += 4, lanes.Advance())
+		{
+			__m128 weight = SmoothWeight4(Distance4(lanes.x, dab.centerX, dzSquared), dab.radius, amount);
+			_mm_storeu_ps(heights + i, _mm_add_ps(_mm_loadu_ps(heights + i), weight));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			heights[i] += BrushSmoothWeight(Distance(firstX + i, z, dab), dab.radius, amount);
+		}
+	}
+
+	void BrushFlattenRow(const BrushDab& dab, float targetHeight, float innerRadius,
+						 float firstX, float z, float* heights, int count)
+	{
+		const float transitionWidth = dab.radius - innerRadius;
+
+		int i = 0;
+#if ONYX_SIMD_SSE2
+		const float dz = z - dab.centerZ;
+		const __m128 dzSquared = _mm_set1_ps(dz * dz);
+		const __m128 target = _mm_set1_ps(targetHeight);
+		const __m128 inner = _mm_set1_ps(innerRadius);
+		LaneX lanes(firstX);
+		for (; i + 4 <= count; i += 4, lanes.Advance())
+		{
+			__m128 current = _mm_loadu_ps(heights + i);
+			__m128 dist = Distance4(lanes.x, dab.centerX, dzSquared);
+
+			__m128 t = Smootherstep4(_mm_div_ps(_mm_sub_ps(dist, inner), _mm_set1_ps(transitionWidth)));
+			__m128 desired = _mm_add_ps(_mm_mul_ps(target, _mm_sub_ps(_mm_set1_ps(1.0f), t)), _mm_mul_ps(current, t));
+			__m128 closer = _mm_cmplt_ps(Abs4(_mm_sub_ps(desired, target)), Abs4(_mm_sub_ps(current, target)));
+
+			__m128 blended = Select4(closer, desired, current);
+			__m128 result = Select4(_mm_cmple_ps(dist, inner), target, blended);
+			result = Select4(_mm_cmplt_ps(dist, _mm_set1_ps(dab.radius)), result, current);
+			_mm_storeu_ps(heights + i, result);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			float dist = Distance(firstX + i, z, dab);
+			if (dist < dab.radius)
+				heights[i] = FlattenHeight(heights[i], dist, targetHeight, innerRadius, transitionWidth);
+		}
+	}
+
+	void BrushSmoothRow(const BrushDab& dab, float strength, float firstX, float z,
+						const float* center, const float* below, const float* above, float* out, int count)
+	{
+		int i = 0;
+#if ONYX_SIMD_SSE2
+		const float dz = z - dab.centerZ;
+		const __m128 dzSquared = _mm_set1_ps(dz * dz);
+		LaneX lanes(firstX);
+		for (; i + 4 <= count; i += 4, lanes.Advance())
+		{
+			// Summed left, right, below, above like the scalar path
+			__m128 sum = _mm_add_ps(_mm_loadu_ps(center + i - 1), _mm_loadu_ps(center + i + 1));
+			sum = _mm_add_ps(sum, _mm_loadu_ps(below + i));
+			sum = _mm_add_ps(sum, _mm_loadu_ps(above + i));
+			__m128 average = _mm_mul_ps(sum, _mm_set1_ps(0.25f));
+
+			__m128 dist = Distance4(lanes.x, dab.centerX, dzSquared);
+			__m128 weight = SmoothWeight4(dist, dab.radius, strength);
+			__m128 current = _mm_loadu_ps(center + i);
+			__m128 mixed = _mm_add_ps(_mm_mul_ps(current, _mm_sub_ps(_mm_set1_ps(1.0f), weight)),
+									  _mm_mul_ps(average, weight));
+			_mm_storeu_ps(out + i, Select4(_mm_cmplt_ps(dist, _mm_set1_ps(dab.radius)), mixed, current));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			float dist = Distance(firstX + i, z, dab);
+			if (dist >= dab.radius)
+			{
+				out[i] = center[i];
+				continue;
+			}
+			float average = (center[i - 1] + center[i + 1] + below[i] + above[i]) * 0.25f;
+			float weight = BrushSmoothWeight(dist, dab.radius, strength);
+			out[i] = center[i] * (1.0f - weight) + average * weight;
+		}
+	}
+
+} // namespace Editor3D
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Editor3D {
+
+	// ============================================================
+	// TERRAIN BRUSH KERNELS
+	// ============================================================
+	//
+	// The sculpt tools' per-vertex math, one row of heightmap vertices at a
+	// time. Vertices are 1 m apart, so a row is `count` heights starting at
+	// world X `firstX` (a whole number) on world Z `z`. Rows run four lanes at
+	// a time with SSE2 and finish in scalar code; both paths round like the
+	// scalar reference, so results do not depend on the lane a vertex lands
+	// in. Vertices at or beyond the radius are left alone.
+
+	struct BrushDab
+	{
+		float centerX = 0.0f;
+		float centerZ = 0.0f;
+		float radius = 0.0f;
+	};
+
+	// strength * (1 - smootherstep(dist / radius)): TerrainBrush::GetWeight
+	// with Falloff::Smooth
+	inline float BrushSmoothWeight(float dist, float radius, float strength)
+	{
+		if (dist >= radius)
+			return 0.0f;
+		float t = dist / radius;
+		t = t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+		return strength * (1.0f - t);
+	}
+
+	// heights += smooth falloff weight of `amount` (negative lowers)
+	void BrushRaiseRow(const BrushDab& dab, float amount, float firstX, float z, float* heights, int count);
+
+	// Full `targetHeight` inside `innerRadius`, then a smootherstep blend out
+	// to the radius that only ever moves a height toward the target
+	void BrushFlattenRow(const BrushDab& dab, float targetHeight, float innerRadius,
+						 float firstX, float z, float* heights, int count);
+
+	// out = mix(center, average of the 4 neighbors, smooth falloff weight).
+	// `center` must be readable at [-1, count], `below` (z - 1) and `above`
+	// (z + 1) at [0, count); `out` must not alias any of them.
+	void BrushSmoothRow(const BrushDab& dab, float strength, float firstX, float z,
+						const float* center, const float* below, const float* above, float* out, int count);
+
+} // namespace Editor3D
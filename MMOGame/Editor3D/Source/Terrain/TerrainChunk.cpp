@@ -1,4 +1,5 @@
 #include "TerrainChunk.h"
+#include "TerrainHeightRegion.h"
 #include <Terrain/ChunkIO.h>
 #include <algorithm>
 #include <cstring>
@@ -200,11 +201,20 @@ namespace Editor3D {
 			GenerateMesh();
 			m_Dirty = false;
 			m_SplatmapDirty = false;
+			m_DirtyHeights = {};
 		}
-		else if (m_SplatmapDirty)
+		else
 		{
-			UpdateSplatmapTexture();
-			m_SplatmapDirty = false;
+			// A pending full regeneration covers the dirty heights as well
+			if (!m_Dirty && !m_DirtyHeights.IsEmpty())
+			{
+				UpdateMeshRegion();
+			}
+			if (m_SplatmapDirty)
+			{
+				UpdateSplatmapTexture();
+				m_SplatmapDirty = false;
+			}
 		}
 
 		if (m_HeightmapTexture)
@@ -227,6 +237,19 @@ namespace Editor3D {
 		m_VAO->UnBind();
 	}
 
+	void TerrainChunk::MarkHeightsDirty(const MMO::TerrainVertexRect& rect)
+	{
+		// Smoothed normals read two vertices around; anything farther out
+		// cannot reach this chunk's mesh
+		constexpr int NORMAL_REACH = 2;
+		constexpr int LAST = CHUNK_RESOLUTION - 1;
+		if (rect.IsEmpty() || rect.maxX < -NORMAL_REACH || rect.maxZ < -NORMAL_REACH ||
+			rect.minX > LAST + NORMAL_REACH || rect.minZ > LAST + NORMAL_REACH)
+			return;
+
+		MergeVertexRect(m_DirtyHeights, rect);
+	}
+
 	void TerrainChunk::SetNormalMode(bool sobel, bool smooth)
 	{
 		if (m_SobelNormals != sobel || m_SmoothNormals != smooth)
@@ -283,22 +306,26 @@ namespace Editor3D {
 		}
 	}
 
-	void TerrainChunk::GenerateMesh()
+	MMO::TerrainMeshOptions TerrainChunk::MakeMeshOptions(const HeightSampler& heightSampler) const
 	{
-		if (m_Data.heightmap.empty())
-			return;
-
-		// Use shared generator for CPU work
 		MMO::TerrainMeshOptions opts;
 		opts.meshResolution = m_MeshResolution;
 		opts.sobelNormals = m_SobelNormals;
 		opts.smoothNormals = m_SmoothNormals;
 		opts.diamondGrid = m_DiamondGrid;
 		opts.generatePaddedHeightmap = true;
-		opts.heightSampler = m_HeightSampler;
+		opts.heightSampler = heightSampler;
+		return opts;
+	}
+
+	void TerrainChunk::GenerateMesh()
+	{
+		if (m_Data.heightmap.empty())
+			return;
 
+		// Use shared generator for CPU work
 		PreparedMeshData meshData;
-		MMO::GenerateTerrainMesh(m_Data, opts, meshData);
+		MMO::GenerateTerrainMesh(m_Data, MakeMeshOptions(m_HeightSampler), meshData);
 
 		m_IndexCount = meshData.indexCount;
 
@@ -343,16 +370,51 @@ namespace Editor3D {
 		UpdateSplatmapTexture();
 	}
 
+	void TerrainChunk::UpdateMeshRegion()
+	{
+		MMO::TerrainMeshRegionData region;
+		MMO::GenerateTerrainMeshRegion(m_Data, MakeMeshOptions(m_HeightSampler), m_DirtyHeights, region);
+		m_DirtyHeights = {};
+
+		// Same layout as GenerateMesh: corner grid, then the diamond centers
+		const uint32_t meshRes = static_cast<uint32_t>(m_MeshResolution);
+		const uint32_t meshQuads = meshRes - 1;
+		UploadVertexRows(region.cornerZ * meshRes + region.cornerX, meshRes,
+						 region.cornerWidth, region.cornerHeight, region.cornerVertices.data());
+		UploadVertexRows(meshRes * meshRes + region.centerZ * meshQuads + region.centerX, meshQuads,
+						 region.centerWidth, region.centerHeight, region.centerVertices.data());
+
+		// Its border follows the neighbors, so it changes with them; 67x67
+		// floats is cheap to send whole
+		if (!region.paddedHeightmap.empty() && m_HeightmapTexture)
+		{
+			m_HeightmapTexture->SetFloatData(region.paddedHeightmap.data());
+		}
+	}
+
+	void TerrainChunk::UploadVertexRows(uint32_t firstVertex, uint32_t rowStride, int width, int height, const float* vertices)
+	{
+		constexpr uint32_t FLOATS_PER_VERTEX = 8; // pos(3) + normal(3) + uv(2)
+		constexpr uint32_t VERTEX_BYTES = FLOATS_PER_VERTEX * sizeof(float);
+		if (width <= 0 || height <= 0)
+			return;
+
+		// Full-width rows are one contiguous run of the buffer
+		if (static_cast<uint32_t>(width) == rowStride)
+		{
+			m_VBO->SetSubData(vertices, firstVertex * VERTEX_BYTES, width * height * VERTEX_BYTES);
+			return;
+		}
+		for (int row = 0; row < height; row++)
+		{
+			m_VBO->SetSubData(vertices + row * width * FLOATS_PER_VERTEX, (firstVertex + row * rowStride) * VERTEX_BYTES,
+							  width * VERTEX_BYTES);
+		}
+	}
+
 	void TerrainChunk::PrepareMeshCPU(PreparedMeshData& out, const HeightSampler& heightSampler) const
 	{
-		MMO::TerrainMeshOptions opts;
-		opts.meshResolution = m_MeshResolution;
-		opts.sobelNormals = m_SobelNormals;
-		opts.smoothNormals = m_SmoothNormals;
-		opts.diamondGrid = m_DiamondGrid;
-		opts.generatePaddedHeightmap = true;
-		opts.heightSampler = heightSampler;
-		MMO::GenerateTerrainMesh(m_Data, opts, out);
+		MMO::GenerateTerrainMesh(m_Data, MakeMeshOptions(heightSampler), out);
 	}
 
 	void TerrainChunk::UploadPreparedMesh(PreparedMeshData& data)
@@ -86,6 +86,13 @@ namespace Editor3D {
 			m_Modified = true;
 			return m_Data;
 		}
+		// Height edits that report what they touched through MarkHeightsDirty,
+		// so the mesh is patched instead of regenerated
+		TerrainChunkData& GetHeightsMutable()
+		{
+			m_Modified = true;
+			return m_Data;
+		}
 		TerrainChunkData& GetSplatmapMutable()
 		{
 			m_SplatmapDirty = true;
@@ -107,10 +114,14 @@ namespace Editor3D {
 			m_Modified = true;
 		}
 		void MarkMeshDirty() { m_Dirty = true; }
+		// Heightmap vertices changed in `rect`, chunk-local and possibly past
+		// the chunk for a neighbor's border edits. Accumulated until the next
+		// Draw, which re-uploads only the vertices they reach.
+		void MarkHeightsDirty(const MMO::TerrainVertexRect& rect);
 
 		void Draw(Shader* shader, bool allowRegenerate = true);
 
-		bool IsDirty() const { return m_Dirty; }
+		bool IsDirty() const { return m_Dirty; } // Whole mesh; height regions are not counted
 		void ClearDirty() { m_Dirty = false; }
 
 		bool IsModified() const { return m_Modified; }
@@ -132,6 +143,7 @@ namespace Editor3D {
 		bool m_DiamondGrid = true;
 		int m_MeshResolution = CHUNK_RESOLUTION;
 		HeightSampler m_HeightSampler;
+		MMO::TerrainVertexRect m_DirtyHeights; // Pending MarkHeightsDirty union
 
 		TerrainChunkData m_Data;
 
@@ -144,7 +156,10 @@ namespace Editor3D {
 
 		uint32_t m_IndexCount = 0;
 
+		MMO::TerrainMeshOptions MakeMeshOptions(const HeightSampler& heightSampler) const;
 		void GenerateMesh();
+		void UpdateMeshRegion();
+		void UploadVertexRows(uint32_t firstVertex, uint32_t rowStride, int width, int height, const float* vertices);
 		void UpdateSplatmapTexture();
 	};
 
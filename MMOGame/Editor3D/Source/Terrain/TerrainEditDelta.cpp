@@ -0,0 +1,384 @@
+#include "TerrainEditDelta.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Editor3D {
+
+	namespace {
+
+		constexpr size_t HEIGHT_ELEMENT_SIZE = sizeof(float);
+		constexpr size_t SPLAT_ELEMENT_SIZE = MMO::TERRAIN_MAX_LAYERS;
+		constexpr size_t MAX_ELEMENT_SIZE = 8;
+		static_assert(HEIGHT_ELEMENT_SIZE <= MAX_ELEMENT_SIZE && SPLAT_ELEMENT_SIZE <= MAX_ELEMENT_SIZE);
+
+		// What an edit starts from when a chunk has no heightmap or splatmap
+		// yet; matches what the brushes fill in before writing
+		const std::vector<float>& EmptyHeightmap()
+		{
+			static const std::vector<float> heights(MMO::TERRAIN_CHUNK_HEIGHTMAP_SIZE, 0.0f);
+			return heights;
+		}
+
+		const std::vector<uint8_t>& EmptySplatmap()
+		{
+			static const std::vector<uint8_t> splat = [] {
+				std::vector<uint8_t> s(static_cast<size_t>(MMO::TERRAIN_SPLATMAP_TEXELS) * MMO::TERRAIN_MAX_LAYERS, 0);
+				for (int i = 0; i < MMO::TERRAIN_SPLATMAP_TEXELS; i++)
+				{
+					s[static_cast<size_t>(i) * MMO::TERRAIN_MAX_LAYERS] = 255;
+				}
+				return s;
+			}();
+			return splat;
+		}
+
+		// ============================================================
+		// RUN-LENGTH CODING
+		// ============================================================
+		//
+		// Bytes are split into planes (byte 0 of every element, then byte 1,
+		// ...) so the zero high bytes of small deltas line up, then coded as
+		// (zero run, literal run, literal bytes) with varint lengths.
+
+		void WriteVarint(std::vector<uint8_t>& out, size_t value)
+		{
+			while (value >= 0x80)
+			{
+				out.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(value));
+		}
+
+		bool ReadVarint(const std::vector<uint8_t>& in, size_t& pos, size_t& value)
+		{
+			value = 0;
+			for (int shift = 0; pos < in.size() && shift < 64; shift += 7)
+			{
+				const uint8_t byte = in[pos++];
+				value |= static_cast<size_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		std::vector<uint8_t> EncodeRuns(const std::vector<uint8_t>& raw, size_t elementSize)
+		{
+			const size_t count = raw.size() / elementSize;
+			std::vector<uint8_t> planes(raw.size());
+			for (size_t i = 0; i < count; i++)
+			{
+				for (size_t b = 0; b < elementSize; b++)
+				{
+					planes[b * count + i] = raw[i * elementSize + b];
+				}
+			}
+
+			std::vector<uint8_t> out;
+			const size_t size = planes.size();
+			size_t pos = 0;
+			while (pos < size)
+			{
+				size_t zeros = 0;
+				while (pos + zeros < size && planes[pos + zeros] == 0)
+					zeros++;
+				pos += zeros;
+
+				// A single zero inside a literal run is cheaper than a new token
+				const size_t literalStart = pos;
+				while (pos < size && !(planes[pos] == 0 && (pos + 1 == size || planes[pos + 1] == 0)))
+					pos++;
+
+				WriteVarint(out, zeros);
+				WriteVarint(out, pos - literalStart);
+				out.insert(out.end(), planes.begin() + literalStart, planes.begin() + pos);
+			}
+			out.shrink_to_fit();
+			return out;
+		}
+
+		std::vector<uint8_t> DecodeRuns(const std::vector<uint8_t>& encoded, size_t count, size_t elementSize)
+		{
+			std::vector<uint8_t> planes(count * elementSize, 0);
+			size_t in = 0;
+			size_t pos = 0;
+			size_t zeros = 0;
+			size_t literals = 0;
+			while (in < encoded.size() && ReadVarint(encoded, in, zeros) && ReadVarint(encoded, in, literals))
+			{
+				pos = std::min(pos + zeros, planes.size());
+				literals = std::min({literals, planes.size() - pos, encoded.size() - in});
+				std::memcpy(planes.data() + pos, encoded.data() + in, literals);
+				pos += literals;
+				in += literals;
+			}
+
+			std::vector<uint8_t> raw(planes.size());
+			for (size_t i = 0; i < count; i++)
+			{
+				for (size_t b = 0; b < elementSize; b++)
+				{
+					raw[i * elementSize + b] = planes[b * count + i];
+				}
+			}
+			return raw;
+		}
+
+		// ============================================================
+		// REGIONS
+		// ============================================================
+
+		// Bounding rectangle of the elements that differ bitwise, on a square
+		// grid of `resolution` elements per row
+		TerrainRect DiffRect(const uint8_t* before, const uint8_t* after, int32_t resolution, size_t elementSize)
+		{
+			int32_t minX = resolution, minZ = resolution, maxX = -1, maxZ = -1;
+			for (int32_t z = 0; z < resolution; z++)
+			{
+				const size_t row = static_cast<size_t>(z) * resolution * elementSize;
+				if (std::memcmp(before + row, after + row, resolution * elementSize) == 0)
+					continue;
+				for (int32_t x = 0; x < resolution; x++)
+				{
+					const size_t offset = row + x * elementSize;
+					if (std::memcmp(before + offset, after + offset, elementSize) != 0)
+					{
+						minX = std::min(minX, x);
+						maxX = std::max(maxX, x);
+					}
+				}
+				minZ = std::min(minZ, z);
+				maxZ = z;
+			}
+
+			TerrainRect rect;
+			if (maxX >= 0)
+			{
+				rect.x = minX;
+				rect.z = minZ;
+				rect.width = maxX - minX + 1;
+				rect.height = maxZ - minZ + 1;
+			}
+			return rect;
+		}
+
+		void EncodeRegion(const uint8_t* before, const uint8_t* after, int32_t resolution, size_t elementSize,
+						  const TerrainRect& rect, std::vector<uint8_t>& outBefore, std::vector<uint8_t>& outXor)
+		{
+			const size_t count = static_cast<size_t>(rect.width) * rect.height;
+			std::vector<uint8_t> predicted(count * elementSize);
+			std::vector<uint8_t> xored(count * elementSize);
+			size_t out = 0;
+			for (int32_t z = rect.z; z < rect.z + rect.height; z++)
+			{
+				for (int32_t x = rect.x; x < rect.x + rect.width; x++)
+				{
+					const size_t offset = (static_cast<size_t>(z) * resolution + x) * elementSize;
+					const uint8_t* left = x > rect.x ? before + offset - elementSize : nullptr;
+					for (size_t b = 0; b < elementSize; b++, out++)
+					{
+						predicted[out] = before[offset + b] ^ (left ? left[b] : 0);
+						xored[out] = before[offset + b] ^ after[offset + b];
+					}
+				}
+			}
+			outBefore = EncodeRuns(predicted, elementSize);
+			outXor = EncodeRuns(xored, elementSize);
+		}
+
+		void DecodeRegion(const std::vector<uint8_t>& encodedBefore, const std::vector<uint8_t>& encodedXor,
+						  int32_t resolution, size_t elementSize, const TerrainRect& rect, bool undo, uint8_t* target)
+		{
+			const size_t count = static_cast<size_t>(rect.width) * rect.height;
+			const std::vector<uint8_t> predicted = DecodeRuns(encodedBefore, count, elementSize);
+			const std::vector<uint8_t> xored = DecodeRuns(encodedXor, count, elementSize);
+			size_t in = 0;
+			for (int32_t z = rect.z; z < rect.z + rect.height; z++)
+			{
+				uint8_t left[MAX_ELEMENT_SIZE] = {};
+				for (int32_t x = rect.x; x < rect.x + rect.width; x++)
+				{
+					uint8_t* dst = target + (static_cast<size_t>(z) * resolution + x) * elementSize;
+					for (size_t b = 0; b < elementSize; b++, in++)
+					{
+						left[b] ^= predicted[in];
+						dst[b] = undo ? left[b] : static_cast<uint8_t>(left[b] ^ xored[in]);
+					}
+				}
+			}
+		}
+
+		const uint8_t* Bytes(const std::vector<float>& heights)
+		{
+			return reinterpret_cast<const uint8_t*>(heights.data());
+		}
+
+	} // namespace
+
+	// ============================================================
+	// TERRAIN CHUNK DELTA
+	// ============================================================
+
+	size_t TerrainChunkDelta::GetMemoryUsage() const
+	{
+		size_t bytes = sizeof(*this) + heightBefore.capacity() + heightXor.capacity() + splatBefore.capacity() +
+					   splatXor.capacity();
+		bytes += (materialsBefore.capacity() + materialsAfter.capacity()) * sizeof(std::string);
+		for (const auto& id : materialsBefore)
+			bytes += id.capacity();
+		for (const auto& id : materialsAfter)
+			bytes += id.capacity();
+		return bytes;
+	}
+
+	TerrainChunkDelta ComputeTerrainDelta(const MMO::TerrainChunkData& before, const MMO::TerrainChunkData& after)
+	{
+		TerrainChunkDelta delta;
+		delta.chunkX = after.chunkX;
+		delta.chunkZ = after.chunkZ;
+
+		// Edits only ever create maps, so an empty "after" means untouched
+		if (after.heightmap.size() == static_cast<size_t>(MMO::TERRAIN_CHUNK_HEIGHTMAP_SIZE))
+		{
+			delta.heightmapWasEmpty = before.heightmap.empty();
+			const std::vector<float>& from = delta.heightmapWasEmpty ? EmptyHeightmap() : before.heightmap;
+			if (from.size() == after.heightmap.size())
+			{
+				delta.heightRect = DiffRect(Bytes(from), Bytes(after.heightmap), MMO::TERRAIN_CHUNK_RESOLUTION,
+											HEIGHT_ELEMENT_SIZE);
+				if (!delta.heightRect.IsEmpty())
+				{
+					EncodeRegion(Bytes(from), Bytes(after.heightmap), MMO::TERRAIN_CHUNK_RESOLUTION,
+								 HEIGHT_ELEMENT_SIZE, delta.heightRect, delta.heightBefore, delta.heightXor);
+				}
+			}
+		}
+
+		if (after.splatmap.size() == EmptySplatmap().size())
+		{
+			delta.splatmapWasEmpty = before.splatmap.empty();
+			const std::vector<uint8_t>& from = delta.splatmapWasEmpty ? EmptySplatmap() : before.splatmap;
+			if (from.size() == after.splatmap.size())
+			{
+				delta.splatRect = DiffRect(from.data(), after.splatmap.data(), MMO::TERRAIN_SPLATMAP_RESOLUTION,
+										   SPLAT_ELEMENT_SIZE);
+				if (!delta.splatRect.IsEmpty())
+				{
+					EncodeRegion(from.data(), after.splatmap.data(), MMO::TERRAIN_SPLATMAP_RESOLUTION,
+								 SPLAT_ELEMENT_SIZE, delta.splatRect, delta.splatBefore, delta.splatXor);
+				}
+			}
+		}
+
+		delta.holeMaskBefore = before.holeMask;
+		delta.holeMaskAfter = after.holeMask;
+
+		for (int layer = 0; layer < MMO::TERRAIN_MAX_LAYERS; layer++)
+		{
+			if (before.materialIds[layer] != after.materialIds[layer])
+			{
+				delta.materialMask |= static_cast<uint8_t>(1u << layer);
+				delta.materialsBefore.push_back(before.materialIds[layer]);
+				delta.materialsAfter.push_back(after.materialIds[layer]);
+			}
+		}
+
+		return delta;
+	}
+
+	void ApplyTerrainDelta(const TerrainChunkDelta& delta, MMO::TerrainChunkData& data, bool undo)
+	{
+		if (delta.HasHeights())
+		{
+			if (undo && delta.heightmapWasEmpty)
+			{
+				data.heightmap.clear();
+				data.minHeight = 0.0f;
+				data.maxHeight = 0.0f;
+			}
+			else
+			{
+				if (data.heightmap.size() != EmptyHeightmap().size())
+					data.heightmap = EmptyHeightmap();
+				if (!delta.heightRect.IsEmpty())
+				{
+					DecodeRegion(delta.heightBefore, delta.heightXor, MMO::TERRAIN_CHUNK_RESOLUTION,
+								 HEIGHT_ELEMENT_SIZE, delta.heightRect, undo,
+								 reinterpret_cast<uint8_t*>(data.heightmap.data()));
+				}
+				data.CalculateBounds();
+			}
+		}
+
+		if (delta.HasSplatmap())
+		{
+			if (undo && delta.splatmapWasEmpty)
+			{
+				data.splatmap.clear();
+			}
+			else
+			{
+				if (data.splatmap.size() != EmptySplatmap().size())
+					data.splatmap = EmptySplatmap();
+				if (!delta.splatRect.IsEmpty())
+				{
+					DecodeRegion(delta.splatBefore, delta.splatXor, MMO::TERRAIN_SPLATMAP_RESOLUTION, SPLAT_ELEMENT_SIZE,
+								 delta.splatRect, undo, data.splatmap.data());
+				}
+			}
+		}
+
+		data.holeMask = undo ? delta.holeMaskBefore : delta.holeMaskAfter;
+
+		size_t changed = 0;
+		for (int layer = 0; layer < MMO::TERRAIN_MAX_LAYERS; layer++)
+		{
+			if (delta.materialMask & (1u << layer))
+			{
+				data.materialIds[layer] = undo ? delta.materialsBefore[changed] : delta.materialsAfter[changed];
+				changed++;
+			}
+		}
+	}
+
+	// ============================================================
+	// TERRAIN EDIT RECORDER
+	// ============================================================
+
+	void TerrainEditRecorder::Begin()
+	{
+		m_Captured.clear();
+		m_Active = true;
+	}
+
+	void TerrainEditRecorder::Capture(int32_t key, const MMO::TerrainChunkData& data)
+	{
+		if (!m_Active || m_Captured.count(key))
+			return;
+		m_Captured.emplace(key, data);
+	}
+
+	std::vector<TerrainChunkDelta> TerrainEditRecorder::Finish(const ChunkLookup& lookup)
+	{
+		std::vector<TerrainChunkDelta> deltas;
+		for (const auto& [key, before] : m_Captured)
+		{
+			const MMO::TerrainChunkData* after = lookup(key);
+			if (!after)
+				continue;
+			TerrainChunkDelta delta = ComputeTerrainDelta(before, *after);
+			if (!delta.IsEmpty())
+				deltas.push_back(std::move(delta));
+		}
+		Reset();
+		return deltas;
+	}
+
+	void TerrainEditRecorder::Reset()
+	{
+		m_Captured.clear();
+		m_Active = false;
+	}
+
+} // namespace Editor3D
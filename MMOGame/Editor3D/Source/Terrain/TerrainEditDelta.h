@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Terrain/TerrainData.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Editor3D {
+
+	// ============================================================
+	// TERRAIN EDIT DELTA
+	// ============================================================
+	//
+	// What one edit (a brush stroke, a ramp, a hole) changed in one chunk:
+	// the bounding rectangle of the changed heightmap vertices and of the
+	// changed splatmap texels, each kept as the pre-edit values plus the XOR
+	// of the post-edit values against them, so undo and redo both rebuild
+	// from it. Both are stored compressed: pre-edit samples are XORed with
+	// their left neighbor, bytes are split into planes and zero runs are
+	// run-length coded, so flat ground and untouched texels cost next to
+	// nothing.
+
+	struct TerrainRect
+	{
+		int32_t x = 0;
+		int32_t z = 0;
+		int32_t width = 0;
+		int32_t height = 0;
+
+		bool IsEmpty() const { return width <= 0 || height <= 0; }
+	};
+
+	struct TerrainChunkDelta
+	{
+		int32_t chunkX = 0;
+		int32_t chunkZ = 0;
+
+		TerrainRect heightRect; // Heightmap vertices
+		std::vector<uint8_t> heightBefore;
+		std::vector<uint8_t> heightXor;
+		bool heightmapWasEmpty = false; // Created by the edit; undo clears it again
+
+		TerrainRect splatRect; // Splatmap texels, all layers
+		std::vector<uint8_t> splatBefore;
+		std::vector<uint8_t> splatXor;
+		bool splatmapWasEmpty = false;
+
+		uint64_t holeMaskBefore = 0;
+		uint64_t holeMaskAfter = 0;
+
+		// Layer slots whose material changed, one string per set bit
+		uint8_t materialMask = 0;
+		std::vector<std::string> materialsBefore;
+		std::vector<std::string> materialsAfter;
+
+		bool IsEmpty() const
+		{
+			return heightRect.IsEmpty() && splatRect.IsEmpty() && !heightmapWasEmpty && !splatmapWasEmpty &&
+				   holeMaskBefore == holeMaskAfter && materialMask == 0;
+		}
+		bool HasHeights() const { return !heightRect.IsEmpty() || heightmapWasEmpty; }
+		bool HasSplatmap() const { return !splatRect.IsEmpty() || splatmapWasEmpty; }
+
+		size_t GetMemoryUsage() const;
+	};
+
+	TerrainChunkDelta ComputeTerrainDelta(const MMO::TerrainChunkData& before, const MMO::TerrainChunkData& after);
+
+	// Puts the delta's region of `data` in its pre-edit (undo) or post-edit
+	// state and recalculates the height bounds. Only the caller knows which
+	// GPU resources that dirties: see HasHeights/HasSplatmap.
+	void ApplyTerrainDelta(const TerrainChunkDelta& delta, MMO::TerrainChunkData& data, bool undo);
+
+	// ============================================================
+	// TERRAIN EDIT RECORDER
+	// ============================================================
+	//
+	// Collects one edit between Begin and Finish. The first time the edit
+	// touches a chunk its data is copied; Finish diffs those copies against
+	// the edited chunks and drops them, so full copies only exist for the
+	// chunks of the edit in progress, never in the undo history.
+
+	class TerrainEditRecorder
+	{
+	public:
+		using ChunkLookup = std::function<const MMO::TerrainChunkData*(int32_t key)>;
+
+		void Begin();
+		bool IsActive() const { return m_Active; }
+
+		// No-op outside an edit or when the chunk is already captured
+		void Capture(int32_t key, const MMO::TerrainChunkData& data);
+
+		// Pre-edit copies by chunk key, for cancelling
+		const std::unordered_map<int32_t, MMO::TerrainChunkData>& GetCaptured() const { return m_Captured; }
+
+		// Deltas of the chunks that changed; `lookup` returns the current data
+		// of a captured chunk, or null if it is gone
+		std::vector<TerrainChunkDelta> Finish(const ChunkLookup& lookup);
+		void Reset();
+
+	private:
+		std::unordered_map<int32_t, MMO::TerrainChunkData> m_Captured;
+		bool m_Active = false;
+	};
+
+} // namespace Editor3D
@@ -0,0 +1,101 @@
+#include "TerrainHeightRegion.h"
+#include <algorithm>
+
+namespace Editor3D {
+
+	namespace {
+
+		constexpr int QUADS = MMO::TERRAIN_CHUNK_RESOLUTION - 1;
+		constexpr int NORMAL_REACH = 2; // Smoothed Sobel normals
+
+		int FloorDiv(int value, int divisor)
+		{
+			int quotient = value / divisor;
+			return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+		}
+
+	} // namespace
+
+	void GatherHeightRegion(const MMO::TerrainVertexRect& rect, const ChunkDataLookup& lookup, std::vector<float>& out)
+	{
+		const int width = rect.maxX - rect.minX + 1;
+		out.assign(static_cast<size_t>(width) * (rect.maxZ - rect.minZ + 1), 0.0f);
+
+		// Chunks in increasing order, so a later chunk overwrites the border
+		// vertices it shares with an earlier one only when that one is missing
+		for (int cz = FloorDiv(rect.minZ - 1, QUADS); cz <= FloorDiv(rect.maxZ, QUADS); cz++)
+		{
+			for (int cx = FloorDiv(rect.minX - 1, QUADS); cx <= FloorDiv(rect.maxX, QUADS); cx++)
+			{
+				const MMO::TerrainChunkData* data = lookup(cx, cz);
+				if (!data || data->heightmap.empty())
+					continue;
+
+				const int x0 = std::max(rect.minX, cx * QUADS);
+				const int x1 = std::min(rect.maxX, cx * QUADS + QUADS);
+				const int z0 = std::max(rect.minZ, cz * QUADS);
+				const int z1 = std::min(rect.maxZ, cz * QUADS + QUADS);
+				for (int gz = z0; gz <= z1; gz++)
+				{
+					std::copy_n(&data->heightmap[(gz - cz * QUADS) * MMO::TERRAIN_CHUNK_RESOLUTION + (x0 - cx * QUADS)],
+								x1 - x0 + 1, &out[(gz - rect.minZ) * width + (x0 - rect.minX)]);
+				}
+			}
+		}
+	}
+
+	void ScatterHeightRegion(const MMO::TerrainVertexRect& rect, const std::vector<float>& heights,
+							 const MutableChunkDataLookup& lookup)
+	{
+		const int width = rect.maxX - rect.minX + 1;
+		for (int cz = FloorDiv(rect.minZ - 1, QUADS); cz <= FloorDiv(rect.maxZ, QUADS); cz++)
+		{
+			for (int cx = FloorDiv(rect.minX - 1, QUADS); cx <= FloorDiv(rect.maxX, QUADS); cx++)
+			{
+				MMO::TerrainChunkData* data = lookup(cx, cz);
+				if (!data || data->heightmap.empty())
+					continue;
+
+				const int x0 = std::max(rect.minX, cx * QUADS);
+				const int x1 = std::min(rect.maxX, cx * QUADS + QUADS);
+				const int z0 = std::max(rect.minZ, cz * QUADS);
+				const int z1 = std::min(rect.maxZ, cz * QUADS + QUADS);
+				for (int gz = z0; gz <= z1; gz++)
+				{
+					std::copy_n(&heights[(gz - rect.minZ) * width + (x0 - rect.minX)], x1 - x0 + 1,
+								&data->heightmap[(gz - cz * QUADS) * MMO::TERRAIN_CHUNK_RESOLUTION + (x0 - cx * QUADS)]);
+				}
+				data->CalculateBounds();
+			}
+		}
+	}
+
+	void ForEachChunkReachedByHeights(const MMO::TerrainVertexRect& rect,
+									  const std::function<void(int32_t chunkX, int32_t chunkZ,
+															   const MMO::TerrainVertexRect& local)>& fn)
+	{
+		for (int cz = FloorDiv(rect.minZ - NORMAL_REACH - 1, QUADS); cz <= FloorDiv(rect.maxZ + NORMAL_REACH, QUADS); cz++)
+		{
+			for (int cx = FloorDiv(rect.minX - NORMAL_REACH - 1, QUADS); cx <= FloorDiv(rect.maxX + NORMAL_REACH, QUADS); cx++)
+			{
+				const MMO::TerrainVertexRect local{rect.minX - cx * QUADS, rect.minZ - cz * QUADS,
+												   rect.maxX - cx * QUADS, rect.maxZ - cz * QUADS};
+				fn(cx, cz, local);
+			}
+		}
+	}
+
+	void MergeVertexRect(MMO::TerrainVertexRect& dirty, const MMO::TerrainVertexRect& rect)
+	{
+		if (dirty.IsEmpty())
+		{
+			dirty = rect;
+			return;
+		}
+		dirty.minX = std::min(dirty.minX, rect.minX);
+		dirty.minZ = std::min(dirty.minZ, rect.minZ);
+		dirty.maxX = std::max(dirty.maxX, rect.maxX);
+		dirty.maxZ = std::max(dirty.maxZ, rect.maxZ);
+	}
+
+} // namespace Editor3D
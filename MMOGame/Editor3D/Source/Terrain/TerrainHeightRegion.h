@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Terrain/TerrainMeshGenerator.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Editor3D {
+
+	// ============================================================
+	// TERRAIN HEIGHT REGIONS
+	// ============================================================
+	//
+	// Moves a rectangle of world heightmap vertices between the chunks that
+	// hold it and one row-major buffer, so the brush kernels run over the
+	// whole rectangle at once. Vertex (x, z) of chunk (cx, cz) is world vertex
+	// (cx * 64 + x, cz * 64 + z); a vertex on a border belongs to two chunks.
+	// Chunks are found through a lookup that returns null for a missing one.
+
+	using ChunkDataLookup = std::function<const MMO::TerrainChunkData*(int32_t chunkX, int32_t chunkZ)>;
+	using MutableChunkDataLookup = std::function<MMO::TerrainChunkData*(int32_t chunkX, int32_t chunkZ)>;
+
+	// out = the heights of `rect`, (maxX - minX + 1) per row. Missing chunks
+	// and empty heightmaps read as 0. A border vertex comes from the chunk it
+	// starts and falls back to the one it ends when that is missing.
+	void GatherHeightRegion(const MMO::TerrainVertexRect& rect, const ChunkDataLookup& lookup, std::vector<float>& out);
+
+	// Writes `heights` (laid out as GatherHeightRegion's) back into every
+	// chunk the lookup returns with a heightmap, then recalculates that
+	// chunk's height bounds. The lookup may size an empty heightmap first.
+	void ScatterHeightRegion(const MMO::TerrainVertexRect& rect, const std::vector<float>& heights,
+							 const MutableChunkDataLookup& lookup);
+
+	// Calls `fn` for every chunk whose mesh a height change in `rect` reaches:
+	// normals and the padded heightmap read up to two vertices across
+	// borders. `local` is `rect` in that chunk's vertex grid.
+	void ForEachChunkReachedByHeights(const MMO::TerrainVertexRect& rect,
+									  const std::function<void(int32_t chunkX, int32_t chunkZ,
+															   const MMO::TerrainVertexRect& local)>& fn);
+
+	// dirty = the bounding rectangle of dirty and rect; an empty dirty takes rect
+	void MergeVertexRect(MMO::TerrainVertexRect& dirty, const MMO::TerrainVertexRect& rect);
+
+} // namespace Editor3D
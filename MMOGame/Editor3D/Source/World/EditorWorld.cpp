@@ -1,5 +1,6 @@
 #include "EditorWorld.h"
 #include <algorithm>
+#include <utility>
 
 namespace MMO {
 
@@ -38,6 +39,8 @@ namespace MMO {
 		m_SelectedMeshIndex = -1;
 		m_ObjectsByGuid.clear();
 		m_RootDisplayOrder.clear();
+		m_Changes.changed.clear();
+		m_Changes.all = true;
 
 		m_StaticObjects.clear();
 		m_SpawnPoints.clear();
@@ -52,6 +55,24 @@ namespace MMO {
 		m_Dirty = false;
 	}
 
+	WorldChangeLog EditorWorld::TakeChanges()
+	{
+		for (uint64_t guid : m_Changes.changed)
+		{
+			if (WorldObject* object = GetObject(guid))
+			{
+				object->ClearChangeQueued();
+			}
+		}
+		return std::exchange(m_Changes, {});
+	}
+
+	void EditorWorld::TrackChanges(WorldObject* object)
+	{
+		object->SetChangeLog(&m_Changes);
+		object->MarkChanged();
+	}
+
 	// ─────────────────────────────────────────────────────────────────────────────
 	// OBJECT CREATION
 	// ─────────────────────────────────────────────────────────────────────────────
@@ -64,6 +85,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_StaticObjects.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid); // Add to display order
 
 		m_Dirty = true;
@@ -78,6 +100,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_SpawnPoints.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid);
 
 		m_Dirty = true;
@@ -109,6 +132,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_Lights.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid);
 
 		m_Dirty = true;
@@ -123,6 +147,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_ParticleEmitters.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid);
 
 		m_Dirty = true;
@@ -137,6 +162,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_TriggerVolumes.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid);
 
 		m_Dirty = true;
@@ -151,6 +177,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_InstancePortals.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid);
 
 		m_Dirty = true;
@@ -165,6 +192,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_PlayerSpawns.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid);
 
 		m_Dirty = true;
@@ -179,6 +207,7 @@ namespace MMO {
 
 		m_ObjectsByGuid[guid] = ptr;
 		m_Groups.push_back(std::move(obj));
+		TrackChanges(ptr);
 		m_RootDisplayOrder.push_back(guid);
 
 		m_Dirty = true;
@@ -344,6 +373,7 @@ namespace MMO {
 
 		// Remove from GUID lookup
 		m_ObjectsByGuid.erase(guid);
+		m_Changes.changed.push_back(guid);
 
 		m_Dirty = true;
 
@@ -666,6 +696,7 @@ namespace MMO {
 
 		// Add to GUID lookup
 		m_ObjectsByGuid[guid] = ptr;
+		TrackChanges(ptr);
 
 		// Add to root display order if no parent
 		if (!ptr->HasParent())
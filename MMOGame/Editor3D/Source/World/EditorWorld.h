@@ -183,8 +183,13 @@ namespace MMO {
 		// Callback invoked after an object is deleted (for cache cleanup)
 		void SetOnObjectDeleted(std::function<void(uint64_t)> callback) { m_OnObjectDeleted = std::move(callback); }
 
+		// Guids added, edited or deleted since the last call. A deleted guid no
+		// longer resolves through GetObject. Moving a group only lists the group.
+		WorldChangeLog TakeChanges();
+
 	private:
 		uint64_t GenerateGuid();
+		void TrackChanges(WorldObject* object);
 
 		template <typename T>
 		void RemoveFromVector(std::vector<std::unique_ptr<T>>& vec, uint64_t guid);
@@ -233,6 +238,9 @@ namespace MMO {
 
 		// Deletion callback
 		std::function<void(uint64_t)> m_OnObjectDeleted;
+
+		// Change log for the viewport's retained scene
+		WorldChangeLog m_Changes;
 	};
 
 } // namespace MMO
@@ -1,19 +1,34 @@
 #include "EditorWorldSystem.h"
+#include "../Commands/TerrainEditCommand.h"
+#include "../Export/ExportManifest.h"
 #include "../Export/MigrationSqlWriter.h"
+#include "../Terrain/TerrainBrushKernels.h"
+#include "../Terrain/TerrainHeightRegion.h"
 #include "EditorWorld.h"
 #include <Core/Application.h>
+#include <Core/FileSystem.h>
 #include <Graphics/AssetManager.h>
+#include <Graphics/DdsFile.h>
+#include <Graphics/MeshSimplifier.h>
+#include <Graphics/ModelCache.h>
+#include <Graphics/Texture.h>
 #include <Model/OmdlFormat.h>
 #include <Model/OmdlWriter.h>
+#include <Pack/PackWriter.h>
 #include <Terrain/ChunkFileWriter.h>
+#include <Terrain/ServerTerrain.h>
 #include <World/PlayerSpawn.h>
 #include <World/SpawnPoint.h>
 #include <World/StaticObject.h>
 #include <World/WorldObjectData.h>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <optional>
+#include <tuple>
 
 using Shared::WorldToChunkX;
 using Shared::WorldToChunkZ;
@@ -179,7 +194,9 @@ namespace Editor3D {
 				{
 					perChunkSetup(terrain, terrainShader);
 				}
-				// Throttle dirty mesh regeneration to max 2 per frame
+				// Throttle dirty mesh regeneration to max 2 per frame. Sculpted
+				// height regions are patched in Draw regardless: they re-upload
+				// only the vertices a brush reached.
 				bool allowRegen = true;
 				if (terrain->IsDirty())
 				{
@@ -422,6 +439,7 @@ namespace Editor3D {
 		ix = std::clamp(ix, 0, CHUNK_RESOLUTION - 1);
 		iz = std::clamp(iz, 0, CHUNK_RESOLUTION - 1);
 
+		m_EditRecorder.Capture(key, terrain->GetData());
 		auto& data = terrain->GetDataMutable();
 		if (data.heightmap.empty())
 		{
@@ -433,19 +451,19 @@ namespace Editor3D {
 
 	void EditorWorldSystem::RaiseTerrain(float worldX, float worldZ, float radius, float amount)
 	{
-		TerrainBrush brush;
-		brush.radius = radius;
-		brush.strength = amount;
+		MMO::TerrainVertexRect rect;
+		if (!BeginBrush(worldX, worldZ, radius, rect))
+			return;
 
-		ApplyBrush(worldX, worldZ, radius, [&brush](TerrainChunk* chunk, int localX, int localZ, float weight) {
-			auto& data = chunk->GetDataMutable();
-			if (data.heightmap.empty())
-			{
-				data.heightmap.resize(CHUNK_HEIGHTMAP_SIZE, 0.0f);
-			}
-			int idx = localZ * CHUNK_RESOLUTION + localX;
-			data.heightmap[idx] += brush.GetWeight(weight);
-		});
+		const BrushDab dab{worldX, worldZ, radius};
+		const int width = rect.maxX - rect.minX + 1;
+		GatherHeights(rect, m_BrushHeights);
+		for (int gz = rect.minZ; gz <= rect.maxZ; gz++)
+		{
+			BrushRaiseRow(dab, amount, static_cast<float>(rect.minX), static_cast<float>(gz),
+						  &m_BrushHeights[(gz - rect.minZ) * width], width);
+		}
+		ScatterHeights(rect, m_BrushHeights, true);
 	}
 
 	void EditorWorldSystem::LowerTerrain(float worldX, float worldZ, float radius, float amount)
@@ -489,121 +507,44 @@ namespace Editor3D {
 
 	void EditorWorldSystem::SmoothTerrain(float worldX, float worldZ, float radius, float strength)
 	{
-		TerrainBrush brush;
-		brush.radius = radius;
-		brush.strength = strength;
-		brush.falloff = TerrainBrush::Falloff::Smooth;
-
-		struct SmoothVertex
-		{
-			TerrainChunk* chunk;
-			int lx, lz;
-			float average;
-			float weight;
-		};
-		std::vector<SmoothVertex> vertices;
-
-		int minChunkX = WorldToChunkX(worldX - radius);
-		int maxChunkX = WorldToChunkX(worldX + radius);
-		int minChunkZ = WorldToChunkZ(worldZ - radius);
-		int maxChunkZ = WorldToChunkZ(worldZ + radius);
-
-		if (!EnsureChunksReady(minChunkX, maxChunkX, minChunkZ, maxChunkZ))
+		MMO::TerrainVertexRect rect;
+		if (!BeginBrush(worldX, worldZ, radius, rect))
 			return;
 
-		for (int cz = minChunkZ; cz <= maxChunkZ; cz++)
-		{
-			for (int cx = minChunkX; cx <= maxChunkX; cx++)
-			{
-				TerrainChunk* terrain = m_Chunks[MakeChunkKey(cx, cz)]->GetTerrain();
-				auto& data = terrain->GetData();
-				if (data.heightmap.empty())
-					continue;
-
-				float chunkWorldX = cx * CHUNK_SIZE;
-				float chunkWorldZ = cz * CHUNK_SIZE;
-
-				for (int lz = 0; lz < CHUNK_RESOLUTION; lz++)
-				{
-					for (int lx = 0; lx < CHUNK_RESOLUTION; lx++)
-					{
-						float vertWorldX = chunkWorldX + (lx / (float)(CHUNK_RESOLUTION - 1)) * CHUNK_SIZE;
-						float vertWorldZ = chunkWorldZ + (lz / (float)(CHUNK_RESOLUTION - 1)) * CHUNK_SIZE;
-
-						float dx = vertWorldX - worldX;
-						float dz = vertWorldZ - worldZ;
-						float dist = std::sqrt(dx * dx + dz * dz);
-						if (dist > radius)
-							continue;
-
-						float sum = GetChunkHeight(cx, cz, lx - 1, lz) + GetChunkHeight(cx, cz, lx + 1, lz) + GetChunkHeight(cx, cz, lx, lz - 1) + GetChunkHeight(cx, cz, lx, lz + 1);
-						float avg = sum * 0.25f;
-
-						SmoothVertex sv;
-						sv.chunk = terrain;
-						sv.lx = lx;
-						sv.lz = lz;
-						sv.average = avg;
-						sv.weight = brush.GetWeight(dist);
-						vertices.push_back(sv);
-					}
-				}
-			}
-		}
-
-		for (auto& sv : vertices)
-		{
-			auto& data = sv.chunk->GetDataMutable();
-			int idx = sv.lz * CHUNK_RESOLUTION + sv.lx;
-			data.heightmap[idx] = glm::mix(data.heightmap[idx], sv.average, sv.weight);
-		}
-
-		StitchEdges(minChunkX, maxChunkX, minChunkZ, maxChunkZ);
+		// Averages read one vertex around the brush, and all of them read the
+		// heights from before this dab
+		const MMO::TerrainVertexRect ring{rect.minX - 1, rect.minZ - 1, rect.maxX + 1, rect.maxZ + 1};
+		const int width = rect.maxX - rect.minX + 1;
+		const int ringWidth = width + 2;
+		GatherHeights(ring, m_BrushHeights);
+		m_BrushScratch.resize(static_cast<size_t>(width) * (rect.maxZ - rect.minZ + 1));
 
-		for (int cz = minChunkZ; cz <= maxChunkZ; cz++)
+		const BrushDab dab{worldX, worldZ, radius};
+		for (int gz = rect.minZ; gz <= rect.maxZ; gz++)
 		{
-			for (int cx = minChunkX; cx <= maxChunkX; cx++)
-			{
-				int32_t key = MakeChunkKey(cx, cz);
-				auto it = m_Chunks.find(key);
-				if (it != m_Chunks.end())
-				{
-					it->second->GetTerrain()->GetDataMutable().CalculateBounds();
-				}
-				DirtyNeighborChunks(cx, cz);
-			}
+			const float* center = &m_BrushHeights[(gz - ring.minZ) * ringWidth + 1];
+			BrushSmoothRow(dab, strength, static_cast<float>(rect.minX), static_cast<float>(gz),
+						   center, center - ringWidth, center + ringWidth, &m_BrushScratch[(gz - rect.minZ) * width], width);
 		}
+		ScatterHeights(rect, m_BrushScratch, false);
 	}
 
 	void EditorWorldSystem::FlattenTerrain(float worldX, float worldZ, float radius, float targetHeight, float hardness)
 	{
-		float innerRadius = radius * std::clamp(hardness, 0.0f, 0.99f);
-		float transitionWidth = radius - innerRadius;
-
-		ApplyBrush(worldX, worldZ, radius, [targetHeight, innerRadius, transitionWidth](TerrainChunk* chunk, int localX, int localZ, float dist) {
-			auto& data = chunk->GetDataMutable();
-			if (data.heightmap.empty())
-			{
-				data.heightmap.resize(CHUNK_HEIGHTMAP_SIZE, 0.0f);
-			}
-			int idx = localZ * CHUNK_RESOLUTION + localX;
-			float currentHeight = data.heightmap[idx];
+		MMO::TerrainVertexRect rect;
+		if (!BeginBrush(worldX, worldZ, radius, rect))
+			return;
 
-			if (dist <= innerRadius)
-			{
-				data.heightmap[idx] = targetHeight;
-			}
-			else
-			{
-				float t = (dist - innerRadius) / transitionWidth;
-				t = t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
-				float desired = glm::mix(targetHeight, currentHeight, t);
-				if (std::abs(desired - targetHeight) < std::abs(currentHeight - targetHeight))
-				{
-					data.heightmap[idx] = desired;
-				}
-			}
-		});
+		const float innerRadius = radius * std::clamp(hardness, 0.0f, 0.99f);
+		const BrushDab dab{worldX, worldZ, radius};
+		const int width = rect.maxX - rect.minX + 1;
+		GatherHeights(rect, m_BrushHeights);
+		for (int gz = rect.minZ; gz <= rect.maxZ; gz++)
+		{
+			BrushFlattenRow(dab, targetHeight, innerRadius, static_cast<float>(rect.minX), static_cast<float>(gz),
+							&m_BrushHeights[(gz - rect.minZ) * width], width);
+		}
+		ScatterHeights(rect, m_BrushHeights, true);
 	}
 
 	void EditorWorldSystem::RampTerrain(float startX, float startZ, float startHeight,
@@ -822,6 +763,7 @@ namespace Editor3D {
 		holeX = std::clamp(holeX, 0, HOLE_GRID_SIZE - 1);
 		holeZ = std::clamp(holeZ, 0, HOLE_GRID_SIZE - 1);
 
+		m_EditRecorder.Capture(key, terrain->GetData());
 		auto& data = terrain->GetDataMutable();
 		uint64_t bit = 1ULL << (holeZ * HOLE_GRID_SIZE + holeX);
 
@@ -922,49 +864,49 @@ namespace Editor3D {
 		}
 	}
 
-	void EditorWorldSystem::BeginEdit(float worldX, float worldZ, float radius)
+	void EditorWorldSystem::BeginEdit()
 	{
-		m_CurrentEditSnapshot = std::make_unique<EditSnapshot>();
-
-		int minChunkX = WorldToChunkX(worldX - radius);
-		int maxChunkX = WorldToChunkX(worldX + radius);
-		int minChunkZ = WorldToChunkZ(worldZ - radius);
-		int maxChunkZ = WorldToChunkZ(worldZ + radius);
-
-		for (int cz = minChunkZ; cz <= maxChunkZ; cz++)
-		{
-			for (int cx = minChunkX; cx <= maxChunkX; cx++)
-			{
-				int32_t key = MakeChunkKey(cx, cz);
-				auto it = m_Chunks.find(key);
-				if (it != m_Chunks.end())
-				{
-					m_CurrentEditSnapshot->chunkSnapshots.emplace_back(key, it->second->GetTerrain()->GetData());
-				}
-			}
-		}
+		m_EditRecorder.Begin();
 	}
 
-	void EditorWorldSystem::EndEdit()
+	void EditorWorldSystem::EndEdit(const std::string& description)
 	{
-		m_CurrentEditSnapshot.reset();
+		if (!m_EditRecorder.IsActive())
+			return;
+
+		std::vector<TerrainChunkDelta> deltas = m_EditRecorder.Finish([this](int32_t key) -> const TerrainChunkData* {
+			auto it = m_Chunks.find(key);
+			return it != m_Chunks.end() ? &it->second->GetTerrain()->GetData() : nullptr;
+		});
+		if (deltas.empty())
+			return;
+
+		auto resolver = [this](int32_t chunkX, int32_t chunkZ) -> TerrainChunk* {
+			auto it = m_Chunks.find(MakeChunkKey(chunkX, chunkZ));
+			if (it == m_Chunks.end() || it->second->GetTerrain()->GetState() != ChunkState::Active)
+				return nullptr;
+			return it->second->GetTerrain();
+		};
+		MMO::CommandHistory::Get().AddWithoutExecute(
+			std::make_unique<TerrainEditCommand>(std::move(resolver), std::move(deltas), description));
 	}
 
 	void EditorWorldSystem::CancelEdit()
 	{
-		if (!m_CurrentEditSnapshot)
+		if (!m_EditRecorder.IsActive())
 			return;
 
-		for (auto& [key, data] : m_CurrentEditSnapshot->chunkSnapshots)
+		for (const auto& [key, data] : m_EditRecorder.GetCaptured())
 		{
 			auto it = m_Chunks.find(key);
 			if (it != m_Chunks.end())
 			{
-				it->second->GetTerrain()->LoadFromData(data);
+				it->second->GetTerrain()->GetDataMutable() = data;
+				it->second->GetTerrain()->MarkSplatmapDirty();
 			}
 		}
 
-		m_CurrentEditSnapshot.reset();
+		m_EditRecorder.Reset();
 	}
 
 	float EditorWorldSystem::CalculateChunkDistance(int32_t chunkX, int32_t chunkZ) const
@@ -1139,6 +1081,50 @@ namespace Editor3D {
 	}
 
 	// ---- Runtime Export ----
+	//
+	// Models are parsed and baked, textures transcoded and chunks rewritten on
+	// a worker pool. Each job only fills in its own struct; the main thread
+	// merges counts, errors and manifest entries between phases. Anything
+	// whose inputs hash to its key in export.manifest is left as it is.
+
+	// Bump when the exporter writes different files for the same inputs (LOD
+	// settings, texture encoder, chunk layout...): everything rebuilds once
+	static constexpr uint64_t EXPORT_VERSION = 2;
+
+	static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	static int GetExportThreadCount()
+	{
+		return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+	}
+
+	// Runs job(i) for every i in [0, count) on up to GetExportThreadCount()
+	// threads, the calling one included
+	static void ParallelFor(size_t count, const std::function<void(size_t)>& job)
+	{
+		const size_t threadCount = std::min(static_cast<size_t>(GetExportThreadCount()), count);
+		std::atomic<size_t> next{0};
+		auto worker = [&] {
+			for (size_t i = next++; i < count; i = next++)
+			{
+				job(i);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t t = 1; t < threadCount; t++)
+		{
+			threads.emplace_back(worker);
+		}
+		worker();
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
 
 	static std::string ModelPathToOmdlName(const std::string& modelPath)
 	{
@@ -1146,304 +1132,809 @@ namespace Editor3D {
 		return p.stem().string() + ".omdl";
 	}
 
-	static bool CopyFileIfNeeded(const std::string& src, const std::string& dst)
+	static std::string ToLower(std::string text)
+	{
+		std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+		return text;
+	}
+
+	static bool IsImageFile(const std::filesystem::path& path)
+	{
+		const std::string ext = ToLower(path.extension().string());
+		return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp";
+	}
+
+	static bool CopyFileOver(const std::string& src, const std::string& dst)
 	{
-		if (std::filesystem::exists(dst))
-			return true;
-		std::filesystem::create_directories(std::filesystem::path(dst).parent_path());
 		std::error_code ec;
-		std::filesystem::copy_file(src, dst, std::filesystem::copy_options::skip_existing, ec);
+		std::filesystem::create_directories(std::filesystem::path(dst).parent_path(), ec);
+		std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing, ec);
 		return !ec;
 	}
 
-	EditorWorldSystem::ExportResult EditorWorldSystem::ExportForRuntime(
-		const std::string& outputDir, uint32_t mapId)
+	// ---- Textures ----
+
+	// One source image bound for materials/<dir>/, shared by every mesh and
+	// material that uses it. ExportTexture fills in the rest.
+	struct TextureExportJob
 	{
+		std::string src;
+		std::string destDir;	  // Absolute
+		std::string destRelative; // "materials/<dir>/"
+		Onyx::TextureUsage usage = Onyx::TextureUsage::Color;
+
+		std::string name; // Output file in destDir, empty on failure
+		uint64_t key = 0;
+		bool skipped = false;
+		bool compressed = false;
+		bool copied = false;
+		uint64_t rawBytes = 0;
+		uint64_t compressedBytes = 0;
+		std::string error;
+
+		std::string GetManifestName() const
+		{
+			return "texture:" + destRelative + std::filesystem::path(src).filename().string();
+		}
+		std::string GetOutput() const { return name.empty() ? "" : destRelative + name; }
+	};
+
+	// Transcodes the job's source into its directory as a block-compressed
+	// .dds with its full mip chain. Images stb cannot decode are copied as
+	// they are. A source whose contents are unchanged since its output was
+	// written is skipped.
+	static void ExportTexture(TextureExportJob& job, const MMO::ExportManifest& manifest,
+							  const std::string& outputDir)
+	{
+		namespace fs = std::filesystem;
 
-		ExportResult result;
+		MMO::ContentHasher hasher(EXPORT_VERSION);
+		hasher.AddValue(job.usage);
+		if (!hasher.AddFile(job.src))
+			return; // Unreadable, like an unresolved slot: the mesh goes without
+		job.key = hasher.Get();
 
-		// Save all dirty chunks first
-		SaveDirtyChunks();
+		if (const auto* entry = manifest.FindUpToDate(job.GetManifestName(), job.key, outputDir))
+		{
+			job.name = fs::path(entry->output).filename().string();
+			job.skipped = true;
+			return;
+		}
 
-		// Also gather objects for all loaded chunks
-		for (auto& [key, chunk] : m_Chunks)
+		int width = 0, height = 0, channels = 0;
+		unsigned char* pixels = Onyx::Texture::LoadImagePixels(job.src.c_str(), width, height, channels, 4, true);
+		if (!pixels)
 		{
-			GatherObjectsForChunk(chunk.get());
+			const std::string rawName = fs::path(job.src).filename().string();
+			if (CopyFileOver(job.src, job.destDir + "/" + rawName))
+			{
+				job.name = rawName;
+				job.copied = true;
+			}
+			return;
 		}
 
-		auto& assets = Onyx::Application::GetInstance().GetAssetManager();
+		const size_t texelCount = static_cast<size_t>(width) * height;
+		const Onyx::BlockFormat format = Onyx::ChooseBlockFormat(job.usage, pixels, texelCount);
+		const std::vector<uint8_t> dds = Onyx::EncodeDds(pixels, width, height, format);
+		Onyx::Texture::FreeImagePixels(pixels);
 
-		// Create output directories
-		char mapDirBuf[64];
-		snprintf(mapDirBuf, sizeof(mapDirBuf), "%s/maps/%03u/chunks", outputDir.c_str(), mapId);
-		std::string runtimeChunksDir = mapDirBuf;
-		std::string modelsDir = outputDir + "/models";
-		std::string materialsDir = outputDir + "/materials";
+		const std::string ddsName = fs::path(job.src).stem().string() + ".dds";
+		const std::string ddsPath = job.destDir + "/" + ddsName;
+		std::error_code ec;
+		fs::create_directories(job.destDir, ec);
+		std::ofstream file(ddsPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(dds.data()), static_cast<std::streamsize>(dds.size()));
+		if (!file)
+		{
+			job.error = "Failed to write texture: " + ddsPath;
+			return;
+		}
 
-		std::filesystem::create_directories(runtimeChunksDir);
-		std::filesystem::create_directories(modelsDir);
-		std::filesystem::create_directories(materialsDir);
+		job.name = ddsName;
+		job.compressed = true;
+		job.rawBytes = texelCount * 4;
+		job.compressedBytes = dds.size();
+	}
 
-		// Collect unique model paths across all chunks
-		std::unordered_set<std::string> uniqueModels;
-		for (const auto& [key, chunk] : m_Chunks)
+	// ---- Models ----
+
+	// A texture slot of an exported mesh, and the texture file its .omdl
+	// references (recorded so a skipped model can tell its textures moved)
+	struct ModelTextureSlot
+	{
+		uint32_t mesh = 0;
+		bool normal = false; // Else albedo
+		std::string src;
+		size_t texture = 0; // Into the texture jobs
+		std::string output;
+	};
+
+	struct ModelExportJob
+	{
+		std::string modelPath;
+		std::string omdlName;
+		uint64_t key = 0;
+
+		bool upToDate = false;				   // Per the manifest, until its textures are checked
+		std::vector<Onyx::CpuMeshData> meshes; // Parsed only to rebuild
+		std::vector<ModelTextureSlot> slots;
+		glm::vec3 boundsMin{0.0f};
+		glm::vec3 boundsMax{0.0f};
+
+		bool written = false;
+		bool skipped = false;
+		int lodsBaked = 0;
+		std::string error;
+
+		std::string GetManifestName() const { return "model:" + modelPath; }
+	};
+
+	// The model file, the files its import pulls in (an OBJ's .mtl, a glTF's
+	// .bin) and the names of the images next to it: texture lookup falls
+	// back to those, so adding or renaming one can change the .omdl
+	static uint64_t HashModelInputs(const std::string& modelPath)
+	{
+		namespace fs = std::filesystem;
+
+		MMO::ContentHasher hasher(EXPORT_VERSION);
+		hasher.Add(modelPath);
+		Onyx::FileSystem::FileView file;
+		if (Onyx::FileSystem::ReadFile(modelPath, file))
 		{
-			for (const auto& obj : chunk->GetObjects())
-			{
-				if (!obj.modelPath.empty())
-				{
-					uniqueModels.insert(obj.modelPath);
-				}
-			}
+			const std::string_view contents(reinterpret_cast<const char*>(file.data), file.size);
+			hasher.Add(contents);
+			Onyx::ModelCache::HashCompanionFiles(hasher, modelPath, contents);
 		}
 
-		// Also collect from editor world if available
-		if (m_EditorWorld)
+		std::vector<std::string> images;
+		std::error_code ec;
+		for (fs::directory_iterator it(fs::path(modelPath).parent_path(), ec), end; !ec && it != end; it.increment(ec))
 		{
-			for (const auto& obj : m_EditorWorld->GetStaticObjects())
+			if (it->is_regular_file(ec) && IsImageFile(it->path()))
+				images.push_back(it->path().filename().string());
+		}
+		std::sort(images.begin(), images.end());
+		for (const std::string& image : images)
+		{
+			hasher.Add(image);
+		}
+		return hasher.Get();
+	}
+
+	// Assimp's texture path is whatever the source asset embeds (often a name
+	// from the original DCC tool that doesn't match what's actually on disk —
+	// e.g. an FBX exported from Unreal references `_Unreal_BaseColor.tga`
+	// while the artist ships `Albedo.png`). Resolve in three steps:
+	//   1. <modelDir>/<assimpPath>
+	//   2. <modelDir>/<basename(assimpPath)>
+	//   3. heuristic: any image in <modelDir> matching the slot kind.
+	static std::string ResolveTextureSrc(const std::string& modelDir, const std::string& assimpPath,
+										 const std::vector<std::string>& keywords)
+	{
+		namespace fs = std::filesystem;
+
+		// error_code overloads throughout: this runs on the export workers
+		std::error_code ec;
+		if (!assimpPath.empty())
+		{
+			std::string p1 = modelDir + "/" + assimpPath;
+			if (fs::exists(p1, ec))
+				return p1;
+			std::string p2 = modelDir + "/" + fs::path(assimpPath).filename().string();
+			if (fs::exists(p2, ec))
+				return p2;
+		}
+		if (modelDir.empty() || !fs::is_directory(modelDir, ec))
+			return "";
+		for (fs::directory_iterator it(modelDir, ec), end; !ec && it != end; it.increment(ec))
+		{
+			if (!it->is_regular_file(ec) || !IsImageFile(it->path()))
+				continue;
+			const std::string lower = ToLower(it->path().filename().string());
+			for (const auto& kw : keywords)
 			{
-				if (!obj->GetModelPath().empty())
+				if (lower.find(kw) != std::string::npos)
 				{
-					uniqueModels.insert(obj->GetModelPath());
+					return it->path().string();
 				}
 			}
 		}
+		return "";
+	}
 
-		// Check for duplicate omdl names (different source paths → same stem)
-		std::unordered_map<std::string, std::string> omdlNameToSource; // omdlName → first source path
-		for (const std::string& modelPath : uniqueModels)
+	// The export needs CPU-side mesh data, which the editor's async render
+	// copies no longer have once uploaded, so models are parsed again here.
+	// Model::ParseFromFile, unlike the Model constructor, creates no GL
+	// objects and can run on the export workers.
+	static bool ParseExportModel(ModelExportJob& job)
+	{
+		std::string directory;
+		job.meshes = Onyx::Model::ParseFromFile(job.modelPath, directory, true);
+		if (job.meshes.empty())
 		{
-			std::string omdlName = ModelPathToOmdlName(modelPath);
-			auto it = omdlNameToSource.find(omdlName);
-			if (it != omdlNameToSource.end() && it->second != modelPath)
-			{
-				result.errors.push_back("Duplicate model name '" + omdlName +
-										"' from:\n  " + it->second + "\n  " + modelPath);
-			}
-			else
-			{
-				omdlNameToSource[omdlName] = modelPath;
-			}
+			job.error = "Failed to parse model (no meshes): " + job.modelPath;
+			return false;
 		}
-		if (!result.errors.empty())
-		{
-			return result;
+		return true;
+	}
+
+	static void ResolveModelTextures(ModelExportJob& job)
+	{
+		static const std::vector<std::string> diffuseKeywords = {"albedo", "basecolor", "base_color", "diffuse", "color"};
+		static const std::vector<std::string> normalKeywords = {"normal", "nrm"};
+
+		const std::string modelDir = std::filesystem::path(job.modelPath).parent_path().string();
+		job.slots.clear();
+		for (uint32_t m = 0; m < job.meshes.size(); m++)
+		{
+			std::string albedoSrc;
+			std::string normalSrc;
+			for (const auto& tex : job.meshes[m].texturePaths)
+			{
+				if (tex.type == "texture_diffuse" && albedoSrc.empty())
+					albedoSrc = ResolveTextureSrc(modelDir, tex.path, diffuseKeywords);
+				if (tex.type == "texture_normal" && normalSrc.empty())
+					normalSrc = ResolveTextureSrc(modelDir, tex.path, normalKeywords);
+			}
+			// If the asset exposed no texture slots at all, still try to find
+			// sibling images by name — common when the FBX has a stub material.
+			if (albedoSrc.empty())
+				albedoSrc = ResolveTextureSrc(modelDir, "", diffuseKeywords);
+			if (normalSrc.empty())
+				normalSrc = ResolveTextureSrc(modelDir, "", normalKeywords);
+
+			if (!albedoSrc.empty())
+				job.slots.push_back({m, false, albedoSrc, 0, ""});
+			if (!normalSrc.empty())
+				job.slots.push_back({m, true, normalSrc, 0, ""});
 		}
+	}
 
-		// Export models as .omdl
-		std::unordered_map<std::string, std::string> modelPathRemap; // original → relative .omdl path
+	// Manifest fields of a model: its bounds, then mesh/slot, source and
+	// output of each texture slot
+	static std::vector<std::string> MakeModelEntryFields(const ModelExportJob& job)
+	{
+		char bounds[160];
+		snprintf(bounds, sizeof(bounds), "%.9g %.9g %.9g %.9g %.9g %.9g", job.boundsMin.x, job.boundsMin.y,
+				 job.boundsMin.z, job.boundsMax.x, job.boundsMax.y, job.boundsMax.z);
 
-		for (const std::string& modelPath : uniqueModels)
+		std::vector<std::string> fields = {bounds};
+		for (const ModelTextureSlot& slot : job.slots)
 		{
-			std::string omdlName = ModelPathToOmdlName(modelPath);
-			std::string omdlRelative = "models/" + omdlName;
-			std::string omdlFullPath = modelsDir + "/" + omdlName;
-
-			// The editor's render path loads models async, which uploads merged
-			// GPU buffers and leaves per-mesh CPU `m_Vertices`/`m_Indices` /
-			// `m_Textures` empty. The exporter needs CPU-side data, so always
-			// re-parse via the synchronous `Model(path, true)` constructor for
-			// export. `loadTextures=true` populates each mesh's m_Textures so the
-			// material-copy pass below has paths to copy. This is a one-shot
-			// local Model that bypasses the AssetManager cache; the editor keeps
-			// using its GPU-only async copy for rendering.
-			Onyx::Model exportModel(modelPath.c_str(), true);
-			Onyx::Model* model = &exportModel;
-
-			// Build .omdl data from model meshes
-			MMO::OmdlData omdl;
-			auto& meshes = model->GetMeshes();
-			if (meshes.empty())
-			{
-				result.errors.push_back("Failed to parse model (no meshes): " + modelPath);
-				continue;
-			}
-
-			uint32_t totalVertices = 0;
-			uint32_t totalIndices = 0;
-
-			// First pass: count totals
-			for (const auto& mesh : meshes)
-			{
-				totalVertices += static_cast<uint32_t>(mesh.m_Vertices.size());
-				totalIndices += static_cast<uint32_t>(mesh.m_Indices.size());
-			}
-
-			omdl.header.meshCount = static_cast<uint32_t>(meshes.size());
-			omdl.header.totalVertices = totalVertices;
-			omdl.header.totalIndices = totalIndices;
-			// Compact small models with u16 indices — saves half the index blob.
-			const bool useU16Idx = totalVertices < 65536u;
-			omdl.header.flags = useU16Idx ? MMO::OMDL_FLAG_U16_INDICES : 0u;
-
-			// Global bounds
-			glm::vec3 globalMin(std::numeric_limits<float>::max());
-			glm::vec3 globalMax(std::numeric_limits<float>::lowest());
-
-			// Allocate blobs
-			omdl.vertexBlob.resize(totalVertices * sizeof(Onyx::MeshVertex));
-			omdl.indexBlob.resize(totalIndices * (useU16Idx ? 2 : 4));
-
-			uint32_t vertexOffset = 0;
-			uint32_t indexOffset = 0;
-
-			for (size_t i = 0; i < meshes.size(); i++)
-			{
-				const auto& mesh = meshes[i];
-				MMO::OmdlMeshInfo info;
-				info.indexCount = static_cast<uint32_t>(mesh.m_Indices.size());
-				info.firstIndex = indexOffset;
-				info.baseVertex = static_cast<int32_t>(vertexOffset);
-
-				// Mesh bounds
-				info.boundsMin[0] = mesh.GetBoundsMin().x;
-				info.boundsMin[1] = mesh.GetBoundsMin().y;
-				info.boundsMin[2] = mesh.GetBoundsMin().z;
-				info.boundsMax[0] = mesh.GetBoundsMax().x;
-				info.boundsMax[1] = mesh.GetBoundsMax().y;
-				info.boundsMax[2] = mesh.GetBoundsMax().z;
-
-				globalMin = glm::min(globalMin, mesh.GetBoundsMin());
-				globalMax = glm::max(globalMax, mesh.GetBoundsMax());
-
-				// Texture paths — copy into materials/{modelStem}/.
-				//
-				// Assimp's `tex.path` is whatever the source asset embeds (often
-				// a name from the original DCC tool that doesn't match what's
-				// actually on disk — e.g. an FBX exported from Unreal references
-				// `_Unreal_BaseColor.tga` while the artist ships `Albedo.png`).
-				// Resolve in three steps:
-				//   1. <modelDir>/<assimpPath>
-				//   2. <modelDir>/<basename(assimpPath)>
-				//   3. heuristic: any image in <modelDir> matching the slot kind.
-				std::string modelDir = std::filesystem::path(modelPath).parent_path().string();
-				std::string modelStem = std::filesystem::path(modelPath).stem().string();
-				std::string matDir = materialsDir + "/" + modelStem;
-				std::string matRelative = "materials/" + modelStem + "/";
-
-				auto resolveTextureSrc = [&](const std::string& assimpPath,
-											 const std::vector<std::string>& keywords) -> std::string {
-					if (!assimpPath.empty())
-					{
-						std::string p1 = modelDir + "/" + assimpPath;
-						if (std::filesystem::exists(p1))
-							return p1;
-						std::string p2 = modelDir + "/" + std::filesystem::path(assimpPath).filename().string();
-						if (std::filesystem::exists(p2))
-							return p2;
-					}
-					if (modelDir.empty() || !std::filesystem::is_directory(modelDir))
-						return "";
-					for (const auto& entry : std::filesystem::directory_iterator(modelDir))
-					{
-						if (!entry.is_regular_file())
-							continue;
-						std::string ext = entry.path().extension().string();
-						std::transform(ext.begin(), ext.end(), ext.begin(),
-									   [](unsigned char c) { return std::tolower(c); });
-						if (ext != ".png" && ext != ".jpg" && ext != ".jpeg" && ext != ".tga" && ext != ".bmp")
-							continue;
-						std::string name = entry.path().filename().string();
-						std::string lower = name;
-						std::transform(lower.begin(), lower.end(), lower.begin(),
-									   [](unsigned char c) { return std::tolower(c); });
-						for (const auto& kw : keywords)
-						{
-							if (lower.find(kw) != std::string::npos)
-							{
-								return entry.path().string();
-							}
-						}
-					}
-					return "";
-				};
-
-				auto copyTexture = [&](const std::string& srcPath) -> std::string {
-					if (srcPath.empty())
-						return "";
-					std::string texName = std::filesystem::path(srcPath).filename().string();
-					std::string destPath = matDir + "/" + texName;
-					if (CopyFileIfNeeded(srcPath, destPath))
-					{
-						result.texturesCopied++;
-					}
-					return matRelative + texName;
-				};
+			fields.push_back(std::to_string(slot.mesh) + (slot.normal ? "n" : "a"));
+			fields.push_back(slot.src);
+			fields.push_back(slot.output);
+		}
+		return fields;
+	}
 
-				const std::vector<std::string> diffuseKeywords =
-					{"albedo", "basecolor", "base_color", "diffuse", "color"};
-				const std::vector<std::string> normalKeywords =
-					{"normal", "nrm"};
+	static bool ReadModelEntryFields(const std::vector<std::string>& fields, ModelExportJob& job)
+	{
+		if (fields.empty() || (fields.size() - 1) % 3 != 0)
+			return false;
+		glm::vec3& mn = job.boundsMin;
+		glm::vec3& mx = job.boundsMax;
+		if (sscanf(fields[0].c_str(), "%f %f %f %f %f %f", &mn.x, &mn.y, &mn.z, &mx.x, &mx.y, &mx.z) != 6)
+			return false;
 
-				for (const auto& tex : mesh.m_Textures)
-				{
-					if (tex.type == "texture_diffuse" && info.albedoPath.empty())
-					{
-						std::string src = resolveTextureSrc(tex.path, diffuseKeywords);
-						info.albedoPath = copyTexture(src);
-					}
-					if (tex.type == "texture_normal" && info.normalPath.empty())
-					{
-						std::string src = resolveTextureSrc(tex.path, normalKeywords);
-						info.normalPath = copyTexture(src);
-					}
-				}
-				// If the asset exposed no texture slots at all, still try to find
-				// sibling images by name — common when the FBX has a stub material.
-				if (info.albedoPath.empty())
-				{
-					info.albedoPath = copyTexture(resolveTextureSrc("", diffuseKeywords));
-				}
-				if (info.normalPath.empty())
-				{
-					info.normalPath = copyTexture(resolveTextureSrc("", normalKeywords));
-				}
+		job.slots.clear();
+		for (size_t i = 1; i < fields.size(); i += 3)
+		{
+			const std::string& id = fields[i];
+			if (id.size() < 2 || (id.back() != 'a' && id.back() != 'n'))
+				return false;
+			ModelTextureSlot slot;
+			slot.mesh = static_cast<uint32_t>(std::strtoul(id.c_str(), nullptr, 10));
+			slot.normal = id.back() == 'n';
+			slot.src = fields[i + 1];
+			slot.output = fields[i + 2];
+			job.slots.push_back(std::move(slot));
+		}
+		return true;
+	}
 
-				omdl.meshes.push_back(std::move(info));
+	// Bakes the parsed meshes into models/<name>.omdl, referencing the
+	// textures the texture phase produced for their slots
+	static void WriteExportModel(ModelExportJob& job, const std::vector<TextureExportJob>& textures,
+								 const std::string& modelsDir)
+	{
+		const auto& meshes = job.meshes;
+		MMO::OmdlData omdl;
 
-				// Copy vertex data (already in v2 28-byte layout)
-				size_t vertBytes = mesh.m_Vertices.size() * sizeof(Onyx::MeshVertex);
-				memcpy(omdl.vertexBlob.data() + vertexOffset * sizeof(Onyx::MeshVertex),
-					   mesh.m_Vertices.data(), vertBytes);
-				vertexOffset += static_cast<uint32_t>(mesh.m_Vertices.size());
+		uint32_t totalVertices = 0;
+		uint32_t totalIndices = 0;
 
-				// Copy index data — narrow to u16 when totalVertices < 65k
-				if (useU16Idx)
-				{
-					uint16_t* dst = reinterpret_cast<uint16_t*>(omdl.indexBlob.data()) + indexOffset;
-					for (size_t k = 0; k < mesh.m_Indices.size(); ++k)
-					{
-						dst[k] = static_cast<uint16_t>(mesh.m_Indices[k]);
-					}
-				}
-				else
+		// First pass: count totals and bake each mesh's LOD chain. The
+		// simplified ranges are laid out after every mesh's LOD0 range, so
+		// their final offsets are only known once all LOD0 counts are.
+		struct LodChain
+		{
+			Onyx::MeshLod lods[Onyx::MAX_MESH_LODS];
+			uint32_t count = 1;
+			std::vector<uint32_t> indices; // Relative to the chain, mesh-local vertices
+		};
+		static_assert(MMO::OMDL_MAX_LODS == Onyx::MAX_MESH_LODS);
+		std::vector<LodChain> lodChains(meshes.size());
+		uint32_t lod0Indices = 0;
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			const auto& mesh = meshes[i];
+			LodChain& chain = lodChains[i];
+			chain.lods[0] = {0, static_cast<uint32_t>(mesh.indices.size()), 0.0f};
+			chain.count = Onyx::BuildMeshLods(reinterpret_cast<const uint8_t*>(mesh.vertices.data()),
+											  mesh.vertices.size(), sizeof(Onyx::MeshVertex), mesh.indices.data(),
+											  mesh.indices.size(), 0, chain.indices, chain.lods);
+			job.lodsBaked += static_cast<int>(chain.count - 1);
+
+			totalVertices += static_cast<uint32_t>(mesh.vertices.size());
+			lod0Indices += static_cast<uint32_t>(mesh.indices.size());
+			totalIndices += static_cast<uint32_t>(mesh.indices.size() + chain.indices.size());
+		}
+
+		omdl.header.meshCount = static_cast<uint32_t>(meshes.size());
+		omdl.header.totalVertices = totalVertices;
+		omdl.header.totalIndices = totalIndices;
+		// Compact small models with u16 indices — saves half the index blob.
+		const bool useU16Idx = totalVertices < 65536u;
+		omdl.header.flags = useU16Idx ? MMO::OMDL_FLAG_U16_INDICES : 0u;
+
+		// Global bounds
+		glm::vec3 globalMin(std::numeric_limits<float>::max());
+		glm::vec3 globalMax(std::numeric_limits<float>::lowest());
+
+		// Allocate blobs
+		omdl.vertexBlob.resize(totalVertices * sizeof(Onyx::MeshVertex));
+		omdl.indexBlob.resize(totalIndices * (useU16Idx ? 2 : 4));
+
+		// Narrow to u16 when totalVertices < 65k
+		auto writeIndices = [&](uint32_t offset, const std::vector<uint32_t>& indices) {
+			if (useU16Idx)
+			{
+				uint16_t* dst = reinterpret_cast<uint16_t*>(omdl.indexBlob.data()) + offset;
+				for (size_t k = 0; k < indices.size(); ++k)
 				{
-					size_t idxBytes = mesh.m_Indices.size() * sizeof(uint32_t);
-					memcpy(omdl.indexBlob.data() + indexOffset * sizeof(uint32_t),
-						   mesh.m_Indices.data(), idxBytes);
+					dst[k] = static_cast<uint16_t>(indices[k]);
 				}
-				indexOffset += static_cast<uint32_t>(mesh.m_Indices.size());
-			}
-
-			omdl.header.boundsMin[0] = globalMin.x;
-			omdl.header.boundsMin[1] = globalMin.y;
-			omdl.header.boundsMin[2] = globalMin.z;
-			omdl.header.boundsMax[0] = globalMax.x;
-			omdl.header.boundsMax[1] = globalMax.y;
-			omdl.header.boundsMax[2] = globalMax.z;
-
-			if (MMO::WriteOmdl(omdlFullPath, omdl))
-			{
-				modelPathRemap[modelPath] = omdlRelative;
-				result.modelsExported++;
 			}
 			else
 			{
-				result.errors.push_back("Failed to write .omdl: " + omdlFullPath);
+				memcpy(omdl.indexBlob.data() + offset * sizeof(uint32_t), indices.data(),
+					   indices.size() * sizeof(uint32_t));
 			}
-		}
+		};
+
+		uint32_t vertexOffset = 0;
+		uint32_t indexOffset = 0;
+		uint32_t lodIndexOffset = lod0Indices;
+
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			const auto& mesh = meshes[i];
+			MMO::OmdlMeshInfo info;
+			info.indexCount = static_cast<uint32_t>(mesh.indices.size());
+			info.firstIndex = indexOffset;
+			info.baseVertex = static_cast<int32_t>(vertexOffset);
+
+			const LodChain& chain = lodChains[i];
+			info.lodCount = chain.count;
+			info.lods[0] = {info.firstIndex, info.indexCount, 0.0f};
+			for (uint32_t l = 1; l < chain.count; l++)
+			{
+				info.lods[l] = {lodIndexOffset + chain.lods[l].firstIndex, chain.lods[l].indexCount,
+								chain.lods[l].error};
+			}
+
+			// Mesh bounds
+			glm::vec3 meshMin(0.0f);
+			glm::vec3 meshMax(0.0f);
+			if (!mesh.vertices.empty())
+			{
+				meshMin = glm::vec3(std::numeric_limits<float>::max());
+				meshMax = glm::vec3(std::numeric_limits<float>::lowest());
+				for (const auto& v : mesh.vertices)
+				{
+					glm::vec3 p(v.position[0], v.position[1], v.position[2]);
+					meshMin = glm::min(meshMin, p);
+					meshMax = glm::max(meshMax, p);
+				}
+			}
+			info.boundsMin[0] = meshMin.x;
+			info.boundsMin[1] = meshMin.y;
+			info.boundsMin[2] = meshMin.z;
+			info.boundsMax[0] = meshMax.x;
+			info.boundsMax[1] = meshMax.y;
+			info.boundsMax[2] = meshMax.z;
+
+			globalMin = glm::min(globalMin, meshMin);
+			globalMax = glm::max(globalMax, meshMax);
+
+			omdl.meshes.push_back(std::move(info));
+
+			// Copy vertex data (already in the 28-byte MeshVertex layout)
+			size_t vertBytes = mesh.vertices.size() * sizeof(Onyx::MeshVertex);
+			memcpy(omdl.vertexBlob.data() + vertexOffset * sizeof(Onyx::MeshVertex), mesh.vertices.data(),
+				   vertBytes);
+			vertexOffset += static_cast<uint32_t>(mesh.vertices.size());
+
+			writeIndices(indexOffset, mesh.indices);
+			indexOffset += static_cast<uint32_t>(mesh.indices.size());
+			writeIndices(lodIndexOffset, chain.indices);
+			lodIndexOffset += static_cast<uint32_t>(chain.indices.size());
+		}
 
-		// Export editor-assigned materials
+		// Texture paths, from materials/{modelStem}/
+		for (ModelTextureSlot& slot : job.slots)
+		{
+			if (slot.mesh >= omdl.meshes.size())
+				continue; // Recorded for a different parse of the model
+			slot.output = textures[slot.texture].GetOutput();
+			MMO::OmdlMeshInfo& info = omdl.meshes[slot.mesh];
+			(slot.normal ? info.normalPath : info.albedoPath) = slot.output;
+		}
+
+		omdl.header.boundsMin[0] = globalMin.x;
+		omdl.header.boundsMin[1] = globalMin.y;
+		omdl.header.boundsMin[2] = globalMin.z;
+		omdl.header.boundsMax[0] = globalMax.x;
+		omdl.header.boundsMax[1] = globalMax.y;
+		omdl.header.boundsMax[2] = globalMax.z;
+
+		const std::string omdlFullPath = modelsDir + "/" + job.omdlName;
+		if (MMO::WriteOmdl(omdlFullPath, omdl))
+		{
+			job.boundsMin = globalMin;
+			job.boundsMax = globalMax;
+			job.written = true;
+		}
+		else
+		{
+			job.error = "Failed to write .omdl: " + omdlFullPath;
+		}
+
+		// Only the written file is needed from here on
+		job.meshes.clear();
+		job.meshes.shrink_to_fit();
+	}
+
+	// ---- Chunks ----
+
+	// Footprint of a placed object's collider for the server terrain bake, or
+	// nothing for objects without one (they are not solid in game either).
+	// Mesh colliders use the model's bounds. Tilt is dropped: the footprint
+	// keeps the yaw and the full world-space height range.
+	static std::optional<MMO::TerrainObstacle> MakeTerrainObstacle(
+		const ChunkObject& co, const std::unordered_map<std::string, std::pair<glm::vec3, glm::vec3>>& modelBounds)
+	{
+		glm::vec3 center = co.colliderCenter;
+		glm::vec3 halfExtents;
+		switch (static_cast<MMO::ColliderType>(co.colliderType))
+		{
+		case MMO::ColliderType::BOX:
+			halfExtents = co.colliderHalfExtents;
+			break;
+		case MMO::ColliderType::SPHERE:
+			halfExtents = glm::vec3(co.colliderRadius);
+			break;
+		case MMO::ColliderType::CAPSULE:
+			halfExtents = glm::vec3(co.colliderRadius, co.colliderHeight * 0.5f, co.colliderRadius);
+			break;
+		case MMO::ColliderType::MESH:
+		{
+			auto it = modelBounds.find(co.modelPath);
+			if (it == modelBounds.end())
+				return std::nullopt;
+			center = (it->second.first + it->second.second) * 0.5f;
+			halfExtents = (it->second.second - it->second.first) * 0.5f;
+			break;
+		}
+		default:
+			return std::nullopt;
+		}
+
+		MMO::TerrainObstacle obstacle;
+		const glm::vec3 worldCenter = co.position + co.rotation * (center * co.scale);
+		obstacle.centerX = worldCenter.x;
+		obstacle.centerZ = worldCenter.z;
+		obstacle.halfExtentX = halfExtents.x * co.scale;
+		obstacle.halfExtentZ = halfExtents.z * co.scale;
+
+		const glm::vec3 axisX = co.rotation * glm::vec3(1.0f, 0.0f, 0.0f);
+		obstacle.yaw = std::atan2(axisX.z, axisX.x);
+
+		obstacle.bottom = std::numeric_limits<float>::max();
+		obstacle.top = std::numeric_limits<float>::lowest();
+		for (int corner = 0; corner < 8; corner++)
+		{
+			glm::vec3 sign((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f);
+			float y = (co.position + co.rotation * ((center + sign * halfExtents) * co.scale)).y;
+			obstacle.bottom = std::min(obstacle.bottom, y);
+			obstacle.top = std::max(obstacle.top, y);
+		}
+		return obstacle;
+	}
+
+	struct ChunkExportJob
+	{
+		int32_t chunkX = 0;
+		int32_t chunkZ = 0;
+		const WorldChunk* loaded = nullptr; // Null: read from its editor file
+		uint64_t key = 0;
+
+		bool built = false;
+		MMO::ChunkFileData fileData;
+		std::vector<MMO::TerrainObstacle> obstacles;
+
+		bool written = false;
+		bool skipped = false;
+		std::string error;
+
+		std::string GetOutput(uint32_t mapId) const
+		{
+			char path[64];
+			snprintf(path, sizeof(path), "maps/%03u/chunks/chunk_%d_%d.chunk", mapId, chunkX, chunkZ);
+			return path;
+		}
+	};
+
+	// The runtime form of an editor chunk, plus the obstacles its objects
+	// put into the server terrain
+	static void BuildChunkFileData(const WorldChunk& chunk, uint32_t mapId,
+								   const std::unordered_map<std::string, std::string>& modelPathRemap,
+								   const std::unordered_map<std::string, std::pair<glm::vec3, glm::vec3>>& modelBounds,
+								   ChunkExportJob& job)
+	{
+		MMO::ChunkFileData& fileData = job.fileData;
+		fileData.mapId = mapId;
+
+		// Terrain
+		if (chunk.GetTerrain())
+		{
+			fileData.terrain = chunk.GetTerrain()->GetData();
+		}
+
+		// Lights — convert EditorLight to ChunkLightData
+		for (const auto& el : chunk.GetLights())
+		{
+			MMO::ChunkLightData ld;
+			ld.type = static_cast<uint8_t>(el.type);
+			ld.position[0] = el.position.x;
+			ld.position[1] = el.position.y;
+			ld.position[2] = el.position.z;
+			ld.direction[0] = el.direction.x;
+			ld.direction[1] = el.direction.y;
+			ld.direction[2] = el.direction.z;
+			ld.color[0] = el.color.x;
+			ld.color[1] = el.color.y;
+			ld.color[2] = el.color.z;
+			ld.intensity = el.intensity;
+			ld.range = el.range;
+			ld.innerAngle = el.innerAngle;
+			ld.outerAngle = el.outerAngle;
+			ld.castShadows = el.castShadows;
+			fileData.lights.push_back(ld);
+		}
+
+		// Objects — convert ChunkObject to ChunkObjectData with remapped model paths
+		for (const auto& co : chunk.GetObjects())
+		{
+			MMO::ChunkObjectData od;
+
+			// Remap model path to .omdl relative path
+			auto remapIt = modelPathRemap.find(co.modelPath);
+			if (remapIt != modelPathRemap.end())
+			{
+				od.modelPath = remapIt->second;
+			}
+			else
+			{
+				od.modelPath = co.modelPath; // fallback to original
+			}
+
+			od.position[0] = co.position.x;
+			od.position[1] = co.position.y;
+			od.position[2] = co.position.z;
+
+			// Convert quaternion to euler angles (radians)
+			glm::vec3 euler = glm::eulerAngles(co.rotation);
+			od.rotation[0] = euler.x;
+			od.rotation[1] = euler.y;
+			od.rotation[2] = euler.z;
+
+			od.scale[0] = co.scale;
+			od.scale[1] = co.scale;
+			od.scale[2] = co.scale;
+
+			od.flags = co.castsShadow ? 1u : 0u;
+			od.materialId = co.materialId;
+
+			fileData.objects.push_back(od);
+
+			if (auto obstacle = MakeTerrainObstacle(co, modelBounds))
+			{
+				job.obstacles.push_back(*obstacle);
+			}
+		}
+
+		job.built = true;
+	}
+
+	// Field by field: the structs have padding, which must not reach the key
+	static void HashChunkFileData(MMO::ContentHasher& hasher, const MMO::ChunkFileData& data)
+	{
+		const MMO::TerrainChunkData& terrain = data.terrain;
+		hasher.AddVector(terrain.heightmap);
+		hasher.AddVector(terrain.splatmap);
+		hasher.AddValue(terrain.holeMask);
+		for (const std::string& materialId : terrain.materialIds)
+		{
+			hasher.Add(materialId);
+		}
+
+		hasher.AddValue(data.lights.size());
+		for (const MMO::ChunkLightData& light : data.lights)
+		{
+			hasher.AddValue(light.type);
+			hasher.AddValue(light.position);
+			hasher.AddValue(light.direction);
+			hasher.AddValue(light.color);
+			hasher.AddValue(light.intensity);
+			hasher.AddValue(light.range);
+			hasher.AddValue(light.innerAngle);
+			hasher.AddValue(light.outerAngle);
+			hasher.AddValue(light.castShadows);
+		}
+
+		hasher.AddValue(data.objects.size());
+		for (const MMO::ChunkObjectData& object : data.objects)
+		{
+			hasher.Add(object.modelPath);
+			hasher.AddValue(object.position);
+			hasher.AddValue(object.rotation);
+			hasher.AddValue(object.scale);
+			hasher.AddValue(object.flags);
+			hasher.Add(object.materialId);
+		}
+	}
+
+	// The collider footprints a loaded chunk's objects put into the server
+	// terrain. ChunkFileData does not carry the collider fields, so without
+	// this a collider-only edit would leave the chunk and terrain keys as is.
+	static void HashTerrainObstacles(MMO::ContentHasher& hasher, const std::vector<MMO::TerrainObstacle>& obstacles)
+	{
+		static_assert(sizeof(MMO::TerrainObstacle) == 7 * sizeof(float), "TerrainObstacle must stay unpadded");
+		hasher.AddVector(obstacles);
+	}
+
+	// ---- Pack ----
+
+	// What the pack would be built from: the path, size and write time of
+	// every file it takes. Any rewrite above changes the write time.
+	static uint64_t HashPackInputs(const std::string& outputDir, const std::vector<std::string>& skipExtensions)
+	{
+		namespace fs = std::filesystem;
+
+		std::vector<std::tuple<std::string, uint64_t, int64_t>> files;
+		std::error_code ec;
+		for (fs::recursive_directory_iterator it(outputDir, ec), end; !ec && it != end; it.increment(ec))
+		{
+			if (!it->is_regular_file(ec))
+				continue;
+			const std::string ext = ToLower(it->path().extension().string());
+			if (std::find(skipExtensions.begin(), skipExtensions.end(), ext) != skipExtensions.end())
+				continue;
+			files.emplace_back(it->path().lexically_relative(outputDir).generic_string(), it->file_size(ec),
+							   static_cast<int64_t>(it->last_write_time(ec).time_since_epoch().count()));
+		}
+		std::sort(files.begin(), files.end());
+
+		MMO::ContentHasher hasher(EXPORT_VERSION);
+		for (const auto& [path, size, writeTime] : files)
+		{
+			hasher.Add(path);
+			hasher.AddValue(size);
+			hasher.AddValue(writeTime);
+		}
+		return hasher.Get();
+	}
+
+	static uint64_t ParseManifestCount(const MMO::ExportManifest::Entry& entry, size_t field)
+	{
+		return field < entry.fields.size() ? std::strtoull(entry.fields[field].c_str(), nullptr, 10) : 0;
+	}
+
+	EditorWorldSystem::ExportResult EditorWorldSystem::ExportForRuntime(
+		const std::string& outputDir, uint32_t mapId)
+	{
+		namespace fs = std::filesystem;
+		using Clock = std::chrono::steady_clock;
+
+		ExportResult result;
+		result.workerThreads = GetExportThreadCount();
+		const Clock::time_point exportStart = Clock::now();
+		Clock::time_point phaseStart = exportStart;
+
+		// Save all dirty chunks first
+		SaveDirtyChunks();
+
+		// Also gather objects for all loaded chunks
+		for (auto& [key, chunk] : m_Chunks)
+		{
+			GatherObjectsForChunk(chunk.get());
+		}
+
+		auto& assets = Onyx::Application::GetInstance().GetAssetManager();
+
+		// Create output directories
+		char mapDirBuf[64];
+		snprintf(mapDirBuf, sizeof(mapDirBuf), "maps/%03u", mapId);
+		const std::string mapRelative = mapDirBuf;
+		std::string runtimeChunksDir = outputDir + "/" + mapRelative + "/chunks";
+		std::string modelsDir = outputDir + "/models";
+		std::string materialsDir = outputDir + "/materials";
+
+		fs::create_directories(runtimeChunksDir);
+		fs::create_directories(modelsDir);
+		fs::create_directories(materialsDir);
+
+		// Collect unique model paths across all chunks
+		std::unordered_set<std::string> uniqueModels;
+		for (const auto& [key, chunk] : m_Chunks)
+		{
+			for (const auto& obj : chunk->GetObjects())
+			{
+				if (!obj.modelPath.empty())
+				{
+					uniqueModels.insert(obj.modelPath);
+				}
+			}
+		}
+
+		// Also collect from editor world if available
+		if (m_EditorWorld)
+		{
+			for (const auto& obj : m_EditorWorld->GetStaticObjects())
+			{
+				if (!obj->GetModelPath().empty())
+				{
+					uniqueModels.insert(obj->GetModelPath());
+				}
+			}
+		}
+
+		// Sorted, so phases add to the server terrain and the manifest in
+		// the same order every run
+		std::vector<std::string> modelPaths(uniqueModels.begin(), uniqueModels.end());
+		std::sort(modelPaths.begin(), modelPaths.end());
+
+		// Check for duplicate omdl names (different source paths → same stem)
+		std::unordered_map<std::string, std::string> omdlNameToSource; // omdlName → first source path
+		for (const std::string& modelPath : modelPaths)
+		{
+			std::string omdlName = ModelPathToOmdlName(modelPath);
+			auto it = omdlNameToSource.find(omdlName);
+			if (it != omdlNameToSource.end() && it->second != modelPath)
+			{
+				result.errors.push_back("Duplicate model name '" + omdlName +
+										"' from:\n  " + it->second + "\n  " + modelPath);
+			}
+			else
+			{
+				omdlNameToSource[omdlName] = modelPath;
+			}
+		}
+		if (!result.errors.empty())
+		{
+			result.timings.totalMs = MillisecondsSince(exportStart);
+			return result;
+		}
+
+		MMO::ExportManifest manifest;
+		const std::string manifestPath = outputDir + "/" + MMO::ExportManifest::FILE_NAME;
+		manifest.Load(manifestPath);
+
+		// Editor-assigned materials. The AssetManager is main-thread only, so
+		// their texture paths are looked up here and exported with the rest.
 		std::unordered_set<std::string> exportedMaterialIds;
 		for (const auto& [key, chunk] : m_Chunks)
 		{
@@ -1459,158 +1950,340 @@ namespace Editor3D {
 			}
 		}
 
+		struct MaterialTexture
+		{
+			std::string src;
+			std::string materialId;
+			Onyx::TextureUsage usage;
+		};
+		std::vector<MaterialTexture> materialTextures;
 		for (const std::string& matId : exportedMaterialIds)
 		{
 			const Onyx::Material* mat = assets.GetMaterial(matId);
 			if (!mat)
 				continue;
 
-			std::string matDir = materialsDir + "/" + matId;
-			std::string matRelative = "materials/" + matId + "/";
-
-			auto copyMatTexture = [&](const std::string& srcPath) {
-				if (srcPath.empty())
-					return;
-				std::string texName = std::filesystem::path(srcPath).filename().string();
-				std::string destPath = matDir + "/" + texName;
-				if (CopyFileIfNeeded(srcPath, destPath))
-				{
-					result.texturesCopied++;
-				}
-			};
-
-			copyMatTexture(mat->albedoPath);
-			copyMatTexture(mat->normalPath);
-			copyMatTexture(mat->rmaPath);
+			if (!mat->albedoPath.empty())
+				materialTextures.push_back({mat->albedoPath, matId, Onyx::TextureUsage::Color});
+			if (!mat->normalPath.empty())
+				materialTextures.push_back({mat->normalPath, matId, Onyx::TextureUsage::Normal});
+			if (!mat->rmaPath.empty())
+				materialTextures.push_back({mat->rmaPath, matId, Onyx::TextureUsage::Data});
 			result.materialsExported++;
 		}
 
-		// Export chunks as runtime .chunk files
-		// We need to iterate ALL known chunk files, not just currently loaded chunks
-		for (int32_t chunkKey : m_KnownChunkFiles)
+		result.timings.prepareMs = MillisecondsSince(phaseStart);
+
+		// Models, first pass: hash every model and parse the changed ones
+		phaseStart = Clock::now();
+		std::vector<ModelExportJob> modelJobs(modelPaths.size());
+		for (size_t i = 0; i < modelPaths.size(); i++)
 		{
-			// Decode chunk key
-			int32_t cx = static_cast<int16_t>(chunkKey >> 16);
-			int32_t cz = static_cast<int16_t>(chunkKey & 0xFFFF);
+			modelJobs[i].modelPath = modelPaths[i];
+			modelJobs[i].omdlName = ModelPathToOmdlName(modelPaths[i]);
+		}
+		ParallelFor(modelJobs.size(), [&](size_t i) {
+			ModelExportJob& job = modelJobs[i];
+			job.key = HashModelInputs(job.modelPath);
+			const auto* entry = manifest.FindUpToDate(job.GetManifestName(), job.key, outputDir);
+			job.upToDate = entry && ReadModelEntryFields(entry->fields, job);
+			if (!job.upToDate && ParseExportModel(job))
+			{
+				ResolveModelTextures(job);
+			}
+		});
+		result.timings.modelsMs = MillisecondsSince(phaseStart);
+
+		// Textures of models and materials, each source once per directory
+		phaseStart = Clock::now();
+		std::vector<TextureExportJob> textureJobs;
+		std::unordered_map<std::string, size_t> textureJobLookup; // destRelative + src → job
+		auto addTexture = [&](const std::string& src, const std::string& dirName, Onyx::TextureUsage usage) {
+			const std::string destRelative = "materials/" + dirName + "/";
+			auto [it, inserted] = textureJobLookup.try_emplace(destRelative + src, textureJobs.size());
+			if (inserted)
+			{
+				TextureExportJob& job = textureJobs.emplace_back();
+				job.src = src;
+				job.destDir = materialsDir + "/" + dirName;
+				job.destRelative = destRelative;
+				job.usage = usage;
+			}
+			return it->second;
+		};
+		for (ModelExportJob& job : modelJobs)
+		{
+			const std::string modelStem = fs::path(job.modelPath).stem().string();
+			for (ModelTextureSlot& slot : job.slots)
+			{
+				slot.texture =
+					addTexture(slot.src, modelStem, slot.normal ? Onyx::TextureUsage::Normal : Onyx::TextureUsage::Color);
+			}
+		}
+		for (const MaterialTexture& texture : materialTextures)
+		{
+			addTexture(texture.src, texture.materialId, texture.usage);
+		}
 
-			// Load chunk if not already loaded
-			auto it = m_Chunks.find(chunkKey);
-			WorldChunk* chunk = nullptr;
-			bool temporarilyLoaded = false;
+		ParallelFor(textureJobs.size(), [&](size_t i) { ExportTexture(textureJobs[i], manifest, outputDir); });
 
-			if (it != m_Chunks.end())
+		for (const TextureExportJob& job : textureJobs)
+		{
+			if (!job.error.empty())
 			{
-				chunk = it->second.get();
+				result.errors.push_back(job.error);
+				continue;
 			}
-			else
+			if (job.skipped)
 			{
-				// Temporarily load chunk from disk for export
-				auto tempChunk = std::make_unique<WorldChunk>(cx, cz);
-				std::string srcPath = GetChunkFilePath(cx, cz);
-				tempChunk->Load(srcPath);
-				chunk = tempChunk.get();
-				temporarilyLoaded = true;
-				// Store temporarily for iteration, will clean up after
-				m_Chunks[chunkKey] = std::move(tempChunk);
+				result.texturesSkipped++;
+				continue;
 			}
-
-			if (!chunk)
+			if (job.name.empty())
 				continue;
 
-			// Build ChunkFileData for runtime
-			MMO::ChunkFileData fileData;
-			fileData.mapId = mapId;
+			result.texturesCopied += job.copied ? 1 : 0;
+			result.texturesCompressed += job.compressed ? 1 : 0;
+			result.textureRawBytes += job.rawBytes;
+			result.textureCompressedBytes += job.compressedBytes;
+			manifest.Set(job.GetManifestName(), {job.key, job.GetOutput(), {}});
+		}
+		result.timings.texturesMs = MillisecondsSince(phaseStart);
+
+		// Models, second pass: write the .omdl files. An unchanged model is
+		// still rewritten if one of its textures now has another output name.
+		phaseStart = Clock::now();
+		ParallelFor(modelJobs.size(), [&](size_t i) {
+			ModelExportJob& job = modelJobs[i];
+			if (!job.error.empty())
+				return;
+			if (job.upToDate)
+			{
+				bool texturesMatch = true;
+				for (const ModelTextureSlot& slot : job.slots)
+				{
+					texturesMatch = texturesMatch && slot.output == textureJobs[slot.texture].GetOutput();
+				}
+				if (texturesMatch)
+				{
+					job.skipped = true;
+					return;
+				}
+				if (!ParseExportModel(job))
+					return;
+			}
+			WriteExportModel(job, textureJobs, modelsDir);
+		});
 
-			// Terrain
-			if (chunk->GetTerrain())
+		std::unordered_map<std::string, std::string> modelPathRemap; // original → relative .omdl path
+		std::unordered_map<std::string, std::pair<glm::vec3, glm::vec3>> modelBounds; // original → local AABB
+		for (const ModelExportJob& job : modelJobs)
+		{
+			if (!job.error.empty())
 			{
-				fileData.terrain = chunk->GetTerrain()->GetData();
+				result.errors.push_back(job.error);
+				continue;
 			}
 
-			// Lights — convert EditorLight to ChunkLightData
-			for (const auto& el : chunk->GetLights())
+			const std::string omdlRelative = "models/" + job.omdlName;
+			modelPathRemap[job.modelPath] = omdlRelative;
+			modelBounds[job.modelPath] = {job.boundsMin, job.boundsMax};
+			if (job.skipped)
 			{
-				MMO::ChunkLightData ld;
-				ld.type = static_cast<uint8_t>(el.type);
-				ld.position[0] = el.position.x;
-				ld.position[1] = el.position.y;
-				ld.position[2] = el.position.z;
-				ld.direction[0] = el.direction.x;
-				ld.direction[1] = el.direction.y;
-				ld.direction[2] = el.direction.z;
-				ld.color[0] = el.color.x;
-				ld.color[1] = el.color.y;
-				ld.color[2] = el.color.z;
-				ld.intensity = el.intensity;
-				ld.range = el.range;
-				ld.innerAngle = el.innerAngle;
-				ld.outerAngle = el.outerAngle;
-				ld.castShadows = el.castShadows;
-				fileData.lights.push_back(ld);
+				result.modelsSkipped++;
+				continue;
 			}
+			result.modelsExported++;
+			result.meshLodsBaked += job.lodsBaked;
+			manifest.Set(job.GetManifestName(), {job.key, omdlRelative, MakeModelEntryFields(job)});
+		}
+		result.timings.modelsMs += MillisecondsSince(phaseStart);
 
-			// Objects — convert ChunkObject to ChunkObjectData with remapped model paths
-			for (const auto& co : chunk->GetObjects())
-			{
-				MMO::ChunkObjectData od;
+		// Chunks: every known chunk file, loaded or not. Loaded chunks are
+		// keyed by the runtime data built from them, unloaded ones by their
+		// editor file and the model remap.
+		phaseStart = Clock::now();
+		std::vector<int32_t> chunkKeys(m_KnownChunkFiles.begin(), m_KnownChunkFiles.end());
+		std::sort(chunkKeys.begin(), chunkKeys.end());
 
-				// Remap model path to .omdl relative path
-				auto remapIt = modelPathRemap.find(co.modelPath);
-				if (remapIt != modelPathRemap.end())
-				{
-					od.modelPath = remapIt->second;
-				}
-				else
-				{
-					od.modelPath = co.modelPath; // fallback to original
-				}
+		std::vector<ChunkExportJob> chunkJobs(chunkKeys.size());
+		for (size_t i = 0; i < chunkKeys.size(); i++)
+		{
+			// Decode chunk key
+			chunkJobs[i].chunkX = static_cast<int16_t>(chunkKeys[i] >> 16);
+			chunkJobs[i].chunkZ = static_cast<int16_t>(chunkKeys[i] & 0xFFFF);
+			auto it = m_Chunks.find(chunkKeys[i]);
+			chunkJobs[i].loaded = it != m_Chunks.end() ? it->second.get() : nullptr;
+		}
 
-				od.position[0] = co.position.x;
-				od.position[1] = co.position.y;
-				od.position[2] = co.position.z;
+		MMO::ContentHasher remapHasher(EXPORT_VERSION);
+		for (const std::string& modelPath : modelPaths)
+		{
+			auto it = modelPathRemap.find(modelPath);
+			remapHasher.Add(modelPath);
+			remapHasher.Add(it != modelPathRemap.end() ? std::string_view(it->second) : std::string_view());
+		}
+		const uint64_t remapKey = remapHasher.Get();
 
-				// Convert quaternion to euler angles (radians)
-				glm::vec3 euler = glm::eulerAngles(co.rotation);
-				od.rotation[0] = euler.x;
-				od.rotation[1] = euler.y;
-				od.rotation[2] = euler.z;
+		ParallelFor(chunkJobs.size(), [&](size_t i) {
+			ChunkExportJob& job = chunkJobs[i];
+			MMO::ContentHasher hasher(EXPORT_VERSION);
+			hasher.AddValue(mapId);
+			hasher.AddValue(job.loaded != nullptr);
+			if (job.loaded)
+			{
+				BuildChunkFileData(*job.loaded, mapId, modelPathRemap, modelBounds, job);
+				HashChunkFileData(hasher, job.fileData);
+				HashTerrainObstacles(hasher, job.obstacles);
+			}
+			else
+			{
+				hasher.AddValue(remapKey);
+				hasher.AddFile(GetChunkFilePath(job.chunkX, job.chunkZ));
+			}
+			job.key = hasher.Get();
+		});
+
+		// The server terrain depends on every chunk and on the bounds of the
+		// models their mesh colliders use
+		MMO::ContentHasher terrainHasher(EXPORT_VERSION);
+		terrainHasher.AddValue(mapId);
+		for (size_t i = 0; i < chunkJobs.size(); i++)
+		{
+			terrainHasher.AddValue(chunkKeys[i]);
+			terrainHasher.AddValue(chunkJobs[i].key);
+		}
+		for (const std::string& modelPath : modelPaths)
+		{
+			auto it = modelBounds.find(modelPath);
+			if (it == modelBounds.end())
+				continue;
+			terrainHasher.Add(modelPath);
+			terrainHasher.AddValue(it->second.first);
+			terrainHasher.AddValue(it->second.second);
+		}
+		const uint64_t terrainKey = terrainHasher.Get();
+		const std::string terrainName = "terrain:" + mapRelative;
+		std::optional<MMO::ExportManifest::Entry> terrainEntry;
+		if (const auto* entry = manifest.FindUpToDate(terrainName, terrainKey, outputDir))
+		{
+			terrainEntry = *entry;
+		}
+		const bool bakeTerrain = !terrainEntry;
 
-				od.scale[0] = co.scale;
-				od.scale[1] = co.scale;
-				od.scale[2] = co.scale;
+		// Unchanged chunks are only read when the server terrain is rebaked
+		ParallelFor(chunkJobs.size(), [&](size_t i) {
+			ChunkExportJob& job = chunkJobs[i];
+			const std::string output = job.GetOutput(mapId);
+			const bool upToDate = manifest.FindUpToDate("chunk:" + output, job.key, outputDir) != nullptr;
+			if (upToDate && !bakeTerrain)
+			{
+				job.skipped = true;
+				return;
+			}
 
-				od.flags = co.castsShadow ? 1u : 0u;
-				od.materialId = co.materialId;
+			if (!job.built)
+			{
+				// Loaded here rather than into m_Chunks, which the workers share
+				WorldChunk chunk(job.chunkX, job.chunkZ);
+				chunk.Load(GetChunkFilePath(job.chunkX, job.chunkZ));
+				BuildChunkFileData(chunk, mapId, modelPathRemap, modelBounds, job);
+			}
 
-				fileData.objects.push_back(od);
+			if (upToDate)
+			{
+				job.skipped = true;
+			}
+			else if (MMO::WriteChunkFile(outputDir + "/" + output, job.fileData, job.chunkX, job.chunkZ))
+			{
+				job.written = true;
+			}
+			else
+			{
+				job.error = "Failed to write chunk: " + outputDir + "/" + output;
 			}
 
-			// Write runtime chunk
-			char chunkFilename[64];
-			snprintf(chunkFilename, sizeof(chunkFilename), "%s/chunk_%d_%d.chunk",
-					 runtimeChunksDir.c_str(), cx, cz);
+			if (!bakeTerrain)
+			{
+				job.fileData = {};
+			}
+		});
 
-			if (MMO::WriteChunkFile(chunkFilename, fileData, cx, cz))
+		for (const ChunkExportJob& job : chunkJobs)
+		{
+			if (!job.error.empty())
+			{
+				result.errors.push_back(job.error);
+			}
+			else if (job.skipped)
+			{
+				result.chunksSkipped++;
+			}
+			else if (job.written)
 			{
 				result.chunksExported++;
+				const std::string output = job.GetOutput(mapId);
+				manifest.Set("chunk:" + output, {job.key, output, {}});
 			}
-			else
+		}
+		result.timings.chunksMs = MillisecondsSince(phaseStart);
+
+		// Bake the server's height/walkability file next to the chunks. It is
+		// server-only, so the pack below leaves it out.
+		phaseStart = Clock::now();
+		if (bakeTerrain)
+		{
+			MMO::ServerTerrainBuilder serverTerrainBuilder;
+			for (const ChunkExportJob& job : chunkJobs)
 			{
-				result.errors.push_back("Failed to write chunk: " + std::string(chunkFilename));
+				if (!job.built)
+					continue;
+				serverTerrainBuilder.AddChunk(job.fileData.terrain);
+				for (const MMO::TerrainObstacle& obstacle : job.obstacles)
+				{
+					serverTerrainBuilder.AddObstacle(obstacle);
+				}
 			}
 
-			// Clean up temporarily loaded chunk
-			if (temporarilyLoaded)
+			if (!serverTerrainBuilder.IsEmpty())
 			{
-				m_Chunks.erase(chunkKey);
+				MMO::ServerTerrain serverTerrain;
+				serverTerrainBuilder.Build(serverTerrain);
+
+				const std::string terrainRelative = mapRelative + "/terrain.strn";
+				const std::string terrainPath = outputDir + "/" + terrainRelative;
+				if (serverTerrain.Save(terrainPath))
+				{
+					result.serverTerrainChunks = static_cast<int>(serverTerrain.GetChunkCount());
+					result.walkableCells = serverTerrain.CountWalkableCells();
+					result.blockedCells = serverTerrain.CountBlockedCells();
+					manifest.Set(terrainName, {terrainKey, terrainRelative,
+											   {std::to_string(result.serverTerrainChunks),
+												std::to_string(result.walkableCells),
+												std::to_string(result.blockedCells)}});
+				}
+				else
+				{
+					result.errors.push_back("Failed to write server terrain: " + terrainPath);
+				}
 			}
 		}
+		else
+		{
+			result.serverTerrainSkipped = true;
+			result.serverTerrainChunks = static_cast<int>(ParseManifestCount(*terrainEntry, 0));
+			result.walkableCells = static_cast<uint32_t>(ParseManifestCount(*terrainEntry, 1));
+			result.blockedCells = static_cast<uint32_t>(ParseManifestCount(*terrainEntry, 2));
+		}
+		chunkJobs.clear();
+		result.timings.serverTerrainMs = MillisecondsSince(phaseStart);
 
 		// Emit migration.sql for DB-bound entities (creature spawns + player spawns).
+		phaseStart = Clock::now();
 		if (m_EditorWorld)
 		{
-			std::filesystem::path sqlPath = std::filesystem::path(outputDir) / "migration.sql";
-			std::filesystem::create_directories(sqlPath.parent_path());
+			fs::path sqlPath = fs::path(outputDir) / "migration.sql";
+			fs::create_directories(sqlPath.parent_path());
 
 			std::ofstream sqlOut(sqlPath, std::ios::binary | std::ios::trunc);
 			if (!sqlOut.is_open())
@@ -1645,7 +2318,58 @@ namespace Editor3D {
 				MMO::MigrationSqlWriter::EmitPlayerCreateInfo(playerPtrs, mapId, sqlOut);
 			}
 		}
+		result.timings.migrationMs = MillisecondsSince(phaseStart);
+
+		// Pack the whole runtime tree (every exported map, not just this one)
+		// into data.opak; the client mounts it and stops touching loose files.
+		// migration.sql is for the database, terrain.strn for the server and
+		// export.manifest for the next export, not the client. Repacked only
+		// when a file it takes was added, removed or rewritten.
+		phaseStart = Clock::now();
+		if (result.errors.empty())
+		{
+			const std::vector<std::string> skipExtensions = {".opak", ".tmp", ".sql", ".strn", ".manifest"};
+			const uint64_t packKey = HashPackInputs(outputDir, skipExtensions);
+			if (const auto* entry = manifest.FindUpToDate("pack", packKey, outputDir))
+			{
+				result.packSkipped = true;
+				result.filesPacked = static_cast<int>(ParseManifestCount(*entry, 0));
+				result.packBytes = ParseManifestCount(*entry, 1);
+				result.packRawBytes = ParseManifestCount(*entry, 2);
+			}
+			else
+			{
+				MMO::PackWriter packWriter;
+				packWriter.AddDirectory(outputDir, skipExtensions);
+
+				MMO::PackWriteStats packStats;
+				std::string packError;
+				const std::string packPath = outputDir + "/data.opak";
+				if (packWriter.Write(packPath, {}, &packStats, &packError))
+				{
+					result.filesPacked = static_cast<int>(packStats.files);
+					result.packBytes = packStats.packBytes;
+					result.packRawBytes = packStats.rawBytes;
+					manifest.Set("pack", {packKey, "data.opak",
+										  {std::to_string(result.filesPacked), std::to_string(result.packBytes),
+										   std::to_string(result.packRawBytes)}});
+				}
+				else
+				{
+					result.errors.push_back("Failed to write " + packPath + ": " + packError);
+				}
+			}
+		}
+		result.timings.packMs = MillisecondsSince(phaseStart);
 
+		// Whatever was rebuilt is recorded even when the export failed, so a
+		// retry only redoes the rest
+		if (!manifest.Save(manifestPath))
+		{
+			result.errors.push_back("Failed to write " + manifestPath);
+		}
+
+		result.timings.totalMs = MillisecondsSince(exportStart);
 		result.success = result.errors.empty();
 		return result;
 	}
@@ -1694,6 +2418,18 @@ namespace Editor3D {
 				}
 			}
 		}
+
+		if (m_EditRecorder.IsActive())
+		{
+			for (int cz = minCZ; cz <= maxCZ; cz++)
+			{
+				for (int cx = minCX; cx <= maxCX; cx++)
+				{
+					m_EditRecorder.Capture(MakeChunkKey(cx, cz), m_Chunks[MakeChunkKey(cx, cz)]->GetTerrain()->GetData());
+				}
+			}
+		}
+
 		return true;
 	}
 
@@ -1976,56 +2712,77 @@ namespace Editor3D {
 		}
 	}
 
-	void EditorWorldSystem::ApplyBrush(float worldX, float worldZ, float radius,
-									   std::function<void(TerrainChunk*, int localX, int localZ, float weight)> operation)
-	{
-
-		int minChunkX = WorldToChunkX(worldX - radius);
-		int maxChunkX = WorldToChunkX(worldX + radius);
-		int minChunkZ = WorldToChunkZ(worldZ - radius);
-		int maxChunkZ = WorldToChunkZ(worldZ + radius);
-
-		if (!EnsureChunksReady(minChunkX, maxChunkX, minChunkZ, maxChunkZ))
-			return;
+	// ---- Sculpt Brushes ----
+	//
+	// Raise, lower, flatten and smooth work on the global grid of heightmap
+	// vertices, one per metre: the ones strictly inside the brush are
+	// gathered into one rectangle, run through the row kernels and written
+	// back to every chunk holding them, so both copies of a shared border
+	// vertex get the same value. Chunks then patch just the mesh vertices
+	// the rectangle reaches.
 
-		for (int cz = minChunkZ; cz <= maxChunkZ; cz++)
-		{
-			for (int cx = minChunkX; cx <= maxChunkX; cx++)
-			{
-				int32_t key = MakeChunkKey(cx, cz);
-				TerrainChunk* terrain = m_Chunks[key]->GetTerrain();
+	static_assert(CHUNK_SIZE == CHUNK_RESOLUTION - 1, "Sculpt brushes assume 1 m between heightmap vertices");
 
-				float chunkWorldX = cx * CHUNK_SIZE;
-				float chunkWorldZ = cz * CHUNK_SIZE;
+	static int FloorDiv(int value, int divisor)
+	{
+		int quotient = value / divisor;
+		return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+	}
 
-				for (int lz = 0; lz < CHUNK_RESOLUTION; lz++)
-				{
-					for (int lx = 0; lx < CHUNK_RESOLUTION; lx++)
-					{
-						float vertWorldX = chunkWorldX + (lx / (float)(CHUNK_RESOLUTION - 1)) * CHUNK_SIZE;
-						float vertWorldZ = chunkWorldZ + (lz / (float)(CHUNK_RESOLUTION - 1)) * CHUNK_SIZE;
+	bool EditorWorldSystem::BeginBrush(float worldX, float worldZ, float radius, MMO::TerrainVertexRect& rect)
+	{
+		rect.minX = static_cast<int>(std::floor(worldX - radius)) + 1;
+		rect.minZ = static_cast<int>(std::floor(worldZ - radius)) + 1;
+		rect.maxX = static_cast<int>(std::ceil(worldX + radius)) - 1;
+		rect.maxZ = static_cast<int>(std::ceil(worldZ + radius)) - 1;
+		if (rect.IsEmpty())
+			return false;
 
-						float dx = vertWorldX - worldX;
-						float dz = vertWorldZ - worldZ;
-						float dist = std::sqrt(dx * dx + dz * dz);
+		// Every chunk holding one of them; a vertex on a border belongs to two
+		const int quads = CHUNK_RESOLUTION - 1;
+		return EnsureChunksReady(FloorDiv(rect.minX - 1, quads), FloorDiv(rect.maxX, quads),
+								 FloorDiv(rect.minZ - 1, quads), FloorDiv(rect.maxZ, quads));
+	}
 
-						operation(terrain, lx, lz, dist);
-					}
-				}
+	void EditorWorldSystem::GatherHeights(const MMO::TerrainVertexRect& rect, std::vector<float>& out) const
+	{
+		GatherHeightRegion(rect, [this](int32_t cx, int32_t cz) -> const MMO::TerrainChunkData* {
+			auto it = m_Chunks.find(MakeChunkKey(cx, cz));
+			return it != m_Chunks.end() ? &it->second->GetTerrain()->GetData() : nullptr;
+		}, out);
+	}
 
-				terrain->GetDataMutable().CalculateBounds();
-			}
-		}
+	void EditorWorldSystem::ScatterHeights(const MMO::TerrainVertexRect& rect, const std::vector<float>& heights,
+										   bool createHeightmaps)
+	{
+		ScatterHeightRegion(rect, heights, [this, createHeightmaps](int32_t cx, int32_t cz) -> MMO::TerrainChunkData* {
+			auto it = m_Chunks.find(MakeChunkKey(cx, cz));
+			if (it == m_Chunks.end())
+				return nullptr;
+			TerrainChunk* terrain = it->second->GetTerrain();
+			if (!terrain->GetData().heightmap.empty())
+				return &terrain->GetHeightsMutable();
+			if (!createHeightmaps)
+				return nullptr;
+
+			// No mesh to patch yet: build it whole
+			TerrainChunkData& data = terrain->GetDataMutable();
+			data.heightmap.resize(CHUNK_HEIGHTMAP_SIZE, 0.0f);
+			return &data;
+		});
 
-		StitchEdges(minChunkX, maxChunkX, minChunkZ, maxChunkZ);
+		MarkHeightsDirty(rect);
+	}
 
-		for (int cz = minChunkZ; cz <= maxChunkZ; cz++)
-		{
-			for (int cx = minChunkX; cx <= maxChunkX; cx++)
+	void EditorWorldSystem::MarkHeightsDirty(const MMO::TerrainVertexRect& rect)
+	{
+		ForEachChunkReachedByHeights(rect, [this](int32_t cx, int32_t cz, const MMO::TerrainVertexRect& local) {
+			auto it = m_Chunks.find(MakeChunkKey(cx, cz));
+			if (it != m_Chunks.end() && it->second->GetTerrain()->GetState() == ChunkState::Active)
 			{
-				DirtyNeighborChunks(cx, cz);
+				it->second->GetTerrain()->MarkHeightsDirty(local);
 			}
-		}
+		});
 	}
 
 	// ---- Model Pre-loading ----
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "WorldChunk.h"
+#include "Terrain/TerrainEditDelta.h"
 #include <Onyx.h>
 #include <atomic>
 #include <condition_variable>
@@ -64,13 +65,46 @@ namespace Editor3D {
 						   const std::string& materialId, float strength);
 		void SetHole(float worldX, float worldZ, bool isHole);
 
-		// Runtime export
+		// Runtime export. Incremental: <outputDir>/export.manifest records the
+		// inputs of every output, and only changed outputs are rebuilt, so the
+		// exported/compressed counts below cover this run's work.
 		struct ExportResult
 		{
 			int modelsExported = 0;
+			int meshLodsBaked = 0; // Simplified levels across all exported meshes
 			int chunksExported = 0;
-			int texturesCopied = 0;
+			int texturesCopied = 0;				 // Shipped as-is (not decodable)
+			int texturesCompressed = 0;			 // Transcoded to BCn .dds this run
+			uint64_t textureRawBytes = 0;		 // Their RGBA8 top levels
+			uint64_t textureCompressedBytes = 0; // Their .dds files, mips included
 			int materialsExported = 0;
+			int filesPacked = 0;	   // Into <outputDir>/data.opak
+			uint64_t packBytes = 0;	   // Size of data.opak
+			uint64_t packRawBytes = 0; // Its files before compression
+			int serverTerrainChunks = 0; // In maps/<id>/terrain.strn
+			uint32_t walkableCells = 0;	  // 1x1 m cells the server lets players walk on
+			uint32_t blockedCells = 0;	  // Cells whose objects also block sight
+
+			// Items export.manifest showed were up to date and left alone
+			int modelsSkipped = 0;
+			int texturesSkipped = 0;
+			int chunksSkipped = 0;
+			bool serverTerrainSkipped = false;
+			bool packSkipped = false;
+
+			int workerThreads = 0; // Used by the parallel phases
+			struct PhaseTimings
+			{
+				double prepareMs = 0.0; // Saving chunks, collecting models, reading the manifest
+				double modelsMs = 0.0;
+				double texturesMs = 0.0;
+				double chunksMs = 0.0;
+				double serverTerrainMs = 0.0;
+				double migrationMs = 0.0;
+				double packMs = 0.0;
+				double totalMs = 0.0;
+			} timings;
+
 			std::vector<std::string> errors;
 			bool success = false;
 		};
@@ -84,8 +118,10 @@ namespace Editor3D {
 		void SaveChunk(int32_t chunkX, int32_t chunkZ);
 
 		// Edit undo/redo
-		void BeginEdit(float worldX, float worldZ, float radius);
-		void EndEdit();
+		// Everything the terrain tools change between BeginEdit and EndEdit
+		// becomes one TerrainEditCommand in the CommandHistory
+		void BeginEdit();
+		void EndEdit(const std::string& description = "Terrain Edit");
 		void CancelEdit();
 
 		// Settings
@@ -147,11 +183,7 @@ namespace Editor3D {
 		std::string m_DefaultMaterialIds[MAX_TERRAIN_LAYERS];
 		std::unordered_map<std::string, int> m_MaterialLayerMap;
 
-		struct EditSnapshot
-		{
-			std::vector<std::pair<int32_t, TerrainChunkData>> chunkSnapshots;
-		};
-		std::unique_ptr<EditSnapshot> m_CurrentEditSnapshot;
+		TerrainEditRecorder m_EditRecorder;
 
 		static int32_t MakeChunkKey(int32_t x, int32_t z)
 		{
@@ -174,8 +206,14 @@ namespace Editor3D {
 		WorldChunk* GetOrCreateChunk(int32_t chunkX, int32_t chunkZ);
 		bool EnsureChunksReady(int minCX, int maxCX, int minCZ, int maxCZ);
 
-		void ApplyBrush(float worldX, float worldZ, float radius,
-						std::function<void(TerrainChunk*, int localX, int localZ, float weight)> operation);
+		// Sculpt brushes: the global heightmap vertices (1 m apart) strictly
+		// inside the brush, gathered from and scattered back to their chunks
+		bool BeginBrush(float worldX, float worldZ, float radius, MMO::TerrainVertexRect& rect);
+		void GatherHeights(const MMO::TerrainVertexRect& rect, std::vector<float>& out) const;
+		void ScatterHeights(const MMO::TerrainVertexRect& rect, const std::vector<float>& heights, bool createHeightmaps);
+		void MarkHeightsDirty(const MMO::TerrainVertexRect& rect);
+		std::vector<float> m_BrushHeights; // Reused between dabs
+		std::vector<float> m_BrushScratch;
 
 		// Object ↔ Chunk bridge
 		void GatherObjectsForChunk(WorldChunk* chunk);
@@ -76,11 +76,10 @@ namespace MMO {
 
 		while (m_Running)
 		{
-			// Poll network events
-			std::vector<NetworkEvent> events;
-			m_Network.Poll(events, 10);
+			// Poll network events (m_Events keeps its capacity between polls)
+			m_Network.Poll(m_Events, 10);
 
-			for (const auto& event : events)
+			for (const auto& event : m_Events)
 			{
 				switch (event.type)
 				{
@@ -100,10 +99,11 @@ namespace MMO {
 					break;
 
 				case NetworkEventType::DATA_RECEIVED:
-					ProcessPacket(event.peerId, event.data);
+					ProcessPacket(event.peerId, event.data, event.size);
 					break;
 				}
 			}
+			ReleaseEvents(m_Events);
 
 			// Periodic cleanup (every 5 minutes)
 			auto now = std::chrono::steady_clock::now();
@@ -113,6 +113,8 @@ namespace MMO {
 				lastCleanup = now;
 			}
 		}
+
+		Database::PrintStatementStats(m_Database.GetStatementStats());
 	}
 
 	void LoginServer::Stop()
@@ -126,12 +128,12 @@ namespace MMO {
 	// PACKET PROCESSING
 	// ============================================================
 
-	void LoginServer::ProcessPacket(uint32_t peerId, const std::vector<uint8_t>& data)
+	void LoginServer::ProcessPacket(uint32_t peerId, const uint8_t* data, size_t size)
 	{
-		if (data.empty())
+		if (size == 0)
 			return;
 
-		ReadBuffer buf(data);
+		ReadBuffer buf(data, size);
 		auto packetType = static_cast<LoginPacketType>(buf.ReadU8());
 
 		switch (packetType)
@@ -48,7 +48,7 @@ namespace MMO {
 		void SetWorldServerInfo(const std::string& host, uint16_t port);
 
 	private:
-		void ProcessPacket(uint32_t peerId, const std::vector<uint8_t>& data);
+		void ProcessPacket(uint32_t peerId, const uint8_t* data, size_t size);
 
 		void HandleRegisterRequest(uint32_t peerId, ReadBuffer& buf);
 		void HandleLoginRequest(uint32_t peerId, ReadBuffer& buf);
@@ -68,6 +68,7 @@ namespace MMO {
 		bool ValidateCharacterName(const std::string& name);
 
 		NetworkServer m_Network;
+		std::vector<NetworkEvent> m_Events; // Reused across polls
 		Database m_Database;
 		std::unordered_map<uint32_t, LoginClient> m_Clients;
 
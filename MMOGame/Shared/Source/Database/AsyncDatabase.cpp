@@ -0,0 +1,229 @@
+#include "AsyncDatabase.h"
+#include <iostream>
+
+namespace MMO {
+
+	AsyncDatabase::~AsyncDatabase()
+	{
+		Shutdown();
+	}
+
+	bool AsyncDatabase::Connect(const std::string& connectionString, size_t connectionCount)
+	{
+		if (connectionCount == 0)
+			connectionCount = 1;
+
+		for (size_t i = 0; i < connectionCount; i++)
+		{
+			auto worker = std::make_unique<Worker>();
+			if (!worker->db.Connect(connectionString))
+			{
+				std::cerr << "AsyncDatabase: connection " << i << " failed" << '\n';
+				Shutdown();
+				return false;
+			}
+			m_Workers.push_back(std::move(worker));
+		}
+
+		for (auto& worker : m_Workers)
+		{
+			Worker* w = worker.get();
+			w->thread = std::thread([this, w]() { WorkerThread(*w); });
+		}
+
+		std::cout << "AsyncDatabase: " << m_Workers.size() << " connection(s)" << '\n';
+		return true;
+	}
+
+	void AsyncDatabase::Shutdown()
+	{
+		for (auto& worker : m_Workers)
+		{
+			{
+				std::lock_guard<std::mutex> lock(worker->mutex);
+				worker->stopping = true;
+			}
+			worker->wake.notify_one();
+		}
+
+		for (auto& worker : m_Workers)
+		{
+			if (worker->thread.joinable())
+			{
+				worker->thread.join();
+			}
+			worker->db.Disconnect();
+		}
+		m_Workers.clear();
+	}
+
+	void AsyncDatabase::Execute(uint64_t key, Job job)
+	{
+		if (m_Workers.empty())
+			return;
+
+		Worker& worker = WorkerFor(key);
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.jobs.push_back(std::move(job));
+		}
+		worker.wake.notify_one();
+	}
+
+	void AsyncDatabase::SaveCharacter(CharacterSaveData data)
+	{
+		if (m_Workers.empty())
+			return;
+
+		CharacterId characterId = data.character.id;
+		Worker& worker = WorkerFor(characterId);
+		bool coalesced;
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			auto [it, inserted] = worker.pendingSaves.insert_or_assign(characterId, std::move(data));
+			coalesced = !inserted;
+
+			// One queued write per character; it picks up whichever snapshot is
+			// newest when it runs
+			if (inserted)
+			{
+				Worker* w = &worker;
+				worker.jobs.push_back([this, w, characterId](Database&) { WriteSave(*w, characterId); });
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_StatsMutex);
+			m_Stats.savesQueued++;
+		}
+
+		if (!coalesced)
+		{
+			worker.wake.notify_one();
+		}
+	}
+
+	void AsyncDatabase::WriteSave(Worker& worker, CharacterId characterId)
+	{
+		CharacterSaveData data;
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			auto it = worker.pendingSaves.find(characterId);
+			if (it == worker.pendingSaves.end())
+				return;
+			data = std::move(it->second);
+			worker.pendingSaves.erase(it);
+		}
+
+		worker.db.SaveCharacterFull(data.character,
+									data.hasCooldowns ? &data.cooldowns : nullptr,
+									data.hasInventory ? &data.inventory : nullptr,
+									data.hasEquipment ? &data.equipment : nullptr);
+
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		m_Stats.savesWritten++;
+	}
+
+	void AsyncDatabase::WorkerThread(Worker& worker)
+	{
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(worker.mutex);
+				worker.wake.wait(lock, [&worker]() { return worker.stopping || !worker.jobs.empty(); });
+
+				// Stopping still drains the queue so no save is lost
+				if (worker.jobs.empty())
+					return;
+
+				job = std::move(worker.jobs.front());
+				worker.jobs.pop_front();
+			}
+
+			auto start = std::chrono::steady_clock::now();
+
+			int64_t latencyMs = m_ArtificialLatencyMs.load(std::memory_order_relaxed);
+			if (latencyMs > 0)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs));
+			}
+
+			try
+			{
+				job(worker.db);
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "AsyncDatabase job failed: " << e.what() << '\n';
+			}
+
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			std::lock_guard<std::mutex> lock(m_StatsMutex);
+			m_Stats.jobsRun++;
+			m_Stats.busyMs += ms;
+		}
+	}
+
+	void AsyncDatabase::PostCompletion(std::function<void()> completion)
+	{
+		std::lock_guard<std::mutex> lock(m_CompletionMutex);
+		m_Completions.push_back(std::move(completion));
+	}
+
+	size_t AsyncDatabase::ProcessCompletions()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_CompletionMutex);
+			if (m_Completions.empty())
+				return 0;
+			m_RunningCompletions.swap(m_Completions);
+		}
+
+		// Run outside the lock: completions may queue more work
+		size_t count = m_RunningCompletions.size();
+		for (auto& completion : m_RunningCompletions)
+		{
+			completion();
+		}
+		m_RunningCompletions.clear();
+
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		m_Stats.completions += count;
+		return count;
+	}
+
+	size_t AsyncDatabase::GetQueueDepth()
+	{
+		size_t depth = 0;
+		for (auto& worker : m_Workers)
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			depth += worker->jobs.size();
+		}
+		return depth;
+	}
+
+	AsyncDatabaseStats AsyncDatabase::GetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		return m_Stats;
+	}
+
+	void AsyncDatabase::ResetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		m_Stats = AsyncDatabaseStats();
+	}
+
+	Database::StatementStatsMap AsyncDatabase::GetStatementStats() const
+	{
+		Database::StatementStatsMap merged;
+		for (const auto& worker : m_Workers)
+		{
+			Database::MergeStatementStats(merged, worker->db.GetStatementStats());
+		}
+		return merged;
+	}
+
+} // namespace MMO
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Database.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace MMO {
+
+	// ============================================================
+	// CHARACTER SAVE DATA
+	// ============================================================
+
+	// Everything one character save writes, captured on the game thread so the
+	// DB worker never touches live entities
+	struct CharacterSaveData
+	{
+		CharacterData character;
+		std::vector<CooldownData> cooldowns;
+		std::vector<Database::InventoryItemData> inventory;
+		std::vector<Database::EquipmentItemData> equipment;
+		bool hasCooldowns = false;
+		bool hasInventory = false;
+		bool hasEquipment = false;
+	};
+
+	// Counters since the last ResetStats()
+	struct AsyncDatabaseStats
+	{
+		uint64_t jobsRun = 0;
+		uint64_t savesQueued = 0;
+		uint64_t savesWritten = 0; // savesQueued - savesWritten were coalesced
+		uint64_t completions = 0;
+		double busyMs = 0.0;	   // Worker time spent inside jobs
+	};
+
+	// ============================================================
+	// ASYNC DATABASE
+	// ============================================================
+	//
+	// Runs Database calls on worker threads, each owning its own connection.
+	// Work is routed by key (normally the CharacterId): one key always lands on
+	// the same worker, so a character's saves and loads run in the order they
+	// were issued. Results come back as completions that the owning thread
+	// runs from ProcessCompletions(), never from a worker.
+	//
+	// SaveCharacter() is write-behind: if a save for the same character is
+	// still queued, the newer snapshot replaces it and only one write happens.
+
+	class AsyncDatabase
+	{
+	public:
+		using Job = std::function<void(Database&)>;
+
+		AsyncDatabase() = default;
+		~AsyncDatabase();
+
+		AsyncDatabase(const AsyncDatabase&) = delete;
+		AsyncDatabase& operator=(const AsyncDatabase&) = delete;
+
+		bool Connect(const std::string& connectionString, size_t connectionCount = 1);
+		// Drains every queued job and save, then closes the connections
+		void Shutdown();
+		bool IsConnected() const { return !m_Workers.empty(); }
+
+		// Fire-and-forget
+		void Execute(uint64_t key, Job job);
+
+		// Runs query(Database&) on a worker; done(result) runs from ProcessCompletions()
+		template <typename QueryFn, typename DoneFn>
+		void Query(uint64_t key, QueryFn query, DoneFn done)
+		{
+			using Result = std::invoke_result_t<QueryFn&, Database&>;
+			Execute(key, [this, query = std::move(query), done = std::move(done)](Database& db) mutable {
+				auto result = std::make_shared<Result>(query(db));
+				PostCompletion([done = std::move(done), result]() mutable { done(std::move(*result)); });
+			});
+		}
+
+		void SaveCharacter(CharacterSaveData data);
+
+		// Runs completions delivered since the last call; returns how many ran
+		size_t ProcessCompletions();
+
+		// Test hook: every job sleeps this long first, emulating a slow server
+		void SetArtificialLatency(std::chrono::milliseconds latency) { m_ArtificialLatencyMs = latency.count(); }
+
+		size_t GetQueueDepth();
+		AsyncDatabaseStats GetStats();
+		void ResetStats();
+		// Prepared-statement timings merged across every worker connection
+		Database::StatementStatsMap GetStatementStats() const;
+
+	private:
+		struct Worker
+		{
+			Database db;
+			std::thread thread;
+			std::mutex mutex;
+			std::condition_variable wake;
+			std::deque<Job> jobs;
+			std::unordered_map<CharacterId, CharacterSaveData> pendingSaves;
+			bool stopping = false;
+		};
+
+		Worker& WorkerFor(uint64_t key) { return *m_Workers[key % m_Workers.size()]; }
+		void WorkerThread(Worker& worker);
+		void WriteSave(Worker& worker, CharacterId characterId);
+		void PostCompletion(std::function<void()> completion);
+
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+
+		std::mutex m_CompletionMutex;
+		std::vector<std::function<void()>> m_Completions;
+		std::vector<std::function<void()>> m_RunningCompletions; // Swapped in by ProcessCompletions
+
+		std::mutex m_StatsMutex;
+		AsyncDatabaseStats m_Stats;
+
+		std::atomic<int64_t> m_ArtificialLatencyMs{0};
+	};
+
+} // namespace MMO
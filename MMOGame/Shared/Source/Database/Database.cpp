@@ -1,9 +1,151 @@
 #include "Database.h"
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 namespace MMO {
 
+	namespace {
+
+		// ============================================================
+		// PREPARED STATEMENTS
+		// ============================================================
+		//
+		// Everything that runs after startup. Map/template loaders run once at
+		// boot and keep plain exec.
+
+		namespace Stmt {
+			constexpr const char* GET_ACCOUNT_BY_USERNAME = "get_account_by_username";
+			constexpr const char* CREATE_ACCOUNT = "create_account";
+			constexpr const char* UPDATE_LAST_LOGIN = "update_last_login";
+			constexpr const char* GET_CHARACTERS_BY_ACCOUNT = "get_characters_by_account";
+			constexpr const char* GET_CHARACTER_BY_ID = "get_character_by_id";
+			constexpr const char* CREATE_CHARACTER = "create_character";
+			constexpr const char* DELETE_CHARACTER = "delete_character";
+			constexpr const char* SAVE_CHARACTER = "save_character";
+			constexpr const char* IS_NAME_TAKEN = "is_name_taken";
+			constexpr const char* GET_COOLDOWNS = "get_cooldowns";
+			constexpr const char* DELETE_COOLDOWNS = "delete_cooldowns";
+			constexpr const char* INSERT_COOLDOWNS = "insert_cooldowns";
+			constexpr const char* CREATE_SESSION = "create_session";
+			constexpr const char* VALIDATE_SESSION = "validate_session";
+			constexpr const char* DELETE_SESSION = "delete_session";
+			constexpr const char* DELETE_EXPIRED_SESSIONS = "delete_expired_sessions";
+			constexpr const char* GET_INVENTORY = "get_inventory";
+			constexpr const char* DELETE_INVENTORY = "delete_inventory";
+			constexpr const char* INSERT_INVENTORY = "insert_inventory";
+			constexpr const char* GET_EQUIPMENT = "get_equipment";
+			constexpr const char* DELETE_EQUIPMENT = "delete_equipment";
+			constexpr const char* INSERT_EQUIPMENT = "insert_equipment";
+		} // namespace Stmt
+
+		struct PreparedStatement
+		{
+			const char* name;
+			const char* sql;
+		};
+
+		constexpr const char* CHARACTER_COLUMNS =
+			"SELECT id, account_id, name, race, class, level, experience, money, "
+			"zone_id::INTEGER, "
+			"position_x, position_y, position_z, orientation, "
+			"max_health, max_mana, current_health, current_mana, "
+			"EXTRACT(EPOCH FROM COALESCE(last_played, created_at))::BIGINT "
+			"FROM characters ";
+
+		const std::vector<PreparedStatement>& GetPreparedStatements()
+		{
+			static const std::string charactersByAccount = std::string(CHARACTER_COLUMNS) +
+														   "WHERE account_id = $1 AND is_deleted = FALSE "
+														   "ORDER BY last_played DESC NULLS LAST";
+			static const std::string characterById = std::string(CHARACTER_COLUMNS) +
+													 "WHERE id = $1 AND is_deleted = FALSE";
+
+			static const std::vector<PreparedStatement> statements = {
+				{Stmt::GET_ACCOUNT_BY_USERNAME,
+				 "SELECT id, username, password_hash, salt, is_banned, COALESCE(ban_reason, '') "
+				 "FROM accounts WHERE username = $1"},
+				{Stmt::CREATE_ACCOUNT,
+				 "INSERT INTO accounts (username, email, password_hash, salt) VALUES ($1, $2, $3, $4)"},
+				{Stmt::UPDATE_LAST_LOGIN,
+				 "UPDATE accounts SET last_login = CURRENT_TIMESTAMP WHERE id = $1"},
+				{Stmt::GET_CHARACTERS_BY_ACCOUNT, charactersByAccount.c_str()},
+				{Stmt::GET_CHARACTER_BY_ID, characterById.c_str()},
+				{Stmt::CREATE_CHARACTER,
+				 "INSERT INTO characters (account_id, name, race, class, zone_id, "
+				 "position_x, position_y, position_z, orientation, "
+				 "max_health, max_mana, current_health, current_mana) "
+				 "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, $10, $11) RETURNING id"},
+				{Stmt::DELETE_CHARACTER,
+				 "UPDATE characters SET is_deleted = TRUE WHERE id = $1"},
+				{Stmt::SAVE_CHARACTER,
+				 "UPDATE characters SET "
+				 "level = $2, experience = $3, money = $4, zone_id = $5, "
+				 "position_x = $6, position_y = $7, position_z = $8, orientation = $9, "
+				 "max_health = $10, max_mana = $11, current_health = $12, current_mana = $13, "
+				 "last_played = CURRENT_TIMESTAMP "
+				 "WHERE id = $1"},
+				{Stmt::IS_NAME_TAKEN,
+				 "SELECT 1 FROM characters WHERE LOWER(name) = LOWER($1) AND is_deleted = FALSE"},
+				{Stmt::GET_COOLDOWNS,
+				 "SELECT ability_id, remaining FROM character_cooldowns WHERE character_id = $1"},
+				{Stmt::DELETE_COOLDOWNS,
+				 "DELETE FROM character_cooldowns WHERE character_id = $1"},
+				{Stmt::INSERT_COOLDOWNS,
+				 "INSERT INTO character_cooldowns (character_id, ability_id, remaining) "
+				 "SELECT $1, a, r FROM unnest($2::int[], $3::real[]) AS u(a, r)"},
+				{Stmt::CREATE_SESSION,
+				 "INSERT INTO sessions (token, account_id, ip_address, expires_at) "
+				 "VALUES ($1, $2, $3, CURRENT_TIMESTAMP + INTERVAL '1 hour' * $4)"},
+				{Stmt::VALIDATE_SESSION,
+				 "SELECT account_id FROM sessions WHERE token = $1 AND expires_at > CURRENT_TIMESTAMP"},
+				{Stmt::DELETE_SESSION,
+				 "DELETE FROM sessions WHERE token = $1"},
+				{Stmt::DELETE_EXPIRED_SESSIONS,
+				 "DELETE FROM sessions WHERE expires_at < CURRENT_TIMESTAMP"},
+				{Stmt::GET_INVENTORY,
+				 "SELECT instance_id, template_id, slot, stack_count "
+				 "FROM character_inventory WHERE character_id = $1 ORDER BY slot"},
+				{Stmt::DELETE_INVENTORY,
+				 "DELETE FROM character_inventory WHERE character_id = $1"},
+				{Stmt::INSERT_INVENTORY,
+				 "INSERT INTO character_inventory (instance_id, character_id, slot, template_id, stack_count) "
+				 "SELECT i, $1, s, t, c FROM unnest($2::bigint[], $3::smallint[], $4::int[], $5::int[]) AS u(i, s, t, c)"},
+				{Stmt::GET_EQUIPMENT,
+				 "SELECT instance_id, template_id, slot "
+				 "FROM character_equipment WHERE character_id = $1 ORDER BY slot"},
+				{Stmt::DELETE_EQUIPMENT,
+				 "DELETE FROM character_equipment WHERE character_id = $1"},
+				{Stmt::INSERT_EQUIPMENT,
+				 "INSERT INTO character_equipment (instance_id, character_id, slot, template_id) "
+				 "SELECT i, $1, s, t FROM unnest($2::bigint[], $3::smallint[], $4::int[]) AS u(i, s, t)"},
+			};
+			return statements;
+		}
+
+		// Postgres array literal ("{1,2,3}") of one numeric field per item, so a
+		// whole batch binds as a single parameter of a prepared unnest() insert
+		template <typename T, typename Field>
+		std::string ToArrayLiteral(const std::vector<T>& items, Field&& field)
+		{
+			std::string out = "{";
+			char buf[32];
+			for (size_t i = 0; i < items.size(); i++)
+			{
+				if (i > 0)
+					out += ',';
+				auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), field(items[i]));
+				out.append(buf, end);
+			}
+			out += '}';
+			return out;
+		}
+
+	} // namespace
+
 	Database::Database() = default;
 	Database::~Database() = default;
 
@@ -15,6 +157,7 @@ namespace MMO {
 			if (m_Connection->is_open())
 			{
 				std::cout << "Connected to database: " << m_Connection->dbname() << '\n';
+				PrepareStatements();
 				return true;
 			}
 		}
@@ -31,6 +174,115 @@ namespace MMO {
 		{
 			m_Connection.reset();
 		}
+		m_Prepared.clear();
+	}
+
+	void Database::PrepareStatements()
+	{
+		// On a fresh database the tables don't exist until MigrationRunner has
+		// run; statements that fail here are prepared again on first use
+		size_t prepared = 0;
+		for (const PreparedStatement& statement : GetPreparedStatements())
+		{
+			if (TryPrepare(statement.name))
+				prepared++;
+		}
+		std::cout << "Prepared " << prepared << "/" << GetPreparedStatements().size() << " statements" << '\n';
+	}
+
+	bool Database::TryPrepare(const char* name)
+	{
+		for (const PreparedStatement& statement : GetPreparedStatements())
+		{
+			if (std::string_view(statement.name) != name)
+				continue;
+
+			try
+			{
+				m_Connection->prepare(statement.name, statement.sql);
+				m_Prepared.insert(statement.name);
+				return true;
+			}
+			catch (const std::exception&)
+			{
+				return false;
+			}
+		}
+		return false;
+	}
+
+	template <typename... Args>
+	pqxx::result Database::Exec(pqxx::work& txn, const char* statement, Args&&... args)
+	{
+		if (!m_Prepared.count(statement) && !TryPrepare(statement))
+		{
+			throw std::runtime_error(std::string("statement not prepared: ") + statement);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		pqxx::result result = txn.exec_prepared(statement, std::forward<Args>(args)...);
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		StatementStats& stats = m_StatementStats[statement];
+		stats.calls++;
+		stats.totalMs += ms;
+		stats.maxMs = std::max(stats.maxMs, ms);
+		return result;
+	}
+
+	// ============================================================
+	// STATEMENT STATS
+	// ============================================================
+
+	Database::StatementStatsMap Database::GetStatementStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		return m_StatementStats;
+	}
+
+	void Database::ResetStatementStats()
+	{
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		m_StatementStats.clear();
+	}
+
+	void Database::MergeStatementStats(StatementStatsMap& into, const StatementStatsMap& from)
+	{
+		for (const auto& [name, stats] : from)
+		{
+			StatementStats& merged = into[name];
+			merged.calls += stats.calls;
+			merged.totalMs += stats.totalMs;
+			merged.maxMs = std::max(merged.maxMs, stats.maxMs);
+		}
+	}
+
+	void Database::PrintStatementStats(const StatementStatsMap& stats)
+	{
+		if (stats.empty())
+			return;
+
+		// Most expensive first
+		std::vector<std::pair<std::string, StatementStats>> sorted(stats.begin(), stats.end());
+		std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+			return a.second.totalMs > b.second.totalMs;
+		});
+
+		// Formatted locally so std::cout's flags stay as other log lines expect
+		std::ostringstream out;
+		out << "[DB] " << std::left << std::setw(28) << "statement" << std::right
+			<< std::setw(10) << "calls" << std::setw(12) << "total ms"
+			<< std::setw(10) << "avg ms" << std::setw(10) << "max ms" << '\n';
+		out << std::fixed << std::setprecision(2);
+		for (const auto& [name, s] : sorted)
+		{
+			out << "[DB] " << std::left << std::setw(28) << name << std::right
+				<< std::setw(10) << s.calls << std::setw(12) << s.totalMs
+				<< std::setw(10) << s.totalMs / static_cast<double>(s.calls)
+				<< std::setw(10) << s.maxMs << '\n';
+		}
+		std::cout << out.str();
 	}
 
 	// ============================================================
@@ -42,10 +294,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT id, username, password_hash, salt, is_banned, COALESCE(ban_reason, '') "
-				"FROM accounts WHERE username = $1",
-				username);
+			pqxx::result result = Exec(txn, Stmt::GET_ACCOUNT_BY_USERNAME, username);
 			txn.commit();
 
 			if (result.empty())
@@ -75,9 +324,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec_params(
-				"INSERT INTO accounts (username, email, password_hash, salt) VALUES ($1, $2, $3, $4)",
-				username, email, passwordHash, salt);
+			Exec(txn, Stmt::CREATE_ACCOUNT, username, email, passwordHash, salt);
 			txn.commit();
 			return true;
 		}
@@ -93,9 +340,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec_params(
-				"UPDATE accounts SET last_login = CURRENT_TIMESTAMP WHERE id = $1",
-				accountId);
+			Exec(txn, Stmt::UPDATE_LAST_LOGIN, accountId);
 			txn.commit();
 			return true;
 		}
@@ -116,15 +361,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT id, account_id, name, race, class, level, experience, money, "
-				"zone_id::INTEGER, "
-				"position_x, position_y, position_z, orientation, "
-				"max_health, max_mana, current_health, current_mana, "
-				"EXTRACT(EPOCH FROM COALESCE(last_played, created_at))::BIGINT "
-				"FROM characters WHERE account_id = $1 AND is_deleted = FALSE "
-				"ORDER BY last_played DESC NULLS LAST",
-				accountId);
+			pqxx::result result = Exec(txn, Stmt::GET_CHARACTERS_BY_ACCOUNT, accountId);
 			txn.commit();
 
 			for (const auto& row : result)
@@ -163,14 +400,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT id, account_id, name, race, class, level, experience, money, "
-				"zone_id::INTEGER, "
-				"position_x, position_y, position_z, orientation, "
-				"max_health, max_mana, current_health, current_mana, "
-				"EXTRACT(EPOCH FROM COALESCE(last_played, created_at))::BIGINT "
-				"FROM characters WHERE id = $1 AND is_deleted = FALSE",
-				characterId);
+			pqxx::result result = Exec(txn, Stmt::GET_CHARACTER_BY_ID, characterId);
 			txn.commit();
 
 			if (result.empty())
@@ -216,12 +446,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"INSERT INTO characters (account_id, name, race, class, zone_id, "
-				"position_x, position_y, position_z, orientation, "
-				"max_health, max_mana, current_health, current_mana) "
-				"VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, $10, $11) RETURNING id",
-				accountId, name,
+			pqxx::result result = Exec(txn, Stmt::CREATE_CHARACTER, accountId, name,
 				static_cast<int>(characterRace), static_cast<int>(characterClass),
 				std::to_string(mapId), posX, posY, posZ, orientation, maxHealth, maxMana);
 			txn.commit();
@@ -244,9 +469,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec_params(
-				"UPDATE characters SET is_deleted = TRUE WHERE id = $1",
-				characterId);
+			Exec(txn, Stmt::DELETE_CHARACTER, characterId);
 			txn.commit();
 			return true;
 		}
@@ -262,18 +485,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec_params(
-				"UPDATE characters SET "
-				"level = $2, experience = $3, money = $4, zone_id = $5, "
-				"position_x = $6, position_y = $7, position_z = $8, orientation = $9, "
-				"max_health = $10, max_mana = $11, current_health = $12, current_mana = $13, "
-				"last_played = CURRENT_TIMESTAMP "
-				"WHERE id = $1",
-				character.id, character.level, character.experience, character.money,
-				std::to_string(character.mapId),
-				character.positionX, character.positionY, character.positionZ, character.orientation,
-				character.maxHealth, character.maxMana,
-				character.currentHealth, character.currentMana);
+			WriteCharacter(txn, character);
 			txn.commit();
 			return true;
 		}
@@ -284,14 +496,47 @@ namespace MMO {
 		}
 	}
 
+	bool Database::SaveCharacterFull(const CharacterData& character,
+									 const std::vector<CooldownData>* cooldowns,
+									 const std::vector<InventoryItemData>* inventory,
+									 const std::vector<EquipmentItemData>* equipment)
+	{
+		try
+		{
+			pqxx::work txn(*m_Connection);
+			WriteCharacter(txn, character);
+			if (cooldowns)
+				WriteCooldowns(txn, character.id, *cooldowns);
+			if (inventory)
+				WriteInventory(txn, character.id, *inventory);
+			if (equipment)
+				WriteEquipment(txn, character.id, *equipment);
+			txn.commit();
+			return true;
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "SaveCharacterFull failed: " << e.what() << '\n';
+			return false;
+		}
+	}
+
+	void Database::WriteCharacter(pqxx::work& txn, const CharacterData& character)
+	{
+		Exec(txn, Stmt::SAVE_CHARACTER,
+			 character.id, character.level, character.experience, character.money,
+			 std::to_string(character.mapId),
+			 character.positionX, character.positionY, character.positionZ, character.orientation,
+			 character.maxHealth, character.maxMana,
+			 character.currentHealth, character.currentMana);
+	}
+
 	bool Database::IsNameTaken(const std::string& name)
 	{
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT 1 FROM characters WHERE LOWER(name) = LOWER($1) AND is_deleted = FALSE",
-				name);
+			pqxx::result result = Exec(txn, Stmt::IS_NAME_TAKEN, name);
 			txn.commit();
 			return !result.empty();
 		}
@@ -312,9 +557,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT ability_id, remaining FROM character_cooldowns WHERE character_id = $1",
-				characterId);
+			pqxx::result result = Exec(txn, Stmt::GET_COOLDOWNS, characterId);
 			txn.commit();
 
 			for (const auto& row : result)
@@ -337,22 +580,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-
-			// Clear existing cooldowns
-			txn.exec_params("DELETE FROM character_cooldowns WHERE character_id = $1", characterId);
-
-			// Insert new cooldowns
-			for (const auto& cd : cooldowns)
-			{
-				if (cd.remaining > 0.0f)
-				{
-					txn.exec_params(
-						"INSERT INTO character_cooldowns (character_id, ability_id, remaining) "
-						"VALUES ($1, $2, $3)",
-						characterId, static_cast<int>(cd.abilityId), cd.remaining);
-				}
-			}
-
+			WriteCooldowns(txn, characterId, cooldowns);
 			txn.commit();
 			return true;
 		}
@@ -363,12 +591,32 @@ namespace MMO {
 		}
 	}
 
+	void Database::WriteCooldowns(pqxx::work& txn, CharacterId characterId, const std::vector<CooldownData>& cooldowns)
+	{
+		// Replace the whole set: one DELETE + one multi-row INSERT
+		Exec(txn, Stmt::DELETE_COOLDOWNS, characterId);
+
+		std::vector<CooldownData> active;
+		active.reserve(cooldowns.size());
+		for (const auto& cd : cooldowns)
+		{
+			if (cd.remaining > 0.0f)
+				active.push_back(cd);
+		}
+		if (active.empty())
+			return;
+
+		Exec(txn, Stmt::INSERT_COOLDOWNS, characterId,
+			 ToArrayLiteral(active, [](const CooldownData& cd) { return static_cast<int>(cd.abilityId); }),
+			 ToArrayLiteral(active, [](const CooldownData& cd) { return cd.remaining; }));
+	}
+
 	bool Database::ClearCooldowns(CharacterId characterId)
 	{
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec_params("DELETE FROM character_cooldowns WHERE character_id = $1", characterId);
+			Exec(txn, Stmt::DELETE_COOLDOWNS, characterId);
 			txn.commit();
 			return true;
 		}
@@ -389,10 +637,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec_params(
-				"INSERT INTO sessions (token, account_id, ip_address, expires_at) "
-				"VALUES ($1, $2, $3, CURRENT_TIMESTAMP + INTERVAL '1 hour' * $4)",
-				token, accountId, ipAddress, expiresInHours);
+			Exec(txn, Stmt::CREATE_SESSION, token, accountId, ipAddress, expiresInHours);
 			txn.commit();
 			return true;
 		}
@@ -408,9 +653,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT account_id FROM sessions WHERE token = $1 AND expires_at > CURRENT_TIMESTAMP",
-				token);
+			pqxx::result result = Exec(txn, Stmt::VALIDATE_SESSION, token);
 			txn.commit();
 
 			if (!result.empty())
@@ -431,7 +674,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec_params("DELETE FROM sessions WHERE token = $1", token);
+			Exec(txn, Stmt::DELETE_SESSION, token);
 			txn.commit();
 			return true;
 		}
@@ -447,7 +690,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			txn.exec("DELETE FROM sessions WHERE expires_at < CURRENT_TIMESTAMP");
+			Exec(txn, Stmt::DELETE_EXPIRED_SESSIONS);
 			txn.commit();
 		}
 		catch (const std::exception& e)
@@ -466,10 +709,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT instance_id, template_id, slot, stack_count "
-				"FROM character_inventory WHERE character_id = $1 ORDER BY slot",
-				characterId);
+			pqxx::result result = Exec(txn, Stmt::GET_INVENTORY, characterId);
 			txn.commit();
 
 			for (const auto& row : result)
@@ -495,10 +735,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-			pqxx::result result = txn.exec_params(
-				"SELECT instance_id, template_id, slot "
-				"FROM character_equipment WHERE character_id = $1 ORDER BY slot",
-				characterId);
+			pqxx::result result = Exec(txn, Stmt::GET_EQUIPMENT, characterId);
 			txn.commit();
 
 			for (const auto& row : result)
@@ -522,20 +759,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-
-			// Clear existing inventory
-			txn.exec_params("DELETE FROM character_inventory WHERE character_id = $1", characterId);
-
-			// Insert new items
-			for (const auto& item : items)
-			{
-				txn.exec_params(
-					"INSERT INTO character_inventory (instance_id, character_id, slot, template_id, stack_count) "
-					"VALUES ($1, $2, $3, $4, $5)",
-					item.instanceId, characterId, static_cast<int>(item.slot),
-					static_cast<int>(item.templateId), item.stackCount);
-			}
-
+			WriteInventory(txn, characterId, items);
 			txn.commit();
 			return true;
 		}
@@ -551,20 +775,7 @@ namespace MMO {
 		try
 		{
 			pqxx::work txn(*m_Connection);
-
-			// Clear existing equipment
-			txn.exec_params("DELETE FROM character_equipment WHERE character_id = $1", characterId);
-
-			// Insert new items
-			for (const auto& item : items)
-			{
-				txn.exec_params(
-					"INSERT INTO character_equipment (instance_id, character_id, slot, template_id) "
-					"VALUES ($1, $2, $3, $4)",
-					item.instanceId, characterId, static_cast<int>(item.slot),
-					static_cast<int>(item.templateId));
-			}
-
+			WriteEquipment(txn, characterId, items);
 			txn.commit();
 			return true;
 		}
@@ -574,6 +785,34 @@ namespace MMO {
 			return false;
 		}
 	}
+
+	// Delete + re-insert rather than ON CONFLICT: items move between slots, and
+	// UNIQUE(character_id, slot) would trip a row-by-row upsert mid-swap
+	void Database::WriteInventory(pqxx::work& txn, CharacterId characterId, const std::vector<InventoryItemData>& items)
+	{
+		Exec(txn, Stmt::DELETE_INVENTORY, characterId);
+		if (items.empty())
+			return;
+
+		Exec(txn, Stmt::INSERT_INVENTORY, characterId,
+			 ToArrayLiteral(items, [](const InventoryItemData& item) { return item.instanceId; }),
+			 ToArrayLiteral(items, [](const InventoryItemData& item) { return static_cast<int>(item.slot); }),
+			 ToArrayLiteral(items, [](const InventoryItemData& item) { return static_cast<int>(item.templateId); }),
+			 ToArrayLiteral(items, [](const InventoryItemData& item) { return item.stackCount; }));
+	}
+
+	void Database::WriteEquipment(pqxx::work& txn, CharacterId characterId, const std::vector<EquipmentItemData>& items)
+	{
+		Exec(txn, Stmt::DELETE_EQUIPMENT, characterId);
+		if (items.empty())
+			return;
+
+		Exec(txn, Stmt::INSERT_EQUIPMENT, characterId,
+			 ToArrayLiteral(items, [](const EquipmentItemData& item) { return item.instanceId; }),
+			 ToArrayLiteral(items, [](const EquipmentItemData& item) { return static_cast<int>(item.slot); }),
+			 ToArrayLiteral(items, [](const EquipmentItemData& item) { return static_cast<int>(item.templateId); }));
+	}
+
 	// ============================================================
 	// MAP LOADING OPERATIONS (Server reads from DB)
 	// ============================================================
@@ -2,9 +2,12 @@
 
 #include "../Types/Types.h"
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <pqxx/pqxx>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace MMO {
@@ -97,6 +100,14 @@ namespace MMO {
 		float remaining;
 	};
 
+	// Per prepared statement, since the last ResetStatementStats()
+	struct StatementStats
+	{
+		uint64_t calls = 0;
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+	};
+
 	// ============================================================
 	// DATABASE WRAPPER
 	// ============================================================
@@ -113,6 +124,13 @@ namespace MMO {
 
 		pqxx::connection& GetRawConnection() { return *m_Connection; }
 
+		// Timing and call counts for every prepared statement executed
+		using StatementStatsMap = std::unordered_map<std::string, StatementStats>;
+		StatementStatsMap GetStatementStats() const;
+		void ResetStatementStats();
+		static void MergeStatementStats(StatementStatsMap& into, const StatementStatsMap& from);
+		static void PrintStatementStats(const StatementStatsMap& stats);
+
 		// Account operations
 		std::optional<AccountData> GetAccountByUsername(const std::string& username);
 		bool CreateAccount(const std::string& username, const std::string& email,
@@ -181,8 +199,32 @@ namespace MMO {
 		bool SaveInventory(CharacterId characterId, const std::vector<InventoryItemData>& items);
 		bool SaveEquipment(CharacterId characterId, const std::vector<EquipmentItemData>& items);
 
+		// Character row plus whichever collections are given, in one transaction
+		bool SaveCharacterFull(const CharacterData& character,
+							   const std::vector<CooldownData>* cooldowns,
+							   const std::vector<InventoryItemData>* inventory,
+							   const std::vector<EquipmentItemData>* equipment);
+
 	private:
+		// Prepares every statement in the table; failures (e.g. before
+		// migrations) are retried on first use
+		void PrepareStatements();
+		bool TryPrepare(const char* name);
+
+		// exec_prepared + per-statement timing
+		template <typename... Args>
+		pqxx::result Exec(pqxx::work& txn, const char* statement, Args&&... args);
+
+		void WriteCharacter(pqxx::work& txn, const CharacterData& character);
+		void WriteCooldowns(pqxx::work& txn, CharacterId characterId, const std::vector<CooldownData>& cooldowns);
+		void WriteInventory(pqxx::work& txn, CharacterId characterId, const std::vector<InventoryItemData>& items);
+		void WriteEquipment(pqxx::work& txn, CharacterId characterId, const std::vector<EquipmentItemData>& items);
+
 		std::unique_ptr<pqxx::connection> m_Connection;
+		std::unordered_set<std::string> m_Prepared;
+
+		mutable std::mutex m_StatsMutex;
+		StatementStatsMap m_StatementStats;
 	};
 
 } // namespace MMO
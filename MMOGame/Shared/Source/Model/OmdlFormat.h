@@ -12,11 +12,14 @@ namespace MMO {
 	// GPU-ready binary: vertices in Onyx::MeshVertex layout (28 B = pos float3 +
 	// snorm16x2 oct-normal + half2 UV + snorm16x2 oct-tangent + snorm16x2 bitangent-sign),
 	// indices are uint32_t (or uint16_t when OMDL_FLAG_U16_INDICES is set in the header).
+	// Each mesh carries up to OMDL_MAX_LODS index ranges over its own vertices; the
+	// simplified ranges follow every mesh's LOD0 range in the index blob.
 	// Reader memory-maps the file and points the VBO at the vertex blob — no Assimp at runtime.
 
 	constexpr uint32_t OMDL_MAGIC = 0x4F4D444C; // "OMDL"
-	constexpr uint32_t OMDL_VERSION = 2;        // v2 = quantized 28 B vertex + flags
+	constexpr uint32_t OMDL_VERSION = 3;        // v3 = v2 (quantized 28 B vertex + flags) + per-mesh LOD table
 	constexpr uint32_t OMDL_VERTEX_BYTES = 28;  // sizeof(Onyx::MeshVertex)
+	constexpr uint32_t OMDL_MAX_LODS = 4;       // == Onyx::MAX_MESH_LODS
 
 	// flags bits
 	constexpr uint32_t OMDL_FLAG_U16_INDICES = 1u << 0; // index blob is uint16_t when totalVertices < 65536
@@ -33,6 +36,14 @@ namespace MMO {
 		float boundsMax[3] = {0, 0, 0};
 	};
 
+	// One level of detail: an index range drawn with the mesh's baseVertex
+	struct OmdlLod
+	{
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		float error = 0.0f; // Max deviation from LOD0, in model units
+	};
+
 	struct OmdlMeshInfo
 	{
 		uint32_t indexCount = 0;
@@ -42,6 +53,10 @@ namespace MMO {
 		float boundsMax[3] = {0, 0, 0};
 		std::string albedoPath;
 		std::string normalPath;
+		// lods[0] is the full mesh (firstIndex/indexCount) and is not stored;
+		// the file holds lodCount then lods[1..lodCount-1]
+		uint32_t lodCount = 1;
+		OmdlLod lods[OMDL_MAX_LODS];
 	};
 
 	// Writer-side: owns blob bytes via std::vector. Used by WriteOmdl + the editor exporter.
@@ -1,81 +1,39 @@
 #include "OmdlReader.h"
 
+#include "Pack/MappedFile.h"
+#include "Pack/PackFile.h"
+
 #include <cstring>
 #include <iostream>
 
-#if defined(_WIN32)
-	#define WIN32_LEAN_AND_MEAN
-	#ifndef NOMINMAX
-		#define NOMINMAX
-	#endif
-	#include <windows.h>
-#else
-	#include <fcntl.h>
-	#include <sys/mman.h>
-	#include <sys/stat.h>
-	#include <unistd.h>
-#endif
-
 namespace MMO {
 
-	// Owns a read-only file mapping. Destructor unmaps and closes.
+	// Keeps the bytes behind an OmdlMapped alive: a file mapping of a loose
+	// .omdl, or a view into a mounted pack.
 	class OmdlMapping
 	{
 	public:
 		const uint8_t* base = nullptr;
 		size_t size = 0;
-#if defined(_WIN32)
-		HANDLE hFile = INVALID_HANDLE_VALUE;
-		HANDLE hMap = nullptr;
-		void* view = nullptr;
-
-		~OmdlMapping()
-		{
-			if (view) UnmapViewOfFile(view);
-			if (hMap) CloseHandle(hMap);
-			if (hFile != INVALID_HANDLE_VALUE) CloseHandle(hFile);
-		}
 
 		bool Open(const std::string& path)
 		{
-			hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
-								OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
-			if (hFile == INVALID_HANDLE_VALUE) return false;
-			LARGE_INTEGER sz;
-			if (!GetFileSizeEx(hFile, &sz)) return false;
-			size = static_cast<size_t>(sz.QuadPart);
-			if (size == 0) return false;
-			hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
-			if (!hMap) return false;
-			view = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
-			if (!view) return false;
-			base = static_cast<const uint8_t*>(view);
+			if (PackFileSystem::Read(path, packView))
+			{
+				base = packView.data;
+				size = packView.size;
+				return size > 0;
+			}
+			if (!file.Open(path))
+				return false;
+			base = file.Data();
+			size = file.Size();
 			return true;
 		}
-#else
-		int fd = -1;
-		void* view = nullptr;
-
-		~OmdlMapping()
-		{
-			if (view && view != MAP_FAILED) munmap(view, size);
-			if (fd >= 0) close(fd);
-		}
 
-		bool Open(const std::string& path)
-		{
-			fd = ::open(path.c_str(), O_RDONLY);
-			if (fd < 0) return false;
-			struct stat st;
-			if (fstat(fd, &st) != 0) return false;
-			size = static_cast<size_t>(st.st_size);
-			if (size == 0) return false;
-			view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
-			if (view == MAP_FAILED) return false;
-			base = static_cast<const uint8_t*>(view);
-			return true;
-		}
-#endif
+	private:
+		MappedFile file;
+		PackView packView;
 	};
 
 	// OmdlMapped move ops + destructor — defined here because OmdlMapping
@@ -165,11 +123,34 @@ namespace MMO {
 				!c.Read(&mesh.boundsMin, sizeof(mesh.boundsMin)) ||
 				!c.Read(&mesh.boundsMax, sizeof(mesh.boundsMax)) ||
 				!ReadStringField(c, mesh.albedoPath) ||
-				!ReadStringField(c, mesh.normalPath))
+				!ReadStringField(c, mesh.normalPath) ||
+				!c.Read(&mesh.lodCount, sizeof(mesh.lodCount)))
 			{
 				std::cerr << "[OmdlReader] Truncated mesh-info in: " << path << "\n";
 				return false;
 			}
+			if (mesh.lodCount == 0 || mesh.lodCount > OMDL_MAX_LODS)
+			{
+				std::cerr << "[OmdlReader] Bad LOD count " << mesh.lodCount << " in: " << path << "\n";
+				return false;
+			}
+			mesh.lods[0] = {mesh.firstIndex, mesh.indexCount, 0.0f};
+			for (uint32_t l = 1; l < mesh.lodCount; l++)
+			{
+				auto& lod = mesh.lods[l];
+				if (!c.Read(&lod.firstIndex, sizeof(lod.firstIndex)) ||
+					!c.Read(&lod.indexCount, sizeof(lod.indexCount)) ||
+					!c.Read(&lod.error, sizeof(lod.error)))
+				{
+					std::cerr << "[OmdlReader] Truncated LOD table in: " << path << "\n";
+					return false;
+				}
+				if (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > out.header.totalIndices)
+				{
+					std::cerr << "[OmdlReader] LOD range out of bounds in: " << path << "\n";
+					return false;
+				}
+			}
 		}
 
 		// Vertex blob — zero-copy: just point into the mapping.
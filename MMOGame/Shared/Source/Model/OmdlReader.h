@@ -5,8 +5,9 @@
 
 namespace MMO {
 
-	// Memory-map an .omdl file and return zero-copy views into it. Pointers in
-	// OmdlMapped are valid until the returned object is destructed (which unmaps).
+	// Memory-map an .omdl file (or find it in a mounted pack) and return
+	// zero-copy views into it. Pointers in OmdlMapped are valid until the
+	// returned object is destructed (which unmaps).
 	// No GL — the caller calls glBufferData(...) directly from out.vertexData.
 	bool ReadOmdl(const std::string& path, OmdlMapped& out);
 
@@ -34,9 +34,17 @@ namespace MMO {
 			file.write(reinterpret_cast<const char*>(&mesh.boundsMax), sizeof(mesh.boundsMax));
 			WriteStringField(file, mesh.albedoPath);
 			WriteStringField(file, mesh.normalPath);
+			file.write(reinterpret_cast<const char*>(&mesh.lodCount), sizeof(mesh.lodCount));
+			for (uint32_t l = 1; l < mesh.lodCount; l++)
+			{
+				const auto& lod = mesh.lods[l];
+				file.write(reinterpret_cast<const char*>(&lod.firstIndex), sizeof(lod.firstIndex));
+				file.write(reinterpret_cast<const char*>(&lod.indexCount), sizeof(lod.indexCount));
+				file.write(reinterpret_cast<const char*>(&lod.error), sizeof(lod.error));
+			}
 		}
 
-		// Vertex blob (already in v2 28-byte layout)
+		// Vertex blob (28-byte MeshVertex layout)
 		if (!data.vertexBlob.empty())
 		{
 			file.write(reinterpret_cast<const char*>(data.vertexBlob.data()), data.vertexBlob.size());
@@ -119,6 +119,23 @@ namespace MMO {
 		WriteF32(value.z);
 	}
 
+	void WriteBuffer::WriteVarU32(uint32_t value)
+	{
+		EnsureCapacity(5);
+		while (value >= 0x80)
+		{
+			m_Data[m_WritePos++] = static_cast<uint8_t>(value | 0x80);
+			value >>= 7;
+		}
+		m_Data[m_WritePos++] = static_cast<uint8_t>(value);
+	}
+
+	void WriteBuffer::WriteVarI32(int32_t value)
+	{
+		uint32_t bits = static_cast<uint32_t>(value);
+		WriteVarU32((bits << 1) ^ (0u - (bits >> 31)));
+	}
+
 	void WriteBuffer::WriteBytes(const void* data, size_t size)
 	{
 		EnsureCapacity(size);
@@ -228,6 +245,27 @@ namespace MMO {
 		return ReadU8() != 0;
 	}
 
+	uint32_t ReadBuffer::ReadVarU32()
+	{
+		uint32_t value = 0;
+		for (int shift = 0; shift < 35; shift += 7)
+		{
+			uint8_t byte = ReadU8();
+			value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+			{
+				return value;
+			}
+		}
+		throw std::runtime_error("Malformed varint");
+	}
+
+	int32_t ReadBuffer::ReadVarI32()
+	{
+		uint32_t bits = ReadVarU32();
+		return static_cast<int32_t>((bits >> 1) ^ (0u - (bits & 1)));
+	}
+
 	std::string ReadBuffer::ReadString()
 	{
 		uint16_t length = ReadU16();
@@ -267,4 +305,15 @@ namespace MMO {
 		m_ReadPos += size;
 	}
 
+	ReadBuffer ReadBuffer::ReadSubBuffer(size_t size)
+	{
+		if (!HasData(size))
+		{
+			throw std::runtime_error("Buffer underflow reading sub-buffer");
+		}
+		ReadBuffer sub(m_Data + m_ReadPos, size);
+		m_ReadPos += size;
+		return sub;
+	}
+
 } // namespace MMO
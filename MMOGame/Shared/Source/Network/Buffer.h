@@ -30,6 +30,11 @@ namespace MMO {
 		void WriteF64(double value);
 		void WriteBool(bool value);
 
+		// Variable-length (LEB128, 1-5 bytes); signed values are zigzag-encoded
+		// so small negatives stay short
+		void WriteVarU32(uint32_t value);
+		void WriteVarI32(int32_t value);
+
 		// Complex types
 		void WriteString(const std::string& value);
 		void WriteVec2(const Vec2& value);
@@ -71,11 +76,16 @@ namespace MMO {
 		double ReadF64();
 		bool ReadBool();
 
+		// Variable-length (see WriteBuffer::WriteVarU32)
+		uint32_t ReadVarU32();
+		int32_t ReadVarI32();
+
 		// Complex types
 		std::string ReadString();
 		Vec2 ReadVec2();
 		Vec3 ReadVec3();
 		void ReadBytes(void* dest, size_t size);
+		ReadBuffer ReadSubBuffer(size_t size);
 
 		// Access
 		bool HasData(size_t bytes) const { return m_ReadPos + bytes <= m_Size; }
@@ -40,6 +40,22 @@ namespace MMO {
 		return s_Initialized;
 	}
 
+	// ============================================================
+	// NETWORK EVENTS
+	// ============================================================
+
+	void ReleaseEvents(std::vector<NetworkEvent>& events)
+	{
+		for (NetworkEvent& event : events)
+		{
+			if (event.packet)
+			{
+				enet_packet_destroy(event.packet);
+			}
+		}
+		events.clear();
+	}
+
 	// ============================================================
 	// NETWORK SERVER
 	// ============================================================
@@ -141,10 +157,10 @@ namespace MMO {
 				NetworkEvent netEvent;
 				netEvent.type = NetworkEventType::DATA_RECEIVED;
 				netEvent.peerId = peerId;
-				netEvent.data.assign(event.packet->data, event.packet->data + event.packet->dataLength);
+				netEvent.data = event.packet->data;
+				netEvent.size = event.packet->dataLength;
+				netEvent.packet = event.packet; // Released by ReleaseEvents
 				outEvents.push_back(netEvent);
-
-				enet_packet_destroy(event.packet);
 				break;
 			}
 
@@ -164,6 +180,9 @@ namespace MMO {
 		ENetPacket* packet = enet_packet_create(data, size,
 												reliable ? ENET_PACKET_FLAG_RELIABLE : 0);
 		enet_peer_send(it->second, 0, packet);
+
+		m_Stats.packetsSent++;
+		m_Stats.bytesSent += size;
 	}
 
 	void NetworkServer::Send(uint32_t peerId, const WriteBuffer& buffer, bool reliable)
@@ -171,6 +190,29 @@ namespace MMO {
 		Send(peerId, buffer.Data(), buffer.Size(), reliable);
 	}
 
+	void NetworkServer::Send(uint32_t peerId, ENetPacket* packet)
+	{
+		auto it = m_Peers.find(peerId);
+		if (it == m_Peers.end())
+		{
+			enet_packet_destroy(packet);
+			return;
+		}
+
+		m_Stats.packetsSent++;
+		m_Stats.bytesSent += packet->dataLength;
+
+		if (enet_peer_send(it->second, 0, packet) != 0)
+		{
+			enet_packet_destroy(packet);
+		}
+	}
+
+	ENetPacket* NetworkServer::CreatePacket(const uint8_t* data, size_t size, bool reliable)
+	{
+		return enet_packet_create(data, size, reliable ? ENET_PACKET_FLAG_RELIABLE : 0);
+	}
+
 	void NetworkServer::Broadcast(const uint8_t* data, size_t size, bool reliable)
 	{
 		if (!m_Host)
@@ -179,6 +221,9 @@ namespace MMO {
 		ENetPacket* packet = enet_packet_create(data, size,
 												reliable ? ENET_PACKET_FLAG_RELIABLE : 0);
 		enet_host_broadcast(m_Host, 0, packet);
+
+		m_Stats.packetsSent += m_Peers.size();
+		m_Stats.bytesSent += size * m_Peers.size();
 	}
 
 	void NetworkServer::Broadcast(const WriteBuffer& buffer, bool reliable)
@@ -326,10 +371,10 @@ namespace MMO {
 				NetworkEvent netEvent;
 				netEvent.type = NetworkEventType::DATA_RECEIVED;
 				netEvent.peerId = 0;
-				netEvent.data.assign(event.packet->data, event.packet->data + event.packet->dataLength);
+				netEvent.data = event.packet->data;
+				netEvent.size = event.packet->dataLength;
+				netEvent.packet = event.packet; // Released by ReleaseEvents
 				outEvents.push_back(netEvent);
-
-				enet_packet_destroy(event.packet);
 				break;
 			}
 
@@ -21,11 +21,26 @@ namespace MMO {
 		DATA_RECEIVED
 	};
 
+	// DATA_RECEIVED events point straight into the ENet packet (no copy); the
+	// packet stays alive until ReleaseEvents(), so dispatch before releasing
 	struct NetworkEvent
 	{
 		NetworkEventType type;
 		uint32_t peerId;
-		std::vector<uint8_t> data;
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		ENetPacket* packet = nullptr;
+	};
+
+	// Destroys the packets behind a polled batch and clears it; the vector keeps
+	// its capacity so callers can reuse it across polls
+	void ReleaseEvents(std::vector<NetworkEvent>& events);
+
+	// Outbound counters since the last ResetStats() (one ENet packet per peer)
+	struct NetworkStats
+	{
+		uint64_t packetsSent = 0;
+		uint64_t bytesSent = 0;
 	};
 
 	// ============================================================
@@ -45,16 +60,27 @@ namespace MMO {
 		void Poll(std::vector<NetworkEvent>& outEvents, uint32_t timeoutMs = 0);
 		void Send(uint32_t peerId, const uint8_t* data, size_t size, bool reliable = true);
 		void Send(uint32_t peerId, const WriteBuffer& buffer, bool reliable = true);
+		// Queues a packet from CreatePacket or PacketBatch::Release; takes
+		// ownership either way
+		void Send(uint32_t peerId, ENetPacket* packet);
 		void Broadcast(const uint8_t* data, size_t size, bool reliable = true);
 		void Broadcast(const WriteBuffer& buffer, bool reliable = true);
 		void DisconnectPeer(uint32_t peerId);
 
 		size_t GetConnectedPeerCount() const { return m_Peers.size(); }
 
+		// Copies data once into an ENet-owned packet that can be held until it is
+		// sent, so callers don't need their own staging buffer
+		static ENetPacket* CreatePacket(const uint8_t* data, size_t size, bool reliable = true);
+
+		const NetworkStats& GetStats() const { return m_Stats; }
+		void ResetStats() { m_Stats = NetworkStats(); }
+
 	private:
 		ENetHost* m_Host;
 		std::unordered_map<uint32_t, ENetPeer*> m_Peers;
 		uint32_t m_NextPeerId;
+		NetworkStats m_Stats;
 	};
 
 	// ============================================================
@@ -0,0 +1,60 @@
+#include "PacketBatch.h"
+#include "../Packets/Packets.h"
+
+namespace MMO {
+
+	PacketBatch::PacketBatch()
+		: m_Packet(nullptr), m_Size(HEADER_SIZE), m_Count(0)
+	{
+	}
+
+	PacketBatch::~PacketBatch()
+	{
+		if (m_Packet)
+		{
+			enet_packet_destroy(m_Packet);
+		}
+	}
+
+	void PacketBatch::Append(const uint8_t* data, size_t size)
+	{
+		if (!m_Packet)
+		{
+			m_Packet = enet_packet_create(nullptr, MAX_BATCH_SIZE, ENET_PACKET_FLAG_RELIABLE);
+			m_Packet->data[0] = static_cast<uint8_t>(WorldPacketType::S_PACKET_BATCH);
+			m_Size = HEADER_SIZE;
+		}
+
+		uint8_t* out = m_Packet->data + m_Size;
+		out[0] = static_cast<uint8_t>(size & 0xFF);
+		out[1] = static_cast<uint8_t>((size >> 8) & 0xFF);
+		memcpy(out + ENTRY_HEADER_SIZE, data, size);
+		m_Size += ENTRY_HEADER_SIZE + size;
+		m_Count++;
+	}
+
+	ENetPacket* PacketBatch::Release()
+	{
+		if (m_Count == 0)
+			return nullptr;
+
+		// A lone packet doesn't need the container framing: slide it to the
+		// front of the same allocation
+		size_t size = m_Size;
+		if (m_Count == 1)
+		{
+			size -= HEADER_SIZE + ENTRY_HEADER_SIZE;
+			memmove(m_Packet->data, m_Packet->data + HEADER_SIZE + ENTRY_HEADER_SIZE, size);
+		}
+
+		// Shrinking only moves dataLength; the storage is not reallocated
+		enet_packet_resize(m_Packet, size);
+
+		ENetPacket* packet = m_Packet;
+		m_Packet = nullptr;
+		m_Size = HEADER_SIZE;
+		m_Count = 0;
+		return packet;
+	}
+
+} // namespace MMO
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Buffer.h"
+#include <enet/enet.h>
+#include <cstdint>
+
+namespace MMO {
+
+	// ============================================================
+	// PACKET BATCH - Coalesces small world packets into one frame
+	// ============================================================
+	//
+	// Wire format (S_PACKET_BATCH):
+	//   u8 packetType = S_PACKET_BATCH
+	//   repeated until end of packet:
+	//     u16 length
+	//     u8[length] inner packet (own type byte + payload)
+	//
+	// The frame is written straight into a reliable ENetPacket allocated at
+	// MAX_BATCH_SIZE, so Release() hands ENet the bytes as they were appended.
+
+	class PacketBatch
+	{
+	public:
+		// Kept under ENet's default 1400-byte MTU so a batch never fragments
+		static constexpr size_t MAX_BATCH_SIZE = 1200;
+		static constexpr size_t HEADER_SIZE = 1;
+		static constexpr size_t ENTRY_HEADER_SIZE = 2;
+
+		PacketBatch();
+		~PacketBatch();
+		PacketBatch(const PacketBatch&) = delete;
+		PacketBatch& operator=(const PacketBatch&) = delete;
+
+		// True if a single packet of this size can ever be batched
+		static bool IsBatchable(size_t packetSize) { return HEADER_SIZE + ENTRY_HEADER_SIZE + packetSize <= MAX_BATCH_SIZE; }
+
+		bool CanFit(size_t packetSize) const { return m_Size + ENTRY_HEADER_SIZE + packetSize <= MAX_BATCH_SIZE; }
+		void Append(const uint8_t* data, size_t size);
+		void Append(const WriteBuffer& packet) { Append(packet.Data(), packet.Size()); }
+
+		bool IsEmpty() const { return m_Count == 0; }
+		uint32_t GetCount() const { return m_Count; }
+
+		// The frame trimmed to its size, or the only inner packet without
+		// framing when GetCount() == 1. The caller owns it (hand it to
+		// NetworkServer::Send). Null when empty; the next Append starts a
+		// new packet.
+		ENetPacket* Release();
+
+	private:
+		ENetPacket* m_Packet; // Allocated on the first Append
+		size_t m_Size;
+		uint32_t m_Count;
+	};
+
+} // namespace MMO
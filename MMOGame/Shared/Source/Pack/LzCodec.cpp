@@ -0,0 +1,200 @@
+#include "LzCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace MMO {
+
+	namespace {
+
+		constexpr size_t MIN_MATCH = 4;
+		constexpr size_t MAX_OFFSET = 65535;
+		constexpr size_t END_LITERALS = 5; // Matches stop this far before the end
+		constexpr size_t MATCH_LIMIT = 12; // No match starts in the last bytes
+		constexpr uint32_t HASH_BITS = 14;
+		constexpr uint32_t NO_POSITION = UINT32_MAX;
+
+		uint32_t Read32(const uint8_t* p)
+		{
+			uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		uint32_t HashSequence(uint32_t sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - HASH_BITS);
+		}
+
+		struct Output
+		{
+			uint8_t* p;
+			uint8_t* end;
+
+			bool Put(uint8_t byte)
+			{
+				if (p == end)
+					return false;
+				*p++ = byte;
+				return true;
+			}
+
+			bool PutLength(size_t length)
+			{
+				while (length >= 255)
+				{
+					if (!Put(255))
+						return false;
+					length -= 255;
+				}
+				return Put(static_cast<uint8_t>(length));
+			}
+
+			bool PutBytes(const uint8_t* bytes, size_t count)
+			{
+				if (count == 0)
+					return true;
+				if (static_cast<size_t>(end - p) < count)
+					return false;
+				std::memcpy(p, bytes, count);
+				p += count;
+				return true;
+			}
+		};
+
+		// matchLength 0 = final literal-only sequence
+		bool EmitSequence(Output& out, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength)
+		{
+			const size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+			const uint8_t token = static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) |
+													   std::min<size_t>(matchCode, 15));
+			if (!out.Put(token))
+				return false;
+			if (literalCount >= 15 && !out.PutLength(literalCount - 15))
+				return false;
+			if (!out.PutBytes(literals, literalCount))
+				return false;
+			if (matchLength == 0)
+				return true;
+
+			if (!out.Put(static_cast<uint8_t>(offset & 0xFF)) || !out.Put(static_cast<uint8_t>(offset >> 8)))
+				return false;
+			return matchCode < 15 || out.PutLength(matchCode - 15);
+		}
+
+		bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+		{
+			uint8_t byte;
+			do
+			{
+				if (ip == end)
+					return false;
+				byte = *ip++;
+				length += byte;
+			} while (byte == 255);
+			return true;
+		}
+
+	} // namespace
+
+	size_t LzCompressBound(size_t size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	size_t LzCompress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity)
+	{
+		Output out{dst, dst + capacity};
+		std::vector<uint32_t> table(size_t(1) << HASH_BITS, NO_POSITION);
+
+		size_t anchor = 0;
+		size_t ip = 0;
+		const size_t limit = size > MATCH_LIMIT ? size - MATCH_LIMIT : 0;
+		while (ip < limit)
+		{
+			const uint32_t sequence = Read32(src + ip);
+			uint32_t& slot = table[HashSequence(sequence)];
+			const uint32_t candidate = slot;
+			slot = static_cast<uint32_t>(ip);
+
+			if (candidate == NO_POSITION || ip - candidate > MAX_OFFSET || Read32(src + candidate) != sequence)
+			{
+				ip++;
+				continue;
+			}
+
+			size_t matchLength = MIN_MATCH;
+			while (ip + matchLength < size - END_LITERALS && src[candidate + matchLength] == src[ip + matchLength])
+			{
+				matchLength++;
+			}
+
+			if (!EmitSequence(out, src + anchor, ip - anchor, ip - candidate, matchLength))
+				return 0;
+			ip += matchLength;
+			anchor = ip;
+		}
+
+		if (!EmitSequence(out, src + anchor, size - anchor, 0, 0))
+			return 0;
+		return static_cast<size_t>(out.p - dst);
+	}
+
+	bool LzDecompress(const uint8_t* src, size_t storedSize, uint8_t* dst, size_t size)
+	{
+		const uint8_t* ip = src;
+		const uint8_t* const iend = src + storedSize;
+		uint8_t* op = dst;
+		uint8_t* const oend = dst + size;
+
+		while (ip < iend)
+		{
+			const uint8_t token = *ip++;
+
+			size_t literalCount = token >> 4;
+			if (literalCount == 15 && !ReadLength(ip, iend, literalCount))
+				return false;
+			if (literalCount > static_cast<size_t>(iend - ip) || literalCount > static_cast<size_t>(oend - op))
+				return false;
+			if (literalCount > 0)
+			{
+				std::memcpy(op, ip, literalCount);
+				ip += literalCount;
+				op += literalCount;
+			}
+
+			if (op == oend)
+				return ip == iend; // The final sequence carries no match
+
+			if (iend - ip < 2)
+				return false;
+			const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+			ip += 2;
+			if (offset == 0 || offset > static_cast<size_t>(op - dst))
+				return false;
+
+			size_t matchLength = (token & 15) + MIN_MATCH;
+			if ((token & 15) == 15 && !ReadLength(ip, iend, matchLength))
+				return false;
+			if (matchLength > static_cast<size_t>(oend - op))
+				return false;
+
+			const uint8_t* match = op - offset;
+			if (offset >= matchLength)
+			{
+				std::memcpy(op, match, matchLength);
+				op += matchLength;
+			}
+			else
+			{
+				// Overlapping copy repeats the last `offset` bytes
+				for (size_t i = 0; i < matchLength; i++)
+				{
+					*op++ = match[i];
+				}
+			}
+		}
+		return op == oend;
+	}
+
+} // namespace MMO
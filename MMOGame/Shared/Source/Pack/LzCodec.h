@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MMO {
+
+	// Byte-oriented LZ77 in the LZ4 block layout: a token (literal count,
+	// match length), the literals, a 16-bit back offset. Decoding is a
+	// bounds-checked copy loop, fast enough to run on asset load.
+
+	// Worst case output size for `size` input bytes
+	size_t LzCompressBound(size_t size);
+
+	// Returns the compressed size, or 0 if the output would not fit in
+	// `capacity` (treat the data as incompressible)
+	size_t LzCompress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity);
+
+	// Decodes exactly `size` bytes; false on malformed input
+	bool LzDecompress(const uint8_t* src, size_t storedSize, uint8_t* dst, size_t size);
+
+} // namespace MMO
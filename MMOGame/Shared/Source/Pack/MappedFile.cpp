@@ -0,0 +1,136 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace MMO {
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_Data = std::exchange(other.m_Data, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+#if defined(_WIN32)
+			m_File = std::exchange(other.m_File, nullptr);
+			m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#else
+			m_Fd = std::exchange(other.m_Fd, -1);
+#endif
+		}
+		return *this;
+	}
+
+#if defined(_WIN32)
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+								  FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		m_File = file;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+
+		m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* view = m_Mapping ? MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!view)
+		{
+			Close();
+			return false;
+		}
+
+		m_Data = static_cast<const uint8_t*>(view);
+		m_Size = static_cast<size_t>(size.QuadPart);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_Mapping)
+			CloseHandle(m_Mapping);
+		if (m_File)
+			CloseHandle(m_File);
+		m_Data = nullptr;
+		m_Size = 0;
+		m_Mapping = nullptr;
+		m_File = nullptr;
+	}
+
+#else
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		m_Fd = ::open(path.c_str(), O_RDONLY);
+		if (m_Fd < 0)
+			return false;
+
+		struct stat st;
+		if (fstat(m_Fd, &st) != 0 || st.st_size == 0)
+		{
+			Close();
+			return false;
+		}
+
+		const size_t size = static_cast<size_t>(st.st_size);
+		void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, m_Fd, 0);
+		if (view == MAP_FAILED)
+		{
+			Close();
+			return false;
+		}
+
+		m_Data = static_cast<const uint8_t*>(view);
+		m_Size = size;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap(const_cast<uint8_t*>(m_Data), m_Size);
+		if (m_Fd >= 0)
+			close(m_Fd);
+		m_Data = nullptr;
+		m_Size = 0;
+		m_Fd = -1;
+	}
+
+#endif
+
+} // namespace MMO
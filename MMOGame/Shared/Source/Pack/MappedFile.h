@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MMO {
+
+	// Read-only memory mapping of a whole file. Unmapped on destruction.
+	// Move-only; Data() stays valid as long as the object (or a moved-to
+	// object) lives.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// False if the file is missing, empty or cannot be mapped
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const uint8_t* Data() const { return m_Data; }
+		size_t Size() const { return m_Size; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+
+#if defined(_WIN32)
+		void* m_File = nullptr; // HANDLE
+		void* m_Mapping = nullptr;
+#else
+		int m_Fd = -1;
+#endif
+	};
+
+} // namespace MMO
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+
+namespace MMO {
+
+	// Read-only streambuf over bytes owned elsewhere (e.g. a PackView), so
+	// stream-based readers work on packed data without a copy
+	class MemoryStreamBuf : public std::streambuf
+	{
+	public:
+		MemoryStreamBuf(const uint8_t* data, size_t size)
+		{
+			char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+			setg(begin, begin, begin + size);
+		}
+
+	protected:
+		pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+		{
+			if (!(which & std::ios_base::in))
+				return pos_type(off_type(-1));
+
+			off_type base = 0;
+			if (dir == std::ios_base::cur)
+				base = gptr() - eback();
+			else if (dir == std::ios_base::end)
+				base = egptr() - eback();
+
+			const off_type target = base + offset;
+			if (target < 0 || target > egptr() - eback())
+				return pos_type(off_type(-1));
+			setg(eback(), eback() + target, egptr());
+			return pos_type(target);
+		}
+
+		pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+		{
+			return seekoff(off_type(position), std::ios_base::beg, which);
+		}
+
+		std::streamsize xsgetn(char* out, std::streamsize count) override
+		{
+			const std::streamsize available = egptr() - gptr();
+			const std::streamsize n = count < available ? count : available;
+			if (n > 0)
+			{
+				std::char_traits<char>::copy(out, gptr(), static_cast<size_t>(n));
+				setg(eback(), gptr() + n, egptr());
+			}
+			return n;
+		}
+	};
+
+	class MemoryStream : public std::istream
+	{
+	public:
+		MemoryStream(const uint8_t* data, size_t size)
+			: std::istream(nullptr), m_Buffer(data, size)
+		{
+			rdbuf(&m_Buffer);
+		}
+
+	private:
+		MemoryStreamBuf m_Buffer;
+	};
+
+} // namespace MMO
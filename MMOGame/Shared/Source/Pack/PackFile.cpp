@@ -0,0 +1,235 @@
+#include "PackFile.h"
+#include "LzCodec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace MMO {
+
+	// ============================================================
+	// PACK FILE
+	// ============================================================
+
+	namespace {
+
+		bool Fail(std::string* error, const std::string& message)
+		{
+			if (error)
+				*error = message;
+			return false;
+		}
+
+		bool InRange(uint64_t offset, uint64_t size, uint64_t total)
+		{
+			return offset <= total && size <= total - offset;
+		}
+
+	} // namespace
+
+	bool PackFile::Open(const std::string& path, std::string* error)
+	{
+		auto file = std::make_shared<MappedFile>();
+		if (!file->Open(path))
+			return Fail(error, "cannot map " + path);
+
+		const uint64_t fileSize = file->Size();
+		PackHeader header;
+		if (fileSize < sizeof(header))
+			return Fail(error, "truncated header in " + path);
+		std::memcpy(&header, file->Data(), sizeof(header));
+
+		if (header.magic != PACK_MAGIC)
+			return Fail(error, "bad magic in " + path);
+		if (header.version != PACK_VERSION)
+			return Fail(error, "unsupported pack version " + std::to_string(header.version) + " in " + path);
+
+		// The index is read in place, so it must be aligned for PackEntry
+		const uint64_t indexBytes = uint64_t(header.entryCount) * sizeof(PackEntry);
+		if (header.indexOffset % alignof(PackEntry) != 0 || !InRange(header.indexOffset, indexBytes, fileSize))
+			return Fail(error, "bad index in " + path);
+		if (!InRange(header.stringsOffset, header.stringsSize, fileSize))
+			return Fail(error, "bad string table in " + path);
+
+		const auto* entries = reinterpret_cast<const PackEntry*>(file->Data() + header.indexOffset);
+		for (uint32_t i = 0; i < header.entryCount; i++)
+		{
+			const PackEntry& entry = entries[i];
+			if (!InRange(entry.offset, entry.storedSize, fileSize) ||
+				!InRange(entry.pathOffset, entry.pathLength, header.stringsSize))
+				return Fail(error, "bad entry " + std::to_string(i) + " in " + path);
+			if (!(entry.flags & PACK_ENTRY_COMPRESSED) && entry.storedSize != entry.size)
+				return Fail(error, "bad entry " + std::to_string(i) + " in " + path);
+		}
+
+		m_Entries = entries;
+		m_EntryCount = header.entryCount;
+		m_Strings = reinterpret_cast<const char*>(file->Data() + header.stringsOffset);
+		m_StringsSize = static_cast<size_t>(header.stringsSize);
+		m_File = std::move(file);
+		return true;
+	}
+
+	std::string_view PackFile::GetPath(const PackEntry& entry) const
+	{
+		return std::string_view(m_Strings + entry.pathOffset, entry.pathLength);
+	}
+
+	const PackEntry* PackFile::Find(std::string_view normalizedPath) const
+	{
+		const uint64_t hash = PackPathHash(normalizedPath);
+		const PackEntry* end = m_Entries + m_EntryCount;
+		const PackEntry* it = std::lower_bound(m_Entries, end, hash,
+											   [](const PackEntry& entry, uint64_t h) { return entry.pathHash < h; });
+
+		// Hash collisions sit next to each other, ordered by path
+		for (; it != end && it->pathHash == hash; ++it)
+		{
+			if (GetPath(*it) == normalizedPath)
+				return it;
+		}
+		return nullptr;
+	}
+
+	bool PackFile::Read(const PackEntry& entry, PackView& out) const
+	{
+		const uint8_t* stored = m_File->Data() + entry.offset;
+
+		if (!(entry.flags & PACK_ENTRY_COMPRESSED))
+		{
+			out.data = stored;
+			out.size = static_cast<size_t>(entry.size);
+			out.owner = m_File;
+			return true;
+		}
+
+		auto buffer = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(entry.size));
+		if (!LzDecompress(stored, static_cast<size_t>(entry.storedSize), buffer->data(), buffer->size()))
+			return false;
+
+		out.data = buffer->data();
+		out.size = buffer->size();
+		out.owner = std::move(buffer);
+		return true;
+	}
+
+	// ============================================================
+	// PACK FILE SYSTEM
+	// ============================================================
+
+	std::mutex PackFileSystem::s_Mutex;
+	std::vector<PackFileSystem::MountedPack> PackFileSystem::s_Mounts;
+
+	bool PackFileSystem::Mount(const std::string& packPath, const std::string& mountPoint, std::string* error)
+	{
+		auto pack = std::make_shared<PackFile>();
+		if (!pack->Open(packPath, error))
+			return false;
+
+		std::string prefix = NormalizePackPath(mountPoint);
+		while (!prefix.empty() && prefix.back() == '/')
+		{
+			prefix.pop_back();
+		}
+
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Mounts.push_back({std::move(prefix), std::move(pack)});
+		return true;
+	}
+
+	void PackFileSystem::UnmountAll()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Mounts.clear();
+	}
+
+	bool PackFileSystem::HasMounts()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return !s_Mounts.empty();
+	}
+
+	const PackEntry* PackFileSystem::Resolve(const std::string& path, std::shared_ptr<const PackFile>& outPack)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (s_Mounts.empty())
+			return nullptr;
+
+		const std::string normalized = NormalizePackPath(path);
+		for (auto it = s_Mounts.rbegin(); it != s_Mounts.rend(); ++it)
+		{
+			std::string_view relative = normalized;
+			if (!it->prefix.empty())
+			{
+				if (relative.size() <= it->prefix.size() || relative.compare(0, it->prefix.size(), it->prefix) != 0 ||
+					relative[it->prefix.size()] != '/')
+					continue;
+				relative.remove_prefix(it->prefix.size() + 1);
+			}
+
+			if (const PackEntry* entry = it->pack->Find(relative))
+			{
+				outPack = it->pack;
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	bool PackFileSystem::Read(const std::string& path, PackView& out)
+	{
+		std::shared_ptr<const PackFile> pack;
+		const PackEntry* entry = Resolve(path, pack);
+		return entry && pack->Read(*entry, out);
+	}
+
+	bool PackFileSystem::Exists(const std::string& path)
+	{
+		std::shared_ptr<const PackFile> pack;
+		return Resolve(path, pack) != nullptr;
+	}
+
+	std::vector<std::string> PackFileSystem::List(const std::string& directory)
+	{
+		std::string dir = NormalizePackPath(directory);
+		while (!dir.empty() && dir.back() == '/')
+		{
+			dir.pop_back();
+		}
+
+		std::vector<std::string> result;
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		for (const auto& mount : s_Mounts)
+		{
+			// Path inside this pack that `dir` refers to
+			std::string_view inner;
+			if (mount.prefix.empty())
+				inner = dir;
+			else if (dir == mount.prefix)
+				inner = {};
+			else if (dir.size() > mount.prefix.size() && dir.compare(0, mount.prefix.size(), mount.prefix) == 0 &&
+					 dir[mount.prefix.size()] == '/')
+				inner = std::string_view(dir).substr(mount.prefix.size() + 1);
+			else
+				continue;
+
+			for (uint32_t i = 0; i < mount.pack->GetEntryCount(); i++)
+			{
+				std::string_view path = mount.pack->GetPath(mount.pack->GetEntry(i));
+				if (!inner.empty() &&
+					(path.size() <= inner.size() || path.compare(0, inner.size(), inner) != 0 || path[inner.size()] != '/'))
+					continue;
+
+				std::string full = mount.prefix;
+				if (!full.empty())
+					full += '/';
+				full += path;
+				result.push_back(std::move(full));
+			}
+		}
+
+		// Shadowed files show up once
+		std::sort(result.begin(), result.end());
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+		return result;
+	}
+
+} // namespace MMO
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "PackFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MMO {
+
+	// Bytes of one file, read from a pack. `owner` keeps them alive: the
+	// pack's mapping for stored entries, a decoded buffer for compressed ones.
+	struct PackView
+	{
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		std::shared_ptr<const void> owner;
+	};
+
+	// ============================================================
+	// PACK FILE (one mapped .opak)
+	// ============================================================
+
+	class PackFile
+	{
+	public:
+		// Maps the file and validates header, index and string table
+		bool Open(const std::string& path, std::string* error = nullptr);
+
+		// Binary search of the mapped index; `normalizedPath` as returned by
+		// NormalizePackPath. Null if absent.
+		const PackEntry* Find(std::string_view normalizedPath) const;
+
+		// Zero-copy for stored entries; compressed ones are decoded here
+		bool Read(const PackEntry& entry, PackView& out) const;
+
+		std::string_view GetPath(const PackEntry& entry) const;
+		uint32_t GetEntryCount() const { return m_EntryCount; }
+		const PackEntry& GetEntry(uint32_t index) const { return m_Entries[index]; }
+
+	private:
+		std::shared_ptr<MappedFile> m_File;
+		const PackEntry* m_Entries = nullptr;
+		uint32_t m_EntryCount = 0;
+		const char* m_Strings = nullptr;
+		size_t m_StringsSize = 0;
+	};
+
+	// ============================================================
+	// PACK FILE SYSTEM (mounted packs, loose-file fallback is the caller's)
+	// ============================================================
+	//
+	// Mount("Data/data.opak", "Data") serves "Data/maps/001/..." from the pack
+	// entry "maps/001/...". Later mounts shadow earlier ones. Thread-safe;
+	// nothing is mounted on the servers, so every lookup misses cheaply.
+
+	class PackFileSystem
+	{
+	public:
+		static bool Mount(const std::string& packPath, const std::string& mountPoint, std::string* error = nullptr);
+		static void UnmountAll();
+		static bool HasMounts();
+
+		static bool Read(const std::string& path, PackView& out);
+		static bool Exists(const std::string& path);
+
+		// Every packed file under `directory` (recursively), as full paths
+		// including the mount point
+		static std::vector<std::string> List(const std::string& directory);
+
+	private:
+		struct MountedPack
+		{
+			std::string prefix; // Normalized mount point, "" = root
+			std::shared_ptr<const PackFile> pack;
+		};
+
+		// Entry for `path` in the newest mount that has it
+		static const PackEntry* Resolve(const std::string& path, std::shared_ptr<const PackFile>& outPack);
+
+		static std::mutex s_Mutex;
+		static std::vector<MountedPack> s_Mounts;
+	};
+
+} // namespace MMO
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MMO {
+
+	// ============================================================
+	// PACK FILE FORMAT (.opak)
+	// ============================================================
+	//
+	// One archive for the exported runtime Data/ tree:
+	//
+	//   PackHeader
+	//   entry data      each entry starts on a PACK_DATA_ALIGNMENT boundary
+	//   PackEntry[]     sorted by (pathHash, path): binary search, no parsing
+	//   string table    normalized paths, not NUL-terminated
+	//
+	// The reader maps the whole file once. Stored entries are handed out as
+	// views into the mapping; compressed ones (LzCodec) are decoded on read.
+
+	constexpr uint32_t PACK_MAGIC = 0x4B41504F; // "OPAK"
+	constexpr uint32_t PACK_VERSION = 1;
+	constexpr uint32_t PACK_DATA_ALIGNMENT = 16;
+
+	enum PackEntryFlags : uint32_t
+	{
+		PACK_ENTRY_COMPRESSED = 1u << 0,
+	};
+
+	struct PackHeader
+	{
+		uint32_t magic = PACK_MAGIC;
+		uint32_t version = PACK_VERSION;
+		uint32_t entryCount = 0;
+		uint32_t flags = 0;
+		uint64_t indexOffset = 0;
+		uint64_t stringsOffset = 0;
+		uint64_t stringsSize = 0;
+	};
+	static_assert(sizeof(PackHeader) == 40, "PackHeader layout is part of the file format");
+
+	struct PackEntry
+	{
+		uint64_t pathHash = 0;
+		uint64_t offset = 0;	 // From the start of the file
+		uint64_t storedSize = 0; // Bytes in the pack
+		uint64_t size = 0;		 // Bytes once decoded
+		uint32_t pathOffset = 0; // Into the string table
+		uint32_t pathLength = 0;
+		uint32_t flags = 0; // PackEntryFlags
+		uint32_t reserved = 0;
+	};
+	static_assert(sizeof(PackEntry) == 48, "PackEntry layout is part of the file format");
+
+	// Forward slashes, no "./" or leading "/", no doubled separators.
+	// Case is kept: packs are built and read on case-sensitive systems too.
+	inline std::string NormalizePackPath(std::string_view path)
+	{
+		std::string out;
+		out.reserve(path.size());
+		for (char c : path)
+		{
+			if (c == '\\')
+				c = '/';
+			if (c == '/' && (out.empty() || out.back() == '/'))
+				continue;
+			out.push_back(c);
+			if (out.size() == 2 && out[0] == '.' && out[1] == '/')
+				out.clear();
+		}
+		return out;
+	}
+
+	// FNV-1a over the normalized path
+	inline uint64_t PackPathHash(std::string_view normalizedPath)
+	{
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (char c : normalizedPath)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+} // namespace MMO
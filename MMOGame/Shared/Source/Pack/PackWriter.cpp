@@ -0,0 +1,212 @@
+#include "PackWriter.h"
+#include "LzCodec.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace MMO {
+
+	namespace {
+
+		bool Fail(std::string* error, const std::string& message)
+		{
+			if (error)
+				*error = message;
+			return false;
+		}
+
+		std::string LowerExtension(const std::string& path)
+		{
+			std::string ext = std::filesystem::path(path).extension().string();
+			std::transform(ext.begin(), ext.end(), ext.begin(),
+						   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return ext;
+		}
+
+		bool HasExtension(const std::string& path, const std::vector<std::string>& extensions)
+		{
+			const std::string ext = LowerExtension(path);
+			return std::find(extensions.begin(), extensions.end(), ext) != extensions.end();
+		}
+
+		bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& out)
+		{
+			std::ifstream file(path, std::ios::binary | std::ios::ate);
+			if (!file.is_open())
+				return false;
+			const std::streamoff size = file.tellg();
+			if (size < 0)
+				return false;
+			out.resize(static_cast<size_t>(size));
+			file.seekg(0);
+			return out.empty() || file.read(reinterpret_cast<char*>(out.data()), size).good();
+		}
+
+		void PadTo(std::ofstream& file, uint64_t& position, uint64_t alignment)
+		{
+			static const char zeros[PACK_DATA_ALIGNMENT] = {};
+			const uint64_t padding = (alignment - position % alignment) % alignment;
+			file.write(zeros, static_cast<std::streamsize>(padding));
+			position += padding;
+		}
+
+	} // namespace
+
+	void PackWriter::AddFile(const std::string& packPath, const std::string& diskPath)
+	{
+		m_Files.push_back({NormalizePackPath(packPath), diskPath, {}});
+	}
+
+	void PackWriter::AddData(const std::string& packPath, std::vector<uint8_t> data)
+	{
+		m_Files.push_back({NormalizePackPath(packPath), {}, std::move(data)});
+	}
+
+	uint32_t PackWriter::AddDirectory(const std::string& directory, const std::vector<std::string>& skipExtensions)
+	{
+		namespace fs = std::filesystem;
+
+		std::error_code ec;
+		uint32_t added = 0;
+		for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+		{
+			if (!it->is_regular_file(ec))
+				continue;
+			const std::string diskPath = it->path().string();
+			if (HasExtension(diskPath, skipExtensions))
+				continue;
+
+			AddFile(it->path().lexically_relative(directory).generic_string(), diskPath);
+			added++;
+		}
+		return added;
+	}
+
+	bool PackWriter::Write(const std::string& outPath, const PackWriteOptions& options, PackWriteStats* stats,
+						   std::string* error) const
+	{
+		// Index order: (hash, path). Duplicate paths would make lookups ambiguous.
+		std::vector<size_t> order(m_Files.size());
+		std::vector<uint64_t> hashes(m_Files.size());
+		for (size_t i = 0; i < m_Files.size(); i++)
+		{
+			order[i] = i;
+			hashes[i] = PackPathHash(m_Files[i].packPath);
+		}
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+			if (hashes[a] != hashes[b])
+				return hashes[a] < hashes[b];
+			return m_Files[a].packPath < m_Files[b].packPath;
+		});
+		for (size_t i = 1; i < order.size(); i++)
+		{
+			if (m_Files[order[i]].packPath == m_Files[order[i - 1]].packPath)
+				return Fail(error, "duplicate pack path " + m_Files[order[i]].packPath);
+		}
+
+		// Written next to the target and renamed over it at the end: a running
+		// client may have the old pack mapped, and truncating it under the
+		// mapping would crash it
+		const std::string tempPath = outPath + ".tmp";
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+			return Fail(error, "cannot create " + tempPath);
+
+		PackWriteStats localStats;
+		PackHeader header;
+		header.entryCount = static_cast<uint32_t>(m_Files.size());
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		uint64_t position = sizeof(header);
+
+		// Entry data, in index order so neighbours in the index are neighbours on disk
+		std::vector<PackEntry> entries;
+		entries.reserve(order.size());
+		std::string strings;
+		std::vector<uint8_t> loaded;
+		std::vector<uint8_t> compressed;
+		for (size_t index : order)
+		{
+			const PendingFile& pending = m_Files[index];
+			const std::vector<uint8_t>* data = &pending.data;
+			if (!pending.diskPath.empty())
+			{
+				if (!ReadWholeFile(pending.diskPath, loaded))
+				{
+					file.close();
+					std::error_code ec;
+					std::filesystem::remove(tempPath, ec);
+					return Fail(error, "cannot read " + pending.diskPath);
+				}
+				data = &loaded;
+			}
+
+			PackEntry entry;
+			entry.pathHash = hashes[index];
+			entry.size = data->size();
+			entry.pathOffset = static_cast<uint32_t>(strings.size());
+			entry.pathLength = static_cast<uint32_t>(pending.packPath.size());
+			strings += pending.packPath;
+
+			const uint8_t* stored = data->data();
+			size_t storedSize = data->size();
+			if (options.compress && !data->empty() && !HasExtension(pending.packPath, options.storedExtensions))
+			{
+				const size_t limit = static_cast<size_t>(static_cast<double>(data->size()) * options.minCompressionRatio);
+				compressed.resize(LzCompressBound(data->size()));
+				const size_t packed = LzCompress(data->data(), data->size(), compressed.data(), compressed.size());
+				if (packed > 0 && packed <= limit)
+				{
+					stored = compressed.data();
+					storedSize = packed;
+					entry.flags |= PACK_ENTRY_COMPRESSED;
+					localStats.compressedFiles++;
+				}
+			}
+
+			PadTo(file, position, PACK_DATA_ALIGNMENT);
+			entry.offset = position;
+			entry.storedSize = storedSize;
+			file.write(reinterpret_cast<const char*>(stored), static_cast<std::streamsize>(storedSize));
+			position += storedSize;
+
+			localStats.files++;
+			localStats.rawBytes += entry.size;
+			localStats.storedBytes += storedSize;
+			entries.push_back(entry);
+		}
+
+		PadTo(file, position, PACK_DATA_ALIGNMENT);
+		header.indexOffset = position;
+		file.write(reinterpret_cast<const char*>(entries.data()),
+				   static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+		position += entries.size() * sizeof(PackEntry);
+
+		header.stringsOffset = position;
+		header.stringsSize = strings.size();
+		file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+		position += strings.size();
+
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.close();
+		std::error_code ec;
+		if (!file)
+		{
+			std::filesystem::remove(tempPath, ec);
+			return Fail(error, "write failed for " + tempPath);
+		}
+		std::filesystem::rename(tempPath, outPath, ec);
+		if (ec)
+		{
+			std::filesystem::remove(tempPath, ec);
+			return Fail(error, "cannot replace " + outPath + ": " + ec.message());
+		}
+
+		localStats.packBytes = position;
+		if (stats)
+			*stats = localStats;
+		return true;
+	}
+
+} // namespace MMO
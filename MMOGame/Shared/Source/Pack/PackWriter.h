@@ -0,0 +1,59 @@
+#pragma once
+
+#include "PackFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MMO {
+
+	struct PackWriteOptions
+	{
+		bool compress = true;
+		// Compressed data is kept only if it is at most this fraction of the
+		// original; otherwise the entry is stored for zero-copy reads
+		float minCompressionRatio = 0.9f;
+		// Stored as-is: already-compressed images, and .omdl so its vertex and
+		// index blobs go from the mapping straight to glBufferData
+		std::vector<std::string> storedExtensions = {".png", ".jpg", ".jpeg", ".ktx2", ".dds", ".omdl"};
+	};
+
+	struct PackWriteStats
+	{
+		uint32_t files = 0;
+		uint32_t compressedFiles = 0;
+		uint64_t rawBytes = 0;
+		uint64_t storedBytes = 0; // Entry data in the pack, before alignment
+		uint64_t packBytes = 0;	  // Size of the .opak
+	};
+
+	// Collects files, then writes one .opak. Files added with AddFile are read
+	// during Write, one at a time.
+	class PackWriter
+	{
+	public:
+		void AddFile(const std::string& packPath, const std::string& diskPath);
+		void AddData(const std::string& packPath, std::vector<uint8_t> data);
+
+		// Every file under `directory`, keyed by its path relative to it.
+		// Files with an extension in `skipExtensions` (e.g. ".opak") are left out.
+		// Returns the number of files added.
+		uint32_t AddDirectory(const std::string& directory, const std::vector<std::string>& skipExtensions = {".opak"});
+
+		bool Write(const std::string& outPath, const PackWriteOptions& options = {}, PackWriteStats* stats = nullptr,
+				   std::string* error = nullptr) const;
+
+		size_t GetFileCount() const { return m_Files.size(); }
+
+	private:
+		struct PendingFile
+		{
+			std::string packPath; // Normalized
+			std::string diskPath; // Empty for AddData
+			std::vector<uint8_t> data;
+		};
+
+		std::vector<PendingFile> m_Files;
+	};
+
+} // namespace MMO
@@ -2,7 +2,9 @@
 
 #include "../Network/Buffer.h"
 #include "../Types/Types.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <vector>
 
 namespace MMO {
@@ -67,7 +69,9 @@ namespace MMO {
 		S_ENTITY_UPDATE = 0x21,	  // Entity-centric update (only changed fields)
 		S_PLAYER_POSITION = 0x22, // Your authoritative position (client prediction reconciliation)
 		S_AURA_UPDATE = 0x23,	  // Single aura add/update/remove
-		S_AURA_UPDATE_ALL = 0x24  // Full aura list (on login, zone change)
+		S_AURA_UPDATE_ALL = 0x24, // Full aura list (on login, zone change)
+		S_PACKET_BATCH = 0x25,	  // Container of length-prefixed packets (see PacketBatch.h)
+		S_ENTITY_DELTAS = 0x26	  // Compact per-recipient entity updates (see EntityDelta)
 	};
 
 	enum class GameEventType : uint8_t
@@ -687,6 +691,25 @@ namespace MMO {
 			}
 		}
 
+		// Bytes Serialize() writes (excluding the packet type byte)
+		size_t SerializedSize() const
+		{
+			size_t size = 5;
+			if (updateMask & UPDATE_POSITION)
+				size += 16;
+			if (updateMask & UPDATE_MOVE_STATE)
+				size += 1;
+			if (updateMask & UPDATE_HEALTH)
+				size += 8;
+			if (updateMask & UPDATE_MANA)
+				size += 8;
+			if (updateMask & UPDATE_TARGET)
+				size += 4;
+			if (updateMask & UPDATE_CASTING)
+				size += isCasting ? 7 : 1;
+			return size;
+		}
+
 		void Deserialize(ReadBuffer& buf)
 		{
 			id = buf.ReadU32();
@@ -807,6 +830,289 @@ namespace MMO {
 		}
 	};
 
+	// ============================================================
+	// COMPACT ENTITY DELTAS (S_ENTITY_DELTAS)
+	// ============================================================
+	//
+	// Per-recipient replacement for S_ENTITY_UPDATE. The server keeps, for every
+	// (peer, known entity) pair, the wire state it last sent; the client keeps the
+	// same per remote entity. Both are seeded from S_EntitySpawn, and everything
+	// goes over ENet's reliable ordered channel, so the last state sent is the
+	// state the client holds when the next delta arrives - no separate ack needed.
+	//
+	// Packet: u8 type, then entries until the end of the packet.
+	// Entry:  varint id, varint mask (EntityDeltaMask), then per set bit:
+	//   POSITION     zigzag varint dx, dy     (1/ENTITY_POSITION_SCALE units)
+	//   HEIGHT       zigzag varint dz
+	//   ROTATION     u16 absolute             (full turn / 65536)
+	//   HEALTH/MANA  zigzag varint delta
+	//   MAX_*        zigzag varint delta      (only when the max actually changed)
+	//   MOVE_STATE   u8
+	//   TARGET       varint id
+	//   CASTING      u8 isCasting [+ varint abilityId, u16 progress]
+
+	constexpr float ENTITY_POSITION_SCALE = 64.0f;
+
+	enum EntityDeltaMask : uint16_t
+	{
+		DELTA_POSITION = 0x001,
+		DELTA_HEIGHT = 0x002,
+		DELTA_ROTATION = 0x004,
+		DELTA_HEALTH = 0x008,
+		DELTA_MANA = 0x010,
+		DELTA_MOVE_STATE = 0x020,
+		DELTA_TARGET = 0x040,
+		DELTA_CASTING = 0x080,
+		DELTA_MAX_HEALTH = 0x100,
+		DELTA_MAX_MANA = 0x200
+	};
+
+	inline int32_t QuantizePosition(float value)
+	{
+		return static_cast<int32_t>(std::lround(value * ENTITY_POSITION_SCALE));
+	}
+
+	inline float DequantizePosition(int32_t value)
+	{
+		return static_cast<float>(value) / ENTITY_POSITION_SCALE;
+	}
+
+	inline uint16_t QuantizeRotation(float radians)
+	{
+		constexpr float TWO_PI = 6.28318530718f;
+		float turns = radians / TWO_PI;
+		turns -= std::floor(turns);
+		return static_cast<uint16_t>(static_cast<uint32_t>(std::lround(turns * 65536.0f)) & 0xFFFF);
+	}
+
+	inline float DequantizeRotation(uint16_t value)
+	{
+		constexpr float TWO_PI = 6.28318530718f;
+		return static_cast<float>(value) * (TWO_PI / 65536.0f);
+	}
+
+	// Wire state of one entity as last sent to / received by one peer
+	struct EntityDeltaBaseline
+	{
+		int32_t x = 0;
+		int32_t y = 0;
+		int32_t height = 0;
+		uint16_t rotation = 0;
+		MoveState moveState = MoveState::IDLE;
+		int32_t health = 0;
+		int32_t maxHealth = 0;
+		int32_t mana = 0;
+		int32_t maxMana = 0;
+		EntityId targetId = INVALID_ENTITY_ID;
+		bool isCasting = false;
+		AbilityId castingAbilityId = static_cast<AbilityId>(0);
+
+		static EntityDeltaBaseline FromSpawn(const S_EntitySpawn& spawn)
+		{
+			EntityDeltaBaseline baseline;
+			baseline.x = QuantizePosition(spawn.position.x);
+			baseline.y = QuantizePosition(spawn.position.y);
+			baseline.height = QuantizePosition(spawn.height);
+			baseline.rotation = QuantizeRotation(spawn.rotation);
+			baseline.health = spawn.health;
+			baseline.maxHealth = spawn.maxHealth;
+			return baseline;
+		}
+	};
+
+	struct EntityDelta
+	{
+		// Append the fields of `state` that are flagged in state.updateMask and
+		// differ from `baseline`, then advance the baseline. Writes nothing and
+		// returns false when no flagged field changed on the wire.
+		static bool Encode(WriteBuffer& buf, const S_EntityUpdate& state, EntityDeltaBaseline& baseline)
+		{
+			uint16_t mask = 0;
+			int32_t x = 0, y = 0, height = 0;
+			uint16_t rotation = 0;
+
+			if (state.updateMask & UPDATE_POSITION)
+			{
+				x = QuantizePosition(state.position.x);
+				y = QuantizePosition(state.position.y);
+				height = QuantizePosition(state.height);
+				rotation = QuantizeRotation(state.rotation);
+				if (x != baseline.x || y != baseline.y)
+					mask |= DELTA_POSITION;
+				if (height != baseline.height)
+					mask |= DELTA_HEIGHT;
+				if (rotation != baseline.rotation)
+					mask |= DELTA_ROTATION;
+			}
+			if ((state.updateMask & UPDATE_MOVE_STATE) && state.moveState != baseline.moveState)
+				mask |= DELTA_MOVE_STATE;
+			if (state.updateMask & UPDATE_HEALTH)
+			{
+				if (state.health != baseline.health)
+					mask |= DELTA_HEALTH;
+				if (state.maxHealth != baseline.maxHealth)
+					mask |= DELTA_MAX_HEALTH;
+			}
+			if (state.updateMask & UPDATE_MANA)
+			{
+				if (state.mana != baseline.mana)
+					mask |= DELTA_MANA;
+				if (state.maxMana != baseline.maxMana)
+					mask |= DELTA_MAX_MANA;
+			}
+			if ((state.updateMask & UPDATE_TARGET) && state.targetId != baseline.targetId)
+				mask |= DELTA_TARGET;
+			// Progress moves every tick, so a flagged cast change is always sent
+			if (state.updateMask & UPDATE_CASTING)
+				mask |= DELTA_CASTING;
+
+			if (mask == 0)
+				return false;
+
+			buf.WriteVarU32(state.id);
+			buf.WriteVarU32(mask);
+			if (mask & DELTA_POSITION)
+			{
+				buf.WriteVarI32(x - baseline.x);
+				buf.WriteVarI32(y - baseline.y);
+				baseline.x = x;
+				baseline.y = y;
+			}
+			if (mask & DELTA_HEIGHT)
+			{
+				buf.WriteVarI32(height - baseline.height);
+				baseline.height = height;
+			}
+			if (mask & DELTA_ROTATION)
+			{
+				buf.WriteU16(rotation);
+				baseline.rotation = rotation;
+			}
+			if (mask & DELTA_HEALTH)
+			{
+				buf.WriteVarI32(state.health - baseline.health);
+				baseline.health = state.health;
+			}
+			if (mask & DELTA_MAX_HEALTH)
+			{
+				buf.WriteVarI32(state.maxHealth - baseline.maxHealth);
+				baseline.maxHealth = state.maxHealth;
+			}
+			if (mask & DELTA_MANA)
+			{
+				buf.WriteVarI32(state.mana - baseline.mana);
+				baseline.mana = state.mana;
+			}
+			if (mask & DELTA_MAX_MANA)
+			{
+				buf.WriteVarI32(state.maxMana - baseline.maxMana);
+				baseline.maxMana = state.maxMana;
+			}
+			if (mask & DELTA_MOVE_STATE)
+			{
+				buf.WriteU8(static_cast<uint8_t>(state.moveState));
+				baseline.moveState = state.moveState;
+			}
+			if (mask & DELTA_TARGET)
+			{
+				buf.WriteVarU32(state.targetId);
+				baseline.targetId = state.targetId;
+			}
+			if (mask & DELTA_CASTING)
+			{
+				buf.WriteU8(state.isCasting ? 1 : 0);
+				if (state.isCasting)
+				{
+					float progress = std::clamp(state.castProgress, 0.0f, 1.0f);
+					buf.WriteVarU32(static_cast<uint32_t>(state.castingAbilityId));
+					buf.WriteU16(static_cast<uint16_t>(std::lround(progress * 65535.0f)));
+				}
+				baseline.isCasting = state.isCasting;
+				baseline.castingAbilityId = state.castingAbilityId;
+			}
+			return true;
+		}
+
+		// Read the id of the next entry (call before Decode/Skip)
+		static EntityId ReadId(ReadBuffer& buf) { return buf.ReadVarU32(); }
+
+		// Apply the entry to `baseline` and return the full decoded state, with
+		// updateMask expressed in EntityUpdateMask terms for existing handlers
+		static S_EntityUpdate Decode(ReadBuffer& buf, EntityId id, EntityDeltaBaseline& baseline)
+		{
+			uint32_t mask = buf.ReadVarU32();
+
+			if (mask & DELTA_POSITION)
+			{
+				baseline.x += buf.ReadVarI32();
+				baseline.y += buf.ReadVarI32();
+			}
+			if (mask & DELTA_HEIGHT)
+				baseline.height += buf.ReadVarI32();
+			if (mask & DELTA_ROTATION)
+				baseline.rotation = buf.ReadU16();
+			if (mask & DELTA_HEALTH)
+				baseline.health += buf.ReadVarI32();
+			if (mask & DELTA_MAX_HEALTH)
+				baseline.maxHealth += buf.ReadVarI32();
+			if (mask & DELTA_MANA)
+				baseline.mana += buf.ReadVarI32();
+			if (mask & DELTA_MAX_MANA)
+				baseline.maxMana += buf.ReadVarI32();
+			if (mask & DELTA_MOVE_STATE)
+				baseline.moveState = static_cast<MoveState>(buf.ReadU8());
+			if (mask & DELTA_TARGET)
+				baseline.targetId = buf.ReadVarU32();
+
+			S_EntityUpdate update{};
+			update.castProgress = 0.0f;
+			if (mask & DELTA_CASTING)
+			{
+				baseline.isCasting = buf.ReadU8() != 0;
+				if (baseline.isCasting)
+				{
+					baseline.castingAbilityId = static_cast<AbilityId>(buf.ReadVarU32());
+					update.castProgress = static_cast<float>(buf.ReadU16()) / 65535.0f;
+				}
+			}
+
+			update.id = id;
+			update.updateMask = 0;
+			if (mask & (DELTA_POSITION | DELTA_HEIGHT | DELTA_ROTATION))
+				update.updateMask |= UPDATE_POSITION;
+			if (mask & (DELTA_HEALTH | DELTA_MAX_HEALTH))
+				update.updateMask |= UPDATE_HEALTH;
+			if (mask & (DELTA_MANA | DELTA_MAX_MANA))
+				update.updateMask |= UPDATE_MANA;
+			if (mask & DELTA_MOVE_STATE)
+				update.updateMask |= UPDATE_MOVE_STATE;
+			if (mask & DELTA_TARGET)
+				update.updateMask |= UPDATE_TARGET;
+			if (mask & DELTA_CASTING)
+				update.updateMask |= UPDATE_CASTING;
+
+			update.position = Vec2(DequantizePosition(baseline.x), DequantizePosition(baseline.y));
+			update.height = DequantizePosition(baseline.height);
+			update.rotation = DequantizeRotation(baseline.rotation);
+			update.moveState = baseline.moveState;
+			update.health = baseline.health;
+			update.maxHealth = baseline.maxHealth;
+			update.mana = baseline.mana;
+			update.maxMana = baseline.maxMana;
+			update.targetId = baseline.targetId;
+			update.isCasting = baseline.isCasting;
+			update.castingAbilityId = baseline.castingAbilityId;
+			return update;
+		}
+
+		// Consume an entry without a baseline (entity unknown to this client)
+		static void Skip(ReadBuffer& buf)
+		{
+			EntityDeltaBaseline scratch;
+			Decode(buf, INVALID_ENTITY_ID, scratch);
+		}
+	};
+
 	struct S_Event
 	{
 		GameEventType type;
@@ -1,11 +1,13 @@
 #include "ChunkFileReader.h"
 #include "ChunkIO.h"
+#include "Pack/MemoryStream.h"
+#include "Pack/PackFile.h"
 #include <fstream>
 #include <iostream>
 
 namespace MMO {
 
-	void ReadTerrainSection(std::ifstream& file, TerrainChunkData& data, int32_t chunkX, int32_t chunkZ)
+	void ReadTerrainSection(std::istream& file, TerrainChunkData& data, int32_t chunkX, int32_t chunkZ)
 	{
 		data.chunkX = chunkX;
 		data.chunkZ = chunkZ;
@@ -28,7 +30,7 @@ namespace MMO {
 		}
 	}
 
-	static void ReadLightsSection(std::ifstream& file, std::vector<ChunkLightData>& lights)
+	static void ReadLightsSection(std::istream& file, std::vector<ChunkLightData>& lights)
 	{
 		uint32_t count = 0;
 		file.read(reinterpret_cast<char*>(&count), sizeof(count));
@@ -51,7 +53,7 @@ namespace MMO {
 		}
 	}
 
-	static void ReadObjectsSection(std::ifstream& file, std::vector<ChunkObjectData>& objects,
+	static void ReadObjectsSection(std::istream& file, std::vector<ChunkObjectData>& objects,
 								   uint32_t containerVersion)
 	{
 		uint32_t count = 0;
@@ -76,12 +78,8 @@ namespace MMO {
 		}
 	}
 
-	bool LoadChunkFile(const std::string& path, ChunkFileData& out)
+	static bool ReadChunkStream(std::istream& file, const std::string& path, ChunkFileData& out)
 	{
-		std::ifstream file(path, std::ios::binary);
-		if (!file.is_open())
-			return false;
-
 		uint32_t magic;
 		file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
 		if (magic != CHNK_MAGIC)
@@ -140,4 +138,20 @@ namespace MMO {
 		return true;
 	}
 
+	bool LoadChunkFile(const std::string& path, ChunkFileData& out)
+	{
+		// Mounted pack first (runtime client), then the loose file
+		PackView view;
+		if (PackFileSystem::Read(path, view))
+		{
+			MemoryStream stream(view.data, view.size);
+			return ReadChunkStream(stream, path, out);
+		}
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			return false;
+		return ReadChunkStream(file, path, out);
+	}
+
 } // namespace MMO
@@ -22,7 +22,7 @@ namespace MMO {
 	bool LoadChunkFile(const std::string& path, ChunkFileData& out);
 
 	// Read just the terrain section from an already-open .chunk stream
-	void ReadTerrainSection(std::ifstream& file, TerrainChunkData& data,
+	void ReadTerrainSection(std::istream& file, TerrainChunkData& data,
 							int32_t chunkX, int32_t chunkZ);
 
 } // namespace MMO
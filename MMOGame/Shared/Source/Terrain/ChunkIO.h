@@ -15,7 +15,7 @@ namespace MMO {
 			f.write(s.data(), len);
 	}
 
-	inline std::string ReadString(std::ifstream& f)
+	inline std::string ReadString(std::istream& f)
 	{
 		uint16_t len = 0;
 		f.read(reinterpret_cast<char*>(&len), sizeof(len));
@@ -0,0 +1,423 @@
+#include "ServerTerrain.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace MMO {
+
+	namespace {
+
+		template <typename T>
+		void WritePod(std::ofstream& f, const T& value)
+		{
+			f.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template <typename T>
+		bool ReadPod(std::ifstream& f, T& value)
+		{
+			return static_cast<bool>(f.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+
+		int64_t MakeChunkKey(int32_t chunkX, int32_t chunkZ)
+		{
+			return (static_cast<int64_t>(chunkX) << 32) | static_cast<uint32_t>(chunkZ);
+		}
+
+		constexpr float PI = 3.14159265358979f;
+
+	} // namespace
+
+	// ============================================================
+	// SERVER TERRAIN
+	// ============================================================
+
+	float ServerTerrain::Chunk::SampleHeight(float localX, float localZ) const
+	{
+		float fx = std::clamp(localX / SERVER_TERRAIN_CELL_SIZE, 0.0f, static_cast<float>(SERVER_TERRAIN_CELLS));
+		float fz = std::clamp(localZ / SERVER_TERRAIN_CELL_SIZE, 0.0f, static_cast<float>(SERVER_TERRAIN_CELLS));
+
+		int x0 = std::min(static_cast<int>(fx), SERVER_TERRAIN_CELLS - 1);
+		int z0 = std::min(static_cast<int>(fz), SERVER_TERRAIN_CELLS - 1);
+		float fracX = fx - x0;
+		float fracZ = fz - z0;
+
+		float h00 = HeightAt(x0, z0);
+		float h10 = HeightAt(x0 + 1, z0);
+		float h01 = HeightAt(x0, z0 + 1);
+		float h11 = HeightAt(x0 + 1, z0 + 1);
+
+		float h0 = h00 + fracX * (h10 - h00);
+		float h1 = h01 + fracX * (h11 - h01);
+		return h0 + fracZ * (h1 - h0);
+	}
+
+	const ServerTerrain::Chunk* ServerTerrain::FindCell(int32_t cellX, int32_t cellZ, int& localX, int& localZ) const
+	{
+		// SERVER_TERRAIN_CELLS is 64: shift and mask floor correctly for negative cells
+		localX = cellX & (SERVER_TERRAIN_CELLS - 1);
+		localZ = cellZ & (SERVER_TERRAIN_CELLS - 1);
+		return FindChunk(cellX >> 6, cellZ >> 6);
+	}
+
+	ServerTerrain::Chunk* ServerTerrain::FindCell(int32_t cellX, int32_t cellZ, int& localX, int& localZ)
+	{
+		return const_cast<Chunk*>(static_cast<const ServerTerrain*>(this)->FindCell(cellX, cellZ, localX, localZ));
+	}
+
+	bool ServerTerrain::GetHeight(float x, float z, float& outHeight) const
+	{
+		const int32_t chunkX = WorldToChunkCoord(x);
+		const int32_t chunkZ = WorldToChunkCoord(z);
+		const Chunk* chunk = FindChunk(chunkX, chunkZ);
+		if (!chunk)
+			return false;
+
+		const float localX = x - chunkX * TERRAIN_CHUNK_SIZE;
+		const float localZ = z - chunkZ * TERRAIN_CHUNK_SIZE;
+		const int cellX = std::min(static_cast<int>(localX / SERVER_TERRAIN_CELL_SIZE), SERVER_TERRAIN_CELLS - 1);
+		const int cellZ = std::min(static_cast<int>(localZ / SERVER_TERRAIN_CELL_SIZE), SERVER_TERRAIN_CELLS - 1);
+		if (chunk->IsHole(cellX, cellZ))
+			return false;
+
+		outHeight = chunk->SampleHeight(localX, localZ);
+		return true;
+	}
+
+	bool ServerTerrain::IsWalkable(float x, float z) const
+	{
+		return IsCellWalkable(WorldToCell(x), WorldToCell(z));
+	}
+
+	bool ServerTerrain::IsCellWalkable(int32_t cellX, int32_t cellZ) const
+	{
+		int localX, localZ;
+		const Chunk* chunk = FindCell(cellX, cellZ, localX, localZ);
+		return chunk && ((chunk->walkable[localZ] >> localX) & 1);
+	}
+
+	bool ServerTerrain::IsCellBlocked(int32_t cellX, int32_t cellZ) const
+	{
+		int localX, localZ;
+		const Chunk* chunk = FindCell(cellX, cellZ, localX, localZ);
+		return chunk && ((chunk->blocked[localZ] >> localX) & 1);
+	}
+
+	bool ServerTerrain::HasLineOfSight(float fromX, float fromZ, float fromHeight,
+									   float toX, float toZ, float toHeight) const
+	{
+		const float dx = toX - fromX;
+		const float dz = toZ - fromZ;
+		const float dh = toHeight - fromHeight;
+		constexpr float INF = std::numeric_limits<float>::infinity();
+
+		// Grid traversal (Amanatides & Woo): visit every cell the segment
+		// crosses, with t in [0, 1] along it
+		const int32_t startX = WorldToCell(fromX);
+		const int32_t startZ = WorldToCell(fromZ);
+		const int32_t endX = WorldToCell(toX);
+		const int32_t endZ = WorldToCell(toZ);
+		const int32_t stepX = dx > 0.0f ? 1 : -1;
+		const int32_t stepZ = dz > 0.0f ? 1 : -1;
+
+		float tMaxX = dx != 0.0f ? ((startX + (dx > 0.0f ? 1 : 0)) * SERVER_TERRAIN_CELL_SIZE - fromX) / dx : INF;
+		float tMaxZ = dz != 0.0f ? ((startZ + (dz > 0.0f ? 1 : 0)) * SERVER_TERRAIN_CELL_SIZE - fromZ) / dz : INF;
+		const float tDeltaX = dx != 0.0f ? SERVER_TERRAIN_CELL_SIZE / std::abs(dx) : INF;
+		const float tDeltaZ = dz != 0.0f ? SERVER_TERRAIN_CELL_SIZE / std::abs(dz) : INF;
+
+		int32_t cellX = startX;
+		int32_t cellZ = startZ;
+		float tIn = 0.0f;
+		const int32_t maxSteps = std::abs(endX - startX) + std::abs(endZ - startZ);
+
+		for (int32_t step = 0;; step++)
+		{
+			const float tOut = std::min(std::min(tMaxX, tMaxZ), 1.0f);
+
+			int localX, localZ;
+			const Chunk* chunk = FindCell(cellX, cellZ, localX, localZ);
+			if (chunk)
+			{
+				// Whoever stands at either end is not hidden by their own cell
+				const bool endpoint = (cellX == startX && cellZ == startZ) || (cellX == endX && cellZ == endZ);
+				if (!endpoint && ((chunk->blocked[localZ] >> localX) & 1))
+					return false;
+
+				if (!chunk->IsHole(localX, localZ))
+				{
+					const float originX = static_cast<float>(cellX - localX) * SERVER_TERRAIN_CELL_SIZE;
+					const float originZ = static_cast<float>(cellZ - localZ) * SERVER_TERRAIN_CELL_SIZE;
+					const float samples[2] = {(tIn + tOut) * 0.5f, tOut};
+					for (float t : samples)
+					{
+						const float ground = chunk->SampleHeight(fromX + dx * t - originX, fromZ + dz * t - originZ);
+						if (fromHeight + dh * t < ground)
+							return false;
+					}
+				}
+			}
+
+			if (step >= maxSteps || tOut >= 1.0f)
+				break;
+
+			if (tMaxX < tMaxZ)
+			{
+				cellX += stepX;
+				tMaxX += tDeltaX;
+			}
+			else
+			{
+				cellZ += stepZ;
+				tMaxZ += tDeltaZ;
+			}
+			tIn = tOut;
+		}
+		return true;
+	}
+
+	uint32_t ServerTerrain::CountWalkableCells() const
+	{
+		uint32_t count = 0;
+		for (const Chunk& chunk : m_Chunks)
+		{
+			for (uint64_t row : chunk.walkable)
+			{
+				count += static_cast<uint32_t>(std::popcount(row));
+			}
+		}
+		return count;
+	}
+
+	uint32_t ServerTerrain::CountBlockedCells() const
+	{
+		uint32_t count = 0;
+		for (const Chunk& chunk : m_Chunks)
+		{
+			for (uint64_t row : chunk.blocked)
+			{
+				count += static_cast<uint32_t>(std::popcount(row));
+			}
+		}
+		return count;
+	}
+
+	void ServerTerrain::BuildChunkTable()
+	{
+		m_ChunkTable.clear();
+		m_Header.chunkCount = static_cast<uint32_t>(m_Chunks.size());
+		if (m_Chunks.empty())
+		{
+			m_Header.originChunkX = m_Header.originChunkZ = 0;
+			m_Header.chunksX = m_Header.chunksZ = 0;
+			return;
+		}
+
+		int32_t minX = m_Chunks[0].chunkX, maxX = minX;
+		int32_t minZ = m_Chunks[0].chunkZ, maxZ = minZ;
+		for (const Chunk& chunk : m_Chunks)
+		{
+			minX = std::min(minX, chunk.chunkX);
+			maxX = std::max(maxX, chunk.chunkX);
+			minZ = std::min(minZ, chunk.chunkZ);
+			maxZ = std::max(maxZ, chunk.chunkZ);
+		}
+
+		m_Header.originChunkX = minX;
+		m_Header.originChunkZ = minZ;
+		m_Header.chunksX = static_cast<uint32_t>(maxX - minX + 1);
+		m_Header.chunksZ = static_cast<uint32_t>(maxZ - minZ + 1);
+		m_ChunkTable.assign(static_cast<size_t>(m_Header.chunksX) * m_Header.chunksZ, -1);
+		for (size_t i = 0; i < m_Chunks.size(); i++)
+		{
+			const Chunk& chunk = m_Chunks[i];
+			size_t slot = static_cast<size_t>(chunk.chunkZ - minZ) * m_Header.chunksX + (chunk.chunkX - minX);
+			m_ChunkTable[slot] = static_cast<int32_t>(i);
+		}
+	}
+
+	bool ServerTerrain::Save(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+			return false;
+
+		WritePod(file, m_Header);
+		for (const Chunk& chunk : m_Chunks)
+		{
+			WritePod(file, chunk.chunkX);
+			WritePod(file, chunk.chunkZ);
+			WritePod(file, chunk.minHeight);
+			WritePod(file, chunk.heightScale);
+			WritePod(file, chunk.holeMask);
+			file.write(reinterpret_cast<const char*>(chunk.heights.data()), sizeof(chunk.heights));
+			file.write(reinterpret_cast<const char*>(chunk.walkable.data()), sizeof(chunk.walkable));
+			file.write(reinterpret_cast<const char*>(chunk.blocked.data()), sizeof(chunk.blocked));
+		}
+		return static_cast<bool>(file);
+	}
+
+	bool ServerTerrain::Load(const std::string& path)
+	{
+		m_Chunks.clear();
+		m_ChunkTable.clear();
+		m_Header = {};
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			return false;
+
+		ServerTerrainHeader header;
+		if (!ReadPod(file, header) || header.magic != STRN_MAGIC || header.version != STRN_VERSION)
+			return false;
+		if (static_cast<uint64_t>(header.chunksX) * header.chunksZ > STRN_MAX_TABLE_SIZE ||
+			header.chunkCount > static_cast<uint64_t>(header.chunksX) * header.chunksZ)
+			return false;
+
+		std::vector<Chunk> chunks(header.chunkCount);
+		for (Chunk& chunk : chunks)
+		{
+			if (!ReadPod(file, chunk.chunkX) || !ReadPod(file, chunk.chunkZ) || !ReadPod(file, chunk.minHeight) ||
+				!ReadPod(file, chunk.heightScale) || !ReadPod(file, chunk.holeMask) ||
+				!file.read(reinterpret_cast<char*>(chunk.heights.data()), sizeof(chunk.heights)) ||
+				!file.read(reinterpret_cast<char*>(chunk.walkable.data()), sizeof(chunk.walkable)) ||
+				!file.read(reinterpret_cast<char*>(chunk.blocked.data()), sizeof(chunk.blocked)))
+			{
+				return false;
+			}
+		}
+
+		m_Chunks = std::move(chunks);
+		m_Header = header;
+		BuildChunkTable();
+
+		// The table is rebuilt from the records; it must cover the same range
+		if (m_Header.originChunkX != header.originChunkX || m_Header.originChunkZ != header.originChunkZ ||
+			m_Header.chunksX != header.chunksX || m_Header.chunksZ != header.chunksZ)
+		{
+			m_Chunks.clear();
+			m_ChunkTable.clear();
+			m_Header = {};
+			return false;
+		}
+		return true;
+	}
+
+	// ============================================================
+	// SERVER TERRAIN BUILDER
+	// ============================================================
+
+	void ServerTerrainBuilder::AddChunk(const TerrainChunkData& data)
+	{
+		if (data.heightmap.size() != TERRAIN_CHUNK_HEIGHTMAP_SIZE)
+			return;
+
+		ServerTerrain::Chunk chunk;
+		chunk.chunkX = data.chunkX;
+		chunk.chunkZ = data.chunkZ;
+		chunk.holeMask = data.holeMask;
+
+		auto [minIt, maxIt] = std::minmax_element(data.heightmap.begin(), data.heightmap.end());
+		chunk.minHeight = *minIt;
+		chunk.heightScale = (*maxIt - *minIt) / 65535.0f;
+		for (int i = 0; i < TERRAIN_CHUNK_HEIGHTMAP_SIZE; i++)
+		{
+			float q = chunk.heightScale > 0.0f ? (data.heightmap[i] - chunk.minHeight) / chunk.heightScale : 0.0f;
+			chunk.heights[i] = static_cast<uint16_t>(std::clamp(std::lround(q), 0L, 65535L));
+		}
+
+		auto [it, inserted] = m_ChunkLookup.try_emplace(MakeChunkKey(chunk.chunkX, chunk.chunkZ), m_Chunks.size());
+		if (inserted)
+			m_Chunks.push_back(chunk);
+		else
+			m_Chunks[it->second] = chunk;
+	}
+
+	void ServerTerrainBuilder::Build(ServerTerrain& out) const
+	{
+		out.m_Chunks = m_Chunks;
+		out.m_Header = {};
+		const float maxSlope = std::tan(m_Settings.maxWalkSlopeDegrees * PI / 180.0f);
+		out.m_Header.maxWalkSlope = maxSlope;
+		out.BuildChunkTable();
+
+		// Slope and holes, one heightmap quad per cell
+		for (ServerTerrain::Chunk& chunk : out.m_Chunks)
+		{
+			for (int z = 0; z < SERVER_TERRAIN_CELLS; z++)
+			{
+				uint64_t row = 0;
+				for (int x = 0; x < SERVER_TERRAIN_CELLS; x++)
+				{
+					if (chunk.IsHole(x, z))
+						continue;
+
+					const float h00 = chunk.HeightAt(x, z);
+					const float h10 = chunk.HeightAt(x + 1, z);
+					const float h01 = chunk.HeightAt(x, z + 1);
+					const float h11 = chunk.HeightAt(x + 1, z + 1);
+					const float gx = ((h10 - h00) + (h11 - h01)) * 0.5f / SERVER_TERRAIN_CELL_SIZE;
+					const float gz = ((h01 - h00) + (h11 - h10)) * 0.5f / SERVER_TERRAIN_CELL_SIZE;
+					if (gx * gx + gz * gz <= maxSlope * maxSlope)
+						row |= 1ULL << x;
+				}
+				chunk.walkable[z] = row;
+				chunk.blocked[z] = 0;
+			}
+		}
+
+		if (out.m_Chunks.empty())
+			return;
+
+		// Object footprints, tested at cell centers and clipped to the table
+		const int32_t minCellX = out.m_Header.originChunkX * SERVER_TERRAIN_CELLS;
+		const int32_t minCellZ = out.m_Header.originChunkZ * SERVER_TERRAIN_CELLS;
+		const int32_t maxCellX = minCellX + static_cast<int32_t>(out.m_Header.chunksX) * SERVER_TERRAIN_CELLS - 1;
+		const int32_t maxCellZ = minCellZ + static_cast<int32_t>(out.m_Header.chunksZ) * SERVER_TERRAIN_CELLS - 1;
+
+		for (const TerrainObstacle& obstacle : m_Obstacles)
+		{
+			const float c = std::cos(obstacle.yaw);
+			const float s = std::sin(obstacle.yaw);
+			const float extentX = std::abs(c) * obstacle.halfExtentX + std::abs(s) * obstacle.halfExtentZ;
+			const float extentZ = std::abs(s) * obstacle.halfExtentX + std::abs(c) * obstacle.halfExtentZ;
+
+			const int32_t x0 = std::max(ServerTerrain::WorldToCell(obstacle.centerX - extentX), minCellX);
+			const int32_t x1 = std::min(ServerTerrain::WorldToCell(obstacle.centerX + extentX), maxCellX);
+			const int32_t z0 = std::max(ServerTerrain::WorldToCell(obstacle.centerZ - extentZ), minCellZ);
+			const int32_t z1 = std::min(ServerTerrain::WorldToCell(obstacle.centerZ + extentZ), maxCellZ);
+
+			for (int32_t cellZ = z0; cellZ <= z1; cellZ++)
+			{
+				for (int32_t cellX = x0; cellX <= x1; cellX++)
+				{
+					const float wx = (cellX + 0.5f) * SERVER_TERRAIN_CELL_SIZE;
+					const float wz = (cellZ + 0.5f) * SERVER_TERRAIN_CELL_SIZE;
+					const float dx = wx - obstacle.centerX;
+					const float dz = wz - obstacle.centerZ;
+					if (std::abs(dx * c + dz * s) > obstacle.halfExtentX ||
+						std::abs(-dx * s + dz * c) > obstacle.halfExtentZ)
+						continue;
+
+					int localX, localZ;
+					ServerTerrain::Chunk* chunk = out.FindCell(cellX, cellZ, localX, localZ);
+					if (!chunk)
+						continue;
+
+					const float ground = chunk->SampleHeight((localX + 0.5f) * SERVER_TERRAIN_CELL_SIZE,
+															 (localZ + 0.5f) * SERVER_TERRAIN_CELL_SIZE);
+					if (obstacle.top <= ground + m_Settings.stepHeight ||
+						obstacle.bottom >= ground + m_Settings.agentHeight)
+						continue;
+
+					chunk->walkable[localZ] &= ~(1ULL << localX);
+					if (obstacle.top >= ground + m_Settings.agentHeight)
+						chunk->blocked[localZ] |= 1ULL << localX;
+				}
+			}
+		}
+	}
+
+} // namespace MMO
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "TerrainData.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MMO {
+
+	// .strn — server terrain. Everything the WorldServer needs to ground
+	// movement and test sight, baked by the editor export from the map's
+	// chunks and static objects. Nothing here is rendered, so the file stays
+	// out of data.opak and the server never reads a client asset.
+	//
+	// Per chunk: the heightmap quantized to uint16 over the chunk's height
+	// range, the hole mask, and two 64x64 bitmaps over 1x1 m cells (one cell
+	// per heightmap quad): walkable, and blocked by a static object taller
+	// than an agent (which also blocks sight). A dense table over the
+	// exported chunk range maps chunk coordinates to records, so every
+	// point query is O(1).
+
+	constexpr uint32_t STRN_MAGIC = 0x5354524E; // "STRN"
+	constexpr uint32_t STRN_VERSION = 1;
+
+	constexpr int SERVER_TERRAIN_CELLS = TERRAIN_CHUNK_RESOLUTION - 1; // Cells per chunk edge
+	constexpr float SERVER_TERRAIN_CELL_SIZE = TERRAIN_CHUNK_SIZE / SERVER_TERRAIN_CELLS;
+	constexpr int SERVER_TERRAIN_HOLE_CELLS = SERVER_TERRAIN_CELLS / TERRAIN_HOLE_GRID_SIZE; // Cells per hole
+	static_assert(SERVER_TERRAIN_CELLS == 64, "walk bitmap rows are one uint64_t");
+
+	// Sanity limit on the chunk table (chunksX * chunksZ)
+	constexpr uint32_t STRN_MAX_TABLE_SIZE = 1u << 20;
+
+	struct ServerTerrainHeader
+	{
+		uint32_t magic = STRN_MAGIC;
+		uint32_t version = STRN_VERSION;
+		int32_t originChunkX = 0; // Chunk coordinates of table entry 0
+		int32_t originChunkZ = 0;
+		uint32_t chunksX = 0; // Table size
+		uint32_t chunksZ = 0;
+		uint32_t chunkCount = 0; // Records that follow
+		float maxWalkSlope = 0.0f; // Tangent the walk bitmap was baked with
+	};
+
+	// Baker inputs, in meters and degrees
+	struct ServerTerrainBakeSettings
+	{
+		float maxWalkSlopeDegrees = 50.0f;
+		float stepHeight = 0.5f;   // Objects lower than this above the ground are walked over
+		float agentHeight = 2.0f;  // Objects starting higher than this are walked under
+	};
+
+	// A static object's footprint: a box turned `yaw` radians about +Y, so
+	// its local X axis points along (cos yaw, sin yaw) in world XZ
+	struct TerrainObstacle
+	{
+		float centerX = 0.0f;
+		float centerZ = 0.0f;
+		float halfExtentX = 0.0f;
+		float halfExtentZ = 0.0f;
+		float yaw = 0.0f;
+		float bottom = 0.0f; // World Y
+		float top = 0.0f;
+	};
+
+	// ============================================================
+	// SERVER TERRAIN
+	// ============================================================
+	//
+	// World coordinates throughout: x/z on the ground plane (the server's
+	// Vec2 x/y) and height along world Y (MovementComponent::height).
+
+	class ServerTerrain
+	{
+	public:
+		bool Load(const std::string& path);
+		bool Save(const std::string& path) const;
+
+		bool IsEmpty() const { return m_Chunks.empty(); }
+		uint32_t GetChunkCount() const { return static_cast<uint32_t>(m_Chunks.size()); }
+
+		// Bilinear ground height like GetTerrainHeight. False outside the
+		// exported chunks and over holes.
+		bool GetHeight(float x, float z, float& outHeight) const;
+
+		// Ground that is inside the terrain, not a hole, not steeper than the
+		// baked slope limit and not covered by a static object
+		bool IsWalkable(float x, float z) const;
+		bool IsCellWalkable(int32_t cellX, int32_t cellZ) const;
+		// Covered by a static object tall enough to block sight
+		bool IsCellBlocked(int32_t cellX, int32_t cellZ) const;
+
+		// Whether the segment between two points clears the ground and every
+		// object-blocked cell. Holes and the outside of the terrain never
+		// block. Cost grows with the number of 1 m cells crossed.
+		bool HasLineOfSight(float fromX, float fromZ, float fromHeight,
+							float toX, float toZ, float toHeight) const;
+
+		static int32_t WorldToCell(float coord)
+		{
+			return static_cast<int32_t>(std::floor(coord / SERVER_TERRAIN_CELL_SIZE));
+		}
+
+		// Cell range covered by the chunk table: [minCell, minCell + cells)
+		int32_t GetMinCellX() const { return m_Header.originChunkX * SERVER_TERRAIN_CELLS; }
+		int32_t GetMinCellZ() const { return m_Header.originChunkZ * SERVER_TERRAIN_CELLS; }
+		uint32_t GetCellsX() const { return m_Header.chunksX * SERVER_TERRAIN_CELLS; }
+		uint32_t GetCellsZ() const { return m_Header.chunksZ * SERVER_TERRAIN_CELLS; }
+
+		uint32_t CountWalkableCells() const;
+		uint32_t CountBlockedCells() const;
+
+	private:
+		friend class ServerTerrainBuilder;
+
+		struct Chunk
+		{
+			int32_t chunkX = 0;
+			int32_t chunkZ = 0;
+			float minHeight = 0.0f;
+			float heightScale = 0.0f; // Meters per quantization step
+			uint64_t holeMask = 0;
+			std::array<uint16_t, TERRAIN_CHUNK_HEIGHTMAP_SIZE> heights{};
+			std::array<uint64_t, SERVER_TERRAIN_CELLS> walkable{}; // Bit x of row z
+			std::array<uint64_t, SERVER_TERRAIN_CELLS> blocked{};
+
+			float HeightAt(int vx, int vz) const
+			{
+				return minHeight + heights[vz * TERRAIN_CHUNK_RESOLUTION + vx] * heightScale;
+			}
+			bool IsHole(int cellX, int cellZ) const
+			{
+				int hole = (cellZ / SERVER_TERRAIN_HOLE_CELLS) * TERRAIN_HOLE_GRID_SIZE + cellX / SERVER_TERRAIN_HOLE_CELLS;
+				return (holeMask & (1ULL << hole)) != 0;
+			}
+			// Bilinear within the chunk, local coordinates in [0, TERRAIN_CHUNK_SIZE]
+			float SampleHeight(float localX, float localZ) const;
+		};
+
+		const Chunk* FindChunk(int32_t chunkX, int32_t chunkZ) const
+		{
+			int64_t tx = static_cast<int64_t>(chunkX) - m_Header.originChunkX;
+			int64_t tz = static_cast<int64_t>(chunkZ) - m_Header.originChunkZ;
+			if (tx < 0 || tz < 0 || tx >= m_Header.chunksX || tz >= m_Header.chunksZ)
+				return nullptr;
+			int32_t index = m_ChunkTable[tz * m_Header.chunksX + tx];
+			return index >= 0 ? &m_Chunks[index] : nullptr;
+		}
+
+		// Chunk owning global cell (cellX, cellZ), with the cell's local index
+		const Chunk* FindCell(int32_t cellX, int32_t cellZ, int& localX, int& localZ) const;
+		Chunk* FindCell(int32_t cellX, int32_t cellZ, int& localX, int& localZ);
+
+		// Rebuilds m_ChunkTable and the header's table fields from m_Chunks
+		void BuildChunkTable();
+
+		ServerTerrainHeader m_Header;
+		std::vector<Chunk> m_Chunks;
+		std::vector<int32_t> m_ChunkTable; // -1 where no chunk was exported
+	};
+
+	// ============================================================
+	// SERVER TERRAIN BUILDER
+	// ============================================================
+	//
+	// Collects chunks and obstacles during export, then bakes walkability:
+	// a cell is walkable when it is not a hole, its quad's slope is within
+	// the limit, and no obstacle covers its center between stepHeight and
+	// agentHeight above the ground. Obstacles whose top clears agentHeight
+	// also block sight.
+
+	class ServerTerrainBuilder
+	{
+	public:
+		explicit ServerTerrainBuilder(const ServerTerrainBakeSettings& settings = {})
+			: m_Settings(settings)
+		{
+		}
+
+		void AddChunk(const TerrainChunkData& data);
+		void AddObstacle(const TerrainObstacle& obstacle) { m_Obstacles.push_back(obstacle); }
+
+		bool IsEmpty() const { return m_Chunks.empty(); }
+
+		void Build(ServerTerrain& out) const;
+
+	private:
+		ServerTerrainBakeSettings m_Settings;
+		std::vector<ServerTerrain::Chunk> m_Chunks;
+		std::unordered_map<int64_t, size_t> m_ChunkLookup;
+		std::vector<TerrainObstacle> m_Obstacles;
+	};
+
+} // namespace MMO
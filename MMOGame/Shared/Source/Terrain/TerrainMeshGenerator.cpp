@@ -5,183 +5,304 @@
 
 namespace MMO {
 
-	void GenerateTerrainMesh(const TerrainChunkData& data,
-							 const TerrainMeshOptions& options,
-							 TerrainMeshData& out)
-	{
-		if (data.heightmap.empty())
-			return;
+	namespace {
 
-		const int dataRes = TERRAIN_CHUNK_RESOLUTION;
-		const int dataQuads = dataRes - 1;
-		const int meshRes = options.meshResolution;
-		const int meshQuads = meshRes - 1;
+		constexpr int DATA_RES = TERRAIN_CHUNK_RESOLUTION;
+		constexpr int DATA_QUADS = DATA_RES - 1;
+		constexpr int FLOATS_PER_VERTEX = 8;
 
-		int totalCornerVerts = meshRes * meshRes;
-		int totalCenterVerts = options.diamondGrid ? (meshQuads * meshQuads) : 0;
-		int totalVerts = totalCornerVerts + totalCenterVerts;
-		int trisPerQuad = options.diamondGrid ? 4 : 2;
-
-		out.vertices.clear();
-		out.vertices.reserve(totalVerts * 8);
-		out.indices.clear();
-		out.indices.reserve(meshQuads * meshQuads * trisPerQuad * 3);
-
-		float meshStep = TERRAIN_CHUNK_SIZE / static_cast<float>(meshQuads);
-		float dataStep = TERRAIN_CHUNK_SIZE / static_cast<float>(dataQuads);
+		// Heights of one chunk, with cross-chunk boundary support
+		struct HeightSource
+		{
+			const TerrainChunkData& data;
+			const TerrainMeshOptions& options;
 
-		// Height sampling with cross-chunk boundary support
-		auto sampleHeightInt = [&](int sx, int sz) -> float {
-			if (sx >= 0 && sx < dataRes && sz >= 0 && sz < dataRes)
+			float SampleInt(int sx, int sz) const
 			{
-				return data.heightmap[sz * dataRes + sx];
+				if (sx >= 0 && sx < DATA_RES && sz >= 0 && sz < DATA_RES)
+				{
+					return data.heightmap[sz * DATA_RES + sx];
+				}
+				if (options.heightSampler)
+				{
+					return options.heightSampler(data.chunkX, data.chunkZ, sx, sz);
+				}
+				sx = std::clamp(sx, 0, DATA_RES - 1);
+				sz = std::clamp(sz, 0, DATA_RES - 1);
+				return data.heightmap[sz * DATA_RES + sx];
 			}
-			if (options.heightSampler)
+
+			// Bilinear interpolation for variable-resolution meshes
+			float SampleBilinear(float fx, float fz) const
 			{
-				return options.heightSampler(data.chunkX, data.chunkZ, sx, sz);
+				fx = std::clamp(fx, 0.0f, static_cast<float>(DATA_RES - 1));
+				fz = std::clamp(fz, 0.0f, static_cast<float>(DATA_RES - 1));
+				int x0 = std::min(static_cast<int>(fx), DATA_RES - 2);
+				int z0 = std::min(static_cast<int>(fz), DATA_RES - 2);
+				float tx = fx - x0;
+				float tz = fz - z0;
+				float h00 = data.heightmap[z0 * DATA_RES + x0];
+				float h10 = data.heightmap[z0 * DATA_RES + x0 + 1];
+				float h01 = data.heightmap[(z0 + 1) * DATA_RES + x0];
+				float h11 = data.heightmap[(z0 + 1) * DATA_RES + x0 + 1];
+				return h00 * (1 - tx) * (1 - tz) + h10 * tx * (1 - tz) +
+					   h01 * (1 - tx) * tz + h11 * tx * tz;
 			}
-			sx = std::clamp(sx, 0, dataRes - 1);
-			sz = std::clamp(sz, 0, dataRes - 1);
-			return data.heightmap[sz * dataRes + sx];
 		};
 
-		// Bilinear interpolation for variable-resolution meshes
-		auto sampleHeightBilinear = [&](float fx, float fz) -> float {
-			fx = std::clamp(fx, 0.0f, static_cast<float>(dataRes - 1));
-			fz = std::clamp(fz, 0.0f, static_cast<float>(dataRes - 1));
-			int x0 = std::min(static_cast<int>(fx), dataRes - 2);
-			int z0 = std::min(static_cast<int>(fz), dataRes - 2);
-			float tx = fx - x0;
-			float tz = fz - z0;
-			float h00 = data.heightmap[z0 * dataRes + x0];
-			float h10 = data.heightmap[z0 * dataRes + x0 + 1];
-			float h01 = data.heightmap[(z0 + 1) * dataRes + x0];
-			float h11 = data.heightmap[(z0 + 1) * dataRes + x0 + 1];
-			return h00 * (1 - tx) * (1 - tz) + h10 * tx * (1 - tz) +
-				   h01 * (1 - tx) * tz + h11 * tx * tz;
-		};
+		// Lower data cell of a bilinear sample, as SampleBilinear picks it
+		int DataCell(float f)
+		{
+			f = std::clamp(f, 0.0f, static_cast<float>(DATA_RES - 1));
+			return std::min(static_cast<int>(f), DATA_RES - 2);
+		}
 
-		// --- Compute normals at data resolution ---
-		const int dataTotalVerts = dataRes * dataRes;
-		std::vector<glm::vec3> dataNormals(dataTotalVerts);
+		glm::vec3 SobelNormal(const HeightSource& heights, int x, int z, float dataStep)
+		{
+			float h00 = heights.SampleInt(x - 1, z - 1);
+			float h10 = heights.SampleInt(x, z - 1);
+			float h20 = heights.SampleInt(x + 1, z - 1);
+			float h01 = heights.SampleInt(x - 1, z);
+			float h21 = heights.SampleInt(x + 1, z);
+			float h02 = heights.SampleInt(x - 1, z + 1);
+			float h12 = heights.SampleInt(x, z + 1);
+			float h22 = heights.SampleInt(x + 1, z + 1);
+
+			float gx = -h00 + h20 - 2.0f * h01 + 2.0f * h21 - h02 + h22;
+			float gz = h00 + 2.0f * h10 + h20 - h02 - 2.0f * h12 - h22;
+
+			return glm::normalize(glm::vec3(-gx, 8.0f * dataStep, -gz));
+		}
 
-		for (int z = 0; z < dataRes; z++)
+		glm::vec3 CentralDifferenceNormal(const HeightSource& heights, int x, int z, float dataStep)
 		{
-			for (int x = 0; x < dataRes; x++)
-			{
-				glm::vec3 normal;
+			float hL = heights.SampleInt(x - 1, z);
+			float hR = heights.SampleInt(x + 1, z);
+			float hD = heights.SampleInt(x, z - 1);
+			float hU = heights.SampleInt(x, z + 1);
 
-				if (options.sobelNormals)
-				{
-					float h00 = sampleHeightInt(x - 1, z - 1);
-					float h10 = sampleHeightInt(x, z - 1);
-					float h20 = sampleHeightInt(x + 1, z - 1);
-					float h01 = sampleHeightInt(x - 1, z);
-					float h21 = sampleHeightInt(x + 1, z);
-					float h02 = sampleHeightInt(x - 1, z + 1);
-					float h12 = sampleHeightInt(x, z + 1);
-					float h22 = sampleHeightInt(x + 1, z + 1);
-
-					float gx = -h00 + h20 - 2.0f * h01 + 2.0f * h21 - h02 + h22;
-					float gz = h00 + 2.0f * h10 + h20 - h02 - 2.0f * h12 - h22;
-
-					normal = glm::normalize(glm::vec3(-gx, 8.0f * dataStep, -gz));
-				}
-				else
-				{
-					float hL = sampleHeightInt(x - 1, z);
-					float hR = sampleHeightInt(x + 1, z);
-					float hD = sampleHeightInt(x, z - 1);
-					float hU = sampleHeightInt(x, z + 1);
+			return glm::normalize(glm::vec3(hL - hR, 2.0f * dataStep, hD - hU));
+		}
 
-					normal = glm::normalize(glm::vec3(hL - hR, 2.0f * dataStep, hD - hU));
-				}
+		// Normals at data resolution over an in-chunk window of data vertices.
+		// Every normal depends only on its own neighborhood, so a window gives
+		// the same values as the whole chunk.
+		struct NormalWindow
+		{
+			int x0 = 0, z0 = 0, width = 0, height = 0;
+			std::vector<glm::vec3> normals;
+
+			const glm::vec3& At(int x, int z) const { return normals[(z - z0) * width + (x - x0)]; }
 
-				dataNormals[z * dataRes + x] = normal;
+			// Bilinear normal interpolation for variable-resolution meshes
+			glm::vec3 SampleBilinear(float fx, float fz) const
+			{
+				fx = std::clamp(fx, 0.0f, static_cast<float>(DATA_RES - 1));
+				fz = std::clamp(fz, 0.0f, static_cast<float>(DATA_RES - 1));
+				int cx = std::min(static_cast<int>(fx), DATA_RES - 2);
+				int cz = std::min(static_cast<int>(fz), DATA_RES - 2);
+				float tx = fx - cx;
+				float tz = fz - cz;
+				glm::vec3 n00 = At(cx, cz);
+				glm::vec3 n10 = At(cx + 1, cz);
+				glm::vec3 n01 = At(cx, cz + 1);
+				glm::vec3 n11 = At(cx + 1, cz + 1);
+				return glm::normalize(n00 * (1 - tx) * (1 - tz) + n10 * tx * (1 - tz) +
+									  n01 * (1 - tx) * tz + n11 * tx * tz);
 			}
-		}
+		};
 
-		// --- Optional 5-tap smooth filter ---
-		if (options.smoothNormals)
+		void ComputeNormals(const HeightSource& heights, int minX, int minZ, int maxX, int maxZ, NormalWindow& out)
 		{
-			auto computeSobelAt = [&](int sx, int sz) -> glm::vec3 {
-				float h00 = sampleHeightInt(sx - 1, sz - 1);
-				float h10 = sampleHeightInt(sx, sz - 1);
-				float h20 = sampleHeightInt(sx + 1, sz - 1);
-				float h01 = sampleHeightInt(sx - 1, sz);
-				float h21 = sampleHeightInt(sx + 1, sz);
-				float h02 = sampleHeightInt(sx - 1, sz + 1);
-				float h12 = sampleHeightInt(sx, sz + 1);
-				float h22 = sampleHeightInt(sx + 1, sz + 1);
-				float gx = -h00 + h20 - 2.0f * h01 + 2.0f * h21 - h02 + h22;
-				float gz = h00 + 2.0f * h10 + h20 - h02 - 2.0f * h12 - h22;
-				return glm::normalize(glm::vec3(-gx, 8.0f * dataStep, -gz));
-			};
+			const TerrainMeshOptions& options = heights.options;
+			const float dataStep = TERRAIN_CHUNK_SIZE / static_cast<float>(DATA_QUADS);
+
+			// The smooth filter reads the unfiltered normals one vertex around
+			const int pad = options.smoothNormals ? 1 : 0;
+			NormalWindow raw;
+			raw.x0 = std::max(minX - pad, 0);
+			raw.z0 = std::max(minZ - pad, 0);
+			raw.width = std::min(maxX + pad, DATA_RES - 1) - raw.x0 + 1;
+			raw.height = std::min(maxZ + pad, DATA_RES - 1) - raw.z0 + 1;
+			raw.normals.resize(raw.width * raw.height);
+
+			for (int z = raw.z0; z < raw.z0 + raw.height; z++)
+			{
+				glm::vec3* row = &raw.normals[(z - raw.z0) * raw.width];
+				for (int x = raw.x0; x < raw.x0 + raw.width; x++)
+				{
+					row[x - raw.x0] = options.sobelNormals ? SobelNormal(heights, x, z, dataStep)
+														   : CentralDifferenceNormal(heights, x, z, dataStep);
+				}
+			}
+
+			if (!options.smoothNormals)
+			{
+				out = std::move(raw);
+				return;
+			}
 
+			// --- 5-tap smooth filter ---
 			auto getNormal = [&](int nx, int nz) -> glm::vec3 {
-				if (nx >= 0 && nx < dataRes && nz >= 0 && nz < dataRes)
-					return dataNormals[nz * dataRes + nx];
-				return computeSobelAt(nx, nz);
+				if (nx >= 0 && nx < DATA_RES && nz >= 0 && nz < DATA_RES)
+					return raw.At(nx, nz);
+				return SobelNormal(heights, nx, nz, dataStep);
 			};
 
-			std::vector<glm::vec3> smoothed(dataTotalVerts);
-			for (int z = 0; z < dataRes; z++)
+			out.x0 = minX;
+			out.z0 = minZ;
+			out.width = maxX - minX + 1;
+			out.height = maxZ - minZ + 1;
+			out.normals.resize(out.width * out.height);
+			for (int z = minZ; z <= maxZ; z++)
 			{
-				for (int x = 0; x < dataRes; x++)
+				for (int x = minX; x <= maxX; x++)
 				{
-					glm::vec3 sum = dataNormals[z * dataRes + x];
+					glm::vec3 sum = raw.At(x, z);
 					sum += getNormal(x - 1, z);
 					sum += getNormal(x + 1, z);
 					sum += getNormal(x, z - 1);
 					sum += getNormal(x, z + 1);
-					smoothed[z * dataRes + x] = glm::normalize(sum / 5.0f);
+					out.normals[(z - minZ) * out.width + (x - minX)] = glm::normalize(sum / 5.0f);
 				}
 			}
-			dataNormals = std::move(smoothed);
 		}
 
-		// Bilinear normal interpolation for variable-resolution meshes
-		auto sampleNormalBilinear = [&](float fx, float fz) -> glm::vec3 {
-			fx = std::clamp(fx, 0.0f, static_cast<float>(dataRes - 1));
-			fz = std::clamp(fz, 0.0f, static_cast<float>(dataRes - 1));
-			int x0 = std::min(static_cast<int>(fx), dataRes - 2);
-			int z0 = std::min(static_cast<int>(fz), dataRes - 2);
-			float tx = fx - x0;
-			float tz = fz - z0;
-			glm::vec3 n00 = dataNormals[z0 * dataRes + x0];
-			glm::vec3 n10 = dataNormals[z0 * dataRes + x0 + 1];
-			glm::vec3 n01 = dataNormals[(z0 + 1) * dataRes + x0];
-			glm::vec3 n11 = dataNormals[(z0 + 1) * dataRes + x0 + 1];
-			return glm::normalize(n00 * (1 - tx) * (1 - tz) + n10 * tx * (1 - tz) +
-								  n01 * (1 - tx) * tz + n11 * tx * tz);
+		struct MeshLayout
+		{
+			int meshRes;
+			int meshQuads;
+			float meshStep;
+			float worldOriginX;
+			float worldOriginZ;
+
+			MeshLayout(const TerrainChunkData& data, const TerrainMeshOptions& options)
+				: meshRes(options.meshResolution),
+				  meshQuads(options.meshResolution - 1),
+				  meshStep(TERRAIN_CHUNK_SIZE / static_cast<float>(options.meshResolution - 1)),
+				  worldOriginX(data.chunkX * TERRAIN_CHUNK_SIZE),
+				  worldOriginZ(data.chunkZ * TERRAIN_CHUNK_SIZE)
+			{
+			}
+
+			float CornerData(int i) const { return i * static_cast<float>(DATA_QUADS) / meshQuads; }
+			float CenterData(int i) const { return (i + 0.5f) * static_cast<float>(DATA_QUADS) / meshQuads; }
 		};
 
-		// --- Build corner vertices ---
-		float worldOriginX = data.chunkX * TERRAIN_CHUNK_SIZE;
-		float worldOriginZ = data.chunkZ * TERRAIN_CHUNK_SIZE;
+		float* WriteVertex(float* v, float px, float py, float pz, const glm::vec3& n, float u, float w)
+		{
+			v[0] = px;
+			v[1] = py;
+			v[2] = pz;
+			v[3] = n.x;
+			v[4] = n.y;
+			v[5] = n.z;
+			v[6] = u;
+			v[7] = w;
+			return v + FLOATS_PER_VERTEX;
+		}
 
-		for (int z = 0; z < meshRes; z++)
+		float* WriteCornerVertex(float* v, const MeshLayout& layout, const HeightSource& heights,
+								 const NormalWindow& normals, int x, int z)
 		{
-			for (int x = 0; x < meshRes; x++)
+			float hx = layout.CornerData(x);
+			float hz = layout.CornerData(z);
+			return WriteVertex(v, layout.worldOriginX + x * layout.meshStep, heights.SampleBilinear(hx, hz),
+							   layout.worldOriginZ + z * layout.meshStep, normals.SampleBilinear(hx, hz),
+							   static_cast<float>(x) / layout.meshQuads, static_cast<float>(z) / layout.meshQuads);
+		}
+
+		float* WriteCenterVertex(float* v, const MeshLayout& layout, const HeightSource& heights,
+								 const NormalWindow& normals, int x, int z)
+		{
+			float hx = layout.CenterData(x);
+			float hz = layout.CenterData(z);
+			return WriteVertex(v, layout.worldOriginX + (x + 0.5f) * layout.meshStep, heights.SampleBilinear(hx, hz),
+							   layout.worldOriginZ + (z + 0.5f) * layout.meshStep, normals.SampleBilinear(hx, hz),
+							   (x + 0.5f) / layout.meshQuads, (z + 0.5f) / layout.meshQuads);
+		}
+
+		// Padded heightmap for shader normal computation
+		void BuildPaddedHeightmap(const HeightSource& heights, std::vector<float>& out, int& outResolution)
+		{
+			const int pRes = DATA_RES + 2;
+			outResolution = pRes;
+			out.resize(pRes * pRes);
+
+			for (int z = 0; z < DATA_RES; z++)
+				for (int x = 0; x < DATA_RES; x++)
+					out[(z + 1) * pRes + (x + 1)] = heights.data.heightmap[z * DATA_RES + x];
+
+			for (int z = -1; z <= DATA_RES; z++)
+			{
+				out[(z + 1) * pRes + 0] = heights.SampleInt(-1, z);
+				out[(z + 1) * pRes + (pRes - 1)] = heights.SampleInt(DATA_RES, z);
+			}
+			for (int x = 0; x < DATA_RES; x++)
 			{
-				float hx = x * static_cast<float>(dataQuads) / meshQuads;
-				float hz = z * static_cast<float>(dataQuads) / meshQuads;
+				out[0 * pRes + (x + 1)] = heights.SampleInt(x, -1);
+				out[(pRes - 1) * pRes + (x + 1)] = heights.SampleInt(x, DATA_RES);
+			}
+		}
 
-				float px = worldOriginX + x * meshStep;
-				float pz = worldOriginZ + z * meshStep;
-				float py = sampleHeightBilinear(hx, hz);
+		// Mesh vertices [first, last] along one axis whose bilinear cell
+		// touches data vertices [minData, maxData]; false if none do
+		template <typename ToData>
+		bool FindAffectedSpan(int count, int minData, int maxData, ToData toData, int& first, int& last)
+		{
+			first = -1;
+			last = -1;
+			for (int i = 0; i < count; i++)
+			{
+				int cell = DataCell(toData(i));
+				if (cell + 1 >= minData && cell <= maxData)
+				{
+					if (first < 0)
+						first = i;
+					last = i;
+				}
+				else if (first >= 0)
+				{
+					break;
+				}
+			}
+			return first >= 0;
+		}
 
-				out.vertices.push_back(px);
-				out.vertices.push_back(py);
-				out.vertices.push_back(pz);
+	} // namespace
 
-				glm::vec3 n = sampleNormalBilinear(hx, hz);
-				out.vertices.push_back(n.x);
-				out.vertices.push_back(n.y);
-				out.vertices.push_back(n.z);
+	void GenerateTerrainMesh(const TerrainChunkData& data,
+							 const TerrainMeshOptions& options,
+							 TerrainMeshData& out)
+	{
+		if (data.heightmap.empty())
+			return;
 
-				out.vertices.push_back(static_cast<float>(x) / meshQuads);
-				out.vertices.push_back(static_cast<float>(z) / meshQuads);
+		const HeightSource heights{data, options};
+		const MeshLayout layout(data, options);
+		const int meshRes = layout.meshRes;
+		const int meshQuads = layout.meshQuads;
+
+		int totalCornerVerts = meshRes * meshRes;
+		int totalCenterVerts = options.diamondGrid ? (meshQuads * meshQuads) : 0;
+		int totalVerts = totalCornerVerts + totalCenterVerts;
+		int trisPerQuad = options.diamondGrid ? 4 : 2;
+
+		out.vertices.resize(totalVerts * FLOATS_PER_VERTEX);
+		out.indices.clear();
+		out.indices.reserve(meshQuads * meshQuads * trisPerQuad * 3);
+
+		// --- Compute normals at data resolution ---
+		NormalWindow normals;
+		ComputeNormals(heights, 0, 0, DATA_RES - 1, DATA_RES - 1, normals);
+
+		// --- Build corner vertices ---
+		float* v = out.vertices.data();
+		for (int z = 0; z < meshRes; z++)
+		{
+			for (int x = 0; x < meshRes; x++)
+			{
+				v = WriteCornerVertex(v, layout, heights, normals, x, z);
 			}
 		}
 
@@ -192,24 +313,7 @@ namespace MMO {
 			{
 				for (int x = 0; x < meshQuads; x++)
 				{
-					float hx = (x + 0.5f) * static_cast<float>(dataQuads) / meshQuads;
-					float hz = (z + 0.5f) * static_cast<float>(dataQuads) / meshQuads;
-
-					float cx = worldOriginX + (x + 0.5f) * meshStep;
-					float cz = worldOriginZ + (z + 0.5f) * meshStep;
-					float cy = sampleHeightBilinear(hx, hz);
-
-					out.vertices.push_back(cx);
-					out.vertices.push_back(cy);
-					out.vertices.push_back(cz);
-
-					glm::vec3 cn = sampleNormalBilinear(hx, hz);
-					out.vertices.push_back(cn.x);
-					out.vertices.push_back(cn.y);
-					out.vertices.push_back(cn.z);
-
-					out.vertices.push_back((x + 0.5f) / meshQuads);
-					out.vertices.push_back((z + 0.5f) / meshQuads);
+					v = WriteCenterVertex(v, layout, heights, normals, x, z);
 				}
 			}
 		}
@@ -262,26 +366,9 @@ namespace MMO {
 		out.indexCount = static_cast<uint32_t>(out.indices.size());
 
 		// --- Padded heightmap for shader normal computation (optional) ---
-		if (options.generatePaddedHeightmap && !data.heightmap.empty())
+		if (options.generatePaddedHeightmap)
 		{
-			const int pRes = TERRAIN_CHUNK_RESOLUTION + 2;
-			out.paddedHeightmapResolution = pRes;
-			out.paddedHeightmap.resize(pRes * pRes);
-
-			for (int z = 0; z < TERRAIN_CHUNK_RESOLUTION; z++)
-				for (int x = 0; x < TERRAIN_CHUNK_RESOLUTION; x++)
-					out.paddedHeightmap[(z + 1) * pRes + (x + 1)] = data.heightmap[z * TERRAIN_CHUNK_RESOLUTION + x];
-
-			for (int z = -1; z <= TERRAIN_CHUNK_RESOLUTION; z++)
-			{
-				out.paddedHeightmap[(z + 1) * pRes + 0] = sampleHeightInt(-1, z);
-				out.paddedHeightmap[(z + 1) * pRes + (pRes - 1)] = sampleHeightInt(TERRAIN_CHUNK_RESOLUTION, z);
-			}
-			for (int x = 0; x < TERRAIN_CHUNK_RESOLUTION; x++)
-			{
-				out.paddedHeightmap[0 * pRes + (x + 1)] = sampleHeightInt(x, -1);
-				out.paddedHeightmap[(pRes - 1) * pRes + (x + 1)] = sampleHeightInt(x, TERRAIN_CHUNK_RESOLUTION);
-			}
+			BuildPaddedHeightmap(heights, out.paddedHeightmap, out.paddedHeightmapResolution);
 		}
 
 		// --- Split splatmap into two RGBA textures ---
@@ -291,4 +378,97 @@ namespace MMO {
 		}
 	}
 
+	void GenerateTerrainMeshRegion(const TerrainChunkData& data,
+								   const TerrainMeshOptions& options,
+								   const TerrainVertexRect& changed,
+								   TerrainMeshRegionData& out)
+	{
+		out.cornerWidth = out.cornerHeight = 0;
+		out.centerWidth = out.centerHeight = 0;
+		out.cornerVertices.clear();
+		out.centerVertices.clear();
+		out.paddedHeightmap.clear();
+		out.paddedHeightmapResolution = 0;
+
+		if (data.heightmap.empty() || changed.IsEmpty())
+			return;
+
+		const HeightSource heights{data, options};
+		const MeshLayout layout(data, options);
+
+		// Data vertices whose normal can change: Sobel and central differences
+		// read one vertex around, the smooth filter one more
+		const int reach = options.smoothNormals ? 2 : 1;
+		const int minX = std::max(changed.minX - reach, 0);
+		const int minZ = std::max(changed.minZ - reach, 0);
+		const int maxX = std::min(changed.maxX + reach, DATA_RES - 1);
+		const int maxZ = std::min(changed.maxZ + reach, DATA_RES - 1);
+		if (maxX < minX || maxZ < minZ)
+			return;
+
+		auto cornerData = [&](int i) { return layout.CornerData(i); };
+		auto centerData = [&](int i) { return layout.CenterData(i); };
+
+		int cx0, cx1, cz0, cz1;
+		bool corners = FindAffectedSpan(layout.meshRes, minX, maxX, cornerData, cx0, cx1) &&
+					   FindAffectedSpan(layout.meshRes, minZ, maxZ, cornerData, cz0, cz1);
+		int dx0 = 0, dx1 = -1, dz0 = 0, dz1 = -1;
+		bool centers = options.diamondGrid &&
+					   FindAffectedSpan(layout.meshQuads, minX, maxX, centerData, dx0, dx1) &&
+					   FindAffectedSpan(layout.meshQuads, minZ, maxZ, centerData, dz0, dz1);
+		if (!corners && !centers)
+			return;
+
+		// Normals under every regenerated vertex's cell
+		int nx0 = DATA_RES, nz0 = DATA_RES, nx1 = -1, nz1 = -1;
+		auto include = [](int& lo, int& hi, int cellLo, int cellHi) {
+			lo = std::min(lo, cellLo);
+			hi = std::max(hi, cellHi + 1);
+		};
+		if (corners)
+		{
+			include(nx0, nx1, DataCell(layout.CornerData(cx0)), DataCell(layout.CornerData(cx1)));
+			include(nz0, nz1, DataCell(layout.CornerData(cz0)), DataCell(layout.CornerData(cz1)));
+		}
+		if (centers)
+		{
+			include(nx0, nx1, DataCell(layout.CenterData(dx0)), DataCell(layout.CenterData(dx1)));
+			include(nz0, nz1, DataCell(layout.CenterData(dz0)), DataCell(layout.CenterData(dz1)));
+		}
+
+		NormalWindow normals;
+		ComputeNormals(heights, nx0, nz0, nx1, nz1, normals);
+
+		if (corners)
+		{
+			out.cornerX = cx0;
+			out.cornerZ = cz0;
+			out.cornerWidth = cx1 - cx0 + 1;
+			out.cornerHeight = cz1 - cz0 + 1;
+			out.cornerVertices.resize(out.cornerWidth * out.cornerHeight * FLOATS_PER_VERTEX);
+			float* v = out.cornerVertices.data();
+			for (int z = cz0; z <= cz1; z++)
+				for (int x = cx0; x <= cx1; x++)
+					v = WriteCornerVertex(v, layout, heights, normals, x, z);
+		}
+
+		if (centers)
+		{
+			out.centerX = dx0;
+			out.centerZ = dz0;
+			out.centerWidth = dx1 - dx0 + 1;
+			out.centerHeight = dz1 - dz0 + 1;
+			out.centerVertices.resize(out.centerWidth * out.centerHeight * FLOATS_PER_VERTEX);
+			float* v = out.centerVertices.data();
+			for (int z = dz0; z <= dz1; z++)
+				for (int x = dx0; x <= dx1; x++)
+					v = WriteCenterVertex(v, layout, heights, normals, x, z);
+		}
+
+		if (options.generatePaddedHeightmap)
+		{
+			BuildPaddedHeightmap(heights, out.paddedHeightmap, out.paddedHeightmapResolution);
+		}
+	}
+
 } // namespace MMO
@@ -32,10 +32,49 @@ namespace MMO {
 		std::vector<uint8_t> splatmapRGBA1; // TERRAIN_SPLATMAP_TEXELS * 4
 	};
 
+	// Heightmap vertices, inclusive, in the chunk's local grid. May reach past
+	// the chunk (negative or > TERRAIN_CHUNK_RESOLUTION - 1) for heights a
+	// neighbor changed along the shared border.
+	struct TerrainVertexRect
+	{
+		int minX = 0;
+		int minZ = 0;
+		int maxX = -1;
+		int maxZ = -1;
+
+		bool IsEmpty() const { return maxX < minX || maxZ < minZ; }
+	};
+
+	// The vertices of a TerrainMeshData that a height change can reach, for
+	// partial re-upload. Corners are the sub-grid [cornerX, cornerX +
+	// cornerWidth) x [cornerZ, cornerZ + cornerHeight) of the meshRes x meshRes
+	// grid, row-major; centers the same of the meshQuads x meshQuads diamond
+	// centers that follow it. Values are bit-identical to the full mesh.
+	struct TerrainMeshRegionData
+	{
+		int cornerX = 0, cornerZ = 0, cornerWidth = 0, cornerHeight = 0;
+		std::vector<float> cornerVertices; // pos(3) + normal(3) + uv(2) per vertex
+		int centerX = 0, centerZ = 0, centerWidth = 0, centerHeight = 0;
+		std::vector<float> centerVertices;
+		std::vector<float> paddedHeightmap; // Whole, when generatePaddedHeightmap
+		int paddedHeightmapResolution = 0;
+
+		bool IsEmpty() const { return cornerVertices.empty() && centerVertices.empty(); }
+	};
+
 	// Pure CPU mesh generation — no GL calls, thread-safe.
 	// Generates vertices, indices, optionally padded heightmap and split splatmaps.
 	void GenerateTerrainMesh(const TerrainChunkData& data,
 							 const TerrainMeshOptions& options,
 							 TerrainMeshData& out);
 
+	// Regenerates only the vertices whose height or normal depends on the
+	// heights in `changed`: normals read one vertex around them, two with
+	// smoothNormals. Indices and splatmaps are untouched by height edits and
+	// are not produced.
+	void GenerateTerrainMeshRegion(const TerrainChunkData& data,
+								   const TerrainMeshOptions& options,
+								   const TerrainVertexRect& changed,
+								   TerrainMeshRegionData& out);
+
 } // namespace MMO
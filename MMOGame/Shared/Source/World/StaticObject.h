@@ -44,14 +44,22 @@ namespace MMO {
 			: WorldObject(guid, WorldObjectType::STATIC_OBJECT, name) {}
 
 		// Model
-		void SetModelPath(const std::string& path) { m_ModelPath = path; }
+		void SetModelPath(const std::string& path)
+		{
+			m_ModelPath = path;
+			MarkChanged();
+		}
 		const std::string& GetModelPath() const { return m_ModelPath; }
 
 		void SetModelId(uint32_t id) { m_ModelId = id; }
 		uint32_t GetModelId() const { return m_ModelId; }
 
 		// Material (reference to MaterialLibrary)
-		void SetMaterialId(const std::string& id) { m_MaterialId = id; }
+		void SetMaterialId(const std::string& id)
+		{
+			m_MaterialId = id;
+			MarkChanged();
+		}
 		const std::string& GetMaterialId() const { return m_MaterialId; }
 
 		// Collision
@@ -62,16 +70,25 @@ namespace MMO {
 		bool HasCollision() const { return m_Collider.type != ColliderType::NONE; }
 
 		// Animation support (for animated models)
-		void AddAnimationPath(const std::string& path) { m_AnimationPaths.push_back(path); }
+		void AddAnimationPath(const std::string& path)
+		{
+			m_AnimationPaths.push_back(path);
+			MarkChanged();
+		}
 		void RemoveAnimationPath(size_t index)
 		{
 			if (index < m_AnimationPaths.size())
 			{
 				m_AnimationPaths.erase(m_AnimationPaths.begin() + index);
+				MarkChanged();
 			}
 		}
 		const std::vector<std::string>& GetAnimationPaths() const { return m_AnimationPaths; }
-		void ClearAnimationPaths() { m_AnimationPaths.clear(); }
+		void ClearAnimationPaths()
+		{
+			m_AnimationPaths.clear();
+			MarkChanged();
+		}
 
 		void SetCurrentAnimation(const std::string& name) { m_CurrentAnimation = name; }
 		const std::string& GetCurrentAnimation() const { return m_CurrentAnimation; }
@@ -100,21 +117,28 @@ namespace MMO {
 		void SetMeshMaterial(const std::string& meshName, const MeshMaterial& material)
 		{
 			m_MeshMaterials[meshName] = material;
+			MarkChanged();
 		}
 		const MeshMaterial* GetMeshMaterial(const std::string& meshName) const
 		{
 			auto it = m_MeshMaterials.find(meshName);
 			return it != m_MeshMaterials.end() ? &it->second : nullptr;
 		}
+		// The reference is for editing, so the object counts as changed
 		MeshMaterial& GetOrCreateMeshMaterial(const std::string& meshName)
 		{
+			MarkChanged();
 			return m_MeshMaterials[meshName];
 		}
 		const std::unordered_map<std::string, MeshMaterial>& GetAllMeshMaterials() const
 		{
 			return m_MeshMaterials;
 		}
-		void ClearMeshMaterials() { m_MeshMaterials.clear(); }
+		void ClearMeshMaterials()
+		{
+			m_MeshMaterials.clear();
+			MarkChanged();
+		}
 
 		const char* GetTypeName() const override { return "Static Object"; }
 
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace MMO {
 
@@ -22,6 +23,14 @@ namespace MMO {
 		GROUP,			  // Container for organizing objects
 	};
 
+	// Guids of objects changed since the consumer last took the log (the
+	// editor's retained render scene). An object queues itself once per take.
+	struct WorldChangeLog
+	{
+		std::vector<uint64_t> changed; // Added, modified or removed
+		bool all = false;			   // Every object was replaced (map cleared)
+	};
+
 	class WorldObject
 	{
 	public:
@@ -37,27 +46,64 @@ namespace MMO {
 		const std::string& GetName() const { return m_Name; }
 		void SetName(const std::string& name) { m_Name = name; }
 
+		// Change tracking: setters that affect placement or rendering queue the
+		// object in its world's log. Objects outside a world have no log.
+		void SetChangeLog(WorldChangeLog* log)
+		{
+			m_ChangeLog = log;
+			m_ChangeQueued = false;
+		}
+		void MarkChanged()
+		{
+			if (m_ChangeLog && !m_ChangeQueued)
+			{
+				m_ChangeLog->changed.push_back(m_Guid);
+				m_ChangeQueued = true;
+			}
+		}
+		void ClearChangeQueued() { m_ChangeQueued = false; }
+
 		// Transform
 		Transform& GetTransform() { return m_Transform; }
 		const Transform& GetTransform() const { return m_Transform; }
 
-		void SetPosition(const glm::vec3& pos) { m_Transform.position = pos; }
+		void SetPosition(const glm::vec3& pos)
+		{
+			m_Transform.position = pos;
+			MarkChanged();
+		}
 		const glm::vec3& GetPosition() const { return m_Transform.position; }
 
-		void SetRotation(const glm::quat& rot) { m_Transform.rotation = rot; }
+		void SetRotation(const glm::quat& rot)
+		{
+			m_Transform.rotation = rot;
+			MarkChanged();
+		}
 		const glm::quat& GetRotation() const { return m_Transform.rotation; }
 
-		void SetScale(float scale) { m_Transform.scale = scale; }
+		void SetScale(float scale)
+		{
+			m_Transform.scale = scale;
+			MarkChanged();
+		}
 		float GetScale() const { return m_Transform.scale; }
 
-		void SetEulerAngles(const glm::vec3& euler) { m_Transform.SetEulerAngles(euler); }
+		void SetEulerAngles(const glm::vec3& euler)
+		{
+			m_Transform.SetEulerAngles(euler);
+			MarkChanged();
+		}
 		glm::vec3 GetEulerAngles() const { return m_Transform.GetEulerAngles(); }
 
 		// Local transform matrix (relative to parent)
 		glm::mat4 GetLocalMatrix() const { return m_Transform.GetMatrix(); }
 
 		// Parent-child hierarchy
-		void SetParent(uint64_t parentGuid) { m_ParentGuid = parentGuid; }
+		void SetParent(uint64_t parentGuid)
+		{
+			m_ParentGuid = parentGuid;
+			MarkChanged();
+		}
 		uint64_t GetParentGuid() const { return m_ParentGuid; }
 		bool HasParent() const { return m_ParentGuid != 0; }
 
@@ -66,7 +112,11 @@ namespace MMO {
 		void SetSelected(bool selected) { m_Selected = selected; }
 
 		bool IsVisible() const { return m_Visible; }
-		void SetVisible(bool visible) { m_Visible = visible; }
+		void SetVisible(bool visible)
+		{
+			m_Visible = visible;
+			MarkChanged();
+		}
 
 		bool IsLocked() const { return m_Locked; }
 		void SetLocked(bool locked) { m_Locked = locked; }
@@ -88,6 +138,9 @@ namespace MMO {
 		bool m_Selected = false;
 		bool m_Visible = true;
 		bool m_Locked = false;
+
+		WorldChangeLog* m_ChangeLog = nullptr;
+		bool m_ChangeQueued = false;
 	};
 
 } // namespace MMO
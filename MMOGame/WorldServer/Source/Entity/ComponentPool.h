@@ -0,0 +1,235 @@
+#pragma once
+
+#include "AuraComponent.h"
+#include "Components.h"
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace MMO {
+
+	class Entity;
+
+	// ============================================================
+	// ENTITY HANDLE
+	// ============================================================
+
+	// Slot in a ComponentStore. The generation changes every time the slot is
+	// reused, so a stale handle never resolves to a newer entity.
+	struct EntityHandle
+	{
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool IsValid() const { return index != UINT32_MAX; }
+		bool operator==(const EntityHandle& other) const = default;
+	};
+
+	// ============================================================
+	// COMPONENT POOL
+	// ============================================================
+	//
+	// Dense storage for one component type. Components sit in fixed-size
+	// blocks, so adding never moves existing ones: a pointer from Get() stays
+	// valid while the tick runs, even if scripts spawn or despawn entities.
+	// Remove() only leaves a tombstone (null owner); Compact() swap-removes the
+	// tombstones at the end of the tick, which is the one point where
+	// components move.
+	//
+	// Systems iterate 0..Size() and skip slots whose owner is null.
+
+	template <typename T>
+	class ComponentPool
+	{
+	public:
+		static constexpr uint32_t BLOCK_SHIFT = 8;
+		static constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_SHIFT;
+		static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+		// Replaces the component if the entity already has one
+		T* Add(EntityHandle handle, Entity* owner, T component = T{})
+		{
+			if (handle.index >= m_Sparse.size())
+				m_Sparse.resize(handle.index + 1, INVALID_SLOT);
+
+			uint32_t slot = m_Sparse[handle.index];
+			if (slot == INVALID_SLOT)
+			{
+				slot = static_cast<uint32_t>(m_Owners.size());
+				if ((slot >> BLOCK_SHIFT) >= m_Blocks.size())
+					m_Blocks.push_back(std::make_unique<T[]>(BLOCK_SIZE));
+				m_Owners.push_back(owner);
+				m_Handles.push_back(handle);
+				m_Sparse[handle.index] = slot;
+			}
+			m_Handles[slot] = handle;
+
+			T& stored = At(slot);
+			stored = std::move(component);
+			return &stored;
+		}
+
+		T* Get(EntityHandle handle)
+		{
+			uint32_t slot = SlotOf(handle);
+			return slot != INVALID_SLOT ? &At(slot) : nullptr;
+		}
+
+		const T* Get(EntityHandle handle) const
+		{
+			uint32_t slot = SlotOf(handle);
+			return slot != INVALID_SLOT ? &At(slot) : nullptr;
+		}
+
+		void Remove(EntityHandle handle)
+		{
+			uint32_t slot = SlotOf(handle);
+			if (slot == INVALID_SLOT)
+				return;
+			m_Sparse[handle.index] = INVALID_SLOT;
+			m_Owners[slot] = nullptr;
+			m_Tombstones++;
+		}
+
+		// Swap-removes tombstones. Invalidates pointers from Get().
+		void Compact()
+		{
+			if (m_Tombstones == 0)
+				return;
+
+			uint32_t slot = 0;
+			while (slot < m_Owners.size())
+			{
+				if (m_Owners[slot])
+				{
+					slot++;
+					continue;
+				}
+
+				uint32_t last = static_cast<uint32_t>(m_Owners.size() - 1);
+				if (slot != last)
+				{
+					At(slot) = std::move(At(last));
+					m_Owners[slot] = m_Owners[last];
+					m_Handles[slot] = m_Handles[last];
+					if (m_Owners[slot])
+						m_Sparse[m_Handles[slot].index] = slot;
+				}
+				At(last) = T{}; // Drop heap memory held by the removed component
+				m_Owners.pop_back();
+				m_Handles.pop_back();
+				// Re-check `slot`: the moved-in element may itself be a tombstone
+			}
+			m_Tombstones = 0;
+		}
+
+		// Dense iteration (tombstones included; their owner is null)
+		uint32_t Size() const { return static_cast<uint32_t>(m_Owners.size()); }
+		T& At(uint32_t slot) { return m_Blocks[slot >> BLOCK_SHIFT][slot & (BLOCK_SIZE - 1)]; }
+		const T& At(uint32_t slot) const { return m_Blocks[slot >> BLOCK_SHIFT][slot & (BLOCK_SIZE - 1)]; }
+		Entity* OwnerAt(uint32_t slot) const { return m_Owners[slot]; }
+		EntityHandle HandleAt(uint32_t slot) const { return m_Handles[slot]; }
+		uint32_t LiveCount() const { return Size() - m_Tombstones; }
+
+	private:
+		// A handle from before its index was reused carries an older generation
+		// than the slot's stored handle and resolves to nothing
+		uint32_t SlotOf(EntityHandle handle) const
+		{
+			if (handle.index >= m_Sparse.size())
+				return INVALID_SLOT;
+			uint32_t slot = m_Sparse[handle.index];
+			if (slot == INVALID_SLOT || m_Handles[slot].generation != handle.generation)
+				return INVALID_SLOT;
+			return slot;
+		}
+
+		std::vector<std::unique_ptr<T[]>> m_Blocks;
+		std::vector<Entity*> m_Owners;		 // Dense, parallel to the blocks
+		std::vector<EntityHandle> m_Handles; // Dense, for fixing m_Sparse on compaction
+		std::vector<uint32_t> m_Sparse;		 // handle.index -> dense slot
+		uint32_t m_Tombstones = 0;
+	};
+
+	// ============================================================
+	// COMPONENT STORE
+	// ============================================================
+
+	// One pool per component type plus the handle allocator. Each MapInstance
+	// owns one; an Entity outside any map (between ReleaseEntity and
+	// AdoptEntity) owns a private one.
+	class ComponentStore
+	{
+	public:
+		template <typename T>
+		ComponentPool<T>& Pool() { return std::get<ComponentPool<T>>(m_Pools); }
+		template <typename T>
+		const ComponentPool<T>& Pool() const { return std::get<ComponentPool<T>>(m_Pools); }
+
+		EntityHandle Create()
+		{
+			EntityHandle handle;
+			if (!m_FreeIndices.empty())
+			{
+				handle.index = m_FreeIndices.back();
+				m_FreeIndices.pop_back();
+			}
+			else
+			{
+				handle.index = static_cast<uint32_t>(m_Generations.size());
+				m_Generations.push_back(0);
+			}
+			handle.generation = m_Generations[handle.index];
+			return handle;
+		}
+
+		// Removes every component (as tombstones) and retires the handle
+		void Destroy(EntityHandle handle)
+		{
+			if (!IsAlive(handle))
+				return;
+			std::apply([handle](auto&... pool) { (pool.Remove(handle), ...); }, m_Pools);
+			m_Generations[handle.index]++;
+			m_FreeIndices.push_back(handle.index);
+		}
+
+		bool IsAlive(EntityHandle handle) const
+		{
+			return handle.index < m_Generations.size() && m_Generations[handle.index] == handle.generation;
+		}
+
+		// Moves every component of `handle` into `to` under a new handle
+		static EntityHandle Transfer(ComponentStore& from, EntityHandle handle, ComponentStore& to, Entity* owner)
+		{
+			EntityHandle moved = to.Create();
+			std::apply([&](auto&... pool) { (MoveComponent(pool, handle, to, moved, owner), ...); }, from.m_Pools);
+			from.Destroy(handle);
+			return moved;
+		}
+
+		void Compact()
+		{
+			std::apply([](auto&... pool) { (pool.Compact(), ...); }, m_Pools);
+		}
+
+	private:
+		template <typename T>
+		static void MoveComponent(ComponentPool<T>& from, EntityHandle handle, ComponentStore& to,
+								  EntityHandle moved, Entity* owner)
+		{
+			if (T* component = from.Get(handle))
+				to.Pool<T>().Add(moved, owner, std::move(*component));
+		}
+
+		std::tuple<ComponentPool<HealthComponent>, ComponentPool<ManaComponent>, ComponentPool<MovementComponent>,
+				   ComponentPool<CombatComponent>, ComponentPool<AggroComponent>, ComponentPool<WalletComponent>,
+				   ComponentPool<InventoryComponent>, ComponentPool<EquipmentComponent>, ComponentPool<StatsComponent>,
+				   ComponentPool<ExperienceComponent>, ComponentPool<AuraComponent>>
+			m_Pools;
+
+		std::vector<uint32_t> m_Generations;
+		std::vector<uint32_t> m_FreeIndices;
+	};
+
+} // namespace MMO
@@ -202,8 +202,37 @@ namespace MMO {
 	}
 
 	Entity::Entity(EntityId id, EntityType type, const std::string& name)
-		: m_Id(id), m_Type(type), m_Name(name)
+		: m_Id(id), m_Type(type), m_Name(name), m_OwnStore(std::make_unique<ComponentStore>())
 	{
+		m_Store = m_OwnStore.get();
+		m_Handle = m_Store->Create();
+	}
+
+	Entity::Entity(EntityId id, EntityType type, const std::string& name, ComponentStore& store)
+		: m_Id(id), m_Type(type), m_Name(name), m_Store(&store)
+	{
+		m_Handle = m_Store->Create();
+	}
+
+	Entity::~Entity()
+	{
+		m_Store->Destroy(m_Handle);
+	}
+
+	void Entity::MoveToStore(ComponentStore* store)
+	{
+		std::unique_ptr<ComponentStore> ownStore;
+		if (!store)
+		{
+			ownStore = std::make_unique<ComponentStore>();
+			store = ownStore.get();
+		}
+		if (store == m_Store)
+			return;
+
+		m_Handle = ComponentStore::Transfer(*m_Store, m_Handle, *store, this);
+		m_Store = store;
+		m_OwnStore = std::move(ownStore); // Frees the previous private store, if any
 	}
 
 	// ============================================================
@@ -212,105 +241,114 @@ namespace MMO {
 
 	Vec2 Entity::GetPosition() const
 	{
-		return m_Movement ? m_Movement->position : Vec2{};
+		const MovementComponent* movement = GetMovement();
+		return movement ? movement->position : Vec2{};
 	}
 
 	float Entity::GetHeight() const
 	{
-		return m_Movement ? m_Movement->height : 0.0f;
+		const MovementComponent* movement = GetMovement();
+		return movement ? movement->height : 0.0f;
 	}
 
 	float Entity::GetHealthPercent() const
 	{
-		return m_Health ? m_Health->Percent() : 0.0f;
+		const HealthComponent* health = GetHealth();
+		return health ? health->Percent() : 0.0f;
 	}
 
 	float Entity::GetManaPercent() const
 	{
-		return m_Mana ? m_Mana->Percent() : 0.0f;
+		const ManaComponent* mana = GetMana();
+		return mana ? mana->Percent() : 0.0f;
 	}
 
 	bool Entity::IsDead() const
 	{
-		return m_Health ? m_Health->IsDead() : false;
+		const HealthComponent* health = GetHealth();
+		return health ? health->IsDead() : false;
 	}
 
 	uint32_t Entity::AddAura(const Aura& aura)
 	{
-		return m_Auras ? m_Auras->AddAura(aura) : 0;
+		AuraComponent* auras = GetAuras();
+		return auras ? auras->AddAura(aura) : 0;
 	}
 
 	void Entity::RemoveAura(uint32_t auraId)
 	{
-		if (m_Auras)
-			m_Auras->RemoveAura(auraId);
+		AuraComponent* auras = GetAuras();
+		if (auras)
+			auras->RemoveAura(auraId);
 	}
 
 	void Entity::RemoveAurasByType(AuraType type)
 	{
-		if (m_Auras)
-			m_Auras->RemoveAurasByType(type);
+		AuraComponent* auras = GetAuras();
+		if (auras)
+			auras->RemoveAurasByType(type);
 	}
 
 	bool Entity::HasAuraType(AuraType type) const
 	{
-		return m_Auras ? m_Auras->HasAuraType(type) : false;
+		const AuraComponent* auras = GetAuras();
+		return auras ? auras->HasAuraType(type) : false;
 	}
 
 	void Entity::AddHealthComponent(int32_t max)
 	{
-		m_Health = std::make_unique<HealthComponent>();
-		m_Health->baseMax = max;
-		m_Health->max = max;
-		m_Health->current = max;
+		HealthComponent* health = m_Store->Pool<HealthComponent>().Add(m_Handle, this);
+		health->baseMax = max;
+		health->max = max;
+		health->current = max;
 	}
 
 	void Entity::AddManaComponent(int32_t max)
 	{
-		m_Mana = std::make_unique<ManaComponent>();
-		m_Mana->baseMax = max;
-		m_Mana->max = max;
-		m_Mana->current = max;
+		ManaComponent* mana = m_Store->Pool<ManaComponent>().Add(m_Handle, this);
+		mana->baseMax = max;
+		mana->max = max;
+		mana->current = max;
 	}
 
 	void Entity::AddMovementComponent(float speed)
 	{
-		m_Movement = std::make_unique<MovementComponent>();
-		m_Movement->speed = speed;
+		MovementComponent* movement = m_Store->Pool<MovementComponent>().Add(m_Handle, this);
+		movement->speed = speed;
 	}
 
 	void Entity::AddCombatComponent(float attackRange)
 	{
-		m_Combat = std::make_unique<CombatComponent>();
-		m_Combat->attackRange = attackRange;
+		CombatComponent* combat = m_Store->Pool<CombatComponent>().Add(m_Handle, this);
+		combat->attackRange = attackRange;
 	}
 
 	void Entity::AddAggroComponent(float aggroRadius, float leashRadius)
 	{
-		m_Aggro = std::make_unique<AggroComponent>();
-		m_Aggro->aggroRadius = aggroRadius;
-		m_Aggro->leashRadius = leashRadius;
+		AggroComponent* aggro = m_Store->Pool<AggroComponent>().Add(m_Handle, this);
+		aggro->aggroRadius = aggroRadius;
+		aggro->leashRadius = leashRadius;
 	}
 
 	void Entity::AddWalletComponent(uint32_t initialMoney)
 	{
-		m_Wallet = std::make_unique<WalletComponent>();
-		m_Wallet->IsCopper = initialMoney;
+		WalletComponent* wallet = m_Store->Pool<WalletComponent>().Add(m_Handle, this);
+		wallet->IsCopper = initialMoney;
 	}
 
 	void Entity::AddInventoryComponent()
 	{
-		m_Inventory = std::make_unique<InventoryComponent>();
+		m_Store->Pool<InventoryComponent>().Add(m_Handle, this);
 	}
 
 	void Entity::AddEquipmentComponent()
 	{
-		m_Equipment = std::make_unique<EquipmentComponent>();
+		m_Store->Pool<EquipmentComponent>().Add(m_Handle, this);
 	}
 
 	void Entity::AddStatsComponent()
 	{
-		m_Stats = std::make_unique<StatsComponent>();
+		StatsComponent* stats = m_Store->Pool<StatsComponent>().Add(m_Handle, this);
 
 		// Set base stats based on class and level
 		float levelMult = static_cast<float>(m_Level);
@@ -318,41 +356,41 @@ namespace MMO {
 		switch (m_Class)
 		{
 		case CharacterClass::WARRIOR:
-			m_Stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 10.0f + levelMult * 2.0f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 10.0f + levelMult * 2.0f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 3.0f + levelMult * 0.5f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 5.0f + levelMult * 0.5f;
+			stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 10.0f + levelMult * 2.0f;
+			stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
+			stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 10.0f + levelMult * 2.0f;
+			stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 3.0f + levelMult * 0.5f;
+			stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 5.0f + levelMult * 0.5f;
 			break;
 
 		case CharacterClass::WITCH:
-			m_Stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 3.0f + levelMult * 0.5f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 5.0f + levelMult * 1.0f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 12.0f + levelMult * 2.5f;
-			m_Stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 10.0f + levelMult * 1.5f;
+			stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 3.0f + levelMult * 0.5f;
+			stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
+			stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 5.0f + levelMult * 1.0f;
+			stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 12.0f + levelMult * 2.5f;
+			stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 10.0f + levelMult * 1.5f;
 			break;
 
 		default:
 			for (size_t i = 0; i < static_cast<size_t>(StatType::COUNT); i++)
 			{
-				m_Stats->baseStats[i] = 5.0f + levelMult;
+				stats->baseStats[i] = 5.0f + levelMult;
 			}
 			break;
 		}
 
-		m_Stats->RecalculateStats();
+		stats->RecalculateStats();
 	}
 
 	void Entity::AddExperienceComponent(uint32_t currentXP)
 	{
-		m_Experience = std::make_unique<ExperienceComponent>();
-		m_Experience->current = currentXP;
+		ExperienceComponent* experience = m_Store->Pool<ExperienceComponent>().Add(m_Handle, this);
+		experience->current = currentXP;
 	}
 
 	void Entity::AddAuraComponent()
 	{
-		m_Auras = std::make_unique<AuraComponent>();
+		m_Store->Pool<AuraComponent>().Add(m_Handle, this);
 	}
 
 	uint32_t Entity::GetXPForNextLevel() const
@@ -362,57 +400,61 @@ namespace MMO {
 
 	uint32_t Entity::GiveXP(uint32_t amount)
 	{
-		if (!m_Experience)
+		HealthComponent* health = GetHealth();
+		ManaComponent* mana = GetMana();
+		StatsComponent* stats = GetStats();
+		ExperienceComponent* experience = GetExperience();
+		if (!experience)
 			return 0;
 
-		m_Experience->current += amount;
-		m_Experience->total += amount;
+		experience->current += amount;
+		experience->total += amount;
 
 		uint32_t levelsGained = 0;
 		uint32_t xpNeeded = GetXPForNextLevel();
 
 		// Check for level up (can level up multiple times)
-		while (m_Experience->current >= xpNeeded)
+		while (experience->current >= xpNeeded)
 		{
-			m_Experience->current -= xpNeeded;
+			experience->current -= xpNeeded;
 			m_Level++;
 			levelsGained++;
 
 			// Update base health/mana for new level
-			if (m_Health)
+			if (health)
 			{
 				int32_t healthPerLevel = (m_Class == CharacterClass::WARRIOR) ? 15 : 8;
-				m_Health->baseMax += healthPerLevel;
-				m_Health->max += healthPerLevel;
-				m_Health->current = m_Health->max; // Full heal on level up
+				health->baseMax += healthPerLevel;
+				health->max += healthPerLevel;
+				health->current = health->max; // Full heal on level up
 			}
-			if (m_Mana)
+			if (mana)
 			{
 				int32_t manaPerLevel = (m_Class == CharacterClass::WARRIOR) ? 5 : 12;
-				m_Mana->baseMax += manaPerLevel;
-				m_Mana->max += manaPerLevel;
-				m_Mana->current = m_Mana->max; // Full mana on level up
+				mana->baseMax += manaPerLevel;
+				mana->max += manaPerLevel;
+				mana->current = mana->max; // Full mana on level up
 			}
 
 			// Recalculate stats with new level
-			if (m_Stats)
+			if (stats)
 			{
 				float levelMult = static_cast<float>(m_Level);
 				switch (m_Class)
 				{
 				case CharacterClass::WARRIOR:
-					m_Stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 10.0f + levelMult * 2.0f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 10.0f + levelMult * 2.0f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 3.0f + levelMult * 0.5f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 5.0f + levelMult * 0.5f;
+					stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 10.0f + levelMult * 2.0f;
+					stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
+					stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 10.0f + levelMult * 2.0f;
+					stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 3.0f + levelMult * 0.5f;
+					stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 5.0f + levelMult * 0.5f;
 					break;
 				case CharacterClass::WITCH:
-					m_Stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 3.0f + levelMult * 0.5f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 5.0f + levelMult * 1.0f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 12.0f + levelMult * 2.5f;
-					m_Stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 10.0f + levelMult * 1.5f;
+					stats->baseStats[static_cast<size_t>(StatType::STRENGTH)] = 3.0f + levelMult * 0.5f;
+					stats->baseStats[static_cast<size_t>(StatType::AGILITY)] = 5.0f + levelMult * 1.0f;
+					stats->baseStats[static_cast<size_t>(StatType::STAMINA)] = 5.0f + levelMult * 1.0f;
+					stats->baseStats[static_cast<size_t>(StatType::INTELLECT)] = 12.0f + levelMult * 2.5f;
+					stats->baseStats[static_cast<size_t>(StatType::SPIRIT)] = 10.0f + levelMult * 1.5f;
 					break;
 				default:
 					break;
@@ -429,10 +471,13 @@ namespace MMO {
 
 	bool Entity::EquipItem(uint8_t inventorySlot, EquipmentSlot equipSlot)
 	{
-		if (!m_Inventory || !m_Equipment || !m_Stats)
+		InventoryComponent* inventory = GetInventory();
+		EquipmentComponent* equipment = GetEquipment();
+		StatsComponent* stats = GetStats();
+		if (!inventory || !equipment || !stats)
 			return false;
 
-		ItemInstance* item = m_Inventory->GetItem(inventorySlot);
+		ItemInstance* item = inventory->GetItem(inventorySlot);
 		if (!item)
 			return false;
 
@@ -441,23 +486,23 @@ namespace MMO {
 			return false;
 
 		// Check if item can be equipped in this slot
-		if (!m_Equipment->CanEquipInSlot(equipSlot, tmpl))
+		if (!equipment->CanEquipInSlot(equipSlot, tmpl))
 			return false;
 
 		// If slot is occupied, swap items
-		ItemInstance* equipped = m_Equipment->GetEquipped(equipSlot);
+		ItemInstance* equipped = equipment->GetEquipped(equipSlot);
 		if (equipped)
 		{
 			// Swap: put equipped item in inventory slot
 			ItemInstance temp = *equipped;
-			m_Equipment->Equip(equipSlot, *item);
-			m_Inventory->slots[inventorySlot].item = temp;
+			equipment->Equip(equipSlot, *item);
+			inventory->slots[inventorySlot].item = temp;
 		}
 		else
 		{
 			// Just equip, remove from inventory
-			m_Equipment->Equip(equipSlot, *item);
-			m_Inventory->RemoveItem(inventorySlot);
+			equipment->Equip(equipSlot, *item);
+			inventory->RemoveItem(inventorySlot);
 		}
 
 		RecalculateStatsFromGear();
@@ -466,21 +511,24 @@ namespace MMO {
 
 	bool Entity::UnequipItem(EquipmentSlot equipSlot, uint8_t* outInventorySlot)
 	{
-		if (!m_Inventory || !m_Equipment || !m_Stats)
+		InventoryComponent* inventory = GetInventory();
+		EquipmentComponent* equipment = GetEquipment();
+		StatsComponent* stats = GetStats();
+		if (!inventory || !equipment || !stats)
 			return false;
 
-		ItemInstance* equipped = m_Equipment->GetEquipped(equipSlot);
+		ItemInstance* equipped = equipment->GetEquipped(equipSlot);
 		if (!equipped)
 			return false;
 
 		// Find empty inventory slot
-		int emptySlot = m_Inventory->FindFirstEmptySlot();
+		int emptySlot = inventory->FindFirstEmptySlot();
 		if (emptySlot < 0)
 			return false; // Inventory full
 
 		// Move to inventory
-		m_Inventory->slots[emptySlot].item = *equipped;
-		m_Equipment->Unequip(equipSlot);
+		inventory->slots[emptySlot].item = *equipped;
+		equipment->Unequip(equipSlot);
 
 		if (outInventorySlot)
 			*outInventorySlot = static_cast<uint8_t>(emptySlot);
@@ -491,23 +539,27 @@ namespace MMO {
 
 	void Entity::RecalculateStatsFromGear()
 	{
-		if (!m_Stats || !m_Equipment)
+		HealthComponent* health = GetHealth();
+		ManaComponent* mana = GetMana();
+		EquipmentComponent* equipment = GetEquipment();
+		StatsComponent* stats = GetStats();
+		if (!stats || !equipment)
 			return;
 
 		// Clear all gear modifiers
 		for (size_t i = 0; i < static_cast<size_t>(StatType::COUNT); i++)
 		{
-			m_Stats->modifiers[i][static_cast<size_t>(ModifierType::BASE_VALUE)] = 0;
+			stats->modifiers[i][static_cast<size_t>(ModifierType::BASE_VALUE)] = 0;
 		}
-		m_Stats->totalArmor = 0;
-		m_Stats->weaponDamageMin = 1.0f;
-		m_Stats->weaponDamageMax = 2.0f;
-		m_Stats->weaponSpeed = 2.0f;
+		stats->totalArmor = 0;
+		stats->weaponDamageMin = 1.0f;
+		stats->weaponDamageMax = 2.0f;
+		stats->weaponSpeed = 2.0f;
 
 		// Apply stats from all equipped items
 		for (uint8_t i = 0; i < EQUIPMENT_SLOT_COUNT; i++)
 		{
-			const ItemInstance* item = m_Equipment->GetEquipped(static_cast<EquipmentSlot>(i));
+			const ItemInstance* item = equipment->GetEquipped(static_cast<EquipmentSlot>(i));
 			if (!item)
 				continue;
 
@@ -518,40 +570,40 @@ namespace MMO {
 			// Apply stat bonuses
 			for (uint8_t j = 0; j < tmpl->statCount; j++)
 			{
-				m_Stats->ApplyMod(tmpl->stats[j].stat, ModifierType::BASE_VALUE,
+				stats->ApplyMod(tmpl->stats[j].stat, ModifierType::BASE_VALUE,
 								  static_cast<float>(tmpl->stats[j].value));
 			}
 
 			// Apply armor
-			m_Stats->totalArmor += tmpl->armor;
+			stats->totalArmor += tmpl->armor;
 
 			// Apply weapon stats (if weapon slot)
 			if (static_cast<EquipmentSlot>(i) == EquipmentSlot::WEAPON && tmpl->IsWeapon())
 			{
-				m_Stats->weaponDamageMin = tmpl->weaponDamageMin;
-				m_Stats->weaponDamageMax = tmpl->weaponDamageMax;
-				m_Stats->weaponSpeed = tmpl->weaponSpeed;
+				stats->weaponDamageMin = tmpl->weaponDamageMin;
+				stats->weaponDamageMax = tmpl->weaponDamageMax;
+				stats->weaponSpeed = tmpl->weaponSpeed;
 			}
 		}
 
-		m_Stats->RecalculateStats();
+		stats->RecalculateStats();
 
 		// Update health/mana max based on stamina/intellect
-		if (m_Health)
+		if (health)
 		{
-			int32_t bonusHealth = m_Stats->GetBonusHealth();
+			int32_t bonusHealth = stats->GetBonusHealth();
 			// Keep current health percentage
-			float healthPct = static_cast<float>(m_Health->current) / static_cast<float>(m_Health->max);
-			m_Health->max = m_Health->baseMax + bonusHealth; // Class base + stamina bonus
-			m_Health->current = static_cast<int32_t>(m_Health->max * healthPct);
+			float healthPct = static_cast<float>(health->current) / static_cast<float>(health->max);
+			health->max = health->baseMax + bonusHealth; // Class base + stamina bonus
+			health->current = static_cast<int32_t>(health->max * healthPct);
 		}
 
-		if (m_Mana)
+		if (mana)
 		{
-			int32_t bonusMana = m_Stats->GetBonusMana();
-			float manaPct = static_cast<float>(m_Mana->current) / static_cast<float>(m_Mana->max);
-			m_Mana->max = m_Mana->baseMax + bonusMana; // Class base + intellect bonus
-			m_Mana->current = static_cast<int32_t>(m_Mana->max * manaPct);
+			int32_t bonusMana = stats->GetBonusMana();
+			float manaPct = static_cast<float>(mana->current) / static_cast<float>(mana->max);
+			mana->max = mana->baseMax + bonusMana; // Class base + intellect bonus
+			mana->current = static_cast<int32_t>(mana->max * manaPct);
 		}
 	}
 
@@ -570,51 +622,62 @@ namespace MMO {
 
 	void Entity::Update(float dt)
 	{
-		// Update cooldowns
-		if (m_Combat)
+		if (CombatComponent* combat = GetCombat())
 		{
-			for (auto& [id, cooldown] : m_Combat->cooldowns)
-			{
-				if (cooldown > 0.0f)
-				{
-					cooldown -= dt;
-				}
-			}
+			TickCombatTimers(*combat, dt);
+		}
+		if (MovementComponent* movement = GetMovement())
+		{
+			IntegrateMovement(*movement, GetHealth(), GetAuras(), dt);
+		}
+	}
 
-			// Update cast timer
-			if (m_Combat->IsCasting())
+	// ============================================================
+	// COMPONENT STEPS
+	// ============================================================
+
+	void TickCombatTimers(CombatComponent& combat, float dt)
+	{
+		// Update cooldowns
+		for (auto& [id, cooldown] : combat.cooldowns)
+		{
+			if (cooldown > 0.0f)
 			{
-				m_Combat->castTimer += dt;
+				cooldown -= dt;
 			}
 		}
 
-		// Calculate speed modifier from auras
-		float speedModifier = 1.0f;
-		if (m_Auras)
+		// Update cast timer
+		if (combat.IsCasting())
 		{
-			speedModifier = m_Auras->GetSpeedModifier();
+			combat.castTimer += dt;
 		}
+	}
 
+	void IntegrateMovement(MovementComponent& movement, const HealthComponent* health, const AuraComponent* auras, float dt)
+	{
 		// Update position based on velocity
-		if (m_Movement && m_Movement->velocity.LengthSquared() > 0.001f)
+		if (movement.velocity.LengthSquared() > 0.001f)
 		{
 			// Check if rooted (can't move)
-			bool isRooted = m_Auras && m_Auras->IsRooted();
+			bool isRooted = auras && auras->IsRooted();
 			if (!isRooted)
 			{
-				float effectiveSpeed = m_Movement->speed * speedModifier;
-				m_Movement->position += m_Movement->velocity.Normalized() * effectiveSpeed * dt;
+				// Speed modifier from auras
+				float speedModifier = auras ? auras->GetSpeedModifier() : 1.0f;
+				float effectiveSpeed = movement.speed * speedModifier;
+				movement.position += movement.velocity.Normalized() * effectiveSpeed * dt;
 			}
 
 			// Update move state
-			if (m_Movement->velocity.Length() > 0.1f)
+			if (movement.velocity.Length() > 0.1f)
 			{
-				m_Movement->moveState = MoveState::RUNNING;
+				movement.moveState = MoveState::RUNNING;
 			}
 		}
-		else if (m_Movement)
+		else
 		{
-			m_Movement->moveState = m_Health && m_Health->IsDead() ? MoveState::DEAD : MoveState::IDLE;
+			movement.moveState = health && health->IsDead() ? MoveState::DEAD : MoveState::IDLE;
 		}
 	}
 
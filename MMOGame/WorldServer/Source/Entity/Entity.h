@@ -4,6 +4,7 @@
 #include "../../../Shared/Source/Types/Types.h"
 #include "../Scripting/IEntity.h"
 #include "AuraComponent.h"
+#include "ComponentPool.h"
 #include "Components.h"
 #include <memory>
 #include <string>
@@ -18,8 +19,13 @@ namespace MMO {
 	class Entity : public IEntity
 	{
 	public:
+		// Without a store the entity keeps its components in a private one
 		Entity(EntityId id, EntityType type, const std::string& name);
-		virtual ~Entity() = default;
+		Entity(EntityId id, EntityType type, const std::string& name, ComponentStore& store);
+		virtual ~Entity();
+
+		Entity(const Entity&) = delete;
+		Entity& operator=(const Entity&) = delete;
 
 		// ========================================
 		// IEntity implementation
@@ -54,30 +60,32 @@ namespace MMO {
 		void SetSummoner(EntityId id) { m_SummonerId = id; }
 		EntityId GetSummoner() const { return m_SummonerId; }
 
-		// Components - using optional pointers (could use ECS but keeping simple)
-		HealthComponent* GetHealth() { return m_Health.get(); }
-		ManaComponent* GetMana() { return m_Mana.get(); }
-		MovementComponent* GetMovement() { return m_Movement.get(); }
-		CombatComponent* GetCombat() { return m_Combat.get(); }
-		AggroComponent* GetAggro() { return m_Aggro.get(); }
-		WalletComponent* GetWallet() { return m_Wallet.get(); }
-		InventoryComponent* GetInventory() { return m_Inventory.get(); }
-		EquipmentComponent* GetEquipment() { return m_Equipment.get(); }
-		StatsComponent* GetStats() { return m_Stats.get(); }
-		ExperienceComponent* GetExperience() { return m_Experience.get(); }
-		AuraComponent* GetAuras() { return m_Auras.get(); }
-
-		const HealthComponent* GetHealth() const { return m_Health.get(); }
-		const ManaComponent* GetMana() const { return m_Mana.get(); }
-		const MovementComponent* GetMovement() const { return m_Movement.get(); }
-		const CombatComponent* GetCombat() const { return m_Combat.get(); }
-		const AggroComponent* GetAggro() const { return m_Aggro.get(); }
-		const WalletComponent* GetWallet() const { return m_Wallet.get(); }
-		const InventoryComponent* GetInventory() const { return m_Inventory.get(); }
-		const EquipmentComponent* GetEquipment() const { return m_Equipment.get(); }
-		const StatsComponent* GetStats() const { return m_Stats.get(); }
-		const ExperienceComponent* GetExperience() const { return m_Experience.get(); }
-		const AuraComponent* GetAuras() const { return m_Auras.get(); }
+		// Components live in the owning map's ComponentStore; null when the
+		// entity doesn't have one. Pointers stay valid until the map's
+		// end-of-tick compaction or a transfer to another map.
+		HealthComponent* GetHealth() { return Get<HealthComponent>(); }
+		ManaComponent* GetMana() { return Get<ManaComponent>(); }
+		MovementComponent* GetMovement() { return Get<MovementComponent>(); }
+		CombatComponent* GetCombat() { return Get<CombatComponent>(); }
+		AggroComponent* GetAggro() { return Get<AggroComponent>(); }
+		WalletComponent* GetWallet() { return Get<WalletComponent>(); }
+		InventoryComponent* GetInventory() { return Get<InventoryComponent>(); }
+		EquipmentComponent* GetEquipment() { return Get<EquipmentComponent>(); }
+		StatsComponent* GetStats() { return Get<StatsComponent>(); }
+		ExperienceComponent* GetExperience() { return Get<ExperienceComponent>(); }
+		AuraComponent* GetAuras() { return Get<AuraComponent>(); }
+
+		const HealthComponent* GetHealth() const { return Get<HealthComponent>(); }
+		const ManaComponent* GetMana() const { return Get<ManaComponent>(); }
+		const MovementComponent* GetMovement() const { return Get<MovementComponent>(); }
+		const CombatComponent* GetCombat() const { return Get<CombatComponent>(); }
+		const AggroComponent* GetAggro() const { return Get<AggroComponent>(); }
+		const WalletComponent* GetWallet() const { return Get<WalletComponent>(); }
+		const InventoryComponent* GetInventory() const { return Get<InventoryComponent>(); }
+		const EquipmentComponent* GetEquipment() const { return Get<EquipmentComponent>(); }
+		const StatsComponent* GetStats() const { return Get<StatsComponent>(); }
+		const ExperienceComponent* GetExperience() const { return Get<ExperienceComponent>(); }
+		const AuraComponent* GetAuras() const { return Get<AuraComponent>(); }
 
 		void AddHealthComponent(int32_t max);
 		void AddManaComponent(int32_t max);
@@ -106,10 +114,21 @@ namespace MMO {
 		const std::vector<AbilityId>& GetAbilities() const { return m_Abilities; }
 		bool HasAbility(AbilityId id) const;
 
-		// Update
+		// Storage
+		EntityHandle GetHandle() const { return m_Handle; }
+		// Moves all components into `store` (a map's), or into a private
+		// store when null (entity leaving a map)
+		void MoveToStore(ComponentStore* store);
+
+		// Single-entity update; MapInstance runs the same steps as pool loops
 		virtual void Update(float dt);
 
 	private:
+		template <typename T>
+		T* Get() { return m_Store->Pool<T>().Get(m_Handle); }
+		template <typename T>
+		const T* Get() const { return m_Store->Pool<T>().Get(m_Handle); }
+
 		EntityId m_Id;
 		EntityType m_Type;
 		std::string m_Name;
@@ -117,19 +136,19 @@ namespace MMO {
 		uint32_t m_Level = 1;
 		EntityId m_SummonerId = 0;
 
-		std::unique_ptr<HealthComponent> m_Health;
-		std::unique_ptr<ManaComponent> m_Mana;
-		std::unique_ptr<MovementComponent> m_Movement;
-		std::unique_ptr<CombatComponent> m_Combat;
-		std::unique_ptr<AggroComponent> m_Aggro;
-		std::unique_ptr<WalletComponent> m_Wallet;
-		std::unique_ptr<InventoryComponent> m_Inventory;
-		std::unique_ptr<EquipmentComponent> m_Equipment;
-		std::unique_ptr<StatsComponent> m_Stats;
-		std::unique_ptr<ExperienceComponent> m_Experience;
-		std::unique_ptr<AuraComponent> m_Auras;
+		std::unique_ptr<ComponentStore> m_OwnStore; // Only while outside a map
+		ComponentStore* m_Store = nullptr;
+		EntityHandle m_Handle;
 
 		std::vector<AbilityId> m_Abilities;
 	};
 
+	// ============================================================
+	// COMPONENT STEPS
+	// ============================================================
+
+	// Shared by Entity::Update and MapInstance's per-pool loops
+	void TickCombatTimers(CombatComponent& combat, float dt);
+	void IntegrateMovement(MovementComponent& movement, const HealthComponent* health, const AuraComponent* auras, float dt);
+
 } // namespace MMO
@@ -1,6 +1,5 @@
 #include "Grid.h"
-#include "../Entity/Entity.h"
-#include "../Map/Map.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -10,17 +9,25 @@ namespace MMO {
 
 	void Grid::AddEntity(EntityId id, Vec2 position, bool isPlayer)
 	{
+		auto [it, inserted] = m_EntityCells.try_emplace(id);
+		if (!inserted)
+		{
+			DetachEntity(id, it->second);
+		}
+
 		CellCoord coord = PositionToCell(position);
-		GridCell* cell = GetOrCreateCell(coord);
+		LinkToCell(id, it->second, coord, position, isPlayer);
 
-		cell->AddEntity(id);
+		// Everyone already watching the cell now sees the entity
+		for (const CellWatcher& watcher : GetCell(coord)->GetWatchers())
+		{
+			PushVisibility(watcher.playerId, id, true);
+		}
 		if (isPlayer)
 		{
-			cell->AddPlayer(id);
+			WatchBlock(id, coord);
 		}
 
-		m_EntityCells[id] = coord;
-
 		// Mark as spawned (needs full data sent to nearby players)
 		DirtyFlags flags;
 		flags.spawned = true;
@@ -34,13 +41,7 @@ namespace MMO {
 		if (it == m_EntityCells.end())
 			return;
 
-		CellCoord coord = it->second;
-		GridCell* cell = GetCell(coord);
-		if (cell)
-		{
-			cell->RemoveEntity(id);
-			cell->RemovePlayer(id);
-		}
+		DetachEntity(id, it->second);
 
 		// Mark as despawned before removing tracking
 		DirtyFlags flags;
@@ -51,60 +52,381 @@ namespace MMO {
 		m_EntityCells.erase(it);
 	}
 
-	void Grid::MoveEntity(EntityId id, Vec2 oldPos, Vec2 newPos, bool isPlayer)
+	void Grid::MoveEntity(EntityId id, Vec2 newPos, bool isPlayer)
 	{
-		CellCoord oldCoord = PositionToCell(oldPos);
 		CellCoord newCoord = PositionToCell(newPos);
 
-		// Update cell tracking if cell changed
-		if (!(oldCoord == newCoord))
+		auto it = m_EntityCells.find(id);
+		if (it != m_EntityCells.end() && it->second.cell == newCoord)
+		{
+			// Same cell (the common case): no list or watcher changes, only the
+			// cached position
+			const EntitySlot& slot = it->second;
+			GridCell* cell = GetCell(slot.cell);
+			cell->GetEntityList().SetPosition(slot.entityIndex, newPos);
+			if (slot.playerIndex != NO_SLOT)
+			{
+				cell->GetPlayerList().SetPosition(slot.playerIndex, newPos);
+			}
+		}
+		else if (it == m_EntityCells.end())
+		{
+			// Not tracked yet (shouldn't happen, but keep the grid consistent)
+			EntitySlot& slot = m_EntityCells[id];
+			LinkToCell(id, slot, newCoord, newPos, isPlayer);
+			for (const CellWatcher& watcher : GetCell(newCoord)->GetWatchers())
+			{
+				PushVisibility(watcher.playerId, id, true);
+			}
+			if (isPlayer)
+			{
+				WatchBlock(id, newCoord);
+			}
+		}
+		else
 		{
-			GridCell* oldCell = GetCell(oldCoord);
-			if (oldCell)
+			EntitySlot& slot = it->second;
+			CellCoord oldCoord = slot.cell;
+			bool wasPlayer = slot.playerIndex != NO_SLOT;
+			UnlinkFromCell(slot);
+			LinkToCell(id, slot, newCoord, newPos, wasPlayer);
+
+			// Watchers of only the old cell lose the entity, watchers of only the
+			// new cell gain it; watchers of both see no change
+			for (const CellWatcher& watcher : GetCell(oldCoord)->GetWatchers())
 			{
-				oldCell->RemoveEntity(id);
-				if (isPlayer)
+				if (watcher.playerId != id && !IsCellInViewBlock(watcher.center, newCoord))
 				{
-					oldCell->RemovePlayer(id);
+					PushVisibility(watcher.playerId, id, false);
 				}
 			}
-
-			GridCell* newCell = GetOrCreateCell(newCoord);
-			newCell->AddEntity(id);
-			if (isPlayer)
+			for (const CellWatcher& watcher : GetCell(newCoord)->GetWatchers())
 			{
-				newCell->AddPlayer(id);
+				if (watcher.playerId != id && !IsCellInViewBlock(watcher.center, oldCoord))
+				{
+					PushVisibility(watcher.playerId, id, true);
+				}
 			}
 
-			m_EntityCells[id] = newCoord;
+			if (wasPlayer)
+			{
+				ShiftWatchBlock(id, oldCoord, newCoord);
+			}
 		}
 
-		// Mark position dirty
+		// Mark position dirty. An entity with any flag set is already in the
+		// dirty set, so repeat marks within a tick skip the set insert.
 		auto& flags = m_DirtyFlags[id];
+		if (!flags.IsAnyDirty())
+		{
+			m_DirtyEntities.insert(id); // Add to dirty set for O(d) iteration
+		}
 		flags.position = true;
-		m_DirtyEntities.insert(id); // Add to dirty set for O(d) iteration
+	}
+
+	void Grid::SetCachedPosition(EntityId id, Vec2 position, bool isPlayer)
+	{
+		auto it = m_EntityCells.find(id);
+		if (it == m_EntityCells.end() || !(it->second.cell == PositionToCell(position)))
+		{
+			MoveEntity(id, position, isPlayer);
+			return;
+		}
+
+		const EntitySlot& slot = it->second;
+		GridCell* cell = GetCell(slot.cell);
+		cell->GetEntityList().SetPosition(slot.entityIndex, position);
+		if (slot.playerIndex != NO_SLOT)
+		{
+			cell->GetPlayerList().SetPosition(slot.playerIndex, position);
+		}
+	}
+
+	void Grid::LinkToCell(EntityId id, EntitySlot& slot, CellCoord coord, Vec2 position, bool isPlayer)
+	{
+		GridCell* cell = GetOrCreateCell(coord);
+		slot.cell = coord;
+		slot.entityIndex = cell->GetEntityList().Add(id, position);
+		slot.playerIndex = isPlayer ? cell->GetPlayerList().Add(id, position) : NO_SLOT;
+	}
+
+	void Grid::UnlinkFromCell(const EntitySlot& slot)
+	{
+		GridCell* cell = GetCell(slot.cell);
+		if (!cell)
+			return;
+
+		// Swap-remove, then point the member that filled the hole at its new index
+		EntityId moved = cell->GetEntityList().RemoveAt(slot.entityIndex);
+		if (moved != INVALID_ENTITY_ID)
+		{
+			m_EntityCells[moved].entityIndex = slot.entityIndex;
+		}
+
+		if (slot.playerIndex != NO_SLOT)
+		{
+			moved = cell->GetPlayerList().RemoveAt(slot.playerIndex);
+			if (moved != INVALID_ENTITY_ID)
+			{
+				m_EntityCells[moved].playerIndex = slot.playerIndex;
+			}
+		}
+	}
+
+	void Grid::DetachEntity(EntityId id, const EntitySlot& slot)
+	{
+		UnlinkFromCell(slot);
+
+		if (const GridCell* cell = GetCell(slot.cell))
+		{
+			for (const CellWatcher& watcher : cell->GetWatchers())
+			{
+				if (watcher.playerId != id)
+				{
+					PushVisibility(watcher.playerId, id, false);
+				}
+			}
+		}
+
+		if (slot.playerIndex != NO_SLOT)
+		{
+			UnwatchBlock(id, slot.cell);
+			m_VisibilityChanges.erase(id);
+		}
+	}
+
+	// ============================================================
+	// INCREMENTAL VISIBILITY
+	// ============================================================
+
+	void Grid::PushVisibility(EntityId playerId, EntityId entityId, bool visible)
+	{
+		m_VisibilityChanges[playerId].push_back({entityId, visible});
+	}
+
+	bool Grid::GetCachedPosition(EntityId id, Vec2& outPosition) const
+	{
+		auto it = m_EntityCells.find(id);
+		if (it == m_EntityCells.end())
+			return false;
+		const GridCell* cell = GetCell(it->second.cell);
+		if (!cell)
+			return false;
+		outPosition = cell->GetEntityList().GetPosition(it->second.entityIndex);
+		return true;
+	}
+
+	void Grid::ClearVisibilityChanges()
+	{
+		// Keep the per-player vectors so steady-state ticks don't reallocate
+		for (auto& [playerId, changes] : m_VisibilityChanges)
+		{
+			changes.clear();
+		}
+	}
+
+	void Grid::WatchBlock(EntityId playerId, CellCoord center)
+	{
+		std::vector<VisibilityChange>& changes = m_VisibilityChanges[playerId];
+		for (int32_t y = center.y - GRID_SEARCH_RADIUS; y <= center.y + GRID_SEARCH_RADIUS; y++)
+		{
+			for (int32_t x = center.x - GRID_SEARCH_RADIUS; x <= center.x + GRID_SEARCH_RADIUS; x++)
+			{
+				GridCell* cell = GetOrCreateCell(CellCoord{x, y});
+				cell->AddWatcher(playerId, center);
+				for (EntityId id : cell->GetEntities())
+				{
+					if (id != playerId)
+					{
+						changes.push_back({id, true});
+					}
+				}
+			}
+		}
+	}
+
+	void Grid::UnwatchBlock(EntityId playerId, CellCoord center)
+	{
+		for (int32_t y = center.y - GRID_SEARCH_RADIUS; y <= center.y + GRID_SEARCH_RADIUS; y++)
+		{
+			for (int32_t x = center.x - GRID_SEARCH_RADIUS; x <= center.x + GRID_SEARCH_RADIUS; x++)
+			{
+				if (GridCell* cell = GetCell(CellCoord{x, y}))
+				{
+					cell->RemoveWatcher(playerId);
+				}
+			}
+		}
+	}
+
+	void Grid::ShiftWatchBlock(EntityId playerId, CellCoord from, CellCoord to)
+	{
+		// One lookup for the whole shift; a crossing pushes a change per entity
+		// in ten cells
+		std::vector<VisibilityChange>& changes = m_VisibilityChanges[playerId];
+
+		// Cells leaving the block: stop watching, everything in them leaves view
+		for (int32_t y = from.y - GRID_SEARCH_RADIUS; y <= from.y + GRID_SEARCH_RADIUS; y++)
+		{
+			for (int32_t x = from.x - GRID_SEARCH_RADIUS; x <= from.x + GRID_SEARCH_RADIUS; x++)
+			{
+				CellCoord coord{x, y};
+				GridCell* cell = GetCell(coord);
+				if (!cell)
+					continue;
+
+				if (IsCellInViewBlock(to, coord))
+				{
+					cell->SetWatcherCenter(playerId, to);
+					continue;
+				}
+
+				cell->RemoveWatcher(playerId);
+				for (EntityId id : cell->GetEntities())
+				{
+					if (id != playerId)
+					{
+						changes.push_back({id, false});
+					}
+				}
+			}
+		}
+
+		// Cells entering the block: start watching, everything in them enters view
+		for (int32_t y = to.y - GRID_SEARCH_RADIUS; y <= to.y + GRID_SEARCH_RADIUS; y++)
+		{
+			for (int32_t x = to.x - GRID_SEARCH_RADIUS; x <= to.x + GRID_SEARCH_RADIUS; x++)
+			{
+				CellCoord coord{x, y};
+				if (IsCellInViewBlock(from, coord))
+					continue;
+
+				GridCell* cell = GetOrCreateCell(coord);
+				cell->AddWatcher(playerId, to);
+				for (EntityId id : cell->GetEntities())
+				{
+					if (id != playerId)
+					{
+						changes.push_back({id, true});
+					}
+				}
+			}
+		}
+	}
+
+	// ============================================================
+	// CELL STORAGE
+	// ============================================================
+
+	void Grid::ReserveBounds(Vec2 minPosition, Vec2 maxPosition)
+	{
+		GrowDense(PositionToCell(minPosition));
+		GrowDense(PositionToCell(maxPosition));
+	}
+
+	int64_t Grid::DenseIndex(CellCoord coord) const
+	{
+		int64_t x = static_cast<int64_t>(coord.x) - m_DenseMin.x;
+		int64_t y = static_cast<int64_t>(coord.y) - m_DenseMin.y;
+		if (x < 0 || y < 0 || x >= m_DenseWidth || y >= m_DenseHeight)
+			return -1;
+		return y * m_DenseWidth + x;
+	}
+
+	void Grid::GrowDense(CellCoord coord)
+	{
+		if (DenseIndex(coord) >= 0)
+			return;
+
+		CellCoord newMin = coord;
+		CellCoord newMax = coord;
+		if (!m_Cells.empty())
+		{
+			// Grow by at least half the current extent so repeated growth stays amortized
+			int32_t padX = std::max(4, m_DenseWidth / 2);
+			int32_t padY = std::max(4, m_DenseHeight / 2);
+			CellCoord oldMax{m_DenseMin.x + m_DenseWidth - 1, m_DenseMin.y + m_DenseHeight - 1};
+			newMin.x = coord.x < m_DenseMin.x ? coord.x - padX : m_DenseMin.x;
+			newMin.y = coord.y < m_DenseMin.y ? coord.y - padY : m_DenseMin.y;
+			newMax.x = coord.x > oldMax.x ? coord.x + padX : oldMax.x;
+			newMax.y = coord.y > oldMax.y ? coord.y + padY : oldMax.y;
+		}
+
+		int64_t width = static_cast<int64_t>(newMax.x) - newMin.x + 1;
+		int64_t height = static_cast<int64_t>(newMax.y) - newMin.y + 1;
+		if (width * height > MAX_DENSE_CELLS)
+			return; // Caller falls back to overflow storage
+
+		std::vector<GridCell> cells;
+		cells.reserve(static_cast<size_t>(width * height));
+		for (int32_t y = newMin.y; y <= newMax.y; y++)
+		{
+			for (int32_t x = newMin.x; x <= newMax.x; x++)
+			{
+				CellCoord c{x, y};
+				int64_t oldIndex = DenseIndex(c);
+				if (oldIndex >= 0)
+				{
+					cells.push_back(std::move(m_Cells[static_cast<size_t>(oldIndex)]));
+				}
+				else if (auto it = m_OverflowCells.find(c); it != m_OverflowCells.end())
+				{
+					cells.push_back(std::move(*it->second));
+					m_OverflowCells.erase(it);
+				}
+				else
+				{
+					cells.emplace_back(c);
+				}
+			}
+		}
+
+		m_Cells = std::move(cells);
+		m_DenseMin = newMin;
+		m_DenseWidth = static_cast<int32_t>(width);
+		m_DenseHeight = static_cast<int32_t>(height);
 	}
 
 	GridCell* Grid::GetOrCreateCell(CellCoord coord)
 	{
-		auto it = m_Cells.find(coord);
-		if (it != m_Cells.end())
+		GrowDense(coord);
+		int64_t index = DenseIndex(coord);
+		if (index >= 0)
 		{
-			return it->second.get();
+			return &m_Cells[static_cast<size_t>(index)];
 		}
 
-		auto cell = std::make_unique<GridCell>(coord);
-		GridCell* ptr = cell.get();
-		m_Cells[coord] = std::move(cell);
-		return ptr;
+		auto& cell = m_OverflowCells[coord];
+		if (!cell)
+		{
+			cell = std::make_unique<GridCell>(coord);
+		}
+		return cell.get();
 	}
 
 	GridCell* Grid::GetCell(CellCoord coord)
 	{
-		auto it = m_Cells.find(coord);
-		return it != m_Cells.end() ? it->second.get() : nullptr;
+		return const_cast<GridCell*>(static_cast<const Grid*>(this)->GetCell(coord));
+	}
+
+	const GridCell* Grid::GetCell(CellCoord coord) const
+	{
+		int64_t index = DenseIndex(coord);
+		if (index >= 0)
+		{
+			return &m_Cells[static_cast<size_t>(index)];
+		}
+		if (m_OverflowCells.empty())
+			return nullptr;
+
+		auto it = m_OverflowCells.find(coord);
+		return it != m_OverflowCells.end() ? it->second.get() : nullptr;
 	}
 
+	// ============================================================
+	// DIRTY FLAGS
+	// ============================================================
+
 	void Grid::MarkDirty(EntityId id, DirtyFlags flags)
 	{
 		auto& existing = m_DirtyFlags[id];
@@ -165,99 +487,53 @@ namespace MMO {
 		m_DirtyEntities.clear();
 	}
 
-	std::vector<EntityId> Grid::GetEntitiesInRadius(Vec2 center, float radius)
+	void Grid::GetEntitiesInRadius(Vec2 center, float radius, std::vector<EntityId>& out) const
 	{
-		std::vector<EntityId> result;
 		float radiusSq = radius * radius;
+		ForEachCellInRadius(center, radius, [&](const GridCell& cell) {
+			cell.GetEntityList().Query(center, radiusSq, out);
+		});
+	}
 
-		CellCoord centerCell = PositionToCell(center);
-		int32_t cellRadius = static_cast<int32_t>(std::ceil(radius / GRID_CELL_SIZE)) + 1;
-
-		for (int32_t dx = -cellRadius; dx <= cellRadius; dx++)
-		{
-			for (int32_t dy = -cellRadius; dy <= cellRadius; dy++)
-			{
-				CellCoord coord{centerCell.x + dx, centerCell.y + dy};
-				GridCell* cell = GetCell(coord);
-				if (!cell)
-					continue;
-
-				for (EntityId id : cell->GetEntities())
-				{
-					Entity* entity = m_Map->GetEntity(id);
-					if (!entity)
-						continue;
-
-					auto movement = entity->GetMovement();
-					if (!movement)
-						continue;
-
-					float distSq = Vec2::DistanceSquared(center, movement->position);
-					if (distSq <= radiusSq)
-					{
-						result.push_back(id);
-					}
-				}
-			}
-		}
+	void Grid::GetPlayersInRadius(Vec2 center, float radius, std::vector<EntityId>& out) const
+	{
+		float radiusSq = radius * radius;
+		ForEachCellInRadius(center, radius, [&](const GridCell& cell) {
+			cell.GetPlayerList().Query(center, radiusSq, out);
+		});
+	}
 
+	std::vector<EntityId> Grid::GetEntitiesInRadius(Vec2 center, float radius) const
+	{
+		std::vector<EntityId> result;
+		GetEntitiesInRadius(center, radius, result);
 		return result;
 	}
 
-	std::vector<EntityId> Grid::GetPlayersInRadius(Vec2 center, float radius)
+	std::vector<EntityId> Grid::GetPlayersInRadius(Vec2 center, float radius) const
 	{
 		std::vector<EntityId> result;
-		float radiusSq = radius * radius;
-
-		CellCoord centerCell = PositionToCell(center);
-		int32_t cellRadius = static_cast<int32_t>(std::ceil(radius / GRID_CELL_SIZE)) + 1;
-
-		for (int32_t dx = -cellRadius; dx <= cellRadius; dx++)
-		{
-			for (int32_t dy = -cellRadius; dy <= cellRadius; dy++)
-			{
-				CellCoord coord{centerCell.x + dx, centerCell.y + dy};
-				GridCell* cell = GetCell(coord);
-				if (!cell)
-					continue;
-
-				for (EntityId id : cell->GetPlayers())
-				{
-					Entity* entity = m_Map->GetEntity(id);
-					if (!entity)
-						continue;
-
-					auto movement = entity->GetMovement();
-					if (!movement)
-						continue;
-
-					float distSq = Vec2::DistanceSquared(center, movement->position);
-					if (distSq <= radiusSq)
-					{
-						result.push_back(id);
-					}
-				}
-			}
-		}
-
+		GetPlayersInRadius(center, radius, result);
 		return result;
 	}
 
-	std::vector<EntityId> Grid::GetNearbyPlayers(Vec2 position)
+	std::vector<EntityId> Grid::GetNearbyPlayers(Vec2 position) const
 	{
 		return GetPlayersInRadius(position, VIEW_DISTANCE);
 	}
 
 	void Grid::ForEachPlayerNear(Vec2 position, std::function<void(EntityId playerId)> callback)
 	{
-		auto players = GetNearbyPlayers(position);
+		// Collect first so the callback may safely mutate the grid
+		std::vector<EntityId> players;
+		GetPlayersInRadius(position, VIEW_DISTANCE, players);
 		for (EntityId playerId : players)
 		{
 			callback(playerId);
 		}
 	}
 
-	std::vector<EntityId> Grid::GetVisibleEntities(Vec2 playerPosition)
+	std::vector<EntityId> Grid::GetVisibleEntities(Vec2 playerPosition) const
 	{
 		return GetEntitiesInRadius(playerPosition, VIEW_DISTANCE);
 	}
@@ -325,7 +601,10 @@ namespace MMO {
 		CellCoord coord = PositionToCell(position);
 		GridCell* cell = GetOrCreateCell(coord);
 		cell->AddSpawnPoint(spawnPointId);
-		m_CellsWithSpawns.insert(coord);
+		if (std::find(m_CellsWithSpawns.begin(), m_CellsWithSpawns.end(), coord) == m_CellsWithSpawns.end())
+		{
+			m_CellsWithSpawns.push_back(coord);
+		}
 
 		std::cout << "[Grid] Registered spawn point " << spawnPointId
 				  << " at cell (" << coord.x << ", " << coord.y << ")" << '\n';
@@ -392,18 +671,16 @@ namespace MMO {
 
 	bool Grid::IsCellActive(CellCoord coord) const
 	{
-		auto it = m_Cells.find(coord);
-		if (it == m_Cells.end())
-			return false;
-		return it->second->IsActive();
+		const GridCell* cell = GetCell(coord);
+		return cell && cell->IsActive();
 	}
 
-	const std::unordered_set<uint32_t>* Grid::GetCellSpawnPoints(CellCoord coord) const
+	const std::vector<uint32_t>* Grid::GetCellSpawnPoints(CellCoord coord) const
 	{
-		auto it = m_Cells.find(coord);
-		if (it == m_Cells.end())
+		const GridCell* cell = GetCell(coord);
+		if (!cell || cell->GetSpawnPoints().empty())
 			return nullptr;
-		return &it->second->GetSpawnPoints();
+		return &cell->GetSpawnPoints();
 	}
 
 	void Grid::RegisterSpawnedMob(CellCoord coord, EntityId mobId)
@@ -426,12 +703,10 @@ namespace MMO {
 
 	std::vector<EntityId> Grid::GetCellSpawnedMobs(CellCoord coord) const
 	{
-		auto it = m_Cells.find(coord);
-		if (it == m_Cells.end())
+		const GridCell* cell = GetCell(coord);
+		if (!cell)
 			return {};
-
-		const auto& mobs = it->second->GetSpawnedMobs();
-		return std::vector<EntityId>(mobs.begin(), mobs.end());
+		return cell->GetSpawnedMobs();
 	}
 
 	void Grid::ActivateCell(CellCoord coord)
@@ -457,20 +732,10 @@ namespace MMO {
 
 	bool Grid::HasPlayersNearCell(CellCoord coord) const
 	{
-		// Check this cell and adjacent cells for players
-		for (int32_t dx = -GRID_SEARCH_RADIUS; dx <= GRID_SEARCH_RADIUS; dx++)
-		{
-			for (int32_t dy = -GRID_SEARCH_RADIUS; dy <= GRID_SEARCH_RADIUS; dy++)
-			{
-				CellCoord checkCoord{coord.x + dx, coord.y + dy};
-				auto it = m_Cells.find(checkCoord);
-				if (it != m_Cells.end() && it->second->HasPlayers())
-				{
-					return true;
-				}
-			}
-		}
-		return false;
+		// A player within GRID_SEARCH_RADIUS cells is exactly a player whose view
+		// block covers this cell, i.e. a watcher
+		const GridCell* cell = GetCell(coord);
+		return cell && cell->HasWatchers();
 	}
 
 } // namespace MMO
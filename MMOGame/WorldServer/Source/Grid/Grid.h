@@ -3,6 +3,7 @@
 #include "GridCell.h"
 #include "GridDefines.h"
 #include <functional>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -34,11 +35,19 @@ namespace MMO {
 		// Entity management
 		void AddEntity(EntityId id, Vec2 position, bool isPlayer);
 		void RemoveEntity(EntityId id);
-		void MoveEntity(EntityId id, Vec2 oldPos, Vec2 newPos, bool isPlayer);
+		// The grid tracks each entity's cell, so only the new position is needed
+		void MoveEntity(EntityId id, Vec2 newPos, bool isPlayer);
+		// For moves too small to mark dirty: rewrites the cached position so
+		// radius queries stay exact; a cell change still goes through MoveEntity
+		void SetCachedPosition(EntityId id, Vec2 position, bool isPlayer);
+
+		// Pre-size dense cell storage to cover a world-space rectangle (map bounds)
+		void ReserveBounds(Vec2 minPosition, Vec2 maxPosition);
 
 		// Get cell at position (creates if doesn't exist)
 		GridCell* GetOrCreateCell(CellCoord coord);
 		GridCell* GetCell(CellCoord coord);
+		const GridCell* GetCell(CellCoord coord) const;
 
 		// Dirty flag management (AzerothCore-style with dirty set for O(d) iteration)
 		void MarkDirty(EntityId id, DirtyFlags flags);
@@ -47,16 +56,18 @@ namespace MMO {
 		void ClearAllDirtyFlags();
 		const std::unordered_set<EntityId>& GetDirtyEntities() const { return m_DirtyEntities; }
 
-		// Query methods
-		std::vector<EntityId> GetEntitiesInRadius(Vec2 center, float radius);
-		std::vector<EntityId> GetPlayersInRadius(Vec2 center, float radius);
-		std::vector<EntityId> GetNearbyPlayers(Vec2 position);
+		// Query methods (scan cached positions, no entity lookups)
+		std::vector<EntityId> GetEntitiesInRadius(Vec2 center, float radius) const;
+		std::vector<EntityId> GetPlayersInRadius(Vec2 center, float radius) const;
+		void GetEntitiesInRadius(Vec2 center, float radius, std::vector<EntityId>& out) const;
+		void GetPlayersInRadius(Vec2 center, float radius, std::vector<EntityId>& out) const;
+		std::vector<EntityId> GetNearbyPlayers(Vec2 position) const;
 
 		// For broadcasting - get all players who can see a position
 		void ForEachPlayerNear(Vec2 position, std::function<void(EntityId playerId)> callback);
 
 		// For full world state sync - get all entities a player can see
-		std::vector<EntityId> GetVisibleEntities(Vec2 playerPosition);
+		std::vector<EntityId> GetVisibleEntities(Vec2 playerPosition) const;
 
 		// Get entities that need update for a specific player
 		void GetDirtyEntitiesForPlayer(EntityId playerId, Vec2 playerPosition,
@@ -64,6 +75,65 @@ namespace MMO {
 									   std::vector<EntityId>& outDespawns,
 									   std::vector<EntityId>& outUpdates);
 
+		// ============================================================
+		// INCREMENTAL VISIBILITY
+		// ============================================================
+
+		// A player's view block (see IsCellInViewBlock) holds its visibility
+		// candidates. Changes are only recorded when an entity is added/removed,
+		// an entity crosses a cell boundary, or a player's view block shifts; each
+		// of those appends ordered changes to the affected players' lists. The
+		// server narrows candidates to VIEW_DISTANCE (see ForEachEntityInViewBlock).
+		struct VisibilityChange
+		{
+			EntityId id;
+			bool visible; // true = entered view, false = left view
+		};
+
+		const std::unordered_map<EntityId, std::vector<VisibilityChange>>& GetVisibilityChanges() const { return m_VisibilityChanges; }
+		void ClearVisibilityChanges();
+
+		// Position cached by the last Add/MoveEntity; false if the entity isn't tracked
+		bool GetCachedPosition(EntityId id, Vec2& outPosition) const;
+
+		// Visit every entity in the view block around a cell with its cached
+		// position, so callers can filter by distance without entity lookups
+		template <typename Fn>
+		void ForEachEntityInViewBlock(CellCoord center, Fn&& fn) const
+		{
+			for (int32_t y = center.y - GRID_SEARCH_RADIUS; y <= center.y + GRID_SEARCH_RADIUS; y++)
+			{
+				for (int32_t x = center.x - GRID_SEARCH_RADIUS; x <= center.x + GRID_SEARCH_RADIUS; x++)
+				{
+					if (const GridCell* cell = GetCell(CellCoord{x, y}))
+					{
+						const CellMemberList& entities = cell->GetEntityList();
+						const std::vector<EntityId>& ids = entities.GetIds();
+						for (uint32_t i = 0; i < ids.size(); i++)
+						{
+							fn(ids[i], entities.GetPosition(i));
+						}
+					}
+				}
+			}
+		}
+
+		// Visit every player whose view block contains the entity's cell
+		template <typename Fn>
+		void ForEachWatcher(EntityId entityId, Fn&& fn) const
+		{
+			auto it = m_EntityCells.find(entityId);
+			if (it == m_EntityCells.end())
+				return;
+			if (const GridCell* cell = GetCell(it->second.cell))
+			{
+				for (const CellWatcher& watcher : cell->GetWatchers())
+				{
+					fn(watcher.playerId);
+				}
+			}
+		}
+
 		// ============================================================
 		// GRID ACTIVATION SYSTEM (AzerothCore-style)
 		// ============================================================
@@ -81,7 +151,7 @@ namespace MMO {
 		bool IsCellActive(CellCoord coord) const;
 
 		// Get all spawn points for a cell
-		const std::unordered_set<uint32_t>* GetCellSpawnPoints(CellCoord coord) const;
+		const std::vector<uint32_t>* GetCellSpawnPoints(CellCoord coord) const;
 
 		// Track spawned mobs per cell (for cleanup on unload)
 		void RegisterSpawnedMob(CellCoord coord, EntityId mobId);
@@ -98,14 +168,67 @@ namespace MMO {
 		bool HasPlayersNearCell(CellCoord coord) const;
 
 	private:
+		static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+		// Where an entity lives: its cell plus its index in that cell's lists
+		struct EntitySlot
+		{
+			CellCoord cell;
+			uint32_t entityIndex = NO_SLOT;
+			uint32_t playerIndex = NO_SLOT; // NO_SLOT for non-players
+		};
+
+		void LinkToCell(EntityId id, EntitySlot& slot, CellCoord coord, Vec2 position, bool isPlayer);
+		void UnlinkFromCell(const EntitySlot& slot);
+		void DetachEntity(EntityId id, const EntitySlot& slot);
+
+		// Visibility bookkeeping
+		void PushVisibility(EntityId playerId, EntityId entityId, bool visible);
+		void WatchBlock(EntityId playerId, CellCoord center);
+		void UnwatchBlock(EntityId playerId, CellCoord center);
+		void ShiftWatchBlock(EntityId playerId, CellCoord from, CellCoord to);
+
+		int64_t DenseIndex(CellCoord coord) const;
+		void GrowDense(CellCoord coord);
+
+		template <typename Fn>
+		void ForEachCellInRadius(Vec2 center, float radius, Fn&& fn) const
+		{
+			CellCoord minCell = PositionToCell(Vec2(center.x - radius, center.y - radius));
+			CellCoord maxCell = PositionToCell(Vec2(center.x + radius, center.y + radius));
+			for (int32_t y = minCell.y; y <= maxCell.y; y++)
+			{
+				for (int32_t x = minCell.x; x <= maxCell.x; x++)
+				{
+					if (const GridCell* cell = GetCell(CellCoord{x, y}))
+					{
+						fn(*cell);
+					}
+				}
+			}
+		}
+
 		MapInstance* m_Map;
-		std::unordered_map<CellCoord, std::unique_ptr<GridCell>, CellCoordHash> m_Cells;
-		std::unordered_map<EntityId, CellCoord> m_EntityCells; // Track which cell each entity is in
+
+		// Dense row-major cell array covering [m_DenseMin, m_DenseMin + m_DenseSize).
+		// Grows on demand; cells beyond MAX_DENSE_CELLS worth of area fall back to
+		// the sparse overflow map so a stray far-away position can't blow up memory.
+		static constexpr int64_t MAX_DENSE_CELLS = 1 << 20;
+		std::vector<GridCell> m_Cells;
+		CellCoord m_DenseMin;
+		int32_t m_DenseWidth = 0;
+		int32_t m_DenseHeight = 0;
+		std::unordered_map<CellCoord, std::unique_ptr<GridCell>, CellCoordHash> m_OverflowCells;
+
+		std::unordered_map<EntityId, EntitySlot> m_EntityCells; // Track which cell (and slot) each entity is in
 		std::unordered_map<EntityId, DirtyFlags> m_DirtyFlags; // Per-entity dirty flags
 		std::unordered_set<EntityId> m_DirtyEntities;		   // Set of dirty entities for O(d) iteration
 
+		// Pending per-player visibility deltas, consumed once per tick
+		std::unordered_map<EntityId, std::vector<VisibilityChange>> m_VisibilityChanges;
+
 		// Cells that have spawn points (even if not yet active)
-		std::unordered_set<CellCoord, CellCoordHash> m_CellsWithSpawns;
+		std::vector<CellCoord> m_CellsWithSpawns;
 	};
 
 } // namespace MMO
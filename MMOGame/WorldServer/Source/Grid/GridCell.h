@@ -2,11 +2,91 @@
 
 #include "../../../Shared/Source/Types/Types.h"
 #include "GridDefines.h"
+#include <algorithm>
 #include <cstdint>
-#include <unordered_set>
+#include <vector>
 
 namespace MMO {
 
+	// ============================================================
+	// CELL MEMBER LIST
+	// ============================================================
+
+	// Dense id list with cached positions stored as parallel x/y arrays so
+	// radius scans walk contiguous memory. Removal is swap-with-last; the caller
+	// keeps each member's slot index and fixes up the one member that moved.
+	class CellMemberList
+	{
+	public:
+		uint32_t Add(EntityId id, Vec2 position)
+		{
+			m_Ids.push_back(id);
+			m_X.push_back(position.x);
+			m_Y.push_back(position.y);
+			return static_cast<uint32_t>(m_Ids.size() - 1);
+		}
+
+		// Returns the id now occupying `index`, or INVALID_ENTITY_ID if the
+		// removed member was the last one
+		EntityId RemoveAt(uint32_t index)
+		{
+			uint32_t last = static_cast<uint32_t>(m_Ids.size() - 1);
+			EntityId moved = INVALID_ENTITY_ID;
+			if (index != last)
+			{
+				m_Ids[index] = m_Ids[last];
+				m_X[index] = m_X[last];
+				m_Y[index] = m_Y[last];
+				moved = m_Ids[index];
+			}
+			m_Ids.pop_back();
+			m_X.pop_back();
+			m_Y.pop_back();
+			return moved;
+		}
+
+		void SetPosition(uint32_t index, Vec2 position)
+		{
+			m_X[index] = position.x;
+			m_Y[index] = position.y;
+		}
+		Vec2 GetPosition(uint32_t index) const { return Vec2(m_X[index], m_Y[index]); }
+
+		// Appends every member within sqrt(radiusSq) of center
+		void Query(Vec2 center, float radiusSq, std::vector<EntityId>& out) const
+		{
+			const size_t count = m_Ids.size();
+			const float* xs = m_X.data();
+			const float* ys = m_Y.data();
+			for (size_t i = 0; i < count; i++)
+			{
+				float dx = xs[i] - center.x;
+				float dy = ys[i] - center.y;
+				if (dx * dx + dy * dy <= radiusSq)
+				{
+					out.push_back(m_Ids[i]);
+				}
+			}
+		}
+
+		bool Empty() const { return m_Ids.empty(); }
+		size_t Size() const { return m_Ids.size(); }
+		const std::vector<EntityId>& GetIds() const { return m_Ids; }
+
+	private:
+		std::vector<EntityId> m_Ids;
+		std::vector<float> m_X;
+		std::vector<float> m_Y;
+	};
+
+	// Player whose view block includes a cell, with the center of that block so
+	// "does this watcher also see cell X" is a bounds check, not a lookup
+	struct CellWatcher
+	{
+		EntityId playerId;
+		CellCoord center;
+	};
+
 	// ============================================================
 	// GRID CELL
 	// ============================================================
@@ -18,19 +98,45 @@ namespace MMO {
 
 		CellCoord GetCoord() const { return m_Coord; }
 
-		// Entity management
-		void AddEntity(EntityId id) { m_Entities.insert(id); }
-		void RemoveEntity(EntityId id) { m_Entities.erase(id); }
-		bool HasEntity(EntityId id) const { return m_Entities.count(id) > 0; }
-
-		// Player management (subset of entities)
-		void AddPlayer(EntityId id) { m_Players.insert(id); }
-		void RemovePlayer(EntityId id) { m_Players.erase(id); }
-		bool HasPlayers() const { return !m_Players.empty(); }
-		int GetPlayerCount() const { return static_cast<int>(m_Players.size()); }
-
-		const std::unordered_set<EntityId>& GetEntities() const { return m_Entities; }
-		const std::unordered_set<EntityId>& GetPlayers() const { return m_Players; }
+		// Entity management (slot indices are owned by Grid)
+		CellMemberList& GetEntityList() { return m_Entities; }
+		CellMemberList& GetPlayerList() { return m_Players; }
+		const CellMemberList& GetEntityList() const { return m_Entities; }
+		const CellMemberList& GetPlayerList() const { return m_Players; }
+
+		bool HasPlayers() const { return !m_Players.Empty(); }
+		int GetPlayerCount() const { return static_cast<int>(m_Players.Size()); }
+
+		const std::vector<EntityId>& GetEntities() const { return m_Entities.GetIds(); }
+		const std::vector<EntityId>& GetPlayers() const { return m_Players.GetIds(); }
+
+		// Players watching this cell (maintained by Grid's visibility system)
+		void AddWatcher(EntityId playerId, CellCoord center) { m_Watchers.push_back({playerId, center}); }
+		void RemoveWatcher(EntityId playerId)
+		{
+			for (size_t i = 0; i < m_Watchers.size(); i++)
+			{
+				if (m_Watchers[i].playerId == playerId)
+				{
+					m_Watchers[i] = m_Watchers.back();
+					m_Watchers.pop_back();
+					return;
+				}
+			}
+		}
+		void SetWatcherCenter(EntityId playerId, CellCoord center)
+		{
+			for (CellWatcher& watcher : m_Watchers)
+			{
+				if (watcher.playerId == playerId)
+				{
+					watcher.center = center;
+					return;
+				}
+			}
+		}
+		bool HasWatchers() const { return !m_Watchers.empty(); }
+		const std::vector<CellWatcher>& GetWatchers() const { return m_Watchers; }
 
 		// Activation state (for mob spawning)
 		GridCellState GetState() const { return m_State; }
@@ -44,27 +150,42 @@ namespace MMO {
 		void UpdateUnloadTimer(float dt) { m_UnloadTimer -= dt; }
 
 		// Spawn points assigned to this grid cell
-		void AddSpawnPoint(uint32_t spawnPointId) { m_SpawnPoints.insert(spawnPointId); }
-		const std::unordered_set<uint32_t>& GetSpawnPoints() const { return m_SpawnPoints; }
+		void AddSpawnPoint(uint32_t spawnPointId)
+		{
+			if (std::find(m_SpawnPoints.begin(), m_SpawnPoints.end(), spawnPointId) == m_SpawnPoints.end())
+			{
+				m_SpawnPoints.push_back(spawnPointId);
+			}
+		}
+		const std::vector<uint32_t>& GetSpawnPoints() const { return m_SpawnPoints; }
 
 		// Track which mobs were spawned by this grid (for cleanup)
-		void AddSpawnedMob(EntityId mobId) { m_SpawnedMobs.insert(mobId); }
-		void RemoveSpawnedMob(EntityId mobId) { m_SpawnedMobs.erase(mobId); }
-		const std::unordered_set<EntityId>& GetSpawnedMobs() const { return m_SpawnedMobs; }
+		void AddSpawnedMob(EntityId mobId) { m_SpawnedMobs.push_back(mobId); }
+		void RemoveSpawnedMob(EntityId mobId)
+		{
+			auto it = std::find(m_SpawnedMobs.begin(), m_SpawnedMobs.end(), mobId);
+			if (it != m_SpawnedMobs.end())
+			{
+				*it = m_SpawnedMobs.back();
+				m_SpawnedMobs.pop_back();
+			}
+		}
+		const std::vector<EntityId>& GetSpawnedMobs() const { return m_SpawnedMobs; }
 		void ClearSpawnedMobs() { m_SpawnedMobs.clear(); }
 
 	private:
 		CellCoord m_Coord;
-		std::unordered_set<EntityId> m_Entities;
-		std::unordered_set<EntityId> m_Players;
+		CellMemberList m_Entities;
+		CellMemberList m_Players;
+		std::vector<CellWatcher> m_Watchers;
 
 		// Activation state
 		GridCellState m_State = GridCellState::UNLOADED;
 		float m_UnloadTimer = 0.0f;
 
 		// Spawn management
-		std::unordered_set<uint32_t> m_SpawnPoints; // Spawn point IDs in this cell
-		std::unordered_set<EntityId> m_SpawnedMobs; // Mobs spawned by this cell
+		std::vector<uint32_t> m_SpawnPoints; // Spawn point IDs in this cell
+		std::vector<EntityId> m_SpawnedMobs; // Mobs spawned by this cell
 	};
 
 } // namespace MMO
@@ -3,6 +3,7 @@
 #include "../../../Shared/Source/Types/Types.h"
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 
 namespace MMO {
 
@@ -15,6 +16,14 @@ namespace MMO {
 	constexpr int32_t GRID_SEARCH_RADIUS = 2;  // Cells to search in each direction (covers VIEW_DISTANCE)
 	constexpr float GRID_UNLOAD_DELAY = 30.0f; // Seconds before unloading inactive grid
 
+	// Known entities are dropped only past VIEW_DISTANCE + margin, so one moving
+	// along the edge doesn't spawn/despawn every tick
+	constexpr float VIEW_DESPAWN_MARGIN = 8.0f;
+
+	// The view block must contain the despawn circle wherever the player is in its cell
+	static_assert(VIEW_DISTANCE + VIEW_DESPAWN_MARGIN <= GRID_SEARCH_RADIUS * GRID_CELL_SIZE,
+				  "GRID_SEARCH_RADIUS too small for VIEW_DISTANCE");
+
 	// ============================================================
 	// CELL COORDINATE
 	// ============================================================
@@ -34,11 +43,27 @@ namespace MMO {
 	{
 		size_t operator()(const CellCoord& coord) const
 		{
-			// Simple hash combining x and y
-			return std::hash<int32_t>()(coord.x) ^ (std::hash<int32_t>()(coord.y) << 16);
+			// Pack both axes into 64 bits and mix (splitmix64 finalizer); a plain
+			// x ^ (y << 16) collides for every mirrored pair of coordinates
+			uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) |
+						   static_cast<uint32_t>(coord.y);
+			key ^= key >> 30;
+			key *= 0xbf58476d1ce4e5b9ULL;
+			key ^= key >> 27;
+			key *= 0x94d049bb133111ebULL;
+			key ^= key >> 31;
+			return static_cast<size_t>(key);
 		}
 	};
 
+	// A player watches the square block of cells within GRID_SEARCH_RADIUS of
+	// its own cell; everything in that block is visible to it
+	inline bool IsCellInViewBlock(CellCoord center, CellCoord cell)
+	{
+		return std::abs(cell.x - center.x) <= GRID_SEARCH_RADIUS &&
+			   std::abs(cell.y - center.y) <= GRID_SEARCH_RADIUS;
+	}
+
 	// ============================================================
 	// DIRTY FLAGS (Granular per-entity)
 	// ============================================================
@@ -31,6 +31,14 @@ void SignalHandler(int signal)
 	}
 }
 
+void TraceSignalHandler(int signal)
+{
+	if (g_Server)
+	{
+		g_Server->RequestTickTrace();
+	}
+}
+
 int main(int argc, char* argv[])
 {
 	std::cout << "=== MMO World Server ===" << '\n';
@@ -39,10 +47,30 @@ int main(int argc, char* argv[])
 	std::signal(SIGINT, SignalHandler);
 	std::signal(SIGTERM, SignalHandler);
 
+	// Chrome trace of the next ticks on demand: `kill -USR1 <pid>`, or
+	// Ctrl+Break on Windows
+#if defined(SIGUSR1)
+	std::signal(SIGUSR1, TraceSignalHandler);
+#elif defined(SIGBREAK)
+	std::signal(SIGBREAK, TraceSignalHandler);
+#endif
+
 	// Get configuration from environment or use defaults
 	const char* serverPort = std::getenv("WORLD_PORT");
 	uint16_t port = ParsePort(serverPort, 7001);
 
+	// Map update worker threads (<= 1 keeps map ticking on the main thread)
+	const char* mapThreads = std::getenv("MAP_UPDATE_THREADS");
+	size_t mapUpdateThreads = mapThreads ? std::strtoul(mapThreads, nullptr, 10) : 1;
+
+	// Per-phase tick timings, logged with the [Net] stats (off by default)
+	const char* tickProfiler = std::getenv("TICK_PROFILER");
+	MMO::TickProfiler::SetEnabled(tickProfiler && std::string(tickProfiler) == "1");
+
+	// Exported runtime data (server terrain lives under maps/<id>/)
+	const char* dataDir = std::getenv("WORLD_DATA_DIR");
+	std::string dataDirectory = dataDir ? dataDir : "Data";
+
 	// Database connection string
 	const char* dbHost = std::getenv("DB_HOST");
 	const char* dbUser = std::getenv("DB_USER");
@@ -58,7 +86,7 @@ int main(int argc, char* argv[])
 	MMO::WorldServer server;
 	g_Server = &server;
 
-	if (!server.Initialize(port, dbConnStr))
+	if (!server.Initialize(port, dbConnStr, mapUpdateThreads, dataDirectory))
 	{
 		std::cerr << "Failed to initialize World Server" << '\n';
 		return 1;
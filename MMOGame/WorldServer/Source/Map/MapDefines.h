@@ -2,8 +2,10 @@
 
 #include "../../../Shared/Source/Packets/Packets.h"
 #include "../../../Shared/Source/Spells/SpellDefines.h"
+#include "../../../Shared/Source/Terrain/ServerTerrain.h"
 #include "../../../Shared/Source/Types/Types.h"
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -11,6 +13,7 @@ namespace MMO {
 
 	// Forward declarations
 	class CreatureTemplate;
+	class NavGrid;
 	class TriggerScript;
 
 	// ============================================================
@@ -129,6 +132,8 @@ namespace MMO {
 		std::vector<Portal> portals;
 		std::vector<MobSpawnPoint> mobSpawns;
 		std::vector<ServerTriggerVolume> triggerVolumes;
+		std::shared_ptr<const ServerTerrain> terrain; // Baked maps/<id>/terrain.strn, null when not exported
+		std::shared_ptr<const NavGrid> navGrid; // Walkable cells of terrain for pathfinding, null without it
 	};
 
 	// ============================================================
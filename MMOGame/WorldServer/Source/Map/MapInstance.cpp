@@ -19,9 +19,12 @@ namespace MMO {
 	// ============================================================
 
 	MapInstance::MapInstance(uint32_t instanceId, const MapTemplate* tmpl)
-		: m_InstanceId(instanceId), m_Template(tmpl), m_Grid(this)
+		: m_InstanceId(instanceId), m_Template(tmpl), m_Profile(instanceId), m_Grid(this)
 	{
+		m_Grid.ReserveBounds(Vec2(0.0f, 0.0f), Vec2(tmpl->width, tmpl->height));
 		BuildTriggerCellIndex();
+		if (tmpl->navGrid)
+			m_PathFinder = std::make_unique<PathFinder>(tmpl->navGrid);
 
 		// Construct per-instance encounter script if configured
 		if (!tmpl->instanceScriptName.empty())
@@ -66,7 +69,7 @@ namespace MMO {
 									  int32_t currentHealth, int32_t currentMana)
 	{
 		EntityId id = GenerateEntityId();
-		auto entity = std::make_unique<Entity>(id, EntityType::PLAYER, name);
+		auto entity = std::make_unique<Entity>(id, EntityType::PLAYER, name, m_Components);
 
 		entity->SetClass(charClass);
 		entity->SetLevel(level);
@@ -156,7 +159,7 @@ namespace MMO {
 		}
 
 		EntityId id = GenerateEntityId();
-		auto entity = std::make_unique<Entity>(id, EntityType::MOB, tmpl->name);
+		auto entity = std::make_unique<Entity>(id, EntityType::MOB, tmpl->name, m_Components);
 
 		entity->SetLevel(tmpl->level);
 		entity->AddHealthComponent(tmpl->maxHealth);
@@ -245,6 +248,7 @@ namespace MMO {
 		m_Entities.erase(id);
 		m_Players.erase(id);
 		m_MobAIs.erase(id);
+		ClearMobPath(id);
 		m_EntityToSpawnPoint.erase(id);
 	}
 
@@ -271,9 +275,11 @@ namespace MMO {
 		// Remove from grid
 		m_Grid.RemoveEntity(id);
 
-		// Extract the entity (transfers ownership)
+		// Extract the entity (transfers ownership); its components move out of
+		// this map's pools into a private store until AdoptEntity
 		std::unique_ptr<Entity> entity = std::move(it->second);
 		m_Entities.erase(it);
+		entity->MoveToStore(nullptr);
 
 		// Clean up player registration if this is a player
 		auto playerIt = m_Players.find(id);
@@ -285,6 +291,7 @@ namespace MMO {
 
 		// Clean up associated data
 		m_MobAIs.erase(id);
+		ClearMobPath(id);
 		m_EntityToSpawnPoint.erase(id);
 		m_EntityTriggerInside.erase(id);
 
@@ -299,6 +306,8 @@ namespace MMO {
 		if (!entity)
 			return nullptr;
 
+		entity->MoveToStore(&m_Components);
+
 		EntityId id = entity->GetId();
 		Vec2 pos = entity->GetMovement() ? entity->GetMovement()->position : Vec2();
 		bool isPlayer = entity->GetType() == EntityType::PLAYER;
@@ -356,16 +365,13 @@ namespace MMO {
 		std::vector<Entity*> result;
 		float radiusSq = radius * radius;
 
-		for (auto& [id, entity] : m_Entities)
+		auto& movements = m_Components.Pool<MovementComponent>();
+		for (uint32_t i = 0; i < movements.Size(); i++)
 		{
-			auto movement = entity->GetMovement();
-			if (movement)
+			Entity* entity = movements.OwnerAt(i);
+			if (entity && Vec2::DistanceSquared(center, movements.At(i).position) <= radiusSq)
 			{
-				float distSq = Vec2::DistanceSquared(center, movement->position);
-				if (distSq <= radiusSq)
-				{
-					result.push_back(entity.get());
-				}
+				result.push_back(entity);
 			}
 		}
 		return result;
@@ -540,76 +546,206 @@ namespace MMO {
 			m_InstanceState->Update(dt);
 
 		// Update grid activation (AzerothCore-style lazy loading)
-		UpdateGridActivation(dt);
-
-		// Store old positions for grid updates and dirty tracking
-		std::unordered_map<EntityId, Vec2> oldPositions;
-		for (auto& [id, entity] : m_Entities)
 		{
-			auto movement = entity->GetMovement();
-			if (movement)
-			{
-				oldPositions[id] = movement->position;
-			}
+			PhaseScope phase(m_Profile, TickPhase::GRID_ACTIVATION);
+			UpdateGridActivation(dt);
 		}
 
+		// Store old positions for grid updates and dirty tracking. Indexed by
+		// movement slot: slots only move in Compact() at the end of the tick,
+		// and entities created this tick land past movedCount.
+		auto& movements = m_Components.Pool<MovementComponent>();
+		const uint32_t movedCount = movements.Size();
+
 		// Update all entities
-		for (auto& [id, entity] : m_Entities)
 		{
-			entity->Update(dt);
+			PhaseScope phase(m_Profile, TickPhase::ENTITY_UPDATE);
+			m_OldPositions.resize(movedCount);
+			for (uint32_t i = 0; i < movedCount; i++)
+			{
+				m_OldPositions[i] = movements.At(i).position;
+			}
+
+			UpdateCombatTimers(dt);
+			UpdateMovement(dt);
 		}
 
 		// Update mob AI
-		for (auto& [id, ai] : m_MobAIs)
 		{
-			Entity* mob = GetEntity(id);
-			if (mob && mob->GetHealth() && !mob->GetHealth()->IsDead())
+			PhaseScope phase(m_Profile, TickPhase::AI);
+			for (auto& [id, ai] : m_MobAIs)
 			{
-				UpdateMobAI(mob, dt);
+				Entity* mob = GetEntity(id);
+				if (mob && mob->GetHealth() && !mob->GetHealth()->IsDead())
+				{
+					UpdateMobAI(mob, dt);
+				}
 			}
 		}
 
-		// Check for position changes and update grid
-		for (auto& [id, entity] : m_Entities)
+		// Run the path searches the AI queued, within the tick budget
+		if (m_PathFinder)
 		{
-			auto movement = entity->GetMovement();
-			if (!movement)
-				continue;
+			PhaseScope phase(m_Profile, TickPhase::PATHFINDING);
+			m_PathFinder->Update(PathFinder::TICK_STEP_BUDGET);
+		}
 
-			auto it = oldPositions.find(id);
-			if (it != oldPositions.end())
+		// Check for position changes and update grid
+		{
+			PhaseScope phase(m_Profile, TickPhase::GRID_MOVES);
+			for (uint32_t i = 0; i < movedCount; i++)
 			{
-				Vec2 oldPos = it->second;
-				Vec2 newPos = movement->position;
+				Entity* entity = movements.OwnerAt(i);
+				if (!entity)
+					continue;
+
+				Vec2 oldPos = m_OldPositions[i];
+				Vec2 newPos = movements.At(i).position;
 
 				// Check if position changed significantly (more than 0.01 units)
 				float distSq = Vec2::DistanceSquared(oldPos, newPos);
+				bool isPlayer = (entity->GetType() == EntityType::PLAYER);
 				if (distSq > 0.0001f)
 				{
-					bool isPlayer = (entity->GetType() == EntityType::PLAYER);
-					m_Grid.MoveEntity(id, oldPos, newPos, isPlayer);
-					CheckTriggers(id, oldPos, newPos);
+					m_Grid.MoveEntity(entity->GetId(), newPos, isPlayer);
+					CheckTriggers(entity->GetId(), oldPos, newPos);
+				}
+				else if (distSq > 0.0f)
+				{
+					// Radius queries (event recipients) read the grid's cached
+					// positions, so small steps must not let them drift
+					m_Grid.SetCachedPosition(entity->GetId(), newPos, isPlayer);
 				}
 			}
 		}
 
 		// Update casts
-		UpdateCasts(dt);
+		{
+			PhaseScope phase(m_Profile, TickPhase::CASTS);
+			UpdateCasts(dt);
+		}
 
 		// Update projectiles
-		UpdateProjectiles(dt);
+		{
+			PhaseScope phase(m_Profile, TickPhase::PROJECTILES);
+			UpdateProjectiles(dt);
+		}
 
 		// Update respawns
-		UpdateRespawns(dt);
+		{
+			PhaseScope phase(m_Profile, TickPhase::RESPAWNS);
+			UpdateRespawns(dt);
+		}
 
 		// Update loot despawn timers
-		UpdateLoot(dt);
+		{
+			PhaseScope phase(m_Profile, TickPhase::LOOT);
+			UpdateLoot(dt);
+		}
 
 		// Update health/mana regeneration
-		UpdateRegeneration(dt);
+		{
+			PhaseScope phase(m_Profile, TickPhase::REGEN);
+			UpdateRegeneration(dt);
+		}
 
 		// Update auras (ticks, expiration)
-		UpdateAuras(dt);
+		{
+			PhaseScope phase(m_Profile, TickPhase::AURAS);
+			UpdateAuras(dt);
+		}
+
+		// Close the holes left by entities removed this tick. The only point
+		// where components move, so no component pointer outlives it.
+		m_Components.Compact();
+	}
+
+	// ============================================================
+	// COMPONENT SYSTEMS
+	// ============================================================
+
+	void MapInstance::UpdateCombatTimers(float dt)
+	{
+		auto& combats = m_Components.Pool<CombatComponent>();
+		for (uint32_t i = 0; i < combats.Size(); i++)
+		{
+			if (combats.OwnerAt(i))
+			{
+				TickCombatTimers(combats.At(i), dt);
+			}
+		}
+	}
+
+	// Keeps a move on walkable ground: a step from walkable onto unwalkable
+	// ground slides along whichever axis stays walkable, or is undone.
+	// Entities already off the walk map (spawned in a hole, teleported) move
+	// freely until they are back on it. Height follows the ground.
+	static void GroundMovement(const ServerTerrain& terrain, MovementComponent& movement, Vec2 from)
+	{
+		Vec2& to = movement.position;
+		if ((to.x != from.x || to.y != from.y) && !terrain.IsWalkable(to.x, to.y) &&
+			terrain.IsWalkable(from.x, from.y))
+		{
+			if (terrain.IsWalkable(to.x, from.y))
+				to = Vec2(to.x, from.y);
+			else if (terrain.IsWalkable(from.x, to.y))
+				to = Vec2(from.x, to.y);
+			else
+				to = from;
+		}
+
+		float ground;
+		if (terrain.GetHeight(to.x, to.y, ground))
+			movement.height = ground;
+	}
+
+	void MapInstance::UpdateMovement(float dt)
+	{
+		auto& movements = m_Components.Pool<MovementComponent>();
+		const auto& healths = m_Components.Pool<HealthComponent>();
+		const auto& auras = m_Components.Pool<AuraComponent>();
+		const ServerTerrain* terrain = GetTerrain();
+		for (uint32_t i = 0; i < movements.Size(); i++)
+		{
+			if (!movements.OwnerAt(i))
+				continue;
+
+			EntityHandle handle = movements.HandleAt(i);
+			MovementComponent& movement = movements.At(i);
+			const Vec2 from = movement.position;
+			IntegrateMovement(movement, healths.Get(handle), auras.Get(handle), dt);
+			if (terrain)
+				GroundMovement(*terrain, movement, from);
+		}
+	}
+
+	bool MapInstance::HasLineOfSight(const MovementComponent& from, const MovementComponent& to) const
+	{
+		const ServerTerrain* terrain = GetTerrain();
+		if (!terrain)
+			return true;
+
+		return terrain->HasLineOfSight(from.position.x, from.position.y, from.height + EYE_HEIGHT,
+									   to.position.x, to.position.y, to.height + EYE_HEIGHT);
+	}
+
+	void MapInstance::SteerMob(EntityId id, MovementComponent& movement, Vec2 goal)
+	{
+		if (!m_PathFinder)
+		{
+			movement.velocity = (goal - movement.position).Normalized() * movement.speed;
+			return;
+		}
+		movement.velocity = m_MobPaths[id].Steer(*m_PathFinder, movement.position, goal) * movement.speed;
+	}
+
+	void MapInstance::ClearMobPath(EntityId id)
+	{
+		auto it = m_MobPaths.find(id);
+		if (it == m_MobPaths.end())
+			return;
+		it->second.Reset(*m_PathFinder);
+		m_MobPaths.erase(it);
 	}
 
 	void MapInstance::UpdateMobAI(Entity* mob, float dt)
@@ -646,7 +782,8 @@ namespace MMO {
 				auto nearbyPlayers = GetPlayersInRadius(movement->position, aggro->aggroRadius);
 				for (Entity* player : nearbyPlayers)
 				{
-					if (player->GetHealth() && !player->GetHealth()->IsDead())
+					if (player->GetHealth() && !player->GetHealth()->IsDead() &&
+						HasLineOfSight(*movement, *player->GetMovement()))
 					{
 						targetId = player->GetId();
 						target = player;
@@ -682,6 +819,7 @@ namespace MMO {
 				// Arrived home
 				aggro->isEvading = false;
 				movement->velocity = Vec2(0, 0);
+				ClearMobPath(mob->GetId());
 				// Heal to full
 				auto health = mob->GetHealth();
 				if (health && health->current < health->max)
@@ -693,8 +831,7 @@ namespace MMO {
 			else
 			{
 				// Move towards home
-				Vec2 dir = (aggro->homePosition - movement->position).Normalized();
-				movement->velocity = dir * movement->speed;
+				SteerMob(mob->GetId(), *movement, aggro->homePosition);
 			}
 			return;
 		}
@@ -715,8 +852,7 @@ namespace MMO {
 			float dist = Vec2::Distance(movement->position, target->GetMovement()->position);
 			if (dist > combat->attackRange)
 			{
-				Vec2 dir = (target->GetMovement()->position - movement->position).Normalized();
-				movement->velocity = dir * movement->speed;
+				SteerMob(mob->GetId(), *movement, target->GetMovement()->position);
 			}
 			else
 			{
@@ -738,8 +874,7 @@ namespace MMO {
 			if (distToHome > 1.0f)
 			{
 				// Return to home position
-				Vec2 dir = (aggro->homePosition - movement->position).Normalized();
-				movement->velocity = dir * movement->speed;
+				SteerMob(mob->GetId(), *movement, aggro->homePosition);
 
 				// Reset combat state
 				if (ai->IsInCombat())
@@ -751,6 +886,7 @@ namespace MMO {
 			{
 				// At home, stop moving and heal to full
 				movement->velocity = Vec2(0, 0);
+				ClearMobPath(mob->GetId());
 				auto health = mob->GetHealth();
 				if (health && health->current < health->max)
 				{
@@ -1861,15 +1997,26 @@ namespace MMO {
 		}
 		m_RegenTimer -= REGEN_TICK_INTERVAL;
 
-		for (auto& [id, entity] : m_Entities)
+		auto& healths = m_Components.Pool<HealthComponent>();
+		auto& manas = m_Components.Pool<ManaComponent>();
+		auto& combats = m_Components.Pool<CombatComponent>();
+		auto& aggros = m_Components.Pool<AggroComponent>();
+		for (uint32_t i = 0; i < healths.Size(); i++)
 		{
-			auto health = entity->GetHealth();
-			auto mana = entity->GetMana();
-			auto combat = entity->GetCombat();
+			Entity* entity = healths.OwnerAt(i);
+			HealthComponent* health = &healths.At(i);
+			if (!entity || health->IsDead())
+				continue;
 
-			if (!health || health->IsDead())
+			// Full entities (and already-topped-up mobs) skip the other lookups
+			EntityHandle handle = healths.HandleAt(i);
+			ManaComponent* mana = manas.Get(handle);
+			if (health->current >= health->max && (!mana || mana->current >= mana->max))
 				continue;
 
+			CombatComponent* combat = combats.Get(handle);
+			EntityId id = entity->GetId();
+
 			bool healthChanged = false;
 			bool manaChanged = false;
 
@@ -1902,7 +2049,7 @@ namespace MMO {
 			else if (entity->GetType() == EntityType::MOB)
 			{
 				// Mob health regen: only while evading (returning home)
-				auto aggro = entity->GetAggro();
+				AggroComponent* aggro = aggros.Get(handle);
 				if (aggro && aggro->isEvading)
 				{
 					if (health->current < health->max)
@@ -1933,15 +2080,19 @@ namespace MMO {
 
 	void MapInstance::UpdateAuras(float dt)
 	{
-		for (auto& [id, entity] : m_Entities)
+		auto& auraPool = m_Components.Pool<AuraComponent>();
+		const uint32_t count = auraPool.Size(); // Entities summoned by a tick start next tick
+		for (uint32_t i = 0; i < count; i++)
 		{
-			auto auras = entity->GetAuras();
-			auto health = entity->GetHealth();
-
-			if (!auras)
+			Entity* entity = auraPool.OwnerAt(i);
+			AuraComponent* auras = &auraPool.At(i);
+			if (!entity || auras->GetAuras().empty())
 				continue;
 
-			std::vector<uint32_t> expiredAuras;
+			EntityId id = entity->GetId();
+			HealthComponent* health = entity->GetHealth();
+			std::vector<uint32_t>& expiredAuras = m_ExpiredAuras;
+			expiredAuras.clear();
 
 			for (auto& aura : auras->GetAuras())
 			{
@@ -1968,7 +2119,7 @@ namespace MMO {
 							if (health && !health->IsDead())
 							{
 								Entity* caster = GetEntity(aura.casterId);
-								ApplyDamage(caster, entity.get(), aura.value, aura.sourceAbility, aura.damageType);
+								ApplyDamage(caster, entity, aura.value, aura.sourceAbility, aura.damageType);
 							}
 							break;
 						}
@@ -1978,7 +2129,7 @@ namespace MMO {
 							if (health && !health->IsDead())
 							{
 								Entity* caster = GetEntity(aura.casterId);
-								ApplyHeal(caster, entity.get(), aura.value, aura.sourceAbility);
+								ApplyHeal(caster, entity, aura.value, aura.sourceAbility);
 							}
 							break;
 						}
@@ -2045,7 +2196,7 @@ namespace MMO {
 
 	void MapInstance::SpawnCellMobs(CellCoord coord)
 	{
-		const std::unordered_set<uint32_t>* spawnPoints = m_Grid.GetCellSpawnPoints(coord);
+		const std::vector<uint32_t>* spawnPoints = m_Grid.GetCellSpawnPoints(coord);
 		if (!spawnPoints)
 			return;
 
@@ -2122,6 +2273,7 @@ namespace MMO {
 
 			// Remove AI
 			m_MobAIs.erase(mobId);
+			ClearMobPath(mobId);
 
 			// Track for respawn later if grid reactivates
 			auto spawnIt = m_EntityToSpawnPoint.find(mobId);
@@ -6,6 +6,8 @@
 #include "../AI/InstanceScript.h"
 #include "../Entity/Entity.h"
 #include "../Grid/Grid.h"
+#include "../Navigation/PathFinder.h"
+#include "../Profiling/TickProfiler.h"
 #include "../Scripting/IMapContext.h"
 #include "MapDefines.h"
 #include <functional>
@@ -73,7 +75,16 @@ namespace MMO {
 		// Queries
 		std::vector<Entity*> GetEntitiesInRadius(Vec2 center, float radius);
 		std::vector<Entity*> GetPlayersInRadius(Vec2 center, float radius);
+		// Eye-to-eye sight over the baked server terrain; always true on maps
+		// exported without one
+		bool HasLineOfSight(const MovementComponent& from, const MovementComponent& to) const;
+		const ServerTerrain* GetTerrain() const { return m_Template->terrain.get(); }
 		const std::unordered_map<EntityId, std::unique_ptr<Entity>>& GetAllEntities() const { return m_Entities; }
+		ComponentStore& GetComponents() { return m_Components; }
+
+		// Phase timings of this map's job. Written by the MapUpdater worker
+		// running the map; read only between ticks.
+		PhaseTimeline& GetProfile() { return m_Profile; }
 
 		// Game logic
 		void Update(float dt);
@@ -144,6 +155,9 @@ namespace MMO {
 	private:
 		EntityId GenerateEntityId();
 		void UpdateMobAI(Entity* mob, float dt);
+		// Sets a mob's velocity toward `goal`, around obstacles when the map has a nav grid
+		void SteerMob(EntityId id, MovementComponent& movement, Vec2 goal);
+		void ClearMobPath(EntityId id);
 		void UpdateCasts(float dt);
 		void UpdateProjectiles(float dt);
 		void UpdateGridActivation(float dt);
@@ -151,6 +165,8 @@ namespace MMO {
 		void DespawnCellMobs(CellCoord coord);
 		void UpdateRespawns(float dt);
 		void UpdateLoot(float dt);
+		void UpdateCombatTimers(float dt);
+		void UpdateMovement(float dt);
 		void UpdateRegeneration(float dt);
 		void UpdateAuras(float dt);
 		void ExecuteAbility(EntityId sourceId, EntityId targetId, AbilityId abilityId, Vec2 targetPosition);
@@ -166,10 +182,19 @@ namespace MMO {
 		uint32_t m_InstanceId;
 		const MapTemplate* m_Template;
 
+		// Component pools for every entity on this map. Declared before
+		// m_Entities: entities release their slots on destruction.
+		ComponentStore m_Components;
+		std::vector<Vec2> m_OldPositions; // Per movement slot, reused every tick
+		std::vector<uint32_t> m_ExpiredAuras;
+		PhaseTimeline m_Profile;
+
 		std::unordered_map<EntityId, std::unique_ptr<Entity>> m_Entities;
 		std::unordered_map<EntityId, PlayerInfo> m_Players;
 		std::unordered_map<uint32_t, EntityId> m_PeerToEntity;
 		std::unordered_map<EntityId, std::unique_ptr<CreatureAI>> m_MobAIs;
+		std::unique_ptr<PathFinder> m_PathFinder; // Null when the map has no nav grid
+		std::unordered_map<EntityId, PathFollower> m_MobPaths;
 		std::unordered_map<EntityId, uint32_t> m_EntityToSpawnPoint;
 
 		// Per-instance encounter script (null if map has none configured)
@@ -196,6 +221,9 @@ namespace MMO {
 		static constexpr float PLAYER_HEALTH_REGEN_PCT = 0.02f;
 		static constexpr float PLAYER_MANA_REGEN_PCT = 0.03f;
 		static constexpr float MOB_EVADE_REGEN_PCT = 0.05f;
+
+		// Sight lines run between points this far above each entity's feet
+		static constexpr float EYE_HEIGHT = 1.5f;
 	};
 
 } // namespace MMO
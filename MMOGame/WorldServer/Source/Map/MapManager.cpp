@@ -3,9 +3,11 @@
 #include "../../../Shared/Source/Scripting/ScriptRegistry.h"
 #include "../AI/CreatureScript.h"
 #include "../AI/CreatureTemplates.h"
+#include "../Navigation/NavGrid.h"
 #include "../Triggers/TriggerScript.h"
 #include "Items/Items.h"
 #include "MapInstance.h"
+#include <cstdio>
 #include <iostream>
 
 namespace MMO {
@@ -14,7 +16,7 @@ namespace MMO {
 	// MAP MANAGER
 	// ============================================================
 
-	void MapManager::Initialize(Database& db)
+	void MapManager::Initialize(Database& db, const std::string& dataDirectory)
 	{
 		// Initialize item templates
 		ItemTemplateManager::Instance().Initialize();
@@ -97,6 +99,25 @@ namespace MMO {
 					  << tmpl.portals.size() << " portals, "
 					  << tmpl.triggerVolumes.size() << " trigger volumes" << '\n';
 
+			char terrainPath[512];
+			snprintf(terrainPath, sizeof(terrainPath), "%s/maps/%03u/terrain.strn", dataDirectory.c_str(), tmpl.id);
+			auto terrain = std::make_shared<ServerTerrain>();
+			if (terrain->Load(terrainPath))
+			{
+				std::cout << "[MapManager] Map " << t.id << " terrain: " << terrain->GetChunkCount() << " chunks, "
+						  << terrain->CountWalkableCells() << " walkable cells" << '\n';
+				auto navGrid = std::make_shared<NavGrid>(*terrain);
+				std::cout << "[MapManager] Map " << t.id << " nav grid: " << navGrid->GetWidth() << "x"
+						  << navGrid->GetHeight() << " cells, " << navGrid->GetRegionCount() << " walkable regions" << '\n';
+				tmpl.terrain = std::move(terrain);
+				tmpl.navGrid = std::move(navGrid);
+			}
+			else
+			{
+				std::cout << "[MapManager] Map " << t.id << " has no server terrain (" << terrainPath
+						  << "), movement is not grounded" << '\n';
+			}
+
 			m_Templates[tmpl.id] = std::move(tmpl);
 		}
 
@@ -193,11 +214,68 @@ namespace MMO {
 		return it != m_Templates.end() ? &it->second : nullptr;
 	}
 
-	void MapManager::Update(float dt)
+	void MapManager::SetUpdateThreads(size_t numThreads)
+	{
+		if (numThreads > 1)
+		{
+			m_Updater.Activate(numThreads);
+			std::cout << "[MapManager] Updating maps on " << numThreads << " worker threads" << '\n';
+		}
+		else
+		{
+			m_Updater.Deactivate();
+		}
+	}
+
+	void MapManager::Update(float dt, const std::function<void(MapInstance*)>& afterUpdate)
 	{
+		// One map's job: update, then its sends. Runs on a single thread, so
+		// the map's profile needs no locking.
+		auto runMap = [dt, &afterUpdate](MapInstance* map) {
+			{
+				PhaseScope phase(map->GetProfile(), TickPhase::MAP_TOTAL);
+				map->Update(dt);
+				if (afterUpdate)
+					afterUpdate(map);
+			}
+			map->GetProfile().EndTick();
+		};
+
+		if (!m_Updater.IsActive() || m_Instances.size() < 2)
+		{
+			for (auto& [id, instance] : m_Instances)
+			{
+				runMap(instance.get());
+			}
+			return;
+		}
+
 		for (auto& [id, instance] : m_Instances)
 		{
-			instance->Update(dt);
+			MapInstance* map = instance.get();
+			m_Updater.Schedule([map, &runMap]() { runMap(map); });
+		}
+		m_Updater.Wait();
+	}
+
+	void MapManager::Defer(std::function<void()> operation)
+	{
+		std::lock_guard<std::mutex> lock(m_DeferredMutex);
+		m_Deferred.push_back(std::move(operation));
+	}
+
+	void MapManager::ProcessDeferred()
+	{
+		std::vector<std::function<void()>> operations;
+		{
+			std::lock_guard<std::mutex> lock(m_DeferredMutex);
+			operations.swap(m_Deferred);
+		}
+
+		// Operations may Defer() again; those run at the next sync point
+		for (auto& operation : operations)
+		{
+			operation();
 		}
 	}
 
@@ -2,8 +2,13 @@
 
 #include "../../../Shared/Source/Types/Types.h"
 #include "MapDefines.h"
+#include "MapUpdater.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace MMO {
 
@@ -25,8 +30,10 @@ namespace MMO {
 		}
 
 		// Initialize with map templates loaded from the database. DB is now the
-		// single source of truth (no hardcoded fallback).
-		void Initialize(Database& db);
+		// single source of truth (no hardcoded fallback). Each map's server
+		// terrain is read from <dataDirectory>/maps/<id>/terrain.strn when the
+		// editor exported one.
+		void Initialize(Database& db, const std::string& dataDirectory = "Data");
 
 		// Get map instance (creates if needed for world maps)
 		MapInstance* GetMapInstance(uint32_t templateId);
@@ -37,8 +44,18 @@ namespace MMO {
 		// Get template
 		const MapTemplate* GetTemplate(uint32_t templateId);
 
-		// Update all maps
-		void Update(float dt);
+		// Size the map update worker pool; 0 or 1 updates maps inline on the caller
+		void SetUpdateThreads(size_t numThreads);
+		size_t GetUpdateThreads() const { return m_Updater.GetThreadCount(); }
+
+		// Update all maps. afterUpdate runs on the same worker right after each
+		// map's Update (per-map serialization); it must only touch that map.
+		void Update(float dt, const std::function<void(MapInstance*)>& afterUpdate = nullptr);
+
+		// Cross-instance work (transfers, DB saves) requested during the tick is
+		// queued here and applied on the main thread by ProcessDeferred()
+		void Defer(std::function<void()> operation);
+		void ProcessDeferred();
 
 		// Transfer player between maps (returns new entity ID)
 		EntityId TransferPlayer(EntityId playerId, uint32_t fromInstanceId,
@@ -52,7 +69,7 @@ namespace MMO {
 		}
 
 		// Global entity ID generation (prevents ID collision across maps)
-		EntityId GenerateGlobalEntityId() { return m_NextGlobalEntityId++; }
+		EntityId GenerateGlobalEntityId() { return m_NextGlobalEntityId.fetch_add(1, std::memory_order_relaxed); }
 
 	private:
 		MapManager() = default;
@@ -63,7 +80,11 @@ namespace MMO {
 		std::unordered_map<uint32_t, MapTemplate> m_Templates;
 		std::unordered_map<uint32_t, std::unique_ptr<MapInstance>> m_Instances;
 		uint32_t m_NextInstanceId = 1;
-		EntityId m_NextGlobalEntityId = 1; // Global counter across all maps
+		std::atomic<EntityId> m_NextGlobalEntityId{1}; // Global counter across all maps (maps tick in parallel)
+
+		MapUpdater m_Updater;
+		std::mutex m_DeferredMutex;
+		std::vector<std::function<void()>> m_Deferred;
 	};
 
 } // namespace MMO
@@ -0,0 +1,94 @@
+#include "MapUpdater.h"
+#include <exception>
+#include <iostream>
+
+namespace MMO {
+
+	MapUpdater::~MapUpdater()
+	{
+		Deactivate();
+	}
+
+	void MapUpdater::Activate(size_t numThreads)
+	{
+		Deactivate();
+
+		m_Stopping = false;
+		m_Workers.reserve(numThreads);
+		for (size_t i = 0; i < numThreads; ++i)
+		{
+			m_Workers.emplace_back(&MapUpdater::WorkerThread, this);
+		}
+	}
+
+	void MapUpdater::Deactivate()
+	{
+		if (m_Workers.empty())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_JobAvailable.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			worker.join();
+		}
+		m_Workers.clear();
+	}
+
+	void MapUpdater::Schedule(std::function<void()> job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Jobs.push(std::move(job));
+			m_PendingJobs++;
+		}
+		m_JobAvailable.notify_one();
+	}
+
+	void MapUpdater::Wait()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_AllDone.wait(lock, [this] { return m_PendingJobs == 0; });
+	}
+
+	void MapUpdater::WorkerThread()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_JobAvailable.wait(lock, [this] { return m_Stopping || !m_Jobs.empty(); });
+				if (m_Stopping && m_Jobs.empty())
+					return;
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop();
+			}
+
+			// A throwing map must not take the whole server down with std::terminate
+			try
+			{
+				job();
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "[MapUpdater] Map update threw: " << e.what() << '\n';
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_PendingJobs--;
+				if (m_PendingJobs == 0)
+				{
+					m_AllDone.notify_all();
+				}
+			}
+		}
+	}
+
+} // namespace MMO
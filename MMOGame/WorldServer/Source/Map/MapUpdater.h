@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace MMO {
+
+	// ============================================================
+	// MAP UPDATER (TrinityCore-style worker pool)
+	// ============================================================
+	//
+	// Runs one job per map instance in parallel. Schedule() every job for
+	// the tick, then Wait() blocks until all of them have finished. Jobs
+	// must only touch state owned by their map.
+
+	class MapUpdater
+	{
+	public:
+		MapUpdater() = default;
+		~MapUpdater();
+
+		MapUpdater(const MapUpdater&) = delete;
+		MapUpdater& operator=(const MapUpdater&) = delete;
+
+		void Activate(size_t numThreads);
+		void Deactivate();
+		bool IsActive() const { return !m_Workers.empty(); }
+		size_t GetThreadCount() const { return m_Workers.size(); }
+
+		void Schedule(std::function<void()> job);
+		void Wait();
+
+	private:
+		void WorkerThread();
+
+		std::vector<std::thread> m_Workers;
+		std::queue<std::function<void()>> m_Jobs;
+		std::mutex m_Mutex;
+		std::condition_variable m_JobAvailable;
+		std::condition_variable m_AllDone;
+		size_t m_PendingJobs = 0;
+		bool m_Stopping = false;
+	};
+
+} // namespace MMO
@@ -0,0 +1,207 @@
+#include "NavGrid.h"
+#include <bit>
+#include <cstdlib>
+#include <limits>
+
+namespace MMO {
+
+	NavGrid::NavGrid(const ServerTerrain& terrain)
+		: m_MinX(terrain.GetMinCellX()), m_MinY(terrain.GetMinCellZ()),
+		  m_Width(terrain.GetCellsX()), m_Height(terrain.GetCellsZ()),
+		  m_WordsPerRow((m_Width + 63) / 64), m_WordsPerColumn((m_Height + 63) / 64)
+	{
+		m_Bits.assign(static_cast<size_t>(m_WordsPerRow) * m_Height, 0);
+		m_Columns.assign(static_cast<size_t>(m_WordsPerColumn) * m_Width, 0);
+		for (uint32_t y = 0; y < m_Height; y++)
+		{
+			for (uint32_t x = 0; x < m_Width; x++)
+			{
+				if (terrain.IsCellWalkable(m_MinX + static_cast<int32_t>(x), m_MinY + static_cast<int32_t>(y)))
+				{
+					m_Bits[y * m_WordsPerRow + (x >> 6)] |= 1ULL << (x & 63);
+					m_Columns[x * m_WordsPerColumn + (y >> 6)] |= 1ULL << (y & 63);
+				}
+			}
+		}
+		LabelRegions();
+	}
+
+	NavGrid::LineScan NavGrid::Scan(const std::vector<uint64_t>& bits, uint32_t wordsPerLine, uint32_t length,
+									uint32_t lines, int32_t along, int32_t line, int32_t step)
+	{
+		// Bits past the end of a line are zero, so they read as unwalkable;
+		// so do the missing lines beside the first and last
+		auto word = [&](int32_t l, int32_t w) -> uint64_t {
+			if (static_cast<uint32_t>(l) >= lines || static_cast<uint32_t>(w) >= wordsPerLine)
+				return 0;
+			return bits[static_cast<size_t>(l) * wordsPerLine + w];
+		};
+
+		LineScan scan{0, true, 0};
+		if (step > 0)
+		{
+			for (int32_t w = (along + 1) >> 6; w < static_cast<int32_t>(wordsPerLine); w++)
+			{
+				scan.words++;
+				const uint64_t cur = word(line, w);
+				const uint64_t left = word(line - 1, w);
+				const uint64_t right = word(line + 1, w);
+				// Bit i of *Behind = the side cell one step back
+				const uint64_t leftBehind = (left << 1) | (word(line - 1, w - 1) >> 63);
+				const uint64_t rightBehind = (right << 1) | (word(line + 1, w - 1) >> 63);
+				uint64_t stop = ~cur | (left & ~leftBehind) | (right & ~rightBehind);
+				if (w == (along + 1) >> 6)
+					stop &= ~((1ULL << ((along + 1) & 63)) - 1);
+				if (stop != 0)
+				{
+					const int32_t bit = std::countr_zero(stop);
+					scan.distance = w * 64 + bit - along;
+					scan.blocked = ((cur >> bit) & 1) == 0;
+					return scan;
+				}
+			}
+			scan.distance = static_cast<int32_t>(length) - along;
+		}
+		else
+		{
+			for (int32_t w = (along - 1) >> 6; w >= 0; w--)
+			{
+				scan.words++;
+				const uint64_t cur = word(line, w);
+				const uint64_t left = word(line - 1, w);
+				const uint64_t right = word(line + 1, w);
+				const uint64_t leftBehind = (left >> 1) | (word(line - 1, w + 1) << 63);
+				const uint64_t rightBehind = (right >> 1) | (word(line + 1, w + 1) << 63);
+				uint64_t stop = ~cur | (left & ~leftBehind) | (right & ~rightBehind);
+				if (w == (along - 1) >> 6)
+					stop &= (2ULL << ((along - 1) & 63)) - 1;
+				if (stop != 0)
+				{
+					const int32_t bit = 63 - std::countl_zero(stop);
+					scan.distance = along - (w * 64 + bit);
+					scan.blocked = ((cur >> bit) & 1) == 0;
+					return scan;
+				}
+			}
+			scan.distance = along + 1;
+		}
+		return scan;
+	}
+
+	void NavGrid::LabelRegions()
+	{
+		// Without corner cutting every diagonal move has an orthogonal detour,
+		// so 4-connectivity gives the same regions as 8-way movement
+		m_Regions.assign(static_cast<size_t>(m_Width) * m_Height, 0);
+		std::vector<uint32_t> queue;
+		for (uint32_t seed = 0; seed < m_Regions.size(); seed++)
+		{
+			const int32_t seedX = m_MinX + static_cast<int32_t>(seed % m_Width);
+			const int32_t seedY = m_MinY + static_cast<int32_t>(seed / m_Width);
+			if (m_Regions[seed] != 0 || !IsWalkable(seedX, seedY))
+				continue;
+
+			const uint32_t region = ++m_RegionCount;
+			m_Regions[seed] = region;
+			queue.clear();
+			queue.push_back(seed);
+			for (size_t head = 0; head < queue.size(); head++)
+			{
+				const uint32_t index = queue[head];
+				const int32_t x = m_MinX + static_cast<int32_t>(index % m_Width);
+				const int32_t y = m_MinY + static_cast<int32_t>(index / m_Width);
+				const int32_t neighbors[4][2] = {{x + 1, y}, {x - 1, y}, {x, y + 1}, {x, y - 1}};
+				for (const auto& n : neighbors)
+				{
+					if (!IsWalkable(n[0], n[1]))
+						continue;
+					const uint32_t next = static_cast<uint32_t>(n[1] - m_MinY) * m_Width + static_cast<uint32_t>(n[0] - m_MinX);
+					if (m_Regions[next] == 0)
+					{
+						m_Regions[next] = region;
+						queue.push_back(next);
+					}
+				}
+			}
+		}
+	}
+
+	bool NavGrid::IsLineWalkable(Vec2 from, Vec2 to) const
+	{
+		int32_t cellX = ToCell(from.x);
+		int32_t cellY = ToCell(from.y);
+		const int32_t endX = ToCell(to.x);
+		const int32_t endY = ToCell(to.y);
+		if (!IsWalkable(cellX, cellY))
+			return false;
+
+		constexpr float INF = std::numeric_limits<float>::infinity();
+		const float dx = to.x - from.x;
+		const float dy = to.y - from.y;
+		const int32_t stepX = dx > 0.0f ? 1 : -1;
+		const int32_t stepY = dy > 0.0f ? 1 : -1;
+		float tMaxX = dx != 0.0f ? ((cellX + (dx > 0.0f ? 1 : 0)) * SERVER_TERRAIN_CELL_SIZE - from.x) / dx : INF;
+		float tMaxY = dy != 0.0f ? ((cellY + (dy > 0.0f ? 1 : 0)) * SERVER_TERRAIN_CELL_SIZE - from.y) / dy : INF;
+		const float tDeltaX = dx != 0.0f ? SERVER_TERRAIN_CELL_SIZE / std::abs(dx) : INF;
+		const float tDeltaY = dy != 0.0f ? SERVER_TERRAIN_CELL_SIZE / std::abs(dy) : INF;
+
+		// Bounded by the cell distance in case rounding misses the end cell
+		int32_t steps = std::abs(endX - cellX) + std::abs(endY - cellY);
+		while ((cellX != endX || cellY != endY) && steps-- > 0)
+		{
+			if (std::abs(tMaxX - tMaxY) < 1e-6f)
+			{
+				// Exactly through a corner: both cells beside it must be open
+				if (!IsWalkable(cellX + stepX, cellY) || !IsWalkable(cellX, cellY + stepY))
+					return false;
+				cellX += stepX;
+				cellY += stepY;
+				tMaxX += tDeltaX;
+				tMaxY += tDeltaY;
+				steps--;
+			}
+			else if (tMaxX < tMaxY)
+			{
+				cellX += stepX;
+				tMaxX += tDeltaX;
+			}
+			else
+			{
+				cellY += stepY;
+				tMaxY += tDeltaY;
+			}
+
+			if (!IsWalkable(cellX, cellY))
+				return false;
+		}
+		return true;
+	}
+
+	bool NavGrid::FindNearestWalkable(int32_t& cellX, int32_t& cellY, int32_t radius) const
+	{
+		if (IsWalkable(cellX, cellY))
+			return true;
+
+		for (int32_t r = 1; r <= radius; r++)
+		{
+			for (int32_t offset = -r; offset <= r; offset++)
+			{
+				const int32_t ring[4][2] = {{cellX + offset, cellY - r},
+											{cellX + offset, cellY + r},
+											{cellX - r, cellY + offset},
+											{cellX + r, cellY + offset}};
+				for (const auto& c : ring)
+				{
+					if (IsWalkable(c[0], c[1]))
+					{
+						cellX = c[0];
+						cellY = c[1];
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+} // namespace MMO
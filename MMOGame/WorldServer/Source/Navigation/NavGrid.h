@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../../../Shared/Source/Terrain/ServerTerrain.h"
+#include "../../../Shared/Source/Types/Types.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace MMO {
+
+	// ============================================================
+	// NAV GRID
+	// ============================================================
+	//
+	// The walkable cells of a map's ServerTerrain, flattened into one dense
+	// bitmap over the terrain's cell range for the pathfinder's inner loops,
+	// plus a connected-region label per cell so unreachable goals are
+	// rejected without a search. Built once per map template and shared
+	// read-only by every instance.
+	//
+	// Cells are SERVER_TERRAIN_CELL_SIZE squares in server ground
+	// coordinates: Vec2 (x, y) = world (x, z). Moves are 8-way, and a
+	// diagonal move needs both cells beside it walkable (no corner cutting).
+
+	class NavGrid
+	{
+	public:
+		explicit NavGrid(const ServerTerrain& terrain);
+
+		int32_t GetMinCellX() const { return m_MinX; }
+		int32_t GetMinCellY() const { return m_MinY; }
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+		uint32_t GetRegionCount() const { return m_RegionCount; }
+
+		bool IsWalkable(int32_t cellX, int32_t cellY) const
+		{
+			const uint32_t x = static_cast<uint32_t>(cellX - m_MinX);
+			const uint32_t y = static_cast<uint32_t>(cellY - m_MinY);
+			if (x >= m_Width || y >= m_Height)
+				return false;
+			return (m_Bits[y * m_WordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+		}
+
+		// 0 for unwalkable cells; equal non-zero labels are connected
+		uint32_t GetRegion(int32_t cellX, int32_t cellY) const
+		{
+			const uint32_t x = static_cast<uint32_t>(cellX - m_MinX);
+			const uint32_t y = static_cast<uint32_t>(cellY - m_MinY);
+			if (x >= m_Width || y >= m_Height)
+				return 0;
+			return m_Regions[y * m_Width + x];
+		}
+
+		// Whether walking the straight segment only crosses walkable cells,
+		// corners included
+		bool IsLineWalkable(Vec2 from, Vec2 to) const;
+
+		// Straight-jump scan for Jump Point Search, a 64-cell word at a time:
+		// from (cellX, cellY) along X (or Y) in direction `step` (+1 or -1),
+		// the distance to the first cell that is unwalkable or has a forced
+		// neighbor, i.e. a walkable side cell next to a blocked one behind it
+		struct LineScan
+		{
+			int32_t distance;
+			bool blocked; // Stopped at an unwalkable cell or the grid edge
+			uint32_t words;
+		};
+		LineScan ScanX(int32_t cellX, int32_t cellY, int32_t step) const
+		{
+			return Scan(m_Bits, m_WordsPerRow, m_Width, m_Height, cellX - m_MinX, cellY - m_MinY, step);
+		}
+		LineScan ScanY(int32_t cellX, int32_t cellY, int32_t step) const
+		{
+			return Scan(m_Columns, m_WordsPerColumn, m_Height, m_Width, cellY - m_MinY, cellX - m_MinX, step);
+		}
+
+		// Nearest walkable cell within `radius` cells (Chebyshev rings);
+		// leaves the cell unchanged and returns false if there is none
+		bool FindNearestWalkable(int32_t& cellX, int32_t& cellY, int32_t radius) const;
+
+		static int32_t ToCell(float coord)
+		{
+			return static_cast<int32_t>(std::floor(coord / SERVER_TERRAIN_CELL_SIZE));
+		}
+		static Vec2 CellCenter(int32_t cellX, int32_t cellY)
+		{
+			return Vec2((cellX + 0.5f) * SERVER_TERRAIN_CELL_SIZE, (cellY + 0.5f) * SERVER_TERRAIN_CELL_SIZE);
+		}
+
+	private:
+		void LabelRegions();
+		static LineScan Scan(const std::vector<uint64_t>& bits, uint32_t wordsPerLine, uint32_t length, uint32_t lines,
+							 int32_t along, int32_t line, int32_t step);
+
+		int32_t m_MinX = 0;
+		int32_t m_MinY = 0;
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint32_t m_WordsPerRow = 0;
+		uint32_t m_WordsPerColumn = 0;
+		uint32_t m_RegionCount = 0;
+		std::vector<uint64_t> m_Bits;	 // Row-major, bit x of word x/64
+		std::vector<uint64_t> m_Columns; // The same bits transposed, for ScanY
+		std::vector<uint32_t> m_Regions; // Row-major
+	};
+
+} // namespace MMO
@@ -0,0 +1,587 @@
+#include "PathFinder.h"
+#include <algorithm>
+#include <limits>
+
+namespace MMO {
+
+	namespace {
+
+		constexpr float SQRT2 = 1.41421356f;
+
+		// Cost of a straight or diagonal run covering (dx, dy) cells
+		float Octile(int32_t dx, int32_t dy)
+		{
+			dx = std::abs(dx);
+			dy = std::abs(dy);
+			return static_cast<float>(std::max(dx, dy)) + (SQRT2 - 1.0f) * static_cast<float>(std::min(dx, dy));
+		}
+
+		// Min-heap on f; among equal f, deeper nodes first
+		bool OpenGreater(float fa, float ga, float fb, float gb)
+		{
+			return fa > fb || (fa == fb && ga < gb);
+		}
+
+	} // namespace
+
+	PathFinder::PathFinder(std::shared_ptr<const NavGrid> grid)
+		: m_Grid(std::move(grid))
+	{
+	}
+
+	// ============================================================
+	// REQUESTS
+	// ============================================================
+
+	bool PathFinder::Prepare(Vec2 from, Vec2 to, uint64_t& key, uint32_t& start, uint32_t& goal) const
+	{
+		int32_t startX = NavGrid::ToCell(from.x), startY = NavGrid::ToCell(from.y);
+		int32_t goalX = NavGrid::ToCell(to.x), goalY = NavGrid::ToCell(to.y);
+		if (!m_Grid->FindNearestWalkable(startX, startY, SNAP_RADIUS) ||
+			!m_Grid->FindNearestWalkable(goalX, goalY, SNAP_RADIUS))
+			return false;
+		if (m_Grid->GetRegion(startX, startY) != m_Grid->GetRegion(goalX, goalY))
+			return false;
+
+		start = ToIndex(startX, startY);
+		goal = ToIndex(goalX, goalY);
+		key = (static_cast<uint64_t>(start) << 32) | goal;
+		return true;
+	}
+
+	void PathFinder::Finish(const CachedPath& cached, Vec2 to, uint32_t start, uint32_t goal,
+							std::vector<Vec2>& outPath) const
+	{
+		outPath.clear();
+		if (cached.status != PathStatus::FOUND)
+			return;
+
+		outPath.assign(cached.waypoints.begin(), cached.waypoints.end());
+		if (outPath.empty())
+			outPath.push_back(NavGrid::CellCenter(IndexX(goal), IndexY(goal)));
+
+		// End on the goal itself unless it had to be snapped to another cell.
+		// The last leg is bent from the goal cell's center to it when still
+		// walkable, else the center stays as a corner.
+		if (NavGrid::ToCell(to.x) != IndexX(goal) || NavGrid::ToCell(to.y) != IndexY(goal))
+			return;
+		const Vec2 corner =
+			outPath.size() >= 2 ? outPath[outPath.size() - 2] : NavGrid::CellCenter(IndexX(start), IndexY(start));
+		if (m_Grid->IsLineWalkable(corner, to))
+			outPath.back() = to;
+		else
+			outPath.push_back(to);
+	}
+
+	void PathFinder::Store(uint64_t key, CachedPath path)
+	{
+		if (m_Cache.size() >= CACHE_CAPACITY && !m_CacheOrder.empty())
+		{
+			m_Cache.erase(m_CacheOrder.front());
+			m_CacheOrder.pop_front();
+		}
+		if (m_Cache.emplace(key, std::move(path)).second)
+			m_CacheOrder.push_back(key);
+	}
+
+	PathStatus PathFinder::FindPath(Vec2 from, Vec2 to, std::vector<Vec2>& outPath)
+	{
+		m_Stats.requests++;
+		outPath.clear();
+
+		uint64_t key;
+		uint32_t start, goal;
+		if (!Prepare(from, to, key, start, goal))
+		{
+			m_Stats.unreachable++;
+			return PathStatus::NO_PATH;
+		}
+
+		auto it = m_Cache.find(key);
+		if (it != m_Cache.end())
+		{
+			m_Stats.cacheHits++;
+			Finish(it->second, to, start, goal, outPath);
+			return it->second.status;
+		}
+
+		// This clobbers the search state, so a queued search mid-way restarts
+		m_SearchActive = false;
+		m_Stats.searches++;
+		BeginSearch(start, goal);
+		CachedPath path;
+		uint32_t budget = std::numeric_limits<uint32_t>::max();
+		StepSearch(budget, path);
+		Finish(path, to, start, goal, outPath);
+		const PathStatus status = path.status;
+		Store(key, std::move(path));
+		return status;
+	}
+
+	PathRequestId PathFinder::Request(Vec2 from, Vec2 to)
+	{
+		m_Stats.requests++;
+		const PathRequestId id = m_NextId++;
+		if (m_NextId == INVALID_PATH_REQUEST)
+			m_NextId = 1;
+
+		auto& result = m_Results[id];
+		result.first = PathStatus::NO_PATH;
+
+		QueuedRequest request{id, to, 0, 0, 0};
+		if (!Prepare(from, to, request.key, request.start, request.goal))
+		{
+			m_Stats.unreachable++;
+			return id;
+		}
+
+		auto it = m_Cache.find(request.key);
+		if (it != m_Cache.end())
+		{
+			m_Stats.cacheHits++;
+			Finish(it->second, to, request.start, request.goal, result.second);
+			result.first = it->second.status;
+			return id;
+		}
+
+		result.first = PathStatus::PENDING;
+		m_Queue.push_back(request);
+		return id;
+	}
+
+	PathStatus PathFinder::Poll(PathRequestId id, std::vector<Vec2>& outPath)
+	{
+		auto it = m_Results.find(id);
+		if (it == m_Results.end())
+			return PathStatus::NO_PATH;
+
+		const PathStatus status = it->second.first;
+		if (status == PathStatus::PENDING)
+			return status;
+
+		outPath = std::move(it->second.second);
+		m_Results.erase(it);
+		return status;
+	}
+
+	void PathFinder::Cancel(PathRequestId id)
+	{
+		// The queue entry is dropped when Update reaches it
+		m_Results.erase(id);
+	}
+
+	void PathFinder::Update(uint32_t stepBudget)
+	{
+		while (!m_Queue.empty() && stepBudget > 0)
+		{
+			const QueuedRequest& request = m_Queue.front();
+			auto resultIt = m_Results.find(request.id);
+			if (resultIt == m_Results.end())
+			{
+				m_SearchActive = false;
+				m_Queue.pop_front();
+				continue;
+			}
+
+			if (!m_SearchActive)
+			{
+				// An earlier request may have searched the same pair
+				auto cacheIt = m_Cache.find(request.key);
+				if (cacheIt != m_Cache.end())
+				{
+					m_Stats.cacheHits++;
+					Finish(cacheIt->second, request.to, request.start, request.goal, resultIt->second.second);
+					resultIt->second.first = cacheIt->second.status;
+					m_Queue.pop_front();
+					continue;
+				}
+
+				m_Stats.searches++;
+				BeginSearch(request.start, request.goal);
+				m_SearchActive = true;
+			}
+
+			CachedPath path;
+			if (!StepSearch(stepBudget, path))
+				break;
+
+			m_SearchActive = false;
+			Finish(path, request.to, request.start, request.goal, resultIt->second.second);
+			resultIt->second.first = path.status;
+			Store(request.key, std::move(path));
+			m_Queue.pop_front();
+		}
+	}
+
+	// ============================================================
+	// JUMP POINT SEARCH
+	// ============================================================
+	//
+	// Harabor & Grastien's pruning, in the variant that forbids corner
+	// cutting: straight runs stop where a side cell opens up behind an
+	// obstacle, diagonal runs stop where either straight run from them would.
+	// Only those jump points enter the open list. Straight runs scan the
+	// NavGrid bitmap a word at a time (the block-based variant).
+
+	float PathFinder::Heuristic(int32_t x, int32_t y) const
+	{
+		return Octile(x - m_GoalX, y - m_GoalY);
+	}
+
+	void PathFinder::BeginSearch(uint32_t start, uint32_t goal)
+	{
+		if (m_Nodes.empty())
+			m_Nodes.resize(static_cast<size_t>(m_Grid->GetWidth()) * m_Grid->GetHeight());
+
+		if (++m_Generation == 0)
+		{
+			for (Node& node : m_Nodes)
+			{
+				node.generation = 0;
+			}
+			m_Generation = 1;
+		}
+
+		m_SearchStart = start;
+		m_SearchGoal = goal;
+		m_GoalX = IndexX(goal);
+		m_GoalY = IndexY(goal);
+		m_SearchSteps = 0;
+
+		Node& node = m_Nodes[start];
+		node.g = 0.0f;
+		node.parent = start;
+		node.generation = m_Generation;
+		node.closed = false;
+
+		m_Open.clear();
+		m_Open.push_back({Heuristic(IndexX(start), IndexY(start)), 0.0f, start});
+	}
+
+	bool PathFinder::StepSearch(uint32_t& budget, CachedPath& out)
+	{
+		auto greater = [](const OpenEntry& a, const OpenEntry& b) { return OpenGreater(a.f, a.g, b.f, b.g); };
+
+		while (!m_Open.empty() && m_SearchSteps <= MAX_SEARCH_STEPS)
+		{
+			if (budget == 0)
+				return false;
+
+			std::pop_heap(m_Open.begin(), m_Open.end(), greater);
+			const OpenEntry entry = m_Open.back();
+			m_Open.pop_back();
+
+			Node& node = m_Nodes[entry.index];
+			if (node.closed || entry.g > node.g)
+				continue;
+			node.closed = true;
+
+			if (entry.index == m_SearchGoal)
+			{
+				out.status = PathStatus::FOUND;
+				BuildPath(out);
+				return true;
+			}
+
+			m_ExpandSteps = 1;
+			Expand(entry.index);
+			m_SearchSteps += m_ExpandSteps;
+			m_Stats.scanSteps += m_ExpandSteps;
+			budget -= std::min(budget, m_ExpandSteps);
+		}
+
+		out.status = PathStatus::NO_PATH;
+		out.waypoints.clear();
+		return true;
+	}
+
+	void PathFinder::Expand(uint32_t index)
+	{
+		const int32_t x = IndexX(index);
+		const int32_t y = IndexY(index);
+
+		int32_t dirs[8][2];
+		int count = 0;
+		auto add = [&](int32_t dx, int32_t dy) {
+			dirs[count][0] = dx;
+			dirs[count][1] = dy;
+			count++;
+		};
+
+		const Node& node = m_Nodes[index];
+		if (index == m_SearchStart)
+		{
+			for (int32_t dy = -1; dy <= 1; dy++)
+			{
+				for (int32_t dx = -1; dx <= 1; dx++)
+				{
+					if (dx == 0 && dy == 0)
+						continue;
+					if (dx != 0 && dy != 0 && !(Walkable(x + dx, y) && Walkable(x, y + dy)))
+						continue;
+					add(dx, dy);
+				}
+			}
+		}
+		else
+		{
+			const int32_t px = IndexX(node.parent);
+			const int32_t py = IndexY(node.parent);
+			const int32_t dx = (x > px) - (x < px);
+			const int32_t dy = (y > py) - (y < py);
+
+			if (dx != 0 && dy != 0)
+			{
+				const bool alongY = Walkable(x, y + dy);
+				const bool alongX = Walkable(x + dx, y);
+				if (alongY)
+					add(0, dy);
+				if (alongX)
+					add(dx, 0);
+				if (alongY && alongX)
+					add(dx, dy);
+			}
+			else if (dx != 0)
+			{
+				const bool ahead = Walkable(x + dx, y);
+				const bool up = Walkable(x, y + 1);
+				const bool down = Walkable(x, y - 1);
+				if (ahead)
+				{
+					add(dx, 0);
+					if (up)
+						add(dx, 1);
+					if (down)
+						add(dx, -1);
+				}
+				if (up)
+					add(0, 1);
+				if (down)
+					add(0, -1);
+			}
+			else
+			{
+				const bool ahead = Walkable(x, y + dy);
+				const bool right = Walkable(x + 1, y);
+				const bool left = Walkable(x - 1, y);
+				if (ahead)
+				{
+					add(0, dy);
+					if (right)
+						add(1, dy);
+					if (left)
+						add(-1, dy);
+				}
+				if (right)
+					add(1, 0);
+				if (left)
+					add(-1, 0);
+			}
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			int32_t jx, jy;
+			const bool found = (dirs[i][0] != 0 && dirs[i][1] != 0)
+								   ? JumpDiagonal(x, y, dirs[i][0], dirs[i][1], jx, jy)
+								   : JumpStraight(x, y, dirs[i][0], dirs[i][1], jx, jy);
+			if (found)
+				Relax(index, jx, jy);
+		}
+	}
+
+	void PathFinder::Relax(uint32_t from, int32_t x, int32_t y)
+	{
+		const uint32_t index = ToIndex(x, y);
+		Node& node = m_Nodes[index];
+		if (node.generation != m_Generation)
+		{
+			node.generation = m_Generation;
+			node.g = std::numeric_limits<float>::infinity();
+			node.closed = false;
+		}
+		if (node.closed)
+			return;
+
+		const float g = m_Nodes[from].g + Octile(x - IndexX(from), y - IndexY(from));
+		if (g < node.g)
+		{
+			node.g = g;
+			node.parent = from;
+			m_Open.push_back({g + Heuristic(x, y), g, index});
+			std::push_heap(m_Open.begin(), m_Open.end(),
+						   [](const OpenEntry& a, const OpenEntry& b) { return OpenGreater(a.f, a.g, b.f, b.g); });
+		}
+	}
+
+	bool PathFinder::JumpStraight(int32_t x, int32_t y, int32_t dx, int32_t dy, int32_t& outX, int32_t& outY)
+	{
+		const NavGrid::LineScan scan = dx != 0 ? m_Grid->ScanX(x, y, dx) : m_Grid->ScanY(x, y, dy);
+		m_ExpandSteps += scan.words;
+
+		// The goal is a jump point wherever the line passes it
+		const int32_t toGoal = dx != 0 ? (y == m_GoalY ? (m_GoalX - x) * dx : 0) : (x == m_GoalX ? (m_GoalY - y) * dy : 0);
+		if (toGoal > 0 && toGoal <= scan.distance)
+		{
+			outX = m_GoalX;
+			outY = m_GoalY;
+			return true;
+		}
+		if (scan.blocked)
+			return false;
+
+		outX = x + dx * scan.distance;
+		outY = y + dy * scan.distance;
+		return true;
+	}
+
+	bool PathFinder::JumpDiagonal(int32_t x, int32_t y, int32_t dx, int32_t dy, int32_t& outX, int32_t& outY)
+	{
+		while (true)
+		{
+			x += dx;
+			y += dy;
+			m_ExpandSteps++;
+			if (!Walkable(x, y))
+				return false;
+
+			int32_t sx, sy;
+			if ((x == m_GoalX && y == m_GoalY) || JumpStraight(x, y, dx, 0, sx, sy) || JumpStraight(x, y, 0, dy, sx, sy))
+			{
+				outX = x;
+				outY = y;
+				return true;
+			}
+
+			// No corner cutting into the next diagonal cell
+			if (!Walkable(x + dx, y) || !Walkable(x, y + dy))
+				return false;
+		}
+	}
+
+	void PathFinder::BuildPath(CachedPath& out) const
+	{
+		std::vector<Vec2> points;
+		for (uint32_t index = m_SearchGoal;; index = m_Nodes[index].parent)
+		{
+			points.push_back(NavGrid::CellCenter(IndexX(index), IndexY(index)));
+			if (index == m_SearchStart)
+				break;
+		}
+		std::reverse(points.begin(), points.end());
+
+		// String pulling: from each kept point, skip ahead while the next
+		// jump point is still in a straight walkable line
+		out.waypoints.clear();
+		size_t anchor = 0;
+		while (anchor + 1 < points.size())
+		{
+			size_t next = anchor + 1;
+			while (next + 1 < points.size() && m_Grid->IsLineWalkable(points[anchor], points[next + 1]))
+			{
+				next++;
+			}
+			out.waypoints.push_back(points[next]);
+			anchor = next;
+		}
+	}
+
+	// ============================================================
+	// PATH FOLLOWER
+	// ============================================================
+
+	Vec2 PathFollower::Steer(PathFinder& finder, Vec2 position, Vec2 goal)
+	{
+		const NavGrid& grid = finder.GetGrid();
+
+		// Open ground: no plan needed
+		if (grid.IsLineWalkable(position, goal))
+		{
+			if (planned)
+				Reset(finder);
+			return (goal - position).Normalized();
+		}
+
+		auto collect = [&] {
+			const PathStatus result = finder.Poll(request, path);
+			if (result != PathStatus::PENDING)
+			{
+				status = result;
+				request = INVALID_PATH_REQUEST;
+				next = 0;
+			}
+		};
+
+		if (request != INVALID_PATH_REQUEST)
+			collect();
+
+		bool drifted = !planned || Vec2::DistanceSquared(plannedGoal, goal) > REPATH_DISTANCE * REPATH_DISTANCE;
+		// An unreachable goal is retried once it changes cell; the answer
+		// mostly comes from the region labels or the cache, not a search
+		if (status == PathStatus::NO_PATH &&
+			(NavGrid::ToCell(goal.x) != NavGrid::ToCell(plannedGoal.x) ||
+			 NavGrid::ToCell(goal.y) != NavGrid::ToCell(plannedGoal.y)))
+			drifted = true;
+		if (drifted && request == INVALID_PATH_REQUEST && status == PathStatus::FOUND && next < path.size())
+		{
+			// A goal moving about the end of the path only moves the last leg
+			const Vec2 lastCorner = path.size() - next >= 2 ? path[path.size() - 2] : position;
+			if (grid.IsLineWalkable(lastCorner, goal))
+			{
+				path.back() = goal;
+				plannedGoal = goal;
+				drifted = false;
+			}
+		}
+		auto replan = [&] {
+			request = finder.Request(position, goal);
+			plannedGoal = goal;
+			planned = true;
+			collect(); // Cache hits are ready at once
+		};
+		const bool exhausted = status == PathStatus::FOUND && next >= path.size();
+		if (request == INVALID_PATH_REQUEST && (drifted || exhausted))
+			replan();
+
+		if (status != PathStatus::FOUND)
+			return Vec2(0.0f, 0.0f);
+
+		while (next < path.size() &&
+			   Vec2::DistanceSquared(position, path[next]) <= WAYPOINT_RADIUS * WAYPOINT_RADIUS)
+		{
+			next++;
+		}
+		// Cut the corner once the waypoint after next is in a walkable line
+		if (next + 1 < path.size() && grid.IsLineWalkable(position, path[next + 1]))
+			next++;
+
+		if (next >= path.size())
+			return Vec2(0.0f, 0.0f);
+
+		// Paths run between cell centers. Off those legs (planned from where
+		// the mover stood a few ticks ago, or pushed aside) head back to this
+		// cell's center first, or plan again from here if that does not help.
+		if (!grid.IsLineWalkable(position, path[next]))
+		{
+			const Vec2 center = NavGrid::CellCenter(NavGrid::ToCell(position.x), NavGrid::ToCell(position.y));
+			if (grid.IsLineWalkable(center, path[next]))
+				return (center - position).Normalized();
+			if (request == INVALID_PATH_REQUEST)
+				replan();
+			return Vec2(0.0f, 0.0f);
+		}
+		return (path[next] - position).Normalized();
+	}
+
+	void PathFollower::Reset(PathFinder& finder)
+	{
+		if (request != INVALID_PATH_REQUEST)
+			finder.Cancel(request);
+		request = INVALID_PATH_REQUEST;
+		path.clear();
+		next = 0;
+		status = PathStatus::NO_PATH;
+		planned = false;
+	}
+
+} // namespace MMO
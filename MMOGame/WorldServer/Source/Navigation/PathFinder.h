@@ -0,0 +1,190 @@
+#pragma once
+
+#include "NavGrid.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace MMO {
+
+	using PathRequestId = uint32_t;
+	constexpr PathRequestId INVALID_PATH_REQUEST = 0;
+
+	enum class PathStatus : uint8_t
+	{
+		PENDING,
+		FOUND,
+		NO_PATH,
+	};
+
+	struct PathFinderStats
+	{
+		uint64_t requests = 0;
+		uint64_t cacheHits = 0;
+		uint64_t unreachable = 0; // Rejected by region label, no search
+		uint64_t searches = 0;
+		uint64_t scanSteps = 0; // Search work, the unit of the tick budget
+	};
+
+	// ============================================================
+	// PATH FINDER
+	// ============================================================
+	//
+	// Jump Point Search over a NavGrid, one per map instance. Paths come back
+	// string-pulled: waypoints in ground coordinates, straight walkable legs
+	// between them, the first leg starting at the requester's position and
+	// the last one ending at the goal.
+	//
+	// Results are cached by (start cell, goal cell), failures included, so a
+	// crowd chasing one player mostly reuses searches. Queued requests run in
+	// Update() under a per-tick budget of scan steps (one per expanded node,
+	// per diagonal step and per 64-cell word of a straight jump); a search
+	// that runs out of budget resumes on the next Update.
+
+	class PathFinder
+	{
+	public:
+		explicit PathFinder(std::shared_ptr<const NavGrid> grid);
+
+		const NavGrid& GetGrid() const { return *m_Grid; }
+
+		// Searches right away, ignoring the budget
+		PathStatus FindPath(Vec2 from, Vec2 to, std::vector<Vec2>& outPath);
+
+		// Queues a search. Cache hits and unreachable goals resolve at once,
+		// so Poll() may return a result immediately.
+		PathRequestId Request(Vec2 from, Vec2 to);
+		// PENDING until the search finishes; a finished result is handed out
+		// once and forgotten
+		PathStatus Poll(PathRequestId id, std::vector<Vec2>& outPath);
+		void Cancel(PathRequestId id);
+
+		// Runs queued searches until about `stepBudget` scan steps are spent
+		void Update(uint32_t stepBudget);
+
+		size_t GetPendingCount() const { return m_Queue.size(); }
+		const PathFinderStats& GetStats() const { return m_Stats; }
+
+		// Scan steps a map instance lets Update() spend per tick
+		static constexpr uint32_t TICK_STEP_BUDGET = 200'000;
+		// Most cached (start, goal) pairs; the oldest go first
+		static constexpr size_t CACHE_CAPACITY = 4096;
+		// A search taking more scan steps than this gives up (NO_PATH)
+		static constexpr uint32_t MAX_SEARCH_STEPS = 4'000'000;
+		// How far an end standing on an unwalkable cell is moved to find one
+		static constexpr int32_t SNAP_RADIUS = 3;
+
+	private:
+		struct Node
+		{
+			float g = 0.0f;
+			uint32_t parent = 0;
+			uint32_t generation = 0; // g/parent are valid when equal to m_Generation
+			bool closed = false;
+		};
+
+		struct OpenEntry
+		{
+			float f;
+			float g;
+			uint32_t index;
+		};
+
+		struct CachedPath
+		{
+			PathStatus status = PathStatus::NO_PATH;
+			std::vector<Vec2> waypoints; // Cell centers, start excluded
+		};
+
+		struct QueuedRequest
+		{
+			PathRequestId id;
+			Vec2 to;
+			uint64_t key;
+			uint32_t start;
+			uint32_t goal;
+		};
+
+		// Snaps both ends to walkable cells and fills the cache key. False
+		// when either end has no walkable cell nearby or the regions differ.
+		bool Prepare(Vec2 from, Vec2 to, uint64_t& key, uint32_t& start, uint32_t& goal) const;
+
+		// Cached waypoints adapted to the exact endpoints
+		void Finish(const CachedPath& cached, Vec2 to, uint32_t start, uint32_t goal,
+					std::vector<Vec2>& outPath) const;
+		void Store(uint64_t key, CachedPath path);
+
+		// Incremental search state: Begin, then Step until it returns true
+		void BeginSearch(uint32_t start, uint32_t goal);
+		bool StepSearch(uint32_t& budget, CachedPath& out);
+		void Expand(uint32_t index);
+		void Relax(uint32_t from, int32_t x, int32_t y);
+		bool JumpStraight(int32_t x, int32_t y, int32_t dx, int32_t dy, int32_t& outX, int32_t& outY);
+		bool JumpDiagonal(int32_t x, int32_t y, int32_t dx, int32_t dy, int32_t& outX, int32_t& outY);
+		void BuildPath(CachedPath& out) const;
+
+		bool Walkable(int32_t x, int32_t y) const { return m_Grid->IsWalkable(x, y); }
+		uint32_t ToIndex(int32_t x, int32_t y) const
+		{
+			return static_cast<uint32_t>(y - m_Grid->GetMinCellY()) * m_Grid->GetWidth() +
+				   static_cast<uint32_t>(x - m_Grid->GetMinCellX());
+		}
+		int32_t IndexX(uint32_t index) const { return m_Grid->GetMinCellX() + static_cast<int32_t>(index % m_Grid->GetWidth()); }
+		int32_t IndexY(uint32_t index) const { return m_Grid->GetMinCellY() + static_cast<int32_t>(index / m_Grid->GetWidth()); }
+		float Heuristic(int32_t x, int32_t y) const;
+
+		std::shared_ptr<const NavGrid> m_Grid;
+
+		// Search scratch, sized to the grid on first use
+		std::vector<Node> m_Nodes;
+		std::vector<OpenEntry> m_Open;
+		uint32_t m_Generation = 0;
+		uint32_t m_SearchStart = 0;
+		uint32_t m_SearchGoal = 0;
+		int32_t m_GoalX = 0;
+		int32_t m_GoalY = 0;
+		uint32_t m_SearchSteps = 0;
+		uint32_t m_ExpandSteps = 0;
+
+		std::unordered_map<uint64_t, CachedPath> m_Cache;
+		std::deque<uint64_t> m_CacheOrder;
+
+		std::deque<QueuedRequest> m_Queue;
+		bool m_SearchActive = false; // Front of m_Queue is mid-search
+		// Every live request, PENDING until its search finishes; Cancel erases
+		std::unordered_map<PathRequestId, std::pair<PathStatus, std::vector<Vec2>>> m_Results;
+		PathRequestId m_NextId = 1;
+
+		PathFinderStats m_Stats;
+	};
+
+	// ============================================================
+	// PATH FOLLOWER
+	// ============================================================
+	//
+	// One mover's path state. Steer() once per tick returns the direction to
+	// walk: straight at the goal when the line is walkable, otherwise along a
+	// planned path. When the goal drifts REPATH_DISTANCE from the one planned
+	// for, the last leg is bent to it if that stays walkable, else a new path
+	// is requested and the old one followed while it is searched. Zero before
+	// the first path arrives and when the goal is unreachable.
+
+	struct PathFollower
+	{
+		std::vector<Vec2> path;
+		size_t next = 0;
+		Vec2 plannedGoal;
+		PathRequestId request = INVALID_PATH_REQUEST;
+		PathStatus status = PathStatus::NO_PATH;
+		bool planned = false;
+
+		static constexpr float REPATH_DISTANCE = 2.0f;
+		static constexpr float WAYPOINT_RADIUS = 0.5f;
+
+		Vec2 Steer(PathFinder& finder, Vec2 position, Vec2 goal);
+		void Reset(PathFinder& finder);
+	};
+
+} // namespace MMO
@@ -0,0 +1,174 @@
+#include "TickProfiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace MMO {
+
+	const char* TickPhaseName(TickPhase phase)
+	{
+		switch (phase)
+		{
+		case TickPhase::GRID_ACTIVATION:
+			return "grid_activation";
+		case TickPhase::ENTITY_UPDATE:
+			return "entity_update";
+		case TickPhase::AI:
+			return "ai";
+		case TickPhase::PATHFINDING:
+			return "pathfinding";
+		case TickPhase::GRID_MOVES:
+			return "grid_moves";
+		case TickPhase::CASTS:
+			return "casts";
+		case TickPhase::PROJECTILES:
+			return "projectiles";
+		case TickPhase::RESPAWNS:
+			return "respawns";
+		case TickPhase::LOOT:
+			return "loot";
+		case TickPhase::REGEN:
+			return "regen";
+		case TickPhase::AURAS:
+			return "auras";
+		case TickPhase::SEND_WORLD_STATE:
+			return "send_world_state";
+		case TickPhase::SEND_EVENTS:
+			return "send_events";
+		case TickPhase::SEND_AURAS:
+			return "send_auras";
+		case TickPhase::SEND_SPAWNS:
+			return "send_spawns";
+		case TickPhase::MAP_TOTAL:
+			return "map";
+		case TickPhase::NETWORK:
+			return "network";
+		case TickPhase::DB_COMPLETIONS:
+			return "db_completions";
+		case TickPhase::MAPS:
+			return "maps";
+		case TickPhase::DEFERRED:
+			return "deferred";
+		case TickPhase::FLUSH:
+			return "flush";
+		case TickPhase::TICK_TOTAL:
+			return "tick";
+		case TickPhase::COUNT:
+			break;
+		}
+		return "?";
+	}
+
+	// ============================================================
+	// PHASE TIMELINE
+	// ============================================================
+
+	void PhaseTimeline::Record(TickPhase phase, Clock::time_point start, Clock::time_point end)
+	{
+		const size_t index = static_cast<size_t>(phase);
+		const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+		m_CurrentMs[index] += static_cast<float>(duration.count()) / 1000.0f;
+		m_Touched |= 1u << index;
+
+		if (TickProfiler::IsTracing())
+		{
+			const auto offset = std::chrono::duration_cast<std::chrono::microseconds>(start - TickProfiler::GetTraceOrigin());
+			m_Trace.push_back({phase, offset.count(), duration.count()});
+		}
+	}
+
+	void PhaseTimeline::EndTick()
+	{
+		if (m_Touched == 0)
+			return;
+
+		for (size_t i = 0; i < m_Rings.size(); i++)
+		{
+			if (!(m_Touched & (1u << i)))
+				continue;
+
+			Ring& ring = m_Rings[i];
+			ring.samplesMs[ring.next] = m_CurrentMs[i];
+			ring.next = (ring.next + 1) % WINDOW;
+			ring.count = std::min(ring.count + 1, WINDOW);
+			m_CurrentMs[i] = 0.0f;
+		}
+		m_Touched = 0;
+	}
+
+	PhaseSummary PhaseTimeline::Summarize(TickPhase phase, float budgetMs) const
+	{
+		const Ring& ring = m_Rings[static_cast<size_t>(phase)];
+		PhaseSummary summary;
+		summary.samples = ring.count;
+		if (ring.count == 0)
+			return summary;
+
+		std::array<float, WINDOW> sorted;
+		std::copy(ring.samplesMs.begin(), ring.samplesMs.begin() + ring.count, sorted.begin());
+		std::sort(sorted.begin(), sorted.begin() + ring.count);
+
+		summary.p50Ms = sorted[ring.count / 2];
+		summary.p99Ms = sorted[std::min(ring.count - 1, ring.count * 99 / 100)];
+		summary.maxMs = sorted[ring.count - 1];
+		if (budgetMs > 0.0f)
+		{
+			summary.overBudget = static_cast<uint32_t>(
+				sorted.begin() + ring.count - std::upper_bound(sorted.begin(), sorted.begin() + ring.count, budgetMs));
+		}
+		return summary;
+	}
+
+	// ============================================================
+	// TICK PROFILER
+	// ============================================================
+
+	void TickProfiler::BeginTrace()
+	{
+		s_TraceOrigin = PhaseTimeline::Clock::now();
+		s_Tracing.store(true, std::memory_order_relaxed);
+	}
+
+	bool TickProfiler::WriteChromeTrace(const std::string& path, const std::vector<NamedTimeline>& timelines)
+	{
+		std::ofstream out(path);
+		if (!out)
+		{
+			std::cerr << "[Profiler] Cannot write " << path << '\n';
+			return false;
+		}
+
+		// Trace Event Format: one "X" (complete) event per recorded phase and a
+		// thread_name metadata event per timeline
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool first = true;
+		size_t eventCount = 0;
+		for (const NamedTimeline& named : timelines)
+		{
+			const uint32_t tid = named.timeline->GetTraceThread();
+			std::string name;
+			for (char c : named.name)
+			{
+				if (c == '"' || c == '\\')
+					name += '\\';
+				name += c;
+			}
+			out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+				<< ",\"args\":{\"name\":\"" << name << "\"}}";
+			first = false;
+
+			for (const PhaseTimeline::TraceEvent& event : named.timeline->GetTrace())
+			{
+				out << ",\n{\"name\":\"" << TickPhaseName(event.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+					<< ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+			}
+			eventCount += named.timeline->GetTrace().size();
+			named.timeline->ClearTrace();
+		}
+		out << "\n]}\n";
+
+		std::cout << "[Profiler] Wrote " << eventCount << " trace events to " << path << '\n';
+		return true;
+	}
+
+} // namespace MMO
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MMO {
+
+	// ============================================================
+	// TICK PHASES
+	// ============================================================
+
+	enum class TickPhase : uint8_t
+	{
+		// Per map: MapInstance::Update
+		GRID_ACTIVATION,
+		ENTITY_UPDATE,
+		AI,
+		PATHFINDING,
+		GRID_MOVES,
+		CASTS,
+		PROJECTILES,
+		RESPAWNS,
+		LOOT,
+		REGEN,
+		AURAS,
+		// Per map: WorldServer::SendMapUpdates
+		SEND_WORLD_STATE,
+		SEND_EVENTS,
+		SEND_AURAS,
+		SEND_SPAWNS,
+		MAP_TOTAL, // Whole map job (update + sends)
+
+		// Main loop
+		NETWORK, // Handling polled events (not Poll and its wait), summed over the loop iterations of one tick
+		DB_COMPLETIONS,
+		MAPS, // Wall time of MapManager::Update (all maps)
+		DEFERRED,
+		FLUSH,
+		TICK_TOTAL,
+
+		COUNT
+	};
+
+	const char* TickPhaseName(TickPhase phase);
+
+	// ============================================================
+	// PHASE TIMELINE
+	// ============================================================
+	//
+	// Rolling per-phase timings for one thread of execution: a map instance
+	// (whose job runs on one MapUpdater worker per tick) or the main loop.
+	// Not thread-safe; read it only at the sync point between ticks.
+
+	struct PhaseSummary
+	{
+		float p50Ms = 0.0f;
+		float p99Ms = 0.0f;
+		float maxMs = 0.0f;
+		uint32_t samples = 0;
+		uint32_t overBudget = 0; // Samples above the budget passed to Summarize
+	};
+
+	class PhaseTimeline
+	{
+	public:
+		static constexpr uint32_t WINDOW = 256; // Ticks kept per phase (~13 s at 20 Hz)
+
+		using Clock = std::chrono::steady_clock;
+
+		struct TraceEvent
+		{
+			TickPhase phase;
+			int64_t startUs; // Relative to the trace origin
+			int64_t durationUs;
+		};
+
+		// traceThread is the "tid" of this timeline in Chrome traces
+		explicit PhaseTimeline(uint32_t traceThread) : m_TraceThread(traceThread) {}
+
+		// Adds to this tick's total for `phase`
+		void Record(TickPhase phase, Clock::time_point start, Clock::time_point end);
+		// Pushes this tick's totals into the rolling window
+		void EndTick();
+
+		PhaseSummary Summarize(TickPhase phase, float budgetMs = 0.0f) const;
+
+		uint32_t GetTraceThread() const { return m_TraceThread; }
+		const std::vector<TraceEvent>& GetTrace() const { return m_Trace; }
+		void ClearTrace() { m_Trace.clear(); }
+
+	private:
+		struct Ring
+		{
+			std::array<float, WINDOW> samplesMs{};
+			uint32_t next = 0;
+			uint32_t count = 0;
+		};
+
+		std::array<Ring, static_cast<size_t>(TickPhase::COUNT)> m_Rings;
+		std::array<float, static_cast<size_t>(TickPhase::COUNT)> m_CurrentMs{};
+		uint32_t m_Touched = 0; // Bit per phase recorded this tick
+
+		uint32_t m_TraceThread;
+		std::vector<TraceEvent> m_Trace;
+
+		static_assert(static_cast<size_t>(TickPhase::COUNT) <= 32, "m_Touched is a 32-bit mask");
+	};
+
+	// ============================================================
+	// TICK PROFILER
+	// ============================================================
+	//
+	// Global switches. Disabled, a PhaseScope costs one relaxed atomic load
+	// and never reads the clock.
+
+	class TickProfiler
+	{
+	public:
+		static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+		static void SetEnabled(bool enabled) { s_Enabled.store(enabled, std::memory_order_relaxed); }
+
+		// Trace capture: phases also append Chrome trace events while active.
+		// Start/stop only at the sync point between ticks.
+		static bool IsTracing() { return s_Tracing.load(std::memory_order_relaxed); }
+		static void BeginTrace();
+		static void EndTrace() { s_Tracing.store(false, std::memory_order_relaxed); }
+		static PhaseTimeline::Clock::time_point GetTraceOrigin() { return s_TraceOrigin; }
+
+		struct NamedTimeline
+		{
+			std::string name;
+			PhaseTimeline* timeline;
+		};
+
+		// Writes every timeline's captured events as Chrome trace JSON
+		// (chrome://tracing, ui.perfetto.dev) and clears them
+		static bool WriteChromeTrace(const std::string& path, const std::vector<NamedTimeline>& timelines);
+
+	private:
+		static inline std::atomic<bool> s_Enabled{false};
+		static inline std::atomic<bool> s_Tracing{false};
+		static inline PhaseTimeline::Clock::time_point s_TraceOrigin{};
+	};
+
+	// ============================================================
+	// PHASE SCOPE
+	// ============================================================
+
+	class PhaseScope
+	{
+	public:
+		PhaseScope(PhaseTimeline& timeline, TickPhase phase)
+			: m_Timeline(TickProfiler::IsEnabled() ? &timeline : nullptr), m_Phase(phase)
+		{
+			if (m_Timeline)
+				m_Start = PhaseTimeline::Clock::now();
+		}
+
+		~PhaseScope()
+		{
+			if (m_Timeline)
+				m_Timeline->Record(m_Phase, m_Start, PhaseTimeline::Clock::now());
+		}
+
+		PhaseScope(const PhaseScope&) = delete;
+		PhaseScope& operator=(const PhaseScope&) = delete;
+
+	private:
+		PhaseTimeline* m_Timeline;
+		TickPhase m_Phase;
+		PhaseTimeline::Clock::time_point m_Start;
+	};
+
+} // namespace MMO
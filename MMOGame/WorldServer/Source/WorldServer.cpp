@@ -12,14 +12,17 @@
 #include "../../Shared/Source/Data/GameDataStore.h"
 #include "../../Shared/Source/Database/MigrationRunner.h"
 #endif
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <thread>
 
 namespace MMO {
 
 	WorldServer::WorldServer()
-		: m_Running(false), m_ServerTick(0)
+		: m_QueuedMessages(0), m_DeltaEntries(0), m_DeltaBytes(0), m_DeltaLegacyBytes(0), m_StatsTicks(0), m_AutosaveTicks(0), m_TickProfile(0), m_TraceRequested(false), m_TraceTicksLeft(0), m_ProfilerEnabledBeforeTrace(false), m_Running(false), m_ServerTick(0)
 	{
+		m_Events.reserve(64);
 	}
 
 	WorldServer::~WorldServer()
@@ -27,7 +30,8 @@ namespace MMO {
 		Stop();
 	}
 
-	bool WorldServer::Initialize(uint16_t port, const std::string& dbConnectionString)
+	bool WorldServer::Initialize(uint16_t port, const std::string& dbConnectionString, size_t mapUpdateThreads,
+								 const std::string& dataDirectory)
 	{
 		if (!m_Network.Start(port))
 		{
@@ -46,6 +50,11 @@ namespace MMO {
 			std::cerr << "Failed to connect to database; aborting startup" << '\n';
 			return false;
 		}
+		if (!m_AsyncDb.Connect(dbConnectionString, DB_CONNECTIONS))
+		{
+			std::cerr << "Failed to open async database connections; aborting startup" << '\n';
+			return false;
+		}
 
 #ifdef HAS_DATABASE
 		// Apply schema migrations before reading any tables.
@@ -67,8 +76,10 @@ namespace MMO {
 		RegisterAllSpellScripts();
 		RegisterAllPlayerScripts();
 
-		// Initialize map manager with templates from DB.
-		MapManager::Instance().Initialize(m_Database);
+		// Initialize map manager with templates from DB and terrain from the
+		// exported data directory.
+		MapManager::Instance().Initialize(m_Database, dataDirectory);
+		MapManager::Instance().SetUpdateThreads(mapUpdateThreads);
 #else
 		std::cerr << "WorldServer must be built with HAS_DATABASE (libpqxx required)" << std::endl;
 		return false;
@@ -90,24 +101,27 @@ namespace MMO {
 			auto now = std::chrono::steady_clock::now();
 			float elapsed = std::chrono::duration<float>(now - m_LastTick).count();
 
-			// Poll network events
-			std::vector<NetworkEvent> events;
-			m_Network.Poll(events, 1);
+			// Poll network events (m_Events keeps its capacity between polls)
+			m_Network.Poll(m_Events, 1);
 
-			for (const auto& event : events)
 			{
-				switch (event.type)
+				PhaseScope phase(m_TickProfile, TickPhase::NETWORK);
+				for (const auto& event : m_Events)
 				{
-				case NetworkEventType::CONNECTED:
-					OnPlayerConnect(event.peerId);
-					break;
-				case NetworkEventType::DISCONNECTED:
-					OnPlayerDisconnect(event.peerId);
-					break;
-				case NetworkEventType::DATA_RECEIVED:
-					ProcessPacket(event.peerId, event.data);
-					break;
+					switch (event.type)
+					{
+					case NetworkEventType::CONNECTED:
+						OnPlayerConnect(event.peerId);
+						break;
+					case NetworkEventType::DISCONNECTED:
+						OnPlayerDisconnect(event.peerId);
+						break;
+					case NetworkEventType::DATA_RECEIVED:
+						ProcessPacket(event.peerId, event.data, event.size);
+						break;
+					}
 				}
+				ReleaseEvents(m_Events);
 			}
 
 			// Game tick
@@ -116,58 +130,104 @@ namespace MMO {
 				m_LastTick = now;
 				m_ServerTick++;
 
-				// Update all map instances
-				MapManager::Instance().Update(TICK_INTERVAL);
+				// No map is running here, so tracing can start safely
+				if (m_TraceRequested.exchange(false) && m_TraceTicksLeft == 0)
+				{
+					BeginTickTrace();
+				}
 
-				// Send world state and events for each map
-				for (auto& [instanceId, mapInstance] : MapManager::Instance().GetAllInstances())
 				{
-					// Send world state to all players in this map
-					SendWorldState(mapInstance.get());
+					PhaseScope tickPhase(m_TickProfile, TickPhase::TICK_TOTAL);
 
-					// Send game events
-					SendEvents(mapInstance.get());
-					mapInstance->ClearEvents();
+					// Finished DB work (character loads) lands here, before the maps
+					// tick, never from a DB worker
+					{
+						PhaseScope phase(m_TickProfile, TickPhase::DB_COMPLETIONS);
+						m_AsyncDb.ProcessCompletions();
+					}
 
-					// Send aura updates (to nearby players only)
-					SendAuraUpdates(mapInstance.get());
+					// Update all map instances and serialize their state; each map
+					// runs on a MapUpdater worker when the pool is active
+					{
+						PhaseScope phase(m_TickProfile, TickPhase::MAPS);
+						MapManager::Instance().Update(TICK_INTERVAL, [this](MapInstance* map) {
+							SendMapUpdates(map);
+						});
+					}
 
-					// Send spawn/despawn notifications
-					SendSpawnsAndDespawns(mapInstance.get());
+					// Sync point: cross-instance work queued during the tick
+					{
+						PhaseScope phase(m_TickProfile, TickPhase::DEFERRED);
+						MapManager::Instance().ProcessDeferred();
+					}
 
-					// Clear dirty flags after all updates sent (AzerothCore-style)
-					mapInstance->GetGrid().ClearAllDirtyFlags();
-				}
+					// One batched packet per peer for everything queued this tick
+					{
+						PhaseScope phase(m_TickProfile, TickPhase::FLUSH);
+						FlushOutbound();
+					}
 
-				// Cleanup expired auth tokens
-				auto currentTime = std::chrono::steady_clock::now();
-				for (auto it = m_PendingAuths.begin(); it != m_PendingAuths.end();)
-				{
-					if (currentTime > it->second.expiresAt)
+					// Snapshots are cheap; the writes happen on the DB workers
+					if (++m_AutosaveTicks >= AUTOSAVE_INTERVAL)
+					{
+						m_AutosaveTicks = 0;
+						SaveAllPlayers();
+					}
+
+					// Cleanup expired auth tokens
+					auto currentTime = std::chrono::steady_clock::now();
+					for (auto it = m_PendingAuths.begin(); it != m_PendingAuths.end();)
 					{
-						it = m_PendingAuths.erase(it);
+						if (currentTime > it->second.expiresAt)
+						{
+							it = m_PendingAuths.erase(it);
+						}
+						else
+						{
+							++it;
+						}
 					}
-					else
+				}
+				m_TickProfile.EndTick();
+
+				if (m_TraceTicksLeft > 0 && --m_TraceTicksLeft == 0)
+				{
+					WriteTickTrace();
+				}
+
+				if (++m_StatsTicks >= NET_STATS_LOG_INTERVAL)
+				{
+					if (TickProfiler::IsEnabled())
 					{
-						++it;
+						LogTickStats();
 					}
+					LogNetworkStats();
 				}
 			}
 
 			// Small sleep to avoid busy waiting
 			std::this_thread::sleep_for(std::chrono::milliseconds(1));
 		}
+
+		Shutdown();
 	}
 
 	void WorldServer::Stop()
 	{
-		// Save all connected players before shutdown
-		for (const auto& [peerId, player] : m_ConnectedPlayers)
-		{
-			SavePlayer(player);
-		}
-
+		// Called from the signal handler; Run() does the actual shutdown once
+		// the current loop iteration finishes
 		m_Running = false;
+	}
+
+	void WorldServer::Shutdown()
+	{
+		// Save all connected players, then block until every queued write is done
+		SaveAllPlayers();
+		m_ConnectedPlayers.clear();
+		m_PendingLogins.clear();
+		m_AsyncDb.Shutdown();
+		Database::PrintStatementStats(m_AsyncDb.GetStatementStats());
+
 		m_Network.Stop();
 	}
 
@@ -194,6 +254,9 @@ namespace MMO {
 	{
 		std::cout << "Client disconnected: " << peerId << '\n';
 
+		// A load still in flight finds the peer gone and is dropped
+		m_PendingLogins.erase(peerId);
+
 		auto it = m_ConnectedPlayers.find(peerId);
 		if (it == m_ConnectedPlayers.end())
 			return;
@@ -207,24 +270,14 @@ namespace MMO {
 		MapInstance* map = MapManager::Instance().GetInstanceById(player.mapInstanceId);
 		if (map)
 		{
-			// Remove entity from map
+			// Remove entity from map (the grid queues despawns for everyone
+			// who could see it; they go out with next tick's visibility deltas)
 			map->UnregisterPlayer(player.entityId);
-
-			// Notify other players in this map
-			WriteBuffer despawnPacket;
-			despawnPacket.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_DESPAWN));
-			S_EntityDespawn despawn;
-			despawn.id = player.entityId;
-			despawn.Serialize(despawnPacket);
-
-			for (const auto& [entityId, info] : map->GetAllPlayers())
-			{
-				m_Network.Send(info.peerId, despawnPacket);
-			}
 		}
 
 		// Clear known entities tracking for this player
 		m_PlayerKnownEntities.erase(peerId);
+		m_Outbound.erase(peerId);
 
 		m_ConnectedPlayers.erase(it);
 	}
@@ -233,12 +286,12 @@ namespace MMO {
 	// PACKET PROCESSING
 	// ============================================================
 
-	void WorldServer::ProcessPacket(uint32_t peerId, const std::vector<uint8_t>& data)
+	void WorldServer::ProcessPacket(uint32_t peerId, const uint8_t* data, size_t size)
 	{
-		if (data.empty())
+		if (size == 0)
 			return;
 
-		ReadBuffer buf(data);
+		ReadBuffer buf(data, size);
 		auto packetType = static_cast<WorldPacketType>(buf.ReadU8());
 
 		// Auth check for non-auth packets
@@ -298,8 +351,27 @@ namespace MMO {
 
 		std::cout << "Auth token received from peer " << peerId << '\n';
 
-		// Load character data from database
-		CharacterData charData = LoadCharacter(request.characterId);
+		// Ignore repeats while the first load is in flight or after entering the world
+		if (m_PendingLogins.count(peerId) || m_ConnectedPlayers.count(peerId))
+			return;
+		m_PendingLogins.insert(peerId);
+
+		// Load the character off the game thread; the rest of the login runs
+		// from ProcessCompletions at the start of a tick
+		CharacterId characterId = request.characterId;
+		m_AsyncDb.Query(
+			characterId,
+			[characterId](Database& db) { return LoadCharacter(db, characterId); },
+			[this, peerId, characterId](CharacterLoadResult loaded) { CompleteAuth(peerId, characterId, loaded); });
+	}
+
+	void WorldServer::CompleteAuth(uint32_t peerId, CharacterId characterId, const CharacterLoadResult& loaded)
+	{
+		// Peer disconnected while the load was in flight
+		if (!m_PendingLogins.erase(peerId))
+			return;
+
+		const CharacterData& charData = loaded.character;
 
 		// Get the map instance for this character
 		uint32_t mapTemplateId = charData.mapId;
@@ -321,7 +393,7 @@ namespace MMO {
 
 		// Create player entity in the map
 		Entity* player = map->CreatePlayer(
-			request.characterId,
+			characterId,
 			charData.name,
 			charData.characterClass,
 			charData.level,
@@ -338,28 +410,24 @@ namespace MMO {
 		}
 
 		// Register player with map
-		map->RegisterPlayer(player->GetId(), peerId, request.characterId, charData.accountId);
+		map->RegisterPlayer(player->GetId(), peerId, characterId, charData.accountId);
 
 		// Track connected player
 		ConnectedPlayer connPlayer;
 		connPlayer.peerId = peerId;
-		connPlayer.characterId = request.characterId;
+		connPlayer.characterId = characterId;
 		connPlayer.accountId = charData.accountId;
 		connPlayer.mapInstanceId = map->GetInstanceId();
 		connPlayer.entityId = player->GetId();
 		m_ConnectedPlayers[peerId] = connPlayer;
+		m_Outbound[peerId];
 
-		// Load and apply cooldowns
-		if (m_Database.IsConnected())
+		// Apply cooldowns
+		if (auto combat = player->GetCombat())
 		{
-			auto cooldowns = m_Database.GetCooldowns(request.characterId);
-			auto combat = player->GetCombat();
-			if (combat)
+			for (const auto& cd : loaded.cooldowns)
 			{
-				for (const auto& cd : cooldowns)
-				{
-					combat->cooldowns[cd.abilityId] = cd.remaining;
-				}
+				combat->cooldowns[cd.abilityId] = cd.remaining;
 			}
 		}
 
@@ -374,9 +442,9 @@ namespace MMO {
 		player->AddEquipmentComponent();
 		player->AddStatsComponent();
 
-		// Load inventory and equipment from database
-		LoadPlayerInventory(player, request.characterId);
-		LoadPlayerEquipment(player, request.characterId);
+		// Apply inventory and equipment loaded from the database
+		LoadPlayerInventory(player, loaded.inventory);
+		LoadPlayerEquipment(player, loaded.equipment);
 
 		// Recalculate stats from equipped gear
 		player->RecalculateStatsFromGear();
@@ -410,44 +478,10 @@ namespace MMO {
 		SendEquipmentData(peerId, player);
 		SendCharacterStats(peerId, player);
 
-		// Send existing entities to new player and track them in known entities
-		std::unordered_set<EntityId>& knownEntities = m_PlayerKnownEntities[peerId];
-		knownEntities.clear(); // Start fresh
-		for (const auto& state : map->GetWorldStateForPlayer(player->GetId()))
-		{
-			Entity* entity = map->GetEntity(state.id);
-			if (entity && entity->GetId() != player->GetId())
-			{
-				SendEntitySpawn(peerId, entity);
-				knownEntities.insert(entity->GetId()); // Track as known
-			}
-		}
-
-		// Broadcast new player spawn to others in same map
-		WriteBuffer spawnPacket;
-		spawnPacket.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_SPAWN));
-		S_EntitySpawn spawn;
-		spawn.id = player->GetId();
-		spawn.type = EntityType::PLAYER;
-		spawn.name = player->GetName();
-		spawn.characterClass = player->GetClass();
-		spawn.position = player->GetMovement()->position;
-		spawn.height = player->GetMovement()->height;
-		spawn.rotation = player->GetMovement()->rotation;
-		spawn.health = player->GetHealth()->current;
-		spawn.maxHealth = player->GetHealth()->max;
-		spawn.level = player->GetLevel();
-		spawn.Serialize(spawnPacket);
-
-		for (const auto& [entityId, info] : map->GetAllPlayers())
-		{
-			m_Network.Send(info.peerId, spawnPacket);
-			// Track the new player in other players' known entities
-			if (info.peerId != peerId)
-			{
-				m_PlayerKnownEntities[info.peerId].insert(player->GetId());
-			}
-		}
+		// Start with an empty known set. Entering the grid queued a spawn for
+		// every entity in the player's view block, and this player for everyone
+		// watching its cell; both go out with the next tick's visibility deltas.
+		m_PlayerKnownEntities[peerId].clear();
 	}
 
 	void WorldServer::HandleInput(uint32_t peerId, ReadBuffer& buf)
@@ -547,8 +581,14 @@ namespace MMO {
 			return;
 		}
 
-		// Transfer the player
-		TransferPlayer(peerId, portal, map);
+		// Transfer at the next sync point, once no map is mid-tick
+		const uint32_t fromInstanceId = map->GetInstanceId();
+		MapManager::Instance().Defer([this, peerId, portal, fromInstanceId]() {
+			if (MapInstance* fromMap = MapManager::Instance().GetInstanceById(fromInstanceId))
+			{
+				TransferPlayer(peerId, portal, fromMap);
+			}
+		});
 	}
 
 	void WorldServer::TransferPlayer(uint32_t peerId, const Portal* portal, MapInstance* fromMap)
@@ -571,25 +611,11 @@ namespace MMO {
 			return;
 		}
 
-		// Notify players in old map about despawn
-		WriteBuffer despawnPacket;
-		despawnPacket.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_DESPAWN));
-		S_EntityDespawn despawn;
-		despawn.id = entityId;
-		despawn.Serialize(despawnPacket);
-
-		for (const auto& [id, info] : fromMap->GetAllPlayers())
-		{
-			if (info.peerId != peerId)
-			{
-				m_Network.Send(info.peerId, despawnPacket);
-			}
-		}
-
 		// === AzerothCore style: MOVE entity instead of recreate ===
 		// Release entity from old map (transfers ownership to us)
 		// Note: Don't call UnregisterPlayer here - it would delete the entity!
-		// ReleaseEntity will handle removing from m_Entities
+		// ReleaseEntity will handle removing from m_Entities, and the old map's
+		// grid queues the despawn for everyone who could see the player
 		std::unique_ptr<Entity> entity = fromMap->ReleaseEntity(entityId);
 		if (!entity)
 		{
@@ -625,43 +651,8 @@ namespace MMO {
 		// Send player stats (level, XP, health, mana) after map change
 		SendYourStats(peerId, playerEntity);
 
-		// Send entities in new map to player and track in known entities
-		std::unordered_set<EntityId>& knownEntities = m_PlayerKnownEntities[peerId];
-		for (const auto& state : destMap->GetWorldStateForPlayer(entityId))
-		{
-			Entity* ent = destMap->GetEntity(state.id);
-			if (ent && ent->GetId() != entityId)
-			{
-				SendEntitySpawn(peerId, ent);
-				knownEntities.insert(ent->GetId()); // Track as known
-			}
-		}
-
-		// Notify players in new map about spawn
-		WriteBuffer spawnPacket;
-		spawnPacket.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_SPAWN));
-		S_EntitySpawn spawn;
-		spawn.id = entityId;
-		spawn.type = EntityType::PLAYER;
-		spawn.name = playerEntity->GetName();
-		spawn.characterClass = playerEntity->GetClass();
-		spawn.position = playerEntity->GetMovement()->position;
-		spawn.height = playerEntity->GetMovement()->height;
-		spawn.rotation = playerEntity->GetMovement()->rotation;
-		spawn.health = playerEntity->GetHealth()->current;
-		spawn.maxHealth = playerEntity->GetHealth()->max;
-		spawn.level = playerEntity->GetLevel();
-		spawn.Serialize(spawnPacket);
-
-		for (const auto& [id, info] : destMap->GetAllPlayers())
-		{
-			m_Network.Send(info.peerId, spawnPacket);
-			// Track the transferred player in other players' known entities
-			if (info.peerId != peerId)
-			{
-				m_PlayerKnownEntities[info.peerId].insert(entityId);
-			}
-		}
+		// Spawns in both directions arrive with the new map's next visibility
+		// deltas (AdoptEntity put the player in the destination grid)
 
 		std::cout << "Player " << playerEntity->GetName() << " transferred to " << destMap->GetName()
 				  << " (EntityId " << entityId << " preserved)" << '\n';
@@ -673,7 +664,7 @@ namespace MMO {
 
 	void WorldServer::SavePlayer(const ConnectedPlayer& player)
 	{
-		if (!m_Database.IsConnected())
+		if (!m_AsyncDb.IsConnected())
 			return;
 
 		MapInstance* map = MapManager::Instance().GetInstanceById(player.mapInstanceId);
@@ -684,7 +675,8 @@ namespace MMO {
 		if (!entity)
 			return;
 
-		CharacterData data;
+		CharacterSaveData save;
+		CharacterData& data = save.character;
 		data.id = player.characterId;
 		data.accountId = player.accountId;
 		data.name = entity->GetName();
@@ -702,31 +694,40 @@ namespace MMO {
 		data.currentHealth = entity->GetHealth()->current;
 		data.currentMana = entity->GetMana() ? entity->GetMana()->current : 0;
 
-		m_Database.SaveCharacter(data);
-
-		// Save cooldowns
+		// Cooldowns
 		auto combat = entity->GetCombat();
 		if (combat)
 		{
-			std::vector<CooldownData> cooldowns;
+			save.hasCooldowns = true;
 			for (const auto& [abilityId, remaining] : combat->cooldowns)
 			{
 				if (remaining > 0.0f)
 				{
-					cooldowns.push_back({abilityId, remaining});
+					save.cooldowns.push_back({abilityId, remaining});
 				}
 			}
-			m_Database.SaveCooldowns(player.characterId, cooldowns);
 		}
 
-		// Save inventory and equipment
-		SavePlayerInventory(entity, player.characterId);
-		SavePlayerEquipment(entity, player.characterId);
+		// Inventory and equipment
+		CapturePlayerInventory(entity, save);
+		CapturePlayerEquipment(entity, save);
+
+		// Write-behind: replaces this character's save if one is still queued
+		m_AsyncDb.SaveCharacter(std::move(save));
+	}
+
+	void WorldServer::SaveAllPlayers()
+	{
+		for (const auto& [peerId, player] : m_ConnectedPlayers)
+		{
+			SavePlayer(player);
+		}
 	}
 
-	CharacterData WorldServer::LoadCharacter(CharacterId characterId)
+	CharacterLoadResult WorldServer::LoadCharacter(Database& db, CharacterId characterId)
 	{
-		CharacterData data;
+		CharacterLoadResult result;
+		CharacterData& data = result.character;
 		data.id = characterId;
 		data.accountId = 0;
 		data.name = "Player" + std::to_string(characterId);
@@ -751,16 +752,20 @@ namespace MMO {
 		data.currentHealth = data.maxHealth;
 		data.currentMana = data.maxMana;
 
-		if (m_Database.IsConnected())
+		if (db.IsConnected())
 		{
-			auto dbData = m_Database.GetCharacterById(characterId);
+			auto dbData = db.GetCharacterById(characterId);
 			if (dbData)
 			{
 				data = *dbData;
 			}
+
+			result.cooldowns = db.GetCooldowns(characterId);
+			result.inventory = db.GetInventory(characterId);
+			result.equipment = db.GetEquipment(characterId);
 		}
 
-		return data;
+		return result;
 	}
 
 	// ============================================================
@@ -773,6 +778,9 @@ namespace MMO {
 		if (!entity || !entity->GetMovement())
 			return;
 
+		// Anything queued for the old world must reach the client before S_ENTER_WORLD
+		FlushPeer(peerId);
+
 		WriteBuffer packet;
 		packet.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTER_WORLD));
 		S_EnterWorld enter;
@@ -788,6 +796,8 @@ namespace MMO {
 
 	void WorldServer::SendMapChange(uint32_t peerId, EntityId newEntityId, const std::string& mapName, Vec2 position, MapInstance* map)
 	{
+		FlushPeer(peerId);
+
 		WriteBuffer packet;
 		packet.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTER_WORLD));
 		Entity* entity = map->GetEntity(newEntityId);
@@ -829,6 +839,39 @@ namespace MMO {
 		m_Network.Send(peerId, packet);
 	}
 
+	void WorldServer::SendMapUpdates(MapInstance* map)
+	{
+		PhaseTimeline& profile = map->GetProfile();
+
+		// Send world state to all players in this map
+		{
+			PhaseScope phase(profile, TickPhase::SEND_WORLD_STATE);
+			SendWorldState(map);
+		}
+
+		// Send game events
+		{
+			PhaseScope phase(profile, TickPhase::SEND_EVENTS);
+			SendEvents(map);
+			map->ClearEvents();
+		}
+
+		// Send aura updates (to nearby players only)
+		{
+			PhaseScope phase(profile, TickPhase::SEND_AURAS);
+			SendAuraUpdates(map);
+		}
+
+		// Send spawn/despawn notifications
+		{
+			PhaseScope phase(profile, TickPhase::SEND_SPAWNS);
+			SendSpawnsAndDespawns(map);
+		}
+
+		// Clear dirty flags after all updates sent (AzerothCore-style)
+		map->GetGrid().ClearAllDirtyFlags();
+	}
+
 	void WorldServer::SendWorldState(MapInstance* map)
 	{
 		Grid& grid = map->GetGrid();
@@ -847,13 +890,19 @@ namespace MMO {
 			pos.lastInputSeq = info.lastInputSeq;
 			pos.position = player->GetMovement()->position;
 			pos.Serialize(posPacket);
-			m_Network.Send(info.peerId, posPacket);
+			QueuePacket(info.peerId, posPacket);
 
 			// Send player's own stats
 			SendYourStats(info.peerId, player);
 		}
 
-		// 2. Entity-centric updates: iterate ONLY dirty entities (AzerothCore-style O(d) optimization)
+		// 2. Entity-centric updates: iterate ONLY dirty entities (AzerothCore-style O(d) optimization),
+		// packed into one S_ENTITY_DELTAS packet per recipient
+		std::unordered_map<uint32_t, WriteBuffer> deltaPackets;
+		uint64_t deltaEntries = 0;
+		uint64_t deltaBytes = 0;
+		uint64_t legacyBytes = 0;
+
 		const auto& dirtyEntities = grid.GetDirtyEntities();
 		for (EntityId entityId : dirtyEntities)
 		{
@@ -886,7 +935,7 @@ namespace MMO {
 				updateMask |= UPDATE_MOVE_STATE;
 
 			// Build update packet
-			S_EntityUpdate update;
+			S_EntityUpdate update{};
 			update.id = entityId;
 			update.updateMask = updateMask;
 
@@ -920,29 +969,63 @@ namespace MMO {
 				update.castProgress = combat->castDuration > 0 ? (combat->castTimer / combat->castDuration) : 0.0f;
 			}
 
-			WriteBuffer updatePacket;
-			updatePacket.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_UPDATE));
-			update.Serialize(updatePacket);
-
-			// Send to all players who can see this entity
-			Vec2 entityPos = movement ? movement->position : Vec2(0, 0);
-			grid.ForEachPlayerNear(entityPos, [&, entityId](EntityId playerId) {
+			// Delta-encode against what each watcher was last sent
+			grid.ForEachWatcher(entityId, [&, entityId](EntityId playerId) {
 				// Don't send entity's own update via this path (they get S_PLAYER_POSITION)
 				if (playerId == entityId)
 					return;
 
 				const PlayerInfo* playerInfo = map->GetPlayerInfo(playerId);
-				if (playerInfo)
+				if (!playerInfo)
+					return;
+
+				// Only send if player knows about this entity (lookup only:
+				// other maps read this container concurrently)
+				auto knownIt = m_PlayerKnownEntities.find(playerInfo->peerId);
+				if (knownIt == m_PlayerKnownEntities.end())
+					return;
+				auto baselineIt = knownIt->second.find(entityId);
+				if (baselineIt == knownIt->second.end())
+					return;
+
+				auto [packetIt, created] = deltaPackets.try_emplace(playerInfo->peerId);
+				WriteBuffer& packet = packetIt->second;
+				if (created)
 				{
-					// Only send if player knows about this entity
-					auto& knownEntities = m_PlayerKnownEntities[playerInfo->peerId];
-					if (knownEntities.find(entityId) != knownEntities.end())
-					{
-						m_Network.Send(playerInfo->peerId, updatePacket);
-					}
+					packet.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_DELTAS));
+				}
+
+				size_t before = packet.Size();
+				if (EntityDelta::Encode(packet, update, baselineIt->second))
+				{
+					deltaEntries++;
+					deltaBytes += packet.Size() - before;
+					legacyBytes += 1 + PacketBatch::ENTRY_HEADER_SIZE + update.SerializedSize();
+				}
+
+				// Keep each delta packet inside one batch frame
+				if (packet.Size() >= PacketBatch::MAX_BATCH_SIZE - PacketBatch::HEADER_SIZE - PacketBatch::ENTRY_HEADER_SIZE - 64)
+				{
+					deltaBytes += 1 + PacketBatch::ENTRY_HEADER_SIZE;
+					QueuePacket(playerInfo->peerId, packet);
+					packet.Clear();
+					packet.WriteU8(static_cast<uint8_t>(WorldPacketType::S_ENTITY_DELTAS));
 				}
 			});
 		}
+
+		for (const auto& [peerId, packet] : deltaPackets)
+		{
+			if (packet.Size() > 1)
+			{
+				deltaBytes += 1 + PacketBatch::ENTRY_HEADER_SIZE;
+				QueuePacket(peerId, packet);
+			}
+		}
+
+		m_DeltaEntries.fetch_add(deltaEntries, std::memory_order_relaxed);
+		m_DeltaBytes.fetch_add(deltaBytes, std::memory_order_relaxed);
+		m_DeltaLegacyBytes.fetch_add(legacyBytes, std::memory_order_relaxed);
 	}
 
 	void WorldServer::SendEvents(MapInstance* map)
@@ -969,7 +1052,7 @@ namespace MMO {
 				const PlayerInfo* info = map->GetPlayerInfo(playerId);
 				if (info)
 				{
-					m_Network.Send(info->peerId, packet);
+					QueuePacket(info->peerId, packet);
 				}
 			});
 		}
@@ -999,30 +1082,32 @@ namespace MMO {
 			auraPacket.aura.casterId = update.aura.casterId;
 			auraPacket.Serialize(packet);
 
-			// Use grid to find nearby players (AzerothCore-style visitor pattern)
-			// Only visits cells within VIEW_DISTANCE, not all players on the map
+			// Send to the watchers that were sent the target's spawn (within
+			// VIEW_DISTANCE), not all players on the map
 			std::unordered_set<uint32_t> sentToPeers;
-			map->GetGrid().ForEachPlayerNear(update.targetPosition, [&](EntityId playerId) {
+			map->GetGrid().ForEachWatcher(update.targetId, [&](EntityId playerId) {
 				const PlayerInfo* playerInfo = map->GetPlayerInfo(playerId);
-				if (playerInfo)
-				{
-					m_Network.Send(playerInfo->peerId, packet);
-					sentToPeers.insert(playerInfo->peerId);
-				}
+				if (!playerInfo)
+					return;
+				auto knownIt = m_PlayerKnownEntities.find(playerInfo->peerId);
+				if (knownIt == m_PlayerKnownEntities.end() || knownIt->second.find(update.targetId) == knownIt->second.end())
+					return;
+				QueuePacket(playerInfo->peerId, packet);
+				sentToPeers.insert(playerInfo->peerId);
 			});
 
 			// Always send to target if they're a player (even if grid didn't include them)
 			const PlayerInfo* targetInfo = map->GetPlayerInfo(update.targetId);
 			if (targetInfo && sentToPeers.find(targetInfo->peerId) == sentToPeers.end())
 			{
-				m_Network.Send(targetInfo->peerId, packet);
+				QueuePacket(targetInfo->peerId, packet);
 			}
 		}
 
 		map->ClearAuraUpdates();
 	}
 
-	void WorldServer::SendEntitySpawn(uint32_t peerId, Entity* entity)
+	void WorldServer::SendEntitySpawn(uint32_t peerId, Entity* entity, EntityDeltaBaseline& outBaseline)
 	{
 		if (!entity)
 			return;
@@ -1054,7 +1139,10 @@ namespace MMO {
 		spawn.level = entity->GetLevel();
 		spawn.Serialize(packet);
 
-		m_Network.Send(peerId, packet);
+		// Deltas for this entity are relative to exactly what the spawn carried
+		outBaseline = EntityDeltaBaseline::FromSpawn(spawn);
+
+		QueuePacket(peerId, packet);
 	}
 
 	void WorldServer::SendEntityDespawn(uint32_t peerId, EntityId entityId)
@@ -1064,76 +1152,126 @@ namespace MMO {
 		S_EntityDespawn despawn;
 		despawn.id = entityId;
 		despawn.Serialize(packet);
-		m_Network.Send(peerId, packet);
+		QueuePacket(peerId, packet);
+	}
+
+	void WorldServer::RefreshKnownEntity(MapInstance* map, uint32_t peerId, std::unordered_map<EntityId, EntityDeltaBaseline>& knownEntities,
+										 EntityId entityId, float distanceSq)
+	{
+		constexpr float SPAWN_DISTANCE_SQ = VIEW_DISTANCE * VIEW_DISTANCE;
+		constexpr float DESPAWN_DISTANCE_SQ = (VIEW_DISTANCE + VIEW_DESPAWN_MARGIN) * (VIEW_DISTANCE + VIEW_DESPAWN_MARGIN);
+
+		if (distanceSq <= SPAWN_DISTANCE_SQ)
+		{
+			if (knownEntities.find(entityId) != knownEntities.end())
+				return;
+			Entity* entity = map->GetEntity(entityId);
+			if (!entity)
+				return;
+			auto [baselineIt, inserted] = knownEntities.try_emplace(entityId);
+			SendEntitySpawn(peerId, entity, baselineIt->second);
+		}
+		else if (distanceSq > DESPAWN_DISTANCE_SQ && knownEntities.erase(entityId) > 0)
+		{
+			SendEntityDespawn(peerId, entityId);
+		}
 	}
 
 	void WorldServer::SendSpawnsAndDespawns(MapInstance* map)
 	{
 		Grid& grid = map->GetGrid();
 
-		// Per-player visibility tracking (AzerothCore-style)
-		// Instead of relying on dirty flags that get cleared each tick,
-		// we track what each player knows about and compare with what they can see
-		for (const auto& [playerEntityId, info] : map->GetAllPlayers())
+		// 1. Incremental visibility: the grid records, per player, every entity
+		// that entered or left its view block since last tick. Replay those in
+		// order against the known set; redundant changes (left and came back) net
+		// out. Entering the block only makes an entity a candidate: it's spawned
+		// once it is within VIEW_DISTANCE, here or in the range pass below.
+		for (const auto& [playerEntityId, changes] : grid.GetVisibilityChanges())
 		{
-			Entity* playerEntity = map->GetEntity(playerEntityId);
-			if (!playerEntity || !playerEntity->GetMovement())
+			if (changes.empty())
 				continue;
 
-			Vec2 playerPos = playerEntity->GetMovement()->position;
-
-			// Get entities currently visible to this player
-			std::vector<EntityId> visibleEntities = grid.GetVisibleEntities(playerPos);
+			const PlayerInfo* info = map->GetPlayerInfo(playerEntityId);
+			if (!info)
+				continue;
 
-			// Get or create the player's known entities set
-			std::unordered_set<EntityId>& knownEntities = m_PlayerKnownEntities[info.peerId];
+			// The player's known entities set (created at auth, main thread)
+			auto knownIt = m_PlayerKnownEntities.find(info->peerId);
+			if (knownIt == m_PlayerKnownEntities.end())
+				continue;
+			auto& knownEntities = knownIt->second;
 
-			// Build set of currently visible entity IDs for quick lookup
-			std::unordered_set<EntityId> visibleSet;
-			for (EntityId id : visibleEntities)
-			{
-				if (id != playerEntityId)
-				{ // Skip self
-					visibleSet.insert(id);
-				}
-			}
+			Vec2 playerPosition;
+			if (!grid.GetCachedPosition(playerEntityId, playerPosition))
+				continue;
 
-			// Find entities to spawn: visible but not known
-			for (EntityId id : visibleSet)
+			for (const Grid::VisibilityChange& change : changes)
 			{
-				if (knownEntities.find(id) == knownEntities.end())
+				if (change.visible)
 				{
-					// Player doesn't know about this entity - send spawn
-					Entity* entity = map->GetEntity(id);
-					if (entity)
+					Vec2 position;
+					if (grid.GetCachedPosition(change.id, position))
 					{
-						SendEntitySpawn(info.peerId, entity);
-						knownEntities.insert(id);
+						RefreshKnownEntity(map, info->peerId, knownEntities, change.id,
+										   Vec2::DistanceSquared(playerPosition, position));
 					}
 				}
+				else if (knownEntities.erase(change.id) > 0)
+				{
+					SendEntityDespawn(info->peerId, change.id);
+				}
 			}
+		}
+
+		grid.ClearVisibilityChanges();
+
+		// 2. Range pass: distances only change for entities that moved this tick.
+		// A moved entity is re-checked against each player watching its cell; a
+		// moved player re-checks its whole view block. Entities outside every
+		// block were already despawned by the grid deltas above.
+		for (EntityId entityId : grid.GetDirtyEntities())
+		{
+			if (!grid.GetDirtyFlags(entityId).position)
+				continue;
+
+			Vec2 position;
+			if (!grid.GetCachedPosition(entityId, position))
+				continue;
 
-			// Find entities to despawn: known but no longer visible (or entity removed)
-			std::vector<EntityId> toRemove;
-			for (EntityId id : knownEntities)
+			if (const PlayerInfo* info = map->GetPlayerInfo(entityId))
 			{
-				if (visibleSet.find(id) == visibleSet.end())
+				auto knownIt = m_PlayerKnownEntities.find(info->peerId);
+				if (knownIt != m_PlayerKnownEntities.end())
 				{
-					// Entity is no longer visible to player - send despawn
-					SendEntityDespawn(info.peerId, id);
-					toRemove.push_back(id);
+					grid.ForEachEntityInViewBlock(Grid::PositionToCell(position), [&](EntityId otherId, Vec2 otherPosition) {
+						if (otherId != entityId)
+						{
+							RefreshKnownEntity(map, info->peerId, knownIt->second, otherId,
+											   Vec2::DistanceSquared(position, otherPosition));
+						}
+					});
 				}
 			}
 
-			// Remove despawned entities from known set
-			for (EntityId id : toRemove)
-			{
-				knownEntities.erase(id);
-			}
-		}
+			grid.ForEachWatcher(entityId, [&](EntityId playerId) {
+				if (playerId == entityId)
+					return;
+
+				const PlayerInfo* watcherInfo = map->GetPlayerInfo(playerId);
+				if (!watcherInfo)
+					return;
+				auto knownIt = m_PlayerKnownEntities.find(watcherInfo->peerId);
+				if (knownIt == m_PlayerKnownEntities.end())
+					return;
 
-		// Clear dirty flags (still used for incremental state updates)
-		grid.ClearAllDirtyFlags();
+				Vec2 watcherPosition;
+				if (grid.GetCachedPosition(playerId, watcherPosition))
+				{
+					RefreshKnownEntity(map, watcherInfo->peerId, knownIt->second, entityId,
+									   Vec2::DistanceSquared(watcherPosition, position));
+				}
+			});
+		}
 	}
 
 	void WorldServer::SendYourStats(uint32_t peerId, Entity* player)
@@ -1159,7 +1297,7 @@ namespace MMO {
 		stats.experienceToNext = player->GetXPForNextLevel();
 
 		stats.Serialize(packet);
-		m_Network.Send(peerId, packet);
+		QueuePacket(peerId, packet);
 	}
 
 	void WorldServer::SendError(uint32_t peerId, ErrorCode code)
@@ -1173,6 +1311,188 @@ namespace MMO {
 		m_Network.Send(peerId, packet);
 	}
 
+	// ============================================================
+	// OUTBOUND BATCHING
+	// ============================================================
+
+	PeerOutbox::~PeerOutbox()
+	{
+		// Frames never flushed (peer left mid-tick)
+		for (ENetPacket* packet : sealed)
+		{
+			enet_packet_destroy(packet);
+		}
+	}
+
+	void PeerOutbox::Seal()
+	{
+		// The batch was built in its ENet packet; sealing just takes it
+		if (ENetPacket* frame = batch.Release())
+		{
+			sealed.push_back(frame);
+		}
+	}
+
+	void WorldServer::QueuePacket(uint32_t peerId, const WriteBuffer& packet)
+	{
+		// Lookup only - called from map workers (see m_Outbound)
+		auto it = m_Outbound.find(peerId);
+		if (it == m_Outbound.end())
+			return;
+
+		m_QueuedMessages.fetch_add(1, std::memory_order_relaxed);
+		PeerOutbox& outbox = it->second;
+
+		// Oversized packets go out on their own, after anything already queued.
+		// Like Append below, this is the packet's one copy, into ENet's storage.
+		if (!PacketBatch::IsBatchable(packet.Size()))
+		{
+			outbox.Seal();
+			outbox.sealed.push_back(NetworkServer::CreatePacket(packet.Data(), packet.Size()));
+			return;
+		}
+
+		if (!outbox.batch.CanFit(packet.Size()))
+		{
+			outbox.Seal();
+		}
+		outbox.batch.Append(packet);
+	}
+
+	void WorldServer::FlushPeer(uint32_t peerId)
+	{
+		auto it = m_Outbound.find(peerId);
+		if (it == m_Outbound.end())
+			return;
+
+		PeerOutbox& outbox = it->second;
+		outbox.Seal();
+		for (ENetPacket* frame : outbox.sealed)
+		{
+			m_Network.Send(peerId, frame);
+		}
+		outbox.sealed.clear();
+	}
+
+	void WorldServer::FlushOutbound()
+	{
+		for (auto& [peerId, outbox] : m_Outbound)
+		{
+			FlushPeer(peerId);
+		}
+	}
+
+	void WorldServer::LogNetworkStats()
+	{
+		const NetworkStats& stats = m_Network.GetStats();
+		const double ticks = static_cast<double>(m_StatsTicks);
+
+		std::cout << "[Net] per tick: " << (m_QueuedMessages.load() / ticks) << " msgs -> "
+				  << (stats.packetsSent / ticks) << " packets, "
+				  << (stats.bytesSent / ticks) << " bytes ("
+				  << m_Network.GetConnectedPeerCount() << " peers)" << '\n';
+
+		const uint64_t deltaBytes = m_DeltaBytes.load();
+		const uint64_t legacyBytes = m_DeltaLegacyBytes.load();
+		if (legacyBytes > 0)
+		{
+			std::cout << "[Net] entity deltas per tick: " << (m_DeltaEntries.load() / ticks) << " entries, "
+					  << (deltaBytes / ticks) << " bytes (S_ENTITY_UPDATE would be "
+					  << (legacyBytes / ticks) << ", "
+					  << static_cast<int>(100.0 - 100.0 * deltaBytes / legacyBytes) << "% saved)" << '\n';
+		}
+
+		const AsyncDatabaseStats dbStats = m_AsyncDb.GetStats();
+		if (dbStats.jobsRun > 0 || dbStats.savesQueued > 0)
+		{
+			std::cout << "[DB] " << dbStats.jobsRun << " jobs (" << static_cast<int>(dbStats.busyMs) << " ms busy), "
+					  << dbStats.savesWritten << "/" << dbStats.savesQueued << " saves written (rest coalesced), "
+					  << m_AsyncDb.GetQueueDepth() << " queued" << '\n';
+		}
+		m_AsyncDb.ResetStats();
+
+		m_Network.ResetStats();
+		m_QueuedMessages = 0;
+		m_DeltaEntries = 0;
+		m_DeltaBytes = 0;
+		m_DeltaLegacyBytes = 0;
+		m_StatsTicks = 0;
+	}
+
+	// ============================================================
+	// TICK PROFILING
+	// ============================================================
+
+	void WorldServer::LogTickStats()
+	{
+		const float budgetMs = TICK_INTERVAL * 1000.0f;
+
+		// Formatted locally so std::cout's flags stay as other log lines expect
+		std::ostringstream out;
+		out << std::fixed << std::setprecision(2);
+
+		auto printPhase = [&out](const char* label, const PhaseSummary& summary) {
+			out << ' ' << label << ' ' << summary.p50Ms << '/' << summary.p99Ms << '/' << summary.maxMs;
+		};
+
+		const PhaseSummary tick = m_TickProfile.Summarize(TickPhase::TICK_TOTAL, budgetMs);
+		out << "[Tick] p50/p99/max ms: tick " << tick.p50Ms << '/' << tick.p99Ms << '/' << tick.maxMs << " ("
+			<< tick.overBudget << " of " << tick.samples << " over " << budgetMs << " ms)";
+		for (TickPhase phase : {TickPhase::NETWORK, TickPhase::DB_COMPLETIONS, TickPhase::MAPS, TickPhase::DEFERRED,
+								TickPhase::FLUSH})
+		{
+			printPhase(TickPhaseName(phase), m_TickProfile.Summarize(phase));
+		}
+		out << '\n';
+
+		// A map's own budget is the whole tick: with one worker it shares it
+		// with every other map, so a map near the budget is a problem either way
+		for (const auto& [instanceId, map] : MapManager::Instance().GetAllInstances())
+		{
+			PhaseTimeline& profile = map->GetProfile();
+			const PhaseSummary total = profile.Summarize(TickPhase::MAP_TOTAL, budgetMs);
+			if (total.samples == 0)
+				continue;
+
+			out << "[Tick] " << map->GetName() << " #" << instanceId << " (" << map->GetAllEntities().size()
+				<< " entities, " << map->GetAllPlayers().size() << " players): map " << total.p50Ms << '/'
+				<< total.p99Ms << '/' << total.maxMs << " (" << total.overBudget << " over)";
+			for (size_t i = 0; i < static_cast<size_t>(TickPhase::MAP_TOTAL); i++)
+			{
+				const TickPhase phase = static_cast<TickPhase>(i);
+				const PhaseSummary summary = profile.Summarize(phase);
+				// Idle phases only add noise to the line
+				if (summary.samples > 0 && summary.maxMs >= 0.01f)
+					printPhase(TickPhaseName(phase), summary);
+			}
+			out << '\n';
+		}
+		std::cout << out.str();
+	}
+
+	void WorldServer::BeginTickTrace()
+	{
+		m_ProfilerEnabledBeforeTrace = TickProfiler::IsEnabled();
+		TickProfiler::SetEnabled(true);
+		TickProfiler::BeginTrace();
+		m_TraceTicksLeft = TRACE_CAPTURE_TICKS;
+		std::cout << "[Profiler] Capturing " << TRACE_CAPTURE_TICKS << " ticks from tick " << m_ServerTick << '\n';
+	}
+
+	void WorldServer::WriteTickTrace()
+	{
+		TickProfiler::EndTrace();
+		TickProfiler::SetEnabled(m_ProfilerEnabledBeforeTrace);
+
+		std::vector<TickProfiler::NamedTimeline> timelines;
+		timelines.push_back({"main", &m_TickProfile});
+		for (const auto& [instanceId, map] : MapManager::Instance().GetAllInstances())
+		{
+			timelines.push_back({map->GetName() + " #" + std::to_string(instanceId), &map->GetProfile()});
+		}
+		TickProfiler::WriteChromeTrace("tick_trace_" + std::to_string(m_ServerTick) + ".json", timelines);
+	}
+
 	// ============================================================
 	// LOOT HANDLING
 	// ============================================================
@@ -1593,13 +1913,12 @@ namespace MMO {
 	// INVENTORY & EQUIPMENT PERSISTENCE
 	// ============================================================
 
-	void WorldServer::LoadPlayerInventory(Entity* player, CharacterId characterId)
+	void WorldServer::LoadPlayerInventory(Entity* player, const std::vector<Database::InventoryItemData>& items)
 	{
-		if (!player || !player->GetInventory() || !m_Database.IsConnected())
+		if (!player || !player->GetInventory())
 			return;
 
 		auto inventory = player->GetInventory();
-		auto items = m_Database.GetInventory(characterId);
 
 		for (const auto& itemData : items)
 		{
@@ -1613,17 +1932,16 @@ namespace MMO {
 
 			inventory->slots[itemData.slot].item = item;
 		}
-		std::cout << "[Inventory] Loaded " << items.size() << " items for character " << characterId << '\n';
+		std::cout << "[Inventory] Loaded " << items.size() << " items for " << player->GetName() << '\n';
 	}
 
-	void WorldServer::LoadPlayerEquipment(Entity* player, CharacterId characterId)
+	void WorldServer::LoadPlayerEquipment(Entity* player, const std::vector<Database::EquipmentItemData>& items)
 	{
-		if (!player || !player->GetEquipment() || !m_Database.IsConnected())
+		if (!player || !player->GetEquipment())
 			return;
 
 		auto equipment = player->GetEquipment();
 
-		auto items = m_Database.GetEquipment(characterId);
 		for (const auto& itemData : items)
 		{
 			if (itemData.slot >= EQUIPMENT_SLOT_COUNT)
@@ -1636,16 +1954,17 @@ namespace MMO {
 
 			equipment->slots[itemData.slot] = item;
 		}
-		std::cout << "[Equipment] Loaded " << items.size() << " items for character " << characterId << '\n';
+		std::cout << "[Equipment] Loaded " << items.size() << " items for " << player->GetName() << '\n';
 	}
 
-	void WorldServer::SavePlayerInventory(Entity* player, CharacterId characterId)
+	void WorldServer::CapturePlayerInventory(Entity* player, CharacterSaveData& out)
 	{
-		if (!player || !player->GetInventory() || !m_Database.IsConnected())
+		if (!player || !player->GetInventory())
 			return;
 
 		auto inventory = player->GetInventory();
-		std::vector<Database::InventoryItemData> items;
+		std::vector<Database::InventoryItemData>& items = out.inventory;
+		out.hasInventory = true;
 
 		for (uint8_t i = 0; i < INVENTORY_SIZE; i++)
 		{
@@ -1661,16 +1980,16 @@ namespace MMO {
 			}
 		}
 
-		m_Database.SaveInventory(characterId, items);
 	}
 
-	void WorldServer::SavePlayerEquipment(Entity* player, CharacterId characterId)
+	void WorldServer::CapturePlayerEquipment(Entity* player, CharacterSaveData& out)
 	{
-		if (!player || !player->GetEquipment() || !m_Database.IsConnected())
+		if (!player || !player->GetEquipment())
 			return;
 
 		auto equipment = player->GetEquipment();
-		std::vector<Database::EquipmentItemData> items;
+		std::vector<Database::EquipmentItemData>& items = out.equipment;
+		out.hasEquipment = true;
 
 		for (uint8_t i = 0; i < EQUIPMENT_SLOT_COUNT; i++)
 		{
@@ -1685,7 +2004,6 @@ namespace MMO {
 			}
 		}
 
-		m_Database.SaveEquipment(characterId, items);
 	}
 
 } // namespace MMO
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "../../Shared/Source/Database/AsyncDatabase.h"
 #include "../../Shared/Source/Database/Database.h"
 #include "../../Shared/Source/Network/ENetWrapper.h"
+#include "../../Shared/Source/Network/PacketBatch.h"
 #include "../../Shared/Source/Packets/Packets.h"
 #include "Map/Map.h"
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <unordered_map>
@@ -37,6 +40,37 @@ namespace MMO {
 		EntityId entityId;
 	};
 
+	// ============================================================
+	// CHARACTER LOAD RESULT
+	// ============================================================
+
+	// Everything a login reads from the DB, fetched on an AsyncDatabase worker
+	struct CharacterLoadResult
+	{
+		CharacterData character;
+		std::vector<CooldownData> cooldowns;
+		std::vector<Database::InventoryItemData> inventory;
+		std::vector<Database::EquipmentItemData> equipment;
+	};
+
+	// ============================================================
+	// PEER OUTBOX (per-peer outbound batching)
+	// ============================================================
+
+	struct PeerOutbox
+	{
+		PacketBatch batch;
+		std::vector<ENetPacket*> sealed; // Frames waiting for FlushOutbound (owned)
+
+		PeerOutbox() = default;
+		PeerOutbox(const PeerOutbox&) = delete;
+		PeerOutbox& operator=(const PeerOutbox&) = delete;
+		~PeerOutbox();
+
+		// Move the open batch's ENet packet (if any) into sealed
+		void Seal();
+	};
+
 	// ============================================================
 	// WORLD SERVER
 	// ============================================================
@@ -47,17 +81,23 @@ namespace MMO {
 		WorldServer();
 		~WorldServer();
 
-		bool Initialize(uint16_t port = 7001, const std::string& dbConnectionString = "");
+		bool Initialize(uint16_t port = 7001, const std::string& dbConnectionString = "",
+						size_t mapUpdateThreads = 1, const std::string& dataDirectory = "Data");
 		void Run();
 		void Stop();
 
 		// For inter-server communication
 		void AddPendingAuth(const std::string& token, CharacterId characterId, AccountId accountId);
 
+		// Captures the next TRACE_CAPTURE_TICKS ticks as a Chrome trace
+		// (tick_trace_<tick>.json). Only sets a flag: safe from a signal handler.
+		void RequestTickTrace() { m_TraceRequested = true; }
+
 	private:
-		void ProcessPacket(uint32_t peerId, const std::vector<uint8_t>& data);
+		void ProcessPacket(uint32_t peerId, const uint8_t* data, size_t size);
 
 		void HandleAuthToken(uint32_t peerId, ReadBuffer& buf);
+		void CompleteAuth(uint32_t peerId, CharacterId characterId, const CharacterLoadResult& loaded);
 		void HandleInput(uint32_t peerId, ReadBuffer& buf);
 		void HandleCastAbility(uint32_t peerId, ReadBuffer& buf);
 		void HandleSelectTarget(uint32_t peerId, ReadBuffer& buf);
@@ -71,11 +111,14 @@ namespace MMO {
 
 		void SendEnterWorld(uint32_t peerId, EntityId entityId, MapInstance* map);
 		void SendZoneData(uint32_t peerId, MapInstance* map);
+		void SendMapUpdates(MapInstance* map);
 		void SendWorldState(MapInstance* map);
 		void SendEvents(MapInstance* map);
 		void SendAuraUpdates(MapInstance* map);
 		void SendSpawnsAndDespawns(MapInstance* map);
-		void SendEntitySpawn(uint32_t peerId, Entity* entity);
+		void RefreshKnownEntity(MapInstance* map, uint32_t peerId, std::unordered_map<EntityId, EntityDeltaBaseline>& knownEntities,
+								EntityId entityId, float distanceSq);
+		void SendEntitySpawn(uint32_t peerId, Entity* entity, EntityDeltaBaseline& outBaseline);
 		void SendEntityDespawn(uint32_t peerId, EntityId entityId);
 		void SendYourStats(uint32_t peerId, Entity* player);
 		void SendError(uint32_t peerId, ErrorCode code);
@@ -89,11 +132,24 @@ namespace MMO {
 		void SendEquipmentUpdate(uint32_t peerId, EquipmentSlot slot, const ItemInstance* item);
 		void SendCharacterStats(uint32_t peerId, Entity* player);
 
+		// Outbound batching: per-tick state fan-out is coalesced into one
+		// S_PACKET_BATCH per peer, flushed at the end of the tick. QueuePacket
+		// is safe from map workers; flushing touches ENet and is main-thread only.
+		void QueuePacket(uint32_t peerId, const WriteBuffer& packet);
+		void FlushPeer(uint32_t peerId);
+		void FlushOutbound();
+		void LogNetworkStats();
+
+		// Tick profiler (see Profiling/TickProfiler.h)
+		void LogTickStats();
+		void BeginTickTrace();
+		void WriteTickTrace();
+
 		// Inventory/Equipment loading and saving
-		void LoadPlayerInventory(Entity* player, CharacterId characterId);
-		void LoadPlayerEquipment(Entity* player, CharacterId characterId);
-		void SavePlayerInventory(Entity* player, CharacterId characterId);
-		void SavePlayerEquipment(Entity* player, CharacterId characterId);
+		void LoadPlayerInventory(Entity* player, const std::vector<Database::InventoryItemData>& items);
+		void LoadPlayerEquipment(Entity* player, const std::vector<Database::EquipmentItemData>& items);
+		void CapturePlayerInventory(Entity* player, CharacterSaveData& out);
+		void CapturePlayerEquipment(Entity* player, CharacterSaveData& out);
 
 		void OnPlayerConnect(uint32_t peerId);
 		void OnPlayerDisconnect(uint32_t peerId);
@@ -101,19 +157,45 @@ namespace MMO {
 		// Portal handling (click-based)
 		void TransferPlayer(uint32_t peerId, const Portal* portal, MapInstance* fromMap);
 
-		// Persistence
+		// Persistence. Saves are snapshotted here and written behind by
+		// m_AsyncDb; LoadCharacter runs on a DB worker and must not touch server state.
 		void SavePlayer(const ConnectedPlayer& player);
-		CharacterData LoadCharacter(CharacterId characterId);
+		void SaveAllPlayers();
+		static CharacterLoadResult LoadCharacter(Database& db, CharacterId characterId);
+
+		// Final save + DB drain once Run() leaves its loop
+		void Shutdown();
 
 		NetworkServer m_Network;
-		Database m_Database;
+		Database m_Database;   // Startup only (migrations, templates, maps)
+		AsyncDatabase m_AsyncDb; // Everything the game loop reads or writes
 
 		std::unordered_map<std::string, PendingAuth> m_PendingAuths;
 		std::unordered_map<uint32_t, ConnectedPlayer> m_ConnectedPlayers;
+		std::unordered_set<uint32_t> m_PendingLogins; // Peers whose character load is in flight
 
 		// Per-player visibility tracking (AzerothCore-style)
-		// Maps peerId -> set of EntityIds the player has been told about
-		std::unordered_map<uint32_t, std::unordered_set<EntityId>> m_PlayerKnownEntities;
+		// Maps peerId -> EntityIds the player has been told about, each with the
+		// wire state last sent for it (baseline for S_ENTITY_DELTAS)
+		std::unordered_map<uint32_t, std::unordered_map<EntityId, EntityDeltaBaseline>> m_PlayerKnownEntities;
+
+		// Reused across polls; packets are released after dispatch
+		std::vector<NetworkEvent> m_Events;
+
+		// Outbound batches per authenticated peer. Entries are only added/removed
+		// on the main thread, so map workers can look them up concurrently.
+		std::unordered_map<uint32_t, PeerOutbox> m_Outbound;
+		std::atomic<uint64_t> m_QueuedMessages; // Logical packets queued since last stats log
+		std::atomic<uint64_t> m_DeltaEntries;	// S_ENTITY_DELTAS entries since last stats log
+		std::atomic<uint64_t> m_DeltaBytes;		// ...and their wire bytes
+		std::atomic<uint64_t> m_DeltaLegacyBytes; // What the same updates cost as S_ENTITY_UPDATE
+		uint32_t m_StatsTicks;
+		uint32_t m_AutosaveTicks;
+
+		PhaseTimeline m_TickProfile;		 // Main-loop phases; maps keep their own
+		std::atomic<bool> m_TraceRequested;
+		uint32_t m_TraceTicksLeft;			 // Ticks still to capture, 0 when idle
+		bool m_ProfilerEnabledBeforeTrace;
 
 		bool m_Running;
 		uint32_t m_ServerTick;
@@ -121,6 +203,10 @@ namespace MMO {
 
 		static constexpr float TICK_RATE = 20.0f; // 20 Hz
 		static constexpr float TICK_INTERVAL = 1.0f / TICK_RATE;
+		static constexpr uint32_t NET_STATS_LOG_INTERVAL = 200; // Ticks between [Net] log lines (10 s)
+		static constexpr uint32_t AUTOSAVE_INTERVAL = 1200;		// Ticks between autosaves of every player (60 s)
+		static constexpr size_t DB_CONNECTIONS = 2;				// AsyncDatabase workers, one connection each
+		static constexpr uint32_t TRACE_CAPTURE_TICKS = 100;	// Ticks per Chrome trace (5 s)
 	};
 
 } // namespace MMO
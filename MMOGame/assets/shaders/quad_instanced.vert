@@ -0,0 +1,37 @@
+#version 330 core
+
+// One Onyx::QuadInstance (Renderer2D.h) per instance, drawn as a 4-vertex
+// triangle strip; the corner comes from gl_VertexID
+layout (location = 0) in vec3 a_Position;
+layout (location = 1) in float a_Rotation;
+layout (location = 2) in vec2 a_HalfSize;
+layout (location = 3) in vec4 a_UVRect;
+layout (location = 4) in vec4 a_Color;
+layout (location = 5) in float a_TexIndex;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out float v_TexIndex;
+
+uniform mat4 u_ViewProjection;
+uniform vec2 u_CornerScale; // (1, aspect ratio): applied after rotation, like Renderer2D's vertex batch
+
+const vec2 CORNERS[4] = vec2[4](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(-1.0, 1.0), vec2(1.0, 1.0));
+
+void main()
+{
+    vec2 corner = CORNERS[gl_VertexID];
+
+    // Degrees, clockwise
+    float angle = radians(-a_Rotation);
+    float s = sin(angle);
+    float c = cos(angle);
+    vec2 offset = corner * a_HalfSize;
+    offset = vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c) * u_CornerScale;
+
+    v_Color = a_Color;
+    v_TexCoord = mix(a_UVRect.xy, a_UVRect.zw, corner * 0.5 + 0.5);
+    v_TexIndex = a_TexIndex;
+
+    gl_Position = u_ViewProjection * vec4(a_Position.xy + offset, a_Position.z, 1.0);
+}
@@ -0,0 +1,118 @@
+#include "pch.h"
+
+#include "ContentHasher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace Onyx {
+
+	namespace {
+
+		// xxHash64 constants and round: one multiply-rotate-multiply per 8 bytes
+		constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+		constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+		constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+
+		constexpr size_t FILE_BLOCK_SIZE = 1 << 20;
+
+		uint64_t RotateLeft(uint64_t value, int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		uint64_t Round(uint64_t state, uint64_t word)
+		{
+			state += word * PRIME_2;
+			return RotateLeft(state, 31) * PRIME_1;
+		}
+
+		uint64_t LoadWord(const uint8_t* bytes)
+		{
+			uint64_t word;
+			memcpy(&word, bytes, sizeof(word));
+			return word;
+		}
+
+	} // namespace
+
+	ContentHasher::ContentHasher(uint64_t seed)
+		: m_State(seed + PRIME_3)
+	{
+	}
+
+	void ContentHasher::Add(const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		m_Length += size;
+
+		if (m_TailSize > 0)
+		{
+			const size_t fill = std::min(size, sizeof(m_Tail) - m_TailSize);
+			memcpy(m_Tail + m_TailSize, bytes, fill);
+			m_TailSize += fill;
+			bytes += fill;
+			size -= fill;
+			if (m_TailSize < sizeof(m_Tail))
+				return;
+			m_State = Round(m_State, LoadWord(m_Tail));
+			m_TailSize = 0;
+		}
+
+		for (; size >= 8; bytes += 8, size -= 8)
+		{
+			m_State = Round(m_State, LoadWord(bytes));
+		}
+
+		if (size > 0)
+		{
+			memcpy(m_Tail, bytes, size);
+			m_TailSize = size;
+		}
+	}
+
+	void ContentHasher::Add(std::string_view text)
+	{
+		// Length first, so ("ab", "c") and ("a", "bc") differ
+		AddValue(text.size());
+		Add(text.data(), text.size());
+	}
+
+	bool ContentHasher::AddFile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		std::vector<char> block(FILE_BLOCK_SIZE);
+		while (file)
+		{
+			file.read(block.data(), static_cast<std::streamsize>(block.size()));
+			Add(block.data(), static_cast<size_t>(file.gcount()));
+		}
+		return file.eof();
+	}
+
+	uint64_t ContentHasher::Get() const
+	{
+		uint64_t state = m_State;
+		if (m_TailSize > 0)
+		{
+			uint8_t last[8] = {};
+			memcpy(last, m_Tail, m_TailSize);
+			state = Round(state, LoadWord(last));
+		}
+		state ^= m_Length;
+
+		// xxHash64 avalanche
+		state ^= state >> 33;
+		state *= PRIME_2;
+		state ^= state >> 29;
+		state *= PRIME_3;
+		state ^= state >> 32;
+		return state;
+	}
+
+} // namespace Onyx
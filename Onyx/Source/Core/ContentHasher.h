@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Onyx {
+
+	// Incremental 64-bit content hash (xxHash64-style rounds) for keys of
+	// derived data: export items, cached model imports. Not cryptographic:
+	// it only has to notice that an input changed.
+	class ContentHasher
+	{
+	public:
+		explicit ContentHasher(uint64_t seed = 0);
+
+		void Add(const void* data, size_t size);
+		void Add(std::string_view text);
+		template <typename T>
+		void AddValue(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Add(&value, sizeof(T));
+		}
+		template <typename T>
+		void AddVector(const std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			AddValue(values.size());
+			Add(values.data(), values.size() * sizeof(T));
+		}
+
+		// Whole file contents; false if it cannot be read
+		bool AddFile(const std::string& path);
+
+		uint64_t Get() const;
+
+	private:
+		uint64_t m_State;
+		uint64_t m_Length = 0;
+		uint8_t m_Tail[8] = {};
+		size_t m_TailSize = 0;
+	};
+
+} // namespace Onyx
@@ -0,0 +1,121 @@
+#include "pch.h"
+
+#include "FileSystem.h"
+
+#include <mutex>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Onyx::FileSystem {
+
+	namespace {
+
+		std::mutex s_ProviderMutex;
+		std::shared_ptr<const Provider> s_Provider;
+
+		// Unmapped when the last FileView referencing it goes away
+		struct Mapping
+		{
+			const uint8_t* data = nullptr;
+			size_t size = 0;
+#ifdef _WIN32
+			HANDLE file = INVALID_HANDLE_VALUE;
+			HANDLE mapping = nullptr;
+#endif
+
+			~Mapping()
+			{
+#ifdef _WIN32
+				if (data)
+					UnmapViewOfFile(data);
+				if (mapping)
+					CloseHandle(mapping);
+				if (file != INVALID_HANDLE_VALUE)
+					CloseHandle(file);
+#else
+				if (data)
+					munmap(const_cast<uint8_t*>(data), size);
+#endif
+			}
+		};
+
+		std::shared_ptr<Mapping> MapFile(const std::string& path)
+		{
+			auto mapping = std::make_shared<Mapping>();
+#ifdef _WIN32
+			mapping->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+										FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (mapping->file == INVALID_HANDLE_VALUE)
+				return nullptr;
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(mapping->file, &size) || size.QuadPart == 0)
+				return nullptr;
+			mapping->mapping = CreateFileMappingA(mapping->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping->mapping)
+				return nullptr;
+			mapping->data = static_cast<const uint8_t*>(MapViewOfFile(mapping->mapping, FILE_MAP_READ, 0, 0, 0));
+			mapping->size = static_cast<size_t>(size.QuadPart);
+#else
+			int fd = open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return nullptr;
+			struct stat st;
+			if (fstat(fd, &st) != 0 || st.st_size <= 0)
+			{
+				close(fd);
+				return nullptr;
+			}
+			void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd); // The mapping keeps the file referenced
+			if (view == MAP_FAILED)
+				return nullptr;
+			mapping->data = static_cast<const uint8_t*>(view);
+			mapping->size = static_cast<size_t>(st.st_size);
+#endif
+			return mapping->data ? mapping : nullptr;
+		}
+
+	} // namespace
+
+	void SetProvider(Provider provider)
+	{
+		std::lock_guard<std::mutex> lock(s_ProviderMutex);
+		s_Provider = provider ? std::make_shared<const Provider>(std::move(provider)) : nullptr;
+	}
+
+	bool ReadFromProvider(const std::string& path, FileView& out)
+	{
+		std::shared_ptr<const Provider> provider;
+		{
+			std::lock_guard<std::mutex> lock(s_ProviderMutex);
+			provider = s_Provider;
+		}
+		return provider && (*provider)(path, out);
+	}
+
+	bool ReadFile(const std::string& path, FileView& out)
+	{
+		if (ReadFromProvider(path, out))
+			return true;
+
+		auto mapping = MapFile(path);
+		if (!mapping)
+			return false;
+		out.data = mapping->data;
+		out.size = mapping->size;
+		out.owner = std::move(mapping);
+		return true;
+	}
+
+} // namespace Onyx::FileSystem
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Onyx::FileSystem {
+
+	// Bytes of a file; `owner` keeps them alive
+	struct FileView
+	{
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		std::shared_ptr<const void> owner;
+	};
+
+	// Lets the game serve asset files from somewhere other than the disk
+	// (e.g. a mounted archive). Return false to fall back to the disk.
+	// Called from loader threads too, so it must be thread-safe.
+	using Provider = std::function<bool(const std::string& path, FileView& out)>;
+
+	// Pass an empty Provider to remove it
+	void SetProvider(Provider provider);
+
+	// False if no provider is set or it does not have `path`
+	bool ReadFromProvider(const std::string& path, FileView& out);
+
+	// The provider first, then the disk through a read-only mapping (no
+	// copy; pages fault in as they are read). False if neither has the file.
+	bool ReadFile(const std::string& path, FileView& out);
+
+} // namespace Onyx::FileSystem
@@ -75,9 +75,7 @@ namespace Onyx {
 
 		importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
 
-		unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace | aiProcess_LimitBoneWeights | aiProcess_JoinIdenticalVertices;
-
-		const aiScene* scene = importer.ReadFile(path, flags);
+		const aiScene* scene = importer.ReadFile(path, IMPORT_FLAGS);
 
 		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
 		{
@@ -119,6 +117,7 @@ namespace Onyx {
 			}
 		}
 
+		CompileAnimations();
 		m_BoneMatrices.resize(m_Skeleton.GetBoneCount(), glm::mat4(1.0f));
 		m_HasGPU = true;
 
@@ -135,9 +134,7 @@ namespace Onyx {
 		Assimp::Importer importer;
 		importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
 
-		unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace | aiProcess_LimitBoneWeights | aiProcess_JoinIdenticalVertices;
-
-		const aiScene* scene = importer.ReadFile(path, flags);
+		const aiScene* scene = importer.ReadFile(path, IMPORT_FLAGS);
 
 		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
 		{
@@ -181,6 +178,7 @@ namespace Onyx {
 			}
 		}
 
+		model->CompileAnimations();
 		model->m_BoneMatrices.resize(model->m_Skeleton.GetBoneCount(), glm::mat4(1.0f));
 		// m_HasGPU stays false — caller must invoke UploadGPUResources() on main thread
 
@@ -397,6 +395,7 @@ namespace Onyx {
 				continue;
 			}
 
+			animation->Compile(m_NodeHierarchy);
 			m_AnimationMap[animName] = static_cast<int>(m_Animations.size());
 			m_Animations.push_back(std::move(animation));
 			animationsLoaded++;
@@ -874,6 +873,15 @@ namespace Onyx {
 
 #endif // ONYX_USE_ASSIMP
 
+	void AnimatedModel::CompileAnimations()
+	{
+		m_Rig.Build(m_NodeHierarchy, m_Skeleton);
+		for (auto& animation : m_Animations)
+		{
+			animation->Compile(m_NodeHierarchy);
+		}
+	}
+
 	Animation* AnimatedModel::GetAnimation(const std::string& name)
 	{
 		auto it = m_AnimationMap.find(name);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Animation.h"
+#include "AnimationRig.h"
 #include "Buffers.h"
 #include "Model.h"
 #include "Skeleton.h"
@@ -80,6 +81,9 @@ namespace Onyx {
 	class AnimatedModel
 	{
 	public:
+		// Post-processing for Load and ParseFromFile (FBX pivots are not preserved)
+		static constexpr unsigned int IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace | aiProcess_LimitBoneWeights | aiProcess_JoinIdenticalVertices;
+
 		AnimatedModel() = default;
 		~AnimatedModel();
 
@@ -106,6 +110,7 @@ namespace Onyx {
 		const Skeleton& GetSkeleton() const { return m_Skeleton; }
 
 		const std::vector<std::unique_ptr<Animation>>& GetAnimations() const { return m_Animations; }
+		const AnimationRig& GetRig() const { return m_Rig; }
 		Animation* GetAnimation(const std::string& name);
 		Animation* GetAnimation(int index);
 		int GetAnimationCount() const { return static_cast<int>(m_Animations.size()); }
@@ -131,13 +136,7 @@ namespace Onyx {
 		const MergedBuffers& GetMergedBuffers() const { return m_Merged; }
 		bool HasMergedBuffers() const { return m_Merged.vao != nullptr; }
 
-		struct NodeData
-		{
-			std::string name;
-			glm::mat4 transform;
-			int parentIndex;
-			std::vector<int> children;
-		};
+		using NodeData = AnimationNode;
 		const std::vector<NodeData>& GetNodeHierarchy() const { return m_NodeHierarchy; }
 		int GetNodeIndex(const std::string& name) const
 		{
@@ -152,6 +151,7 @@ namespace Onyx {
 		void LoadAnimationsImpl(const void* scene);
 		void LoadMaterialsImpl(const void* scene);
 		void BuildNodeHierarchyImpl(void* node, int parentIndex);
+		void CompileAnimations();
 
 		std::string m_Path;
 		std::string m_Directory;
@@ -170,6 +170,7 @@ namespace Onyx {
 
 		std::vector<NodeData> m_NodeHierarchy;
 		std::unordered_map<std::string, int> m_NodeMap;
+		AnimationRig m_Rig;
 
 		MergedBuffers m_Merged;
 
@@ -179,6 +180,8 @@ namespace Onyx {
 		void ProcessNodeImplCpuOnly(void* node, const void* scene);
 		void ProcessMeshImplCpuOnly(void* mesh, const void* scene);
 		void LoadMaterialsImplCpuOnly(const void* scene);
+
+		friend class ModelCache; // Stores and rebuilds parsed models
 	};
 
 } // namespace Onyx
@@ -1,20 +1,36 @@
 #include "Animation.h"
 #include "pch.h"
+#include "Maths/SimdMath.h"
 #include <algorithm>
+#include <cmath>
 
 namespace Onyx {
 
-	template <typename KeyType>
-	int BoneAnimation::FindKeyIndex(const std::vector<KeyType>& keys, float time) const
-	{
-		for (size_t i = 0; i < keys.size() - 1; i++)
+	namespace {
+
+		template <typename KeyType>
+		void ShortestKeyInterval(const std::vector<KeyType>& keys, float& shortest)
 		{
-			if (time < keys[i + 1].time)
+			for (size_t i = 1; i < keys.size(); i++)
 			{
-				return static_cast<int>(i);
+				float interval = keys[i].time - keys[i - 1].time;
+				if (interval > 0.0f)
+				{
+					shortest = std::min(shortest, interval);
+				}
 			}
 		}
-		return static_cast<int>(keys.size() - 2);
+
+	} // namespace
+
+	template <typename KeyType>
+	int BoneAnimation::FindKeyIndex(const std::vector<KeyType>& keys, float time) const
+	{
+		// First key after `time`, searched from keys[1]; the segment starts one before it
+		auto it = std::upper_bound(keys.begin() + 1, keys.end(), time,
+								   [](float t, const KeyType& key) { return t < key.time; });
+		int index = static_cast<int>(it - keys.begin()) - 1;
+		return std::min(index, static_cast<int>(keys.size() - 2));
 	}
 
 	glm::vec3 BoneAnimation::InterpolatePosition(float time) const
@@ -93,6 +109,10 @@ namespace Onyx {
 	{
 		m_BoneAnimationMap[boneAnim.boneName] = static_cast<int>(m_BoneAnimations.size());
 		m_BoneAnimations.push_back(boneAnim);
+
+		// The compiled table no longer covers every track
+		m_FrameCount = 0;
+		m_NodeTracks.clear();
 	}
 
 	const BoneAnimation* Animation::GetBoneAnimation(const std::string& boneName) const
@@ -105,4 +125,81 @@ namespace Onyx {
 		return nullptr;
 	}
 
+	void Animation::Compile(const std::vector<AnimationNode>& nodes)
+	{
+		float shortest = m_Duration;
+		for (const auto& track : m_BoneAnimations)
+		{
+			ShortestKeyInterval(track.positionKeys, shortest);
+			ShortestKeyInterval(track.rotationKeys, shortest);
+			ShortestKeyInterval(track.scaleKeys, shortest);
+		}
+		float step = std::max(shortest, m_TicksPerSecond / MAX_SAMPLE_RATE);
+
+		// Tolerance keeps float noise in key times from adding a frame
+		uint32_t intervals = 0;
+		if (m_Duration > 0.0f && step > 0.0f)
+		{
+			intervals = static_cast<uint32_t>(std::ceil(m_Duration / step - 1e-3f));
+			intervals = std::clamp(intervals, 1u, MAX_COMPILED_FRAMES - 1);
+		}
+
+		const size_t trackCount = m_BoneAnimations.size();
+		m_FrameCount = intervals + 1;
+		m_FramesPerTick = intervals > 0 ? static_cast<float>(intervals) / m_Duration : 0.0f;
+		m_FramePositions.resize(m_FrameCount * trackCount);
+		m_FrameRotations.resize(m_FrameCount * trackCount);
+		m_FrameScales.resize(m_FrameCount * trackCount);
+
+		for (uint32_t frame = 0; frame < m_FrameCount; frame++)
+		{
+			float time = intervals > 0 ? m_Duration * static_cast<float>(frame) / static_cast<float>(intervals) : 0.0f;
+			for (size_t track = 0; track < trackCount; track++)
+			{
+				const BoneAnimation& boneAnim = m_BoneAnimations[track];
+				size_t index = frame * trackCount + track;
+				m_FramePositions[index] = boneAnim.InterpolatePosition(time);
+				m_FrameRotations[index] = boneAnim.InterpolateRotation(time);
+				m_FrameScales[index] = boneAnim.InterpolateScale(time);
+			}
+		}
+
+		m_NodeTracks.assign(nodes.size(), -1);
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			auto it = m_BoneAnimationMap.find(nodes[i].name);
+			if (it != m_BoneAnimationMap.end())
+			{
+				m_NodeTracks[i] = it->second;
+			}
+		}
+	}
+
+	AnimationCursor Animation::GetCursor(float time) const
+	{
+		AnimationCursor cursor;
+		if (m_FrameCount < 2)
+		{
+			return cursor;
+		}
+
+		float frame = glm::clamp(time * m_FramesPerTick, 0.0f, static_cast<float>(m_FrameCount - 1));
+		cursor.frame0 = std::min(static_cast<uint32_t>(frame), m_FrameCount - 2);
+		cursor.frame1 = cursor.frame0 + 1;
+		cursor.alpha = frame - static_cast<float>(cursor.frame0);
+		return cursor;
+	}
+
+	void Animation::SampleTrack(const AnimationCursor& cursor, int track,
+								glm::vec3& position, glm::quat& rotation, glm::vec3& scale) const
+	{
+		const size_t trackCount = m_BoneAnimations.size();
+		const size_t a = cursor.frame0 * trackCount + track;
+		const size_t b = cursor.frame1 * trackCount + track;
+
+		position = glm::mix(m_FramePositions[a], m_FramePositions[b], cursor.alpha);
+		rotation = Simd::QuatSlerpFast(m_FrameRotations[a], m_FrameRotations[b], cursor.alpha);
+		scale = glm::mix(m_FrameScales[a], m_FrameScales[b], cursor.alpha);
+	}
+
 } // namespace Onyx
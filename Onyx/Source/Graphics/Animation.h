@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <string>
@@ -26,6 +27,23 @@ namespace Onyx {
 		glm::vec3 scale;
 	};
 
+	// One node of a model's transform hierarchy, in the order Assimp visits it
+	struct AnimationNode
+	{
+		std::string name;
+		glm::mat4 transform;
+		int parentIndex;
+		std::vector<int> children;
+	};
+
+	// Where a clip time falls on the compiled frame grid
+	struct AnimationCursor
+	{
+		uint32_t frame0 = 0;
+		uint32_t frame1 = 0;
+		float alpha = 0.0f;
+	};
+
 	struct BoneAnimation
 	{
 		std::string boneName;
@@ -58,12 +76,47 @@ namespace Onyx {
 		const BoneAnimation* GetBoneAnimation(const std::string& boneName) const;
 		const std::vector<BoneAnimation>& GetBoneAnimations() const { return m_BoneAnimations; }
 
+		// ============================================================
+		// COMPILED CLIP
+		// ============================================================
+		//
+		// Resamples every track onto one uniform frame grid and binds tracks to
+		// node indices, so sampling is a multiply, two frame loads and a lerp
+		// per track instead of a name lookup and a key search. The grid step is
+		// the clip's shortest key interval (capped at MAX_SAMPLE_RATE), so
+		// clips exported with uniform keys resample without loss.
+		static constexpr float MAX_SAMPLE_RATE = 120.0f; // Frames per second
+		static constexpr uint32_t MAX_COMPILED_FRAMES = 4096;
+
+		void Compile(const std::vector<AnimationNode>& nodes);
+		bool IsCompiled() const { return m_FrameCount > 0; }
+		uint32_t GetFrameCount() const { return m_FrameCount; }
+
+		AnimationCursor GetCursor(float time) const;
+
+		// Track index animating nodes[nodeIndex] as passed to Compile, or -1
+		int GetNodeTrack(int nodeIndex) const
+		{
+			return nodeIndex >= 0 && nodeIndex < static_cast<int>(m_NodeTracks.size()) ? m_NodeTracks[nodeIndex] : -1;
+		}
+
+		void SampleTrack(const AnimationCursor& cursor, int track,
+						 glm::vec3& position, glm::quat& rotation, glm::vec3& scale) const;
+
 	private:
 		std::string m_Name;
 		float m_Duration = 0.0f;
 		float m_TicksPerSecond = 25.0f;
 		std::vector<BoneAnimation> m_BoneAnimations;
 		std::unordered_map<std::string, int> m_BoneAnimationMap;
+
+		// Frame-major: frame f's keys for all tracks are contiguous
+		uint32_t m_FrameCount = 0;
+		float m_FramesPerTick = 0.0f;
+		std::vector<glm::vec3> m_FramePositions;
+		std::vector<glm::quat> m_FrameRotations;
+		std::vector<glm::vec3> m_FrameScales;
+		std::vector<int> m_NodeTracks;
 	};
 
 } // namespace Onyx
@@ -0,0 +1,153 @@
+#include "pch.h"
+
+#include "AnimationBatch.h"
+#include "Animator.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Onyx {
+
+	AnimationBatch::~AnimationBatch()
+	{
+		Deactivate();
+	}
+
+	void AnimationBatch::Activate(size_t numThreads)
+	{
+		Deactivate();
+
+		m_Stopping = false;
+		m_Workers.reserve(numThreads);
+		for (size_t i = 0; i < numThreads; ++i)
+		{
+			m_Workers.emplace_back(&AnimationBatch::WorkerThread, this);
+		}
+	}
+
+	void AnimationBatch::Deactivate()
+	{
+		if (m_Workers.empty())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_WorkAvailable.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			worker.join();
+		}
+		m_Workers.clear();
+	}
+
+	void AnimationBatch::Update(std::span<Animator* const> animators, float deltaTime,
+								std::span<glm::mat4* const> palettes)
+	{
+		// Clocks first: cheap, and BlendTo/Play from game code may have touched them
+		m_Advanced.resize(animators.size());
+		for (size_t i = 0; i < animators.size(); i++)
+		{
+			m_Advanced[i] = animators[i]->Advance(deltaTime) ? 1 : 0;
+		}
+
+		ParallelFor(static_cast<uint32_t>(animators.size()), [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++)
+			{
+				Animator* animator = animators[i];
+				if (m_Advanced[i])
+					animator->EvaluatePose();
+
+				glm::mat4* palette = i < palettes.size() ? palettes[i] : nullptr;
+				if (palette)
+				{
+					const auto& bones = animator->GetBoneMatrices();
+					size_t count = std::min<size_t>(animator->GetPaletteSize(), bones.size());
+					std::memcpy(palette, bones.data(), count * sizeof(glm::mat4));
+				}
+			}
+		});
+	}
+
+	void AnimationBatch::Evaluate(std::span<const AnimationJob> jobs)
+	{
+		ParallelFor(static_cast<uint32_t>(jobs.size()), [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++)
+			{
+				const AnimationJob& job = jobs[i];
+				job.rig->Evaluate(*job.clip, job.time, job.blendFrom, job.blendFromTime, job.blendFactor,
+								  *job.globals, job.palette, job.paletteSize);
+			}
+		});
+	}
+
+	void AnimationBatch::ParallelFor(uint32_t count, const std::function<void(uint32_t, uint32_t)>& body)
+	{
+		if (count == 0)
+			return;
+		if (m_Workers.empty() || count < MIN_PARALLEL_ITEMS)
+		{
+			body(0, count);
+			return;
+		}
+
+		// A few chunks per thread so uneven rigs still balance
+		const uint32_t threads = static_cast<uint32_t>(m_Workers.size()) + 1;
+		const uint32_t chunk = std::max(1u, count / (threads * 4));
+		std::atomic<uint32_t> next{0};
+		auto drain = [&] {
+			while (true)
+			{
+				uint32_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+				if (begin >= count)
+					return;
+				body(begin, std::min(begin + chunk, count));
+			}
+		};
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Work = drain;
+			m_WorkGeneration++;
+			m_BusyWorkers = m_Workers.size();
+		}
+		m_WorkAvailable.notify_all();
+
+		drain();
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_WorkDone.wait(lock, [this] { return m_BusyWorkers == 0; });
+		m_Work = nullptr;
+	}
+
+	void AnimationBatch::WorkerThread()
+	{
+		uint64_t seenGeneration = 0;
+		while (true)
+		{
+			std::function<void()> work;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_WorkAvailable.wait(lock, [&] { return m_Stopping || m_WorkGeneration != seenGeneration; });
+				if (m_Stopping)
+					return;
+
+				seenGeneration = m_WorkGeneration;
+				work = m_Work;
+			}
+
+			work();
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (--m_BusyWorkers == 0)
+				{
+					m_WorkDone.notify_all();
+				}
+			}
+		}
+	}
+
+} // namespace Onyx
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "AnimationRig.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Onyx {
+
+	class Animator;
+
+	// One pose to evaluate: everything AnimationRig::Evaluate needs
+	struct AnimationJob
+	{
+		const AnimationRig* rig = nullptr;
+		const Animation* clip = nullptr;
+		float time = 0.0f;
+		const Animation* blendFrom = nullptr;
+		float blendFromTime = 0.0f;
+		float blendFactor = 0.0f;
+		std::vector<glm::mat4>* globals = nullptr; // Scratch, one per job
+		glm::mat4* palette = nullptr;
+		uint32_t paletteSize = 0;
+	};
+
+	// ============================================================
+	// ANIMATION BATCH
+	// ============================================================
+	//
+	// Evaluates many poses per frame across a persistent worker pool; the
+	// calling thread works too and returns once every pose is written.
+	// Without Activate() everything runs on the calling thread.
+	//
+	// Typical frame: reserve one palette range per animated instance with
+	// SceneRenderer::ReserveSkinned, then Update(animators, dt, palettes) so
+	// workers write bone matrices straight into the renderer's packed bone
+	// buffer instead of going through SubmitSkinned's per-instance copy.
+
+	class AnimationBatch
+	{
+	public:
+		AnimationBatch() = default;
+		~AnimationBatch();
+
+		AnimationBatch(const AnimationBatch&) = delete;
+		AnimationBatch& operator=(const AnimationBatch&) = delete;
+
+		void Activate(size_t numThreads);
+		void Deactivate();
+		size_t GetThreadCount() const { return m_Workers.size(); }
+
+		// Advances every animator's clock (serially), then evaluates their poses
+		// in parallel. palettes[i], when given and non-null, receives a copy of
+		// animator i's GetPaletteSize() matrices, including animators that are
+		// paused or stopped this frame.
+		void Update(std::span<Animator* const> animators, float deltaTime,
+					std::span<glm::mat4* const> palettes = {});
+
+		// Evaluates prepared jobs in parallel
+		void Evaluate(std::span<const AnimationJob> jobs);
+
+	private:
+		// Calls body(begin, end) over [0, count) in chunks on every thread
+		void ParallelFor(uint32_t count, const std::function<void(uint32_t, uint32_t)>& body);
+		void WorkerThread();
+
+		// Below this many items, waking the workers costs more than it saves
+		static constexpr uint32_t MIN_PARALLEL_ITEMS = 16;
+
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		std::condition_variable m_WorkDone;
+		std::function<void()> m_Work;
+		uint64_t m_WorkGeneration = 0;
+		size_t m_BusyWorkers = 0;
+		bool m_Stopping = false;
+
+		std::vector<uint8_t> m_Advanced;
+	};
+
+} // namespace Onyx
@@ -0,0 +1,129 @@
+#include "pch.h"
+
+#include "AnimationRig.h"
+#include "Maths/SimdMath.h"
+
+#include <algorithm>
+
+namespace Onyx {
+
+	void AnimationRig::Build(const std::vector<AnimationNode>& nodes, const Skeleton& skeleton)
+	{
+		m_Nodes.clear();
+		m_Nodes.reserve(nodes.size());
+		m_UnboundBones.clear();
+		m_GlobalInverse = skeleton.GetGlobalInverseTransform();
+		m_BoneCount = static_cast<uint32_t>(std::min(skeleton.GetBoneCount(), Skeleton::MAX_BONES));
+
+		// Depth-first from every root, children in their original order
+		std::vector<int> slotOf(nodes.size(), -1);
+		std::vector<int> stack;
+		for (int i = static_cast<int>(nodes.size()) - 1; i >= 0; i--)
+		{
+			if (nodes[i].parentIndex < 0)
+				stack.push_back(i);
+		}
+
+		while (!stack.empty())
+		{
+			int index = stack.back();
+			stack.pop_back();
+			const AnimationNode& source = nodes[index];
+
+			Node node;
+			node.localTransform = source.transform;
+			node.boneOffset = glm::mat4(1.0f);
+			node.node = index;
+			node.parent = source.parentIndex >= 0 ? slotOf[source.parentIndex] : -1;
+			node.boneIndex = skeleton.GetBoneIndex(source.name);
+			if (node.boneIndex >= Skeleton::MAX_BONES)
+				node.boneIndex = -1;
+			if (node.boneIndex >= 0)
+				node.boneOffset = skeleton.GetBone(node.boneIndex)->offsetMatrix;
+
+			slotOf[index] = static_cast<int>(m_Nodes.size());
+			m_Nodes.push_back(node);
+
+			for (auto it = source.children.rbegin(); it != source.children.rend(); ++it)
+			{
+				stack.push_back(*it);
+			}
+		}
+
+		std::vector<bool> bound(m_BoneCount, false);
+		for (const Node& node : m_Nodes)
+		{
+			if (node.boneIndex >= 0)
+				bound[node.boneIndex] = true;
+		}
+		for (uint32_t bone = 0; bone < m_BoneCount; bone++)
+		{
+			if (!bound[bone])
+				m_UnboundBones.push_back(static_cast<int>(bone));
+		}
+	}
+
+	void AnimationRig::Evaluate(const Animation& clip, float time,
+								const Animation* blendFrom, float blendFromTime, float blendFactor,
+								std::vector<glm::mat4>& globals, glm::mat4* palette, uint32_t paletteSize) const
+	{
+		globals.resize(m_Nodes.size());
+		const int boneLimit = static_cast<int>(std::min(paletteSize, m_BoneCount));
+
+		const AnimationCursor cursor = clip.GetCursor(time);
+		const AnimationCursor fromCursor = blendFrom ? blendFrom->GetCursor(blendFromTime) : AnimationCursor{};
+
+		glm::mat4 local;
+		glm::mat4 skinned;
+		for (size_t i = 0; i < m_Nodes.size(); i++)
+		{
+			const Node& node = m_Nodes[i];
+
+			int track = clip.GetNodeTrack(node.node);
+			if (track >= 0)
+			{
+				glm::vec3 position;
+				glm::quat rotation;
+				glm::vec3 scale;
+				clip.SampleTrack(cursor, track, position, rotation, scale);
+
+				int fromTrack = blendFrom ? blendFrom->GetNodeTrack(node.node) : -1;
+				if (fromTrack >= 0)
+				{
+					glm::vec3 fromPosition;
+					glm::quat fromRotation;
+					glm::vec3 fromScale;
+					blendFrom->SampleTrack(fromCursor, fromTrack, fromPosition, fromRotation, fromScale);
+
+					position = glm::mix(fromPosition, position, blendFactor);
+					rotation = Simd::QuatSlerp(fromRotation, rotation, blendFactor);
+					scale = glm::mix(fromScale, scale, blendFactor);
+				}
+
+				Simd::ComposeTRS(position, rotation, scale, local);
+			}
+			else
+			{
+				local = node.localTransform;
+			}
+
+			if (node.parent >= 0)
+				Simd::MultiplyMat4(globals[node.parent], local, globals[i]);
+			else
+				globals[i] = local;
+
+			if (node.boneIndex >= 0 && node.boneIndex < boneLimit)
+			{
+				Simd::MultiplyMat4(globals[i], node.boneOffset, skinned);
+				Simd::MultiplyMat4(m_GlobalInverse, skinned, palette[node.boneIndex]);
+			}
+		}
+
+		for (int bone : m_UnboundBones)
+		{
+			if (bone < boneLimit)
+				palette[bone] = glm::mat4(1.0f);
+		}
+	}
+
+} // namespace Onyx
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Animation.h"
+#include "Skeleton.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Onyx {
+
+	// ============================================================
+	// ANIMATION RIG
+	// ============================================================
+	//
+	// A model's node hierarchy flattened into parent-before-child order, with
+	// each node's skeleton bone index resolved once. Evaluating a pose is a
+	// single loop over this table with nothing looked up by name. Built once
+	// per AnimatedModel and shared by every Animator playing it.
+
+	class AnimationRig
+	{
+	public:
+		void Build(const std::vector<AnimationNode>& nodes, const Skeleton& skeleton);
+
+		bool IsEmpty() const { return m_Nodes.empty(); }
+		uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_Nodes.size()); }
+
+		// Skinning matrices one pose writes (the skeleton's bone count)
+		uint32_t GetBoneCount() const { return m_BoneCount; }
+
+		// Writes skinning matrices for `clip` at `time` (ticks), blended from
+		// `blendFrom` at `blendFromTime` when given, into palette[0, min(GetBoneCount(),
+		// paletteSize)). Bones no node drives are written as identity. Clips
+		// must be compiled against the node list the rig was built from.
+		// `globals` is scratch owned by the caller so one rig can serve many
+		// animators, including from several threads at once.
+		void Evaluate(const Animation& clip, float time,
+					  const Animation* blendFrom, float blendFromTime, float blendFactor,
+					  std::vector<glm::mat4>& globals, glm::mat4* palette, uint32_t paletteSize) const;
+
+	private:
+		struct Node
+		{
+			glm::mat4 localTransform; // Used when no track animates the node
+			glm::mat4 boneOffset;
+			int node;	   // Index in the source hierarchy, as clips are bound
+			int parent;	   // Index in m_Nodes, -1 for roots
+			int boneIndex; // -1 when the node does not skin anything
+		};
+
+		std::vector<Node> m_Nodes;
+		std::vector<int> m_UnboundBones;
+		glm::mat4 m_GlobalInverse = glm::mat4(1.0f);
+		uint32_t m_BoneCount = 0;
+	};
+
+} // namespace Onyx
@@ -1,6 +1,5 @@
 #include "Animator.h"
 #include "pch.h"
-#include <glm/gtc/matrix_transform.hpp>
 
 namespace Onyx {
 
@@ -9,7 +8,6 @@ namespace Onyx {
 		if (m_Model)
 		{
 			m_FinalBoneMatrices.resize(Skeleton::MAX_BONES, glm::mat4(1.0f));
-			BuildNodeCache();
 		}
 	}
 
@@ -21,37 +19,13 @@ namespace Onyx {
 		m_CurrentTime = 0.0f;
 		m_Playing = false;
 		m_IsBlending = false;
-		m_NodeCacheValid = false;
 
 		if (m_Model)
 		{
 			m_FinalBoneMatrices.resize(Skeleton::MAX_BONES, glm::mat4(1.0f));
-			BuildNodeCache();
 		}
 	}
 
-	void Animator::BuildNodeCache()
-	{
-		if (!m_Model)
-			return;
-
-		m_NodeCache.clear();
-		const auto& nodeHierarchy = m_Model->GetNodeHierarchy();
-
-		for (size_t i = 0; i < nodeHierarchy.size(); i++)
-		{
-			const auto& node = nodeHierarchy[i];
-			NodeTransformCache cacheNode;
-			cacheNode.name = node.name;
-			cacheNode.localTransform = node.transform;
-			cacheNode.parentIndex = node.parentIndex;
-			cacheNode.children = node.children;
-			m_NodeCache.push_back(cacheNode);
-		}
-
-		m_NodeCacheValid = true;
-	}
-
 	void Animator::Play(const std::string& animationName, bool loop)
 	{
 		if (!m_Model)
@@ -166,17 +140,28 @@ namespace Onyx {
 
 	void Animator::Update(float deltaTime)
 	{
-		if (!m_Model || !m_CurrentAnimation)
+		if (!Advance(deltaTime))
 		{
 			return;
 		}
+
+		EvaluatePose();
+		m_Model->SetBoneMatrices(m_FinalBoneMatrices);
+	}
+
+	bool Animator::Advance(float deltaTime)
+	{
+		if (!m_Model || !m_CurrentAnimation)
+		{
+			return false;
+		}
 		if (!m_Playing || m_Paused)
 		{
-			return;
+			return false;
 		}
-		if (m_NodeCache.empty() || m_FinalBoneMatrices.empty())
+		if (m_Model->GetRig().IsEmpty() || m_FinalBoneMatrices.empty())
 		{
-			return;
+			return false;
 		}
 
 		m_CurrentTime += deltaTime * m_PlaybackSpeed * m_CurrentAnimation->GetTicksPerSecond();
@@ -205,77 +190,25 @@ namespace Onyx {
 				m_BlendFromAnimation = nullptr;
 			}
 		}
-
-		glm::mat4 identity(1.0f);
-		for (int i = 0; i < static_cast<int>(m_NodeCache.size()); i++)
-		{
-			if (m_NodeCache[i].parentIndex < 0)
-			{
-				CalculateBoneTransform(i, identity);
-			}
-		}
-
-		m_Model->SetBoneMatrices(m_FinalBoneMatrices);
+		return true;
 	}
 
-	void Animator::CalculateBoneTransform(int nodeIndex, const glm::mat4& parentTransform)
+	void Animator::EvaluatePose()
 	{
-		if (nodeIndex < 0 || nodeIndex >= static_cast<int>(m_NodeCache.size()))
+		if (!m_Model || !m_CurrentAnimation)
 		{
 			return;
 		}
 
-		const auto& node = m_NodeCache[nodeIndex];
-		glm::mat4 nodeTransform = node.localTransform;
-
-		if (m_CurrentAnimation)
-		{
-			const BoneAnimation* boneAnim = m_CurrentAnimation->GetBoneAnimation(node.name);
-
-			if (boneAnim)
-			{
-				glm::vec3 position = boneAnim->InterpolatePosition(m_CurrentTime);
-				glm::quat rotation = boneAnim->InterpolateRotation(m_CurrentTime);
-				glm::vec3 scale = boneAnim->InterpolateScale(m_CurrentTime);
-
-				if (m_IsBlending && m_BlendFromAnimation)
-				{
-					const BoneAnimation* fromBoneAnim = m_BlendFromAnimation->GetBoneAnimation(node.name);
-					if (fromBoneAnim)
-					{
-						glm::vec3 fromPos = fromBoneAnim->InterpolatePosition(m_BlendFromTime);
-						glm::quat fromRot = fromBoneAnim->InterpolateRotation(m_BlendFromTime);
-						glm::vec3 fromScale = fromBoneAnim->InterpolateScale(m_BlendFromTime);
-
-						position = glm::mix(fromPos, position, m_BlendFactor);
-						rotation = glm::slerp(fromRot, rotation, m_BlendFactor);
-						scale = glm::mix(fromScale, scale, m_BlendFactor);
-					}
-				}
-
-				nodeTransform = glm::translate(glm::mat4(1.0f), position) *
-								glm::mat4_cast(rotation) *
-								glm::scale(glm::mat4(1.0f), scale);
-			}
-		}
-
-		glm::mat4 globalTransform = parentTransform * nodeTransform;
-
-		const Skeleton& skeleton = m_Model->GetSkeleton();
-		int boneIndex = skeleton.GetBoneIndex(node.name);
-		if (boneIndex >= 0 && boneIndex < static_cast<int>(m_FinalBoneMatrices.size()))
-		{
-			const Bone* bone = skeleton.GetBone(boneIndex);
-			if (bone)
-			{
-				m_FinalBoneMatrices[boneIndex] = skeleton.GetGlobalInverseTransform() * globalTransform * bone->offsetMatrix;
-			}
-		}
+		const Animation* blendFrom = m_IsBlending ? m_BlendFromAnimation : nullptr;
+		m_Model->GetRig().Evaluate(*m_CurrentAnimation, m_CurrentTime, blendFrom, m_BlendFromTime, m_BlendFactor,
+								   m_GlobalTransforms, m_FinalBoneMatrices.data(),
+								   static_cast<uint32_t>(m_FinalBoneMatrices.size()));
+	}
 
-		for (int childIndex : node.children)
-		{
-			CalculateBoneTransform(childIndex, globalTransform);
-		}
+	uint32_t Animator::GetPaletteSize() const
+	{
+		return m_Model ? m_Model->GetRig().GetBoneCount() : 0;
 	}
 
 } // namespace Onyx
@@ -22,6 +22,16 @@ namespace Onyx {
 
 		void Update(float deltaTime);
 
+		// Update split in two for AnimationBatch. Advance moves the clock and
+		// returns whether there is a pose to evaluate; EvaluatePose writes it
+		// and touches only this animator, so different animators can evaluate
+		// on different threads. Neither publishes to AnimatedModel::SetBoneMatrices.
+		bool Advance(float deltaTime);
+		void EvaluatePose();
+
+		// Matrices a pose writes: the model skeleton's bone count
+		uint32_t GetPaletteSize() const;
+
 		// Blending (smooth transition between animations)
 		void BlendTo(const std::string& animationName, float blendDuration, bool loop = true);
 		void BlendTo(int animationIndex, float blendDuration, bool loop = true);
@@ -44,8 +54,6 @@ namespace Onyx {
 		const std::vector<glm::mat4>& GetBoneMatrices() const { return m_FinalBoneMatrices; }
 
 	private:
-		void CalculateBoneTransform(int nodeIndex, const glm::mat4& parentTransform);
-
 		AnimatedModel* m_Model = nullptr;
 		Animation* m_CurrentAnimation = nullptr;
 
@@ -65,17 +73,8 @@ namespace Onyx {
 		// Final matrices
 		std::vector<glm::mat4> m_FinalBoneMatrices;
 
-		// Node transforms cache (for hierarchy traversal)
-		struct NodeTransformCache
-		{
-			std::string name;
-			glm::mat4 localTransform;
-			int parentIndex;
-			std::vector<int> children;
-		};
-		std::vector<NodeTransformCache> m_NodeCache;
-		bool m_NodeCacheValid = false;
-		void BuildNodeCache();
+		// Per-node global transforms, scratch for AnimationRig::Evaluate
+		std::vector<glm::mat4> m_GlobalTransforms;
 	};
 
 } // namespace Onyx
@@ -2,12 +2,15 @@
 #include "AnimatedModel.h"
 #include "Model.h"
 #include "pch.h"
+#include <Core/Platform.h>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstring>
 #include <iostream>
+#include <type_traits>
 
 namespace Onyx {
 
@@ -16,6 +19,8 @@ namespace Onyx {
 		m_DefaultAlbedo = Texture::CreateSolidColor(200, 200, 200);
 		m_DefaultNormal = Texture::CreateSolidColor(128, 128, 255);
 
+		m_ModelCache.SetDirectory((Platform::GetExecutableDir() / "Cache" / "Models").string());
+
 		InitBufferPool();
 		m_LoadThread = std::thread(&AssetManager::LoaderThreadFunc, this);
 		m_TextureLoadThread = std::thread(&AssetManager::TextureLoaderThreadFunc, this);
@@ -155,8 +160,7 @@ namespace Onyx {
 
 		try
 		{
-			auto model = std::make_unique<Model>(path.c_str(), loadTextures);
-			m_Models[handle.id] = std::move(model);
+			m_Models[handle.id] = ImportModel(path, loadTextures);
 		}
 		catch (...)
 		{
@@ -283,6 +287,7 @@ namespace Onyx {
 	Material& AssetManager::CreateMaterial(const std::string& id, const std::string& name)
 	{
 		auto& mat = m_Materials[id];
+		m_MaterialsVersion++;
 		mat.id = id;
 		mat.name = name.empty() ? id : name;
 		return mat;
@@ -291,6 +296,7 @@ namespace Onyx {
 	void AssetManager::RegisterMaterial(const Material& mat)
 	{
 		m_Materials[mat.id] = mat;
+		m_MaterialsVersion++;
 	}
 
 	std::string AssetManager::GenerateUniqueMaterialId(const std::string& baseName) const
@@ -337,7 +343,10 @@ namespace Onyx {
 
 	bool AssetManager::RemoveMaterial(const std::string& id)
 	{
-		return m_Materials.erase(id) > 0;
+		if (m_Materials.erase(id) == 0)
+			return false;
+		m_MaterialsVersion++;
+		return true;
 	}
 
 	std::vector<std::string> AssetManager::GetAllMaterialIds() const
@@ -360,7 +369,7 @@ namespace Onyx {
 
 		try
 		{
-			m_Models[handle.id] = std::make_unique<Model>(path.c_str(), false);
+			m_Models[handle.id] = ImportModel(path, false);
 		}
 		catch (...)
 		{
@@ -452,10 +461,11 @@ namespace Onyx {
 			if (readyTex->preloaded.Valid())
 			{
 				double texStart = glfwGetTime();
-				auto texture = Texture::CreateWithMipmaps(
-					readyTex->preloaded.pixels.data(),
-					readyTex->preloaded.width, readyTex->preloaded.height,
-					readyTex->preloaded.channels);
+				auto texture = readyTex->preloaded.compressed.Valid()
+								   ? Texture::CreateCompressed(readyTex->preloaded.compressed)
+								   : Texture::CreateWithMipmaps(readyTex->preloaded.pixels.data(),
+																readyTex->preloaded.width, readyTex->preloaded.height,
+																readyTex->preloaded.channels);
 				float texMs = static_cast<float>((glfwGetTime() - texStart) * 1000.0);
 
 				TextureHandle handle;
@@ -498,10 +508,10 @@ namespace Onyx {
 			}
 
 			// Large model — begin staged upload (streamed across multiple frames)
-			size_t totalBytes = pending->mergedVertexData.size() + pending->mergedIndexData.size();
+			size_t totalBytes = pending->merged.vertexData.size() + pending->merged.indexData.size();
 			std::cout << "[UPLOAD] Model: " << pending->path
-					  << " verts=" << pending->mergedTotalVertices
-					  << " indices=" << pending->mergedTotalIndices
+					  << " verts=" << pending->merged.totalVertices
+					  << " indices=" << pending->merged.totalIndices
 					  << " bytes=" << totalBytes
 					  << (totalBytes > UPLOAD_CHUNK_BYTES ? " STAGED" : " IMMEDIATE")
 					  << (pending->isAnimated ? " ANIMATED" : " STATIC") << '\n';
@@ -523,14 +533,15 @@ namespace Onyx {
 				m_AnimModelPaths[pending->path] = handle;
 				m_IdToPath[handle.id] = pending->path;
 			}
-			else if (!pending->mergedVertexData.empty())
+			else if (!pending->merged.vertexData.empty())
 			{
-				auto model = std::make_unique<Model>(pending->directory, pending->meshBounds);
+				MergedMeshData& data = pending->merged;
+				auto model = std::make_unique<Model>(pending->directory, data.meshBounds);
 				model->SetMergedBuffers(BuildMergedFromPool(
-					pending->mergedVertexData.data(), pending->mergedVertexData.size(),
-					pending->mergedIndexData.data(), pending->mergedIndexData.size(),
-					pending->mergedTotalVertices, pending->mergedTotalIndices,
-					std::move(pending->mergedMeshInfos)));
+					data.vertexData.data(), data.vertexData.size(),
+					data.indexData.data(), data.indexData.size(),
+					data.totalVertices, data.totalIndices,
+					std::move(data.meshInfos)));
 
 				ModelHandle handle;
 				handle.id = m_NextId++;
@@ -565,14 +576,14 @@ namespace Onyx {
 		m_ActiveUpload->pending = pending;
 		m_ActiveUpload->isAnimated = pending->isAnimated;
 
-		size_t vboBytes = pending->mergedVertexData.size();
-		size_t eboBytes = pending->mergedIndexData.size();
+		size_t vboBytes = pending->merged.vertexData.size();
+		size_t eboBytes = pending->merged.indexData.size();
 
 		if (!pending->isAnimated)
 		{
 			// Lightweight Model: bounds-only Mesh objects, no vertex data iteration
 			m_ActiveUpload->staticModel = std::make_unique<Model>(
-				pending->directory, pending->meshBounds);
+				pending->directory, pending->merged.meshBounds);
 		}
 		else
 		{
@@ -624,12 +635,12 @@ namespace Onyx {
 		size_t budget = UPLOAD_CHUNK_BYTES;
 
 		// Upload VBO chunk
-		size_t vboRemaining = pending.mergedVertexData.size() - upload.vboUploaded;
+		size_t vboRemaining = pending.merged.vertexData.size() - upload.vboUploaded;
 		if (vboRemaining > 0)
 		{
 			size_t chunk = std::min(vboRemaining, budget);
 			upload.vbo->SetSubData(
-				pending.mergedVertexData.data() + upload.vboUploaded,
+				pending.merged.vertexData.data() + upload.vboUploaded,
 				static_cast<uint32_t>(upload.vboUploaded),
 				static_cast<uint32_t>(chunk));
 			upload.vboUploaded += chunk;
@@ -637,20 +648,20 @@ namespace Onyx {
 		}
 
 		// Upload EBO chunk (with remaining budget)
-		size_t eboRemaining = pending.mergedIndexData.size() - upload.eboUploaded;
+		size_t eboRemaining = pending.merged.indexData.size() - upload.eboUploaded;
 		if (eboRemaining > 0 && budget > 0)
 		{
 			size_t chunk = std::min(eboRemaining, budget);
 			upload.ebo->SetSubData(
-				pending.mergedIndexData.data() + upload.eboUploaded,
+				pending.merged.indexData.data() + upload.eboUploaded,
 				static_cast<uint32_t>(upload.eboUploaded),
 				static_cast<uint32_t>(chunk));
 			upload.eboUploaded += chunk;
 		}
 
 		// Check if upload is complete
-		bool vboDone = upload.vboUploaded >= pending.mergedVertexData.size();
-		bool eboDone = upload.eboUploaded >= pending.mergedIndexData.size();
+		bool vboDone = upload.vboUploaded >= pending.merged.vertexData.size();
+		bool eboDone = upload.eboUploaded >= pending.merged.indexData.size();
 
 		if (vboDone && eboDone)
 		{
@@ -664,15 +675,15 @@ namespace Onyx {
 		auto& upload = *m_ActiveUpload;
 		auto& pending = *upload.pending;
 
-		upload.ebo->SetCount(pending.mergedTotalIndices);
+		upload.ebo->SetCount(pending.merged.totalIndices);
 
 		MergedBuffers merged;
 		merged.vao = std::move(upload.vao);
 		merged.vbo = std::move(upload.vbo);
 		merged.ebo = std::move(upload.ebo);
-		merged.totalVertices = pending.mergedTotalVertices;
-		merged.totalIndices = pending.mergedTotalIndices;
-		merged.meshInfos = std::move(pending.mergedMeshInfos);
+		merged.totalVertices = pending.merged.totalVertices;
+		merged.totalIndices = pending.merged.totalIndices;
+		merged.meshInfos = std::move(pending.merged.meshInfos);
 
 		if (upload.isAnimated && upload.animModel)
 		{
@@ -718,8 +729,7 @@ namespace Onyx {
 	}
 
 	template <typename VertexT, typename MeshRange>
-	void AssetManager::MergeMeshesToPending(const MeshRange& meshes, PendingLoad& out,
-											std::vector<MeshBoundsInfo>* boundsOut)
+	void AssetManager::MergeMeshes(const MeshRange& meshes, MergedMeshData& out)
 	{
 		uint32_t totalVerts = 0, totalIndices = 0;
 		for (const auto& mesh : meshes)
@@ -727,10 +737,14 @@ namespace Onyx {
 			totalVerts += static_cast<uint32_t>(mesh.vertices.size());
 			totalIndices += static_cast<uint32_t>(mesh.indices.size());
 		}
-		out.mergedTotalVertices = totalVerts;
-		out.mergedTotalIndices = totalIndices;
-		out.mergedVertexData.resize(totalVerts * sizeof(VertexT));
-		out.mergedIndexData.resize(totalIndices * sizeof(uint32_t));
+		out.totalVertices = totalVerts;
+		out.totalIndices = totalIndices;
+		out.vertexData.resize(totalVerts * sizeof(VertexT));
+		out.indexData.resize(totalIndices * sizeof(uint32_t));
+
+		// Static meshes get a LOD chain on this (loader) thread; its ranges
+		// are appended after every mesh's LOD0 range
+		std::vector<uint32_t> lodIndices;
 
 		size_t vOff = 0, iOff = 0;
 		uint32_t vertexOffset = 0, indexOffset = 0;
@@ -740,9 +754,18 @@ namespace Onyx {
 			info.indexCount = static_cast<uint32_t>(mesh.indices.size());
 			info.firstIndex = indexOffset;
 			info.baseVertex = static_cast<int32_t>(vertexOffset);
-			out.mergedMeshInfos.push_back(info);
+			info.lods[0] = {info.firstIndex, info.indexCount, 0.0f};
+			if constexpr (std::is_same_v<VertexT, MeshVertex>)
+			{
+				info.lodCount = BuildMeshLods(reinterpret_cast<const uint8_t*>(mesh.vertices.data()),
+											  mesh.vertices.size(), sizeof(MeshVertex), mesh.indices.data(),
+											  mesh.indices.size(), totalIndices + static_cast<uint32_t>(lodIndices.size()),
+											  lodIndices, info.lods);
+			}
+			out.meshInfos.push_back(info);
 
-			if (boundsOut)
+			// Static meshes also keep their bounds and texture paths
+			if constexpr (std::is_same_v<VertexT, MeshVertex>)
 			{
 				MeshBoundsInfo bounds;
 				bounds.name = mesh.name;
@@ -756,20 +779,105 @@ namespace Onyx {
 					bounds.boundsMin = glm::min(bounds.boundsMin, p);
 					bounds.boundsMax = glm::max(bounds.boundsMax, p);
 				}
-				boundsOut->push_back(bounds);
+				out.meshBounds.push_back(bounds);
+				out.meshTextures.push_back(mesh.texturePaths);
 			}
 
 			size_t vBytes = mesh.vertices.size() * sizeof(VertexT);
-			std::memcpy(out.mergedVertexData.data() + vOff, mesh.vertices.data(), vBytes);
+			std::memcpy(out.vertexData.data() + vOff, mesh.vertices.data(), vBytes);
 			vOff += vBytes;
 
 			size_t iBytes = mesh.indices.size() * sizeof(uint32_t);
-			std::memcpy(out.mergedIndexData.data() + iOff, mesh.indices.data(), iBytes);
+			std::memcpy(out.indexData.data() + iOff, mesh.indices.data(), iBytes);
 			iOff += iBytes;
 
 			vertexOffset += static_cast<uint32_t>(mesh.vertices.size());
 			indexOffset += static_cast<uint32_t>(mesh.indices.size());
 		}
+
+		if (!lodIndices.empty())
+		{
+			out.indexData.resize(out.indexData.size() + lodIndices.size() * sizeof(uint32_t));
+			std::memcpy(out.indexData.data() + iOff, lodIndices.data(), lodIndices.size() * sizeof(uint32_t));
+			out.totalIndices += static_cast<uint32_t>(lodIndices.size());
+		}
+	}
+
+	// --- Model cache ---
+
+	bool AssetManager::ImportStaticModel(const std::string& path, uint64_t sourceHash, MergedMeshData& out)
+	{
+		const uint64_t key = sourceHash ? ModelCache::MakeKey(sourceHash, ModelCache::Kind::Static) : 0;
+		if (m_ModelCache.LoadStatic(key, out))
+			return true;
+
+		const auto start = std::chrono::steady_clock::now();
+		std::string directory;
+		std::vector<CpuMeshData> meshes = Model::ParseFromFile(path, directory, true);
+		if (meshes.empty())
+			return false;
+
+		MergeMeshes<MeshVertex>(meshes, out);
+		m_ModelCache.RecordImport(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		m_ModelCache.StoreStatic(key, out);
+		return true;
+	}
+
+	std::unique_ptr<AnimatedModel> AssetManager::ImportAnimatedModel(const std::string& path, uint64_t sourceHash)
+	{
+		const uint64_t key = sourceHash ? ModelCache::MakeKey(sourceHash, ModelCache::Kind::Animated) : 0;
+		std::unique_ptr<AnimatedModel> model;
+		if (m_ModelCache.LoadAnimated(key, path, model))
+			return model;
+
+		const auto start = std::chrono::steady_clock::now();
+		model = AnimatedModel::ParseFromFile(path);
+		if (!model)
+			return nullptr;
+		m_ModelCache.RecordImport(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+		// Remember files without animations too, so the next load skips
+		// straight to the static import
+		if (model->GetAnimationCount() == 0)
+			model.reset();
+		m_ModelCache.StoreAnimated(key, model.get());
+		return model;
+	}
+
+	std::unique_ptr<Model> AssetManager::ImportModel(const std::string& path, bool loadTextures)
+	{
+		const std::string directory = path.substr(0, path.find_last_of('/'));
+
+		MergedMeshData data;
+		if (!ImportStaticModel(path, m_ModelCache.HashSource(path), data))
+			return std::make_unique<Model>(std::vector<CpuMeshData>{}, directory);
+
+		// Split back into per-mesh CPU data for Draw and picking. The merged
+		// buffers, LODs included, are uploaded as imported, so the renderer's
+		// BuildMergedBuffers has nothing left to do.
+		const MeshVertex* vertices = reinterpret_cast<const MeshVertex*>(data.vertexData.data());
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(data.indexData.data());
+		std::vector<CpuMeshData> meshes(data.meshInfos.size());
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			const MergedMeshInfo& info = data.meshInfos[i];
+			const uint32_t vertexEnd = i + 1 < meshes.size()
+										   ? static_cast<uint32_t>(data.meshInfos[i + 1].baseVertex)
+										   : data.totalVertices;
+			meshes[i].vertices.assign(vertices + info.baseVertex, vertices + vertexEnd);
+			meshes[i].indices.assign(indices + info.firstIndex, indices + info.firstIndex + info.indexCount);
+			meshes[i].name = data.meshBounds[i].name;
+			if (loadTextures)
+				meshes[i].texturePaths = data.meshTextures[i];
+		}
+
+		auto model = std::make_unique<Model>(std::move(meshes), directory);
+		model->SetMergedBuffers(BuildMergedFromPool(
+			data.vertexData.data(), data.vertexData.size(),
+			data.indexData.data(), data.indexData.size(),
+			data.totalVertices, data.totalIndices,
+			std::move(data.meshInfos)));
+		return model;
 	}
 
 	void AssetManager::LoaderThreadFunc()
@@ -792,12 +900,14 @@ namespace Onyx {
 			pending->status = ModelLoadStatus::Parsing;
 
 			bool loaded = false;
+			const uint64_t sourceHash = m_ModelCache.HashSource(pending->path);
+			pending->directory = pending->path.substr(0, pending->path.find_last_of('/'));
 
 			// Try animated first if requested
 			if (pending->checkAnimated)
 			{
-				auto animModel = AnimatedModel::ParseFromFile(pending->path);
-				if (animModel && animModel->GetAnimationCount() > 0)
+				auto animModel = ImportAnimatedModel(pending->path, sourceHash);
+				if (animModel)
 				{
 					animModel->PreloadTextureData(); // stbi_load on background thread
 					pending->parsedAnimModel = std::move(animModel);
@@ -806,30 +916,19 @@ namespace Onyx {
 				}
 			}
 
-			// Fall back to static model
-			std::vector<CpuMeshData> staticMeshData;
-			if (!loaded)
+			// Fall back to static model (merged on this thread, or straight from the cache)
+			if (!loaded && ImportStaticModel(pending->path, sourceHash, pending->merged))
 			{
-				staticMeshData = Model::ParseFromFile(pending->path, pending->directory, false);
-				if (!staticMeshData.empty())
-				{
-					pending->isAnimated = false;
-					loaded = true;
-				}
+				pending->isAnimated = false;
+				loaded = true;
 			}
 
 			if (loaded)
 			{
-				// Pre-concatenate mesh data on background thread (CPU-only, no GL calls)
+				// Pre-concatenate skinned mesh data on background thread (CPU-only, no GL calls)
 				// This avoids large CPU allocations on the main/render thread.
-				if (!pending->isAnimated)
-				{
-					MergeMeshesToPending<MeshVertex>(staticMeshData, *pending, &pending->meshBounds);
-				}
-				else
-				{
-					MergeMeshesToPending<SkinnedVertex>(pending->parsedAnimModel->GetMeshes(), *pending, nullptr);
-				}
+				if (pending->isAnimated)
+					MergeMeshes<SkinnedVertex>(pending->parsedAnimModel->GetMeshes(), pending->merged);
 
 				pending->status = ModelLoadStatus::ReadyForGPU;
 
@@ -3,6 +3,7 @@
 #include "AssetHandle.h"
 #include "Material.h"
 #include "Model.h"
+#include "ModelCache.h"
 #include "Texture.h"
 #include <atomic>
 #include <condition_variable>
@@ -55,6 +56,8 @@ namespace Onyx {
 		const Material* GetMaterial(const std::string& id) const;
 		bool HasMaterial(const std::string& id) const;
 		bool RemoveMaterial(const std::string& id);
+		// Bumped by every create/register/remove, so caches of resolved material paths can revalidate
+		uint32_t GetMaterialsVersion() const { return m_MaterialsVersion; }
 		std::vector<std::string> GetAllMaterialIds() const;
 
 		Texture* GetDefaultAlbedo() const { return m_DefaultAlbedo.get(); }
@@ -68,6 +71,11 @@ namespace Onyx {
 		void RequestModelAsync(const std::string& path, bool checkAnimated = true);
 		void ProcessGPUUploads(int maxPerFrame = 2);
 
+		// Derived-data cache for Assimp imports, used by LoadModel, Reload
+		// and the async loader. Defaults to Cache/Models next to the executable.
+		ModelCache& GetModelCache() { return m_ModelCache; }
+		ModelCacheStats GetModelCacheStats() const { return m_ModelCache.GetStats(); }
+
 	private:
 		uint32_t m_NextId = 1;
 
@@ -82,6 +90,7 @@ namespace Onyx {
 		std::unordered_map<uint32_t, std::string> m_IdToPath;
 
 		std::unordered_map<std::string, Material> m_Materials;
+		uint32_t m_MaterialsVersion = 0;
 
 		std::unique_ptr<Texture> m_DefaultAlbedo;
 		std::unique_ptr<Texture> m_DefaultNormal;
@@ -126,12 +135,7 @@ namespace Onyx {
 			std::unique_ptr<AnimatedModel> parsedAnimModel;
 			bool isAnimated = false;
 			// Pre-concatenated merged data (populated by background thread, consumed by GPU upload)
-			std::vector<uint8_t> mergedVertexData;
-			std::vector<uint8_t> mergedIndexData;
-			std::vector<MergedMeshInfo> mergedMeshInfos;
-			std::vector<MeshBoundsInfo> meshBounds; // per-mesh bounds computed on background thread
-			uint32_t mergedTotalVertices = 0;
-			uint32_t mergedTotalIndices = 0;
+			MergedMeshData merged;
 		};
 
 		mutable std::mutex m_LoadMutex;
@@ -145,8 +149,16 @@ namespace Onyx {
 		void LoaderThreadFunc();
 
 		template <typename VertexT, typename MeshRange>
-		void MergeMeshesToPending(const MeshRange& meshes, PendingLoad& out,
-								  std::vector<MeshBoundsInfo>* boundsOut);
+		static void MergeMeshes(const MeshRange& meshes, MergedMeshData& out);
+
+		ModelCache m_ModelCache;
+
+		// Cache-first imports; thread-safe (no GL). `sourceHash` is
+		// m_ModelCache.HashSource(path), 0 to bypass the cache.
+		bool ImportStaticModel(const std::string& path, uint64_t sourceHash, MergedMeshData& out);
+		std::unique_ptr<AnimatedModel> ImportAnimatedModel(const std::string& path, uint64_t sourceHash);
+		// Synchronous static load for LoadModel and Reload (main thread)
+		std::unique_ptr<Model> ImportModel(const std::string& path, bool loadTextures);
 
 		// Async texture loading — stbi_load on background thread, glTexImage2D on main thread
 		struct PendingTextureLoad
@@ -0,0 +1,733 @@
+#include "pch.h"
+
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace Onyx {
+
+	namespace {
+
+		// 16 texels of one 4x4 block, RGBA
+		struct Block
+		{
+			uint8_t texels[16][4];
+		};
+
+		void LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, Block& block)
+		{
+			for (uint32_t y = 0; y < 4; y++)
+			{
+				const uint32_t sy = std::min(by * 4 + y, height - 1);
+				for (uint32_t x = 0; x < 4; x++)
+				{
+					const uint32_t sx = std::min(bx * 4 + x, width - 1);
+					std::memcpy(block.texels[y * 4 + x], rgba + (size_t(sy) * width + sx) * 4, 4);
+				}
+			}
+		}
+
+		void StoreBlock(const Block& block, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, uint8_t* rgba)
+		{
+			for (uint32_t y = 0; y < 4 && by * 4 + y < height; y++)
+			{
+				for (uint32_t x = 0; x < 4 && bx * 4 + x < width; x++)
+				{
+					std::memcpy(rgba + (size_t(by * 4 + y) * width + bx * 4 + x) * 4, block.texels[y * 4 + x], 4);
+				}
+			}
+		}
+
+		// ============================================================
+		// ENDPOINT FITTING (shared by BC1 and BC7)
+		// ============================================================
+
+		// Endpoints of the block's principal axis over the first C channels
+		template <int C>
+		void FitEndpoints(const Block& block, float e0[C], float e1[C])
+		{
+			float mean[C] = {};
+			for (const auto& texel : block.texels)
+			{
+				for (int c = 0; c < C; c++)
+				{
+					mean[c] += texel[c];
+				}
+			}
+			for (int c = 0; c < C; c++)
+			{
+				mean[c] /= 16.0f;
+			}
+
+			float cov[C][C] = {};
+			for (const auto& texel : block.texels)
+			{
+				for (int i = 0; i < C; i++)
+				{
+					for (int j = 0; j < C; j++)
+					{
+						cov[i][j] += (texel[i] - mean[i]) * (texel[j] - mean[j]);
+					}
+				}
+			}
+
+			// Power iteration from the all-ones direction
+			float axis[C];
+			std::fill(axis, axis + C, 1.0f);
+			for (int iteration = 0; iteration < 8; iteration++)
+			{
+				float next[C] = {};
+				float largest = 0.0f;
+				for (int i = 0; i < C; i++)
+				{
+					for (int j = 0; j < C; j++)
+					{
+						next[i] += cov[i][j] * axis[j];
+					}
+					largest = std::max(largest, std::abs(next[i]));
+				}
+				if (largest < 1e-6f)
+					break;
+				for (int i = 0; i < C; i++)
+				{
+					axis[i] = next[i] / largest;
+				}
+			}
+
+			float length = 0.0f;
+			for (int c = 0; c < C; c++)
+			{
+				length += axis[c] * axis[c];
+			}
+			length = std::sqrt(length);
+			for (int c = 0; c < C; c++)
+			{
+				axis[c] /= length;
+			}
+
+			float tMin = std::numeric_limits<float>::max();
+			float tMax = std::numeric_limits<float>::lowest();
+			for (const auto& texel : block.texels)
+			{
+				float t = 0.0f;
+				for (int c = 0; c < C; c++)
+				{
+					t += (texel[c] - mean[c]) * axis[c];
+				}
+				tMin = std::min(tMin, t);
+				tMax = std::max(tMax, t);
+			}
+
+			for (int c = 0; c < C; c++)
+			{
+				e0[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+				e1[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+			}
+		}
+
+		// Endpoints minimizing the squared error for fixed per-texel weights
+		// (0 = e0, 1 = e1). False if the weights are degenerate.
+		template <int C>
+		bool RefineEndpoints(const Block& block, const float weights[16], float e0[C], float e1[C])
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[C] = {};
+			float bx[C] = {};
+			for (int i = 0; i < 16; i++)
+			{
+				const float b = weights[i];
+				const float a = 1.0f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (int c = 0; c < C; c++)
+				{
+					ax[c] += a * block.texels[i][c];
+					bx[c] += b * block.texels[i][c];
+				}
+			}
+
+			const float det = aa * bb - ab * ab;
+			if (std::abs(det) < 1e-6f)
+				return false;
+
+			for (int c = 0; c < C; c++)
+			{
+				e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.0f, 255.0f);
+				e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.0f, 255.0f);
+			}
+			return true;
+		}
+
+		// ============================================================
+		// BC1 (colour)
+		// ============================================================
+
+		uint16_t To565(const float color[3])
+		{
+			const int r = std::clamp(static_cast<int>(std::lround(color[0] * 31.0f / 255.0f)), 0, 31);
+			const int g = std::clamp(static_cast<int>(std::lround(color[1] * 63.0f / 255.0f)), 0, 63);
+			const int b = std::clamp(static_cast<int>(std::lround(color[2] * 31.0f / 255.0f)), 0, 31);
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		void From565(uint16_t value, int out[3])
+		{
+			const int r = value >> 11;
+			const int g = (value >> 5) & 63;
+			const int b = value & 31;
+			out[0] = (r << 3) | (r >> 2);
+			out[1] = (g << 2) | (g >> 4);
+			out[2] = (b << 3) | (b >> 2);
+		}
+
+		// BC3's colour block always decodes as four colours
+		void Bc1Palette(uint16_t c0, uint16_t c1, bool alwaysFourColors, int palette[4][3])
+		{
+			From565(c0, palette[0]);
+			From565(c1, palette[1]);
+			for (int c = 0; c < 3; c++)
+			{
+				if (c0 > c1 || alwaysFourColors)
+				{
+					palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+					palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+				}
+				else
+				{
+					palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+					palette[3][c] = 0;
+				}
+			}
+		}
+
+		struct Bc1Candidate
+		{
+			uint16_t c0 = 0;
+			uint16_t c1 = 0;
+			uint8_t indices[16] = {};
+			int error = std::numeric_limits<int>::max();
+		};
+
+		void TryBc1Endpoints(const Block& block, const float e0[3], const float e1[3], Bc1Candidate& best)
+		{
+			Bc1Candidate candidate;
+			candidate.c0 = To565(e0);
+			candidate.c1 = To565(e1);
+			if (candidate.c0 < candidate.c1)
+				std::swap(candidate.c0, candidate.c1);
+
+			// Equal endpoints: every texel takes colour 0 (valid in either mode)
+			int palette[4][3];
+			Bc1Palette(candidate.c0, candidate.c1, true, palette);
+			const int usable = candidate.c0 == candidate.c1 ? 1 : 4;
+
+			candidate.error = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				int bestError = std::numeric_limits<int>::max();
+				for (int p = 0; p < usable; p++)
+				{
+					int error = 0;
+					for (int c = 0; c < 3; c++)
+					{
+						const int d = block.texels[i][c] - palette[p][c];
+						error += d * d;
+					}
+					if (error < bestError)
+					{
+						bestError = error;
+						candidate.indices[i] = static_cast<uint8_t>(p);
+					}
+				}
+				candidate.error += bestError;
+			}
+
+			if (candidate.error < best.error)
+				best = candidate;
+		}
+
+		void EncodeBc1(const Block& block, uint8_t* out)
+		{
+			float e0[3];
+			float e1[3];
+			FitEndpoints<3>(block, e0, e1);
+			Bc1Candidate best;
+			TryBc1Endpoints(block, e0, e1, best);
+
+			static constexpr float INDEX_WEIGHT[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+			float weights[16];
+			for (int i = 0; i < 16; i++)
+			{
+				weights[i] = INDEX_WEIGHT[best.indices[i]];
+			}
+			if (best.error > 0 && RefineEndpoints<3>(block, weights, e0, e1))
+				TryBc1Endpoints(block, e0, e1, best);
+
+			uint32_t bits = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				bits |= uint32_t(best.indices[i]) << (2 * i);
+			}
+			std::memcpy(out, &best.c0, 2);
+			std::memcpy(out + 2, &best.c1, 2);
+			std::memcpy(out + 4, &bits, 4);
+		}
+
+		void DecodeBc1(const uint8_t* in, bool alwaysFourColors, Block& block)
+		{
+			uint16_t c0, c1;
+			uint32_t bits;
+			std::memcpy(&c0, in, 2);
+			std::memcpy(&c1, in + 2, 2);
+			std::memcpy(&bits, in + 4, 4);
+
+			int palette[4][3];
+			Bc1Palette(c0, c1, alwaysFourColors, palette);
+			for (int i = 0; i < 16; i++)
+			{
+				const int index = (bits >> (2 * i)) & 3;
+				for (int c = 0; c < 3; c++)
+				{
+					block.texels[i][c] = static_cast<uint8_t>(palette[index][c]);
+				}
+				block.texels[i][3] = 255;
+			}
+		}
+
+		// ============================================================
+		// BC4 (one channel; BC3 alpha, BC5 = two of these)
+		// ============================================================
+
+		void Bc4Palette(int a0, int a1, int palette[8])
+		{
+			palette[0] = a0;
+			palette[1] = a1;
+			if (a0 > a1)
+			{
+				for (int i = 1; i <= 6; i++)
+				{
+					palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+				}
+			}
+			else
+			{
+				for (int i = 1; i <= 4; i++)
+				{
+					palette[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+				}
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		void EncodeBc4(const Block& block, int channel, uint8_t* out)
+		{
+			int lo = 255;
+			int hi = 0;
+			for (const auto& texel : block.texels)
+			{
+				lo = std::min<int>(lo, texel[channel]);
+				hi = std::max<int>(hi, texel[channel]);
+			}
+
+			// hi > lo selects the 8-value ramp; equal values need index 0 only
+			int palette[8];
+			Bc4Palette(hi, lo, palette);
+			uint64_t bits = 0;
+			if (hi != lo)
+			{
+				for (int i = 0; i < 16; i++)
+				{
+					const int value = block.texels[i][channel];
+					int bestIndex = 0;
+					int bestError = std::numeric_limits<int>::max();
+					for (int p = 0; p < 8; p++)
+					{
+						const int error = std::abs(value - palette[p]);
+						if (error < bestError)
+						{
+							bestError = error;
+							bestIndex = p;
+						}
+					}
+					bits |= uint64_t(bestIndex) << (3 * i);
+				}
+			}
+
+			out[0] = static_cast<uint8_t>(hi);
+			out[1] = static_cast<uint8_t>(lo);
+			for (int k = 0; k < 6; k++)
+			{
+				out[2 + k] = static_cast<uint8_t>(bits >> (8 * k));
+			}
+		}
+
+		void DecodeBc4(const uint8_t* in, int channel, Block& block)
+		{
+			int palette[8];
+			Bc4Palette(in[0], in[1], palette);
+			uint64_t bits = 0;
+			for (int k = 0; k < 6; k++)
+			{
+				bits |= uint64_t(in[2 + k]) << (8 * k);
+			}
+			for (int i = 0; i < 16; i++)
+			{
+				block.texels[i][channel] = static_cast<uint8_t>(palette[(bits >> (3 * i)) & 7]);
+			}
+		}
+
+		// ============================================================
+		// BC7 (mode 6: one subset, RGBA 7.7.7.7 + p-bit endpoints, 4-bit indices)
+		// ============================================================
+
+		constexpr int BC7_WEIGHTS4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		struct BitWriter
+		{
+			uint8_t* out;
+			int position = 0;
+
+			void Write(uint32_t value, int bits)
+			{
+				for (int b = 0; b < bits; b++, position++)
+				{
+					if ((value >> b) & 1)
+						out[position >> 3] |= static_cast<uint8_t>(1 << (position & 7));
+				}
+			}
+		};
+
+		struct BitReader
+		{
+			const uint8_t* in;
+			int position = 0;
+
+			uint32_t Read(int bits)
+			{
+				uint32_t value = 0;
+				for (int b = 0; b < bits; b++, position++)
+				{
+					value |= uint32_t((in[position >> 3] >> (position & 7)) & 1) << b;
+				}
+				return value;
+			}
+		};
+
+		struct Bc7Candidate
+		{
+			int quantized[2][4] = {}; // 7-bit endpoint values
+			int pbits[2] = {};
+			uint8_t indices[16] = {};
+			int error = std::numeric_limits<int>::max();
+		};
+
+		void TryBc7Endpoints(const Block& block, const float e0[4], const float e1[4], Bc7Candidate& best)
+		{
+			for (int p0 = 0; p0 < 2; p0++)
+			{
+				for (int p1 = 0; p1 < 2; p1++)
+				{
+					Bc7Candidate candidate;
+					candidate.pbits[0] = p0;
+					candidate.pbits[1] = p1;
+
+					int endpoint[2][4];
+					for (int c = 0; c < 4; c++)
+					{
+						candidate.quantized[0][c] = std::clamp(static_cast<int>(std::lround((e0[c] - p0) / 2.0f)), 0, 127);
+						candidate.quantized[1][c] = std::clamp(static_cast<int>(std::lround((e1[c] - p1) / 2.0f)), 0, 127);
+						endpoint[0][c] = (candidate.quantized[0][c] << 1) | p0;
+						endpoint[1][c] = (candidate.quantized[1][c] << 1) | p1;
+					}
+
+					int palette[16][4];
+					for (int p = 0; p < 16; p++)
+					{
+						for (int c = 0; c < 4; c++)
+						{
+							palette[p][c] = ((64 - BC7_WEIGHTS4[p]) * endpoint[0][c] + BC7_WEIGHTS4[p] * endpoint[1][c] + 32) >> 6;
+						}
+					}
+
+					candidate.error = 0;
+					for (int i = 0; i < 16 && candidate.error < best.error; i++)
+					{
+						int bestError = std::numeric_limits<int>::max();
+						for (int p = 0; p < 16; p++)
+						{
+							int error = 0;
+							for (int c = 0; c < 4; c++)
+							{
+								const int d = block.texels[i][c] - palette[p][c];
+								error += d * d;
+							}
+							if (error < bestError)
+							{
+								bestError = error;
+								candidate.indices[i] = static_cast<uint8_t>(p);
+							}
+						}
+						candidate.error += bestError;
+					}
+
+					if (candidate.error < best.error)
+						best = candidate;
+				}
+			}
+		}
+
+		void EncodeBc7(const Block& block, uint8_t* out)
+		{
+			float e0[4];
+			float e1[4];
+			FitEndpoints<4>(block, e0, e1);
+			Bc7Candidate best;
+			TryBc7Endpoints(block, e0, e1, best);
+
+			float weights[16];
+			for (int i = 0; i < 16; i++)
+			{
+				weights[i] = BC7_WEIGHTS4[best.indices[i]] / 64.0f;
+			}
+			if (best.error > 0 && RefineEndpoints<4>(block, weights, e0, e1))
+				TryBc7Endpoints(block, e0, e1, best);
+
+			// The first index is stored without its top bit, so it must be < 8
+			if (best.indices[0] & 8)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					std::swap(best.quantized[0][c], best.quantized[1][c]);
+				}
+				std::swap(best.pbits[0], best.pbits[1]);
+				for (auto& index : best.indices)
+				{
+					index = static_cast<uint8_t>(15 - index);
+				}
+			}
+
+			std::memset(out, 0, 16);
+			BitWriter writer{out};
+			writer.Write(1u << 6, 7); // Mode 6
+			for (int c = 0; c < 4; c++)
+			{
+				writer.Write(best.quantized[0][c], 7);
+				writer.Write(best.quantized[1][c], 7);
+			}
+			writer.Write(best.pbits[0], 1);
+			writer.Write(best.pbits[1], 1);
+			writer.Write(best.indices[0], 3);
+			for (int i = 1; i < 16; i++)
+			{
+				writer.Write(best.indices[i], 4);
+			}
+		}
+
+		bool DecodeBc7(const uint8_t* in, Block& block)
+		{
+			if ((in[0] & 0x7F) != 0x40)
+			{
+				for (auto& texel : block.texels)
+				{
+					texel[0] = 255;
+					texel[1] = 0;
+					texel[2] = 255;
+					texel[3] = 255;
+				}
+				return false;
+			}
+
+			BitReader reader{in, 7};
+			int endpoint[2][4];
+			for (int c = 0; c < 4; c++)
+			{
+				endpoint[0][c] = static_cast<int>(reader.Read(7)) << 1;
+				endpoint[1][c] = static_cast<int>(reader.Read(7)) << 1;
+			}
+			const int p0 = static_cast<int>(reader.Read(1));
+			const int p1 = static_cast<int>(reader.Read(1));
+			for (int c = 0; c < 4; c++)
+			{
+				endpoint[0][c] |= p0;
+				endpoint[1][c] |= p1;
+			}
+
+			for (int i = 0; i < 16; i++)
+			{
+				const int weight = BC7_WEIGHTS4[reader.Read(i == 0 ? 3 : 4)];
+				for (int c = 0; c < 4; c++)
+				{
+					block.texels[i][c] =
+						static_cast<uint8_t>(((64 - weight) * endpoint[0][c] + weight * endpoint[1][c] + 32) >> 6);
+				}
+			}
+			return true;
+		}
+
+		// ============================================================
+		// PER-FORMAT DISPATCH
+		// ============================================================
+
+		void EncodeBlock(BlockFormat format, const Block& block, uint8_t* out)
+		{
+			switch (format)
+			{
+			case BlockFormat::BC1:
+				EncodeBc1(block, out);
+				break;
+			case BlockFormat::BC3:
+				EncodeBc4(block, 3, out);
+				EncodeBc1(block, out + 8);
+				break;
+			case BlockFormat::BC4:
+				EncodeBc4(block, 0, out);
+				break;
+			case BlockFormat::BC5:
+				EncodeBc4(block, 0, out);
+				EncodeBc4(block, 1, out + 8);
+				break;
+			case BlockFormat::BC7:
+				EncodeBc7(block, out);
+				break;
+			}
+		}
+
+		bool DecodeBlock(BlockFormat format, const uint8_t* in, Block& block)
+		{
+			switch (format)
+			{
+			case BlockFormat::BC1:
+				DecodeBc1(in, false, block);
+				return true;
+			case BlockFormat::BC3:
+				DecodeBc1(in + 8, true, block);
+				DecodeBc4(in, 3, block);
+				return true;
+			case BlockFormat::BC4:
+			case BlockFormat::BC5:
+				for (auto& texel : block.texels)
+				{
+					texel[1] = 0;
+					texel[2] = 0;
+					texel[3] = 255;
+				}
+				DecodeBc4(in, 0, block);
+				if (format == BlockFormat::BC5)
+					DecodeBc4(in + 8, 1, block);
+				return true;
+			case BlockFormat::BC7:
+				return DecodeBc7(in, block);
+			}
+			return false;
+		}
+
+		// Runs `rowFunc(blockRow)` over every block row, split across threads
+		// for big images (the exporter encodes 2K textures)
+		template <typename RowFunc>
+		void ForEachBlockRow(uint32_t blockRows, uint32_t blocksPerRow, RowFunc rowFunc)
+		{
+			constexpr uint32_t BLOCKS_PER_THREAD = 4096;
+			const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+			const uint32_t threadCount =
+				std::min(hardware, std::max(1u, (blockRows * blocksPerRow) / BLOCKS_PER_THREAD));
+			if (threadCount <= 1)
+			{
+				for (uint32_t row = 0; row < blockRows; row++)
+				{
+					rowFunc(row);
+				}
+				return;
+			}
+
+			std::vector<std::thread> threads;
+			threads.reserve(threadCount);
+			for (uint32_t t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back([&, t] {
+					for (uint32_t row = t; row < blockRows; row += threadCount)
+					{
+						rowFunc(row);
+					}
+				});
+			}
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		}
+
+	} // namespace
+
+	const char* GetBlockFormatName(BlockFormat format)
+	{
+		switch (format)
+		{
+		case BlockFormat::BC1:
+			return "BC1";
+		case BlockFormat::BC3:
+			return "BC3";
+		case BlockFormat::BC4:
+			return "BC4";
+		case BlockFormat::BC5:
+			return "BC5";
+		case BlockFormat::BC7:
+			return "BC7";
+		}
+		return "?";
+	}
+
+	size_t GetBlockBytes(BlockFormat format)
+	{
+		return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8 : 16;
+	}
+
+	size_t GetBlockCompressedSize(BlockFormat format, uint32_t width, uint32_t height)
+	{
+		const size_t blocksX = (std::max(width, 1u) + 3) / 4;
+		const size_t blocksY = (std::max(height, 1u) + 3) / 4;
+		return blocksX * blocksY * GetBlockBytes(format);
+	}
+
+	void CompressBlocks(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out)
+	{
+		const uint32_t blocksX = (width + 3) / 4;
+		const uint32_t blocksY = (height + 3) / 4;
+		const size_t blockBytes = GetBlockBytes(format);
+
+		ForEachBlockRow(blocksY, blocksX, [&](uint32_t by) {
+			Block block;
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				LoadBlock(rgba, width, height, bx, by, block);
+				EncodeBlock(format, block, out + (size_t(by) * blocksX + bx) * blockBytes);
+			}
+		});
+	}
+
+	bool DecompressBlocks(BlockFormat format, const uint8_t* blocks, uint32_t width, uint32_t height, uint8_t* rgba)
+	{
+		const uint32_t blocksX = (width + 3) / 4;
+		const uint32_t blocksY = (height + 3) / 4;
+		const size_t blockBytes = GetBlockBytes(format);
+
+		bool ok = true;
+		Block block;
+		for (uint32_t by = 0; by < blocksY; by++)
+		{
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				ok &= DecodeBlock(format, blocks + (size_t(by) * blocksX + bx) * blockBytes, block);
+				StoreBlock(block, width, height, bx, by, rgba);
+			}
+		}
+		return ok;
+	}
+
+} // namespace Onyx
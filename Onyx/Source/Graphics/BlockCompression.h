@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Onyx {
+
+	// GPU block-compressed formats (4x4 texel blocks). CPU-only: no GL here,
+	// so the exporter and tools can use it without a context.
+	enum class BlockFormat : uint8_t
+	{
+		BC1, // RGB, 8 bytes/block (opaque colour)
+		BC3, // RGBA, 16 bytes/block (BC1 colour + BC4 alpha)
+		BC4, // R, 8 bytes/block (single-channel data)
+		BC5, // RG, 16 bytes/block (tangent-space normals, Z rebuilt in the shader)
+		BC7, // RGBA, 16 bytes/block (encoder: mode 6 only)
+	};
+
+	const char* GetBlockFormatName(BlockFormat format);
+	size_t GetBlockBytes(BlockFormat format);
+	size_t GetBlockCompressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+	// `rgba` is width * height * 4 bytes. Edge blocks of sizes that are not a
+	// multiple of 4 repeat the last row/column.
+	void CompressBlocks(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out);
+
+	// Writes width * height * 4 bytes. BC4 decodes to (r, 0, 0, 255) and BC5
+	// to (r, g, 0, 255), as the GPU samples them. Returns false on BC7 blocks
+	// in modes other than 6 (decoded as magenta); the GPU handles all modes.
+	bool DecompressBlocks(BlockFormat format, const uint8_t* blocks, uint32_t width, uint32_t height, uint8_t* rgba);
+
+} // namespace Onyx
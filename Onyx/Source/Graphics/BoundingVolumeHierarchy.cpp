@@ -0,0 +1,175 @@
+#include "pch.h"
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Onyx {
+
+	void BoundingVolumeHierarchy::Clear()
+	{
+		m_Items.clear();
+		m_Order.clear();
+		m_Nodes.clear();
+		m_ItemCount = 0;
+		m_RefitsSinceBuild = 0;
+		m_Dirty = false;
+	}
+
+	void BoundingVolumeHierarchy::Insert(uint32_t item, const glm::vec3& min, const glm::vec3& max)
+	{
+		if (item >= m_Items.size())
+			m_Items.resize(item + 1);
+
+		ItemBounds& bounds = m_Items[item];
+		if (!bounds.alive)
+			m_ItemCount++;
+		bounds.min = min;
+		bounds.max = max;
+		bounds.leaf = INVALID_INDEX;
+		bounds.alive = true;
+		m_Dirty = true;
+	}
+
+	void BoundingVolumeHierarchy::Update(uint32_t item, const glm::vec3& min, const glm::vec3& max)
+	{
+		if (item >= m_Items.size() || !m_Items[item].alive)
+			return;
+
+		ItemBounds& bounds = m_Items[item];
+		bounds.min = min;
+		bounds.max = max;
+		if (m_Dirty || bounds.leaf == INVALID_INDEX)
+			return;
+
+		// Refitting keeps the tree valid but lets boxes grow and overlap; once
+		// a quarter of the items have moved, a rebuild is cheaper than the
+		// looser culling
+		if (++m_RefitsSinceBuild > std::max(64u, m_ItemCount / 4))
+		{
+			m_Dirty = true;
+			return;
+		}
+		RefitUpwards(bounds.leaf);
+	}
+
+	void BoundingVolumeHierarchy::Remove(uint32_t item)
+	{
+		if (item >= m_Items.size() || !m_Items[item].alive)
+			return;
+
+		m_Items[item].alive = false;
+		m_Items[item].leaf = INVALID_INDEX;
+		m_ItemCount--;
+		m_Dirty = true;
+	}
+
+	void BoundingVolumeHierarchy::Rebuild()
+	{
+		m_Dirty = false;
+		m_RefitsSinceBuild = 0;
+		m_Nodes.clear();
+		m_Order.clear();
+
+		for (uint32_t i = 0; i < m_Items.size(); i++)
+		{
+			if (m_Items[i].alive)
+				m_Order.push_back(i);
+		}
+		if (m_Order.empty())
+			return;
+
+		// A binary tree with MAX_LEAF_ITEMS per leaf needs under 2n / MAX_LEAF_ITEMS nodes
+		m_Nodes.reserve(2 * (m_Order.size() / MAX_LEAF_ITEMS + 1));
+		m_Nodes.emplace_back();
+		BuildNode(0, 0, static_cast<uint32_t>(m_Order.size()), INVALID_INDEX);
+	}
+
+	void BoundingVolumeHierarchy::BuildNode(uint32_t index, uint32_t first, uint32_t count, uint32_t parent)
+	{
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+		glm::vec3 centroidMin(std::numeric_limits<float>::max());
+		glm::vec3 centroidMax(std::numeric_limits<float>::lowest());
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			const ItemBounds& item = m_Items[m_Order[i]];
+			boundsMin = glm::min(boundsMin, item.min);
+			boundsMax = glm::max(boundsMax, item.max);
+			const glm::vec3 centroid = (item.min + item.max) * 0.5f;
+			centroidMin = glm::min(centroidMin, centroid);
+			centroidMax = glm::max(centroidMax, centroid);
+		}
+
+		Node node;
+		node.min = boundsMin;
+		node.max = boundsMax;
+		node.first = first;
+		node.count = count;
+		node.parent = parent;
+
+		if (count <= MAX_LEAF_ITEMS)
+		{
+			for (uint32_t i = first; i < first + count; i++)
+			{
+				m_Items[m_Order[i]].leaf = index;
+			}
+			m_Nodes[index] = node;
+			return;
+		}
+
+		// Median split on the widest centroid axis: balanced, and cheap enough
+		// to redo whenever instances are added or removed
+		const glm::vec3 extent = centroidMax - centroidMin;
+		int axis = 0;
+		if (extent.y > extent[axis])
+			axis = 1;
+		if (extent.z > extent[axis])
+			axis = 2;
+
+		const uint32_t half = count / 2;
+		auto begin = m_Order.begin() + first;
+		std::nth_element(begin, begin + half, begin + count, [this, axis](uint32_t a, uint32_t b) {
+			return m_Items[a].min[axis] + m_Items[a].max[axis] < m_Items[b].min[axis] + m_Items[b].max[axis];
+		});
+
+		// Children are allocated as a pair so the right one is always left + 1
+		node.left = static_cast<uint32_t>(m_Nodes.size());
+		m_Nodes.emplace_back();
+		m_Nodes.emplace_back();
+		m_Nodes[index] = node;
+
+		BuildNode(node.left, first, half, index);
+		BuildNode(node.left + 1, first + half, count - half, index);
+	}
+
+	void BoundingVolumeHierarchy::RefitUpwards(uint32_t nodeIndex)
+	{
+		// Leaf: from its items
+		{
+			Node& leaf = m_Nodes[nodeIndex];
+			glm::vec3 boundsMin(std::numeric_limits<float>::max());
+			glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+			for (uint32_t i = leaf.first; i < leaf.first + leaf.count; i++)
+			{
+				const ItemBounds& item = m_Items[m_Order[i]];
+				boundsMin = glm::min(boundsMin, item.min);
+				boundsMax = glm::max(boundsMax, item.max);
+			}
+			leaf.min = boundsMin;
+			leaf.max = boundsMax;
+		}
+
+		// Ancestors: from their two children
+		for (uint32_t parent = m_Nodes[nodeIndex].parent; parent != INVALID_INDEX; parent = m_Nodes[parent].parent)
+		{
+			Node& node = m_Nodes[parent];
+			const Node& left = m_Nodes[node.left];
+			const Node& right = m_Nodes[node.left + 1];
+			node.min = glm::min(left.min, right.min);
+			node.max = glm::max(left.max, right.max);
+		}
+	}
+
+} // namespace Onyx
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Frustum.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Onyx {
+
+	// ============================================================
+	// BOUNDING VOLUME HIERARCHY
+	// ============================================================
+	//
+	// AABB tree over caller-numbered items (e.g. SceneRenderer's static
+	// instance slots). Inserting or removing items marks the tree for a
+	// rebuild on the next query; moving an item only refits its leaf and
+	// ancestors, until enough has moved that a rebuild pays for itself.
+	// Every node covers a contiguous run of the item order, so a node fully
+	// inside the frustum emits its items without testing them.
+
+	class BoundingVolumeHierarchy
+	{
+	public:
+		void Clear();
+
+		void Insert(uint32_t item, const glm::vec3& min, const glm::vec3& max);
+		void Update(uint32_t item, const glm::vec3& min, const glm::vec3& max);
+		void Remove(uint32_t item);
+
+		// Queries rebuild first when needed; call this to pay that up front
+		void Rebuild();
+
+		// Calls visit(item) for every item whose box touches the frustum
+		template <typename Visit>
+		void Query(const Frustum& frustum, Visit&& visit);
+
+		uint32_t GetItemCount() const { return m_ItemCount; }
+		uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_Nodes.size()); }
+
+		// Nodes tested by the last Query, for stats
+		uint32_t GetLastNodesVisited() const { return m_LastNodesVisited; }
+
+	private:
+		static constexpr uint32_t MAX_LEAF_ITEMS = 4;
+		static constexpr uint32_t INVALID_INDEX = ~0u;
+
+		struct Node
+		{
+			glm::vec3 min;
+			uint32_t first; // Into m_Order
+			glm::vec3 max;
+			uint32_t count;
+			uint32_t left = INVALID_INDEX; // Right child is left + 1; INVALID_INDEX = leaf
+			uint32_t parent = INVALID_INDEX;
+		};
+
+		struct ItemBounds
+		{
+			glm::vec3 min;
+			glm::vec3 max;
+			uint32_t leaf = INVALID_INDEX;
+			bool alive = false;
+		};
+
+		void BuildNode(uint32_t index, uint32_t first, uint32_t count, uint32_t parent);
+		void RefitUpwards(uint32_t node);
+
+		std::vector<ItemBounds> m_Items; // Indexed by item id
+		std::vector<uint32_t> m_Order;	 // Item ids, grouped by node
+		std::vector<Node> m_Nodes;
+		std::vector<uint32_t> m_Stack;
+		uint32_t m_ItemCount = 0;
+		uint32_t m_RefitsSinceBuild = 0;
+		uint32_t m_LastNodesVisited = 0;
+		bool m_Dirty = false;
+	};
+
+	template <typename Visit>
+	void BoundingVolumeHierarchy::Query(const Frustum& frustum, Visit&& visit)
+	{
+		if (m_Dirty)
+			Rebuild();
+
+		m_LastNodesVisited = 0;
+		if (m_Nodes.empty())
+			return;
+
+		m_Stack.clear();
+		m_Stack.push_back(0);
+		while (!m_Stack.empty())
+		{
+			const Node& node = m_Nodes[m_Stack.back()];
+			m_Stack.pop_back();
+			m_LastNodesVisited++;
+
+			const FrustumTest test = frustum.ClassifyBox(node.min, node.max);
+			if (test == FrustumTest::Outside)
+				continue;
+
+			if (test == FrustumTest::Inside)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+				{
+					visit(m_Order[i]);
+				}
+				continue;
+			}
+
+			if (node.left == INVALID_INDEX)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+				{
+					const ItemBounds& item = m_Items[m_Order[i]];
+					if (frustum.IsBoxVisible(item.min, item.max))
+						visit(m_Order[i]);
+				}
+				continue;
+			}
+
+			m_Stack.push_back(node.left + 1);
+			m_Stack.push_back(node.left);
+		}
+	}
+
+} // namespace Onyx
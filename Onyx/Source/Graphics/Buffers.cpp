@@ -345,4 +345,111 @@ namespace Onyx {
 		}
 	}
 
-} // namespace Onyx
\ No newline at end of file
+	PersistentRingBuffer::PersistentRingBuffer(size_t regionSizeBytes)
+		: m_RegionSize(regionSizeBytes)
+	{
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		const GLsizeiptr size = static_cast<GLsizeiptr>(m_RegionSize * REGION_COUNT);
+
+		// The window asks for a 4.3 context, so buffer storage is optional
+		if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage)
+		{
+			glGenBuffers(1, &m_BufferID);
+			glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+			glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+			m_Mapped = static_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			if (m_Mapped)
+				return;
+
+			// Immutable storage cannot be respecified for the fallback
+			glDeleteBuffers(1, &m_BufferID);
+			m_BufferID = 0;
+		}
+
+		m_Staging.resize(static_cast<size_t>(size));
+		m_Mapped = m_Staging.data();
+
+		glGenBuffers(1, &m_BufferID);
+		glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	PersistentRingBuffer::~PersistentRingBuffer()
+	{
+		for (void* fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync(static_cast<GLsync>(fence));
+		}
+		// Deleting the buffer unmaps it; the GL keeps it alive for draws in flight
+		glDeleteBuffers(1, &m_BufferID);
+	}
+
+	void PersistentRingBuffer::Bind() const
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+	}
+
+	void PersistentRingBuffer::UnBind() const
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void* PersistentRingBuffer::Allocate(size_t sizeBytes, size_t& outOffset)
+	{
+		if (m_RegionUsed + sizeBytes > m_RegionSize)
+			return nullptr;
+
+		outOffset = GetRegionStart() + m_RegionUsed;
+		m_RegionUsed += sizeBytes;
+		return m_Mapped + outOffset;
+	}
+
+	void PersistentRingBuffer::CommitWrites()
+	{
+		if (IsPersistent() || m_RegionCommitted == m_RegionUsed)
+			return;
+
+		const size_t offset = GetRegionStart() + m_RegionCommitted;
+		glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+		glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset),
+						static_cast<GLsizeiptr>(m_RegionUsed - m_RegionCommitted), m_Mapped + offset);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		m_RegionCommitted = m_RegionUsed;
+	}
+
+	void PersistentRingBuffer::NextRegion()
+	{
+		if (!IsPersistent())
+		{
+			// Orphan: draws still in flight keep the old storage
+			m_Region = (m_Region + 1) % REGION_COUNT;
+			m_RegionUsed = 0;
+			m_RegionCommitted = 0;
+			glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+			glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_Staging.size()), nullptr, GL_STREAM_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			return;
+		}
+
+		if (m_Fences[m_Region])
+			glDeleteSync(static_cast<GLsync>(m_Fences[m_Region]));
+		m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_Region = (m_Region + 1) % REGION_COUNT;
+		m_RegionUsed = 0;
+
+		if (GLsync fence = static_cast<GLsync>(m_Fences[m_Region]))
+		{
+			// Normally long signaled: the GPU is REGION_COUNT - 1 regions behind
+			GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			while (result == GL_TIMEOUT_EXPIRED)
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+			glDeleteSync(fence);
+			m_Fences[m_Region] = nullptr;
+		}
+	}
+
+} // namespace Onyx
@@ -126,4 +126,53 @@ namespace Onyx {
 		size_t m_AllocatedSize = 0;
 	};
 
+	// GL_ARRAY_BUFFER for data written once per draw: immutable storage mapped
+	// persistent + coherent for its whole life, split into REGION_COUNT
+	// regions. Writes append inside the current region and never touch bytes
+	// the GPU may still read; NextRegion() fences the full region and only
+	// waits if the GPU is still reading the one it moves to.
+	//
+	// Without GL 4.4 / ARB_buffer_storage, or if the persistent map fails,
+	// writes go to a CPU copy instead: CommitWrites() uploads them with
+	// glBufferSubData and NextRegion() orphans the buffer with glBufferData.
+	class PersistentRingBuffer
+	{
+	public:
+		static constexpr uint32_t REGION_COUNT = 3;
+
+		explicit PersistentRingBuffer(size_t regionSizeBytes);
+		~PersistentRingBuffer();
+
+		PersistentRingBuffer(const PersistentRingBuffer&) = delete;
+		PersistentRingBuffer& operator=(const PersistentRingBuffer&) = delete;
+
+		void Bind() const;
+		void UnBind() const;
+
+		// Reserves sizeBytes in the current region and returns where to write
+		// them, with outOffset their byte offset in the buffer. Returns nullptr
+		// when the region is too full; draw what was written, then NextRegion().
+		void* Allocate(size_t sizeBytes, size_t& outOffset);
+
+		// Makes everything allocated so far visible to draws. Free when mapped
+		void CommitWrites();
+
+		void NextRegion();
+
+		size_t GetRegionSize() const { return m_RegionSize; }
+		size_t GetRegionStart() const { return m_Region * m_RegionSize; }
+		uint32_t GetBufferID() const { return m_BufferID; }
+		bool IsPersistent() const { return m_Staging.empty(); }
+
+	private:
+		uint32_t m_BufferID = 0;
+		uint8_t* m_Mapped = nullptr;   // The mapping, or m_Staging's data
+		std::vector<uint8_t> m_Staging; // Fallback only
+		size_t m_RegionSize = 0;
+		uint32_t m_Region = 0;
+		size_t m_RegionUsed = 0;
+		size_t m_RegionCommitted = 0; // Fallback only: bytes of the region already uploaded
+		void* m_Fences[REGION_COUNT] = {}; // GLsync per region, null once waited on
+	};
+
 } // namespace Onyx
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "pch.h"
+
+#include "DdsFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Onyx {
+
+	namespace {
+
+		constexpr uint32_t DDS_MAGIC = 0x20534444; // "DDS "
+
+		constexpr uint32_t DDSD_CAPS = 0x1;
+		constexpr uint32_t DDSD_HEIGHT = 0x2;
+		constexpr uint32_t DDSD_WIDTH = 0x4;
+		constexpr uint32_t DDSD_PIXELFORMAT = 0x1000;
+		constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+		constexpr uint32_t DDSD_LINEARSIZE = 0x80000;
+		constexpr uint32_t DDPF_FOURCC = 0x4;
+		constexpr uint32_t DDSCAPS_COMPLEX = 0x8;
+		constexpr uint32_t DDSCAPS_TEXTURE = 0x1000;
+		constexpr uint32_t DDSCAPS_MIPMAP = 0x400000;
+		constexpr uint32_t DX10_DIMENSION_TEXTURE2D = 3;
+
+		constexpr uint32_t FourCC(char a, char b, char c, char d)
+		{
+			return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) |
+				   (uint32_t(uint8_t(d)) << 24);
+		}
+
+		struct DdsPixelFormat
+		{
+			uint32_t size = sizeof(DdsPixelFormat);
+			uint32_t flags = 0;
+			uint32_t fourCC = 0;
+			uint32_t rgbBitCount = 0;
+			uint32_t masks[4] = {};
+		};
+
+		struct DdsHeader
+		{
+			uint32_t size = sizeof(DdsHeader);
+			uint32_t flags = 0;
+			uint32_t height = 0;
+			uint32_t width = 0;
+			uint32_t pitchOrLinearSize = 0;
+			uint32_t depth = 0;
+			uint32_t mipMapCount = 0;
+			uint32_t reserved1[11] = {};
+			DdsPixelFormat pixelFormat;
+			uint32_t caps = 0;
+			uint32_t caps2 = 0;
+			uint32_t caps3 = 0;
+			uint32_t caps4 = 0;
+			uint32_t reserved2 = 0;
+		};
+		static_assert(sizeof(DdsHeader) == 124, "DDS_HEADER is 124 bytes");
+
+		struct DdsHeaderDx10
+		{
+			uint32_t dxgiFormat = 0;
+			uint32_t resourceDimension = DX10_DIMENSION_TEXTURE2D;
+			uint32_t miscFlag = 0;
+			uint32_t arraySize = 1;
+			uint32_t miscFlags2 = 0;
+		};
+		static_assert(sizeof(DdsHeaderDx10) == 20, "DDS_HEADER_DXT10 is 20 bytes");
+
+		uint32_t ToDxgi(BlockFormat format)
+		{
+			switch (format)
+			{
+			case BlockFormat::BC1:
+				return 71; // DXGI_FORMAT_BC1_UNORM
+			case BlockFormat::BC3:
+				return 77;
+			case BlockFormat::BC4:
+				return 80;
+			case BlockFormat::BC5:
+				return 83;
+			case BlockFormat::BC7:
+				return 98;
+			}
+			return 0;
+		}
+
+		// _SRGB variants map to the same blocks; Onyx textures are not sRGB
+		bool FromDxgi(uint32_t dxgi, BlockFormat& out)
+		{
+			switch (dxgi)
+			{
+			case 70: // BC1_TYPELESS
+			case 71:
+			case 72:
+				out = BlockFormat::BC1;
+				return true;
+			case 76:
+			case 77:
+			case 78:
+				out = BlockFormat::BC3;
+				return true;
+			case 79:
+			case 80:
+				out = BlockFormat::BC4;
+				return true;
+			case 82:
+			case 83:
+				out = BlockFormat::BC5;
+				return true;
+			case 97:
+			case 98:
+			case 99:
+				out = BlockFormat::BC7;
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool FromFourCC(uint32_t fourCC, BlockFormat& out)
+		{
+			if (fourCC == FourCC('D', 'X', 'T', '1'))
+				out = BlockFormat::BC1;
+			else if (fourCC == FourCC('D', 'X', 'T', '5'))
+				out = BlockFormat::BC3;
+			else if (fourCC == FourCC('A', 'T', 'I', '1') || fourCC == FourCC('B', 'C', '4', 'U'))
+				out = BlockFormat::BC4;
+			else if (fourCC == FourCC('A', 'T', 'I', '2') || fourCC == FourCC('B', 'C', '5', 'U'))
+				out = BlockFormat::BC5;
+			else
+				return false;
+			return true;
+		}
+
+		bool Fail(std::string* error, const char* message)
+		{
+			if (error)
+				*error = message;
+			return false;
+		}
+
+		// 2x2 box filter; odd edges reuse their last texel
+		std::vector<uint8_t> Downsample(const std::vector<uint8_t>& src, uint32_t width, uint32_t height)
+		{
+			const uint32_t w = std::max(1u, width / 2);
+			const uint32_t h = std::max(1u, height / 2);
+			std::vector<uint8_t> dst(size_t(w) * h * 4);
+			for (uint32_t y = 0; y < h; y++)
+			{
+				const uint32_t y0 = std::min(y * 2, height - 1);
+				const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+				for (uint32_t x = 0; x < w; x++)
+				{
+					const uint32_t x0 = std::min(x * 2, width - 1);
+					const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+					for (uint32_t c = 0; c < 4; c++)
+					{
+						const uint32_t sum = src[(size_t(y0) * width + x0) * 4 + c] + src[(size_t(y0) * width + x1) * 4 + c] +
+											 src[(size_t(y1) * width + x0) * 4 + c] + src[(size_t(y1) * width + x1) * 4 + c];
+						dst[(size_t(y) * w + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+					}
+				}
+			}
+			return dst;
+		}
+
+	} // namespace
+
+	bool ParseDds(const uint8_t* data, size_t size, DdsImage& out, std::string* error)
+	{
+		uint32_t magic = 0;
+		DdsHeader header;
+		if (size < sizeof(magic) + sizeof(header))
+			return Fail(error, "truncated DDS header");
+		std::memcpy(&magic, data, sizeof(magic));
+		std::memcpy(&header, data + sizeof(magic), sizeof(header));
+		if (magic != DDS_MAGIC || header.size != sizeof(DdsHeader))
+			return Fail(error, "not a DDS file");
+		if (!(header.pixelFormat.flags & DDPF_FOURCC))
+			return Fail(error, "uncompressed DDS is not supported");
+
+		size_t offset = sizeof(magic) + sizeof(header);
+		BlockFormat format;
+		if (header.pixelFormat.fourCC == FourCC('D', 'X', '1', '0'))
+		{
+			DdsHeaderDx10 dx10;
+			if (size < offset + sizeof(dx10))
+				return Fail(error, "truncated DX10 header");
+			std::memcpy(&dx10, data + offset, sizeof(dx10));
+			offset += sizeof(dx10);
+			if (dx10.resourceDimension != DX10_DIMENSION_TEXTURE2D || dx10.arraySize != 1)
+				return Fail(error, "only single 2D DDS textures are supported");
+			if (!FromDxgi(dx10.dxgiFormat, format))
+				return Fail(error, "unsupported DXGI format");
+		}
+		else if (!FromFourCC(header.pixelFormat.fourCC, format))
+		{
+			return Fail(error, "unsupported DDS FourCC");
+		}
+
+		if (header.width == 0 || header.height == 0)
+			return Fail(error, "empty DDS image");
+
+		const uint32_t levelCount = std::max(1u, header.mipMapCount);
+		out.format = format;
+		out.width = header.width;
+		out.height = header.height;
+		out.levels.clear();
+		uint32_t width = header.width;
+		uint32_t height = header.height;
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			const size_t levelSize = GetBlockCompressedSize(format, width, height);
+			if (size - offset < levelSize)
+				return Fail(error, "truncated DDS mip data");
+			out.levels.push_back({data + offset, levelSize, width, height});
+			offset += levelSize;
+			if (width == 1 && height == 1)
+				break;
+			width = std::max(1u, width / 2);
+			height = std::max(1u, height / 2);
+		}
+		return true;
+	}
+
+	std::vector<uint8_t> EncodeDds(const uint8_t* rgba, uint32_t width, uint32_t height, BlockFormat format,
+								   bool generateMips)
+	{
+		uint32_t levelCount = 1;
+		if (generateMips)
+		{
+			for (uint32_t w = width, h = height; w > 1 || h > 1; w = std::max(1u, w / 2), h = std::max(1u, h / 2))
+			{
+				levelCount++;
+			}
+		}
+
+		DdsHeader header;
+		header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE |
+					   (levelCount > 1 ? DDSD_MIPMAPCOUNT : 0);
+		header.width = width;
+		header.height = height;
+		header.pitchOrLinearSize = static_cast<uint32_t>(GetBlockCompressedSize(format, width, height));
+		header.mipMapCount = levelCount;
+		header.pixelFormat.flags = DDPF_FOURCC;
+		header.pixelFormat.fourCC = FourCC('D', 'X', '1', '0');
+		header.caps = DDSCAPS_TEXTURE | (levelCount > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+		DdsHeaderDx10 dx10;
+		dx10.dxgiFormat = ToDxgi(format);
+
+		size_t totalSize = sizeof(DDS_MAGIC) + sizeof(header) + sizeof(dx10);
+		for (uint32_t level = 0, w = width, h = height; level < levelCount;
+			 level++, w = std::max(1u, w / 2), h = std::max(1u, h / 2))
+		{
+			totalSize += GetBlockCompressedSize(format, w, h);
+		}
+
+		std::vector<uint8_t> file(totalSize);
+		size_t offset = 0;
+		std::memcpy(file.data(), &DDS_MAGIC, sizeof(DDS_MAGIC));
+		offset += sizeof(DDS_MAGIC);
+		std::memcpy(file.data() + offset, &header, sizeof(header));
+		offset += sizeof(header);
+		std::memcpy(file.data() + offset, &dx10, sizeof(dx10));
+		offset += sizeof(dx10);
+
+		std::vector<uint8_t> level(rgba, rgba + size_t(width) * height * 4);
+		uint32_t w = width;
+		uint32_t h = height;
+		for (uint32_t i = 0; i < levelCount; i++)
+		{
+			CompressBlocks(format, level.data(), w, h, file.data() + offset);
+			offset += GetBlockCompressedSize(format, w, h);
+			if (i + 1 < levelCount)
+			{
+				level = Downsample(level, w, h);
+				w = std::max(1u, w / 2);
+				h = std::max(1u, h / 2);
+			}
+		}
+		return file;
+	}
+
+	BlockFormat ChooseBlockFormat(TextureUsage usage, const uint8_t* rgba, size_t texelCount)
+	{
+		switch (usage)
+		{
+		case TextureUsage::Normal:
+			return BlockFormat::BC5;
+		case TextureUsage::Data:
+			return BlockFormat::BC7;
+		case TextureUsage::Color:
+			break;
+		}
+
+		// BC3 rather than BC7 for alpha: the mode-6-only BC7 encoder loses to
+		// BC3's separate alpha block on colour and is ~10x slower
+		for (size_t i = 0; i < texelCount; i++)
+		{
+			if (rgba[i * 4 + 3] != 255)
+				return BlockFormat::BC3;
+		}
+		return BlockFormat::BC1;
+	}
+
+} // namespace Onyx
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "BlockCompression.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Onyx {
+
+	// ============================================================
+	// DDS CONTAINER (block-compressed textures with their mip chain)
+	// ============================================================
+	//
+	// Written with the DX10 extension header; legacy DXT1/DXT5/ATI1/ATI2/
+	// BC4U/BC5U FourCCs are read too. Rows are in GL order (first row = the
+	// bottom of the image), the same orientation Texture's stb path produces
+	// by flipping on load, so the blocks upload without any rework.
+
+	// Views into the file bytes; valid as long as those bytes are
+	struct DdsImage
+	{
+		struct Level
+		{
+			const uint8_t* data = nullptr;
+			size_t size = 0;
+			uint32_t width = 0;
+			uint32_t height = 0;
+		};
+
+		BlockFormat format = BlockFormat::BC1;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<Level> levels; // levels[0] = full size
+
+		bool Valid() const { return !levels.empty(); }
+	};
+
+	bool ParseDds(const uint8_t* data, size_t size, DdsImage& out, std::string* error = nullptr);
+
+	// Compresses `rgba` (width * height * 4, GL row order) and, with
+	// `generateMips`, a box-filtered chain down to 1x1. Returns the file bytes.
+	std::vector<uint8_t> EncodeDds(const uint8_t* rgba, uint32_t width, uint32_t height, BlockFormat format,
+								   bool generateMips = true);
+
+	// What a texture holds decides its format
+	enum class TextureUsage : uint8_t
+	{
+		Color,	// Albedo: BC1, or BC3 when any texel is translucent
+		Normal, // Tangent-space normal map: BC5 (X, Y)
+		Data,	// Packed masks such as RMA: BC7
+	};
+
+	BlockFormat ChooseBlockFormat(TextureUsage usage, const uint8_t* rgba, size_t texelCount);
+
+} // namespace Onyx
@@ -114,4 +114,27 @@ namespace Onyx {
 		return true;
 	}
 
+	FrustumTest Frustum::ClassifyBox(const glm::vec3& min, const glm::vec3& max) const
+	{
+		FrustumTest result = FrustumTest::Inside;
+		for (int i = 0; i < Count; i++)
+		{
+			const glm::vec4& plane = m_Planes[i];
+			glm::vec3 positive;
+			glm::vec3 negative;
+			positive.x = (plane.x >= 0.0f) ? max.x : min.x;
+			positive.y = (plane.y >= 0.0f) ? max.y : min.y;
+			positive.z = (plane.z >= 0.0f) ? max.z : min.z;
+			negative.x = (plane.x >= 0.0f) ? min.x : max.x;
+			negative.y = (plane.y >= 0.0f) ? min.y : max.y;
+			negative.z = (plane.z >= 0.0f) ? min.z : max.z;
+
+			if (DistanceToPlane(plane, positive) < 0.0f)
+				return FrustumTest::Outside;
+			if (DistanceToPlane(plane, negative) < 0.0f)
+				result = FrustumTest::Intersects;
+		}
+		return result;
+	}
+
 } // namespace Onyx
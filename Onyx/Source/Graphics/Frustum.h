@@ -4,6 +4,13 @@
 
 namespace Onyx {
 
+	enum class FrustumTest
+	{
+		Outside,
+		Intersects,
+		Inside
+	};
+
 	class Frustum
 	{
 	public:
@@ -11,6 +18,9 @@ namespace Onyx {
 		bool IsPointVisible(const glm::vec3& point) const;
 		bool IsSphereVisible(const glm::vec3& center, float radius) const;
 		bool IsBoxVisible(const glm::vec3& min, const glm::vec3& max) const;
+		// Inside = the whole box is in front of every plane, so nothing
+		// contained in it needs testing again
+		FrustumTest ClassifyBox(const glm::vec3& min, const glm::vec3& max) const;
 
 	private:
 		enum Planes
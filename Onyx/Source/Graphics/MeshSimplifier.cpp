@@ -0,0 +1,383 @@
+#include "pch.h"
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace Onyx {
+
+	// ============================================================
+	// MESH LODS
+	// ============================================================
+
+	float GetLodErrorScale(const glm::mat4& projection, float distance, float worldScale)
+	{
+		// projection[1][1] = cot(fovY / 2) for perspective, 2 / height for ortho
+		const bool orthographic = projection[2][3] == 0.0f;
+		if (orthographic)
+			return projection[1][1] * worldScale;
+		return projection[1][1] * worldScale / std::max(distance, 1e-3f);
+	}
+
+	uint32_t SelectLod(const MeshLod* lods, uint32_t lodCount, float errorScale, float threshold)
+	{
+		for (uint32_t i = lodCount; i-- > 1;)
+		{
+			if (lods[i].error * errorScale <= threshold)
+				return i;
+		}
+		return 0;
+	}
+
+	// ============================================================
+	// SIMPLIFIER
+	// ============================================================
+
+	namespace {
+
+		// Symmetric 4x4 plane quadric: sum of w * (n.p + d)^2, plus the summed
+		// weight so Evaluate returns a mean squared distance
+		struct Quadric
+		{
+			double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+			double b0 = 0, b1 = 0, b2 = 0, c = 0;
+			double weight = 0;
+
+			void AddPlane(const glm::dvec3& n, double d, double w)
+			{
+				a00 += w * n.x * n.x;
+				a01 += w * n.x * n.y;
+				a02 += w * n.x * n.z;
+				a11 += w * n.y * n.y;
+				a12 += w * n.y * n.z;
+				a22 += w * n.z * n.z;
+				b0 += w * n.x * d;
+				b1 += w * n.y * d;
+				b2 += w * n.z * d;
+				c += w * d * d;
+				weight += w;
+			}
+
+			void Add(const Quadric& q)
+			{
+				a00 += q.a00;
+				a01 += q.a01;
+				a02 += q.a02;
+				a11 += q.a11;
+				a12 += q.a12;
+				a22 += q.a22;
+				b0 += q.b0;
+				b1 += q.b1;
+				b2 += q.b2;
+				c += q.c;
+				weight += q.weight;
+			}
+
+			double Evaluate(const glm::dvec3& p) const
+			{
+				const double value = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z +
+									 2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z) +
+									 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+				return weight > 0.0 ? std::max(value, 0.0) / weight : 0.0;
+			}
+		};
+
+		struct Collapse
+		{
+			uint32_t from; // Vertex (wedge) that moves
+			uint32_t to;
+			double cost;
+		};
+
+		struct PositionKey
+		{
+			uint32_t bits[3];
+			bool operator==(const PositionKey& other) const { return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+		};
+
+		struct PositionKeyHash
+		{
+			size_t operator()(const PositionKey& key) const
+			{
+				return (size_t(key.bits[0]) * 73856093u) ^ (size_t(key.bits[1]) * 19349663u) ^
+					   (size_t(key.bits[2]) * 83492791u);
+			}
+		};
+
+		uint64_t EdgeKey(uint32_t a, uint32_t b)
+		{
+			return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+		}
+
+		glm::dvec3 TriangleNormal(const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c)
+		{
+			return glm::cross(b - a, c - a);
+		}
+
+	} // namespace
+
+	SimplifyResult SimplifyMesh(const uint8_t* vertices, size_t vertexCount, size_t stride, const uint32_t* indices,
+								size_t indexCount, size_t targetIndexCount, float maxError)
+	{
+		SimplifyResult result;
+		result.indices.assign(indices, indices + indexCount);
+		if (indexCount < 3 || vertexCount == 0)
+			return result;
+
+		// Weld by position: UV/normal seams split one position into several
+		// vertices, and the topology has to see through that
+		std::vector<glm::dvec3> positions;
+		std::vector<uint32_t> positionOf(vertexCount);
+		std::vector<uint32_t> vertexCountAt;
+		{
+			std::unordered_map<PositionKey, uint32_t, PositionKeyHash> welded;
+			welded.reserve(vertexCount);
+			for (size_t v = 0; v < vertexCount; v++)
+			{
+				float p[3];
+				std::memcpy(p, vertices + v * stride, sizeof(p));
+				PositionKey key;
+				std::memcpy(key.bits, p, sizeof(p));
+				auto [it, inserted] = welded.try_emplace(key, static_cast<uint32_t>(positions.size()));
+				if (inserted)
+				{
+					positions.emplace_back(p[0], p[1], p[2]);
+					vertexCountAt.push_back(0);
+				}
+				positionOf[v] = it->second;
+				vertexCountAt[it->second]++;
+			}
+		}
+		const size_t positionCount = positions.size();
+
+		// Lock seams, open borders and non-manifold edges
+		std::vector<uint8_t> locked(positionCount, 0);
+		{
+			std::unordered_map<uint64_t, uint32_t> edgeUses;
+			edgeUses.reserve(indexCount);
+			for (size_t i = 0; i < indexCount; i += 3)
+			{
+				for (int e = 0; e < 3; e++)
+				{
+					const uint32_t a = positionOf[indices[i + e]];
+					const uint32_t b = positionOf[indices[i + (e + 1) % 3]];
+					if (a != b)
+						edgeUses[EdgeKey(a, b)]++;
+				}
+			}
+			for (const auto& [key, uses] : edgeUses)
+			{
+				if (uses != 2)
+				{
+					locked[key >> 32] = 1;
+					locked[key & 0xFFFFFFFFu] = 1;
+				}
+			}
+			for (size_t p = 0; p < positionCount; p++)
+			{
+				if (vertexCountAt[p] > 1)
+					locked[p] = 1;
+			}
+		}
+
+		// Area-weighted plane quadrics
+		std::vector<Quadric> quadrics(positionCount);
+		for (size_t i = 0; i < indexCount; i += 3)
+		{
+			const uint32_t p0 = positionOf[indices[i]];
+			const uint32_t p1 = positionOf[indices[i + 1]];
+			const uint32_t p2 = positionOf[indices[i + 2]];
+			glm::dvec3 n = TriangleNormal(positions[p0], positions[p1], positions[p2]);
+			const double doubleArea = glm::length(n);
+			if (doubleArea <= 0.0)
+				continue;
+			n /= doubleArea;
+			const double d = -glm::dot(n, positions[p0]);
+			const double w = doubleArea * 0.5;
+			quadrics[p0].AddPlane(n, d, w);
+			quadrics[p1].AddPlane(n, d, w);
+			quadrics[p2].AddPlane(n, d, w);
+		}
+
+		const double maxCost = double(maxError) * double(maxError);
+		double worstCost = 0.0;
+		std::vector<uint32_t>& current = result.indices;
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<uint8_t> touched(positionCount);
+		std::vector<uint32_t> adjacencyStart(positionCount + 1);
+		std::vector<uint32_t> adjacency;
+		std::vector<Collapse> collapses;
+
+		while (current.size() > targetIndexCount)
+		{
+			const size_t triangleCount = current.size() / 3;
+
+			// Triangles around each position (CSR)
+			std::fill(adjacencyStart.begin(), adjacencyStart.end(), 0);
+			for (uint32_t index : current)
+			{
+				adjacencyStart[positionOf[index] + 1]++;
+			}
+			for (size_t p = 0; p < positionCount; p++)
+			{
+				adjacencyStart[p + 1] += adjacencyStart[p];
+			}
+			adjacency.resize(current.size());
+			{
+				std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+				for (size_t i = 0; i < current.size(); i++)
+				{
+					adjacency[fill[positionOf[current[i]]]++] = static_cast<uint32_t>(i / 3);
+				}
+			}
+
+			// Every edge, in each direction its start vertex may move
+			collapses.clear();
+			for (size_t i = 0; i < current.size(); i += 3)
+			{
+				for (int e = 0; e < 3; e++)
+				{
+					const uint32_t from = current[i + e];
+					const uint32_t to = current[i + (e + 1) % 3];
+					const uint32_t pf = positionOf[from];
+					const uint32_t pt = positionOf[to];
+					if (locked[pf] || pf == pt)
+						continue;
+					Quadric merged = quadrics[pf];
+					merged.Add(quadrics[pt]);
+					collapses.push_back({from, to, merged.Evaluate(positions[pt])});
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(),
+					  [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+			for (size_t v = 0; v < vertexCount; v++)
+			{
+				remap[v] = static_cast<uint32_t>(v);
+			}
+			std::fill(touched.begin(), touched.end(), 0);
+
+			// Each interior collapse removes two triangles
+			const size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+			size_t removed = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (collapse.cost > maxCost || removed >= trianglesToRemove)
+					break;
+				const uint32_t pf = positionOf[collapse.from];
+				const uint32_t pt = positionOf[collapse.to];
+				if (touched[pf] || touched[pt])
+					continue;
+
+				// Reject collapses that fold a surviving triangle over
+				bool flips = false;
+				for (uint32_t a = adjacencyStart[pf]; a < adjacencyStart[pf + 1] && !flips; a++)
+				{
+					const uint32_t* tri = &current[size_t(adjacency[a]) * 3];
+					glm::dvec3 before[3];
+					glm::dvec3 after[3];
+					bool degenerates = false;
+					for (int k = 0; k < 3; k++)
+					{
+						const uint32_t p = positionOf[tri[k]];
+						degenerates |= p == pt;
+						before[k] = positions[p];
+						after[k] = p == pf ? positions[pt] : positions[p];
+					}
+					if (degenerates)
+						continue;
+					const glm::dvec3 n0 = TriangleNormal(before[0], before[1], before[2]);
+					const glm::dvec3 n1 = TriangleNormal(after[0], after[1], after[2]);
+					flips = glm::dot(n0, n1) <= 0.0;
+				}
+				if (flips)
+					continue;
+
+				remap[collapse.from] = collapse.to;
+				quadrics[pt].Add(quadrics[pf]);
+				worstCost = std::max(worstCost, collapse.cost);
+				removed += 2;
+
+				// Everything around the moved vertex is stale until the next pass
+				for (uint32_t a = adjacencyStart[pf]; a < adjacencyStart[pf + 1]; a++)
+				{
+					const uint32_t* tri = &current[size_t(adjacency[a]) * 3];
+					touched[positionOf[tri[0]]] = 1;
+					touched[positionOf[tri[1]]] = 1;
+					touched[positionOf[tri[2]]] = 1;
+				}
+				touched[pt] = 1;
+			}
+
+			if (removed == 0)
+				break;
+
+			// Apply and drop the triangles that collapsed to slivers
+			size_t write = 0;
+			for (size_t i = 0; i < current.size(); i += 3)
+			{
+				const uint32_t a = remap[current[i]];
+				const uint32_t b = remap[current[i + 1]];
+				const uint32_t c = remap[current[i + 2]];
+				const uint32_t pa = positionOf[a];
+				const uint32_t pb = positionOf[b];
+				const uint32_t pc = positionOf[c];
+				if (pa == pb || pb == pc || pa == pc)
+					continue;
+				current[write++] = a;
+				current[write++] = b;
+				current[write++] = c;
+			}
+			current.resize(write);
+		}
+
+		result.error = static_cast<float>(std::sqrt(worstCost));
+		return result;
+	}
+
+	uint32_t BuildMeshLods(const uint8_t* vertices, size_t vertexCount, size_t stride, const uint32_t* indices,
+						   size_t indexCount, uint32_t indexBase, std::vector<uint32_t>& lodIndices,
+						   MeshLod (&lods)[MAX_MESH_LODS], float maxErrorRatio)
+	{
+		lods[0].error = 0.0f;
+		if (indexCount < 3 * 64) // Not worth a draw-range switch
+			return 1;
+
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			float p[3];
+			std::memcpy(p, vertices + size_t(indices[i]) * stride, sizeof(p));
+			boundsMin = glm::min(boundsMin, glm::vec3(p[0], p[1], p[2]));
+			boundsMax = glm::max(boundsMax, glm::vec3(p[0], p[1], p[2]));
+		}
+		const float maxError = glm::length(boundsMax - boundsMin) * 0.5f * maxErrorRatio;
+
+		std::vector<uint32_t> previous(indices, indices + indexCount);
+		uint32_t lodCount = 1;
+		while (lodCount < MAX_MESH_LODS)
+		{
+			const size_t target = previous.size() / 6 * 3;
+			const float budget = maxError - lods[lodCount - 1].error;
+			if (budget <= 0.0f)
+				break;
+			SimplifyResult simplified =
+				SimplifyMesh(vertices, vertexCount, stride, previous.data(), previous.size(), target, budget);
+			if (simplified.indices.empty() || simplified.indices.size() > previous.size() * 8 / 10)
+				break;
+
+			MeshLod& lod = lods[lodCount++];
+			lod.firstIndex = indexBase + static_cast<uint32_t>(lodIndices.size());
+			lod.indexCount = static_cast<uint32_t>(simplified.indices.size());
+			lod.error = lods[lodCount - 2].error + simplified.error;
+			lodIndices.insert(lodIndices.end(), simplified.indices.begin(), simplified.indices.end());
+			previous = std::move(simplified.indices);
+		}
+		return lodCount;
+	}
+
+} // namespace Onyx
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Onyx {
+
+	// ============================================================
+	// MESH LODS
+	// ============================================================
+	//
+	// A LOD is a range of the mesh's index buffer over the same vertices, so
+	// every level shares one VBO and switching is just a different draw range.
+
+	constexpr uint32_t MAX_MESH_LODS = 4; // LOD0 (full detail) + 3 simplified
+
+	struct MeshLod
+	{
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		float error = 0.0f; // Max deviation from LOD0, in mesh units
+	};
+
+	// World-space error of one mesh unit, in NDC units (screen height = 2),
+	// at `distance` from the camera. Orthographic projections ignore distance.
+	float GetLodErrorScale(const glm::mat4& projection, float distance, float worldScale);
+
+	// Coarsest LOD whose error * errorScale stays under `threshold`
+	uint32_t SelectLod(const MeshLod* lods, uint32_t lodCount, float errorScale, float threshold);
+
+	// ============================================================
+	// SIMPLIFIER (quadric error metric, edge collapse)
+	// ============================================================
+	//
+	// Collapses edges onto existing vertices, cheapest quadric error first,
+	// so the output indexes the input vertices unchanged. Vertices on open
+	// borders or UV/normal seams (several vertices at one position) stay put,
+	// which keeps silhouettes and seams crack-free. Positions are read as
+	// float3 at offset 0 of each `stride`-byte vertex (Onyx::MeshVertex).
+
+	struct SimplifyResult
+	{
+		std::vector<uint32_t> indices;
+		float error = 0.0f; // Max deviation of the result, in mesh units
+	};
+
+	// Stops at `targetIndexCount` or before exceeding `maxError`, whichever
+	// comes first. Indices are relative to `vertices`.
+	SimplifyResult SimplifyMesh(const uint8_t* vertices, size_t vertexCount, size_t stride, const uint32_t* indices,
+								size_t indexCount, size_t targetIndexCount, float maxError);
+
+	// Builds LOD1.. at roughly halving triangle counts, each from the last,
+	// until a level saves under 20% or would deviate more than `maxErrorRatio`
+	// of the mesh's bounding radius. Simplified indices are appended to
+	// `lodIndices`; `lods[0]` must already describe the full mesh and
+	// `indexBase` is where `lodIndices` starts in the final index buffer.
+	// Returns the LOD count, including LOD0.
+	uint32_t BuildMeshLods(const uint8_t* vertices, size_t vertexCount, size_t stride, const uint32_t* indices,
+						   size_t indexCount, uint32_t indexBase, std::vector<uint32_t>& lodIndices,
+						   MeshLod (&lods)[MAX_MESH_LODS], float maxErrorRatio = 0.02f);
+
+} // namespace Onyx
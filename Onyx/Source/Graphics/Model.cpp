@@ -43,14 +43,7 @@ namespace Onyx {
 	void Onyx::Model::LoadModel(std::string path)
 	{
 		Assimp::Importer import;
-		const aiScene* scene = import.ReadFile(path,
-											   aiProcess_Triangulate |
-												   aiProcess_GenSmoothNormals |
-												   aiProcess_CalcTangentSpace |
-												   aiProcess_JoinIdenticalVertices);
-		// Note: NOT using aiProcess_PreTransformVertices to preserve separate meshes
-		// Each mesh will need its node transform applied manually
-		// Note: NOT using aiProcess_FlipUVs because Texture class already flips with stbi
+		const aiScene* scene = import.ReadFile(path, IMPORT_FLAGS);
 
 		if (!scene)
 		{
@@ -111,11 +104,7 @@ namespace Onyx {
 		std::vector<CpuMeshData> result;
 
 		Assimp::Importer import;
-		const aiScene* scene = import.ReadFile(path,
-											   aiProcess_Triangulate |
-												   aiProcess_GenSmoothNormals |
-												   aiProcess_CalcTangentSpace |
-												   aiProcess_JoinIdenticalVertices);
+		const aiScene* scene = import.ReadFile(path, IMPORT_FLAGS);
 
 		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
 		{
@@ -235,9 +224,11 @@ namespace Onyx {
 			totalIndices += static_cast<uint32_t>(mesh.m_Indices.size());
 		}
 
-		// Concatenate vertex and index data, record per-mesh offsets
+		// Concatenate vertex and index data, record per-mesh offsets. LOD
+		// ranges are appended after the last mesh's LOD0 range.
 		std::vector<MeshVertex> allVertices;
 		std::vector<uint32_t> allIndices;
+		std::vector<uint32_t> lodIndices;
 		allVertices.reserve(totalVerts);
 		allIndices.reserve(totalIndices);
 
@@ -252,6 +243,11 @@ namespace Onyx {
 			m_Merged.meshInfos[i].indexCount = static_cast<uint32_t>(mesh.m_Indices.size());
 			m_Merged.meshInfos[i].firstIndex = indexOffset;
 			m_Merged.meshInfos[i].baseVertex = static_cast<int32_t>(vertexOffset);
+			m_Merged.meshInfos[i].lods[0] = {indexOffset, m_Merged.meshInfos[i].indexCount, 0.0f};
+			m_Merged.meshInfos[i].lodCount = BuildMeshLods(
+				reinterpret_cast<const uint8_t*>(mesh.m_Vertices.data()), mesh.m_Vertices.size(), sizeof(MeshVertex),
+				mesh.m_Indices.data(), mesh.m_Indices.size(), totalIndices + static_cast<uint32_t>(lodIndices.size()),
+				lodIndices, m_Merged.meshInfos[i].lods);
 
 			allVertices.insert(allVertices.end(), mesh.m_Vertices.begin(), mesh.m_Vertices.end());
 			allIndices.insert(allIndices.end(), mesh.m_Indices.begin(), mesh.m_Indices.end());
@@ -259,9 +255,10 @@ namespace Onyx {
 			vertexOffset += static_cast<uint32_t>(mesh.m_Vertices.size());
 			indexOffset += static_cast<uint32_t>(mesh.m_Indices.size());
 		}
+		allIndices.insert(allIndices.end(), lodIndices.begin(), lodIndices.end());
 
 		m_Merged.totalVertices = totalVerts;
-		m_Merged.totalIndices = totalIndices;
+		m_Merged.totalIndices = static_cast<uint32_t>(allIndices.size());
 
 		// Create VBO, EBO, VAO using engine abstractions
 		m_Merged.vbo = std::make_unique<VertexBuffer>(
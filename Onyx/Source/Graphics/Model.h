@@ -11,6 +11,7 @@
 
 #include "Buffers.h"
 #include "Mesh.h"
+#include "MeshSimplifier.h"
 #include "VertexLayout.h"
 
 namespace Onyx {
@@ -20,6 +21,10 @@ namespace Onyx {
 		uint32_t indexCount;
 		uint32_t firstIndex;
 		int32_t baseVertex;
+		// lods[0] mirrors indexCount/firstIndex; simplified ranges live after
+		// every mesh's LOD0 range in the same EBO (static meshes only)
+		uint32_t lodCount = 1;
+		MeshLod lods[MAX_MESH_LODS];
 	};
 
 	struct MergedBuffers
@@ -47,9 +52,28 @@ namespace Onyx {
 		glm::vec3 boundsMax{0.0f};
 	};
 
+	// CPU side of MergedBuffers, built off the main thread: what AssetManager
+	// uploads and ModelCache stores
+	struct MergedMeshData
+	{
+		std::vector<uint8_t> vertexData; // MeshVertex, or SkinnedVertex for animated models
+		std::vector<uint8_t> indexData;	 // uint32_t: every mesh's LOD0 range, then LOD ranges
+		uint32_t totalVertices = 0;
+		uint32_t totalIndices = 0;
+		std::vector<MergedMeshInfo> meshInfos;
+		// Static models only
+		std::vector<MeshBoundsInfo> meshBounds;
+		std::vector<std::vector<MeshTexture>> meshTextures; // Paths, id=0
+	};
+
 	class Model
 	{
 	public:
+		// Post-processing for every static import. Not FlipUVs: Texture
+		// already flips with stbi. Not PreTransformVertices: meshes stay
+		// separate and get their node transform applied manually.
+		static constexpr unsigned int IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices;
+
 		Model(const char* path, bool loadTextures = true)
 			: m_LoadTextures(loadTextures)
 		{
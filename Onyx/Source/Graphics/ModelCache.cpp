@@ -0,0 +1,794 @@
+#include "pch.h"
+
+#include "ModelCache.h"
+
+#include "AnimatedModel.h"
+#include "Core/ContentHasher.h"
+#include "Core/FileSystem.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace Onyx {
+
+	namespace {
+
+		constexpr uint32_t ENTRY_MAGIC = 0x43444D4F; // "OMDC"
+		constexpr size_t ARRAY_ALIGNMENT = 16;
+
+		// Entry flags
+		constexpr uint32_t ENTRY_NOT_ANIMATED = 1u << 0;
+
+		struct EntryHeader
+		{
+			uint32_t magic = ENTRY_MAGIC;
+			uint32_t version = ModelCache::VERSION;
+			uint64_t key = 0;
+			uint32_t kind = 0;
+			uint32_t flags = 0;
+			uint64_t payloadSize = 0;
+		};
+		static_assert(sizeof(EntryHeader) % ARRAY_ALIGNMENT == 0, "Payload arrays are aligned from the file start");
+
+		using Clock = std::chrono::steady_clock;
+
+		double MsSince(Clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		}
+
+		// Appends the payload. Bulk arrays are padded to ARRAY_ALIGNMENT
+		// from the start of the file (the header is a multiple of it).
+		class EntryWriter
+		{
+		public:
+			template <typename T>
+			void Value(const T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				Bytes(&value, sizeof(T));
+			}
+
+			void String(const std::string& text)
+			{
+				Value(static_cast<uint32_t>(text.size()));
+				Bytes(text.data(), text.size());
+			}
+
+			template <typename T>
+			void Array(const T* values, size_t count)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				Value(static_cast<uint64_t>(count));
+				m_Data.resize((m_Data.size() + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1));
+				Bytes(values, count * sizeof(T));
+			}
+
+			template <typename T>
+			void Array(const std::vector<T>& values)
+			{
+				Array(values.data(), values.size());
+			}
+
+			const std::vector<uint8_t>& GetData() const { return m_Data; }
+
+		private:
+			void Bytes(const void* data, size_t size)
+			{
+				const uint8_t* bytes = static_cast<const uint8_t*>(data);
+				m_Data.insert(m_Data.end(), bytes, bytes + size);
+			}
+
+			std::vector<uint8_t> m_Data;
+		};
+
+		// Reads what EntryWriter wrote. Every read is bounds-checked; after
+		// the first failure all reads fail, so callers check Ok() once.
+		class EntryReader
+		{
+		public:
+			EntryReader(const uint8_t* data, size_t size)
+				: m_Data(data), m_Size(size)
+			{
+			}
+
+			template <typename T>
+			bool Value(T& out)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				if (!Has(sizeof(T)))
+					return false;
+				std::memcpy(&out, m_Data + m_Offset, sizeof(T));
+				m_Offset += sizeof(T);
+				return true;
+			}
+
+			bool String(std::string& out)
+			{
+				uint32_t size = 0;
+				if (!Value(size) || !Has(size))
+					return false;
+				out.assign(reinterpret_cast<const char*>(m_Data + m_Offset), size);
+				m_Offset += size;
+				return true;
+			}
+
+			// Element count of a container about to be read, capped by the
+			// bytes left so a corrupt count cannot drive a huge allocation
+			bool Count(uint32_t& out)
+			{
+				return Value(out) && (out <= m_Size - m_Offset || Fail());
+			}
+
+			template <typename T>
+			bool Array(std::vector<T>& out)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				const uint8_t* data = nullptr;
+				size_t count = 0;
+				if (!ArrayBytes(sizeof(T), data, count))
+					return false;
+				out.resize(count);
+				std::memcpy(out.data(), data, count * sizeof(T));
+				return true;
+			}
+
+			// Raw bytes of an array of `elementSize`-byte elements
+			bool ArrayBytes(size_t elementSize, const uint8_t*& outData, size_t& outCount)
+			{
+				uint64_t count = 0;
+				if (!Value(count))
+					return false;
+				m_Offset = (m_Offset + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1);
+				if (m_Offset > m_Size || count > (m_Size - m_Offset) / elementSize)
+					return Fail();
+				outData = m_Data + m_Offset;
+				outCount = static_cast<size_t>(count);
+				m_Offset += outCount * elementSize;
+				return true;
+			}
+
+			bool Ok() const { return !m_Failed && m_Offset == m_Size; }
+
+		private:
+			bool Has(size_t size)
+			{
+				return (!m_Failed && size <= m_Size - m_Offset) || Fail();
+			}
+
+			bool Fail()
+			{
+				m_Failed = true;
+				m_Offset = m_Size;
+				return false;
+			}
+
+			const uint8_t* m_Data;
+			size_t m_Size;
+			size_t m_Offset = 0;
+			bool m_Failed = false;
+		};
+
+		std::string GetEntryPath(const std::string& directory, uint64_t key)
+		{
+			char name[17];
+			snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+			return directory + "/" + name + ModelCache::EXTENSION;
+		}
+
+		// The entry's payload, or false if it is missing or not this key
+		bool ReadEntry(const std::string& path, uint64_t key, ModelCache::Kind kind,
+					   FileSystem::FileView& file, EntryHeader& header, bool& outRejected)
+		{
+			outRejected = false;
+			if (!FileSystem::ReadFile(path, file))
+				return false;
+
+			outRejected = true;
+			if (file.size < sizeof(EntryHeader))
+				return false;
+			std::memcpy(&header, file.data, sizeof(EntryHeader));
+			if (header.magic != ENTRY_MAGIC || header.version != ModelCache::VERSION || header.key != key
+				|| header.kind != static_cast<uint32_t>(kind) || header.payloadSize != file.size - sizeof(EntryHeader))
+				return false;
+
+			outRejected = false;
+			return true;
+		}
+
+		bool WriteEntry(const std::string& directory, uint64_t key, ModelCache::Kind kind, uint32_t flags,
+						const std::vector<uint8_t>& payload)
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(directory, ec);
+
+			EntryHeader header;
+			header.key = key;
+			header.kind = static_cast<uint32_t>(kind);
+			header.flags = flags;
+			header.payloadSize = payload.size();
+
+			// Unique per thread, so two loaders storing the same key never
+			// share a temp file; the last rename wins with identical bytes
+			const std::string path = GetEntryPath(directory, key);
+			const std::string tempPath = path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+			{
+				std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+				if (!file)
+					return false;
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+				if (!file)
+				{
+					file.close();
+					std::filesystem::remove(tempPath, ec);
+					return false;
+				}
+			}
+
+			std::filesystem::rename(tempPath, path, ec);
+			if (ec)
+			{
+				std::filesystem::remove(tempPath, ec);
+				return false;
+			}
+			return true;
+		}
+
+		std::string ParentDirectory(const std::string& path)
+		{
+			return std::filesystem::path(path).parent_path().string();
+		}
+
+		std::string LowerExtension(const std::string& path)
+		{
+			std::string extension = std::filesystem::path(path).extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(),
+						   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension;
+		}
+
+		std::string_view Trim(std::string_view text)
+		{
+			while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+				text.remove_prefix(1);
+			while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+				text.remove_suffix(1);
+			return text;
+		}
+
+		// `mtllib` names, one library per line with the rest of the line as
+		// the file name, as Assimp's OBJ parser reads them
+		void FindObjMaterialLibraries(std::string_view text, std::vector<std::string>& out)
+		{
+			constexpr std::string_view KEYWORD = "mtllib";
+			while (!text.empty())
+			{
+				const size_t end = std::min(text.find('\n'), text.size());
+				const std::string_view line = Trim(text.substr(0, end));
+				text.remove_prefix(std::min(end + 1, text.size()));
+
+				if (line.size() > KEYWORD.size() && line.substr(0, KEYWORD.size()) == KEYWORD
+					&& (line[KEYWORD.size()] == ' ' || line[KEYWORD.size()] == '\t'))
+				{
+					const std::string_view name = Trim(line.substr(KEYWORD.size()));
+					if (!name.empty())
+						out.emplace_back(name);
+				}
+			}
+		}
+
+		bool IsImagePath(const std::string& path)
+		{
+			const std::string extension = LowerExtension(path);
+			return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga"
+				|| extension == ".bmp" || extension == ".dds" || extension == ".ktx2" || extension == ".webp";
+		}
+
+		// Every external `"uri"` of a .gltf that is not an image: its
+		// buffers. Embedded `data:` URIs are already part of the file.
+		void FindGltfBuffers(std::string_view text, std::vector<std::string>& out)
+		{
+			constexpr std::string_view KEY = "\"uri\"";
+			for (size_t at = text.find(KEY); at != std::string_view::npos; at = text.find(KEY, at))
+			{
+				at += KEY.size();
+				while (at < text.size() && (std::isspace(static_cast<unsigned char>(text[at])) || text[at] == ':'))
+					at++;
+				if (at >= text.size() || text[at] != '"')
+					continue;
+
+				std::string uri;
+				for (at++; at < text.size() && text[at] != '"'; at++)
+				{
+					if (text[at] == '\\' && at + 1 < text.size())
+						at++;
+					if (text[at] == '%' && at + 2 < text.size() && std::isxdigit(static_cast<unsigned char>(text[at + 1]))
+						&& std::isxdigit(static_cast<unsigned char>(text[at + 2])))
+					{
+						uri += static_cast<char>(std::stoi(std::string(text.substr(at + 1, 2)), nullptr, 16));
+						at += 2;
+					}
+					else
+					{
+						uri += text[at];
+					}
+				}
+
+				if (!uri.empty() && uri.rfind("data:", 0) != 0 && !IsImagePath(uri))
+					out.push_back(std::move(uri));
+			}
+		}
+
+	} // namespace
+
+	std::vector<std::string> ModelCache::FindCompanionFiles(const std::string& sourcePath, std::string_view contents)
+	{
+		// Images are left out: entries hold texture paths, and the textures
+		// load from those
+		const std::string extension = LowerExtension(sourcePath);
+		std::vector<std::string> names;
+		if (extension == ".obj")
+			FindObjMaterialLibraries(contents, names);
+		else if (extension == ".gltf")
+			FindGltfBuffers(contents, names);
+
+		const std::filesystem::path directory = std::filesystem::path(sourcePath).parent_path();
+		for (std::string& name : names)
+			name = (directory / name).string();
+		return names;
+	}
+
+	void ModelCache::HashCompanionFiles(ContentHasher& hasher, const std::string& sourcePath, std::string_view contents)
+	{
+		for (const std::string& companion : FindCompanionFiles(sourcePath, contents))
+		{
+			hasher.Add(companion);
+			const bool found = hasher.AddFile(companion);
+			hasher.AddValue(found); // A missing file that shows up later misses too
+		}
+	}
+
+	void ModelCache::SetDirectory(const std::string& directory)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Directory = directory;
+	}
+
+	std::string ModelCache::GetDirectory() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Directory;
+	}
+
+	uint64_t ModelCache::HashSource(const std::string& sourcePath)
+	{
+		if (GetDirectory().empty())
+			return 0;
+
+		const auto start = Clock::now();
+		FileSystem::FileView file;
+		if (!FileSystem::ReadFile(sourcePath, file))
+			return 0;
+
+		ContentHasher hasher(VERSION);
+		hasher.Add(file.data, file.size);
+		HashCompanionFiles(hasher, sourcePath, std::string_view(reinterpret_cast<const char*>(file.data), file.size));
+		const uint64_t hash = hasher.Get();
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.hashMs += MsSince(start);
+		return hash ? hash : 1; // 0 means "no key"
+	}
+
+	uint64_t ModelCache::MakeKey(uint64_t sourceHash, Kind kind)
+	{
+		// Everything besides the source bytes that shapes an import's result
+		ContentHasher hasher(VERSION);
+		hasher.AddValue(sourceHash);
+		hasher.AddValue(kind);
+		if (kind == Kind::Static)
+		{
+			hasher.AddValue(Model::IMPORT_FLAGS);
+			hasher.AddValue(sizeof(MeshVertex));
+			hasher.AddValue(MAX_MESH_LODS);
+		}
+		else
+		{
+			hasher.AddValue(AnimatedModel::IMPORT_FLAGS);
+			hasher.AddValue(sizeof(SkinnedVertex));
+		}
+		const uint64_t key = hasher.Get();
+		return key ? key : 1;
+	}
+
+	// ============================================================
+	// STATIC MODELS
+	// ============================================================
+	//
+	// u32 meshCount, then per mesh: MergedMeshInfo, name, bounds, textures
+	// (u32 count, then type and path each); then u32 totalVertices,
+	// u32 totalIndices and the vertex and index arrays.
+
+	bool ModelCache::LoadStatic(uint64_t key, MergedMeshData& out)
+	{
+		const std::string directory = GetDirectory();
+		if (key == 0 || directory.empty())
+			return false;
+
+		const auto start = Clock::now();
+		FileSystem::FileView file;
+		EntryHeader header;
+		bool rejected = false;
+		if (!ReadEntry(GetEntryPath(directory, key), key, Kind::Static, file, header, rejected))
+		{
+			RecordMiss(rejected);
+			return false;
+		}
+
+		EntryReader reader(file.data + sizeof(EntryHeader), static_cast<size_t>(header.payloadSize));
+		MergedMeshData data;
+
+		uint32_t meshCount = 0;
+		reader.Count(meshCount);
+		data.meshInfos.resize(meshCount);
+		data.meshBounds.resize(meshCount);
+		data.meshTextures.resize(meshCount);
+		for (uint32_t i = 0; i < meshCount && reader.Value(data.meshInfos[i]); i++)
+		{
+			MeshBoundsInfo& bounds = data.meshBounds[i];
+			reader.String(bounds.name);
+			reader.Value(bounds.boundsMin);
+			reader.Value(bounds.boundsMax);
+
+			uint32_t textureCount = 0;
+			reader.Count(textureCount);
+			data.meshTextures[i].resize(textureCount);
+			for (MeshTexture& texture : data.meshTextures[i])
+			{
+				texture.id = 0;
+				reader.String(texture.type);
+				reader.String(texture.path);
+			}
+		}
+
+		reader.Value(data.totalVertices);
+		reader.Value(data.totalIndices);
+
+		const uint8_t* vertices = nullptr;
+		const uint8_t* indices = nullptr;
+		size_t vertexCount = 0, indexCount = 0;
+		reader.ArrayBytes(sizeof(MeshVertex), vertices, vertexCount);
+		reader.ArrayBytes(sizeof(uint32_t), indices, indexCount);
+
+		if (!reader.Ok() || vertexCount != data.totalVertices || indexCount != data.totalIndices)
+		{
+			RecordMiss(true);
+			return false;
+		}
+
+		data.vertexData.assign(vertices, vertices + vertexCount * sizeof(MeshVertex));
+		data.indexData.assign(indices, indices + indexCount * sizeof(uint32_t));
+		out = std::move(data);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.hits++;
+		m_Stats.bytesRead += file.size;
+		m_Stats.loadMs += MsSince(start);
+		return true;
+	}
+
+	void ModelCache::StoreStatic(uint64_t key, const MergedMeshData& data)
+	{
+		const std::string directory = GetDirectory();
+		if (key == 0 || directory.empty())
+			return;
+
+		EntryWriter writer;
+		writer.Value(static_cast<uint32_t>(data.meshInfos.size()));
+		for (size_t i = 0; i < data.meshInfos.size(); i++)
+		{
+			writer.Value(data.meshInfos[i]);
+
+			const MeshBoundsInfo bounds = i < data.meshBounds.size() ? data.meshBounds[i] : MeshBoundsInfo{};
+			writer.String(bounds.name);
+			writer.Value(bounds.boundsMin);
+			writer.Value(bounds.boundsMax);
+
+			const std::vector<MeshTexture> noTextures;
+			const std::vector<MeshTexture>& textures = i < data.meshTextures.size() ? data.meshTextures[i] : noTextures;
+			writer.Value(static_cast<uint32_t>(textures.size()));
+			for (const MeshTexture& texture : textures)
+			{
+				writer.String(texture.type);
+				writer.String(texture.path);
+			}
+		}
+
+		writer.Value(data.totalVertices);
+		writer.Value(data.totalIndices);
+		writer.Array(reinterpret_cast<const MeshVertex*>(data.vertexData.data()), data.vertexData.size() / sizeof(MeshVertex));
+		writer.Array(reinterpret_cast<const uint32_t*>(data.indexData.data()), data.indexData.size() / sizeof(uint32_t));
+
+		if (WriteEntry(directory, key, Kind::Static, 0, writer.GetData()))
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stats.stores++;
+			m_Stats.bytesWritten += sizeof(EntryHeader) + writer.GetData().size();
+		}
+	}
+
+	// ============================================================
+	// ANIMATED MODELS
+	// ============================================================
+	//
+	// Bounds; meshes (name, material, vertex and index arrays); materials
+	// (texture paths relative to the model's directory when they were under
+	// it, so the entry survives moving the folder); skeleton; node hierarchy;
+	// animations as their source keys, compiled again on load.
+
+	bool ModelCache::LoadAnimated(uint64_t key, const std::string& sourcePath, std::unique_ptr<AnimatedModel>& out)
+	{
+		const std::string directory = GetDirectory();
+		if (key == 0 || directory.empty())
+			return false;
+
+		const auto start = Clock::now();
+		FileSystem::FileView file;
+		EntryHeader header;
+		bool rejected = false;
+		if (!ReadEntry(GetEntryPath(directory, key), key, Kind::Animated, file, header, rejected))
+		{
+			RecordMiss(rejected);
+			return false;
+		}
+
+		std::unique_ptr<AnimatedModel> model;
+		if (!(header.flags & ENTRY_NOT_ANIMATED))
+		{
+			EntryReader reader(file.data + sizeof(EntryHeader), static_cast<size_t>(header.payloadSize));
+			model = std::make_unique<AnimatedModel>();
+			model->m_Path = sourcePath;
+			model->m_Directory = ParentDirectory(sourcePath);
+
+			reader.Value(model->m_BoundsMin);
+			reader.Value(model->m_BoundsMax);
+
+			uint32_t meshCount = 0;
+			reader.Count(meshCount);
+			model->m_Meshes.resize(meshCount);
+			for (SkinnedMesh& mesh : model->m_Meshes)
+			{
+				reader.String(mesh.name);
+				reader.Value(mesh.materialIndex);
+				reader.Array(mesh.vertices);
+				reader.Array(mesh.indices);
+				mesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+			}
+
+			auto readTexturePath = [&](std::string& path) {
+				uint8_t relative = 0;
+				reader.Value(relative);
+				reader.String(path);
+				if (relative)
+					path = model->m_Directory + "/" + path;
+			};
+
+			uint32_t materialCount = 0;
+			reader.Count(materialCount);
+			model->m_Materials.resize(materialCount);
+			for (AnimatedMaterial& material : model->m_Materials)
+			{
+				reader.String(material.name);
+				reader.Value(material.diffuseColor);
+				reader.Value(material.specularColor);
+				reader.Value(material.shininess);
+				readTexturePath(material.diffuseTexturePath);
+				readTexturePath(material.normalTexturePath);
+				readTexturePath(material.specularTexturePath);
+			}
+
+			glm::mat4 globalInverse(1.0f);
+			reader.Value(globalInverse);
+			model->m_Skeleton.SetGlobalInverseTransform(globalInverse);
+
+			uint32_t boneCount = 0;
+			reader.Count(boneCount);
+			for (uint32_t i = 0; i < boneCount; i++)
+			{
+				Bone bone;
+				reader.String(bone.name);
+				reader.Value(bone.parentIndex);
+				reader.Value(bone.offsetMatrix);
+				reader.Value(bone.localBindTransform);
+				model->m_Skeleton.AddBone(bone.name, bone.parentIndex, bone.offsetMatrix);
+				model->m_Skeleton.SetBoneLocalTransform(static_cast<int>(i), bone.localBindTransform);
+			}
+
+			uint32_t nodeCount = 0;
+			reader.Count(nodeCount);
+			model->m_NodeHierarchy.resize(nodeCount);
+			for (uint32_t i = 0; i < nodeCount; i++)
+			{
+				AnimationNode& node = model->m_NodeHierarchy[i];
+				reader.String(node.name);
+				reader.Value(node.transform);
+				reader.Value(node.parentIndex);
+				reader.Array(node.children);
+				model->m_NodeMap[node.name] = static_cast<int>(i);
+			}
+
+			uint32_t animationCount = 0;
+			reader.Count(animationCount);
+			for (uint32_t i = 0; i < animationCount; i++)
+			{
+				std::string name;
+				float duration = 0.0f;
+				float ticksPerSecond = 0.0f;
+				reader.String(name);
+				reader.Value(duration);
+				reader.Value(ticksPerSecond);
+
+				auto animation = std::make_unique<Animation>(name, duration, ticksPerSecond);
+				uint32_t trackCount = 0;
+				reader.Count(trackCount);
+				for (uint32_t track = 0; track < trackCount; track++)
+				{
+					BoneAnimation boneAnimation;
+					reader.String(boneAnimation.boneName);
+					reader.Array(boneAnimation.positionKeys);
+					reader.Array(boneAnimation.rotationKeys);
+					reader.Array(boneAnimation.scaleKeys);
+					animation->AddBoneAnimation(boneAnimation);
+				}
+
+				model->m_AnimationMap[name] = static_cast<int>(model->m_Animations.size());
+				model->m_Animations.push_back(std::move(animation));
+			}
+
+			// Every bone must have come back at the index it was stored at
+			if (!reader.Ok() || model->m_Skeleton.GetBoneCount() != static_cast<int>(boneCount))
+			{
+				RecordMiss(true);
+				return false;
+			}
+
+			model->CompileAnimations();
+			model->m_BoneMatrices.resize(model->m_Skeleton.GetBoneCount(), glm::mat4(1.0f));
+		}
+
+		out = std::move(model);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.hits++;
+		m_Stats.bytesRead += file.size;
+		m_Stats.loadMs += MsSince(start);
+		return true;
+	}
+
+	void ModelCache::StoreAnimated(uint64_t key, const AnimatedModel* model)
+	{
+		const std::string directory = GetDirectory();
+		if (key == 0 || directory.empty())
+			return;
+
+		EntryWriter writer;
+		if (model)
+		{
+			writer.Value(model->m_BoundsMin);
+			writer.Value(model->m_BoundsMax);
+
+			writer.Value(static_cast<uint32_t>(model->m_Meshes.size()));
+			for (const SkinnedMesh& mesh : model->m_Meshes)
+			{
+				writer.String(mesh.name);
+				writer.Value(mesh.materialIndex);
+				writer.Array(mesh.vertices);
+				writer.Array(mesh.indices);
+			}
+
+			const std::string prefix = model->m_Directory + "/";
+			auto writeTexturePath = [&](const std::string& path) {
+				const bool relative = !model->m_Directory.empty() && path.compare(0, prefix.size(), prefix) == 0;
+				writer.Value(static_cast<uint8_t>(relative));
+				writer.String(relative ? path.substr(prefix.size()) : path);
+			};
+
+			writer.Value(static_cast<uint32_t>(model->m_Materials.size()));
+			for (const AnimatedMaterial& material : model->m_Materials)
+			{
+				writer.String(material.name);
+				writer.Value(material.diffuseColor);
+				writer.Value(material.specularColor);
+				writer.Value(material.shininess);
+				writeTexturePath(material.diffuseTexturePath);
+				writeTexturePath(material.normalTexturePath);
+				writeTexturePath(material.specularTexturePath);
+			}
+
+			writer.Value(model->m_Skeleton.GetGlobalInverseTransform());
+			const std::vector<Bone>& bones = model->m_Skeleton.GetBones();
+			writer.Value(static_cast<uint32_t>(bones.size()));
+			for (const Bone& bone : bones)
+			{
+				writer.String(bone.name);
+				writer.Value(bone.parentIndex);
+				writer.Value(bone.offsetMatrix);
+				writer.Value(bone.localBindTransform);
+			}
+
+			writer.Value(static_cast<uint32_t>(model->m_NodeHierarchy.size()));
+			for (const AnimationNode& node : model->m_NodeHierarchy)
+			{
+				writer.String(node.name);
+				writer.Value(node.transform);
+				writer.Value(node.parentIndex);
+				writer.Array(node.children);
+			}
+
+			writer.Value(static_cast<uint32_t>(model->m_Animations.size()));
+			for (const auto& animation : model->m_Animations)
+			{
+				writer.String(animation->GetName());
+				writer.Value(animation->GetDuration());
+				writer.Value(animation->GetTicksPerSecond());
+
+				const std::vector<BoneAnimation>& tracks = animation->GetBoneAnimations();
+				writer.Value(static_cast<uint32_t>(tracks.size()));
+				for (const BoneAnimation& track : tracks)
+				{
+					writer.String(track.boneName);
+					writer.Array(track.positionKeys);
+					writer.Array(track.rotationKeys);
+					writer.Array(track.scaleKeys);
+				}
+			}
+		}
+
+		if (WriteEntry(directory, key, Kind::Animated, model ? 0 : ENTRY_NOT_ANIMATED, writer.GetData()))
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stats.stores++;
+			m_Stats.bytesWritten += sizeof(EntryHeader) + writer.GetData().size();
+		}
+	}
+
+	// ============================================================
+	// STATS
+	// ============================================================
+
+	void ModelCache::RecordImport(double milliseconds)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.imports++;
+		m_Stats.importMs += milliseconds;
+	}
+
+	void ModelCache::RecordMiss(bool rejected)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.misses++;
+		if (rejected)
+			m_Stats.rejected++;
+	}
+
+	ModelCacheStats ModelCache::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Stats;
+	}
+
+	void ModelCache::ResetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats = {};
+	}
+
+} // namespace Onyx
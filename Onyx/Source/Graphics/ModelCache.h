@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Model.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Onyx {
+
+	class AnimatedModel;
+	class ContentHasher;
+
+	struct ModelCacheStats
+	{
+		uint32_t hits = 0;
+		uint32_t misses = 0;   // No usable entry; includes rejected
+		uint32_t rejected = 0; // Entry present but unreadable (truncated, wrong version)
+		uint32_t stores = 0;
+		uint32_t imports = 0; // Assimp imports run by callers on a miss
+		uint64_t bytesRead = 0;
+		uint64_t bytesWritten = 0;
+		double hashMs = 0.0;   // Hashing source files
+		double loadMs = 0.0;   // Reading hits
+		double importMs = 0.0; // Assimp plus post-processing on misses
+	};
+
+	// ============================================================
+	// MODEL CACHE
+	// ============================================================
+	//
+	// Derived-data cache for Assimp imports. An entry holds what an import
+	// ends up as after post-processing: a static model's merged MeshVertex
+	// data with its LOD chain, bounds and texture paths, or a skinned model's
+	// meshes, materials, skeleton, node hierarchy and animations. Entries are
+	// keyed by the source file's contents and the files it pulls in (an
+	// OBJ's .mtl, a glTF's .bin), plus the import settings, so moving a file
+	// keeps its entry and editing either misses. Other formats key on the
+	// source file alone: delete the directory after editing what they
+	// reference.
+	//
+	// Each entry is `<directory>/<key>.omc`: a header, then the payload with
+	// every bulk array 16-byte aligned from the start of the file, read in
+	// place through FileSystem::ReadFile's mapping. Entries are written to a
+	// temp file and renamed into place, so a reader never sees a torn one.
+	// Unreadable entries count as misses and are overwritten. Thread-safe.
+	class ModelCache
+	{
+	public:
+		// Bump when the entry layout or what the importers produce changes
+		// (MeshVertex packing, LOD building, node naming...): every entry
+		// written before then misses. Vertex sizes and Assimp flags are
+		// already part of the key.
+		static constexpr uint32_t VERSION = 1;
+		static constexpr const char* EXTENSION = ".omc";
+
+		enum class Kind : uint32_t
+		{
+			Static = 1,
+			Animated = 2,
+		};
+
+		// Empty disables the cache. Created on the first store.
+		void SetDirectory(const std::string& directory);
+		std::string GetDirectory() const;
+
+		// Content hash of a source file and its companions (an OBJ's mtllib
+		// files, a glTF's non-image buffers), shared by its Static and
+		// Animated keys. 0 when the cache is disabled or the source cannot
+		// be read; a missing companion still hashes, as missing.
+		uint64_t HashSource(const std::string& sourcePath);
+		static uint64_t MakeKey(uint64_t sourceHash, Kind kind);
+
+		// The companions a source's `contents` name, resolved next to it.
+		// HashCompanionFiles adds each one's path, bytes and whether it was
+		// found, for other keys over imported models (the editor's export).
+		static std::vector<std::string> FindCompanionFiles(const std::string& sourcePath, std::string_view contents);
+		static void HashCompanionFiles(ContentHasher& hasher, const std::string& sourcePath, std::string_view contents);
+
+		bool LoadStatic(uint64_t key, MergedMeshData& out);
+		void StoreStatic(uint64_t key, const MergedMeshData& data);
+
+		// False on a miss. On a hit `out` is the parsed model, with no GPU
+		// resources, or null if the source was stored as having no
+		// animations (StoreAnimated with a null model).
+		bool LoadAnimated(uint64_t key, const std::string& sourcePath, std::unique_ptr<AnimatedModel>& out);
+		void StoreAnimated(uint64_t key, const AnimatedModel* model);
+
+		// Callers report the Assimp work a miss cost them
+		void RecordImport(double milliseconds);
+
+		ModelCacheStats GetStats() const;
+		void ResetStats();
+
+	private:
+		void RecordMiss(bool rejected);
+
+		mutable std::mutex m_Mutex;
+		std::string m_Directory;
+		ModelCacheStats m_Stats;
+	};
+
+} // namespace Onyx
@@ -1,12 +1,35 @@
 #include "pch.h"
 
 #include "ParticleSystem.h"
+#include "Maths/SimdMath.h"
+#include <utility>
 
 namespace Onyx {
 
+	// WriteQuads stores a QuadInstance as rows {position, rotation}, {halfSize, uvMin}, {uvMax, color, texIndex}
+	static_assert(offsetof(QuadInstance, rotation) == 12 && offsetof(QuadInstance, halfSize) == 16
+			&& offsetof(QuadInstance, uvRect) == 24 && offsetof(QuadInstance, color) == 40
+			&& offsetof(QuadInstance, texIndex) == 44,
+		"QuadInstance layout changed");
+
+	// ParticleEmitterHandle = slot | generation << EMITTER_SLOT_BITS
+	constexpr uint32_t EMITTER_SLOT_BITS = 16;
+	constexpr uint32_t EMITTER_SLOT_MASK = (1u << EMITTER_SLOT_BITS) - 1;
+
 	ParticleSystem::ParticleSystem(int particleCount)
+		: m_Capacity(static_cast<uint32_t>(std::max(particleCount, 1)))
 	{
-		m_ParticlePool.resize(particleCount);
+		for (std::vector<float>* stream : {&m_PositionX, &m_PositionY, &m_VelocityX, &m_VelocityY,
+				 &m_LifeRemaining, &m_Lifetime, &m_SizeBegin, &m_SizeEnd, &m_Rotation})
+			stream->resize(m_Capacity);
+
+		for (int channel = 0; channel < 4; channel++)
+		{
+			m_ColorBegin[channel].resize(m_Capacity);
+			m_ColorEnd[channel].resize(m_Capacity);
+		}
+
+		m_Dead.resize(m_Capacity);
 	}
 
 	ParticleSystem::~ParticleSystem()
@@ -14,89 +37,357 @@ namespace Onyx {
 
 	void ParticleSystem::Update(float timestamp)
 	{
-		for (auto& particle : m_ParticlePool)
+		UpdateEmitters(timestamp);
+
+		const uint32_t count = m_AliveCount;
+		float* positionX = m_PositionX.data();
+		float* positionY = m_PositionY.data();
+		const float* velocityX = m_VelocityX.data();
+		const float* velocityY = m_VelocityY.data();
+		float* life = m_LifeRemaining.data();
+		uint32_t* dead = m_Dead.data();
+		uint32_t deadCount = 0;
+
+		uint32_t i = 0;
+#if ONYX_SIMD_SSE2
+		const __m128 dt = _mm_set1_ps(timestamp);
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
 		{
-			if (!particle.active)
-				continue;
+			_mm_storeu_ps(positionX + i, _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_mul_ps(_mm_loadu_ps(velocityX + i), dt)));
+			_mm_storeu_ps(positionY + i, _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_mul_ps(_mm_loadu_ps(velocityY + i), dt)));
+
+			const __m128 remaining = _mm_sub_ps(_mm_loadu_ps(life + i), dt);
+			_mm_storeu_ps(life + i, remaining);
 
-			if (particle.lifeRemaining <= 0.0f)
+			const int deadLanes = _mm_movemask_ps(_mm_cmple_ps(remaining, zero));
+			if (deadLanes)
 			{
-				particle.active = false;
-				continue;
+				for (uint32_t lane = 0; lane < 4; lane++)
+				{
+					if (deadLanes & (1 << lane))
+						dead[deadCount++] = i + lane;
+				}
 			}
+		}
+#endif
+		for (; i < count; i++)
+		{
+			positionX[i] += velocityX[i] * timestamp;
+			positionY[i] += velocityY[i] * timestamp;
+			life[i] -= timestamp;
+			if (life[i] <= 0.0f)
+				dead[deadCount++] = i;
+		}
 
-			particle.position += {
-				particle.velocity.x * timestamp,
-				particle.velocity.y * timestamp};
-			particle.lifeRemaining -= timestamp;
+		// Highest first, so the last live particle is never one still to be removed
+		for (uint32_t d = deadCount; d-- > 0;)
+		{
+			const uint32_t last = --m_AliveCount;
+			if (dead[d] != last)
+				CopyParticle(last, dead[d]);
 		}
+
+		if (m_PoolIndex >= m_AliveCount)
+			m_PoolIndex = 0;
 	}
 
 	void ParticleSystem::Render(Onyx::Renderer2D* renderer)
 	{
-		for (auto& particle : m_ParticlePool)
+		if (m_AliveCount == 0)
+			return;
+
+		WriteQuads(renderer->AllocateQuads(m_AliveCount));
+	}
+
+	void ParticleSystem::WriteQuads(QuadInstance* out) const
+	{
+		const uint32_t count = m_AliveCount;
+
+		// Same maths as lerp(end, begin, t) and PackQuadColor, so the output
+		// matches RenderQuadInstanced bit for bit. Whole 16-byte rows only:
+		// `out` is usually write-combined GPU memory.
+		uint32_t i = 0;
+#if ONYX_SIMD_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 scale255 = _mm_set1_ps(255.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 texIndex = _mm_set1_ps(-1.0f);
+
+		auto lerp = [](__m128 a, __m128 b, __m128 t) { return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a))); };
+
+		// Nothing reads the records back, so skip the cache when we can
+		const bool aligned = (reinterpret_cast<uintptr_t>(out) & 15) == 0;
+
+		for (; i + 4 <= count; i += 4)
 		{
-			if (!particle.active)
-				continue;
+			const __m128 t = _mm_div_ps(_mm_loadu_ps(&m_LifeRemaining[i]), _mm_loadu_ps(&m_Lifetime[i]));
+			const __m128 size = lerp(_mm_loadu_ps(&m_SizeEnd[i]), _mm_loadu_ps(&m_SizeBegin[i]), t);
 
-			float life = particle.lifeRemaining / particle.lifetime;
+			__m128i packed = _mm_setzero_si128();
+			for (int channel = 0; channel < 4; channel++)
+			{
+				__m128 value = lerp(_mm_loadu_ps(&m_ColorEnd[channel][i]), _mm_loadu_ps(&m_ColorBegin[channel][i]), t);
+				value = _mm_min_ps(_mm_max_ps(value, zero), one);
+				const __m128i byte = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale255), half));
+				packed = _mm_or_si128(packed, _mm_slli_epi32(byte, channel * 8));
+			}
 
-			particle.color = Onyx::lerp4D(particle.colorEnd, particle.colorBegin, life);
-			float size = Onyx::lerp(particle.sizeEnd, particle.sizeBegin, life);
+			// Each record is three float4 rows; transposing one row's four
+			// fields across four particles yields that row for each of them
+			__m128 position[4] = {_mm_mul_ps(_mm_loadu_ps(&m_PositionX[i]), two), _mm_mul_ps(_mm_loadu_ps(&m_PositionY[i]), two), zero, _mm_loadu_ps(&m_Rotation[i])};
+			__m128 extent[4] = {size, size, zero, zero};
+			__m128 tail[4] = {one, one, _mm_castsi128_ps(packed), texIndex};
+			_MM_TRANSPOSE4_PS(position[0], position[1], position[2], position[3]);
+			_MM_TRANSPOSE4_PS(extent[0], extent[1], extent[2], extent[3]);
+			_MM_TRANSPOSE4_PS(tail[0], tail[1], tail[2], tail[3]);
 
-			renderer->RenderRotatedQuad(
-				{size, size},
-				{particle.position.x, particle.position.y, 0.0f},
-				particle.color,
-				particle.rotation);
+			float* quads = reinterpret_cast<float*>(out + i);
+			if (aligned)
+			{
+				for (uint32_t lane = 0; lane < 4; lane++)
+				{
+					_mm_stream_ps(quads + lane * 12, position[lane]);
+					_mm_stream_ps(quads + lane * 12 + 4, extent[lane]);
+					_mm_stream_ps(quads + lane * 12 + 8, tail[lane]);
+				}
+			}
+			else
+			{
+				for (uint32_t lane = 0; lane < 4; lane++)
+				{
+					_mm_storeu_ps(quads + lane * 12, position[lane]);
+					_mm_storeu_ps(quads + lane * 12 + 4, extent[lane]);
+					_mm_storeu_ps(quads + lane * 12 + 8, tail[lane]);
+				}
+			}
+		}
+		_mm_sfence();
+#endif
+		for (; i < count; i++)
+		{
+			const float t = m_LifeRemaining[i] / m_Lifetime[i];
+			const float size = Onyx::lerp(m_SizeEnd[i], m_SizeBegin[i], t);
+			const Onyx::Vector4D color(
+				Onyx::lerp(m_ColorEnd[0][i], m_ColorBegin[0][i], t),
+				Onyx::lerp(m_ColorEnd[1][i], m_ColorBegin[1][i], t),
+				Onyx::lerp(m_ColorEnd[2][i], m_ColorBegin[2][i], t),
+				Onyx::lerp(m_ColorEnd[3][i], m_ColorBegin[3][i], t));
+
+			QuadInstance& quad = out[i];
+			quad.position = {m_PositionX[i] * 2, m_PositionY[i] * 2, 0.0f};
+			quad.rotation = m_Rotation[i];
+			quad.halfSize = {size, size};
+			quad.uvRect = {0.0f, 0.0f, 1.0f, 1.0f};
+			quad.color = PackQuadColor(color);
+			quad.texIndex = -1.0f;
 		}
 	}
 
-	void ParticleSystem::Emitter(const ParticleProperties& props)
+	void ParticleSystem::Emit(const ParticleProperties& props)
 	{
-		/*for (auto& particle : m_ParticlePool)
+		const uint32_t index = AllocateParticle();
+
+		m_LifeRemaining[index] = props.lifetime;
+		m_Lifetime[index] = props.lifetime;
+
+		m_PositionX[index] = props.position.x;
+		m_PositionY[index] = props.position.y;
+		m_Rotation[index] = props.rotation;
+
+		m_VelocityX[index] = props.velocity.x + props.velocityVariation.x * Onyx::ramdomInRange(-0.5f, 0.5f);
+		m_VelocityY[index] = props.velocity.y + props.velocityVariation.y * Onyx::ramdomInRange(-0.5f, 0.5f);
+
+		m_SizeBegin[index] = props.sizeBegin;
+		m_SizeEnd[index] = props.sizeEnd;
+
+		const float colorBegin[4] = {props.colorBegin.x, props.colorBegin.y, props.colorBegin.z, props.colorBegin.w};
+		const float colorEnd[4] = {props.colorEnd.x, props.colorEnd.y, props.colorEnd.z, props.colorEnd.w};
+		for (int channel = 0; channel < 4; channel++)
 		{
-			particle.velocity = props.velocity;
-			particle.size = props.size;
-			particle.color = props.color;
+			m_ColorBegin[channel][index] = colorBegin[channel];
+			m_ColorEnd[channel][index] = colorEnd[channel];
+		}
+	}
 
-			if (particle.lifeRemaining < 0.0f)
+	void ParticleSystem::Emit(const ParticleProperties& props, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			Emit(props);
+	}
+
+	uint32_t ParticleSystem::AllocateParticle()
+	{
+		if (m_AliveCount < m_Capacity)
+			return m_AliveCount++;
+
+		const uint32_t index = m_PoolIndex;
+		m_PoolIndex = (m_PoolIndex + 1) % m_Capacity;
+		return index;
+	}
+
+	void ParticleSystem::CopyParticle(uint32_t from, uint32_t to)
+	{
+		m_PositionX[to] = m_PositionX[from];
+		m_PositionY[to] = m_PositionY[from];
+		m_VelocityX[to] = m_VelocityX[from];
+		m_VelocityY[to] = m_VelocityY[from];
+		m_LifeRemaining[to] = m_LifeRemaining[from];
+		m_Lifetime[to] = m_Lifetime[from];
+		m_SizeBegin[to] = m_SizeBegin[from];
+		m_SizeEnd[to] = m_SizeEnd[from];
+		m_Rotation[to] = m_Rotation[from];
+
+		for (int channel = 0; channel < 4; channel++)
+		{
+			m_ColorBegin[channel][to] = m_ColorBegin[channel][from];
+			m_ColorEnd[channel][to] = m_ColorEnd[channel][from];
+		}
+	}
+
+	// ============================================================
+	// EMITTERS
+	// ============================================================
+
+	void ParticleSystem::UpdateEmitters(float timestamp)
+	{
+		for (Emitter& emitter : m_Emitters)
+		{
+			if (!emitter.used || !emitter.playing)
+				continue;
+
+			const ParticleEmitterSettings& settings = emitter.settings;
+			const float dt = timestamp * settings.playbackSpeed;
+
+			ParticleProperties props = settings.properties;
+			props.velocity = {props.velocity.x * settings.scale, props.velocity.y * settings.scale};
+			props.velocityVariation = {props.velocityVariation.x * settings.scale, props.velocityVariation.y * settings.scale};
+			props.sizeBegin *= settings.scale;
+			props.sizeEnd *= settings.scale;
+
+			if (settings.mode == ParticleEmitMode::Rate)
+			{
+				// A non-looping emitter stops owing particles at `duration`
+				float activeTime = dt;
+				if (!settings.looping)
+					activeTime = std::max(0.0f, std::min(dt, settings.duration - emitter.elapsed));
+
+				emitter.rateAccumulator += activeTime * settings.rate;
+				const uint32_t count = static_cast<uint32_t>(emitter.rateAccumulator);
+				emitter.rateAccumulator -= static_cast<float>(count);
+				Emit(props, count);
+
+				emitter.elapsed += dt;
+				if (!settings.looping && emitter.elapsed >= settings.duration)
+					emitter.playing = false;
+			}
+			else
 			{
-				particle.position = props.position;
+				emitter.burstTimer -= dt;
+				while (emitter.playing && emitter.burstTimer <= 0.0f)
+				{
+					Emit(props, settings.burstCount);
+
+					if (settings.looping && settings.burstInterval > 0.0f)
+						emitter.burstTimer += settings.burstInterval;
+					else
+						emitter.playing = false;
+				}
 			}
-		}*/
+		}
 	}
 
-	void ParticleSystem::Emit(const ParticleProperties& props)
+	ParticleEmitterHandle ParticleSystem::AddEmitter(const ParticleEmitterSettings& settings)
 	{
-		Particle& particle = m_ParticlePool[m_PoolIndex];
+		uint32_t slot = 0;
+		while (slot < m_Emitters.size() && m_Emitters[slot].used)
+			slot++;
 
-		particle.active = true;
-		particle.lifeRemaining = props.lifetime;
-		particle.lifetime = props.lifetime;
+		if (slot > EMITTER_SLOT_MASK)
+			return INVALID_PARTICLE_EMITTER;
+		if (slot == m_Emitters.size())
+			m_Emitters.emplace_back();
 
-		particle.position = props.position;
-		particle.rotation = props.rotation;
+		Emitter& emitter = m_Emitters[slot];
+		const uint16_t generation = emitter.generation;
+		emitter = Emitter{};
+		emitter.generation = generation;
+		emitter.settings = settings;
+		emitter.used = true;
 
-		particle.velocity = props.velocity;
-		particle.velocity.x += props.velocityVariation.x * Onyx::ramdomInRange(-0.5f, 0.5f);
-		particle.velocity.y += props.velocityVariation.y * Onyx::ramdomInRange(-0.5f, 0.5f);
+		const ParticleEmitterHandle handle = slot | (static_cast<uint32_t>(generation) << EMITTER_SLOT_BITS);
+		if (settings.autoPlay)
+			Play(handle);
 
-		particle.sizeBegin = props.sizeBegin;
-		// particle.sizeBegin += props.sizeVariation * Onyx::ramdomInRange(0.0f, 0.5f);
-		particle.sizeEnd = props.sizeEnd;
+		return handle;
+	}
 
-		particle.color = props.color;
-		particle.colorBegin = props.colorBegin;
-		particle.colorEnd = props.colorEnd;
+	void ParticleSystem::RemoveEmitter(ParticleEmitterHandle emitter)
+	{
+		Emitter* found = FindEmitter(emitter);
+		if (!found)
+			return;
 
-		if (m_PoolIndex == m_ParticlePool.size() - 1)
-		{
-			m_PoolIndex = 0;
+		// Skips 0 on wrap-around, so no handle is ever INVALID_PARTICLE_EMITTER
+		const uint16_t generation = found->generation + 1 != 0 ? found->generation + 1 : 1;
+		*found = Emitter{};
+		found->generation = generation;
+	}
+
+	ParticleEmitterSettings* ParticleSystem::GetEmitterSettings(ParticleEmitterHandle emitter)
+	{
+		Emitter* found = FindEmitter(emitter);
+		return found ? &found->settings : nullptr;
+	}
+
+	void ParticleSystem::SetEmitterPosition(ParticleEmitterHandle emitter, Onyx::Vector2D position)
+	{
+		if (Emitter* found = FindEmitter(emitter))
+			found->settings.properties.position = position;
+	}
+
+	void ParticleSystem::Play(ParticleEmitterHandle emitter)
+	{
+		Emitter* found = FindEmitter(emitter);
+		if (!found)
 			return;
-		}
 
-		m_PoolIndex++;
+		// Restarts: a burst emitter fires on the next Update
+		found->playing = true;
+		found->elapsed = 0.0f;
+		found->rateAccumulator = 0.0f;
+		found->burstTimer = 0.0f;
+	}
+
+	void ParticleSystem::Stop(ParticleEmitterHandle emitter)
+	{
+		if (Emitter* found = FindEmitter(emitter))
+			found->playing = false;
+	}
+
+	bool ParticleSystem::IsPlaying(ParticleEmitterHandle emitter) const
+	{
+		const Emitter* found = FindEmitter(emitter);
+		return found && found->playing;
+	}
+
+	ParticleSystem::Emitter* ParticleSystem::FindEmitter(ParticleEmitterHandle emitter)
+	{
+		return const_cast<Emitter*>(std::as_const(*this).FindEmitter(emitter));
+	}
+
+	const ParticleSystem::Emitter* ParticleSystem::FindEmitter(ParticleEmitterHandle emitter) const
+	{
+		const uint32_t slot = emitter & EMITTER_SLOT_MASK;
+		if (emitter == INVALID_PARTICLE_EMITTER || slot >= m_Emitters.size())
+			return nullptr;
+
+		const Emitter& found = m_Emitters[slot];
+		if (!found.used || found.generation != (emitter >> EMITTER_SLOT_BITS))
+			return nullptr;
+		return &found;
 	}
 
-}; // namespace Onyx
\ No newline at end of file
+} // namespace Onyx
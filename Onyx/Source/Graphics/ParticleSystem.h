@@ -3,6 +3,9 @@
 #include "Maths/Maths.h"
 #include "Renderer2D.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace Onyx {
 
 	struct ParticleProperties
@@ -15,34 +18,109 @@ namespace Onyx {
 		float lifetime = 1.0f;
 	};
 
+	enum class ParticleEmitMode
+	{
+		Rate,  // `rate` particles a second while playing
+		Burst, // `burstCount` particles at once, again every `burstInterval` seconds when looping
+	};
+
+	// A particle source owned by a ParticleSystem. The playback fields mirror
+	// the editor's MMO::ParticleEmitter world object, so one can drive an
+	// emitter directly.
+	struct ParticleEmitterSettings
+	{
+		ParticleProperties properties{};
+		ParticleEmitMode mode = ParticleEmitMode::Rate;
+
+		float rate = 100.0f;
+		float duration = 1.0f; // Seconds a non-looping Rate emitter plays
+		uint32_t burstCount = 100;
+		float burstInterval = 1.0f;
+
+		bool looping = true;
+		bool autoPlay = true;
+		float playbackSpeed = 1.0f; // Scales emission time, not particles already out
+		float scale = 1.0f;			// Scales particle size and velocity
+	};
+
+	// Slot index in the low 16 bits, the slot's generation (never 0) above, so
+	// a removed emitter's handle stays dead after its slot is reused
+	using ParticleEmitterHandle = uint32_t;
+	constexpr ParticleEmitterHandle INVALID_PARTICLE_EMITTER = 0;
+
+	// ============================================================
+	// PARTICLE SYSTEM
+	// ============================================================
+	//
+	// Particles live in structure-of-arrays form and the live ones are kept
+	// packed at [0, GetAliveCount()), in no particular order: a particle that
+	// dies is replaced by the last live one. Update integrates and Render
+	// interpolates four particles at a time with SSE2 (scalar elsewhere),
+	// and Render writes its quads straight into Renderer2D's instanced ring.
+	// When the pool is full, new particles overwrite live ones round-robin.
+
 	class ParticleSystem
 	{
 	public:
 		ParticleSystem(int particleCount = 10000);
 		~ParticleSystem();
 
+		// Runs the emitters, moves every live particle and retires the ones
+		// whose life ran out
 		void Update(float timestamp);
 		void Render(Onyx::Renderer2D* renderer);
 
+		// One QuadInstance per live particle, placed like
+		// Renderer2D::RenderQuadInstanced(size, position, color, rotation)
+		void WriteQuads(QuadInstance* out) const;
+
 		void Emit(const ParticleProperties& props);
-		void Emitter(const ParticleProperties& props);
+		void Emit(const ParticleProperties& props, uint32_t count);
+
+		// Emitters. AddEmitter returns INVALID_PARTICLE_EMITTER past 65536 emitters
+		ParticleEmitterHandle AddEmitter(const ParticleEmitterSettings& settings);
+		void RemoveEmitter(ParticleEmitterHandle emitter);
+		// Null once removed; changes apply from the next Update
+		ParticleEmitterSettings* GetEmitterSettings(ParticleEmitterHandle emitter);
+		void SetEmitterPosition(ParticleEmitterHandle emitter, Onyx::Vector2D position);
+		void Play(ParticleEmitterHandle emitter);
+		void Stop(ParticleEmitterHandle emitter); // Emits nothing more; live particles finish
+		bool IsPlaying(ParticleEmitterHandle emitter) const;
+
+		uint32_t GetAliveCount() const { return m_AliveCount; }
+		uint32_t GetCapacity() const { return m_Capacity; }
 	private:
-		struct Particle
+		struct Emitter
 		{
-			Onyx::Vector2D position, velocity;
-			Onyx::Vector4D color, colorBegin, colorEnd;
+			ParticleEmitterSettings settings;
+			uint16_t generation = 1; // Bumped on removal
+			bool used = false;
+			bool playing = false;
+			float elapsed = 0.0f;
+			float rateAccumulator = 0.0f; // Fraction of a particle owed
+			float burstTimer = 0.0f;	  // Until the next burst
+		};
 
-			float sizeBegin, sizeEnd;
-			float rotation = 0.0f;
+		uint32_t AllocateParticle();
+		void CopyParticle(uint32_t from, uint32_t to);
+		void UpdateEmitters(float timestamp);
+		Emitter* FindEmitter(ParticleEmitterHandle emitter);
+		const Emitter* FindEmitter(ParticleEmitterHandle emitter) const;
+	private:
+		uint32_t m_Capacity = 0;
+		uint32_t m_AliveCount = 0;
+		uint32_t m_PoolIndex = 0; // Next live particle to overwrite when full
 
-			float lifetime = 1.0f;
-			float lifeRemaining = 1.0f;
+		std::vector<float> m_PositionX, m_PositionY;
+		std::vector<float> m_VelocityX, m_VelocityY;
+		std::vector<float> m_LifeRemaining, m_Lifetime;
+		std::vector<float> m_SizeBegin, m_SizeEnd;
+		std::vector<float> m_Rotation;
+		std::vector<float> m_ColorBegin[4], m_ColorEnd[4]; // r, g, b, a
 
-			bool active = false;
-		};
+		std::vector<uint32_t> m_Dead; // Scratch for Update, ascending
 
-		std::vector<Particle> m_ParticlePool;
-		int m_PoolIndex = 0;
+		std::vector<Emitter> m_Emitters; // Indexed by the handle's slot
 	};
 
-} // namespace Onyx
\ No newline at end of file
+} // namespace Onyx
@@ -2,30 +2,22 @@
 #include "pch.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstring>
 
 namespace Onyx {
 
 	Renderer2D::Renderer2D(Window& window, std::shared_ptr<Camera> camera)
-		: m_VAO(new Onyx::VertexArray), m_VBO(new Onyx::VertexBuffer(Renderer2DSpecification::VertexBufferSize)), m_Window(window), m_Camera(camera)
+		: m_VAO(new Onyx::VertexArray), m_VBO(nullptr), m_EBO(new Onyx::IndexBuffer(0u)), m_Window(window), m_Camera(camera)
 	{
 		m_DefaultShader = std::make_unique<Onyx::Shader>(
 			"MMOGame/assets/shaders/basic.vert",
 			"MMOGame/assets/shaders/basic.frag");
+		m_QuadShader = std::make_unique<Onyx::Shader>(
+			"MMOGame/assets/shaders/quad_instanced.vert",
+			"MMOGame/assets/shaders/basic.frag");
 
-		for (uint32_t i = 0; i < Renderer2DSpecification::IndexBufferSize; i += 6)
-		{
-			m_IndexBufferData[i + 0] = 0 + m_IndexBufferOffset;
-			m_IndexBufferData[i + 1] = 1 + m_IndexBufferOffset;
-			m_IndexBufferData[i + 2] = 2 + m_IndexBufferOffset;
-
-			m_IndexBufferData[i + 3] = 2 + m_IndexBufferOffset;
-			m_IndexBufferData[i + 4] = 3 + m_IndexBufferOffset;
-			m_IndexBufferData[i + 5] = 0 + m_IndexBufferOffset;
-
-			m_IndexBufferOffset += 4;
-		}
-
-		m_EBO = new IndexBuffer(m_IndexBufferData, Renderer2DSpecification::IndexBufferSize);
+		ReserveQuads(Renderer2DSpecification::InitialQuadCapacity);
+		CreateQuadRing(Renderer2DSpecification::InitialInstanceCapacity);
 	}
 
 	Renderer2D::~Renderer2D()
@@ -33,8 +25,6 @@ namespace Onyx {
 		delete m_VAO;
 		delete m_VBO;
 		delete m_EBO;
-		delete m_VertexBufferData;
-		delete m_IndexBufferData;
 	}
 
 	void Renderer2D::RenderQuad(Onyx::Vector2D size, Onyx::Vector3 position, Onyx::Vector4D color)
@@ -47,12 +37,10 @@ namespace Onyx {
 			size.x + position.x * 2, -size.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f,
 			-size.x + position.x * 2, -size.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f};
 
-		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-			m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+		std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 		m_VertexCount += 4;
 		m_IndexCount += 6;
-		m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
 
 		// Use default shader for colored quads
 		m_Shader = m_DefaultShader.get();
@@ -69,12 +57,10 @@ namespace Onyx {
 			size.x + position.x, -size.y * aspectRatio + position.y, position.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, (float)textureUnit,
 			-size.x + position.x, -size.y * aspectRatio + position.y, position.z, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, (float)textureUnit};
 
-		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-			m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+		std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 		m_VertexCount += 4;
 		m_IndexCount += 6;
-		m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
 
 		m_Shader = shader;
 		m_TextureUnits[textureUnit] = textureUnit;
@@ -98,12 +84,10 @@ namespace Onyx {
 			size.x + position.x * 2, size.y + position.y * 2, position.z, 1.0f, 1.0f, 1.0f, 1.0f, spriteUV[2].x, spriteUV[2].y, (float)textureUnit,
 			-size.x + position.x * 2, size.y + position.y * 2, position.z, 1.0f, 1.0f, 1.0f, 1.0f, spriteUV[3].x, spriteUV[3].y, (float)textureUnit};
 
-		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-			m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+		std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 		m_VertexCount += 4;
 		m_IndexCount += 6;
-		m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
 
 		m_Shader = shader;
 		m_TextureUnits[textureUnit] = textureUnit;
@@ -144,12 +128,10 @@ namespace Onyx {
 			left, bottom, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, uvMin.x, uvMax.y, (float)textureUnit   // Bottom-left
 		};
 
-		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-			m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+		std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 		m_VertexCount += 4;
 		m_IndexCount += 6;
-		m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
 
 		m_TextureUnits[textureUnit] = textureUnit;
 		glBindTextureUnit(textureUnit, texture->GetTextureID());
@@ -160,6 +142,8 @@ namespace Onyx {
 		if (m_VertexCount == 0)
 			return;
 
+		ReserveQuads(m_VertexCount / Renderer2DSpecification::Vertices);
+
 		m_VAO->Bind();
 		m_VBO->Bind();
 		m_EBO->Bind();
@@ -169,7 +153,7 @@ namespace Onyx {
 		m_VAO->AddBuffer(2, sizeof(BufferDisposition) / sizeof(float), offsetof(BufferDisposition, texCoord), 2);
 		m_VAO->AddBuffer(1, sizeof(BufferDisposition) / sizeof(float), offsetof(BufferDisposition, texIndex), 3);
 
-		glBufferSubData(GL_ARRAY_BUFFER, 0, m_VertexCount * sizeof(BufferDisposition), m_VertexBufferData);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, m_VertexCount * sizeof(BufferDisposition), m_VertexBufferData.data());
 
 		m_VBO->UnBind();
 		m_VAO->UnBind();
@@ -219,7 +203,6 @@ namespace Onyx {
 		m_IndexCount = 0;
 		m_VertexCount = 0;
 		m_VertexBufferOffset = 0;
-		CleanBuffer();
 		CleanTextureUnits();
 
 		m_ScreenSpaceMode = false;
@@ -276,12 +259,10 @@ namespace Onyx {
 
 			// angle += 90 / subdivision;
 
-			for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-				m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+			std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 			m_VertexCount += 4;
 			m_IndexCount += 6;
-			m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
 		}
 	}
 
@@ -300,14 +281,11 @@ namespace Onyx {
 			bottomRight.x + position.x * 2, bottomRight.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f,
 			bottomLeft.x + position.x * 2, bottomLeft.y * aspectRatio + position.y * 2, position.z, color.x, color.y, color.z, color.w, 0.0f, 0.0f, -1.0f};
 
-		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-			m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+		std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 		m_VertexCount += 4;
 		m_IndexCount += 6;
 
-		m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
-
 		m_Shader = m_DefaultShader.get();
 	}
 
@@ -327,12 +305,10 @@ namespace Onyx {
 			bottomRight.x + position.x, bottomRight.y * aspectRatio + position.y, position.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, (float)textureUnit,
 			bottomLeft.x + position.x, bottomLeft.y * aspectRatio + position.y, position.z, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, (float)textureUnit};
 
-		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-			m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+		std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 		m_VertexCount += 4;
 		m_IndexCount += 6;
-		m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
 
 		m_Shader = shader;
 		m_TextureUnits[textureUnit] = textureUnit;
@@ -361,12 +337,10 @@ namespace Onyx {
 			bottomRight.x + position.x, bottomRight.y * aspectRatio + position.y, position.z, 0.0f, 0.0f, 0.0f, 0.0f, spriteUV[1].x, spriteUV[1].y, (float)textureUnit,
 			bottomLeft.x + position.x, bottomLeft.y * aspectRatio + position.y, position.z, 0.0f, 0.0f, 0.0f, 0.0f, spriteUV[0].x, spriteUV[0].y, (float)textureUnit};
 
-		for (uint32_t i = 0; i < sizeof(vertices) / sizeof(float); i++)
-			m_VertexBufferData[m_VertexBufferOffset + i] = vertices[i];
+		std::memcpy(PushVertices(sizeof(vertices) / sizeof(float)), vertices, sizeof(vertices));
 
 		m_VertexCount += 4;
 		m_IndexCount += 6;
-		m_VertexBufferOffset += sizeof(vertices) / sizeof(float);
 
 		m_Shader = shader;
 		m_TextureUnits[textureUnit] = textureUnit;
@@ -375,9 +349,15 @@ namespace Onyx {
 
 	void Renderer2D::Flush()
 	{
-		if (m_IndexCount == 0)
-			return; // Nothing to draw
+		if (m_IndexCount > 0)
+			FlushVertexBatch();
+		FlushInstanced();
 
+		CleanTextureUnits();
+	}
+
+	void Renderer2D::FlushVertexBatch()
+	{
 		m_Stats.DrawCalls++;
 
 		if (m_Shader != nullptr)
@@ -385,20 +365,17 @@ namespace Onyx {
 			m_Shader->Bind();
 
 			// Set up orthographic projection matrix for 2D rendering
-			auto camera = m_Camera.lock();
-			if (camera)
+			if (!m_Camera.expired())
 			{
-				float aspectRatio = m_Window.GetAspectRatio();
-				glm::mat4 projection = glm::ortho(-aspectRatio, aspectRatio, -1.0f, 1.0f, -1.0f, 100.0f);
-				glm::mat4 view = camera->GetViewMatrix();
-				glm::mat4 viewProjection = projection * view;
-
+				glm::mat4 viewProjection = GetViewProjection();
 				glUniformMatrix4fv(glGetUniformLocation(m_Shader->GetProgramID(), "u_ViewProjection"), 1, GL_FALSE, glm::value_ptr(viewProjection));
 			}
 
 			glUniform1iv(glGetUniformLocation(m_Shader->GetProgramID(), "u_Textures"), Renderer2DSpecification::MaxTextureUnits, m_TextureUnits);
 		}
 
+		ReserveQuads(m_VertexCount / Renderer2DSpecification::Vertices);
+
 		m_VAO->Bind();
 		m_VBO->Bind();
 		m_EBO->Bind();
@@ -408,7 +385,7 @@ namespace Onyx {
 		m_VAO->AddBuffer(2, sizeof(BufferDisposition) / sizeof(float), offsetof(BufferDisposition, texCoord), 2);
 		m_VAO->AddBuffer(1, sizeof(BufferDisposition) / sizeof(float), offsetof(BufferDisposition, texIndex), 3);
 
-		glBufferSubData(GL_ARRAY_BUFFER, 0, m_VertexCount * sizeof(BufferDisposition), m_VertexBufferData);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, m_VertexCount * sizeof(BufferDisposition), m_VertexBufferData.data());
 		glDrawElements(GL_TRIANGLES, m_IndexCount, GL_UNSIGNED_INT, nullptr);
 
 		if (m_Shader != nullptr)
@@ -420,20 +397,221 @@ namespace Onyx {
 		m_IndexCount = 0;
 		m_VertexCount = 0;
 		m_VertexBufferOffset = 0;
-		CleanBuffer();
-		CleanTextureUnits();
 	}
 
-	void Renderer2D::CleanBuffer()
+	// ============================================================
+	// INSTANCED QUADS
+	// ============================================================
+
+	void Renderer2D::RenderQuadInstanced(Onyx::Vector2D size, Onyx::Vector3 position, Onyx::Vector4D color, float rotation)
+	{
+		// Written field by field: the record lives in write-combined GPU memory
+		QuadInstance* quad = AllocateQuads(1);
+		quad->position = {position.x * 2, position.y * 2, position.z};
+		quad->rotation = rotation;
+		quad->halfSize = {size.x, size.y};
+		quad->uvRect = {0.0f, 0.0f, 1.0f, 1.0f};
+		quad->color = PackQuadColor(color);
+		quad->texIndex = -1.0f;
+	}
+
+	void Renderer2D::RenderQuadInstanced(Onyx::Vector2D size, Onyx::Vector3 position, const Onyx::Texture& texture, Onyx::Vector2D uvMin, Onyx::Vector2D uvMax, float rotation)
 	{
-		for (uint32_t i = 0; i < sizeof(Renderer2DSpecification::VertexBufferSize); i++)
-			m_VertexBufferData[i] = 0.0f;
+		const int textureUnit = BindTexture(texture);
+
+		QuadInstance* quad = AllocateQuads(1);
+		quad->position = {position.x, position.y, position.z};
+		quad->rotation = rotation;
+		quad->halfSize = {size.x, size.y};
+		quad->uvRect = {uvMin.x, uvMin.y, uvMax.x, uvMax.y};
+		quad->color = 0xFFFFFFFF;
+		quad->texIndex = static_cast<float>(textureUnit);
+	}
+
+	QuadInstance* Renderer2D::AllocateQuads(uint32_t count)
+	{
+		// Painter's order: vertex quads submitted before these draw first
+		if (m_IndexCount > 0 && !m_ScreenSpaceMode)
+			FlushVertexBatch();
+
+		const size_t sizeBytes = static_cast<size_t>(count) * sizeof(QuadInstance);
+		size_t offset = 0;
+		void* data = m_QuadRing->Allocate(sizeBytes, offset);
+		if (!data)
+		{
+			// The region is full: draw what it holds and continue in the next
+			// one. If this batch alone filled it, regions are smaller than the
+			// batches actually drawn, so start over with a bigger ring.
+			const uint32_t regionFirstQuad = static_cast<uint32_t>(m_QuadRing->GetRegionStart() / sizeof(QuadInstance));
+			const bool outgrown = count > m_QuadsPerRegion || (m_PendingQuadCount > 0 && m_PendingFirstQuad == regionFirstQuad);
+			const uint32_t neededQuads = m_PendingQuadCount + count;
+
+			FlushInstanced();
+			if (outgrown)
+				CreateQuadRing(std::max(m_QuadsPerRegion * 2, neededQuads));
+			else
+				m_QuadRing->NextRegion();
+
+			// Fits: the region is empty and holds at least `count` records
+			data = m_QuadRing->Allocate(sizeBytes, offset);
+		}
+
+		if (m_PendingQuadCount == 0)
+			m_PendingFirstQuad = static_cast<uint32_t>(offset / sizeof(QuadInstance));
+		m_PendingQuadCount += count;
+		m_Stats.QuadCount += count;
+		return static_cast<QuadInstance*>(data);
+	}
+
+	void Renderer2D::FlushInstanced()
+	{
+		if (m_PendingQuadCount == 0)
+			return;
+
+		m_Stats.DrawCalls++;
+
+		m_QuadShader->Bind();
+		const uint32_t programID = m_QuadShader->GetProgramID();
+		glm::mat4 viewProjection = GetViewProjection();
+		glUniformMatrix4fv(glGetUniformLocation(programID, "u_ViewProjection"), 1, GL_FALSE, glm::value_ptr(viewProjection));
+		glUniform2f(glGetUniformLocation(programID, "u_CornerScale"), 1.0f, m_Window.GetAspectRatio());
+		glUniform1iv(glGetUniformLocation(programID, "u_Textures"), Renderer2DSpecification::MaxTextureUnits, m_TextureUnits);
+
+		// Records are read straight from the ring; baseInstance picks the batch
+		m_QuadRing->CommitWrites();
+		m_QuadVAO->Bind();
+		glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, m_PendingQuadCount, m_PendingFirstQuad);
+		m_QuadVAO->UnBind();
+		m_QuadShader->UnBind();
+
+		m_PendingFirstQuad += m_PendingQuadCount;
+		m_PendingQuadCount = 0;
+	}
+
+	void Renderer2D::CreateQuadRing(uint32_t quadsPerRegion)
+	{
+		m_QuadRing = std::make_unique<PersistentRingBuffer>(static_cast<size_t>(quadsPerRegion) * sizeof(QuadInstance));
+		m_QuadsPerRegion = quadsPerRegion;
+		m_PendingFirstQuad = 0;
+		m_PendingQuadCount = 0;
+
+		struct InstanceAttribute
+		{
+			GLint componentCount;
+			GLenum type;
+			GLboolean normalized;
+			size_t offset;
+		};
+		const InstanceAttribute attributes[] = {
+			{3, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, position)},
+			{1, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, rotation)},
+			{2, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, halfSize)},
+			{4, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, uvRect)},
+			{4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(QuadInstance, color)},
+			{1, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, texIndex)},
+		};
+
+		// One record per instance; the corners come from gl_VertexID
+		m_QuadVAO = std::make_unique<VertexArray>();
+		m_QuadVAO->Bind();
+		m_QuadRing->Bind();
+		for (GLuint i = 0; i < std::size(attributes); i++)
+		{
+			glEnableVertexAttribArray(i);
+			glVertexAttribPointer(i, attributes[i].componentCount, attributes[i].type, attributes[i].normalized,
+								  sizeof(QuadInstance), (const void*)(uintptr_t)attributes[i].offset);
+			glVertexAttribDivisor(i, 1);
+		}
+		m_QuadVAO->UnBind();
+		m_QuadRing->UnBind();
+	}
+
+	// ============================================================
+	// BUFFERS
+	// ============================================================
+
+	float* Renderer2D::PushVertices(uint32_t floatCount)
+	{
+		// Painter's order: instanced quads submitted before these draw first
+		if (m_PendingQuadCount > 0 && !m_ScreenSpaceMode)
+			FlushInstanced();
+
+		if (m_VertexBufferOffset + floatCount > m_VertexBufferData.size())
+			m_VertexBufferData.resize(std::max<size_t>(m_VertexBufferData.size() * 2, m_VertexBufferOffset + floatCount));
+
+		float* out = m_VertexBufferData.data() + m_VertexBufferOffset;
+		m_VertexBufferOffset += floatCount;
+		return out;
+	}
+
+	// Grows the vertex batch's GPU buffers to the largest batch drawn so far.
+	// The index pattern never changes, so it is only rebuilt here.
+	void Renderer2D::ReserveQuads(uint32_t quadCount)
+	{
+		if (quadCount <= m_QuadCapacity)
+			return;
+
+		const uint32_t capacity = std::max(quadCount, m_QuadCapacity * 2);
+
+		// Keep whichever VAO is bound from picking up m_EBO below
+		m_VAO->UnBind();
+
+		delete m_VBO;
+		m_VBO = new Onyx::VertexBuffer(capacity * Renderer2DSpecification::Vertices * sizeof(BufferDisposition));
+
+		std::vector<uint32_t> indices(static_cast<size_t>(capacity) * 6);
+		for (uint32_t quad = 0; quad < capacity; quad++)
+		{
+			const uint32_t first = quad * Renderer2DSpecification::Vertices;
+			uint32_t* out = &indices[quad * 6];
+			out[0] = first + 0;
+			out[1] = first + 1;
+			out[2] = first + 2;
+
+			out[3] = first + 2;
+			out[4] = first + 3;
+			out[5] = first + 0;
+		}
+		m_EBO->SetData(indices.data(), static_cast<uint32_t>(indices.size() * sizeof(uint32_t)));
+
+		m_QuadCapacity = capacity;
+	}
+
+	int Renderer2D::BindTexture(const Onyx::Texture& texture)
+	{
+		const int textureUnit = texture.GetTextureID() - 1;
+		if (textureUnit < 0 || textureUnit >= static_cast<int>(Renderer2DSpecification::MaxTextureUnits))
+			return -1;
+
+		// Once per texture and Flush rather than once per quad
+		if (m_BoundTextures[textureUnit] != texture.GetTextureID())
+		{
+			glBindTextureUnit(textureUnit, texture.GetTextureID());
+			m_BoundTextures[textureUnit] = texture.GetTextureID();
+		}
+		m_TextureUnits[textureUnit] = textureUnit;
+		return textureUnit;
+	}
+
+	glm::mat4 Renderer2D::GetViewProjection() const
+	{
+		auto camera = m_Camera.lock();
+		if (!camera)
+			return glm::mat4(1.0f);
+
+		float aspectRatio = m_Window.GetAspectRatio();
+		glm::mat4 projection = glm::ortho(-aspectRatio, aspectRatio, -1.0f, 1.0f, -1.0f, 100.0f);
+		glm::mat4 view = camera->GetViewMatrix();
+		return projection * view;
 	}
 
 	void Renderer2D::CleanTextureUnits()
 	{
 		for (uint32_t i = 0; i < Renderer2DSpecification::MaxTextureUnits; i++)
+		{
 			m_TextureUnits[i] = 0;
+			m_BoundTextures[i] = 0;
+		}
 	}
 
 } // namespace Onyx
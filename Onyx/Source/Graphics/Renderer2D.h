@@ -5,7 +5,9 @@
 #include "Maths/Maths.h"
 #include "Shader.h"
 #include "Texture.h"
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "Graphics/Window.h"
 
@@ -19,12 +21,33 @@ namespace Onyx {
 		float texIndex;
 	};
 
+	// One quad of the instanced path, expanded to its 4 corners by
+	// quad_instanced.vert: 48 bytes instead of 4 BufferDispositions (160)
+	// plus 6 indices
+	struct QuadInstance
+	{
+		glm::vec3 position{0.0f}; // Center
+		float rotation = 0.0f; // Degrees, clockwise like RenderRotatedQuad
+		glm::vec2 halfSize{0.0f};
+		glm::vec4 uvRect{0.0f, 0.0f, 1.0f, 1.0f}; // uMin, vMin (bottom left), uMax, vMax (top right)
+		uint32_t color = 0xFFFFFFFF; // RGBA8, red in the low byte
+		float texIndex = -1.0f; // Texture unit, -1 = color only
+	};
+	static_assert(sizeof(QuadInstance) == 48, "QuadInstance layout is mirrored by quad_instanced.vert");
+
+	inline uint32_t PackQuadColor(const Onyx::Vector4D& color)
+	{
+		auto channel = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+		return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(color.w) << 24);
+	}
+
 	struct Renderer2DSpecification
 	{
-		static const uint32_t MaxQuads = 400 * 400;
 		static const uint32_t Vertices = 4;
-		static const uint32_t IndexBufferSize = MaxQuads * Vertices * 6;
-		static const uint32_t VertexBufferSize = MaxQuads * Vertices * sizeof(BufferDisposition);
+
+		// Starting sizes; both paths grow to the largest batch actually drawn
+		static const uint32_t InitialQuadCapacity = 1024;
+		static const uint32_t InitialInstanceCapacity = 4096; // Per ring region
 
 		static const uint32_t MaxTextureUnits = 32;
 	};
@@ -71,6 +94,20 @@ namespace Onyx {
 		void RenderRotatedQuad(Onyx::Vector2D size, Onyx::Vector3 position, const Onyx::Texture& texture, const Onyx::Shader* shader, float rotation);
 		void RenderRotatedQuad(Onyx::Vector2D size, Onyx::Vector3 position, const Onyx::Texture& texture, const Onyx::Shader* shader, Onyx::Vector2D spriteCoord, Onyx::Vector2D spriteSize, float rotation);
 
+		// Instanced quads: records go straight into a persistently mapped ring
+		// buffer and are drawn with one instanced draw per run; corners,
+		// rotation and UVs are worked out on the GPU. Placement matches the
+		// vertex-batch overload with the same arguments. Switching between
+		// these and the vertex batch draws what the other has pending, so
+		// quads draw in submission order; interleaving costs a draw per switch.
+		void RenderQuadInstanced(Onyx::Vector2D size, Onyx::Vector3 position, Onyx::Vector4D color, float rotation = 0.0f);
+		void RenderQuadInstanced(Onyx::Vector2D size, Onyx::Vector3 position, const Onyx::Texture& texture, Onyx::Vector2D uvMin, Onyx::Vector2D uvMax, float rotation = 0.0f);
+
+		// Space for `count` records, never null; fill them in before the next
+		// AllocateQuads, vertex-batch submit or Flush
+		QuadInstance* AllocateQuads(uint32_t count);
+		void SubmitQuad(const QuadInstance& quad) { *AllocateQuads(1) = quad; }
+
 		void Flush();
 
 		std::weak_ptr<Onyx::Camera> GetCamera() const { return m_Camera; }
@@ -82,26 +119,42 @@ namespace Onyx {
 		Renderer2DStats& GetStats() { return m_Stats; }
 		void ResetStats() { m_Stats.Reset(); }
 	private:
-		void CleanBuffer();
 		void CleanTextureUnits();
+
+		void FlushVertexBatch();
+		float* PushVertices(uint32_t floatCount);
+		void ReserveQuads(uint32_t quadCount);
+		int BindTexture(const Onyx::Texture& texture);
+
+		void CreateQuadRing(uint32_t quadsPerRegion);
+		void FlushInstanced();
+		glm::mat4 GetViewProjection() const;
 	private:
-		float* m_VertexBufferData = new float[Renderer2DSpecification::VertexBufferSize];
-		uint32_t* m_IndexBufferData = new uint32_t[Renderer2DSpecification::IndexBufferSize];
+		std::vector<float> m_VertexBufferData;
 
 		VertexArray* m_VAO;
 		VertexBuffer* m_VBO;
 		IndexBuffer* m_EBO;
+		uint32_t m_QuadCapacity = 0; // Quads m_VBO and m_EBO hold
 
 		uint32_t m_IndexCount = 0;
 		uint32_t m_VertexCount = 0;
 
-		uint32_t m_VertexBufferOffset = 0;
-		uint32_t m_IndexBufferOffset = 0;
+		uint32_t m_VertexBufferOffset = 0; // Floats written to m_VertexBufferData
 
-		int32_t m_TextureUnits[Renderer2DSpecification::MaxTextureUnits];
+		int32_t m_TextureUnits[Renderer2DSpecification::MaxTextureUnits] = {};
+		uint32_t m_BoundTextures[Renderer2DSpecification::MaxTextureUnits] = {}; // Texture ID per unit since the last Flush
 		const Onyx::Shader* m_Shader = nullptr;
 		std::unique_ptr<Onyx::Shader> m_DefaultShader;
 
+		// Instanced path
+		std::unique_ptr<PersistentRingBuffer> m_QuadRing;
+		std::unique_ptr<VertexArray> m_QuadVAO;
+		std::unique_ptr<Onyx::Shader> m_QuadShader;
+		uint32_t m_QuadsPerRegion = 0;
+		uint32_t m_PendingFirstQuad = 0; // First record Flush has not drawn
+		uint32_t m_PendingQuadCount = 0;
+
 		std::weak_ptr<Onyx::Camera> m_Camera;
 
 		Window& m_Window;
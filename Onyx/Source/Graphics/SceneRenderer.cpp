@@ -2,6 +2,7 @@
 #include "RenderCommand.h"
 #include "pch.h"
 #include <GL/glew.h>
+#include <algorithm>
 #include <cstdio>
 #include <limits>
 
@@ -52,6 +53,7 @@ namespace Onyx {
 
 		m_StaticBatches.clear();
 		m_SkinnedQueue.clear();
+		m_SkinnedPalette.clear();
 		m_PointLights.clear();
 		m_SpotLights.clear();
 		m_Stats = {};
@@ -69,6 +71,8 @@ namespace Onyx {
 	void SceneRenderer::SetShadowDistance(float distance) { m_ShadowDistance = distance; }
 	void SceneRenderer::SetSplitLambda(float lambda) { m_SplitLambda = lambda; }
 	void SceneRenderer::SetShowCascades(bool show) { m_ShowCascades = show; }
+	void SceneRenderer::SetLodErrorThreshold(float threshold) { m_LodErrorThreshold = threshold; }
+	void SceneRenderer::SetShadowLodBias(float bias) { m_ShadowLodBias = bias; }
 
 	void SceneRenderer::SetShadowMapSize(uint32_t resolution)
 	{
@@ -118,23 +122,167 @@ namespace Onyx {
 		TransformAABB(mesh.GetBoundsMin(), mesh.GetBoundsMax(), worldTransform, wMin, wMax);
 		batch.bounds.push_back({wMin, wMax});
 
+		float worldScale = 0.0f;
+		for (int c = 0; c < 3; c++)
+		{
+			worldScale = std::max(worldScale, glm::length(glm::vec3(worldTransform[c])));
+		}
+		batch.lodSources.push_back({&info, worldScale});
+
 		batch.totalTriangles += info.indexCount / 3;
 	}
 
+	StaticInstanceHandle SceneRenderer::RegisterStatic(Model* model, uint32_t meshIndex,
+													   const glm::mat4& worldTransform,
+													   const std::string& albedoPath,
+													   const std::string& normalPath)
+	{
+		if (!model)
+			return {};
+		if (!model->HasMergedBuffers())
+			model->BuildMergedBuffers();
+		if (!model->HasMergedBuffers())
+			return {};
+
+		const auto& merged = model->GetMergedBuffers();
+		if (meshIndex >= merged.meshInfos.size())
+			return {};
+
+		// Material strings are hashed once here, never per frame
+		uint64_t key = MakeBatchKey(model, albedoPath, normalPath);
+		auto [it, inserted] = m_RetainedBatchLookup.try_emplace(key, static_cast<uint32_t>(m_RetainedBatches.size()));
+		if (inserted)
+		{
+			RetainedBatch batch;
+			batch.model = model;
+			batch.albedoPath = albedoPath;
+			batch.normalPath = normalPath;
+			m_RetainedBatches.push_back(std::move(batch));
+		}
+
+		uint32_t index;
+		if (!m_FreeStaticInstances.empty())
+		{
+			index = m_FreeStaticInstances.back();
+			m_FreeStaticInstances.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_StaticInstances.size());
+			m_StaticInstances.emplace_back();
+		}
+
+		const auto& info = merged.meshInfos[meshIndex];
+		const auto& mesh = model->GetMeshes()[meshIndex];
+
+		StaticInstance& instance = m_StaticInstances[index];
+		instance.batch = it->second;
+		instance.alive = true;
+		instance.command = {info.indexCount, 1, info.firstIndex, info.baseVertex, 0};
+		instance.lodSource.info = &info;
+		instance.localMin = mesh.GetBoundsMin();
+		instance.localMax = mesh.GetBoundsMax();
+		SetStaticTransform(instance, worldTransform);
+
+		m_StaticBvh.Insert(index, instance.bounds.worldMin, instance.bounds.worldMax);
+		return {index, instance.generation};
+	}
+
+	void SceneRenderer::UpdateStatic(StaticInstanceHandle handle, const glm::mat4& worldTransform)
+	{
+		StaticInstance* instance = GetStaticInstance(handle);
+		if (!instance)
+			return;
+
+		SetStaticTransform(*instance, worldTransform);
+		m_StaticBvh.Update(handle.index, instance->bounds.worldMin, instance->bounds.worldMax);
+	}
+
+	void SceneRenderer::UnregisterStatic(StaticInstanceHandle handle)
+	{
+		StaticInstance* instance = GetStaticInstance(handle);
+		if (!instance)
+			return;
+
+		instance->alive = false;
+		instance->generation++;
+		m_StaticBvh.Remove(handle.index);
+		m_FreeStaticInstances.push_back(handle.index);
+	}
+
+	void SceneRenderer::ClearStatic()
+	{
+		// Bump generations rather than dropping slots so old handles stay stale
+		m_FreeStaticInstances.clear();
+		for (uint32_t i = 0; i < m_StaticInstances.size(); i++)
+		{
+			StaticInstance& instance = m_StaticInstances[i];
+			if (instance.alive)
+			{
+				instance.alive = false;
+				instance.generation++;
+			}
+			m_FreeStaticInstances.push_back(i);
+		}
+		m_StaticBvh.Clear();
+	}
+
+	SceneRenderer::StaticInstance* SceneRenderer::GetStaticInstance(StaticInstanceHandle handle)
+	{
+		if (handle.index >= m_StaticInstances.size())
+			return nullptr;
+		StaticInstance& instance = m_StaticInstances[handle.index];
+		if (!instance.alive || instance.generation != handle.generation)
+			return nullptr;
+		return &instance;
+	}
+
+	void SceneRenderer::SetStaticTransform(StaticInstance& instance, const glm::mat4& worldTransform)
+	{
+		instance.drawData.model = worldTransform;
+		TransformAABB(instance.localMin, instance.localMax, worldTransform,
+					  instance.bounds.worldMin, instance.bounds.worldMax);
+
+		float worldScale = 0.0f;
+		for (int c = 0; c < 3; c++)
+		{
+			worldScale = std::max(worldScale, glm::length(glm::vec3(worldTransform[c])));
+		}
+		instance.lodSource.worldScale = worldScale;
+	}
+
 	void SceneRenderer::SubmitSkinned(AnimatedModel* model,
 									  const glm::mat4& worldTransform,
 									  const std::vector<glm::mat4>& boneMatrices,
 									  const std::string& albedoPath,
 									  const std::string& normalPath)
 	{
-		if (!model)
+		uint32_t offset = ReserveSkinned(model, worldTransform, static_cast<uint32_t>(boneMatrices.size()),
+										 albedoPath, normalPath);
+		if (offset == INVALID_PALETTE_OFFSET)
 			return;
+
+		std::copy(boneMatrices.begin(), boneMatrices.end(), m_SkinnedPalette.begin() + offset);
+	}
+
+	uint32_t SceneRenderer::ReserveSkinned(AnimatedModel* model,
+										   const glm::mat4& worldTransform,
+										   uint32_t boneCount,
+										   const std::string& albedoPath,
+										   const std::string& normalPath)
+	{
+		if (!model)
+			return INVALID_PALETTE_OFFSET;
 		if (!model->HasMergedBuffers())
 			model->BuildMergedBuffers();
 		if (!model->HasMergedBuffers())
-			return;
+			return INVALID_PALETTE_OFFSET;
 
-		m_SkinnedQueue.push_back({model, worldTransform, boneMatrices, albedoPath, normalPath});
+		uint32_t offset = static_cast<uint32_t>(m_SkinnedPalette.size());
+		m_SkinnedPalette.resize(m_SkinnedPalette.size() + boneCount, glm::mat4(1.0f));
+		m_SkinnedQueue.push_back({model, worldTransform, offset, boneCount, albedoPath, normalPath});
+		m_SkinnedBatchesDirty = true;
+		return offset;
 	}
 
 	void SceneRenderer::RenderShadows(ShadowCasterCallback extraShadows)
@@ -225,6 +373,8 @@ namespace Onyx {
 		RenderCommand::EnablePolygonOffset(4.0f, 4.0f);
 
 		const auto& skinnedBatches = GetOrBuildSkinnedBatches();
+		if (!skinnedBatches.empty())
+			UploadSkinnedPalette();
 
 		// Reusable scratch vectors — avoid per-batch heap allocation
 		std::vector<StaticDrawData> culledData;
@@ -251,7 +401,9 @@ namespace Onyx {
 					if (cascadeFrustum.IsBoxVisible(batch.bounds[i].worldMin, batch.bounds[i].worldMax))
 					{
 						culledData.push_back(batch.drawData[i]);
-						culledCmds.push_back(batch.commands[i]);
+						culledCmds.push_back(SelectStaticLod(batch.commands[i], batch.lodSources[i], batch.bounds[i],
+															 m_LodErrorThreshold * m_ShadowLodBias));
+						m_Stats.shadowLodTrianglesSaved += (batch.commands[i].count - culledCmds.back().count) / 3;
 					}
 				}
 
@@ -266,6 +418,21 @@ namespace Onyx {
 										   static_cast<uint32_t>(culledCmds.size()));
 			}
 
+			CollectVisibleStatic(cascadeFrustum, m_LodErrorThreshold * m_ShadowLodBias,
+								 m_Stats.shadowLodTrianglesSaved);
+			for (auto& batch : m_RetainedBatches)
+			{
+				if (batch.visibleCommands.empty())
+					continue;
+
+				m_StaticSSBO->Upload(batch.visibleData.data(),
+									 batch.visibleData.size() * sizeof(StaticDrawData), 0);
+				m_StaticCmdBO->Upload(batch.visibleCommands.data(),
+									  batch.visibleCommands.size() * sizeof(DrawIndirectCommand));
+				RenderCommand::DrawBatched(*batch.model->GetMergedBuffers().vao,
+										   static_cast<uint32_t>(batch.visibleCommands.size()));
+			}
+
 			m_StaticCmdBO->UnBind();
 			m_StaticSSBO->UnBind();
 
@@ -273,11 +440,10 @@ namespace Onyx {
 			{
 				m_SkinnedShadowShader->Bind();
 				m_SkinnedShadowShader->SetMat4("u_LightSpaceMatrix", lightSpaceMat);
+				m_BoneSSBO->BindBase(1);
 
 				for (const auto& [key, batch] : skinnedBatches)
 				{
-					m_BoneSSBO->Upload(batch.packedBones.data(),
-									   batch.packedBones.size() * sizeof(glm::mat4), 1);
 					m_SkinnedSSBO->Upload(batch.drawData.data(),
 										  batch.drawData.size() * sizeof(SkinnedDrawData), 0);
 					m_SkinnedCmdBO->Upload(batch.commands.data(),
@@ -303,7 +469,7 @@ namespace Onyx {
 
 	void SceneRenderer::RenderStaticPass()
 	{
-		if (m_StaticBatches.empty())
+		if (m_StaticBatches.empty() && m_StaticBvh.GetItemCount() == 0)
 			return;
 
 		std::vector<StaticDrawData> culledData;
@@ -319,6 +485,26 @@ namespace Onyx {
 		UploadLightUniforms(m_StaticBatchedShader.get());
 		UploadShadowUniforms(m_StaticBatchedShader.get());
 
+		auto drawBatch = [&](Model* model, const std::string& albedoPath, const std::string& normalPath,
+							 const std::vector<StaticDrawData>& data, const std::vector<DrawIndirectCommand>& cmds) {
+			BindStaticMaterial(albedoPath, normalPath);
+
+			uint32_t drawCount = static_cast<uint32_t>(cmds.size());
+
+			m_StaticSSBO->Upload(data.data(), data.size() * sizeof(StaticDrawData), 0);
+			m_StaticCmdBO->Upload(cmds.data(), cmds.size() * sizeof(DrawIndirectCommand));
+
+			RenderCommand::DrawBatched(*model->GetMergedBuffers().vao, drawCount);
+
+			m_Stats.batchedMeshCount += drawCount;
+			m_Stats.batchedDrawCalls++;
+			for (const auto& cmd : cmds)
+			{
+				m_Stats.triangles += cmd.count / 3;
+			}
+		};
+
+		// Immediate submissions: linear cull
 		for (auto& [key, batch] : m_StaticBatches)
 		{
 			culledData.clear();
@@ -327,14 +513,14 @@ namespace Onyx {
 			uint32_t totalMeshes = static_cast<uint32_t>(batch.bounds.size());
 			m_Stats.meshesSubmitted += totalMeshes;
 
-			uint32_t culledTriangles = 0;
 			for (size_t i = 0; i < batch.bounds.size(); i++)
 			{
 				if (m_CameraFrustum.IsBoxVisible(batch.bounds[i].worldMin, batch.bounds[i].worldMax))
 				{
 					culledData.push_back(batch.drawData[i]);
-					culledCmds.push_back(batch.commands[i]);
-					culledTriangles += batch.commands[i].count / 3;
+					culledCmds.push_back(SelectStaticLod(batch.commands[i], batch.lodSources[i], batch.bounds[i],
+														 m_LodErrorThreshold));
+					m_Stats.lodTrianglesSaved += (batch.commands[i].count - culledCmds.back().count) / 3;
 				}
 			}
 
@@ -343,33 +529,21 @@ namespace Onyx {
 			if (culledCmds.empty())
 				continue;
 
-			Texture* albedo = m_AssetManager->ResolveTexture(batch.albedoPath);
-			Texture* normal = m_AssetManager->ResolveTexture(batch.normalPath);
-			(albedo ? albedo : m_AssetManager->GetDefaultAlbedo())->Bind(0);
-
-			if (normal)
-			{
-				normal->Bind(1);
-				m_StaticBatchedShader->SetInt("u_UseNormalMap", 1);
-			}
-			else
-			{
-				m_AssetManager->GetDefaultNormal()->Bind(1);
-				m_StaticBatchedShader->SetInt("u_UseNormalMap", 0);
-			}
-
-			uint32_t drawCount = static_cast<uint32_t>(culledCmds.size());
-
-			m_StaticSSBO->Upload(culledData.data(),
-								 culledData.size() * sizeof(StaticDrawData), 0);
-			m_StaticCmdBO->Upload(culledCmds.data(),
-								  culledCmds.size() * sizeof(DrawIndirectCommand));
+			drawBatch(batch.model, batch.albedoPath, batch.normalPath, culledData, culledCmds);
+		}
 
-			RenderCommand::DrawBatched(*batch.model->GetMergedBuffers().vao, drawCount);
+		// Retained instances: BVH traversal writes each batch's command list
+		const uint32_t retainedCount = m_StaticBvh.GetItemCount();
+		const uint32_t retainedVisible = CollectVisibleStatic(m_CameraFrustum, m_LodErrorThreshold,
+															   m_Stats.lodTrianglesSaved);
+		m_Stats.meshesSubmitted += retainedCount;
+		m_Stats.meshesCulled += retainedCount - retainedVisible;
 
-			m_Stats.batchedMeshCount += drawCount;
-			m_Stats.batchedDrawCalls++;
-			m_Stats.triangles += culledTriangles;
+		for (auto& batch : m_RetainedBatches)
+		{
+			if (batch.visibleCommands.empty())
+				continue;
+			drawBatch(batch.model, batch.albedoPath, batch.normalPath, batch.visibleData, batch.visibleCommands);
 		}
 
 		m_StaticCmdBO->UnBind();
@@ -377,6 +551,46 @@ namespace Onyx {
 		m_Stats.drawCalls += m_Stats.batchedDrawCalls;
 	}
 
+	void SceneRenderer::BindStaticMaterial(const std::string& albedoPath, const std::string& normalPath)
+	{
+		Texture* albedo = m_AssetManager->ResolveTexture(albedoPath);
+		Texture* normal = m_AssetManager->ResolveTexture(normalPath);
+		(albedo ? albedo : m_AssetManager->GetDefaultAlbedo())->Bind(0);
+
+		if (normal)
+		{
+			normal->Bind(1);
+			m_StaticBatchedShader->SetInt("u_UseNormalMap", 1);
+		}
+		else
+		{
+			m_AssetManager->GetDefaultNormal()->Bind(1);
+			m_StaticBatchedShader->SetInt("u_UseNormalMap", 0);
+		}
+	}
+
+	uint32_t SceneRenderer::CollectVisibleStatic(const Frustum& frustum, float lodThreshold, uint32_t& trianglesSaved)
+	{
+		for (auto& batch : m_RetainedBatches)
+		{
+			batch.visibleData.clear();
+			batch.visibleCommands.clear();
+		}
+
+		uint32_t visible = 0;
+		m_StaticBvh.Query(frustum, [&](uint32_t index) {
+			const StaticInstance& instance = m_StaticInstances[index];
+			RetainedBatch& batch = m_RetainedBatches[instance.batch];
+			batch.visibleData.push_back(instance.drawData);
+			batch.visibleCommands.push_back(
+				SelectStaticLod(instance.command, instance.lodSource, instance.bounds, lodThreshold));
+			trianglesSaved += (instance.command.count - batch.visibleCommands.back().count) / 3;
+			visible++;
+		});
+		m_Stats.bvhNodesVisited += m_StaticBvh.GetLastNodesVisited();
+		return visible;
+	}
+
 	void SceneRenderer::RenderSkinnedPass()
 	{
 		if (m_SkinnedQueue.empty())
@@ -393,6 +607,7 @@ namespace Onyx {
 
 		UploadLightUniforms(m_SkinnedBatchedShader.get());
 		UploadShadowUniforms(m_SkinnedBatchedShader.get());
+		UploadSkinnedPalette();
 
 		for (const auto& [key, batch] : skinnedBatches)
 		{
@@ -419,8 +634,6 @@ namespace Onyx {
 				m_SkinnedBatchedShader->SetInt("u_UseNormalMap", 0);
 			}
 
-			m_BoneSSBO->Upload(batch.packedBones.data(),
-							   batch.packedBones.size() * sizeof(glm::mat4), 1);
 			m_SkinnedSSBO->Upload(batch.drawData.data(),
 								  batch.drawData.size() * sizeof(SkinnedDrawData), 0);
 			m_SkinnedCmdBO->Upload(batch.commands.data(),
@@ -440,6 +653,32 @@ namespace Onyx {
 		m_Stats.drawCalls += m_Stats.skinnedDrawCalls;
 	}
 
+	DrawIndirectCommand SceneRenderer::SelectStaticLod(const DrawIndirectCommand& command,
+													   const StaticLodSource& source, const MeshBounds& bounds,
+													   float threshold) const
+	{
+		DrawIndirectCommand cmd = command;
+		if (source.info->lodCount <= 1)
+			return cmd;
+
+		// Distance to the nearest point of the box, so large meshes the camera
+		// stands inside or beside keep full detail
+		const glm::vec3 nearest = glm::clamp(m_CameraPos, bounds.worldMin, bounds.worldMax);
+		const float distance = glm::length(nearest - m_CameraPos);
+
+		const float errorScale = GetLodErrorScale(m_Projection, distance, source.worldScale);
+		const uint32_t lod = SelectLod(source.info->lods, source.info->lodCount, errorScale, threshold);
+		cmd.count = source.info->lods[lod].indexCount;
+		cmd.firstIndex = source.info->lods[lod].firstIndex;
+		return cmd;
+	}
+
+	void SceneRenderer::UploadSkinnedPalette()
+	{
+		// Every batch indexes the same palette, so one upload covers the pass
+		m_BoneSSBO->Upload(m_SkinnedPalette.data(), m_SkinnedPalette.size() * sizeof(glm::mat4), 1);
+	}
+
 	void SceneRenderer::BuildSkinnedBatches(std::unordered_map<uint64_t, SkinnedBatch>& out) const
 	{
 		for (const auto& sub : m_SkinnedQueue)
@@ -456,11 +695,8 @@ namespace Onyx {
 				batch.normalPath = sub.normalPath;
 			}
 
-			int32_t boneOffset = static_cast<int32_t>(batch.packedBones.size());
-			int32_t boneCount = static_cast<int32_t>(sub.boneMatrices.size());
-
-			batch.packedBones.insert(batch.packedBones.end(),
-									 sub.boneMatrices.begin(), sub.boneMatrices.end());
+			int32_t boneOffset = static_cast<int32_t>(sub.boneOffset);
+			int32_t boneCount = static_cast<int32_t>(sub.boneCount);
 
 			for (uint32_t meshIdx = 0; meshIdx < merged.meshInfos.size(); meshIdx++)
 			{
@@ -2,6 +2,7 @@
 
 #include "AnimatedModel.h"
 #include "AssetManager.h"
+#include "BoundingVolumeHierarchy.h"
 #include "Buffers.h"
 #include "CascadedShadowMap.h"
 #include "Framebuffer.h"
@@ -45,6 +46,15 @@ namespace Onyx {
 		glm::vec3 worldMax;
 	};
 
+	// Retained static instance. Stale handles (unregistered, or from before
+	// ClearStatic) are ignored by every call that takes one.
+	struct StaticInstanceHandle
+	{
+		uint32_t index = ~0u;
+		uint32_t generation = 0;
+		bool IsValid() const { return index != ~0u; }
+	};
+
 	struct RenderStats
 	{
 		uint32_t drawCalls = 0;
@@ -55,6 +65,9 @@ namespace Onyx {
 		uint32_t skinnedInstances = 0;
 		uint32_t meshesSubmitted = 0;
 		uint32_t meshesCulled = 0;
+		uint32_t bvhNodesVisited = 0; // Static instance BVH, camera + cascades
+		uint32_t lodTrianglesSaved = 0;		  // Camera pass, vs drawing every mesh at LOD0
+		uint32_t shadowLodTrianglesSaved = 0; // Summed over cascades
 	};
 
 	struct DirectionalLight
@@ -105,17 +118,49 @@ namespace Onyx {
 		void SetSplitLambda(float lambda);
 		void SetShowCascades(bool show);
 
+		// A mesh draws its coarsest LOD whose error projects under `threshold`
+		// NDC units (screen height = 2; the default is about a pixel at 1080p).
+		// Shadow casters use threshold * shadowBias.
+		void SetLodErrorThreshold(float threshold);
+		void SetShadowLodBias(float bias);
+
+		// Immediate mode: drawn this frame only, culled linearly
 		void SubmitStatic(Model* model, uint32_t meshIndex,
 						  const glm::mat4& worldTransform,
 						  const std::string& albedoPath,
 						  const std::string& normalPath);
 
+		// Retained mode: registered once and drawn every frame until
+		// unregistered, culled through a BVH. Begin() does not clear these.
+		StaticInstanceHandle RegisterStatic(Model* model, uint32_t meshIndex,
+											const glm::mat4& worldTransform,
+											const std::string& albedoPath,
+											const std::string& normalPath);
+		void UpdateStatic(StaticInstanceHandle handle, const glm::mat4& worldTransform);
+		void UnregisterStatic(StaticInstanceHandle handle);
+		void ClearStatic();
+		uint32_t GetStaticInstanceCount() const { return m_StaticBvh.GetItemCount(); }
+
 		void SubmitSkinned(AnimatedModel* model,
 						   const glm::mat4& worldTransform,
 						   const std::vector<glm::mat4>& boneMatrices,
 						   const std::string& albedoPath = "",
 						   const std::string& normalPath = "");
 
+		// Queues a skinned instance whose bone matrices are written later, into
+		// GetSkinnedPalette(offset)[0, boneCount), before RenderShadows or
+		// RenderBatches. Returns the palette offset, or INVALID_PALETTE_OFFSET
+		// when the model has no GPU buffers. Lets AnimationBatch evaluate poses
+		// straight into the buffer this frame uploads.
+		static constexpr uint32_t INVALID_PALETTE_OFFSET = ~0u;
+		uint32_t ReserveSkinned(AnimatedModel* model,
+								const glm::mat4& worldTransform,
+								uint32_t boneCount,
+								const std::string& albedoPath = "",
+								const std::string& normalPath = "");
+		// Valid until the next SubmitSkinned/ReserveSkinned, which may grow the palette
+		glm::mat4* GetSkinnedPalette(uint32_t offset) { return m_SkinnedPalette.data() + offset; }
+
 		void RenderShadows(ShadowCasterCallback extraShadows = nullptr);
 		void RenderBatches();
 
@@ -126,6 +171,12 @@ namespace Onyx {
 		RenderStats GetStats() const { return m_Stats; }
 
 	private:
+		struct StaticLodSource
+		{
+			const MergedMeshInfo* info = nullptr; // Owned by the model's MergedBuffers
+			float worldScale = 1.0f;			  // Largest axis scale of the transform
+		};
+
 		struct StaticBatch
 		{
 			Model* model = nullptr;
@@ -134,14 +185,41 @@ namespace Onyx {
 			std::vector<StaticDrawData> drawData;
 			std::vector<DrawIndirectCommand> commands;
 			std::vector<MeshBounds> bounds;
+			std::vector<StaticLodSource> lodSources;
 			uint32_t totalTriangles = 0;
 		};
 
+		// Draws sharing a model and material. Retained batches live as long
+		// as the renderer; `visibleData`/`visibleCommands` are per-pass scratch
+		// filled by the BVH traversal.
+		struct RetainedBatch
+		{
+			Model* model = nullptr;
+			std::string albedoPath;
+			std::string normalPath;
+			std::vector<StaticDrawData> visibleData;
+			std::vector<DrawIndirectCommand> visibleCommands;
+		};
+
+		struct StaticInstance
+		{
+			uint32_t batch = 0;
+			uint32_t generation = 0;
+			bool alive = false;
+			StaticDrawData drawData;
+			DrawIndirectCommand command;
+			MeshBounds bounds;
+			StaticLodSource lodSource;
+			glm::vec3 localMin;
+			glm::vec3 localMax;
+		};
+
 		struct SkinnedSubmission
 		{
 			AnimatedModel* model = nullptr;
 			glm::mat4 transform;
-			std::vector<glm::mat4> boneMatrices;
+			uint32_t boneOffset = 0; // Into m_SkinnedPalette
+			uint32_t boneCount = 0;
 			std::string albedoPath;
 			std::string normalPath;
 		};
@@ -153,7 +231,6 @@ namespace Onyx {
 			std::string normalPath;
 			std::vector<SkinnedDrawData> drawData;
 			std::vector<DrawIndirectCommand> commands;
-			std::vector<glm::mat4> packedBones;
 			uint32_t totalTriangles = 0;
 		};
 
@@ -161,7 +238,18 @@ namespace Onyx {
 		void RenderStaticPass();
 		void RenderSkinnedPass();
 
+		// `command` narrowed to the LOD picked for `threshold`
+		DrawIndirectCommand SelectStaticLod(const DrawIndirectCommand& command, const StaticLodSource& source,
+											const MeshBounds& bounds, float threshold) const;
+
+		StaticInstance* GetStaticInstance(StaticInstanceHandle handle);
+		void SetStaticTransform(StaticInstance& instance, const glm::mat4& worldTransform);
+		// Fills every retained batch's visible lists; returns the draw count
+		uint32_t CollectVisibleStatic(const Frustum& frustum, float lodThreshold, uint32_t& trianglesSaved);
+		void BindStaticMaterial(const std::string& albedoPath, const std::string& normalPath);
+
 		void BuildSkinnedBatches(std::unordered_map<uint64_t, SkinnedBatch>& out) const;
+		void UploadSkinnedPalette();
 		const std::unordered_map<uint64_t, SkinnedBatch>& GetOrBuildSkinnedBatches();
 
 		static void TransformAABB(const glm::vec3& localMin, const glm::vec3& localMax,
@@ -192,6 +280,9 @@ namespace Onyx {
 		float m_SplitLambda = 0.0f;
 		bool m_ShowCascades = false;
 
+		float m_LodErrorThreshold = 0.002f;
+		float m_ShadowLodBias = 4.0f;
+
 		glm::mat4 m_View = glm::mat4(1.0f);
 		glm::mat4 m_Projection = glm::mat4(1.0f);
 		glm::vec3 m_CameraPos = glm::vec3(0.0f);
@@ -204,7 +295,14 @@ namespace Onyx {
 		Frustum m_CameraFrustum;
 
 		std::unordered_map<uint64_t, StaticBatch> m_StaticBatches;
+
+		std::vector<RetainedBatch> m_RetainedBatches;
+		std::unordered_map<uint64_t, uint32_t> m_RetainedBatchLookup; // MakeBatchKey -> index
+		std::vector<StaticInstance> m_StaticInstances;
+		std::vector<uint32_t> m_FreeStaticInstances;
+		BoundingVolumeHierarchy m_StaticBvh;
 		std::vector<SkinnedSubmission> m_SkinnedQueue;
+		std::vector<glm::mat4> m_SkinnedPalette; // Every skinned instance's bones, uploaded once per pass
 
 		std::unordered_map<uint64_t, SkinnedBatch> m_BuiltSkinnedBatches;
 		bool m_SkinnedBatchesDirty = true;
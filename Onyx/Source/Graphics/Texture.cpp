@@ -7,6 +7,9 @@
 #include <stb_image.h>
 
 #include "Texture.h"
+#include "Core/FileSystem.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Onyx {
 
@@ -17,6 +20,11 @@ namespace Onyx {
 
 	Texture::Texture(const char* texturePath)
 	{
+		if (IsDdsPath(texturePath))
+		{
+			InitFromDds(texturePath);
+			return;
+		}
 		InitTexture(texturePath, false, 0, 0, 0);
 	}
 
@@ -39,11 +47,79 @@ namespace Onyx {
 		return texture;
 	}
 
+	unsigned char* Texture::LoadImagePixels(const char* path, int& width, int& height, int& channels,
+											int desiredChannels, bool flipVertically)
+	{
+		// Per thread: the preloader decodes on its own thread
+		stbi_set_flip_vertically_on_load_thread(flipVertically ? 1 : 0);
+
+		FileSystem::FileView file;
+		if (FileSystem::ReadFromProvider(path, file))
+		{
+			return stbi_load_from_memory(file.data, static_cast<int>(file.size), &width, &height, &channels,
+										 desiredChannels);
+		}
+		return stbi_load(path, &width, &height, &channels, desiredChannels);
+	}
+
+	void Texture::FreeImagePixels(unsigned char* pixels)
+	{
+		stbi_image_free(pixels);
+	}
+
+	bool Texture::IsDdsPath(const char* path)
+	{
+		const size_t length = std::strlen(path);
+		if (length < 4)
+			return false;
+		std::string extension(path + length - 4);
+		std::transform(extension.begin(), extension.end(), extension.begin(),
+					   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return extension == ".dds";
+	}
+
+	uint32_t Texture::GetCompressedFormat(BlockFormat format)
+	{
+		switch (format)
+		{
+		// S3TC is an extension (patents kept it out of core); RGTC and BPTC are core since 3.0/4.2
+		case BlockFormat::BC1:
+			return GLEW_EXT_texture_compression_s3tc ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : 0;
+		case BlockFormat::BC3:
+			return GLEW_EXT_texture_compression_s3tc ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : 0;
+		case BlockFormat::BC4:
+			return GL_COMPRESSED_RED_RGTC1;
+		case BlockFormat::BC5:
+			return GL_COMPRESSED_RG_RGTC2;
+		case BlockFormat::BC7:
+			return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		}
+		return 0;
+	}
+
 	PreloadedImage Texture::PreloadFromFile(const char* path)
 	{
 		PreloadedImage result;
-		stbi_set_flip_vertically_on_load_thread(1);
-		unsigned char* data = stbi_load(path, &result.width, &result.height, &result.channels, 0);
+		if (IsDdsPath(path))
+		{
+			// Keep the file mapped; the blocks go to the GPU as they are
+			FileSystem::FileView file;
+			std::string error;
+			if (!FileSystem::ReadFile(path, file))
+				return result;
+			if (!ParseDds(file.data, file.size, result.compressed, &error))
+			{
+				std::cout << "ERROR::TEXTURE::DDS: " << path << ": " << error << '\n';
+				return result;
+			}
+			result.width = static_cast<int>(result.compressed.width);
+			result.height = static_cast<int>(result.compressed.height);
+			result.channels = 4;
+			result.compressedOwner = std::move(file.owner);
+			return result;
+		}
+
+		unsigned char* data = LoadImagePixels(path, result.width, result.height, result.channels, 0, true);
 		if (data)
 		{
 			size_t size = static_cast<size_t>(result.width) * result.height * result.channels;
@@ -97,6 +173,81 @@ namespace Onyx {
 		return texture;
 	}
 
+	std::unique_ptr<Texture> Texture::CreateCompressed(const DdsImage& image)
+	{
+		auto texture = std::unique_ptr<Texture>(new Texture());
+		texture->InitCompressed(image);
+		return texture;
+	}
+
+	void Texture::InitFromDds(const char* texturePath)
+	{
+		FileSystem::FileView file;
+		if (!FileSystem::ReadFile(texturePath, file))
+		{
+			std::cout << "ERROR::TEXTURE::FILE_NOT_FOUND: " << texturePath << '\n';
+			return;
+		}
+
+		DdsImage image;
+		std::string error;
+		if (!ParseDds(file.data, file.size, image, &error))
+		{
+			std::cout << "ERROR::TEXTURE::DDS: " << texturePath << ": " << error << '\n';
+			return;
+		}
+		InitCompressed(image);
+	}
+
+	void Texture::InitCompressed(const DdsImage& image)
+	{
+		m_TextureWidth = static_cast<int>(image.width);
+		m_TextureHeight = static_cast<int>(image.height);
+		m_NChannels = 4;
+		m_TextureData = nullptr;
+
+		const GLsizei levelCount = static_cast<GLsizei>(image.levels.size());
+
+		glGenTextures(1, &m_TextureID);
+		Bind();
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+		const GLenum internalFormat = GetCompressedFormat(image.format);
+		if (internalFormat)
+		{
+			glTexStorage2D(GL_TEXTURE_2D, levelCount, internalFormat, m_TextureWidth, m_TextureHeight);
+			for (GLsizei i = 0; i < levelCount; i++)
+			{
+				const auto& level = image.levels[i];
+				glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, level.width, level.height, internalFormat,
+										  static_cast<GLsizei>(level.size), level.data);
+			}
+		}
+		else
+		{
+			// No S3TC on this driver: decode on the CPU, keeping the stored mips
+			std::cout << "WARNING::TEXTURE::" << GetBlockFormatName(image.format)
+					  << " not supported, decoding to RGBA8\n";
+			glTexStorage2D(GL_TEXTURE_2D, levelCount, GL_RGBA8, m_TextureWidth, m_TextureHeight);
+			std::vector<uint8_t> rgba;
+			for (GLsizei i = 0; i < levelCount; i++)
+			{
+				const auto& level = image.levels[i];
+				rgba.resize(size_t(level.width) * level.height * 4);
+				DecompressBlocks(image.format, level.data, level.width, level.height, rgba.data());
+				glTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, level.width, level.height, GL_RGBA, GL_UNSIGNED_BYTE,
+								rgba.data());
+			}
+		}
+
+		UnBind();
+	}
+
 	void Texture::InitFromData(const void* data, int width, int height, int channels)
 	{
 		m_TextureWidth = width;
@@ -161,8 +312,6 @@ namespace Onyx {
 
 	void Texture::InitTexture(const char* texturePath, bool useColorKey, uint8_t keyR, uint8_t keyG, uint8_t keyB)
 	{
-		stbi_set_flip_vertically_on_load(true);
-
 		glGenTextures(1, &m_TextureID);
 		Bind();
 
@@ -171,7 +320,7 @@ namespace Onyx {
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		m_TextureData = stbi_load(texturePath, &m_TextureWidth, &m_TextureHeight, &m_NChannels, 0);
+		m_TextureData = LoadImagePixels(texturePath, m_TextureWidth, m_TextureHeight, m_NChannels, 0, true);
 
 		if (!m_TextureData)
 		{
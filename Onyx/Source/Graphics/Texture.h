@@ -1,20 +1,27 @@
 #pragma once
 
+#include "DdsFile.h"
 #include "Maths/Maths.h"
 #include <memory>
 #include <vector>
 
 namespace Onyx {
 
+	// Either decoded `pixels`, or a .dds file's blocks (`compressed` points
+	// into the bytes `compressedOwner` keeps mapped)
 	struct PreloadedImage
 	{
 		std::vector<unsigned char> pixels;
 		int width = 0, height = 0, channels = 0;
-		bool Valid() const { return !pixels.empty(); }
+		DdsImage compressed;
+		std::shared_ptr<const void> compressedOwner;
+		bool Valid() const { return !pixels.empty() || compressed.Valid(); }
 		void Free()
 		{
 			pixels.clear();
 			pixels.shrink_to_fit();
+			compressed = {};
+			compressedOwner.reset();
 		}
 	};
 
@@ -30,9 +37,21 @@ namespace Onyx {
 		static std::unique_ptr<Texture> CreateWithMipmaps(const void* data, int width, int height, int channels);
 		static std::unique_ptr<Texture> CreateFloatTexture(const float* data, int width, int height);
 		static std::unique_ptr<Texture> CreateNoiseTexture(const float* data, int width, int height);
+		// Uploads the blocks and every mip level as stored; no decode, no glGenerateMipmap
+		static std::unique_ptr<Texture> CreateCompressed(const DdsImage& image);
 
 		static PreloadedImage PreloadFromFile(const char* path);
 
+		// Decodes an image through FileSystem's provider (e.g. a mounted pack),
+		// falling back to the disk. Free the result with FreeImagePixels.
+		static unsigned char* LoadImagePixels(const char* path, int& width, int& height, int& channels,
+											  int desiredChannels, bool flipVertically);
+		static void FreeImagePixels(unsigned char* pixels);
+
+		static bool IsDdsPath(const char* path);
+		// GL internal format for `format`, or 0 when the context cannot sample it
+		static uint32_t GetCompressedFormat(BlockFormat format);
+
 		void Bind() const;
 		void Bind(uint32_t slot) const;
 		void UnBind() const;
@@ -48,6 +67,8 @@ namespace Onyx {
 		void InitTexture(const char* texturePath, bool useColorKey, uint8_t keyR, uint8_t keyG, uint8_t keyB);
 		void InitSolidColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 		void InitFromData(const void* data, int width, int height, int channels);
+		void InitFromDds(const char* texturePath);
+		void InitCompressed(const DdsImage& image);
 
 		uint32_t m_TextureID = 0;
 		unsigned char* m_TextureData = nullptr;
@@ -2,10 +2,11 @@
 
 #include <GL/glew.h>
 
-#define STB_IMAGE_STATIC
-#include <stb_image.h>
-
+#include "DdsFile.h"
+#include "Texture.h"
 #include "TextureArray.h"
+#include "Core/FileSystem.h"
+#include <algorithm>
 
 namespace Onyx {
 
@@ -33,6 +34,7 @@ namespace Onyx {
 		m_Height = height;
 		m_Layers = layers;
 		m_Channels = channels;
+		m_Compressed = false;
 
 		GLenum internalFormat = (channels == 4) ? GL_RGBA8 : GL_RGB8;
 
@@ -52,11 +54,76 @@ namespace Onyx {
 		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 	}
 
+	void TextureArray::CreateCompressed(int width, int height, int layers, BlockFormat format)
+	{
+		const GLenum internalFormat = Texture::GetCompressedFormat(format);
+		if (!internalFormat)
+		{
+			Create(width, height, layers, 4);
+			return;
+		}
+
+		if (m_TextureID)
+		{
+			glDeleteTextures(1, &m_TextureID);
+		}
+
+		m_Width = width;
+		m_Height = height;
+		m_Layers = layers;
+		m_Channels = 4;
+		m_Compressed = true;
+		m_Format = format;
+		m_CompressedFormat = internalFormat;
+		m_MipLevels = 1;
+		while ((std::max)(width, height) >> m_MipLevels)
+		{
+			m_MipLevels++;
+		}
+
+		glGenTextures(1, &m_TextureID);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
+
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_MipLevels, internalFormat, width, height, layers);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	void TextureArray::UploadCompressedLayer(int layer, const DdsImage& image)
+	{
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
+		const int levelCount = (std::min)(m_MipLevels, static_cast<int>(image.levels.size()));
+		for (int i = 0; i < levelCount; i++)
+		{
+			const auto& level = image.levels[i];
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, layer, level.width, level.height, 1,
+									  m_CompressedFormat, static_cast<GLsizei>(level.size), level.data);
+		}
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
 	void TextureArray::SetLayerData(int layer, const void* data)
 	{
 		if (!m_TextureID || layer < 0 || layer >= m_Layers)
 			return;
 
+		if (m_Compressed)
+		{
+			// Compress this layer and its mip chain on the CPU
+			std::vector<uint8_t> file = EncodeDds(static_cast<const uint8_t*>(data), m_Width, m_Height, m_Format);
+			DdsImage image;
+			if (ParseDds(file.data(), file.size(), image))
+			{
+				UploadCompressedLayer(layer, image);
+			}
+			return;
+		}
+
 		GLenum format = (m_Channels == 4) ? GL_RGBA : GL_RGB;
 
 		glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
@@ -73,10 +140,11 @@ namespace Onyx {
 		if (!m_TextureID || layer < 0 || layer >= m_Layers)
 			return false;
 
-		stbi_set_flip_vertically_on_load(true);
+		if (Texture::IsDdsPath(path.c_str()))
+			return LoadLayerFromDds(path, layer);
 
 		int w, h, ch;
-		unsigned char* data = stbi_load(path.c_str(), &w, &h, &ch, m_Channels);
+		unsigned char* data = Texture::LoadImagePixels(path.c_str(), w, h, ch, m_Channels, true);
 		if (!data)
 		{
 			std::cerr << "[TextureArray] Failed to load: " << path << '\n';
@@ -86,7 +154,7 @@ namespace Onyx {
 		if (w == m_Width && h == m_Height)
 		{
 			SetLayerData(layer, data);
-			stbi_image_free(data);
+			Texture::FreeImagePixels(data);
 			return true;
 		}
 
@@ -108,7 +176,48 @@ namespace Onyx {
 		}
 
 		SetLayerData(layer, resized.data());
-		stbi_image_free(data);
+		Texture::FreeImagePixels(data);
+		return true;
+	}
+
+	bool TextureArray::LoadLayerFromDds(const std::string& path, int layer)
+	{
+		FileSystem::FileView file;
+		DdsImage image;
+		std::string error;
+		if (!FileSystem::ReadFile(path, file) || !ParseDds(file.data, file.size, image, &error))
+		{
+			std::cerr << "[TextureArray] Failed to load: " << path << ' ' << error << '\n';
+			return false;
+		}
+
+		const int w = static_cast<int>(image.width);
+		const int h = static_cast<int>(image.height);
+		if (m_Compressed && image.format == m_Format && w == m_Width && h == m_Height)
+		{
+			UploadCompressedLayer(layer, image);
+			return true;
+		}
+
+		// Format or size differs: decode the top level and take the pixel path
+		std::vector<uint8_t> rgba(size_t(w) * h * 4);
+		DecompressBlocks(image.format, image.levels[0].data, image.width, image.height, rgba.data());
+
+		std::vector<uint8_t> pixels(size_t(m_Width) * m_Height * m_Channels);
+		for (int y = 0; y < m_Height; y++)
+		{
+			for (int x = 0; x < m_Width; x++)
+			{
+				const int srcX = (std::min)(x * w / m_Width, w - 1);
+				const int srcY = (std::min)(y * h / m_Height, h - 1);
+				for (int c = 0; c < m_Channels; c++)
+				{
+					pixels[(size_t(y) * m_Width + x) * m_Channels + c] = rgba[(size_t(srcY) * w + srcX) * 4 + c];
+				}
+			}
+		}
+
+		SetLayerData(layer, pixels.data());
 		return true;
 	}
 
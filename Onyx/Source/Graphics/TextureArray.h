@@ -1,10 +1,13 @@
 #pragma once
 
+#include "BlockCompression.h"
 #include <cstdint>
 #include <string>
 
 namespace Onyx {
 
+	struct DdsImage;
+
 	class TextureArray
 	{
 	public:
@@ -12,6 +15,9 @@ namespace Onyx {
 		~TextureArray();
 
 		void Create(int width, int height, int layers, int channels);
+		// Block-compressed layers with a full mip chain. Matching .dds layers
+		// upload as stored; anything else is compressed on the CPU first.
+		void CreateCompressed(int width, int height, int layers, BlockFormat format);
 		void SetLayerData(int layer, const void* data);
 		bool LoadLayerFromFile(const std::string& path, int layer);
 		void SetLayerSolidColor(int layer, uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
@@ -23,6 +29,7 @@ namespace Onyx {
 		int GetWidth() const { return m_Width; }
 		int GetHeight() const { return m_Height; }
 		int GetLayers() const { return m_Layers; }
+		bool IsCompressed() const { return m_Compressed; }
 
 	private:
 		uint32_t m_TextureID = 0;
@@ -30,6 +37,13 @@ namespace Onyx {
 		int m_Height = 0;
 		int m_Layers = 0;
 		int m_Channels = 4;
+		bool m_Compressed = false;
+		BlockFormat m_Format = BlockFormat::BC1;
+		uint32_t m_CompressedFormat = 0;
+		int m_MipLevels = 1;
+
+		bool LoadLayerFromDds(const std::string& path, int layer);
+		void UploadCompressedLayer(int layer, const DdsImage& image);
 	};
 
 } // namespace Onyx
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ONYX_SIMD_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define ONYX_SIMD_SSE2 0
+#endif
+
+namespace Onyx {
+
+	// ============================================================
+	// SIMD KERNELS
+	// ============================================================
+	//
+	// SSE2 versions of the per-bone math in animation evaluation, with
+	// scalar fallbacks elsewhere. glm's own mat4 product is scalar unless it
+	// is built with GLM_FORCE_INTRINSICS, which this project does not set.
+	// Quaternions are loaded component by component, so glm's storage
+	// order (xyzw or wxyz) does not matter.
+
+	namespace Simd {
+
+#if ONYX_SIMD_SSE2
+		inline __m128 LoadQuat(const glm::quat& q) { return _mm_set_ps(q.w, q.z, q.y, q.x); }
+
+		inline glm::quat StoreQuat(__m128 v)
+		{
+			alignas(16) float f[4];
+			_mm_store_ps(f, v);
+			return glm::quat(f[3], f[0], f[1], f[2]);
+		}
+
+		inline __m128 Dot4(__m128 a, __m128 b)
+		{
+			__m128 m = _mm_mul_ps(a, b);
+			__m128 s = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+#endif
+
+		// Normalized lerp along the shorter arc. Runs ahead of slerp in the
+		// middle of wide arcs; see QuatSlerpFast for the corrected form.
+		inline glm::quat QuatNlerp(const glm::quat& a, const glm::quat& b, float t)
+		{
+#if ONYX_SIMD_SSE2
+			__m128 qa = LoadQuat(a);
+			__m128 qb = LoadQuat(b);
+			__m128 dot = Dot4(qa, qb);
+			// Flip b onto a's hemisphere: xor the sign bit of dot into b
+			__m128 sign = _mm_and_ps(dot, _mm_set1_ps(-0.0f));
+			qb = _mm_xor_ps(qb, sign);
+			__m128 r = _mm_add_ps(qa, _mm_mul_ps(_mm_sub_ps(qb, qa), _mm_set1_ps(t)));
+			__m128 len = _mm_sqrt_ps(Dot4(r, r));
+			return StoreQuat(_mm_div_ps(r, len));
+#else
+			float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+			float s = dot < 0.0f ? -1.0f : 1.0f;
+			glm::quat r(a.w + (b.w * s - a.w) * t, a.x + (b.x * s - a.x) * t,
+						a.y + (b.y * s - a.y) * t, a.z + (b.z * s - a.z) * t);
+			return glm::normalize(r);
+#endif
+		}
+
+		// nlerp with t pre-warped so the result tracks slerp's constant angular
+		// speed (polynomial fit from "Approximating slerp", Kapoulkine 2015):
+		// a few mul/adds instead of acos and three sin calls
+		inline glm::quat QuatSlerpFast(const glm::quat& a, const glm::quat& b, float t)
+		{
+			const float d = std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+			const float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+			const float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+			const float k = A * (t - 0.5f) * (t - 0.5f) + B;
+			return QuatNlerp(a, b, t + t * (t - 0.5f) * (t - 1.0f) * k);
+		}
+
+		// Spherical lerp along the shorter arc; falls back to nlerp when the
+		// quaternions are nearly parallel, like glm::slerp
+		inline glm::quat QuatSlerp(const glm::quat& a, const glm::quat& b, float t)
+		{
+			float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+			float sign = cosTheta < 0.0f ? -1.0f : 1.0f;
+			cosTheta *= sign;
+			if (cosTheta > 0.9995f)
+				return QuatNlerp(a, b, t);
+
+			float theta = std::acos(cosTheta);
+			float invSin = 1.0f / std::sin(theta);
+			float wa = std::sin((1.0f - t) * theta) * invSin;
+			float wb = std::sin(t * theta) * invSin * sign;
+#if ONYX_SIMD_SSE2
+			__m128 r = _mm_add_ps(_mm_mul_ps(LoadQuat(a), _mm_set1_ps(wa)), _mm_mul_ps(LoadQuat(b), _mm_set1_ps(wb)));
+			return StoreQuat(r);
+#else
+			return glm::quat(a.w * wa + b.w * wb, a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb);
+#endif
+		}
+
+		// translate(p) * mat4_cast(r) * scale(s), written straight into `out`
+		inline void ComposeTRS(const glm::vec3& p, const glm::quat& r, const glm::vec3& s, glm::mat4& out)
+		{
+			const float xx = r.x * r.x, yy = r.y * r.y, zz = r.z * r.z;
+			const float xy = r.x * r.y, xz = r.x * r.z, yz = r.y * r.z;
+			const float wx = r.w * r.x, wy = r.w * r.y, wz = r.w * r.z;
+
+			out[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy + wz) * s.x, 2.0f * (xz - wy) * s.x, 0.0f);
+			out[1] = glm::vec4(2.0f * (xy - wz) * s.y, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz + wx) * s.y, 0.0f);
+			out[2] = glm::vec4(2.0f * (xz + wy) * s.z, 2.0f * (yz - wx) * s.z, (1.0f - 2.0f * (xx + yy)) * s.z, 0.0f);
+			out[3] = glm::vec4(p, 1.0f);
+		}
+
+		// out = a * b (column-major); `out` may alias either input
+		inline void MultiplyMat4(const glm::mat4& a, const glm::mat4& b, glm::mat4& out)
+		{
+#if ONYX_SIMD_SSE2
+			const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+			const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+			const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+			const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+			for (int c = 0; c < 4; c++)
+			{
+				__m128 col = _mm_mul_ps(a0, _mm_set1_ps(b[c][0]));
+				col = _mm_add_ps(col, _mm_mul_ps(a1, _mm_set1_ps(b[c][1])));
+				col = _mm_add_ps(col, _mm_mul_ps(a2, _mm_set1_ps(b[c][2])));
+				col = _mm_add_ps(col, _mm_mul_ps(a3, _mm_set1_ps(b[c][3])));
+				_mm_storeu_ps(&out[c][0], col);
+			}
+#else
+			glm::mat4 result = a * b;
+			out = result;
+#endif
+		}
+
+	} // namespace Simd
+
+} // namespace Onyx
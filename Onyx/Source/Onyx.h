@@ -3,6 +3,7 @@
 // Core
 #include "Source/Core/Application.h"
 #include "Source/Core/Base.h"
+#include "Source/Core/FileSystem.h"
 #include "Source/Core/Layer.h"
 
 // Graphics
@@ -14,6 +15,7 @@
 #include "Graphics/Frustum.h"
 #include "Graphics/Material.h"
 #include "Graphics/Mesh.h"
+#include "Graphics/MeshSimplifier.h"
 #include "Graphics/ParticleSystem.h"
 #include "Graphics/RenderCommand.h"
 #include "Graphics/Renderer2D.h"